@@ -7,6 +7,7 @@
 #include "ovdec.h"
 #include "ovdefs.h"
 #include "ovdmx.h"
+#include "ovio.h"
 #include "ovframe.h"
 #include "ovdpb.h"
 #include "ovutils.h"
@@ -15,10 +16,6 @@
 typedef struct OVVCHdl{
     OVVCDmx *dmx;
     OVVCDec *dec;
-    /* TODO decide whether or not file pointer must be given
-       to dmx or not  it is only given to the hadle so when can
-       close the file later since we opened it from here*/
-    FILE *fp;
 }OVVCHdl;
 
 static int dmx_attach_file(OVVCHdl *const vvc_hdl, const char *const input_file_name);
@@ -48,6 +45,7 @@ main(int argc, char** argv)
   FILE *fout = NULL;
   int nb_frame_th = 1;
   int nb_entry_th = 1;
+  int read_ahead = 0;
 
   uint8_t options_flag=0;
 
@@ -64,9 +62,10 @@ main(int argc, char** argv)
           {"outfile",      required_argument, 0, 'o'},
           {"framethr",      required_argument, 0, 't'},
           {"entrythr",      required_argument, 0, 'e'},
+          {"readahead",      required_argument, 0, 'r'},
         };
       int option_index = 0;
-      c = getopt_long (argc, argv, "vhl:i:o:t:e:",
+      c = getopt_long (argc, argv, "vhl:i:o:t:e:r:",
                        long_options, &option_index);
       if (c == -1){
         break;
@@ -103,6 +102,10 @@ main(int argc, char** argv)
           nb_entry_th = atoi(optarg);
           break;
 
+        case 'r':
+          read_ahead = atoi(optarg);
+          break;
+
         case '?':
           options_flag+=0x10;
           break;
@@ -140,6 +143,8 @@ main(int argc, char** argv)
 
     if (ret < 0) goto failinit;
 
+    ovdmx_set_read_ahead(ovvc_hdl.dmx, read_ahead);
+
     ret = dmx_attach_file(&ovvc_hdl, input_file_name);
 
     if (ret < 0) goto failattach;
@@ -164,17 +169,14 @@ static int
 dmx_attach_file(OVVCHdl *const vvc_hdl, const char *const input_file_name)
 {
     int ret;
-    FILE *file = fopen(input_file_name,"rb");
+    /* Demuxer takes ownership of the stream and closes it on detach */
+    OVIOStream *io_str = ovio_stream_open_mmap(input_file_name);
 
-    if (file == NULL) {
-        perror(input_file_name);
-       vvc_hdl->fp = NULL;
+    if (io_str == NULL) {
        return -1;
     }
 
-    vvc_hdl->fp = file;
-
-    ret = ovdmx_attach_stream(vvc_hdl->dmx, vvc_hdl->fp);
+    ret = ovdmx_attach_stream(vvc_hdl->dmx, io_str);
 
     return ret;
 }
@@ -219,10 +221,6 @@ close_openvvc_hdl(OVVCHdl *const ovvc_hdl)
     OVVCDmx *vvcdmx = ovvc_hdl->dmx;
     int ret;
 
-    if (ovvc_hdl->fp != NULL) {
-        fclose(ovvc_hdl->fp);
-    }
-
     ret = ovdec_close(vvcdec);
 
     if (ret < 0) goto faildecclose;
@@ -356,8 +354,15 @@ static uint32_t write_decoded_frame_to_file(OVFrame *const frame, FILE *fp){
   uint8_t component = 0;
   uint32_t ret = 0;
   for(component=0; component<3; component++){
-    uint32_t frame_size = frame->height[component] * frame->linesize[component];
-    ret +=fwrite(frame->data[component], frame_size, sizeof(uint8_t), fp);
+    /* Planes rows are padded so they are written one at a time */
+    size_t smp_size = frame->frame_info.chromat_format == OV_YUV_420_P8 ? 1 : 2;
+    size_t row_size = frame->width[component] * smp_size;
+    const uint8_t *row = frame->data[component];
+    size_t y;
+    for(y=0; y<frame->height[component]; y++){
+      ret +=fwrite(row, row_size, sizeof(uint8_t), fp);
+      row += frame->linesize[component];
+    }
   }
   return ret;
 }
@@ -378,4 +383,5 @@ static void print_usage(){
   printf("\t-o <file>, --outfile=<file>\t\tPath to the output file (Default: test.yuv).\n");
   printf("\t-f <nbthreads>, --framethr=<nbthreads>\t\tNumber of simultaneous frames decoded (Default: 1).\n");
   printf("\t-e <nbthreads>, --entrythr=<nbthreads>\t\tNumber of simultaneous entries decoded per frame (Default: 1).\n");
+  printf("\t-r <depth>, --readahead=<depth>\t\tNumber of picture units extracted ahead by a demux thread (Default: 0).\n");
 }
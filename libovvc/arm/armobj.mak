@@ -1,6 +1,11 @@
 arm_SRC_FOLDER:=libovvc/arm/
-arm_LIB_SRC:=  	rcn_mc_neon.S \
-								rcn_mc_neon_wrapper.c \
-								rcn_sao_neon.c \
+arm_LIB_SRC:=  	rcn_sao_neon.c \
 								rcn_transform_neon.c \
 								rcn_intra_dc_planar_neon.c \
+
+# Motion compensation kernels are written for 10 bits only
+ifeq ($(BITDEPTH),10)
+arm_LIB_SRC+=  	rcn_mc_neon.S \
+								rcn_mc_neon_wrapper.c \
+
+endif
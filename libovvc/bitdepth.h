@@ -0,0 +1,58 @@
+#ifndef BITDEPTH_H
+#define BITDEPTH_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "ovconfig.h"
+
+/* Bit depth samples storage and reconstruction are specialised
+ * for at compile time (see configure --bitdepth).
+ * Pictures planes, in loop filters and motion compensation
+ * reference reads use OVSample while CTU reconstruction buffers
+ * keep 16 bits intermediate samples.
+ */
+#ifndef BITDEPTH
+#define BITDEPTH 10
+#endif
+
+#if BITDEPTH == 8
+typedef uint8_t OVSample;
+#elif BITDEPTH == 10
+typedef uint16_t OVSample;
+#else
+#error "Unsupported BITDEPTH"
+#endif
+
+#define OV_SAMPLE_MAX ((1 << BITDEPTH) - 1)
+#define OV_SAMPLE_MID (1 << (BITDEPTH - 1))
+
+/* Write a row of 16 bits reconstructed samples to a picture plane */
+static inline void
+ov_store_samples(OVSample *dst, const uint16_t *src, int nb_smp)
+{
+#if BITDEPTH == 8
+    int i;
+    for (i = 0; i < nb_smp; ++i) {
+        dst[i] = src[i];
+    }
+#else
+    memcpy(dst, src, sizeof(*dst) * nb_smp);
+#endif
+}
+
+/* Read a row of picture samples to 16 bits filtering buffers */
+static inline void
+ov_load_samples(int16_t *dst, const OVSample *src, int nb_smp)
+{
+#if BITDEPTH == 8
+    int i;
+    for (i = 0; i < nb_smp; ++i) {
+        dst[i] = src[i];
+    }
+#else
+    memcpy(dst, src, sizeof(*dst) * nb_smp);
+#endif
+}
+
+#endif
@@ -18,37 +18,6 @@ attach_rcn_ctu_buff(OVCTUDec *const ctudec)
      ctu_binfo->stride_c = RCN_CTB_STRIDE;
 }
 
-void
-ctudec_alloc_intra_line_buff(OVCTUDec *const ctudec, int nb_ctu_w)
-{
-    struct OVRCNCtx *rcn_ctx = &ctudec->rcn_ctx;
-    struct OVBuffInfo *intra_line_b = &rcn_ctx->intra_line_buff;
-
-    const OVPartInfo *const pinfo = ctudec->part_ctx;
-    uint8_t log2_ctb_size = pinfo->log2_ctu_s;
-    int max_cu_width_l = 1 << log2_ctb_size;
-    intra_line_b->stride    = nb_ctu_w*max_cu_width_l ;
-    intra_line_b->stride_c  = nb_ctu_w*max_cu_width_l / 2 ;
-
-    //Free and re-alloc when new ctu width for rectangular entry. 
-    ctudec_free_intra_line_buff(ctudec);
-    intra_line_b->y = ov_malloc(intra_line_b->stride * sizeof(uint16_t));
-    intra_line_b->cb = ov_malloc(intra_line_b->stride_c * sizeof(uint16_t));
-    intra_line_b->cr = ov_malloc(intra_line_b->stride_c * sizeof(uint16_t));
-}
-
-void ctudec_free_intra_line_buff(OVCTUDec *const ctudec)
-{
-    struct OVRCNCtx *rcn_ctx = &ctudec->rcn_ctx;
-    struct OVBuffInfo *intra_line_b = &rcn_ctx->intra_line_buff;
-
-   if(intra_line_b->y){
-        ov_freep(&intra_line_b->y);
-        ov_freep(&intra_line_b->cb);
-        ov_freep(&intra_line_b->cr);
-    }
-}
-
 int
 ovdec_decode_ctu(OVVCDec *dec, OVCTUDec *ctu_dec)
 {
@@ -155,8 +124,8 @@ void ctudec_extend_filter_region(OVCTUDec *const ctudec, int16_t** saved_rows, i
         int16_t* filter_region = fb->filter_region[comp];
         int stride_filter = fb->filter_region_stride[comp];
 
-        int stride_pic = fb->pic_frame->linesize[comp]/2;
-        int16_t* frame = (int16_t*) fb->pic_frame->data[comp] + y_pic*stride_pic + x_pic;
+        int stride_pic = fb->pic_frame->linesize[comp] / sizeof(OVSample);
+        OVSample* frame = (OVSample*) fb->pic_frame->data[comp] + y_pic*stride_pic + x_pic;
 
         // //*******************************************************/
         // //Copy of entire frame in filter buffer
@@ -169,7 +138,7 @@ void ctudec_extend_filter_region(OVCTUDec *const ctudec, int16_t** saved_rows, i
         //Copy of entire CTU from frame, before border extension
         for(int ii=0; ii < height; ii++)
         {
-            memcpy(&filter_region[ii*stride_filter + fb->filter_region_offset[comp]], &frame[ii*stride_pic], sizeof(int16_t)* width);
+            ov_load_samples(&filter_region[ii*stride_filter + fb->filter_region_offset[comp]], &frame[ii*stride_pic], width);
         }
 
         // //*******************************************************/
@@ -226,8 +195,8 @@ void ctudec_extend_filter_region(OVCTUDec *const ctudec, int16_t** saved_rows, i
         for(int ii=0; ii < margin; ii++)
         {
             if ( !(is_border_rect & OV_BOUNDARY_BOTTOM_RECT) ){
-                memcpy(&filter_region[(h+ii)*stride_filter], &frame[(height+ii)*stride_pic - margin],
-                    sizeof(int16_t)* (width + 2*margin));
+                ov_load_samples(&filter_region[(h+ii)*stride_filter], &frame[(height+ii)*stride_pic - margin],
+                                width + 2*margin);
             }
             else{
                 memcpy(&filter_region[(h+ii)*stride_filter ], &filter_region[(h-1)*stride_filter],
@@ -361,7 +330,6 @@ int
 ctudec_uninit(OVCTUDec *ctudec)
 {
     ctudec_free_filter_buffers(ctudec);    
-    ctudec_free_intra_line_buff(ctudec);
 
     ov_free(ctudec);
     return 0;
@@ -4,6 +4,7 @@
 #include "ovdefs.h"
 #include "ovframe.h"
 #include "ovmem.h"
+#include "bitdepth.h"
 #include "ovdec.h"
 
 #include "nvcl_structures.h"
@@ -48,6 +49,7 @@ enum VVCCUFlag
 };
 
 struct TUInfo;
+struct DBFCTURecord;
 
 /* FIXME: Move here for SSE */
 struct LMParams
@@ -122,7 +124,9 @@ struct SAOInfo
     /* FIXME remove */
     uint8_t chroma_format_idc;
 
-    /*array of SAO parameters structure for each ctu */ 
+    /*array of SAO parameters structure for each ctu
+     * owned by the slice decoder
+     */
     SAOParamsCtu *sao_params;
 };
 
@@ -138,8 +142,8 @@ struct ALFInfo
     uint8_t num_alf_aps_ids_luma;
     uint8_t left_ctb_alf_flag;
 
-    //TODO: use width in ctu of image (or tile) instead of max value 32.
-    uint8_t ctb_cc_alf_flag_line[2][32];
+    /* Above CTU line flags, points to slice decoder lines */
+    uint8_t *ctb_cc_alf_flag_line[2];
 
     const struct OVALFData* aps_alf_data[8];
     const struct OVALFData* aps_alf_data_c;
@@ -147,16 +151,28 @@ struct ALFInfo
     const struct OVALFData* aps_cc_alf_data_cr;
 
     uint8_t left_ctb_cc_alf_flag[2];
-    //TODO: use width in ctu of image (or tile) instead of max value 32.
-    uint8_t ctb_alf_flag_line[32];
+    uint8_t *ctb_alf_flag_line;
     uint8_t* ctb_cc_alf_filter_idx[2];
 
-    //TODO:  better here or in slicedec ?
-     /* arrays of ALF parameters structure for each ctu*/
+    /* arrays of ALF parameters structure for each ctu
+     * Note the arrays are owned by the slice decoder
+     */
     ALFParamsCtu *ctb_alf_params;
 
     //ALF reconstruction structure
     RCNALF rcn_alf;
+
+    /* Identifiers of the APS used by current slice and of the APS
+     * coefficients in rcn_alf were derived from so derivation is
+     * only done when an APS changes
+     */
+    uint64_t aps_alf_uid[8];
+    uint64_t aps_alf_uid_c;
+    uint64_t rcn_aps_uid[8];
+    uint64_t rcn_aps_uid_c;
+
+    /* Fixed filters sets only depend on bitdepth */
+    uint8_t fixed_filters_init;
 };
 
 struct LMCSInfo
@@ -172,6 +188,9 @@ struct LMCSInfo
     uint16_t* lmcs_lut_inv_luma;
     uint16_t* lmcs_lut_fwd_luma;
     const OVLMCSData *data;
+
+    /* Identifier of the APS LUTs were derived from */
+    uint64_t aps_uid;
 };
 
 
@@ -575,10 +594,10 @@ struct OVCTUDec
         /* Pointers to the first sample data of CTU in the current
          * picture
          */
-        struct OVBuffInfo{
-            uint16_t *y;
-            uint16_t *cb;
-            uint16_t *cr;
+        struct OVFrameBuffInfo{
+            OVSample *y;
+            OVSample *cb;
+            OVSample *cr;
             uint32_t stride;
             uint32_t stride_c;
         } frame_buff;
@@ -588,9 +607,18 @@ struct OVCTUDec
          * These buffers will be written to the destination picture
          * before filtering operation
          */
-        struct OVBuffInfo ctu_buff;
+        struct OVBuffInfo{
+            uint16_t *y;
+            uint16_t *cb;
+            uint16_t *cr;
+            uint32_t stride;
+            uint32_t stride_c;
+        } ctu_buff;
 
-        /*Pointers to intra line reconstruction buffers*/
+        /*Pointers to intra line reconstruction buffers
+         * Lines are owned by the slice decoder so they can be
+         * shared by CTU lines decoded in separate threads
+         */
         struct OVBuffInfo intra_line_buff;
 
         /* Side Buffer to be used by reconstruction functions
@@ -613,10 +641,21 @@ struct OVCTUDec
          * to block reconstruction function
          */
         struct RCNFunctions rcn_funcs;
+
+        /* Parameters rcn_funcs were initialised with so they
+         * are only reset when those change
+         */
+        uint32_t rcn_funcs_key;
     } rcn_ctx;
 
 
     struct DBFInfo dbf_info;
+
+    /* When set, deblocking information of each CTU of the current
+     * line is stored here and deblocking is deferred to the
+     * in loop filters job instead of being applied after the CTU
+     */
+    struct DBFCTURecord *dbf_records;
     
     struct SAOInfo sao_info;
 
@@ -650,6 +689,11 @@ struct OVCTUDec
      */
     uint8_t ctu_ngh_flags;
 
+    /* Entropy coding sync is enabled the above right CTU
+     * is considered unavailable
+     */
+    uint8_t entropy_sync;
+
     /* FIXME COMPAT old passed this line
      * Old structures to be removed
      * Those structures were imported as is from previous version
@@ -832,9 +876,6 @@ void ctudec_save_last_rows(OVCTUDec *const ctudec, int16_t** saved_rows, int x_l
 void ctudec_save_last_cols(OVCTUDec *const ctudec, int x_pic_l, int y_pic_l, uint8_t is_border_rect);
 void ctudec_free_filter_buffers(OVCTUDec *const ctudec);
 
-void ctudec_alloc_intra_line_buff(OVCTUDec *const ctudec, int nb_ctu_w);
-void ctudec_free_intra_line_buff(OVCTUDec *const ctudec);
-
 int ctudec_init(OVCTUDec **ctudec_p);
 int ctudec_uninit(OVCTUDec *ctudec_p);
 
@@ -347,7 +347,7 @@ decinit_set_entry_points(OVPS *const prms, const OVNALUnit *nal, uint32_t nb_sh_
     struct SHInfo *const sh_info = &prms->sh_info;
     const OVSH *const sh = prms->sh;
     struct TileInfo *const tinfo = &prms->pps_info.tile_info;
-    /* FIXME we consider nb_entries is nb_tiles */
+    /* FIXME we consider slice covers all tiles */
     /* TODO compute and keep track of nb_tiles from pps */
     int nb_entries = tinfo->nb_tile_cols * tinfo->nb_tile_rows;
     uint32_t rbsp_offset[256];
@@ -355,6 +355,12 @@ decinit_set_entry_points(OVPS *const prms, const OVNALUnit *nal, uint32_t nb_sh_
     const uint32_t *rbsp_epb_pos = nal->epb_pos;
     int nb_sh_epb = 0;
 
+    if (prms->sps->sps_entropy_coding_sync_enabled_flag) {
+        /* Each CTU line of each tile is an entry */
+        const struct PicPartInfo *const pinfo = &prms->pic_info;
+        nb_entries = tinfo->nb_tile_cols * pinfo->nb_ctb_h;
+    }
+
     rbsp_offset[0] = 0;
 
     for (j = 0; j < nb_rbsp_epb; ++j) {
@@ -383,6 +389,8 @@ decinit_set_entry_points(OVPS *const prms, const OVNALUnit *nal, uint32_t nb_sh_
     /* Note this is so we can retrieve entry end by using rbsp_entry [i + 1] */
     sh_info->rbsp_entry[i] = nal->rbsp_data + nal->rbsp_size;
 
+    sh_info->nb_entries = nb_entries;
+
     /*FIXME check entries do not exceed rpbs size */
     return 0;
 }
@@ -580,6 +588,7 @@ decinit_update_params(struct OVPS *const ps, const OVNVCLCtx *const nvcl_ctx)
 {
     /* FIXME assert nvcl_ctx params sets are not NULL*/
     int ret;
+    uint8_t sps_changed = 0;
     OVSH * sh = nvcl_ctx->sh;
     OVPH * ph = nvcl_ctx->ph;
     OVPPS * pps = retrieve_pps(nvcl_ctx, ph);
@@ -592,22 +601,27 @@ decinit_update_params(struct OVPS *const ps, const OVNVCLCtx *const nvcl_ctx)
         return OVVC_EINDATA;
     }
 
+    /* Parameter sets are only reinitialised when changed, a re-sent
+     * identical parameter set is the same object in nvcl_ctx
+     */
     if (ps->sps != sps) {
         ret = update_sps_info(&ps->sps_info, sps);
         if (ret < 0) {
             goto failsps;
         }
 
-        ps->sps = sps;
+        nvcl_ps_replace(&ps->sps, sps);
+        set_pic_part_info(&ps->pic_info, ps->sps);
+        sps_changed = 1;
     }
 
-    if (ps->pps != pps) {
-        /* FIXME pps could trigger use a new sps */
+    /* PPS derived information also depends on the SPS */
+    if (ps->pps != pps || sps_changed) {
         ret = update_pps_info(&ps->pps_info, pps, ps->sps);
         if (ret < 0) {
             goto failpps;
         }
-        ps->pps = pps;
+        nvcl_ps_replace(&ps->pps, pps);
     }
 
     if (ps->ph != ph) {
@@ -616,7 +630,7 @@ decinit_update_params(struct OVPS *const ps, const OVNVCLCtx *const nvcl_ctx)
         if (ret < 0) {
             goto failph;
         }
-        ps->ph = ph;
+        nvcl_ps_replace(&ps->ph, ph);
     }
 
     /* We only check sh is present in ctx since we should be called
@@ -628,34 +642,25 @@ decinit_update_params(struct OVPS *const ps, const OVNVCLCtx *const nvcl_ctx)
         if (ret < 0) {
             goto failsh;
         }
-        ps->sh = nvcl_ctx->sh;
+        nvcl_ps_replace(&ps->sh, nvcl_ctx->sh);
     }
 
     for(int i = 0; i < sh->sh_num_alf_aps_ids_luma; i++){
         uint8_t aps_id = sh->sh_alf_aps_id_luma[i];
         OVAPS * aps_alf = retrieve_aps_alf(nvcl_ctx, aps_id);
-        if (ps->aps_alf[i] != aps_alf) {
-            ps->aps_alf[i] = aps_alf;
-        }  
+        nvcl_ps_replace(&ps->aps_alf[i], aps_alf);
     }
     OVAPS * aps_alf_c = retrieve_aps_alf(nvcl_ctx, sh->sh_alf_aps_id_chroma);
-    if (ps->aps_alf_c != aps_alf_c) {
-        ps->aps_alf_c = aps_alf_c;
-    }
+    nvcl_ps_replace(&ps->aps_alf_c, aps_alf_c);
+
     OVAPS * aps_cc_alf_cb = retrieve_aps_alf(nvcl_ctx, sh->sh_alf_cc_cb_aps_id);
-    if (ps->aps_cc_alf_cb != aps_cc_alf_cb) {
-        ps->aps_cc_alf_cb = aps_cc_alf_cb;
-    }
+    nvcl_ps_replace(&ps->aps_cc_alf_cb, aps_cc_alf_cb);
+
     OVAPS * aps_cc_alf_cr = retrieve_aps_alf(nvcl_ctx, sh->sh_alf_cc_cr_aps_id);
-    if (ps->aps_cc_alf_cr != aps_cc_alf_cr) {
-        ps->aps_cc_alf_cr = aps_cc_alf_cr;
-    }
+    nvcl_ps_replace(&ps->aps_cc_alf_cr, aps_cc_alf_cr);
 
     OVAPS * aps_lmcs = retrieve_aps_lmcs(nvcl_ctx, ph);
-    if (ps->aps_lmcs != aps_lmcs) {
-        ps->aps_lmcs = aps_lmcs;
-    }
-    set_pic_part_info(&ps->pic_info, ps->sps);
+    nvcl_ps_replace(&ps->aps_lmcs, aps_lmcs);
 
     return 0;
 
@@ -665,10 +670,30 @@ failpps:
 failph:
 failsh:
     /* On failure  we reset all active ps so next activation will try again */
-    ps->sps = NULL;
-    ps->pps = NULL;
-    ps->ph = NULL;
-    ps->sh = NULL;
+    nvcl_ps_unref(&ps->sps);
+    nvcl_ps_unref(&ps->pps);
+    nvcl_ps_unref(&ps->ph);
+    nvcl_ps_unref(&ps->sh);
 
     return ret;
 }
+
+void
+decinit_unref_params(struct OVPS *const ps)
+{
+    int i;
+
+    nvcl_ps_unref(&ps->sps);
+    nvcl_ps_unref(&ps->pps);
+    nvcl_ps_unref(&ps->ph);
+    nvcl_ps_unref(&ps->sh);
+
+    for (i = 0; i < 8; ++i) {
+        nvcl_ps_unref(&ps->aps_alf[i]);
+    }
+
+    nvcl_ps_unref(&ps->aps_alf_c);
+    nvcl_ps_unref(&ps->aps_cc_alf_cb);
+    nvcl_ps_unref(&ps->aps_cc_alf_cr);
+    nvcl_ps_unref(&ps->aps_lmcs);
+}
@@ -3,6 +3,7 @@
 
 #include <stdio.h>
 #include <pthread.h>
+#include <stdatomic.h>
 
 #include "ovdefs.h"
 #include "nvcl.h"
@@ -31,6 +32,16 @@ struct RectEntryInfo {
     int last_ctu_w;
     int last_ctu_h;
     int nb_ctb_pic_w;
+
+    /* Entropy coding sync (WPP) each CTU line of the entry
+     * is a separate entry point starting at first_line
+     */
+    uint8_t entropy_sync;
+    /* CTU lines are decoded concurrently by multiple threads */
+    uint8_t wpp_sync;
+    /* In loop filters are applied by the slice filtering job */
+    uint8_t lf_pipeline;
+    uint16_t first_line;
 };
 
 struct OVPartInfo
@@ -254,11 +265,80 @@ struct OutputThread
     uint8_t kill;
 };
 
+/* Number of job priority levels of the thread pool */
+#define OV_POOL_NB_PRIO 3
+
+/* Extra level above decoder priorities for jobs other jobs may
+ * be blocked on (i.e. loop filter jobs reporting reference CTU
+ * lines). Workers always serve it first so such a job never sits
+ * behind entry jobs of later pictures waiting for its lines.
+ */
+#define OV_POOL_PRIO_UNBLOCK OV_POOL_NB_PRIO
+
+/* Job to be run by a worker of the thread pool */
+struct OVJob
+{
+    int (*run)(void *opaque, int idx);
+    void *opaque;
+    int idx;
+
+    /* Priority level of the decoder submitting the job */
+    uint8_t priority;
+
+    struct OVJob *next;
+};
+
+struct OVWorker;
+
+/* Pool of worker threads shared by the pictures in flight of
+ * one or several decoders, jobs are queued on per worker and per
+ * priority queues and idle workers steal jobs from other queues.
+ */
+struct OVThreadPool
+{
+    struct OVWorker *workers;
+    int nb_workers;
+
+    /* Workers are started on demand */
+    int nb_started;
+    int nb_idle;
+
+    unsigned next_worker;
+    atomic_uint nb_pending;
+
+    pthread_mutex_t pool_mtx;
+    pthread_cond_t pool_cnd;
+
+    /* Sub decoders with a picture in decoding on this pool.
+     * Entry jobs block on reference lines decoded by older
+     * pictures so they are kept below the number of workers
+     * for one worker to always be left to older pictures jobs.
+     */
+    int nb_pic_in_flight;
+    int max_pic_in_flight;
+    pthread_cond_t pic_cnd;
+
+    uint8_t kill;
+
+    /* Set when the pool was created by the user and is
+     * not owned by a decoder
+     */
+    uint8_t shared;
+};
+
 struct MainThread
 {
     int kill;
     pthread_mutex_t main_mtx;
     pthread_cond_t main_cnd;
+
+    /* Pipe written each time a picture becomes ready for output
+     * so user event loops can poll on its read end (-1 if unavailable)
+     */
+    int event_fd[2];
+
+    /* DPB of the decoder checked for pictures ready for output */
+    OVDPB *const *dpb;
 };
 
 struct OVVCDec
@@ -314,6 +394,14 @@ struct OVVCDec
 
     //Boolean that indicates if the video is displayed
     uint8_t display_output;
+
+    /* Submission returns instead of waiting for a sub decoder */
+    uint8_t non_blocking;
+
+    /* Pool pictures reserved for the slices of the picture unit
+     * being submitted in non blocking mode
+     */
+    int nb_reserved_pic;
     
     OVDPB *dpb;
 
@@ -333,6 +421,24 @@ struct OVVCDec
 
     struct MainThread main_thread;
 
+    /* Pool used by the decoder if no shared pool is attached */
+    struct OVThreadPool thread_pool;
+
+    /* Pool sub decoders submit their jobs to */
+    struct OVThreadPool *pool;
+
+    /* Priority of the jobs of this decoder in its pool */
+    uint8_t priority;
+
+    /* SIMD extensions the decoder is allowed to use */
+    int cpu_flags;
+
+    /* Luma samples padded around allocated pictures */
+    int frame_margin;
+
+    /* Post processing applied on output pictures */
+    struct PostProcCtx pp_ctx;
+
     /* Informations on decoder behaviour transmitted by user
      */
     struct {
@@ -7,6 +7,9 @@
 
 int decinit_update_params(struct OVPS *const ps, const OVNVCLCtx *const nvcl_ctx);
 
+/* Release the references on parameter sets held by ps */
+void decinit_unref_params(struct OVPS *const ps);
+
 int decinit_set_entry_points(OVPS *const prms, const OVNALUnit *nal, uint32_t nb_sh_bytes);
 
 #endif
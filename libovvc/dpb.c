@@ -1,6 +1,7 @@
 #include <string.h>
 #include <stddef.h>
 #include <limits.h>
+#include "ovconfig.h"
 #include "ovutils.h"
 #include "ovmem.h"
 #include "nvcl_private.h"
@@ -14,6 +15,10 @@
 #include "slicedec.h"
 #include "ovdec_internal.h"
 
+#if ARCH_X86
+#include <immintrin.h>
+#endif
+
 
 #if 1
 #endif
@@ -27,8 +32,6 @@ enum SliceType
    SLICE_I = 2,
 };
 
-const uint8_t SIZE_INT64 = 6;
-
 static void tmvp_release_mv_planes(OVPicture *const pic);
 
 static int dpb_init_params(OVDPB *dpb, OVDPBParams const *prm);
@@ -40,7 +43,7 @@ static void ovdpb_init_decoded_ctus(OVPicture *const pic, const OVPS *const ps);
 static void ovdpb_uninit_decoded_ctus(OVPicture *const pic);
 
 int
-ovdpb_init(OVDPB **dpb_p, const OVPS *ps)
+ovdpb_init(OVDPB **dpb_p, const OVPS *ps, int margin)
 {
     #if 0
     OVDPB *dpb = *dpb_p;
@@ -53,7 +56,7 @@ ovdpb_init(OVDPB **dpb_p, const OVPS *ps)
          return OVVC_ENOMEM;
     }
 
-    ret = dpbpriv_init_framepool(&(*dpb_p)->internal, ps->sps);
+    ret = dpbpriv_init_framepool(&(*dpb_p)->internal, ps->sps, margin);
     if (ret < 0) {
         goto failframepool;
     }
@@ -656,6 +659,58 @@ ovdpb_output_pic(OVDPB *dpb, OVPicture **out, int output_cvs_id)
     return 0;
 }
 
+/* Check if ovdpb_output_pic would return a picture once sub
+ * decoders which finished decoding release their pictures.
+ * Pictures still flagged in decoding are considered decoded
+ * when all their CTU lines were reported.
+ */
+int
+ovdpb_output_ready(const OVDPB *dpb, int output_cvs_id)
+{
+    do {
+        const int nb_dpb_pic = sizeof(dpb->pictures) / sizeof(*dpb->pictures);
+        int nb_output = 0;
+        int min_poc   = INT_MAX;
+        int min_idx   = nb_dpb_pic;
+        int i;
+
+        for (i = 0; i < nb_dpb_pic; i++) {
+            const OVPicture *pic = &dpb->pictures[i];
+            uint8_t output_flag = (pic->flags & OV_OUTPUT_PIC_FLAG);
+            uint8_t is_output_cvs = pic->cvs_id == output_cvs_id;
+            if (output_flag && is_output_cvs) {
+                const struct PicDecodedCtusInfo *decoded_ctus = &pic->decoded_ctus;
+                uint8_t in_decoding = (pic->flags & OV_IN_DECODING_PIC_FLAG) &&
+                                      atomic_load_explicit(&decoded_ctus->nb_lines_done, memory_order_acquire) < decoded_ctus->nb_ctb_h;
+                if (!in_decoding) {
+                    nb_output++;
+                }
+                if (pic->poc < min_poc) {
+                    min_poc = pic->poc;
+                    min_idx = in_decoding ? nb_dpb_pic : i;
+                }
+            }
+        }
+
+        if (output_cvs_id == dpb->cvs_id && nb_output <= dpb->max_nb_reorder_pic) {
+            return 0;
+        }
+
+        if (min_idx < nb_dpb_pic) {
+            return 1;
+        }
+
+        if (output_cvs_id != dpb->cvs_id) {
+            output_cvs_id = (output_cvs_id + 1) & 0xff;
+        } else {
+            break;
+        }
+
+    } while (1);
+
+    return 0;
+}
+
 /*FIXME
  *   There might be better ways instead of always looping over
  *   the whole DPB and check for POC and CVS.
@@ -1064,12 +1119,24 @@ void
 ovdpb_init_decoded_ctus(OVPicture *const pic, const OVPS *const ps)
 {   
     struct PicDecodedCtusInfo* decoded_ctus = &pic->decoded_ctus;
-    if(!decoded_ctus->mask){
-        decoded_ctus->mask_h = ps->pic_info.nb_ctb_h;
-        decoded_ctus->mask_w = (ps->pic_info.nb_ctb_w >> SIZE_INT64) + 1;
-        decoded_ctus->mask = ov_mallocz(decoded_ctus->mask_h * sizeof(uint64_t*));
-        for(int i = 0; i < decoded_ctus->mask_h; i++)
-            decoded_ctus->mask[i] = ov_mallocz(decoded_ctus->mask_w * sizeof(uint64_t));
+    if(!decoded_ctus->lines){
+        decoded_ctus->nb_ctb_w = ps->pic_info.nb_ctb_w;
+        decoded_ctus->nb_ctb_h = ps->pic_info.nb_ctb_h;
+        decoded_ctus->nb_mask_words = (decoded_ctus->nb_ctb_w + 63) >> 6;
+        decoded_ctus->lines = ov_mallocz(decoded_ctus->nb_ctb_h * sizeof(*decoded_ctus->lines));
+        decoded_ctus->ctu_masks = ov_mallocz(decoded_ctus->nb_ctb_h * decoded_ctus->nb_mask_words *
+                                             sizeof(*decoded_ctus->ctu_masks));
+        for(int i = 0; i < decoded_ctus->nb_ctb_h; i++) {
+            struct CTULineProgress *line = &decoded_ctus->lines[i];
+            atomic_init(&line->nb_ctus, 0);
+            line->ctu_mask = &decoded_ctus->ctu_masks[i * decoded_ctus->nb_mask_words];
+            for (int j = 0; j < decoded_ctus->nb_mask_words; j++) {
+                atomic_init(&line->ctu_mask[j], 0);
+            }
+            pthread_mutex_init(&line->line_mtx, NULL);
+            pthread_cond_init(&line->line_cnd, NULL);
+        }
+        atomic_init(&decoded_ctus->nb_lines_done, 0);
     }
 
     pic->ovdpb_frame_synchro = ovdpb_synchro_ref_decoded_ctus;
@@ -1079,23 +1146,35 @@ void
 ovdpb_uninit_decoded_ctus(OVPicture *const pic)
 {   
     struct PicDecodedCtusInfo* decoded_ctus = &pic->decoded_ctus;
-    if(decoded_ctus->mask){
-        for(int i = 0; i < decoded_ctus->mask_h; i++)
-            ov_freep(&decoded_ctus->mask[i]);
-        ov_freep(&decoded_ctus->mask);
+    if(decoded_ctus->lines){
+        for(int i = 0; i < decoded_ctus->nb_ctb_h; i++) {
+            struct CTULineProgress *line = &decoded_ctus->lines[i];
+            pthread_mutex_destroy(&line->line_mtx);
+            pthread_cond_destroy(&line->line_cnd);
+        }
+        ov_freep(&decoded_ctus->lines);
+        ov_freep(&decoded_ctus->ctu_masks);
     }
 }
 
-void xctu_to_mask(uint64_t* mask, int mask_w, int xmin_ctu, int xmax_ctu)
+/* Update the number of first CTU lines completely decoded
+ */
+static void
+update_lines_done(struct PicDecodedCtusInfo *decoded_ctus)
 {
-    int sub_xmin_ctu, sub_xmax_ctu;
-    for(int i = (xmin_ctu >> SIZE_INT64); i <= (xmax_ctu >> SIZE_INT64); i++)
-    {
-        mask[i] = 0;
-        sub_xmin_ctu = xmin_ctu > (i<<SIZE_INT64)     ? xmin_ctu % (1<<SIZE_INT64) : 0;
-        sub_xmax_ctu = xmax_ctu < ((i+1)<<SIZE_INT64) ? xmax_ctu % (1<<SIZE_INT64) : (1<<SIZE_INT64)-1;
-        for(int ii = sub_xmin_ctu; ii <= sub_xmax_ctu; ii++)
-            mask[i] |= 1 << ii;
+    unsigned nb_lines_done = atomic_load_explicit(&decoded_ctus->nb_lines_done, memory_order_acquire);
+
+    while (nb_lines_done < decoded_ctus->nb_ctb_h) {
+        struct CTULineProgress *next = &decoded_ctus->lines[nb_lines_done];
+        if (atomic_load_explicit(&next->nb_ctus, memory_order_acquire) < decoded_ctus->nb_ctb_w) {
+            break;
+        }
+        /* On failure nb_lines_done is updated to its current value */
+        if (atomic_compare_exchange_weak_explicit(&decoded_ctus->nb_lines_done, &nb_lines_done,
+                                                  nb_lines_done + 1, memory_order_acq_rel,
+                                                  memory_order_acquire)) {
+            nb_lines_done++;
+        }
     }
 }
 
@@ -1103,15 +1182,29 @@ void
 ovdpb_report_decoded_ctu_line(OVPicture *const pic, int y_ctu, int xmin_ctu, int xmax_ctu)
 {
     struct PicDecodedCtusInfo* decoded_ctus = &pic->decoded_ctus;
-    int mask_w = decoded_ctus->mask_w;
-    uint64_t mask[mask_w];
-    xctu_to_mask(mask, mask_w, xmin_ctu, xmax_ctu);
-
-    pthread_mutex_lock(&decoded_ctus->ref_mtx);
-    for(int i = 0; i < mask_w; i++)
-        decoded_ctus->mask[y_ctu][i] |= mask[i];
-    pthread_cond_broadcast(&decoded_ctus->ref_cnd);
-    pthread_mutex_unlock(&decoded_ctus->ref_mtx);
+    struct CTULineProgress *line = &decoded_ctus->lines[y_ctu];
+    unsigned nb_ctus = xmax_ctu - xmin_ctu + 1;
+    int x = xmin_ctu;
+
+    while (x <= xmax_ctu) {
+        int last_x = OVMIN(xmax_ctu, x | 63);
+        uint64_t bits = (~0ULL >> (63 - (last_x - x))) << (x & 63);
+        atomic_fetch_or_explicit(&line->ctu_mask[x >> 6], bits, memory_order_release);
+        x = last_x + 1;
+    }
+
+    nb_ctus += atomic_fetch_add_explicit(&line->nb_ctus, nb_ctus, memory_order_acq_rel);
+
+    /* Segments of a line are reported by tiles so threads waiting
+     * on part of the line are woken on each report
+     */
+    pthread_mutex_lock(&line->line_mtx);
+    pthread_cond_broadcast(&line->line_cnd);
+    pthread_mutex_unlock(&line->line_mtx);
+
+    if (nb_ctus >= decoded_ctus->nb_ctb_w) {
+        update_lines_done(decoded_ctus);
+    }
     // ov_log(NULL, OVLOG_TRACE, "update_decoded_ctus POC %d line %d\n", pic->poc, y_ctu);
 }
 
@@ -1119,12 +1212,18 @@ void
 ovdpb_report_decoded_frame(OVPicture *const pic)
 {
     struct PicDecodedCtusInfo* decoded_ctus = &pic->decoded_ctus;
-    pthread_mutex_lock(&decoded_ctus->ref_mtx);
-    for(int i = 0; i < decoded_ctus->mask_h; i++){
-        memset(decoded_ctus->mask[i], 0xFF, decoded_ctus->mask_w * sizeof(int64_t));
+    for(int i = 0; i < decoded_ctus->nb_ctb_h; i++){
+        struct CTULineProgress *line = &decoded_ctus->lines[i];
+        for (int j = 0; j < decoded_ctus->nb_mask_words; j++) {
+            atomic_store_explicit(&line->ctu_mask[j], ~0ULL, memory_order_release);
+        }
+        atomic_store_explicit(&line->nb_ctus, decoded_ctus->nb_ctb_w, memory_order_release);
+
+        pthread_mutex_lock(&line->line_mtx);
+        pthread_cond_broadcast(&line->line_cnd);
+        pthread_mutex_unlock(&line->line_mtx);
     }
-    pthread_cond_broadcast(&decoded_ctus->ref_cnd);
-    pthread_mutex_unlock(&decoded_ctus->ref_mtx);
+    atomic_store_explicit(&decoded_ctus->nb_lines_done, decoded_ctus->nb_ctb_h, memory_order_release);
 
     pic->ovdpb_frame_synchro = ovdpb_no_synchro;
 }
@@ -1133,61 +1232,119 @@ static void
 ovdpb_reset_decoded_ctus(OVPicture *const pic)
 {
     struct PicDecodedCtusInfo* decoded_ctus = &pic->decoded_ctus;
-    pthread_mutex_lock(&decoded_ctus->ref_mtx);
-    for(int i = 0; i < decoded_ctus->mask_h; i++){
-        if (decoded_ctus->mask)
-        memset(decoded_ctus->mask[i], 0, decoded_ctus->mask_w * sizeof(int64_t));
+    if (decoded_ctus->lines) {
+        for(int i = 0; i < decoded_ctus->nb_ctb_h; i++){
+            struct CTULineProgress *line = &decoded_ctus->lines[i];
+            atomic_store_explicit(&line->nb_ctus, 0, memory_order_relaxed);
+            for (int j = 0; j < decoded_ctus->nb_mask_words; j++) {
+                atomic_store_explicit(&line->ctu_mask[j], 0, memory_order_relaxed);
+            }
+        }
     }
-    pthread_mutex_unlock(&decoded_ctus->ref_mtx);
+    atomic_store_explicit(&decoded_ctus->nb_lines_done, 0, memory_order_relaxed);
+
+    /* Invalidate progress cached by threads on previous use of the picture */
+    atomic_fetch_add_explicit(&decoded_ctus->decode_id, 1, memory_order_relaxed);
 
     pic->ovdpb_frame_synchro = ovdpb_synchro_ref_decoded_ctus;
 }
 
 void
-ovdpb_get_lines_decoded_ctus(OVPicture *const pic, uint64_t* decoded, int y_start, int y_end )
+ovdpb_no_synchro(OVPicture *const ref_pic, int tl_ctu_x, int tl_ctu_y, int br_ctu_x, int br_ctu_y)
 {
-    // ov_log(NULL, OVLOG_DEBUG, "Get decoded_ctus ref POC %d lines %d,%d \n", pic->poc, y_start, y_end);
-    struct PicDecodedCtusInfo* decoded_ctus = &pic->decoded_ctus;
-    int mask_w = decoded_ctus->mask_w;
-    // for(int i = y_start; i <= y_end; i++)
-    //     memcpy(decoded[i], decoded_ctus->mask[i], decoded_ctus->mask_w * sizeof(int64_t)) ;
-    memcpy(&decoded[y_start*mask_w], decoded_ctus->mask[y_start], (y_end-y_start) * mask_w * sizeof(int64_t)) ;
+    return;
 }
 
-void
-ovdpb_no_synchro(OVPicture *const ref_pic, int tl_ctu_x, int tl_ctu_y, int br_ctu_x, int br_ctu_y)
+/* Per thread cache of the progress last seen on reference pictures
+ * so that the shared progress is only read when a CTU line not yet
+ * known as decoded is requested
+ */
+#define NB_PROGRESS_CACHE 16
+#define NB_SYNCHRO_SPIN 256
+
+static _Thread_local struct RefProgressCache
 {
-    return;
+    const OVPicture *pic;
+    uint32_t decode_id;
+    uint16_t nb_lines_done;
+} ref_progress_cache[NB_PROGRESS_CACHE];
+
+static inline void
+spin_pause(void)
+{
+    /* Leave execution resources to a sibling hardware thread */
+    #if ARCH_X86
+    _mm_pause();
+    #elif ARCH_AARCH64
+    __asm__ volatile ("yield");
+    #endif
+}
+
+static int
+ctus_decoded(struct CTULineProgress *line, int x0, int x1)
+{
+    while (x0 <= x1) {
+        int last_x = OVMIN(x1, x0 | 63);
+        uint64_t bits = (~0ULL >> (63 - (last_x - x0))) << (x0 & 63);
+        uint64_t mask = atomic_load_explicit(&line->ctu_mask[x0 >> 6], memory_order_acquire);
+        if ((mask & bits) != bits) {
+            return 0;
+        }
+        x0 = last_x + 1;
+    }
+
+    return 1;
+}
+
+static void
+wait_ctus(struct CTULineProgress *line, int x0, int x1)
+{
+    int nb_spin = NB_SYNCHRO_SPIN;
+
+    /* Spin for a while before blocking since the line is often
+     * being filtered and will be available soon
+     */
+    while (!ctus_decoded(line, x0, x1)) {
+        if (!nb_spin--) {
+            pthread_mutex_lock(&line->line_mtx);
+            while (!ctus_decoded(line, x0, x1)) {
+                pthread_cond_wait(&line->line_cnd, &line->line_mtx);
+            }
+            pthread_mutex_unlock(&line->line_mtx);
+            break;
+        }
+        spin_pause();
+    }
 }
 
 void
 ovdpb_synchro_ref_decoded_ctus(OVPicture *const ref_pic, int tl_ctu_x, int tl_ctu_y, int br_ctu_x, int br_ctu_y)
 {
     struct PicDecodedCtusInfo* decoded_ctus = &ref_pic->decoded_ctus;
+    uintptr_t cache_idx = ((uintptr_t)ref_pic / sizeof(*ref_pic)) % NB_PROGRESS_CACHE;
+    struct RefProgressCache *cache = &ref_progress_cache[cache_idx];
+    uint32_t decode_id = atomic_load_explicit(&decoded_ctus->decode_id, memory_order_relaxed);
+    int ctu_y;
+
+    if (cache->pic != ref_pic || cache->decode_id != decode_id) {
+        cache->pic = ref_pic;
+        cache->decode_id = decode_id;
+        cache->nb_lines_done = 0;
+    }
 
-    //TODOpar: store previous decoded_ctus of ref_pic in local memory.
-    //Avoid to fetch decoded_ctus variable when not needed.
-    int mask_w = decoded_ctus->mask_w;
-    int mask_h = decoded_ctus->mask_h;
-    uint64_t wanted_mask[mask_w];
-    xctu_to_mask(wanted_mask, mask_w, tl_ctu_x, br_ctu_x);
-
-    //TODOpar: create a mutex + ref_cnd by ctu line ?
-    uint8_t all_ctus_available;
-    do{
-        pthread_mutex_lock(&decoded_ctus->ref_mtx);
-
-        all_ctus_available = 1;
-        for(int ctu_y = tl_ctu_y; ctu_y <= br_ctu_y; ctu_y++ ){
-            for(int i = 0; i < mask_w; i++)
-                all_ctus_available = all_ctus_available && ((decoded_ctus->mask[ctu_y][i] & wanted_mask[i]) == wanted_mask[i]);
-        }
-        if(!all_ctus_available)
-        {
-            // ov_log(NULL, OVLOG_DEBUG, "Wait ref POC %d lines %d,%d \n", ref_pic->poc, tl_ctu_x, tl_ctu_y);
-            pthread_cond_wait(&decoded_ctus->ref_cnd, &decoded_ctus->ref_mtx);
-        }
+    if (br_ctu_y < cache->nb_lines_done) {
+        return;
+    }
+
+    cache->nb_lines_done = atomic_load_explicit(&decoded_ctus->nb_lines_done, memory_order_acquire);
+    if (br_ctu_y < cache->nb_lines_done) {
+        return;
+    }
 
-        pthread_mutex_unlock(&decoded_ctus->ref_mtx);
-    }while(!all_ctus_available);
+    /* Lines are reported by segments of tile width so only
+     * the CTUs read from are waited for
+     */
+    for (ctu_y = OVMAX(tl_ctu_y, cache->nb_lines_done); ctu_y <= br_ctu_y; ctu_y++) {
+        wait_ctus(&decoded_ctus->lines[ctu_y], tl_ctu_x, br_ctu_x);
+    }
 }
@@ -5,6 +5,7 @@
 #include "overror.h"
 #include "ovutils.h"
 #include "ovmem.h"
+#include "bitdepth.h"
 
 #include "nvcl.h"
 #include "nvcl_structures.h"
@@ -20,6 +21,11 @@ dpbpriv_uninit_framepool(struct DPBInternal *dpb_priv)
     int i;
     for (i = 0; i < nb_comp; ++i) {
         if (fp->plane_pool[i]) {
+            /* Planes used at once beyond the prefilled DPB size
+             * were allocated while decoding
+             */
+            ov_log(NULL, OVLOG_DEBUG, "Frame pool %d high water mark: %u planes\n",
+                   i, ovmempool_high_water_mark(fp->plane_pool[i]));
             ovmempool_uninit(&fp->plane_pool[i]);
         }
     }
@@ -28,27 +34,51 @@ dpbpriv_uninit_framepool(struct DPBInternal *dpb_priv)
 }
 
 int
-dpbpriv_init_framepool(struct DPBInternal *dpb_priv, const OVSPS *const sps)
+dpbpriv_init_framepool(struct DPBInternal *dpb_priv, const OVSPS *const sps,
+                       int margin_l)
 {
-    static const uint8_t comp_shift[3] = {0, 2, 2};
     static const uint8_t comp_shift_h[3] = {0, 1, 1};
     static const uint8_t comp_shift_v[3] = {0, 1, 1};
 
     size_t pic_w = (size_t) sps->sps_pic_width_max_in_luma_samples;
     size_t pic_h = (size_t) sps->sps_pic_height_max_in_luma_samples;
 
-    uint8_t bd_shift = !!sps->sps_bitdepth_minus8;
+    /* Samples are stored on OVSample whatever the stream bit depth */
+    uint8_t bd_shift = sizeof(OVSample) >> 1;
     /* TODO non 420 chromat_formats */
     uint8_t nb_comp = 3;
     struct FramePool *fp = &dpb_priv->frame_pool;
 
-    /* FIXME allocation size overflow */
-    size_t pic_size = (pic_w * pic_h) << bd_shift;
+    /* Planes of every picture of the DPB are allocated upfront
+     * FIXME handle temporal and sub layers
+     */
+    const OVDPBParams *dpb_prms = &sps->dpb_parameters[sps->sps_max_sublayers_minus1];
+    unsigned nb_prefill = dpb_prms->dpb_max_dec_pic_buffering_minus1 + 1;
 
     int i;
 
+    /* Pictures are stored on BITDEPTH bits so streams of other bit
+     * depths require a library configured with a matching --bitdepth
+     */
+    if (sps->sps_bitdepth_minus8 + 8 != BITDEPTH) {
+        ov_log(NULL, OVLOG_ERROR, "Stream bit depth %d unsupported by %d bits decoder build,"
+               " reconfigure with --bitdepth=%d\n",
+               sps->sps_bitdepth_minus8 + 8, BITDEPTH, sps->sps_bitdepth_minus8 + 8);
+        return OVVC_EBITDEPTH;
+    }
+
     for (i = 0; i < nb_comp; ++i) {
-        size_t elem_size = pic_size >> comp_shift[i];
+        struct PlaneProp *prop = &fp->plane_prop[i];
+        size_t plane_w = pic_w >> comp_shift_h[i];
+        size_t plane_h = pic_h >> comp_shift_v[i];
+        size_t margin  = margin_l >> comp_shift_h[i];
+
+        /* Horizontal margin is rounded so rows start on a cache line */
+        size_t margin_x = OVALIGN(margin << bd_shift, OV_FRAME_ALIGN);
+        size_t stride   = OVALIGN((plane_w << bd_shift) + 2 * margin_x, OV_FRAME_ALIGN);
+
+        /* FIXME allocation size overflow */
+        size_t elem_size = stride * (plane_h + 2 * margin);
 
         fp->plane_pool[i] = ovmempool_init(elem_size);
 
@@ -56,10 +86,21 @@ dpbpriv_init_framepool(struct DPBInternal *dpb_priv, const OVSPS *const sps)
             goto fail_poolinit;
         }
 
-        fp->plane_prop[i].stride = (pic_w << bd_shift) >> comp_shift_v[i];
-        fp->plane_prop[i].height = pic_h >> comp_shift_v[i];
-        fp->plane_prop[i].width  = pic_w >> comp_shift_h[i];
-        fp->plane_prop[i].depth  = bd_shift;
+        if (ovmempool_prefill(fp->plane_pool[i], nb_prefill) < 0) {
+            ov_log(NULL, OVLOG_WARNING, "Failed frame pool prefill\n");
+        }
+
+        /* Planes allocated above the DPB size while output pictures
+         * are held by the user are freed once released
+         */
+        ovmempool_set_max_free(fp->plane_pool[i], nb_prefill);
+
+        prop->stride = stride;
+        prop->height = plane_h;
+        prop->width  = plane_w;
+        prop->depth  = bd_shift;
+        prop->margin = margin;
+        prop->offset = margin * stride + margin_x;
     }
 
     return 0;
@@ -429,6 +429,7 @@ vvc_intra_pred(const struct OVRCNCtx *const rcn_ctx, struct OVBuffInfo* ctu_buff
 {
     const struct DCFunctions *dc = &rcn_ctx->rcn_funcs.dc;
     const struct PlanarFunctions *planar = &rcn_ctx->rcn_funcs.planar;
+    const struct AngularFunctions *angular = &rcn_ctx->rcn_funcs.angular;
 
     uint16_t ref_above[(128<<1) + 128]/*={0}*/;
     uint16_t ref_left [(128<<1) + 128]/*={0}*/;
@@ -547,15 +548,9 @@ vvc_intra_pred(const struct OVRCNCtx *const rcn_ctx, struct OVBuffInfo* ctu_buff
                             ref1[k] = ref2[OVMIN(inv_angle_sum >> 9,pu_height)];
                         }
 
-                        if (use_gauss_filter){
-                            intra_angular_v_gauss(ref1, dst, dst_stride,
-                                                  log2_pb_width, log2_pb_height,
-                                                  -abs_angle_val);
-                        } else {
-                            intra_angular_v_cubic(ref1, dst, dst_stride,
-                                                  log2_pb_width, log2_pb_height,
-                                                  -abs_angle_val);
-                        }
+                        angular->v[use_gauss_filter][log2_pb_width](ref1, dst, dst_stride,
+                                                                    log2_pb_width, log2_pb_height,
+                                                                    -abs_angle_val);
                     }
                 } else if (OVMIN(2, log2_pb_height - (floor_log2(3*inverse_angle_table[mode_idx] - 2) - 8)) < 0 ){
                     //FIXME check this
@@ -572,15 +567,9 @@ vvc_intra_pred(const struct OVRCNCtx *const rcn_ctx, struct OVBuffInfo* ctu_buff
                                                log2_pb_width, log2_pb_height,
                                                abs_angle_val);
                     } else {
-                        if (use_gauss_filter){
-                            intra_angular_v_gauss(ref1, dst, dst_stride,
-                                                  log2_pb_width, log2_pb_height,
-                                                  abs_angle_val);
-                        } else {
-                            intra_angular_v_cubic(ref1, dst, dst_stride,
-                                                  log2_pb_width, log2_pb_height,
-                                                  abs_angle_val);
-                        }
+                        angular->v[use_gauss_filter][log2_pb_width](ref1, dst, dst_stride,
+                                                                    log2_pb_width, log2_pb_height,
+                                                                    abs_angle_val);
                     }
                 } else {
                     uint8_t req_frac = !!(angle_table[mode_idx] & 0x1F);
@@ -599,15 +588,9 @@ vvc_intra_pred(const struct OVRCNCtx *const rcn_ctx, struct OVBuffInfo* ctu_buff
                                                     log2_pb_width, log2_pb_height,
                                                     mode_idx);
                     } else {
-                        if (use_gauss_filter){
-                            intra_angular_v_gauss_pdpc(ref1, ref2, dst, dst_stride,
-                                                       log2_pb_width, log2_pb_height,
-                                                       mode_idx);
-                        } else {
-                            intra_angular_v_cubic_pdpc(ref1, ref2, dst, dst_stride,
-                                                  log2_pb_width, log2_pb_height,
-                                                  mode_idx);
-                        }
+                        angular->v_pdpc[use_gauss_filter][log2_pb_width](ref1, ref2, dst, dst_stride,
+                                                                         log2_pb_width, log2_pb_height,
+                                                                         mode_idx);
                     }
                 }
                 break;
@@ -678,15 +661,9 @@ vvc_intra_pred(const struct OVRCNCtx *const rcn_ctx, struct OVBuffInfo* ctu_buff
                             inv_angle_sum += inv_angle;
                             ref2[k] = ref1[OVMIN(inv_angle_sum >> 9,pu_width)];
                         }
-                        if (use_gauss_filter){
-                            intra_angular_h_gauss(ref2, dst, dst_stride,
-                                                  log2_pb_width, log2_pb_height,
-                                                  -abs_angle_val);
-                        } else {
-                            intra_angular_h_cubic(ref2, dst, dst_stride,
-                                                  log2_pb_width, log2_pb_height,
-                                                  -abs_angle_val);
-                        }
+                        angular->h[use_gauss_filter][log2_pb_height](ref2, dst, dst_stride,
+                                                                     log2_pb_width, log2_pb_height,
+                                                                     -abs_angle_val);
                     }
 
                 } else if (OVMIN(2, log2_pb_width - (floor_log2(3*inverse_angle_table[mode_idx] - 2) - 8)) < 0 ){//FIXME check this
@@ -704,15 +681,9 @@ vvc_intra_pred(const struct OVRCNCtx *const rcn_ctx, struct OVBuffInfo* ctu_buff
                                                 log2_pb_width, log2_pb_height,
                                                 abs_angle_val);
                     } else {
-                        if (use_gauss_filter){
-                        intra_angular_h_gauss(ref2, dst, dst_stride,
-                                         log2_pb_width, log2_pb_height,
-                                         abs_angle_val);
-                        } else {
-                            intra_angular_h_cubic(ref2, dst, dst_stride,
-                                                  log2_pb_width, log2_pb_height,
-                                                  abs_angle_val);
-                        }
+                        angular->h[use_gauss_filter][log2_pb_height](ref2, dst, dst_stride,
+                                                                     log2_pb_width, log2_pb_height,
+                                                                     abs_angle_val);
                     }
                 } else {
                     uint8_t req_frac = !!(angle_table[mode_idx] & 0x1F);
@@ -731,15 +702,9 @@ vvc_intra_pred(const struct OVRCNCtx *const rcn_ctx, struct OVBuffInfo* ctu_buff
                                                     log2_pb_width, log2_pb_height,
                                                     mode_idx);
                     } else {
-                        if (use_gauss_filter){
-                        intra_angular_h_gauss_pdpc(ref1, ref2, dst, dst_stride,
-                                             log2_pb_width, log2_pb_height,
-                                             mode_idx);
-                        } else {
-                            intra_angular_h_cubic_pdpc(ref1, ref2, dst, dst_stride,
-                                                  log2_pb_width, log2_pb_height,
-                                                  mode_idx);
-                        }
+                        angular->h_pdpc[use_gauss_filter][log2_pb_height](ref1, ref2, dst, dst_stride,
+                                                                          log2_pb_width, log2_pb_height,
+                                                                          mode_idx);
                     }
                 }
             }
@@ -264,9 +264,12 @@ store_inter_maps(const struct DRVLines *const l,
     uint64_t above_map1 = lns->dir1[ctb_x + 1];
     uint64_t affine_map = lns->affine[ctb_x + 1];
 
-    above_map0 |= (uint64_t)lns->dir0 [ctb_x + 2] << nb_units_ctb;
-    above_map1 |= (uint64_t)lns->dir1 [ctb_x + 2] << nb_units_ctb;
-    affine_map |= (uint64_t)lns->affine[ctb_x + 2] << nb_units_ctb;
+    /* Above right CTU is not available with entropy coding sync */
+    if (!ctudec->entropy_sync) {
+        above_map0 |= (uint64_t)lns->dir0 [ctb_x + 2] << nb_units_ctb;
+        above_map1 |= (uint64_t)lns->dir1 [ctb_x + 2] << nb_units_ctb;
+        affine_map |= (uint64_t)lns->affine[ctb_x + 2] << nb_units_ctb;
+    }
 
     if (is_last) {
        above_map0 = 0;
@@ -758,9 +761,11 @@ load_first_ctu_inter(const struct DRVLines *const l,
     uint64_t above_map1 = lns->dir1[0];
     uint64_t affine_map = lns->affine[0];
 
-    above_map0 |= (uint64_t)lns->dir0[1] << nb_unit_ctb;
-    above_map1 |= (uint64_t)lns->dir1[1] << nb_unit_ctb;
-    affine_map |= (uint64_t)lns->affine[1] << nb_unit_ctb;
+    if (!ctudec->entropy_sync) {
+        above_map0 |= (uint64_t)lns->dir0[1] << nb_unit_ctb;
+        above_map1 |= (uint64_t)lns->dir1[1] << nb_unit_ctb;
+        affine_map |= (uint64_t)lns->affine[1] << nb_unit_ctb;
+    }
 
     int i;
 
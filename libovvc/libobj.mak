@@ -22,6 +22,7 @@ LIB_SRC:=																																 \
 					nvcl_rpl.c                                                     \
 					ovdec.c                                                        \
 					ovutils.c                                                      \
+					ovcpu.c                                                        \
 					ovmem.c                                                        \
 					overror.c																										   \
 					ovdmx.c                                                        \
@@ -66,4 +67,6 @@ LIB_SRC:=																																 \
 LIB_HEADER:=ovdefs.h       \
 						ovunits.h      \
 						ovdec.h        \
+						ovdmx.h        \
+						ovio.h         \
 						ovframe.h
@@ -1,79 +1,262 @@
 #include "ovmem.h"
+#include "overror.h"
 
 #include "mempool_internal.h"
 #include "mempool.h"
 
+/* The stack head holds the index + 1 of its first element in its
+ * lower half and the ABA tag in its upper half so it does not
+ * depend on the number of bits used by pointers
+ */
+#define HEAD_IDX(head) ((uint32_t)((head) & 0xFFFFFFFFu))
+#define HEAD_TAG(head) ((uint32_t)((head) >> 32))
+
+#define MEMPOOL_MAX_ELEMS (MEMPOOL_MAX_SEGS * MEMPOOL_SEG_SIZE)
 
 static void ovmempool_free(MemPool *mpool);
 
+/* Index of the cache used by current thread in every pool */
+static atomic_uint mempool_nb_threads;
+static _Thread_local int mempool_mag_idx = -1;
+
+static inline uint64_t
+pack_head(uint32_t idx_plus1, uint32_t tag)
+{
+    return (uint64_t)idx_plus1 | ((uint64_t)tag << 32);
+}
+
+static inline MemPoolElem *
+elem_at(MemPool *mpool, uint32_t idx)
+{
+    MemPoolElem *seg = atomic_load_explicit(&mpool->segs[idx >> MEMPOOL_LOG2_SEG_SIZE],
+                                            memory_order_acquire);
+
+    return &seg[idx & (MEMPOOL_SEG_SIZE - 1)];
+}
+
+static inline int
+thread_mag_idx(void)
+{
+    if (mempool_mag_idx < 0) {
+        unsigned th_idx = atomic_fetch_add_explicit(&mempool_nb_threads, 1, memory_order_relaxed);
+        mempool_mag_idx = th_idx % MEMPOOL_NB_MAGS;
+    }
+
+    return mempool_mag_idx;
+}
 
 MemPool *
 ovmempool_init(size_t elem_size)
 {
     struct MemPool *mpool = ov_mallocz(sizeof(*mpool));
+    int i;
+
     if (!mpool) {
         goto failalloc;
     }
 
     mpool->elem_size = elem_size;
 
+    atomic_init(&mpool->stack_head, 0);
+    atomic_init(&mpool->nb_elems, 0);
+    atomic_init(&mpool->nb_free, 0);
+    atomic_init(&mpool->high_water_mark, 0);
+
+    for (i = 0; i < MEMPOOL_MAX_SEGS; ++i) {
+        atomic_init(&mpool->segs[i], NULL);
+    }
+
+    for (i = 0; i < MEMPOOL_NB_MAGS; ++i) {
+        atomic_init(&mpool->mag_slots[i], &mpool->mags[i]);
+    }
+
     /* The pool keeps a ref to itself so we avoid freeing it
        while some of its elements can still point to it
        the pool will be freed only when all allocated elements
        have returned to it and ovmem_pool_uninit() has been called*/
-    mpool->nb_ref = 1;
+    atomic_init(&mpool->nb_ref, 1);
 
 failalloc:
     return mpool;
 }
 
+/* Take a new element from the current segment, the segment
+ * is allocated by the first thread requiring it
+ */
+static MemPoolElem *
+mempool_new_elem(MemPool *mpool)
+{
+    uint32_t idx = atomic_fetch_add_explicit(&mpool->nb_elems, 1, memory_order_relaxed);
+    _Atomic(MemPoolElem *) *seg_p;
+    MemPoolElem *seg;
+    MemPoolElem *elem;
+
+    if (idx >= MEMPOOL_MAX_ELEMS) {
+        return NULL;
+    }
+
+    seg_p = &mpool->segs[idx >> MEMPOOL_LOG2_SEG_SIZE];
+    seg = atomic_load_explicit(seg_p, memory_order_acquire);
+    if (!seg) {
+        MemPoolElem *new_seg = ov_mallocz(sizeof(*new_seg) * MEMPOOL_SEG_SIZE);
+        if (!new_seg) {
+            return NULL;
+        }
+
+        if (atomic_compare_exchange_strong_explicit(seg_p, &seg, new_seg,
+                                                    memory_order_acq_rel,
+                                                    memory_order_acquire)) {
+            seg = new_seg;
+        } else {
+            ov_free(new_seg);
+        }
+    }
+
+    elem = &seg[idx & (MEMPOOL_SEG_SIZE - 1)];
+
+    /* Keep track of parent pool so elem can be released
+       without knowledge of responsible mempool */
+    elem->mempool = mpool;
+    elem->idx = idx;
+    atomic_init(&elem->next_idx, 0);
+
+    return elem;
+}
+
+/* Note elements are never freed while the pool is alive so
+ * reading next_idx of an element popped by another thread
+ * is safe, the tag makes the exchange fail in this case
+ */
+static MemPoolElem *
+stack_pop(MemPool *mpool)
+{
+    uint64_t head = atomic_load_explicit(&mpool->stack_head, memory_order_acquire);
+    MemPoolElem *elem;
+    uint64_t next;
+
+    do {
+        if (!HEAD_IDX(head)) {
+            return NULL;
+        }
+        elem = elem_at(mpool, HEAD_IDX(head) - 1);
+        next = pack_head(atomic_load_explicit(&elem->next_idx, memory_order_relaxed),
+                         HEAD_TAG(head) + 1);
+    } while (!atomic_compare_exchange_weak_explicit(&mpool->stack_head, &head, next,
+                                                    memory_order_acq_rel,
+                                                    memory_order_acquire));
+
+    return elem;
+}
+
+static void
+stack_push(MemPool *mpool, MemPoolElem *elem)
+{
+    uint64_t head = atomic_load_explicit(&mpool->stack_head, memory_order_relaxed);
+    uint64_t next;
+
+    do {
+        atomic_store_explicit(&elem->next_idx, HEAD_IDX(head), memory_order_relaxed);
+        next = pack_head(elem->idx + 1, HEAD_TAG(head) + 1);
+    } while (!atomic_compare_exchange_weak_explicit(&mpool->stack_head, &head, next,
+                                                    memory_order_release,
+                                                    memory_order_relaxed));
+}
+
+/* Elements of which data allocation failed are kept in the
+ * stack without data so their index is not lost
+ */
+static MemPoolElem *
+mempool_alloc_elem(MemPool *mpool, MemPoolElem *elem)
+{
+    if (!elem) {
+        elem = mempool_new_elem(mpool);
+        if (!elem) {
+            return NULL;
+        }
+    }
+
+    elem->data = ov_mallocz(mpool->elem_size);
+    if (!elem->data) {
+        stack_push(mpool, elem);
+        return NULL;
+    }
+
+    return elem;
+}
+
+static void
+update_high_water_mark(MemPool *mpool, unsigned nb_used)
+{
+    unsigned hwm = atomic_load_explicit(&mpool->high_water_mark, memory_order_relaxed);
+
+    while (nb_used > hwm &&
+           !atomic_compare_exchange_weak_explicit(&mpool->high_water_mark, &hwm, nb_used,
+                                                  memory_order_relaxed,
+                                                  memory_order_relaxed));
+}
+
 MemPoolElem *
 ovmempool_popelem(MemPool *mpool)
 {
-    pthread_mutex_lock(&mpool->pool_mtx);
+    int mag_idx = thread_mag_idx();
+    struct MemPoolMag *mag;
+    MemPoolElem *elem = NULL;
+    int nb_used;
+
+    /* Try current thread cache first, it might be held by
+     * another thread sharing the same index
+     */
+    mag = atomic_exchange_explicit(&mpool->mag_slots[mag_idx], NULL, memory_order_acquire);
+    if (mag) {
+        if (mag->nb_elems) {
+            elem = mag->elems[--mag->nb_elems];
+        }
+        atomic_store_explicit(&mpool->mag_slots[mag_idx], mag, memory_order_release);
+    }
+
+    if (!elem) {
+        elem = stack_pop(mpool);
+    }
 
-    MemPoolElem *elem = mpool->stack_elem;
-    if (elem) {
-        mpool->stack_elem = elem->next_elem;
-        elem->next_elem = NULL;
+    if (elem && elem->data) {
+        atomic_fetch_sub_explicit(&mpool->nb_free, 1, memory_order_relaxed);
     } else {
-        elem = ov_mallocz(sizeof(*elem));
+        elem = mempool_alloc_elem(mpool, elem);
         if (!elem) {
-            goto ret_and_unlock;
-        }
-        /* Keep track of parent pool so elem can be released
-           without knowledge of responsible mempool */
-        elem->mempool = mpool;
-
-        elem->data = ov_mallocz(mpool->elem_size);
-        if (!elem->data) {
-            ov_freep(&elem);
-            goto ret_and_unlock;
+            return NULL;
         }
     }
 
     /* Keep track of ref in use so we avoid freeing the
        mempool if some of its elements did not return */
-    mpool->nb_ref++;
+    nb_used = atomic_fetch_add_explicit(&mpool->nb_ref, 1, memory_order_acq_rel);
+
+    update_high_water_mark(mpool, nb_used);
 
-ret_and_unlock:
-    pthread_mutex_unlock(&mpool->pool_mtx);
     return elem;
 }
 
 static void
 ovmempool_free(MemPool *mpool)
 {
-    MemPoolElem *stack_elem = mpool->stack_elem;
+    int i;
 
-    while (stack_elem) {
-        /* Free all elements directly available in the pool */
-        MemPoolElem *next_to_free = stack_elem->next_elem;
+    /* Every element returned to the pool so all elements of
+     * the segments are either in the stack or in the caches
+     */
+    for (i = 0; i < MEMPOOL_MAX_SEGS; ++i) {
+        MemPoolElem *seg = atomic_load_explicit(&mpool->segs[i], memory_order_acquire);
+        int j;
 
-        ov_free(stack_elem->data);
-        ov_free(stack_elem);
+        if (!seg) {
+            continue;
+        }
+
+        for (j = 0; j < MEMPOOL_SEG_SIZE; ++j) {
+            ov_free(seg[j].data);
+        }
 
-        stack_elem = next_to_free;
+        ov_free(seg);
     }
 
     ov_freep(&mpool);
@@ -81,29 +264,78 @@ ovmempool_free(MemPool *mpool)
 
 void
 ovmempool_pushelem(MemPoolElem *released_elem)
-{  
+{
     if (released_elem) {
         MemPool *mpool = released_elem->mempool;
-        pthread_mutex_lock(&mpool->pool_mtx);
+        unsigned nb_free = atomic_load_explicit(&mpool->nb_free, memory_order_relaxed);
+
+        if (mpool->max_free && nb_free >= mpool->max_free) {
+            /* Element index is kept in the stack without data
+             * so it can be reused by a later allocation
+             */
+            ov_freep(&released_elem->data);
+            stack_push(mpool, released_elem);
+        } else {
+            int mag_idx = thread_mag_idx();
+            struct MemPoolMag *mag;
+
+            atomic_fetch_add_explicit(&mpool->nb_free, 1, memory_order_relaxed);
+
+            mag = atomic_exchange_explicit(&mpool->mag_slots[mag_idx], NULL, memory_order_acquire);
+            if (mag && mag->nb_elems < MEMPOOL_MAG_SIZE) {
+                mag->elems[mag->nb_elems++] = released_elem;
+                released_elem = NULL;
+            }
+
+            if (mag) {
+                atomic_store_explicit(&mpool->mag_slots[mag_idx], mag, memory_order_release);
+            }
+
+            if (released_elem) {
+                stack_push(mpool, released_elem);
+            }
+        }
 
-        released_elem->next_elem = mpool->stack_elem;
-        mpool->stack_elem = released_elem;
-        mpool->nb_ref--;
-        if (!mpool->nb_ref) {
+        if (atomic_fetch_sub_explicit(&mpool->nb_ref, 1, memory_order_acq_rel) == 1) {
             ovmempool_free(mpool);
         }
-        pthread_mutex_unlock(&mpool->pool_mtx);
     }
 }
 
+int
+ovmempool_prefill(MemPool *mpool, unsigned nb_elems)
+{
+    while (atomic_load_explicit(&mpool->nb_free, memory_order_relaxed) < nb_elems) {
+        MemPoolElem *elem = mempool_alloc_elem(mpool, NULL);
+        if (!elem) {
+            return OVVC_ENOMEM;
+        }
+
+        atomic_fetch_add_explicit(&mpool->nb_free, 1, memory_order_relaxed);
+        stack_push(mpool, elem);
+    }
+
+    return 0;
+}
+
+void
+ovmempool_set_max_free(MemPool *mpool, unsigned max_free)
+{
+    mpool->max_free = max_free;
+}
+
+unsigned
+ovmempool_high_water_mark(const MemPool *mpool)
+{
+    return atomic_load_explicit(&mpool->high_water_mark, memory_order_relaxed);
+}
+
 void
 ovmempool_uninit(MemPool **mpool_p)
 {
     MemPool *mpool = *mpool_p;
 
-    mpool->nb_ref--;
-
-    if (!mpool->nb_ref) {
+    if (atomic_fetch_sub_explicit(&mpool->nb_ref, 1, memory_order_acq_rel) == 1) {
         ovmempool_free(mpool);
     }
 
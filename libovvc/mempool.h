@@ -15,4 +15,19 @@ void ovmempool_pushelem(MemPoolElem *released_elem);
 
 void ovmempool_uninit(MemPool **mpool_p);
 
+/* Allocate elements until at least nb_elems are available
+ * so that following requests do not require allocations
+ */
+int ovmempool_prefill(MemPool *mpool, unsigned nb_elems);
+
+/* Free the data of released elements instead of keeping them
+ * when max_free elements are already available (0 for no limit)
+ */
+void ovmempool_set_max_free(MemPool *mpool, unsigned max_free);
+
+/* Maximum number of elements simultaneously in use since pool
+ * initialisation
+ */
+unsigned ovmempool_high_water_mark(const MemPool *mpool);
+
 #endif
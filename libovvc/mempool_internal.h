@@ -1,21 +1,80 @@
 #ifndef OV_MEMPOOL_INTERNAL_H
 #define OV_MEMPOOL_INTERNAL_H
 #include <stddef.h>
-#include <pthread.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+/* Number of per thread caches of a pool */
+#define MEMPOOL_NB_MAGS 16
+
+/* Number of free elements kept in a thread cache */
+#define MEMPOOL_MAG_SIZE 8
+
+/* Elements are allocated by segments of MEMPOOL_SEG_SIZE so they
+ * can be referred to by their index in the pool
+ */
+#define MEMPOOL_LOG2_SEG_SIZE 6
+#define MEMPOOL_SEG_SIZE (1 << MEMPOOL_LOG2_SEG_SIZE)
+#define MEMPOOL_MAX_SEGS 256
 
 struct MemPoolElem
 {
     struct MemPool *mempool;
     void *data;
-    struct MemPoolElem *next_elem;
+
+    /* Index of the element in its pool */
+    uint32_t idx;
+
+    /* Index + 1 of next element in the stack (0 if last),
+     * read concurrently by threads popping from the stack
+     */
+    atomic_uint next_idx;
+};
+
+/* Small stack of free elements used by one thread at a time
+ * in front of the shared stack
+ */
+struct MemPoolMag
+{
+    int nb_elems;
+    struct MemPoolElem *elems[MEMPOOL_MAG_SIZE];
 };
 
 struct MemPool
 {
-    struct MemPoolElem *stack_elem;
+    /* Lock free stack of free elements, the index + 1 of its
+     * first element is stored in the lower 32 bits and a tag
+     * incremented on each change to prevent ABA issues in the
+     * upper 32 bits
+     */
+    atomic_uint_least64_t stack_head;
+
+    /* Segments of elements, never freed before the pool so
+     * elements popped by other threads can still be read
+     */
+    _Atomic(struct MemPoolElem *) segs[MEMPOOL_MAX_SEGS];
+    atomic_uint nb_elems;
+
+    /* Threads take ownership of their cache by swapping it
+     * with NULL so no lock is required
+     */
+    _Atomic(struct MemPoolMag *) mag_slots[MEMPOOL_NB_MAGS];
+    struct MemPoolMag mags[MEMPOOL_NB_MAGS];
+
     size_t elem_size;
-    int nb_ref;
-    pthread_mutex_t pool_mtx;
+
+    atomic_int nb_ref;
+
+    /* Number of elements available in caches and stack */
+    atomic_uint nb_free;
+
+    /* Data of elements released while nb_free is above this
+     * limit is freed (0 for no limit)
+     */
+    unsigned max_free;
+
+    /* Maximum number of elements simultaneously in use */
+    atomic_uint high_water_mark;
 };
 
 #endif
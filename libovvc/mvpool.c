@@ -25,7 +25,7 @@ init_mv_pool(struct MVPool *const mv_pool, const struct PicPartInfo *const pinfo
 
     mv_pool->mv_pool = ovmempool_init(elem_size);
 
-    if (!mv_pool->dir_pool) {
+    if (!mv_pool->mv_pool) {
        return OVVC_ENOMEM;
     }
 
@@ -49,7 +49,8 @@ init_dir_field_pool(struct MVPool *const mv_pool, const struct PicPartInfo *cons
 }
 
 int
-mvpool_init(struct MVPool **mv_pool_p, const struct PicPartInfo *const pinfo)
+mvpool_init(struct MVPool **mv_pool_p, const struct PicPartInfo *const pinfo,
+            unsigned nb_prefill)
 {
     struct MVPool *mv_pool;
     int ret;
@@ -71,6 +72,14 @@ mvpool_init(struct MVPool **mv_pool_p, const struct PicPartInfo *const pinfo)
         goto fail_mv;
     }
 
+    if (ovmempool_prefill(mv_pool->mv_pool, nb_prefill) < 0 ||
+        ovmempool_prefill(mv_pool->dir_pool, nb_prefill) < 0) {
+        ov_log(NULL, OVLOG_WARNING, "Failed MV pool prefill\n");
+    }
+
+    ovmempool_set_max_free(mv_pool->mv_pool, nb_prefill);
+    ovmempool_set_max_free(mv_pool->dir_pool, nb_prefill);
+
     return 0;
 
 fail_mv :
@@ -87,6 +96,9 @@ mvpool_uninit(struct MVPool **mv_pool_p)
 {
     struct MVPool *mv_pool = *mv_pool_p;
 
+    ov_log(NULL, OVLOG_DEBUG, "MV pool high water mark: %u planes\n",
+           ovmempool_high_water_mark(mv_pool->mv_pool));
+
     ovmempool_uninit(&mv_pool->dir_pool);
 
     ovmempool_uninit(&mv_pool->mv_pool);
@@ -1,3 +1,6 @@
+#include <string.h>
+#include <stdatomic.h>
+
 #include "ovmem.h"
 
 #include "nvcl.h"
@@ -5,6 +8,32 @@
 
 #define NB_ARRAY_ELEMS(x) sizeof(x)/sizeof(*(x))
 
+/* Hidden header in front of every parameter set allocated with
+ * nvcl_ps_alloc()
+ * The RBSP the parameter set was read from is kept so that a
+ * re-sent parameter set can be detected without parsing it again.
+ */
+struct PSHeader
+{
+    atomic_int ref_count;
+
+    /* Unique identifier of the parameter set used as key by
+     * states derived from it
+     */
+    uint64_t uid;
+
+    uint32_t rbsp_hash;
+    uint32_t rbsp_size;
+    uint8_t *rbsp_data;
+};
+
+/* Keep parameter sets aligned as if returned by ov_malloc */
+#define PS_HEADER_SIZE ((sizeof(struct PSHeader) + ALIGN - 1) & ~(ALIGN - 1))
+
+#define PS_HEADER(ps) ((struct PSHeader *)((uint8_t *)(ps) - PS_HEADER_SIZE))
+
+static atomic_ullong nb_ps_alloc;
+
 
 /* FIXME give size in bytes instead and find SODB end
  * (RBSP stop bit) here instead
@@ -30,45 +59,158 @@ nvcl_reader_init(OVNVCLReader *rdr, const uint8_t *bytestream_start,
     return 0;
 }
 
+void *
+nvcl_ps_alloc(size_t size)
+{
+    uint8_t *buff = ov_mallocz(PS_HEADER_SIZE + size);
+    struct PSHeader *hdr = (struct PSHeader *)buff;
+
+    if (!buff) {
+        return NULL;
+    }
+
+    atomic_init(&hdr->ref_count, 1);
+
+    hdr->uid = atomic_fetch_add_explicit(&nb_ps_alloc, 1, memory_order_relaxed) + 1;
+
+    return buff + PS_HEADER_SIZE;
+}
+
+uint64_t
+nvcl_ps_uid(const void *ps)
+{
+    return ps ? PS_HEADER(ps)->uid : 0;
+}
+
+void *
+nvcl_ps_ref(void *ps)
+{
+    if (ps) {
+        atomic_fetch_add_explicit(&PS_HEADER(ps)->ref_count, 1, memory_order_relaxed);
+    }
+
+    return ps;
+}
+
+void
+nvcl_ps_unref(void *ps_ref)
+{
+    void **ps_p = (void **)ps_ref;
+    void *ps = *ps_p;
+
+    if (ps) {
+        struct PSHeader *hdr = PS_HEADER(ps);
+        if (atomic_fetch_sub_explicit(&hdr->ref_count, 1, memory_order_acq_rel) == 1) {
+            ov_free(hdr->rbsp_data);
+            ov_free(hdr);
+        }
+    }
+
+    *ps_p = NULL;
+}
+
+void
+nvcl_ps_replace(void *dst_ref, void *ps)
+{
+    void **dst_p = (void **)dst_ref;
+
+    if (*dst_p != ps) {
+        nvcl_ps_unref(dst_p);
+        *dst_p = nvcl_ps_ref(ps);
+    }
+}
+
+/* FNV-1a */
+static uint32_t
+rbsp_hash(const uint8_t *data, uint32_t size)
+{
+    uint32_t hash = 0x811C9DC5;
+    uint32_t i;
+
+    for (i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 0x01000193;
+    }
+
+    return hash;
+}
+
+/* The reader is expected to be still positioned on the NAL
+ * Unit it was initialised with
+ */
+static const uint8_t *
+reader_rbsp(const OVNVCLReader *const rdr, uint32_t *size)
+{
+    const uint8_t *rbsp = rdr->bytestream - rdr->nb_bytes_read;
+
+    *size = rdr->bytestream_end - rbsp;
+
+    return rbsp;
+}
+
+int
+nvcl_ps_set_rbsp(void *ps, const OVNVCLReader *const rdr)
+{
+    struct PSHeader *hdr = PS_HEADER(ps);
+    uint32_t size;
+    const uint8_t *rbsp = reader_rbsp(rdr, &size);
+
+    ov_freep(&hdr->rbsp_data);
+
+    hdr->rbsp_data = ov_malloc(size);
+    if (!hdr->rbsp_data) {
+        hdr->rbsp_size = 0;
+        return OV_ENOMEM;
+    }
+
+    memcpy(hdr->rbsp_data, rbsp, size);
+    hdr->rbsp_size = size;
+    hdr->rbsp_hash = rbsp_hash(rbsp, size);
+
+    return 0;
+}
+
+int
+nvcl_ps_same_rbsp(const void *ps, const OVNVCLReader *const rdr)
+{
+    const struct PSHeader *hdr = PS_HEADER(ps);
+    uint32_t size;
+    const uint8_t *rbsp = reader_rbsp(rdr, &size);
+
+    if (!hdr->rbsp_data || hdr->rbsp_size != size) {
+        return 0;
+    }
+
+    return hdr->rbsp_hash == rbsp_hash(rbsp, size) &&
+           !memcmp(hdr->rbsp_data, rbsp, size);
+}
+
 void
 nvcl_free_ctx(OVNVCLCtx *const nvcl_ctx)
 {
     int i;
     int nb_elems = NB_ARRAY_ELEMS(nvcl_ctx->sps_list);
     for (i = 0; i < nb_elems; ++i) {
-        if (nvcl_ctx->sps_list[i]) {
-            ov_freep(&nvcl_ctx->sps_list[i]);
-        }
+        nvcl_ps_unref(&nvcl_ctx->sps_list[i]);
     }
 
     nb_elems = NB_ARRAY_ELEMS(nvcl_ctx->pps_list);
     for (i = 0; i < nb_elems; ++i) {
-        if (nvcl_ctx->pps_list[i]) {
-            ov_freep(&nvcl_ctx->pps_list[i]);
-        }
+        nvcl_ps_unref(&nvcl_ctx->pps_list[i]);
     }
 
     nb_elems = NB_ARRAY_ELEMS(nvcl_ctx->alf_aps_list);
     for (i = 0; i < nb_elems; ++i) {
-        if (nvcl_ctx->alf_aps_list[i]) {
-            ov_freep(&nvcl_ctx->alf_aps_list[i]);
-        }
+        nvcl_ps_unref(&nvcl_ctx->alf_aps_list[i]);
     }
 
     nb_elems = NB_ARRAY_ELEMS(nvcl_ctx->lmcs_aps_list);
     for (i = 0; i < nb_elems; ++i) {
-        if (nvcl_ctx->lmcs_aps_list[i]) {
-            ov_freep(&nvcl_ctx->lmcs_aps_list[i]);
-        }
+        nvcl_ps_unref(&nvcl_ctx->lmcs_aps_list[i]);
     }
 
-    if (nvcl_ctx->ph) {
-        ov_freep(&nvcl_ctx->ph);
-    }
+    nvcl_ps_unref(&nvcl_ctx->ph);
 
-    if (nvcl_ctx->sh) {
-        ov_freep(&nvcl_ctx->sh);
-    }
+    nvcl_ps_unref(&nvcl_ctx->sh);
 
     if (nvcl_ctx->sei) {
         nvcl_free_sei_params(nvcl_ctx->sei);
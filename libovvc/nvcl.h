@@ -1,6 +1,7 @@
 #ifndef OV_NVCL_H
 #define OV_NVCL_H
 #include <stdint.h>
+#include <stddef.h>
 
 #include "ovdefs.h"
 
@@ -50,6 +51,33 @@ uint32_t nvcl_num_bytes_read(const OVNVCLReader *const rdr);
 
 void nvcl_free_ctx(OVNVCLCtx *const nvcl_ctx);
 
+/* Parameter sets (SPS, PPS, APS, PH and SH) are immutable once read
+ * and reference counted so decoders can share them with the NVCL
+ * context instead of copying them
+ */
+void *nvcl_ps_alloc(size_t size);
+
+void *nvcl_ps_ref(void *ps);
+
+/* Identifier unique to every allocated parameter set (0 for NULL)
+ * Contrary to addresses it is never reused and can be kept as a key
+ * for derived states without holding a reference
+ */
+uint64_t nvcl_ps_uid(const void *ps);
+
+/* Release reference and set pointer to NULL */
+void nvcl_ps_unref(void *ps_ref);
+
+/* Make *dst_ref reference ps instead of its previous parameter set */
+void nvcl_ps_replace(void *dst_ref, void *ps);
+
+/* Keep the RBSP the parameter set was read from so a re-sent
+ * identical parameter set can be detected by nvcl_ps_same_rbsp()
+ */
+int nvcl_ps_set_rbsp(void *ps, const OVNVCLReader *const rdr);
+
+int nvcl_ps_same_rbsp(const void *ps, const OVNVCLReader *const rdr);
+
 
 /* Reading functions */
 int nvcl_opi_read(OVNVCLReader *const rdr, OVOPI *const opi,
@@ -23,6 +23,26 @@ validate_aps(OVNVCLReader *rdr, OVAPS *const aps)
     return 1;
 }
 
+static OVAPS **
+probe_aps_slot(OVNVCLReader *const rdr, OVNVCLCtx *const nvcl_ctx)
+{
+    uint8_t val = fetch_bits(rdr, 8);
+    uint8_t aps_params_type = val >> 5;
+    uint8_t aps_id = val & 0x1F;
+
+    if (aps_id >= OV_MAX_NUM_APS) {
+        return NULL;
+    }
+
+    if (aps_params_type == 0) {
+        return &nvcl_ctx->alf_aps_list[aps_id];
+    } else if (aps_params_type == 1) {
+        return &nvcl_ctx->lmcs_aps_list[aps_id];
+    }
+
+    return NULL;
+}
+
 
 void 
 nvcl_read_alf_data(OVNVCLReader *const rdr, struct OVALFData* alf_data, uint8_t aps_chroma_present_flag)
@@ -184,9 +204,15 @@ int
 nvcl_decode_nalu_aps(OVNVCLReader *const rdr, OVNVCLCtx *const nvcl_ctx)
 {
     int ret;
-    /* TODO compare RBSP data to avoid new read */
+    OVAPS **aps_slot = probe_aps_slot(rdr, nvcl_ctx);
+    OVAPS *aps;
 
-    OVAPS *aps = ov_mallocz(sizeof(*aps));
+    /* Identical re-sent APS are neither read again nor replaced */
+    if (aps_slot && *aps_slot && nvcl_ps_same_rbsp(*aps_slot, rdr)) {
+        return (*aps_slot)->aps_adaptation_parameter_set_id;
+    }
+
+    aps = nvcl_ps_alloc(sizeof(*aps));
     if (!aps) {
         return OV_ENOMEM;
     }
@@ -203,18 +229,23 @@ nvcl_decode_nalu_aps(OVNVCLReader *const rdr, OVNVCLCtx *const nvcl_ctx)
         goto cleanup;
     }
 
+    ret = nvcl_ps_set_rbsp(aps, rdr);
+    if (ret < 0) {
+        goto cleanup;
+    }
+
     uint8_t aps_id = aps->aps_adaptation_parameter_set_id;
-    if (aps->aps_params_type == 0) {
-        ov_free(nvcl_ctx->alf_aps_list[aps_id]);
-        nvcl_ctx->alf_aps_list[aps_id] = aps;
-    } else if (aps->aps_params_type == 1) {
-        ov_free(nvcl_ctx->lmcs_aps_list[aps_id]);
-        nvcl_ctx->lmcs_aps_list[aps_id] = aps;
+    if (aps_slot) {
+        /* Decoders still using the previous APS keep their own reference */
+        nvcl_ps_unref(aps_slot);
+        *aps_slot = aps;
+    } else {
+        nvcl_ps_unref(&aps);
     }
     return aps_id;
 
 cleanup:
-    ov_free(aps);
+    nvcl_ps_unref(&aps);
     return ret;
 }
 
@@ -24,20 +24,11 @@ validate_ph(OVNVCLReader *rdr, OVPH *const ph)
     return 1;
 }
 
-static void
-free_ph(OVPH *const ph)
-{
-    /* TODO unref and/or free dynamic structure */
-    ov_free(ph);
-}
-
 static void
 replace_ph(OVNVCLCtx *const nvcl_ctx, OVPH *const ph)
 {
-    /* TODO unref and/or free dynamic structure */
-    OVPH *to_free = nvcl_ctx->ph;
-
-    free_ph(to_free);
+    /* Decoders still using the previous PH keep their own reference */
+    nvcl_ps_unref(&nvcl_ctx->ph);
 
     nvcl_ctx->ph = ph;
 }
@@ -48,7 +39,7 @@ nvcl_decode_nalu_ph(OVNVCLReader *const rdr, OVNVCLCtx *const nvcl_ctx)
     int ret;
     /* TODO compare RBSP data to avoid new read */
 
-    OVPH *ph = ov_mallocz(sizeof(*ph));
+    OVPH *ph = nvcl_ps_alloc(sizeof(*ph));
     if (!ph) {
         return OV_ENOMEM;
     }
@@ -63,13 +54,12 @@ nvcl_decode_nalu_ph(OVNVCLReader *const rdr, OVNVCLCtx *const nvcl_ctx)
         goto cleanup;
     }
 
-    /*FIXME unref instead of free */
     replace_ph(nvcl_ctx, ph);
 
     return 0;
 
 cleanup:
-    ov_free(ph);
+    nvcl_ps_unref(&ph);
     return ret;
 }
 
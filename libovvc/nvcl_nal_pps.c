@@ -21,20 +21,11 @@ validate_pps(OVNVCLReader *rdr, OVPPS *const pps)
     return 1;
 }
 
-static void
-free_pps(OVPPS *const pps)
-{
-    /* TODO unref and/or free dynamic structure */
-    ov_free(pps);
-}
-
 static void
 replace_pps(OVPPS *pps_list[], OVPPS *const pps, uint8_t pps_id)
 {
-    /* TODO unref and/or free dynamic structure */
-    OVPPS *to_free = pps_list[pps_id];
-
-    free_pps(to_free);
+    /* Decoders still using the previous PPS keep their own reference */
+    nvcl_ps_unref(&pps_list[pps_id]);
 
     pps_list[pps_id] = pps;
 }
@@ -47,14 +38,15 @@ nvcl_decode_nalu_pps(OVNVCLReader *const rdr, OVNVCLCtx *const nvcl_ctx)
     OVPPS *pps;
     OVPPS **pps_list = nvcl_ctx->pps_list;
     if (pps_list[pps_id]) {
-        /* TODO compare RBSP data to avoid new read */
-        uint8_t identical_rbsp = 0;
-        if (identical_rbsp) {
+        /* Identical re-sent PPS are neither read again nor
+         * replaced so the active one is kept
+         */
+        if (nvcl_ps_same_rbsp(pps_list[pps_id], rdr)) {
             goto duplicated;
         }
     }
 
-    pps = ov_mallocz(sizeof(*pps));
+    pps = nvcl_ps_alloc(sizeof(*pps));
     if (!pps) {
         return OV_ENOMEM;
     }
@@ -69,13 +61,17 @@ nvcl_decode_nalu_pps(OVNVCLReader *const rdr, OVNVCLCtx *const nvcl_ctx)
         goto cleanup;
     }
 
-    /*FIXME unref instead of free */
+    ret = nvcl_ps_set_rbsp(pps, rdr);
+    if (ret < 0) {
+        goto cleanup;
+    }
+
     replace_pps(pps_list, pps, pps_id);
 
     return 0;
 
 cleanup:
-    ov_free(pps);
+    nvcl_ps_unref(&pps);
     return ret;
 
 duplicated:
@@ -24,20 +24,11 @@ validate_sps(OVNVCLReader *rdr, OVSPS *const sps)
     return 1;
 }
 
-static void
-free_sps(OVSPS *const sps)
-{
-    /* TODO unref and/or free dynamic structure */
-    ov_free(sps);
-}
-
 static void
 replace_sps(OVSPS *sps_list[], OVSPS *const sps, uint8_t sps_id)
 {
-    /* TODO unref and/or free dynamic structure */
-    OVSPS *to_free = sps_list[sps_id];
-
-    free_sps(to_free);
+    /* Decoders still using the previous SPS keep their own reference */
+    nvcl_ps_unref(&sps_list[sps_id]);
 
     sps_list[sps_id] = sps;
 }
@@ -51,14 +42,15 @@ nvcl_decode_nalu_sps(OVNVCLReader *const rdr, OVNVCLCtx *const nvcl_ctx)
     OVSPS *sps;
 
     if (sps_list[sps_id]) {
-        /* TODO compare RBSP data to avoid new read */
-        uint8_t identical_rbsp = 0;
-        if (identical_rbsp) {
+        /* Identical re-sent SPS are neither read again nor
+         * replaced so the active one is kept
+         */
+        if (nvcl_ps_same_rbsp(sps_list[sps_id], rdr)) {
             goto duplicated;
         }
     }
 
-    sps = ov_mallocz(sizeof(*sps));
+    sps = nvcl_ps_alloc(sizeof(*sps));
     if (!sps) {
         return OV_ENOMEM;
     }
@@ -73,13 +65,17 @@ nvcl_decode_nalu_sps(OVNVCLReader *const rdr, OVNVCLCtx *const nvcl_ctx)
         goto cleanup;
     }
 
-    /*FIXME unref instead of free */
+    ret = nvcl_ps_set_rbsp(sps, rdr);
+    if (ret < 0) {
+        goto cleanup;
+    }
+
     replace_sps(sps_list, sps, sps_id);
 
     return 0;
 
 cleanup:
-    ov_free(sps);
+    nvcl_ps_unref(&sps);
     return ret;
 
 duplicated:
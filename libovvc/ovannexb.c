@@ -1,3 +1,7 @@
+#include <string.h>
+
+#include "ovconfig.h"
+#include "ovcpu.h"
 #include "ovannexb.h"
 #include "ovunits.h"
 
@@ -52,6 +56,92 @@ invalid_data:
     return -1;
 }
 
+static inline int
+is_candidate(const uint8_t *byte)
+{
+    return !byte[0] && !byte[1] && byte[2] <= 0x3;
+}
+
+/* Detect if one of the bytes of a 64 bits word is zero */
+static inline uint64_t
+has_zero_byte(uint64_t word)
+{
+    return (word - 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL;
+}
+
+static const uint8_t *
+find_candidate_c(const uint8_t *byte, const uint8_t *end)
+{
+    /* A candidate starts with a zero byte so we skip words
+     * not containing any
+     */
+    while (byte + 8 <= end) {
+        uint64_t word;
+        memcpy(&word, byte, sizeof(word));
+        if (has_zero_byte(word)) {
+            int i;
+            for (i = 0; i < 8; ++i) {
+                if (is_candidate(byte + i)) {
+                    return byte + i;
+                }
+            }
+        }
+        byte += 8;
+    }
+
+    while (byte < end) {
+        if (is_candidate(byte)) {
+            return byte;
+        }
+        byte++;
+    }
+
+    return byte;
+}
+
+#if ARCH_X86 && SSE_ENABLED
+static const uint8_t *
+find_candidate_sse(const uint8_t *byte, const uint8_t *end)
+{
+    byte = ovannexb_find_candidate_sse(byte, end);
+
+    /* Remaining bytes and candidate check */
+    return find_candidate_c(byte, end);
+}
+#endif
+
+#if ARCH_X86 && AVX_ENABLED
+static const uint8_t *
+find_candidate_avx2(const uint8_t *byte, const uint8_t *end)
+{
+    byte = ovannexb_find_candidate_avx2(byte, end);
+
+    /* Less than 34 bytes remain */
+    byte = ovannexb_find_candidate_sse(byte, end);
+
+    return find_candidate_c(byte, end);
+}
+#endif
+
+OVAnnexBScanFunc
+ovannexb_scan_function(int cpu_flags)
+{
+    #if ARCH_X86 && AVX_ENABLED
+    if (cpu_flags & OV_CPU_AVX2) {
+        return &find_candidate_avx2;
+    }
+    #endif
+
+    /* Kernel file is built with SSE4.1 code generation */
+    #if ARCH_X86 && SSE_ENABLED
+    if (cpu_flags & OV_CPU_SSE4_1) {
+        return &find_candidate_sse;
+    }
+    #endif
+
+    return &find_candidate_c;
+}
+
 int
 dmx_process_elem(OVVCDmx *const dmx, const uint8_t *const bytestream,
         uint64_t byte_pos, int stc_or_epb)
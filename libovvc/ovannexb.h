@@ -7,6 +7,26 @@
 
 int ovannexb_check_stc_or_epb(const uint8_t *byte);
 
+/* Returns the position of the first 0x00 0x00 0x0X (X <= 3) byte
+ * sequence starting at or after byte and before end, or end when
+ * none is found (byte if byte is already past end).
+ * Candidates still have to be checked by ovannexb_check_stc_or_epb()
+ * Up to 2 bytes after end are read.
+ */
+typedef const uint8_t *(*OVAnnexBScanFunc)(const uint8_t *byte, const uint8_t *end);
+
+/* Candidate scanner for the instruction sets given in cpu_flags
+ * (see enum OVCPUFlags)
+ */
+OVAnnexBScanFunc ovannexb_scan_function(int cpu_flags);
+
+/* SIMD scanner, returns the first candidate found or the position
+ * where less than a vector of bytes remain to be scanned before end
+ */
+const uint8_t *ovannexb_find_candidate_sse(const uint8_t *byte, const uint8_t *end);
+
+const uint8_t *ovannexb_find_candidate_avx2(const uint8_t *byte, const uint8_t *end);
+
 int dmx_process_elem(OVVCDmx *const dmx,
                      const uint8_t *const bytestream,
                      uint64_t byte_pos,
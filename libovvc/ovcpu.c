@@ -0,0 +1,154 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "ovconfig.h"
+#include "ovutils.h"
+#include "ovdec.h"
+#include "ovcpu.h"
+
+#if ARCH_X86
+#include <cpuid.h>
+#endif
+
+static pthread_once_t cpu_once = PTHREAD_ONCE_INIT;
+static int cpu_flags;
+
+#if ARCH_X86
+static uint64_t
+xgetbv(uint32_t idx)
+{
+    uint32_t eax, edx;
+    __asm__ volatile ("xgetbv" : "=a"(eax), "=d"(edx) : "c"(idx));
+    return ((uint64_t)edx << 32) | eax;
+}
+
+static int
+detect_cpu_flags(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    unsigned int max_leaf;
+    int flags = 0;
+
+    max_leaf = __get_cpuid_max(0, NULL);
+    if (max_leaf < 1) {
+        return 0;
+    }
+
+    __cpuid(1, eax, ebx, ecx, edx);
+
+    if (edx & bit_SSE2) {
+        flags |= OV_CPU_SSE2;
+    }
+
+    if (ecx & bit_SSSE3) {
+        flags |= OV_CPU_SSSE3;
+    }
+
+    if (ecx & bit_SSE4_1) {
+        flags |= OV_CPU_SSE4_1;
+    }
+
+    /* AVX registers must also be saved by the OS on context switch */
+    if ((ecx & bit_OSXSAVE) && (ecx & bit_AVX) && (xgetbv(0) & 0x6) == 0x6) {
+        if (max_leaf >= 7) {
+            __cpuid_count(7, 0, eax, ebx, ecx, edx);
+            if (ebx & bit_AVX2) {
+                flags |= OV_CPU_AVX2;
+            }
+        }
+    }
+
+    return flags;
+}
+#elif ARCH_AARCH64
+static int
+detect_cpu_flags(void)
+{
+    /* NEON is mandatory on AArch64 */
+    return OV_CPU_NEON;
+}
+#else
+static int
+detect_cpu_flags(void)
+{
+    return 0;
+}
+#endif
+
+static int
+parse_cpu_level(const char *name)
+{
+    static const struct {
+        const char *name;
+        int level;
+    } levels[] = {
+        { "c",      OVCPU_LEVEL_C      },
+    #if ARCH_X86
+        { "sse4.1", OVCPU_LEVEL_SSE4_1 },
+        { "avx2",   OVCPU_LEVEL_AVX2   },
+    #elif ARCH_AARCH64
+        { "neon",   OVCPU_LEVEL_NEON   },
+    #endif
+    };
+    int i;
+
+    for (i = 0; i < sizeof(levels) / sizeof(*levels); ++i) {
+        if (!strcmp(name, levels[i].name)) {
+            return levels[i].level;
+        }
+    }
+
+    return -1;
+}
+
+static void
+init_cpu_flags(void)
+{
+    const char *env = getenv("OVVC_CPU");
+
+    cpu_flags = detect_cpu_flags();
+
+    if (env) {
+        int level = parse_cpu_level(env);
+        if (level < 0) {
+            ov_log(NULL, OVLOG_WARNING, "Unknown OVVC_CPU level %s ignored.\n", env);
+        } else {
+            cpu_flags &= ov_cpu_level_mask(level);
+        }
+    }
+
+    ov_log(NULL, OVLOG_VERBOSE, "CPU flags 0x%X.\n", cpu_flags);
+}
+
+int
+ov_cpu_flags(void)
+{
+    pthread_once(&cpu_once, init_cpu_flags);
+
+    return cpu_flags;
+}
+
+int
+ov_cpu_level_mask(int level)
+{
+    int mask = 0;
+
+    /* Levels of other architectures only select flags which
+     * are never detected
+     */
+    if (level >= OVCPU_LEVEL_SSE4_1) {
+        mask |= OV_CPU_SSE2 | OV_CPU_SSSE3 | OV_CPU_SSE4_1;
+    }
+
+    if (level >= OVCPU_LEVEL_NEON) {
+        mask |= OV_CPU_NEON;
+    }
+
+    if (level >= OVCPU_LEVEL_AVX2) {
+        mask |= OV_CPU_AVX2;
+    }
+
+    return mask;
+}
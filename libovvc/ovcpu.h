@@ -0,0 +1,27 @@
+#ifndef OVCPU_H
+#define OVCPU_H
+
+/* Instruction sets extensions used to select SIMD kernels at
+ * runtime
+ */
+enum OVCPUFlags
+{
+    OV_CPU_SSE2   = 1 << 0,
+    OV_CPU_SSSE3  = 1 << 1,
+    OV_CPU_SSE4_1 = 1 << 2,
+    OV_CPU_AVX2   = 1 << 3,
+
+    OV_CPU_NEON   = 1 << 8,
+};
+
+/* Flags supported by the host CPU
+ * Detection is only done on first call, the result is limited to
+ * the level given by the OVVC_CPU environment variable if set
+ * ("c", "sse4.1" or "avx2" on x86, "c" or "neon" on ARM)
+ */
+int ov_cpu_flags(void);
+
+/* Flags of instruction sets up to level (see enum OVCPULevel) */
+int ov_cpu_level_mask(int level);
+
+#endif
@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include <time.h>
 
 #include "ovutils.h"
 #include "ovmem.h"
@@ -21,6 +22,7 @@
  */
 #include "ovdpb.h"
 #include "ovthreads.h"
+#include "ovcpu.h"
 
 static const char *const decname = "Open VVC Decoder";
 
@@ -28,7 +30,11 @@ static const char *option_names[OVDEC_NB_OPTIONS] =
 {
     "frame threads",
     "entry threads",
-    "display_output"
+    "display_output",
+    "non_blocking",
+    "priority",
+    "cpu level",
+    "frame margin"
 };
 
 struct OVVCSubDec;
@@ -85,6 +91,9 @@ ovdec_init_subdec_list(OVVCDec *dec)
         }
         dec->subdec_list[i]->th_slice.main_thread = &dec->main_thread;
         dec->subdec_list[i]->th_slice.output_thread = &dec->output_thread;
+        dec->subdec_list[i]->th_slice.pool = dec->pool;
+        dec->subdec_list[i]->th_slice.priority = dec->priority;
+        dec->subdec_list[i]->cpu_flags = dec->cpu_flags;
     }
 
     return 0;
@@ -106,21 +115,29 @@ init_vcl_decoder(OVVCDec *const dec, OVSliceDec *sldec, const OVNVCLCtx *const n
     }
 
     if (!dec->dpb) {
-         ret = ovdpb_init(&dec->dpb, &dec->active_params);
-        dec->dpb->display_output = dec->display_output;
+         ret = ovdpb_init(&dec->dpb, &dec->active_params, dec->frame_margin);
          if (ret < 0) {
              return ret;
          }
+        dec->dpb->display_output = dec->display_output;
     }
 
     /* FIXME only if TMVP */
     //TODOpar: protect mv pool when more than one thread ?
     if (!dec->mv_pool) {
-        ret = mvpool_init(&dec->mv_pool, &dec->active_params.pic_info);
+        const OVSPS *sps = dec->active_params.sps;
+        const OVDPBParams *dpb_prms = &sps->dpb_parameters[sps->sps_max_sublayers_minus1];
+
+        /* MV planes of every picture of the DPB are allocated upfront */
+        ret = mvpool_init(&dec->mv_pool, &dec->active_params.pic_info,
+                          dpb_prms->dpb_max_dec_pic_buffering_minus1 + 1);
     }
 
-    //Temporary: copy active parameters
-    slicedec_copy_params(sldec, &dec->active_params);
+    /* Sub decoder keeps references on active parameters */
+    ret = slicedec_copy_params(sldec, &dec->active_params);
+    if (ret < 0) {
+        return ret;
+    }
 
     /* FIXME clean way on new slice with address 0 */
 #if 0
@@ -147,6 +164,52 @@ init_vcl_decoder(OVVCDec *const dec, OVSliceDec *sldec, const OVNVCLCtx *const n
 }
 
 
+/* Release pictures of sub decoders which finished decoding so they
+ * can be output and sub decoders reused.
+ * Must be called with main_mtx locked.
+ * Returns the index of the first available sub decoder or the
+ * number of sub decoders if none is available
+ */
+static int
+ovdec_release_subdecs(OVVCDec *const dec, int *nb_available)
+{
+    OVSliceDec **sldec_list = dec->subdec_list;
+    int nb_threads = dec->nb_frame_th;
+    int min_idx_available = nb_threads;
+    int nb_avail = 0;
+
+    //Unmark ref pict lists of decoded pics
+    for(int i = nb_threads-1; i >= 0 ; i--){
+        OVSliceDec *slicedec = sldec_list[i];
+        struct SliceThread *th_slice = &slicedec->th_slice;
+
+        if(th_slice->active_state == DECODING_FINISHED){
+            min_idx_available = i;
+            nb_avail++;
+            OVPicture *slice_pic = slicedec->pic;
+            if(slice_pic && (slice_pic->flags & OV_IN_DECODING_PIC_FLAG)){
+                ov_log(NULL, OVLOG_TRACE, "Subdec %d Remove DECODING_PIC_FLAG POC: %d\n", min_idx_available, slice_pic->poc);
+                ovdpb_unref_pic(slice_pic, OV_IN_DECODING_PIC_FLAG);
+                ovdpb_unmark_ref_pic_lists(slicedec->slice_type, slice_pic);
+
+                pthread_mutex_lock(&th_slice->gnrl_mtx);
+                th_slice->active_state = IDLE;
+                pthread_mutex_unlock(&th_slice->gnrl_mtx);
+            }
+        }
+        else if(th_slice->active_state == IDLE){
+            min_idx_available = i;
+            nb_avail++;
+        }
+    }
+
+    if (nb_available) {
+        *nb_available = nb_avail;
+    }
+
+    return min_idx_available;
+}
+
 OVSliceDec *
 ovdec_select_subdec(OVVCDec *const dec)
 {
@@ -157,32 +220,19 @@ ovdec_select_subdec(OVVCDec *const dec)
 
     OVSliceDec * slicedec;
     struct SliceThread* th_slice;
+
+    /* Released by the sub decoder once its picture is decoded */
+    if (dec->nb_reserved_pic) {
+        dec->nb_reserved_pic--;
+    } else {
+        ovthread_pool_acquire_pic(dec->pool);
+    }
+
     do{
-        //Unmark ref pict lists of decoded pics
-        int min_idx_available = nb_threads;
+        int min_idx_available;
         pthread_mutex_lock(&th_main->main_mtx);
-        
-        for(int i = nb_threads-1; i >= 0 ; i--){
-            slicedec = sldec_list[i];
-            th_slice = &slicedec->th_slice;
-            
-            if(th_slice->active_state == DECODING_FINISHED){
-                min_idx_available = i;
-                OVPicture *slice_pic = slicedec->pic;
-                if(slice_pic && (slice_pic->flags & OV_IN_DECODING_PIC_FLAG)){
-                    ov_log(NULL, OVLOG_TRACE, "Subdec %d Remove DECODING_PIC_FLAG POC: %d\n", min_idx_available, slice_pic->poc);
-                    ovdpb_unref_pic(slice_pic, OV_IN_DECODING_PIC_FLAG);
-                    ovdpb_unmark_ref_pic_lists(slicedec->slice_type, slice_pic);
-
-                    pthread_mutex_lock(&th_slice->gnrl_mtx);
-                    th_slice->active_state = IDLE;
-                    pthread_mutex_unlock(&th_slice->gnrl_mtx);
-                }
-            }
-            else if(th_slice->active_state == IDLE){
-                min_idx_available = i;     
-            }
-        }
+
+        min_idx_available = ovdec_release_subdecs(dec, NULL);
 
         if(min_idx_available < nb_threads){
             slicedec = sldec_list[min_idx_available];
@@ -202,6 +252,8 @@ ovdec_select_subdec(OVVCDec *const dec)
 
     } while(!th_main->kill);
 
+    ovthread_pool_release_pic(dec->pool);
+
     return NULL;
 
     #else
@@ -209,6 +261,85 @@ ovdec_select_subdec(OVVCDec *const dec)
     #endif
 }
 
+/* Wait until no sub decoder has a picture in decoding
+ * so no job of this decoder remains in its pool
+ */
+static void
+ovdec_wait_subdecs(OVVCDec *const dec)
+{
+    struct MainThread *th_main = &dec->main_thread;
+    int i;
+
+    if (!dec->subdec_list) {
+        return;
+    }
+
+    pthread_mutex_lock(&th_main->main_mtx);
+    for (i = 0; i < dec->nb_frame_th; ++i) {
+        OVSliceDec *sldec = dec->subdec_list[i];
+        while (sldec && sldec->th_slice.active_state == ACTIVE) {
+            pthread_cond_wait(&th_main->main_cnd, &th_main->main_mtx);
+        }
+    }
+    pthread_mutex_unlock(&th_main->main_mtx);
+}
+
+/* Reserve a sub decoder and a pool picture for every slice of the
+ * picture unit so it can be decoded without waiting.
+ * Sub decoders are only selected by the submitting thread so they
+ * cannot be taken before the slices are decoded, whereas pool
+ * pictures shared with other decoders are reserved at once.
+ */
+static int
+ovdec_reserve_pu(OVVCDec *const dec, const OVPictureUnit *const pu)
+{
+    struct MainThread *th_main = &dec->main_thread;
+    int nb_slices = 0;
+    int nb_available;
+    int ret;
+    int i;
+
+    for (i = 0; i < pu->nb_nalus; ++i) {
+        switch (pu->nalus[i]->type) {
+        case OVNALU_TRAIL:
+        case OVNALU_STSA:
+        case OVNALU_RADL:
+        case OVNALU_RASL:
+        case OVNALU_IDR_W_RADL:
+        case OVNALU_IDR_N_LP:
+        case OVNALU_CRA:
+        case OVNALU_GDR:
+            nb_slices++;
+            break;
+        default:
+            break;
+        }
+    }
+
+    pthread_mutex_lock(&th_main->main_mtx);
+    ovdec_release_subdecs(dec, &nb_available);
+    pthread_mutex_unlock(&th_main->main_mtx);
+
+    /* Slices beyond this limit wait for the previous slices
+     * of the picture unit to be decoded
+     */
+    nb_slices = OVMIN(nb_slices, dec->pool->max_pic_in_flight);
+    nb_slices = OVMIN(nb_slices, dec->nb_frame_th);
+
+    if (nb_available < nb_slices) {
+        return OVVC_EAGAIN;
+    }
+
+    ret = ovthread_pool_try_acquire_pic(dec->pool, nb_slices);
+    if (ret < 0) {
+        return ret;
+    }
+
+    dec->nb_reserved_pic = nb_slices;
+
+    return 0;
+}
+
 
 static int
 decode_nal_unit(OVVCDec *const vvcdec, OVNALUnit * nalu)
@@ -216,6 +347,7 @@ decode_nal_unit(OVVCDec *const vvcdec, OVNALUnit * nalu)
     OVNVCLReader rdr;
     OVNVCLCtx *const nvcl_ctx = &vvcdec->nvcl_ctx;
     enum OVNALUType nalu_type = nalu->type;
+    OVSliceDec *sldec = NULL;
     /* FIXME add proper SH allocation */
     int ret;
 
@@ -238,7 +370,7 @@ decode_nal_unit(OVVCDec *const vvcdec, OVNALUnit * nalu)
             return ret;
         } else {
             /*Select the first available subdecoder, or wait until one is available*/
-            OVSliceDec *sldec = ovdec_select_subdec(vvcdec);
+            sldec = ovdec_select_subdec(vvcdec);
                 
             ret = init_vcl_decoder(vvcdec, sldec, nvcl_ctx, nalu, &rdr);
 
@@ -251,8 +383,14 @@ decode_nal_unit(OVVCDec *const vvcdec, OVNALUnit * nalu)
 
             /* FIXME handle non rect entries later */
             ret = slicedec_decode_rect_entries(sldec, sldec->active_params);
- 
-            /* TODO start VCL decoder */
+
+            /* No entry job was started so the picture will not be
+             * finished by its last job
+             */
+            if (ret < 0) {
+                slicedec_finish_decoding(sldec);
+                goto failvcl;
+            }
         }
 
         break;
@@ -315,9 +453,8 @@ fail:
     return ret;
 
 failvcl:
-    //TODOpar: change 0
-    if (vvcdec->subdec_list[0]->pic) {
-        ovdpb_unref_pic(vvcdec->subdec_list[0]->pic, ~0);
+    if (sldec->pic) {
+        ovdpb_unref_pic(sldec->pic, ~0);
     }
     return ret;
 }
@@ -459,11 +596,40 @@ ovdec_submit_picture_unit(OVVCDec *vvcdec, const OVPictureUnit *const pu)
     }
     #endif
 
+    /* Nothing from the picture unit is read so the user
+     * can submit it again later
+     */
+    if (vvcdec->non_blocking) {
+        ret = ovdec_reserve_pu(vvcdec, pu);
+        if (ret < 0) {
+            return ret;
+        }
+    }
+
     ret = vvc_decode_picture_unit(vvcdec, pu);
 
+    /* Release pictures reserved for slices which were not decoded */
+    while (vvcdec->nb_reserved_pic) {
+        ovthread_pool_release_pic(vvcdec->pool);
+        vvcdec->nb_reserved_pic--;
+    }
+
+    /* Pictures already decoded might be output once the new
+     * picture is marked for output
+     */
+    pthread_mutex_lock(&vvcdec->main_thread.main_mtx);
+    ovthread_main_thread_check_output(&vvcdec->main_thread);
+    pthread_mutex_unlock(&vvcdec->main_thread.main_mtx);
+
     return ret;
 }
 
+int
+ovdec_get_event_fd(OVVCDec *dec)
+{
+    return dec->main_thread.event_fd[0];
+}
+
 
 int
 ovdec_receive_picture(OVVCDec *dec, OVFrame **frame_p)
@@ -486,16 +652,33 @@ ovdec_receive_picture(OVVCDec *dec, OVFrame **frame_p)
     ovframe_new_ref(frame_p, sldec->pic->frame);
     #endif
 
+    /* Events are cleared before checking for pictures so
+     * a picture decoded from now on will raise a new event
+     */
+    ovthread_main_thread_clear_event(&dec->main_thread);
+
+    /* Decoded pictures must be released from their sub decoder
+     * to be output
+     */
+    pthread_mutex_lock(&dec->main_thread.main_mtx);
+    ovdec_release_subdecs(dec, NULL);
+    pthread_mutex_unlock(&dec->main_thread.main_mtx);
+
     OVPicture *pic = NULL;
     out_cvs_id = (dpb->cvs_id - 1) & 0xFF;
     ret = ovdpb_output_pic(dpb, &pic, out_cvs_id);
 
     if (pic) {
+        int pp_ret;
         *frame_p = pic->frame;
-        pp_process_frame(pic->sei, dec->dpb, frame_p);
-
-        //New ref if it is a frame already in a DPB pic
-        if(*frame_p ==  pic->frame){
+        pp_ret = pp_process_frame(&dec->pp_ctx, pic->sei, dec->dpb, frame_p);
+
+        if (pp_ret < 0) {
+            ov_log(dec, OVLOG_ERROR, "Post processing failed on picture with POC %d.\n", pic->poc);
+            *frame_p = NULL;
+            ret = pp_ret;
+        } else if (*frame_p == pic->frame) {
+            //New ref if it is a frame already in a DPB pic
             ovframe_new_ref(frame_p, pic->frame);
         }
         /* we unref the picture even if ref failed the picture
@@ -513,6 +696,51 @@ ovdec_receive_picture(OVVCDec *dec, OVFrame **frame_p)
     return 0;
 }
 
+int
+ovdec_receive_picture_timeout(OVVCDec *dec, OVFrame **frame_p, int timeout_ms)
+{
+    struct MainThread *th_main = &dec->main_thread;
+    struct timespec deadline;
+    int ret;
+
+    clock_gettime(OV_MAIN_CND_CLOCK, &deadline);
+    deadline.tv_sec  += timeout_ms / 1000;
+    deadline.tv_nsec += (long)(timeout_ms % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    for (;;) {
+        int nb_available;
+        int timed_out;
+
+        *frame_p = NULL;
+        ret = ovdec_receive_picture(dec, frame_p);
+        if (ret < 0 || *frame_p) {
+            return ret;
+        }
+
+        pthread_mutex_lock(&th_main->main_mtx);
+
+        /* No picture will be output without new data if every
+         * sub decoder is idle
+         */
+        ovdec_release_subdecs(dec, &nb_available);
+        if (nb_available == dec->nb_frame_th || timeout_ms <= 0) {
+            pthread_mutex_unlock(&th_main->main_mtx);
+            return ret;
+        }
+
+        timed_out = pthread_cond_timedwait(&th_main->main_cnd, &th_main->main_mtx, &deadline);
+        pthread_mutex_unlock(&th_main->main_mtx);
+
+        if (timed_out) {
+            return OVVC_EAGAIN;
+        }
+    }
+}
+
 int
 ovdec_drain_picture(OVVCDec *dec, OVFrame **frame_p)
 {
@@ -536,11 +764,16 @@ ovdec_drain_picture(OVVCDec *dec, OVFrame **frame_p)
     ret = ovdpb_drain_frame(dpb, &pic, out_cvs_id);
 
     if (pic) {
+        int pp_ret;
         *frame_p = pic->frame;
-        pp_process_frame(pic->sei, dec->dpb, frame_p);
-
-        //New ref if it is a frame already in a DPB pic
-        if(*frame_p ==  pic->frame){
+        pp_ret = pp_process_frame(&dec->pp_ctx, pic->sei, dec->dpb, frame_p);
+
+        if (pp_ret < 0) {
+            ov_log(dec, OVLOG_ERROR, "Post processing failed on picture with POC %d.\n", pic->poc);
+            *frame_p = NULL;
+            ret = pp_ret;
+        } else if (*frame_p == pic->frame) {
+            //New ref if it is a frame already in a DPB pic
             ovframe_new_ref(frame_p, pic->frame);
         }
         /* we unref the picture even if ref failed the picture
@@ -567,6 +800,53 @@ set_nb_entry_threads(OVVCDec *ovdec, int nb_threads)
     return 0;
 }
 
+static int
+set_non_blocking(OVVCDec *ovdec, int on_off)
+{
+    ovdec->non_blocking = !!on_off;
+    return 0;
+}
+
+/* Jobs of pictures in flight are kept at their priority level
+ * so pictures never wait on older ones with a lower priority
+ */
+static int
+set_priority(OVVCDec *ovdec, int priority)
+{
+    priority = ov_clip(priority, 0, OV_POOL_NB_PRIO - 1);
+
+    ovdec_wait_subdecs(ovdec);
+
+    ovdec->priority = priority;
+    ovdec->pp_ctx.priority = priority;
+
+    if (ovdec->subdec_list) {
+        for (int i = 0; i < ovdec->nb_frame_th; ++i) {
+            ovdec->subdec_list[i]->th_slice.priority = priority;
+        }
+    }
+
+    return 0;
+}
+
+/* Level is only an upper bound on detected CPU extensions */
+static int
+set_cpu_level(OVVCDec *ovdec, int level)
+{
+    ovdec_wait_subdecs(ovdec);
+
+    ovdec->cpu_flags = ov_cpu_flags() & ov_cpu_level_mask(level);
+    ovdec->pp_ctx.cpu_flags = ovdec->cpu_flags;
+
+    if (ovdec->subdec_list) {
+        for (int i = 0; i < ovdec->nb_frame_th; ++i) {
+            ovdec->subdec_list[i]->cpu_flags = ovdec->cpu_flags;
+        }
+    }
+
+    return 0;
+}
+
 static int
 set_nb_frame_threads(OVVCDec *ovdec, int nb_threads)
 {
@@ -575,6 +855,20 @@ set_nb_frame_threads(OVVCDec *ovdec, int nb_threads)
     return 0;
 }
 
+/* Margins of pictures already allocated are kept */
+static int
+set_frame_margin(OVVCDec *ovdec, int margin)
+{
+    if (ovdec->dpb) {
+        ov_log(ovdec, OVLOG_WARNING, "Frame margin set once pictures are allocated,"
+               " it is ignored.\n");
+    }
+
+    ovdec->frame_margin = ov_clip(margin, 0, OV_FRAME_MAX_MARGIN);
+
+    return 0;
+}
+
 int
 ovdec_set_option(OVVCDec *ovdec, enum OVOptions opt_id, int value)
 {
@@ -589,6 +883,18 @@ ovdec_set_option(OVVCDec *ovdec, enum OVOptions opt_id, int value)
         case OVDEC_DISPLAY_OUTPUT:
             set_display_output(ovdec, value);
             break;
+        case OVDEC_NON_BLOCKING:
+            set_non_blocking(ovdec, value);
+            break;
+        case OVDEC_PRIORITY:
+            set_priority(ovdec, value);
+            break;
+        case OVDEC_CPU_LEVEL:
+            set_cpu_level(ovdec, value);
+            break;
+        case OVDEC_FRAME_MARGIN:
+            set_frame_margin(ovdec, value);
+            break;
         default :
             if (opt_id < OVDEC_NB_OPTIONS) {
                 ov_log(ovdec, OVLOG_ERROR, "Invalid option id %d.", opt_id);
@@ -622,6 +928,9 @@ ovdec_init(OVVCDec **vvcdec, int display_output, int nb_frame_th, int nb_entry_t
 
     (*vvcdec)->name = decname;
 
+    ovthread_main_thread_init(&(*vvcdec)->main_thread);
+    (*vvcdec)->main_thread.dpb = &(*vvcdec)->dpb;
+
     ovdec_set_option(*vvcdec, OVDEC_NB_FRAME_THREADS, nb_frame_th);
 
     ovdec_set_option(*vvcdec, OVDEC_NB_ENTRY_THREADS, nb_entry_th);
@@ -630,6 +939,26 @@ ovdec_init(OVVCDec **vvcdec, int display_output, int nb_frame_th, int nb_entry_t
 
     (*vvcdec)->display_output = !!display_output;
 
+    (*vvcdec)->frame_margin = OV_FRAME_MARGIN;
+
+    (*vvcdec)->cpu_flags = ov_cpu_flags();
+
+    /* Entry jobs of every picture in flight share the same
+     * pool of workers, one more worker than frame threads is
+     * started since pool keeps pictures in flight below its
+     * number of workers
+     */
+    if (ovthread_pool_init(&(*vvcdec)->thread_pool, OVMAX(nb_frame_th + 1, nb_entry_th)) < 0) {
+        goto fail;
+    }
+
+    (*vvcdec)->pool = &(*vvcdec)->thread_pool;
+
+    /* Film grain stripes jobs are submitted to the same pool */
+    (*vvcdec)->pp_ctx.pool      = (*vvcdec)->pool;
+    (*vvcdec)->pp_ctx.priority  = (*vvcdec)->priority;
+    (*vvcdec)->pp_ctx.cpu_flags = (*vvcdec)->cpu_flags;
+
     ovdec_init_subdec_list(*vvcdec);
 
     return 0;
@@ -640,6 +969,66 @@ fail:
 }
 
 
+int
+ovdec_pool_init(OVThreadPool **pool_p, int nb_threads)
+{
+    OVThreadPool *pool;
+
+    if (nb_threads <= 0) {
+        nb_threads = get_number_of_cores();
+    }
+
+    pool = ov_mallocz(sizeof(*pool));
+    if (!pool) {
+        return OVVC_ENOMEM;
+    }
+
+    if (ovthread_pool_init(pool, nb_threads) < 0) {
+        ov_freep(&pool);
+        return OVVC_ENOMEM;
+    }
+
+    pool->shared = 1;
+
+    *pool_p = pool;
+
+    return 0;
+}
+
+void
+ovdec_pool_uninit(OVThreadPool **pool_p)
+{
+    if (*pool_p) {
+        ovthread_pool_uninit(*pool_p);
+        ov_freep(pool_p);
+    }
+}
+
+int
+ovdec_attach_pool(OVVCDec *dec, OVThreadPool *pool)
+{
+    if (!pool || !pool->shared) {
+        ov_log(dec, OVLOG_ERROR, "Invalid thread pool attached.\n");
+        return OVVC_EINDATA;
+    }
+
+    ovdec_wait_subdecs(dec);
+
+    /* Release the threads of the decoder own pool */
+    ovthread_pool_uninit(&dec->thread_pool);
+
+    dec->pool = pool;
+    dec->pp_ctx.pool = pool;
+
+    if (dec->subdec_list) {
+        for (int i = 0; i < dec->nb_frame_th; ++i) {
+            dec->subdec_list[i]->th_slice.pool = pool;
+        }
+    }
+
+    return 0;
+}
+
 void
 ovdec_uninit_subdec_list(OVVCDec *vvcdec)
 {
@@ -647,6 +1036,9 @@ ovdec_uninit_subdec_list(OVVCDec *vvcdec)
 
     if (vvcdec != NULL)
     {
+        /* Jobs might still be running in a shared pool */
+        ovdec_wait_subdecs(vvcdec);
+
         if (vvcdec->subdec_list) {
             for (int i = 0; i < vvcdec->nb_frame_th; ++i){
                 sldec = vvcdec->subdec_list[i];
@@ -672,16 +1064,22 @@ ovdec_close(OVVCDec *vvcdec)
 
         nvcl_free_ctx(&vvcdec->nvcl_ctx);
 
+        decinit_unref_params(&vvcdec->active_params);
+
+        /* Wait for pending jobs before releasing sub decoders */
+        ovthread_pool_uninit(&vvcdec->thread_pool);
+
         ovdec_uninit_subdec_list(vvcdec);
 
         ovdpb_uninit(&vvcdec->dpb);
 
+        pp_uninit_ctx(&vvcdec->pp_ctx);
+
         if (vvcdec->mv_pool) {
             mvpool_uninit(&vvcdec->mv_pool);
         }
 
-        pthread_mutex_destroy(&vvcdec->main_thread.main_mtx);
-        pthread_cond_destroy(&vvcdec->main_thread.main_cnd);
+        ovthread_main_thread_uninit(&vvcdec->main_thread);
         ov_free(vvcdec);
 
         return 0;
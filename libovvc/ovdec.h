@@ -13,9 +13,35 @@ enum OVOptions {
    OVDEC_NB_FRAME_THREADS = 0,
    OVDEC_NB_ENTRY_THREADS = 1,
    OVDEC_DISPLAY_OUTPUT = 2,
+   OVDEC_NON_BLOCKING = 3,
+   OVDEC_PRIORITY = 4,
+   OVDEC_CPU_LEVEL = 5,
+   OVDEC_FRAME_MARGIN = 6,
    OVDEC_NB_OPTIONS,
 };
 
+/* Number of luma samples padded around pictures when set with
+ * OVDEC_FRAME_MARGIN (OV_FRAME_MARGIN by default, at most
+ * OV_FRAME_MAX_MARGIN). Larger margins let motion vectors point
+ * further outside of reference pictures without edge emulation
+ * at the cost of memory. It is only applied to pictures allocated
+ * after the first picture unit is submitted so it must be set
+ * before decoding starts.
+ */
+
+/* Highest SIMD level the decoder is allowed to use when set with
+ * OVDEC_CPU_LEVEL, levels not supported by the CPU are never used
+ * By default the best level available is used
+ */
+enum OVCPULevel {
+   OVCPU_LEVEL_C = 0,
+   /* x86 */
+   OVCPU_LEVEL_SSE4_1 = 1,
+   OVCPU_LEVEL_AVX2 = 2,
+   /* ARM */
+   OVCPU_LEVEL_NEON = 1,
+};
+
 /**
  * Submit raw Annex B data corresponding to a Picture Unit
  * the decoder will then extract RBSP data of each NAL Unit
@@ -23,9 +49,25 @@ enum OVOptions {
  * update the decoder status and attach the VCL data to a decoding
  * thread before returning
  * returns a negative number of failure, 0 otherwise
+ * OVVC_EBITDEPTH is returned if the stream bit depth differs from
+ * the one the library was configured for (configure --bitdepth)
+ * When OVDEC_NON_BLOCKING option is set OVVC_EAGAIN is returned
+ * instead of waiting for a decoding thread to be available, the
+ * Picture Unit is then left untouched and can be submitted again
+ * once a picture is received. Slices of a Picture Unit beyond the
+ * number of frame threads still wait for the previous slices of
+ * the same Picture Unit to be decoded
  */
 int ovdec_submit_picture_unit(OVVCDec *vvcdec, const OVPictureUnit *pu);
 
+/*
+ * Returns a file descriptor which becomes readable when a picture
+ * is ready for output so event loops can poll it before calling
+ * ovdec_receive_picture() until no picture is returned;
+ * -1 if unavailable on the platform
+ */
+int ovdec_get_event_fd(OVVCDec *dec);
+
 /*
  * Request a reference to a picture from the decoder
  * and sets a new reference to the output frame
@@ -39,12 +81,41 @@ int ovdec_submit_picture_unit(OVVCDec *vvcdec, const OVPictureUnit *pu);
  */
 int ovdec_receive_picture(OVVCDec *dec, OVFrame **frame_p);
 
+/*
+ * Same as ovdec_receive_picture() but waits up to timeout_ms
+ * milliseconds for a picture to be output while pictures are
+ * being decoded, the timeout is measured on a monotonic clock
+ * where available so wall clock changes do not affect it
+ * returns OVVC_EAGAIN if no picture was output before timeout
+ */
+int ovdec_receive_picture_timeout(OVVCDec *dec, OVFrame **frame_p, int timeout_ms);
+
 int ovdec_drain_picture(OVVCDec *vvcdec, OVFrame **frame);
 
 int ovdec_init(OVVCDec **ovvcdec, int display_output, int nb_frame_th, int nb_entry_th);
 
 int ovdec_set_option(OVVCDec *ovdec, enum OVOptions opt_id, int value);
 
+/*
+ * Create a pool of nb_threads worker threads (one per core if
+ * nb_threads <= 0) to be shared by several decoders.
+ * The pool must be uninitialised after every decoder
+ * it is attached to is closed.
+ */
+int ovdec_pool_init(OVThreadPool **pool, int nb_threads);
+
+void ovdec_pool_uninit(OVThreadPool **pool);
+
+/*
+ * Make the decoder run its jobs in a shared pool instead of its own
+ * threads. Decoders sharing a pool are served according to their
+ * OVDEC_PRIORITY option (0 to 2, higher is served more often).
+ * Decoders sharing a pool of N workers decode at most N - 1
+ * pictures (sub decoders) at once, so that jobs waiting on
+ * reference pictures never hold every worker.
+ */
+int ovdec_attach_pool(OVVCDec *ovdec, OVThreadPool *pool);
+
 int ovdec_close(OVVCDec *ovvcdec);
 
 void ovdec_uninit_subdec_list(OVVCDec *vvcdec);
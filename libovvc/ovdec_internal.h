@@ -28,7 +28,8 @@ struct MVPool
 
 struct PicPartInfo;
 
-int mvpool_init(struct MVPool **mv_pool_p, const struct PicPartInfo *const pinfo);
+int mvpool_init(struct MVPool **mv_pool_p, const struct PicPartInfo *const pinfo,
+                unsigned nb_prefill);
 
 void mvpool_uninit(struct MVPool **mv_pool_p);
 
@@ -41,6 +41,7 @@ typedef struct OVNVCLUnit OVNVCLUnit;
 
 typedef struct OVVCDec OVVCDec;
 typedef struct SubDec OVSubDec;
+typedef struct OVThreadPool OVThreadPool;
 
 typedef struct OVPS OVPS;
 
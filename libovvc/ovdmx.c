@@ -2,6 +2,9 @@
 #include <stddef.h>
 #include <string.h>
 #include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
 
 #include "ovutils.h"
 #include "overror.h"
@@ -12,15 +15,10 @@
 #include "ovdmx.h"
 #include "ovio.h"
 #include "ovannexb.h"
+#include "ovcpu.h"
 #include "ovunits.h"
 
 
-/* Use Fixed size of demux read cache buffer to 64K */
-
-#define OVVCDMX_IO_BUFF_SIZE (1 << 16)
-
-#define OVVCDMX_IO_BUFF_MASK ((1 << 16) - 1)
-
 #define OVRBSP_CACHE_SIZE (1 << 16)
 
 #define OVEPB_CACHE_SIZE (16 * sizeof(uint32_t))
@@ -56,7 +54,8 @@ struct RBSPSegment
 
 struct RBSPCacheData
 {
-    /* Cache buffer used to catenate RBSP chunks while extracting RBSP_data.
+    /* Cache buffer used to catenate RBSP chunks while extracting RBSP_data
+       of NAL Units which cannot refer directly to the input chunks.
        Its size is initialised at 64kB and will grow
        to the max RBSP size encountered in the stream */
     uint8_t *start;
@@ -115,6 +114,9 @@ struct ReaderCache
     /* Pointer to io_cached buffer */
     const uint8_t *data_start;
 
+    /* Reference to the input chunk data_start belongs to */
+    OVIOChunk *chunk;
+
     const uint8_t *cache_start;
     const uint8_t *cache_end;
 
@@ -127,17 +129,56 @@ struct ReaderCache
      * in wrong informations reporting about the demuxer status
      */
 
-    /* Number of 64 kB chunks already processed by
+    /* Number of chunks already processed by
      * the demuxer */
     uint64_t nb_chunk_read;
 };
 
+/* Result of a Picture Unit extraction by read ahead thread */
+struct PUQueueElem
+{
+    OVPictureUnit *pu;
+    int ret;
+};
+
+struct DMXReadAhead
+{
+    pthread_t thread;
+
+    /* Single producer single consumer ring buffer: the read ahead
+     * thread writes at tail and ovdmx_extract_picture_unit() reads
+     * at head. Indices only grow, queue is full when they differ
+     * by depth.
+     */
+    struct PUQueueElem *queue;
+    unsigned depth;
+    atomic_uint head;
+    atomic_uint tail;
+
+    /* Only used to sleep when queue is full or empty, the mutex is
+     * not taken when nobody is waiting
+     */
+    pthread_mutex_t mtx;
+    pthread_cond_t cnd;
+    atomic_int nb_waiting;
+
+    /* Stream has no data available for now */
+    atomic_uchar starved;
+
+    /* Thread pushed its last element and does not access demuxer
+     * anymore
+     */
+    atomic_uchar done;
+
+    atomic_uchar kill;
+
+    uint8_t running;
+};
+
 struct OVVCDmx
 {
     const char *name;
 
-    FILE *fstream;
-
     /* Points to a read only IO context */
     OVIOStream *io_str;
 
@@ -162,11 +203,20 @@ struct OVVCDmx
     /* Memory pool for NALUListElem */
     MemPool *nalu_elem_pool;
 
+    /* Start code and EPB candidates scanner selected on CPU flags */
+    OVAnnexBScanFunc find_candidate;
+
     uint8_t eof;
 
+    /* Optional thread extracting Picture Units ahead of requests */
+    struct DMXReadAhead read_ahead;
+
     /* Demuxer options to be passed at init */
     struct{
-        int val;
+        /* Maximum number of Picture Units extracted ahead
+         * 0 if read ahead is disabled
+         */
+        int read_ahead;
     }options;
 };
 
@@ -174,7 +224,7 @@ static int extract_cache_segments(OVVCDmx *const dmx, struct ReaderCache *const
 
 static int init_rbsp_cache(struct RBSPCacheData *const rbsp_ctx);
 
-/* Realloc rbsp_cache adding an extra 64KB to previously allocated size
+/* Realloc rbsp_cache doubling previously allocated size
    and copy previous content */
 static int extend_rbsp_cache(struct RBSPCacheData *const rbsp_ctx);
 
@@ -198,6 +248,10 @@ static void append_nalu_elem(struct NALUnitsList *const list, struct NALUnitList
 
 static void free_nalu_elem(struct NALUnitListElem *nalu_elem);
 
+static int read_ahead_start(OVVCDmx *const dmx);
+
+static void read_ahead_stop(OVVCDmx *const dmx);
+
 int
 ovdmx_init(OVVCDmx **vvcdmx)
 {
@@ -209,6 +263,8 @@ ovdmx_init(OVVCDmx **vvcdmx)
     (*vvcdmx)->name = demux_name;
     (*vvcdmx)->io_str = NULL;
 
+    (*vvcdmx)->find_candidate = ovannexb_scan_function(ov_cpu_flags());
+
     (*vvcdmx)->nalu_elem_pool = ovmempool_init(sizeof(struct NALUnitListElem));
 
     if ((*vvcdmx)->nalu_elem_pool == NULL) {
@@ -271,98 +327,115 @@ fail:
     return -1;
 }
 
-/*FIXME do not use FILE use a wrapper to something more general instead
-  so we can support other IO types */
 int
-ovdmx_attach_stream(OVVCDmx *const dmx, FILE *fstream)
+ovdmx_attach_stream(OVVCDmx *const dmx, OVIOStream *io_str)
 {
     int ret = 0;
 
-    /* FiXME is this check necessary this function should not
-       be called if stream is not allocated.
-       Maybe we should open file ourselves / and use a wrapper around
-       I/Os */
-    if (fstream == NULL) {
+    if (io_str == NULL) {
         ov_log(dmx, OVLOG_ERROR, "No stream to attach.\n");
         return OVVC_EINDATA;
     }
 
-    dmx->fstream = fstream;
-
-    /* TODO distinguish init and open / attach */
-    dmx->io_str = ovio_stream_open(fstream);
-    if (dmx->io_str == NULL) {
-        ov_log(dmx, OVLOG_ERROR, "Failed to open stream.\n");
-        return OVVC_EINDATA;
-    }
+    dmx->io_str = io_str;
 
     /* Initialise reader cache by first read */
     if (!ovio_stream_eof(dmx->io_str)) {
         struct ReaderCache *const cache_ctx = &dmx->cache_ctx;
-        int read_in_buf;
 
-        read_in_buf = ovio_stream_read(&cache_ctx->data_start, OVVCDMX_IO_BUFF_SIZE,
-                                       dmx->io_str);
-        cache_ctx->first_pos = 0;
-        cache_ctx->cache_start = cache_ctx->data_start;
-
-        /* Buffer end is set to size minus 8 so we do not overread first data chunk */
-        cache_ctx->cache_end = cache_ctx->data_start + OVVCDMX_IO_BUFF_SIZE - 8;
-
-        if (!read_in_buf) {
-            /* TODO error handling if end of file is encountered on first read */
-            int32_t nb_bytes;
-            nb_bytes = ovio_stream_tell(dmx->io_str) & OVVCDMX_IO_BUFF_MASK;
-            cache_ctx->cache_end = cache_ctx->cache_start + nb_bytes;
-            dmx->eof = 1;
-            /* FIXME We could emulate a start code at the end of cache ?*/
+        ret = refill_reader_cache(cache_ctx, dmx->io_str);
+        if (ret < 0) {
+            /* Feed streams might not have received data yet
+             * first chunk will be read on extraction
+             */
+            if (ret == OVVC_EAGAIN) {
+                return 0;
+            }
+            ov_log(dmx, OVLOG_ERROR, "Failed to read stream.\n");
+            return ret;
         }
 
+        dmx->eof = ret;
+
         /* FIXME Process first chunk of data ? */
         ret = extract_cache_segments(dmx, cache_ctx);
+        if (ret < 0) {
+            return ret;
+        }
+    }
 
-        cache_ctx->nb_chunk_read = 1;
+    if (dmx->options.read_ahead > 0) {
+        ret = read_ahead_start(dmx);
     }
 
     return ret;
 }
 
-/*FIXME share bytestream mem with OVIOStream so we avoid copying from one to
-  another*/
 void
 ovdmx_detach_stream(OVVCDmx *const dmx)
 {
-    dmx->fstream = NULL;
+    /* Thread must not access stream anymore */
+    read_ahead_stop(dmx);
+
+    /* Chunks still referenced by NAL Units are released with them */
+    if (dmx->cache_ctx.chunk) {
+        ovio_chunk_unref(&dmx->cache_ctx.chunk);
+    }
 
-    /* FIXME decide if it should free OVIOStream cache buff */
     if (dmx->io_str != NULL) {
         ovio_stream_close(dmx->io_str);
     }
 
     dmx->io_str = NULL;
-    /* FIXME ReaderCache  should be reset */
+
+    memset(&dmx->cache_ctx, 0, sizeof(dmx->cache_ctx));
+    dmx->eof = 0;
 }
 
+/* Returns 1 if the chunk read is the last of the stream,
+ * 0 otherwise or a negative value on failure
+ */
 static int
 refill_reader_cache(struct ReaderCache *const cache_ctx, OVIOStream *const io_str)
 {
-    int read_in_buf;
-    read_in_buf = ovio_stream_read(&cache_ctx->data_start, OVVCDMX_IO_BUFF_SIZE,
-                                   io_str);
-    cache_ctx->data_start -= 8;
+    OVIOChunk *chunk;
+    const uint8_t *data_start;
+    size_t nb_bytes;
+    int eof;
+    int ret;
 
-    cache_ctx->cache_start = cache_ctx->data_start;
-    cache_ctx->cache_end   = cache_ctx->data_start + OVVCDMX_IO_BUFF_SIZE;
+    ret = ovio_stream_read(&chunk, &data_start, &nb_bytes, io_str);
+    if (ret < 0) {
+        return ret;
+    }
+
+    eof = !!ovio_stream_eof(io_str);
 
-    cache_ctx->nb_chunk_read += read_in_buf;
+    /* NAL Units pointing into previous chunk keep their own reference */
+    ovio_chunk_unref(&cache_ctx->chunk);
+    cache_ctx->chunk = chunk;
 
-    if (!read_in_buf) {
-        int32_t nb_bytes = ovio_stream_tell(io_str) & OVVCDMX_IO_BUFF_MASK;
-        cache_ctx->cache_end = cache_ctx->data_start + nb_bytes + 8;
-        return 1;
+    if (cache_ctx->nb_chunk_read) {
+        /* Start from the last bytes of previous chunk copied
+         * before data
+         */
+        data_start -= 8;
+        nb_bytes   += 8;
+    } else {
+        cache_ctx->first_pos = 0;
     }
 
-    return 0;
+    cache_ctx->data_start  = data_start;
+    cache_ctx->cache_start = data_start;
+
+    /* Buffer end is set to size minus 8 so the last bytes are processed
+     * with next chunk and we do not overread current one
+     */
+    cache_ctx->cache_end = data_start + nb_bytes - (eof ? 0 : 8);
+
+    cache_ctx->nb_chunk_read++;
+
+    return eof;
 }
 
 #if 0
@@ -405,9 +478,17 @@ extract_nal_unit(OVVCDmx *const dmx, struct NALUnitsList *const dst_list)
     do {
         if (!current_nalu && !dmx->eof) {
             struct ReaderCache *const cache_ctx = &dmx->cache_ctx;
+            int ret;
 
-            /* FIXME error handling from demux + use return values */
-            dmx->eof = refill_reader_cache(cache_ctx, dmx->io_str);
+            ret = refill_reader_cache(cache_ctx, dmx->io_str);
+            if (ret < 0) {
+                if (ret != OVVC_EAGAIN) {
+                    ov_log(dmx, OVLOG_ERROR, "Failed to read stream.\n");
+                }
+                return ret;
+            }
+
+            dmx->eof = ret;
 
             extract_cache_segments(dmx, cache_ctx);
 
@@ -528,8 +609,8 @@ convert_nalu_list_to_pu(OVPictureUnit *dst, struct NALUnitsList *const src)
     return 0;
 }
 
-int
-ovdmx_extract_picture_unit(OVVCDmx *const dmx, OVPictureUnit **dst_pu)
+static int
+extract_picture_unit(OVVCDmx *const dmx, OVPictureUnit **dst_pu)
 {
     int ret;
     struct NALUnitsList pending_nalu_list = {0};
@@ -559,6 +640,13 @@ ovdmx_extract_picture_unit(OVVCDmx *const dmx, OVPictureUnit **dst_pu)
     }
     #else
     ret = extract_nal_unit(dmx, &pending_nalu_list);
+    if (ret == OVVC_EAGAIN) {
+        /* Not enough data was fed to the stream yet */
+        *dst_pu = NULL;
+        ov_free(pu);
+        return ret;
+    }
+
     if (!dmx->eof && ret < 0) {
         ov_log(dmx, OVLOG_ERROR, "No valid Access Unit found \n");
         free_nalu_list(&pending_nalu_list);
@@ -582,6 +670,230 @@ ovdmx_extract_picture_unit(OVVCDmx *const dmx, OVPictureUnit **dst_pu)
     return 0;
 }
 
+static int
+is_last_pu(const OVPictureUnit *pu, int ret)
+{
+    /* Once end of stream is reached extraction only returns
+     * empty Picture Units
+     */
+    return (ret < 0 && ret != OVVC_EAGAIN) || !pu || !pu->nb_nalus;
+}
+
+static void
+read_ahead_notify(struct DMXReadAhead *const ra)
+{
+    if (atomic_load(&ra->nb_waiting)) {
+        pthread_mutex_lock(&ra->mtx);
+        pthread_cond_broadcast(&ra->cnd);
+        pthread_mutex_unlock(&ra->mtx);
+    }
+}
+
+static int
+queue_full(struct DMXReadAhead *const ra)
+{
+    return atomic_load(&ra->tail) - atomic_load(&ra->head) >= ra->depth;
+}
+
+static int
+queue_empty(struct DMXReadAhead *const ra)
+{
+    return atomic_load(&ra->tail) == atomic_load(&ra->head);
+}
+
+static void *
+read_ahead_thread(void *opaque)
+{
+    OVVCDmx *const dmx = opaque;
+    struct DMXReadAhead *const ra = &dmx->read_ahead;
+
+    while (!atomic_load(&ra->kill)) {
+        OVPictureUnit *pu = NULL;
+        unsigned tail;
+        int ret;
+
+        if (queue_full(ra)) {
+            atomic_fetch_add(&ra->nb_waiting, 1);
+            pthread_mutex_lock(&ra->mtx);
+            while (queue_full(ra) && !atomic_load(&ra->kill)) {
+                pthread_cond_wait(&ra->cnd, &ra->mtx);
+            }
+            pthread_mutex_unlock(&ra->mtx);
+            atomic_fetch_sub(&ra->nb_waiting, 1);
+            continue;
+        }
+
+        ret = extract_picture_unit(dmx, &pu);
+
+        if (ret == OVVC_EAGAIN) {
+            /* Wait a bit for more data to be fed to stream */
+            struct timespec deadline;
+
+            atomic_store(&ra->starved, 1);
+            read_ahead_notify(ra);
+
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += 1000000;
+            if (deadline.tv_nsec >= 1000000000) {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000;
+            }
+
+            pthread_mutex_lock(&ra->mtx);
+            if (!atomic_load(&ra->kill)) {
+                pthread_cond_timedwait(&ra->cnd, &ra->mtx, &deadline);
+            }
+            pthread_mutex_unlock(&ra->mtx);
+            continue;
+        }
+
+        atomic_store(&ra->starved, 0);
+
+        tail = atomic_load(&ra->tail);
+        ra->queue[tail % ra->depth].pu  = ret < 0 ? NULL : pu;
+        ra->queue[tail % ra->depth].ret = ret;
+        atomic_store(&ra->tail, tail + 1);
+
+        if (is_last_pu(pu, ret)) {
+            atomic_store(&ra->done, 1);
+            read_ahead_notify(ra);
+            break;
+        }
+
+        read_ahead_notify(ra);
+    }
+
+    return NULL;
+}
+
+static int
+read_ahead_start(OVVCDmx *const dmx)
+{
+    struct DMXReadAhead *const ra = &dmx->read_ahead;
+    int ret;
+
+    ra->depth = dmx->options.read_ahead;
+    ra->queue = ov_mallocz(sizeof(*ra->queue) * ra->depth);
+    if (!ra->queue) {
+        return OVVC_ENOMEM;
+    }
+
+    atomic_init(&ra->head, 0);
+    atomic_init(&ra->tail, 0);
+    atomic_init(&ra->nb_waiting, 0);
+    atomic_init(&ra->starved, 0);
+    atomic_init(&ra->done, 0);
+    atomic_init(&ra->kill, 0);
+
+    pthread_mutex_init(&ra->mtx, NULL);
+    pthread_cond_init(&ra->cnd, NULL);
+
+    ret = pthread_create(&ra->thread, NULL, read_ahead_thread, dmx);
+    if (ret) {
+        ov_log(dmx, OVLOG_ERROR, "Could not create read ahead thread.\n");
+        pthread_mutex_destroy(&ra->mtx);
+        pthread_cond_destroy(&ra->cnd);
+        ov_freep(&ra->queue);
+        return OVVC_ENOMEM;
+    }
+
+    ra->running = 1;
+
+    return 0;
+}
+
+static void
+read_ahead_stop(OVVCDmx *const dmx)
+{
+    struct DMXReadAhead *const ra = &dmx->read_ahead;
+    unsigned head;
+
+    if (!ra->running) {
+        return;
+    }
+
+    pthread_mutex_lock(&ra->mtx);
+    atomic_store(&ra->kill, 1);
+    pthread_cond_broadcast(&ra->cnd);
+    pthread_mutex_unlock(&ra->mtx);
+
+    pthread_join(ra->thread, NULL);
+
+    /* Release Picture Units which were never requested */
+    head = atomic_load(&ra->head);
+    while (head != atomic_load(&ra->tail)) {
+        OVPictureUnit *pu = ra->queue[head % ra->depth].pu;
+        if (pu) {
+            ov_free_pu(&pu);
+        }
+        head++;
+    }
+
+    pthread_mutex_destroy(&ra->mtx);
+    pthread_cond_destroy(&ra->cnd);
+    ov_freep(&ra->queue);
+
+    ra->running = 0;
+}
+
+int
+ovdmx_set_read_ahead(OVVCDmx *const dmx, int queue_depth)
+{
+    if (dmx->io_str) {
+        ov_log(dmx, OVLOG_ERROR, "Read ahead must be set before attaching a stream.\n");
+        return OVVC_EINDATA;
+    }
+
+    dmx->options.read_ahead = OVMAX(queue_depth, 0);
+
+    return 0;
+}
+
+int
+ovdmx_extract_picture_unit(OVVCDmx *const dmx, OVPictureUnit **dst_pu)
+{
+    struct DMXReadAhead *const ra = &dmx->read_ahead;
+
+    *dst_pu = NULL;
+
+    if (!ra->running) {
+        return extract_picture_unit(dmx, dst_pu);
+    }
+
+    for (;;) {
+        if (!queue_empty(ra)) {
+            unsigned head = atomic_load(&ra->head);
+            struct PUQueueElem elem = ra->queue[head % ra->depth];
+
+            atomic_store(&ra->head, head + 1);
+            read_ahead_notify(ra);
+
+            *dst_pu = elem.pu;
+
+            return elem.ret;
+        }
+
+        /* Thread does not access demuxer anymore we can
+         * carry on extraction from here
+         */
+        if (atomic_load(&ra->done)) {
+            return extract_picture_unit(dmx, dst_pu);
+        }
+
+        if (atomic_load(&ra->starved)) {
+            return OVVC_EAGAIN;
+        }
+
+        atomic_fetch_add(&ra->nb_waiting, 1);
+        pthread_mutex_lock(&ra->mtx);
+        while (queue_empty(ra) && !atomic_load(&ra->done) && !atomic_load(&ra->starved)) {
+            pthread_cond_wait(&ra->cnd, &ra->mtx);
+        }
+        pthread_mutex_unlock(&ra->mtx);
+        atomic_fetch_sub(&ra->nb_waiting, 1);
+    }
+}
+
 static struct NALUnitListElem *
 create_nalu_elem(OVVCDmx *const dmx)
 {
@@ -605,7 +917,10 @@ static void
 free_nalu_elem(struct NALUnitListElem *nalu_elem)
 {
     /* TODO unref NALU instead of free */
-    if (nalu_elem->nalu.rbsp_data) {
+    if (nalu_elem->nalu.chunk) {
+        ovio_chunk_unref(&nalu_elem->nalu.chunk);
+        nalu_elem->nalu.rbsp_data = NULL;
+    } else if (nalu_elem->nalu.rbsp_data) {
         ov_freep(&nalu_elem->nalu.rbsp_data);
     }
 
@@ -647,7 +962,7 @@ append_rbsp_segment_to_cache(struct ReaderCache *const cache_ctx,
         return -1;
     }
 
-    if (rbsp_cache->cache_size < rbsp_cache->rbsp_size + sgmt_size) {
+    while (rbsp_cache->cache_size < rbsp_cache->rbsp_size + sgmt_size) {
         int ret;
          ret = extend_rbsp_cache(rbsp_cache);
          if (ret < 0) {
@@ -670,6 +985,46 @@ empty_rbsp_cache(struct RBSPCacheData *rbsp_cache)
     rbsp_cache->rbsp_size = 0;
 }
 
+/* Move RBSP data catenated in cache to the NAL Unit. Large RBSP
+ * take the cache buffer over instead of being copied, the demuxer
+ * then starts over with a new cache buffer.
+ */
+static int
+move_rbsp_cache_to_nalu(struct RBSPCacheData *rbsp_cache, OVNALUnit *nalu)
+{
+    size_t rbsp_size = rbsp_cache->rbsp_size;
+    uint8_t *rbsp_data;
+
+    if (rbsp_size > OVRBSP_CACHE_SIZE / 4) {
+        uint8_t *new_cache = ov_malloc(OVRBSP_CACHE_SIZE + OV_RBSP_PADDING);
+        if (!new_cache) {
+            return OV_ENOMEM;
+        }
+
+        rbsp_data = rbsp_cache->start;
+
+        rbsp_cache->start = new_cache;
+        rbsp_cache->cache_size = OVRBSP_CACHE_SIZE;
+    } else {
+        rbsp_data = ov_malloc(rbsp_size + OV_RBSP_PADDING);
+        if (!rbsp_data) {
+            return OV_ENOMEM;
+        }
+
+        memcpy(rbsp_data, rbsp_cache->start, rbsp_size);
+    }
+
+    /* Prevent padding to be not zero */
+    memset(rbsp_data + rbsp_size, 0, OV_RBSP_PADDING);
+
+    nalu->rbsp_data = rbsp_data;
+    nalu->rbsp_size = rbsp_size;
+
+    empty_rbsp_cache(rbsp_cache);
+
+    return 0;
+}
+
 static int
 process_start_code(OVVCDmx *const dmx, struct ReaderCache *const cache_ctx,
                    const struct RBSPSegment *sgmt_ctx)
@@ -689,14 +1044,28 @@ process_start_code(OVVCDmx *const dmx, struct ReaderCache *const cache_ctx,
     /* New NAL Unit start code found we end so we can process previous
      * NAL Unit data
      */
-    append_rbsp_segment_to_cache(cache_ctx, &dmx->rbsp_ctx, sgmt_ctx);
-
     if (nalu_pending) {
-        /* FIXME Using of mallocz is to prevent padding to be not zero */
-        uint8_t *rbsp_data = ov_mallocz(dmx->rbsp_ctx.rbsp_size + OV_RBSP_PADDING);
-        if (!rbsp_data) {
-            free_nalu_elem(nalu_elem);
-            return OV_ENOMEM;
+        ptrdiff_t sgmt_size = sgmt_ctx->end_p - sgmt_ctx->start_p;
+
+        if (!dmx->rbsp_ctx.rbsp_size && sgmt_size > 0) {
+            /* Nothing was catenated to RBSP cache so the whole NAL Unit
+             * is this segment of current chunk (no EPB and no chunk
+             * boundary crossed), refer to the chunk instead of copying.
+             * Bytes following RBSP in chunk are used as padding.
+             */
+            ovio_chunk_new_ref(&nalu_pending->nalu.chunk, cache_ctx->chunk);
+
+            nalu_pending->nalu.rbsp_data = sgmt_ctx->start_p;
+            nalu_pending->nalu.rbsp_size = sgmt_size;
+        } else {
+            int ret;
+            append_rbsp_segment_to_cache(cache_ctx, &dmx->rbsp_ctx, sgmt_ctx);
+
+            ret = move_rbsp_cache_to_nalu(&dmx->rbsp_ctx, &nalu_pending->nalu);
+            if (ret < 0) {
+                free_nalu_elem(nalu_elem);
+                return ret;
+            }
         }
 
         if (dmx->epb_info.nb_epb) {
@@ -704,7 +1073,6 @@ process_start_code(OVVCDmx *const dmx, struct ReaderCache *const cache_ctx,
             epb_pos = ov_malloc(dmx->epb_info.nb_epb * sizeof(*epb_pos));
             if (!epb_pos) {
                 free_nalu_elem(nalu_elem);
-                ov_free(rbsp_data);
                 return OV_ENOMEM;
             }
 
@@ -716,13 +1084,6 @@ process_start_code(OVVCDmx *const dmx, struct ReaderCache *const cache_ctx,
 
         dmx->epb_info.nb_epb = 0;
 
-        nalu_pending->nalu.rbsp_data = rbsp_data;
-        nalu_pending->nalu.rbsp_size = dmx->rbsp_ctx.rbsp_size;
-
-        memcpy(rbsp_data, dmx->rbsp_ctx.start, dmx->rbsp_ctx.rbsp_size);
-
-        empty_rbsp_cache(&dmx->rbsp_ctx);
-
         append_nalu_elem(nalu_list, nalu_pending);
     } else {
         ov_log(dmx, OVLOG_TRACE, "No pending nalu when processing start_code, skipping.\n");
@@ -769,10 +1130,9 @@ process_emulation_prevention_byte(OVVCDmx *const dmx, struct ReaderCache *const
 static int
 extract_cache_segments(OVVCDmx *const dmx, struct ReaderCache *const cache_ctx)
 {
-    const uint64_t mask = OVVCDMX_IO_BUFF_MASK;
     const uint8_t *byte = cache_ctx->cache_start;
     const uint8_t *const cache_end = cache_ctx->cache_end;
-    uint32_t byte_pos = cache_ctx->first_pos & mask;
+    size_t byte_pos = cache_ctx->first_pos;
     uint8_t end_of_cache;
     struct RBSPSegment sgmt_ctx = {0};
 
@@ -780,12 +1140,16 @@ extract_cache_segments(OVVCDmx *const dmx, struct ReaderCache *const cache_ctx)
     sgmt_ctx.end_p   = byte + byte_pos;
 
     do {
-        const uint8_t *bytestream = &byte[byte_pos & mask];
-
-        /* FIXME we will actually loop over this more than once even if a start
-         * code has been detected. This is a bit inefficient
-         * TODO bin tricks for two fast zero bytes detection
+        /* Skip bytes which cannot start a start code or an emulation
+         * prevention three bytes sequence
          */
+        const uint8_t *bytestream = dmx->find_candidate(&byte[byte_pos], cache_end);
+
+        byte_pos = bytestream - byte;
+        if (bytestream >= cache_end) {
+            break;
+        }
+
         if (*bytestream == 0) {
             int ret;
             ret = ovannexb_check_stc_or_epb(bytestream);
@@ -868,7 +1232,7 @@ extract_cache_segments(OVVCDmx *const dmx, struct ReaderCache *const cache_ctx)
 static int
 init_rbsp_cache(struct RBSPCacheData *const rbsp_ctx)
 {
-    rbsp_ctx->start = ov_mallocz(OVRBSP_CACHE_SIZE);
+    rbsp_ctx->start = ov_mallocz(OVRBSP_CACHE_SIZE + OV_RBSP_PADDING);
     if (rbsp_ctx->start == NULL) {
         return OV_ENOMEM;
     }
@@ -890,9 +1254,10 @@ extend_rbsp_cache(struct RBSPCacheData *const rbsp_ctx)
 {
     uint8_t *old_cache = rbsp_ctx->start;
     uint8_t *new_cache;
-    size_t new_size = rbsp_ctx->cache_size + OVRBSP_CACHE_SIZE;
+    /* Grow geometrically so large RBSP are not copied over and over */
+    size_t new_size = rbsp_ctx->cache_size << 1;
 
-    new_cache = ov_malloc(new_size);
+    new_cache = ov_malloc(new_size + OV_RBSP_PADDING);
     if (!new_cache) {
         return OV_ENOMEM;
     }
@@ -3,6 +3,7 @@
 
 #include <stdio.h>
 #include "ovunits.h"
+#include "ovio.h"
 
 typedef struct OVVCDmx OVVCDmx;
 
@@ -10,10 +11,22 @@ int ovdmx_init(OVVCDmx **vvcdmx);
 
 int ovdmx_close(OVVCDmx *vvcdmx);
 
-int ovdmx_attach_stream(OVVCDmx *const dmx, FILE *fstream);
+/* Attach an input stream opened with one of the ovio_stream_open
+ * functions, the demuxer takes ownership of the stream and closes
+ * it on detach.
+ * With feed streams ovdmx_extract_picture_unit() returns OVVC_EAGAIN
+ * when more data is required.
+ */
+int ovdmx_attach_stream(OVVCDmx *const dmx, OVIOStream *io_str);
 
 void ovdmx_detach_stream(OVVCDmx *const dmx);
 
+/* Extract Picture Units from a thread up to queue_depth Picture Units
+ * ahead of ovdmx_extract_picture_unit() calls (0 disables read ahead).
+ * Must be set before attaching a stream.
+ */
+int ovdmx_set_read_ahead(OVVCDmx *const dmx, int queue_depth);
+
 int ovdmx_extract_picture_unit(OVVCDmx *const dmx, OVPictureUnit **dst_pu);
 
 #endif
@@ -61,13 +61,37 @@ struct OVPicture
     atomic_uint ref_count;
     pthread_mutex_t pic_mtx;
 
-    //Map of decoded CTUs
+    /* Decoding progress of CTU lines used for synchronization
+     * of threads using the picture as reference
+     */
     struct PicDecodedCtusInfo {
-        uint64_t** mask;
-        int mask_h;
-        int mask_w;
-        pthread_mutex_t ref_mtx;
-        pthread_cond_t  ref_cnd;
+        struct CTULineProgress {
+            /* Number of CTUs of the line reported as decoded */
+            atomic_uint nb_ctus;
+
+            /* One bit per CTU of the line reported as decoded so
+             * that references only wait for the CTUs they read
+             */
+            atomic_uint_least64_t *ctu_mask;
+
+            pthread_mutex_t line_mtx;
+            pthread_cond_t  line_cnd;
+        } *lines;
+
+        /* Storage of the CTU masks of all lines */
+        atomic_uint_least64_t *ctu_masks;
+        uint16_t nb_mask_words;
+
+        /* Number of first CTU lines completely decoded */
+        atomic_uint nb_lines_done;
+
+        uint16_t nb_ctb_w;
+        uint16_t nb_ctb_h;
+
+        /* Incremented each time the picture is reused, read
+         * concurrently by threads checking their progress cache
+         */
+        atomic_uint decode_id;
     } decoded_ctus;
 
     FrameSynchroFunction ovdpb_frame_synchro;
@@ -161,7 +185,7 @@ struct DPB
    struct DPBInternal internal;
 };
 
-int ovdpb_init(OVDPB **dpb_p, const OVPS *ps);
+int ovdpb_init(OVDPB **dpb_p, const OVPS *ps, int margin);
 
 void ovdpb_uninit(OVDPB **dpb_p);
 
@@ -182,6 +206,8 @@ int16_t tmvp_compute_scale(int32_t dist_current, int32_t dist_colocated);
 
 int ovdpb_output_pic(OVDPB *dpb, OVPicture **out, int output_cvs_id);
 
+int ovdpb_output_ready(const OVDPB *dpb, int output_cvs_id);
+
 int ovdpb_unmark_ref_pic_lists(uint8_t slice_type, OVPicture * current_pic);
 
 
@@ -189,8 +215,6 @@ void ovdpb_report_decoded_ctu_line(OVPicture *const pic, int y_ctu, int xmin_ctu
 
 void ovdpb_report_decoded_frame(OVPicture *const pic);
 
-void ovdpb_get_lines_decoded_ctus(OVPicture *const pic, uint64_t* decoded, int y_start, int y_end );
-
 void ovdpb_no_synchro(OVPicture *const ref_pic, int tl_ctu_x, int tl_ctu_y, int br_ctu_x, int br_ctu_y);
 
 void ovdpb_synchro_ref_decoded_ctus(OVPicture *const ref_pic, int tl_ctu_x, int tl_ctu_y, int br_ctu_x, int br_ctu_y);
@@ -18,6 +18,7 @@ int dpbpriv_request_frame(struct DPBInternal *dpb_priv, OVFrame **frame);
 
 void dpbpriv_uninit_framepool(struct DPBInternal *dpb_priv);
 
-int dpbpriv_init_framepool(struct DPBInternal *dpb_priv, const OVSPS *const sps);
+int dpbpriv_init_framepool(struct DPBInternal *dpb_priv, const OVSPS *const sps,
+                           int margin);
 
 #endif
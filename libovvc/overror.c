@@ -16,6 +16,9 @@ const char * ovvc_error_stringify(uint32_t error_code){
     case OVVC_EUNSUPPORTED:
       return "Unsupported tool.";
       break;
+    case OVVC_EBITDEPTH:
+      return "Bit depth not built.";
+      break;
     default:
       return "Error code not recognized.";
   }
@@ -8,6 +8,8 @@
 #define OVVC_EINDATA          OVVC_ERROR_TAG('I','N','D','A')
 #define OVVC_EUNSUPPORTED     OVVC_ERROR_TAG('U','N','S','P')
 #define OVVC_EAGAIN           OVVC_ERROR_TAG('E','A','G','N')
+/* Stream bit depth differs from the one the library was built for */
+#define OVVC_EBITDEPTH        OVVC_ERROR_TAG('B','D','E','P')
 
 #define OVVC_ERROR_TAG(a,b,c,d) -(((a)<<24)+((b)<<16)+((c)<<8)+(d))
 
@@ -1,8 +1,11 @@
+#include <string.h>
+
 #include "mempool.h"
 #include "mempool_internal.h"
 #include "overror.h"
 #include "ovutils.h"
 #include "ovmem.h"
+#include "bitdepth.h"
 
 #include "ovframe.h"
 
@@ -43,13 +46,16 @@ framepool_request_planes(OVFrame *const frame, struct FramePool *const fp)
 
         frame->internal.pool_elem[i] = pool_elem;
 
-        frame->data[i]     = pool_elem->data;
+        frame->data[i]     = (uint8_t *)pool_elem->data + prop->offset;
 
         frame->width[i]    = prop->width;
         frame->height[i]   = prop->height;
         frame->linesize[i] = prop->stride;
+        frame->margin[i]   = prop->margin;
     }
 
+    frame->frame_info.chromat_format = fp->plane_prop[0].depth ? OV_YUV_420_P10 : OV_YUV_420_P8;
+
     atomic_init(&frame->internal.ref_count, 0);
 
     return 0;
@@ -94,3 +100,75 @@ ovframe_unref(OVFrame **frame)
     }
 
 }
+
+static void
+extend_plane_borders(OVSample *const plane, ptrdiff_t stride, int margin,
+                     int pic_w, int pic_h, int x0, int y0, int x1, int y1)
+{
+    int ext_x0 = x0;
+    int ext_x1 = x1;
+    int y;
+
+    if (x0 == 0) {
+        for (y = y0; y < y1; ++y) {
+            OVSample *row = plane + y * stride;
+            OVSample val = row[0];
+            int x;
+            for (x = -margin; x < 0; ++x) {
+                row[x] = val;
+            }
+        }
+        ext_x0 = -margin;
+    }
+
+    if (x1 == pic_w) {
+        for (y = y0; y < y1; ++y) {
+            OVSample *row = plane + y * stride;
+            OVSample val = row[pic_w - 1];
+            int x;
+            for (x = pic_w; x < pic_w + margin; ++x) {
+                row[x] = val;
+            }
+        }
+        ext_x1 = pic_w + margin;
+    }
+
+    /* Corners are filled from the already extended first and last rows */
+    if (y0 == 0) {
+        const OVSample *src = plane + ext_x0;
+        for (y = -margin; y < 0; ++y) {
+            memcpy(plane + y * stride + ext_x0, src, (ext_x1 - ext_x0) * sizeof(*plane));
+        }
+    }
+
+    if (y1 == pic_h) {
+        const OVSample *src = plane + (pic_h - 1) * stride + ext_x0;
+        for (y = pic_h; y < pic_h + margin; ++y) {
+            memcpy(plane + y * stride + ext_x0, src, (ext_x1 - ext_x0) * sizeof(*plane));
+        }
+    }
+}
+
+void
+ovframe_extend_borders(OVFrame *const frame, int x0, int y0, int x1, int y1)
+{
+    const int nb_comp = 3;
+    int i;
+
+    for (i = 0; i < nb_comp; ++i) {
+        /* FIXME non 420 chroma formats */
+        int shift = !!i;
+        int pic_w = frame->width[i];
+        int pic_h = frame->height[i];
+        int margin = frame->margin[i];
+        int cx1 = OVMIN(x1 >> shift, pic_w);
+        int cy1 = OVMIN(y1 >> shift, pic_h);
+
+        if (!margin || (x0 && cx1 < pic_w && y0 && cy1 < pic_h)) {
+            continue;
+        }
+
+        extend_plane_borders((OVSample *)frame->data[i], frame->linesize[i] / sizeof(OVSample), margin,
+                             pic_w, pic_h, x0 >> shift, y0 >> shift, cx1, cy1);
+    }
+}
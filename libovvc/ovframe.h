@@ -13,6 +13,19 @@ enum ChromaFmt
     OV_YUV_420_P10 = 1,
 };
 
+/* Default number of luma samples allocated around each side
+ * of the picture planes, filled with picture border samples
+ * after decoding so motion compensation can read outside of
+ * the reference picture without edge emulation
+ */
+#define OV_FRAME_MARGIN 160
+
+/* Largest margin which can be set with OVDEC_FRAME_MARGIN */
+#define OV_FRAME_MAX_MARGIN 1024
+
+/* Alignment of planes start and rows in bytes */
+#define OV_FRAME_ALIGN 64
+
 struct MemPool;
 /* Miscelaneous information on Picture */
 struct FrameInfo
@@ -30,6 +43,12 @@ struct PlaneProp
     uint16_t width;
     uint16_t height;
     uint16_t depth;
+
+    /* Number of padding samples around the picture
+     * and offset in bytes of the first picture sample
+     */
+    uint16_t margin;
+    uint32_t offset;
 };
 
 struct FramePool
@@ -57,6 +76,11 @@ struct Frame
     size_t width[3];
     size_t height[3];
 
+    /* Per component number of samples available around
+     * planes borders
+     */
+    size_t margin[3];
+
     /* Picture Order Count */
     uint32_t poc;
 
@@ -76,4 +100,10 @@ int ovframe_new_ref(OVFrame **dst, OVFrame *src);
 void ovframe_unref(OVFrame **frame);
 
 int framepool_request_planes(OVFrame *const frame, struct FramePool *const fp);
+
+/* Copy border samples of the luma area [x0, x1[ x [y0, y1[ and the
+ * corresponding chroma areas into the frame margins when the area
+ * touches the picture borders
+ */
+void ovframe_extend_borders(OVFrame *const frame, int x0, int y0, int x1, int y1);
 #endif
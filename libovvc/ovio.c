@@ -1,8 +1,23 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "ovconfig.h"
+
+#if HAVE_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include "ovmem.h"
+#include "overror.h"
+#include "ovutils.h"
+#include "mempool.h"
+#include "mempool_internal.h"
 
 #include "ovio.h"
 
@@ -10,45 +25,132 @@
 
 #define OVIO_BUFF_SIZE (1 << 16)
 
-typedef struct OVReadBuff{
+/* Note we keep a 8 bytes left and 8 bytes padding at the right of
+ * each chunk in order to store the last bytes of the previous chunk
+ * of the bytestream 8 bytes is because we might want to use 64bit types
+ * in order to quickly probe for successive zero bytes
+ */
+#define OVIO_CHUNK_PADDING 8
+
+/* Files smaller than this are read instead of being mapped */
+#define OVIO_MMAP_MIN_SIZE (2 * OVIO_BUFF_SIZE)
+
+struct OVIOChunk {
+    /* Bytestream is cached from this position in chunk memory
+     */
     uint8_t *bytestream;
+
+    /* Number of stream bytes available from bytestream */
+    size_t size;
+
+    /* Chunk is released when no NAL Unit nor reader refers
+     * to it anymore
+     */
+    atomic_uint ref_count;
+
+    void (*release)(OVIOChunk *chunk);
+
+    /* Pool element for chunks read in pool memory,
+     * mapping length for memory mapped chunks
+     */
+    MemPoolElem *pool_ref;
+    size_t map_size;
+};
+
+/* Buffer given by user to a feed stream */
+struct OVIOFeedBuff {
+    const uint8_t *data;
+    size_t size;
+    size_t pos;
+
+    void (*release)(void *opaque);
     void *opaque;
-}OVReadBuff;
 
-struct OVIOStream {
-    FILE *fstream;
-    const uint8_t *bytestream;
-    OVReadBuff opaque_cache;
+    struct OVIOFeedBuff *next;
 };
 
+struct OVIOBackend {
+    const char *name;
 
-static int ovread_buff_init(struct OVReadBuff *const cache_buff,
-                             size_t buff_size);
+    /* Copy up to size bytes of the stream to dst and returns the number
+     * of copied bytes. Sets io_str->eof once end of stream is reached
+     * a return value of 0 without eof means no data is available yet
+     */
+    size_t (*read)(OVIOStream *io_str, uint8_t *dst, size_t size);
 
-static void ovread_buff_close(struct OVReadBuff *const cache_buff);
+    /* Optional: returns a chunk referring directly to backend memory
+     * instead of a copy, used for first chunk only
+     */
+    OVIOChunk *(*map)(OVIOStream *io_str);
 
-OVIOStream *
-ovio_stream_open(FILE *fstream)
+    /* Optional: move to offset bytes from stream start */
+    int (*seek)(OVIOStream *io_str, long int offset);
+
+    void (*close)(OVIOStream *io_str);
+};
+
+struct OVIOStream {
+    const struct OVIOBackend *backend;
+
+    /* Pool of chunks read from the stream, chunks can outlive
+     * the stream as long as NAL Units refer to them
+     */
+    MemPool *chunk_pool;
+
+    /* Last chunk read, used to keep a copy of its last bytes
+     * into next chunk left padding
+     */
+    OVIOChunk *last_chunk;
+
+    /* Chunk partially filled by a feed stream waiting for more data */
+    OVIOChunk *pending_chunk;
+
+    /* Number of bytes read from stream start */
+    long int pos;
+
+    uint8_t eof;
+    uint8_t error;
+
+    /* Backends private data */
+    FILE *fstream;
+    uint8_t close_fstream;
+
+    struct {
+        OVIOChunk *chunk;
+        const uint8_t *data;
+        size_t size;
+        size_t pos;
+    } map;
+
+    OVIOCallbacks cb;
+
+    struct {
+        pthread_mutex_t mtx;
+        struct OVIOFeedBuff *first;
+        struct OVIOFeedBuff *last;
+        uint8_t end;
+    } feed;
+};
+
+static OVIOStream *
+ovio_stream_alloc(const struct OVIOBackend *backend)
 {
     OVIOStream *io_str;
-    int ret;
-    if (fstream == NULL) {
-        return NULL;
-    }
+    size_t chunk_size = sizeof(OVIOChunk) + OVIO_CHUNK_PADDING + OVIO_BUFF_SIZE
+                      + OVIO_CHUNK_PADDING;
 
     io_str = ov_mallocz(sizeof(OVIOStream));
     if (io_str == NULL) {
         return io_str;
     }
 
-    ret = ovread_buff_init(&io_str->opaque_cache, OVIO_BUFF_SIZE);
-    if (ret < 0) {
+    io_str->chunk_pool = ovmempool_init(chunk_size);
+    if (io_str->chunk_pool == NULL) {
         ov_freep(&io_str);
         return io_str;
     }
 
-    io_str->fstream = fstream;
-    io_str->bytestream = io_str->opaque_cache.bytestream;
+    io_str->backend = backend;
 
     return io_str;
 }
@@ -56,98 +158,620 @@ ovio_stream_open(FILE *fstream)
 void
 ovio_stream_close(OVIOStream *io_str)
 {
-    ovread_buff_close(&io_str->opaque_cache);
+    if (io_str->last_chunk) {
+        ovio_chunk_unref(&io_str->last_chunk);
+    }
+
+    if (io_str->pending_chunk) {
+        ovio_chunk_unref(&io_str->pending_chunk);
+    }
+
+    if (io_str->backend->close) {
+        io_str->backend->close(io_str);
+    }
+
+    /* Pool is actually freed when last chunk referenced by a NAL Unit
+     * is released
+     */
+    ovmempool_uninit(&io_str->chunk_pool);
     ov_free(io_str);
 }
 
-static int
-ovread_buff_init(struct OVReadBuff *const cache_buff, size_t buff_size)
+static void
+release_pool_chunk(OVIOChunk *chunk)
 {
+    ovmempool_pushelem(chunk->pool_ref);
+}
+
+static OVIOChunk *
+ovio_chunk_alloc(OVIOStream *const io_str)
+{
+    MemPoolElem *elem = ovmempool_popelem(io_str->chunk_pool);
+    OVIOChunk *chunk;
     uint8_t *byte_stream;
 
-    /* Note we keep a 8 bytes left and 8 bytes padding at the right of
-     * our buffer in order to check,to store the last bytes of the
-     * previous chunk of the bytestream 8 bytes is because we might
-     * want to use 64bit types in order to quickly probe for successive
-     * zero bytes
-     */
-    byte_stream = ov_mallocz(8 + buff_size + 8);
+    if (!elem) {
+        return NULL;
+    }
+
+    chunk = elem->data;
+    byte_stream = (uint8_t *)(chunk + 1);
+
+    chunk->pool_ref = elem;
+    chunk->release = &release_pool_chunk;
+    chunk->bytestream = byte_stream + OVIO_CHUNK_PADDING;
+    chunk->size = 0;
+    atomic_init(&chunk->ref_count, 1);
 
-    if (byte_stream == NULL) {
+    /* FIXME this might depend on the demux maybe this should
+       be done somewhere else this force cache buffer */
+    if (io_str->last_chunk) {
+        const OVIOChunk *last = io_str->last_chunk;
+        const uint8_t *last_end = last->bytestream + last->size;
+        memcpy(chunk->bytestream - OVIO_CHUNK_PADDING, last_end - OVIO_CHUNK_PADDING,
+               sizeof(*byte_stream) * OVIO_CHUNK_PADDING);
+    } else {
+        memset(chunk->bytestream - OVIO_CHUNK_PADDING, 0, sizeof(*byte_stream) * OVIO_CHUNK_PADDING);
+    }
+
+    return chunk;
+}
+
+int
+ovio_chunk_new_ref(OVIOChunk **chunk_p, OVIOChunk *chunk)
+{
+    if (!chunk) {
         return -1;
     }
 
-    cache_buff->opaque = (void *)byte_stream;
+    atomic_fetch_add_explicit(&chunk->ref_count, 1, memory_order_acq_rel);
+
+    *chunk_p = chunk;
+
+    return 0;
+}
+
+void
+ovio_chunk_unref(OVIOChunk **chunk_p)
+{
+    OVIOChunk *chunk = *chunk_p;
+
+    if (!chunk) {
+        return;
+    }
+
+    if (atomic_fetch_sub_explicit(&chunk->ref_count, 1, memory_order_acq_rel) == 1) {
+        chunk->release(chunk);
+    }
+
+    *chunk_p = NULL;
+}
+
+static int
+fill_chunk(OVIOStream *const io_str, OVIOChunk *chunk)
+{
+    const struct OVIOBackend *backend = io_str->backend;
+
+    while (chunk->size < OVIO_BUFF_SIZE && !io_str->eof) {
+        size_t nb_bytes = backend->read(io_str, chunk->bytestream + chunk->size,
+                                        OVIO_BUFF_SIZE - chunk->size);
+        if (!nb_bytes) {
+            break;
+        }
+
+        chunk->size += nb_bytes;
+        io_str->pos += nb_bytes;
+    }
 
-    /* Bytestream will be cached from this position in allocated memory
-     * the padding byte will be used to keep a copy of the last 8 bytes
-     * in order to check for start codes overlapping between two chunks
+    /* Chunks but the last one keep at least two paddings so the last
+     * bytes copied to next chunk do not overlap previous chunk
      */
-    cache_buff->bytestream = byte_stream + 8;
+    if (!io_str->eof && chunk->size < 2 * OVIO_CHUNK_PADDING) {
+        return OVVC_EAGAIN;
+    }
 
-    /* last 16 bytes are set to 0xFF so we do not detect any zero byte
+    /* last 8 bytes are set to 0xFF so we do not detect any zero byte
      * past the actual available data when checking for a start or emulation
      * prevention code.
      * Using. 0xFF shoul prevent patterns such as 0x000003 or 0x000001
-     * we used 16 bytes so first copy from read function will copy 0XFF
-     * bytes at the averlapping area reader will then ignore them since
-     * it cannot be taken as start code.
+     * reader will then ignore them since it cannot be taken as start code.
      */
-    memset(byte_stream + 8 + buff_size, 0XFF, sizeof(*byte_stream) * 8);
+    memset(chunk->bytestream + chunk->size, 0xFF, OVIO_CHUNK_PADDING);
 
-    return 1;
+    return 0;
 }
 
-void
-ovread_buff_close(struct OVReadBuff *const cache_buff)
+int
+ovio_stream_read(OVIOChunk **dst_chunk, const uint8_t **dst_buff, size_t *dst_size,
+                 OVIOStream *const io_str)
 {
-    cache_buff->bytestream = NULL;
+    const struct OVIOBackend *backend = io_str->backend;
+    OVIOChunk *chunk = NULL;
+    int ret;
+
+    *dst_chunk = NULL;
+    *dst_buff = NULL;
+    *dst_size = 0;
+
+    if (!io_str->last_chunk && backend->map) {
+        chunk = backend->map(io_str);
+    }
+
+    if (!chunk) {
+        chunk = io_str->pending_chunk;
+        io_str->pending_chunk = NULL;
+
+        if (!chunk) {
+            chunk = ovio_chunk_alloc(io_str);
+            if (!chunk) {
+                return OVVC_ENOMEM;
+            }
+        }
+
+        ret = fill_chunk(io_str, chunk);
+        if (ret < 0) {
+            /* Keep partial data until more is fed to the stream */
+            io_str->pending_chunk = chunk;
+            return ret;
+        }
+    }
+
+    if (io_str->last_chunk) {
+        ovio_chunk_unref(&io_str->last_chunk);
+    }
 
-    ov_freep(&cache_buff->opaque);
+    io_str->last_chunk = chunk;
+
+    /* Reader gets its own reference on chunk */
+    ovio_chunk_new_ref(dst_chunk, chunk);
+
+    *dst_buff = chunk->bytestream;
+    *dst_size = chunk->size;
+
+    return 0;
 }
 
-/* FIXME find a way to give a pointer to cache directly to bytestream */
-size_t
-ovio_stream_read(const uint8_t **dst_buff, size_t size, OVIOStream *const io_str)
+int
+ovio_stream_seek(OVIOStream *const io_str, long int offset)
 {
-    const size_t i_buff_size = OVIO_BUFF_SIZE;
-    FILE *fstream = io_str->fstream;
-    uint8_t *cache_start = io_str->opaque_cache.bytestream;
-    uint8_t *cache_end = cache_start + i_buff_size;
-    size_t read_in_buf;
+    int ret;
 
-    /* FIXME this might depend on the demux maybe this should
-       be done somewhere else this force cache buffer */
-    memcpy(cache_start - 8, cache_end - 8, sizeof(*cache_start) * 8);
+    if (!io_str->backend->seek) {
+        return OVVC_EUNSUPPORTED;
+    }
 
-    read_in_buf = fread(cache_start, i_buff_size, 1, fstream);
+    ret = io_str->backend->seek(io_str, offset);
+    if (ret < 0) {
+        return ret;
+    }
+
+    if (io_str->last_chunk) {
+        ovio_chunk_unref(&io_str->last_chunk);
+    }
+
+    if (io_str->pending_chunk) {
+        ovio_chunk_unref(&io_str->pending_chunk);
+    }
 
-    *dst_buff = cache_start;
+    io_str->pos = offset;
+    io_str->eof = 0;
 
-    return read_in_buf;
+    return 0;
 }
 
-/* FIXME decide of an EOF value check what is usual*/
 int
 ovio_stream_eof(OVIOStream *const io_str)
 {
-    FILE *fstream = io_str->fstream;
-
-    return feof(fstream);
+    return io_str->eof;
 }
 
 int
 ovio_stream_error(OVIOStream *const io_str)
 {
-    FILE *fstream = io_str->fstream;
-
-    return ferror(fstream);
+    return io_str->error;
 }
 
 long int
 ovio_stream_tell(OVIOStream *const io_str)
+{
+    return io_str->pos;
+}
+
+/* FILE backend */
+static size_t
+file_read(OVIOStream *io_str, uint8_t *dst, size_t size)
 {
     FILE *fstream = io_str->fstream;
+    size_t nb_bytes = fread(dst, 1, size, fstream);
+
+    if (nb_bytes < size) {
+        io_str->error = !!ferror(fstream);
+        io_str->eof = 1;
+    }
+
+    return nb_bytes;
+}
+
+static int
+file_seek(OVIOStream *io_str, long int offset)
+{
+    if (fseek(io_str->fstream, offset, SEEK_SET) < 0) {
+        return OVVC_EINDATA;
+    }
+
+    return 0;
+}
+
+static void
+file_close(OVIOStream *io_str)
+{
+    if (io_str->close_fstream) {
+        fclose(io_str->fstream);
+    }
+}
+
+static const struct OVIOBackend file_backend = {
+    .name  = "file",
+    .read  = &file_read,
+    .seek  = &file_seek,
+    .close = &file_close,
+};
+
+OVIOStream *
+ovio_stream_open(FILE *fstream)
+{
+    OVIOStream *io_str;
+    if (fstream == NULL) {
+        return NULL;
+    }
+
+    io_str = ovio_stream_alloc(&file_backend);
+    if (io_str == NULL) {
+        return io_str;
+    }
+
+    io_str->fstream = fstream;
+
+    return io_str;
+}
+
+/* Memory mapped file backend
+ * The whole file but its last bytes is given as a single chunk
+ * referring to the mapping so NAL Units need not be copied at all.
+ * Remaining bytes are copied to a regular chunk so that the last
+ * chunk is padded.
+ */
+#if HAVE_MMAP
+static void
+release_map_chunk(OVIOChunk *chunk)
+{
+    munmap(chunk->bytestream, chunk->map_size);
+    ov_free(chunk);
+}
+
+static OVIOChunk *
+map_map(OVIOStream *io_str)
+{
+    if (io_str->map.pos || io_str->map.size < OVIO_MMAP_MIN_SIZE) {
+        return NULL;
+    }
+
+    /* Keep enough bytes after the chunk so reading padding
+     * never goes past the mapping
+     */
+    io_str->map.chunk->size = io_str->map.size - 2 * OVIO_CHUNK_PADDING;
+    io_str->map.pos = io_str->map.chunk->size;
+    io_str->pos = io_str->map.pos;
+
+    ovio_chunk_new_ref(&io_str->map.chunk, io_str->map.chunk);
+
+    return io_str->map.chunk;
+}
+
+static size_t
+map_read(OVIOStream *io_str, uint8_t *dst, size_t size)
+{
+    size_t nb_bytes = OVMIN(size, io_str->map.size - io_str->map.pos);
+
+    memcpy(dst, io_str->map.data + io_str->map.pos, nb_bytes);
+
+    io_str->map.pos += nb_bytes;
+    io_str->eof = io_str->map.pos == io_str->map.size;
+
+    return nb_bytes;
+}
+
+static int
+map_seek(OVIOStream *io_str, long int offset)
+{
+    if (offset < 0 || (size_t)offset > io_str->map.size) {
+        return OVVC_EINDATA;
+    }
+
+    io_str->map.pos = offset;
+
+    return 0;
+}
+
+static void
+map_close(OVIOStream *io_str)
+{
+    /* Mapping is released with the last NAL Unit referring to it */
+    ovio_chunk_unref(&io_str->map.chunk);
+}
+
+static const struct OVIOBackend map_backend = {
+    .name  = "mmap",
+    .read  = &map_read,
+    .map   = &map_map,
+    .seek  = &map_seek,
+    .close = &map_close,
+};
+
+OVIOStream *
+ovio_stream_open_mmap(const char *filename)
+{
+    OVIOStream *io_str;
+    OVIOChunk *chunk;
+    struct stat st;
+    void *data;
+    int fd;
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        ov_log(NULL, OVLOG_ERROR, "Could not open %s.\n", filename);
+        return NULL;
+    }
+
+    if (fstat(fd, &st) < 0 || !st.st_size) {
+        ov_log(NULL, OVLOG_ERROR, "Could not get size of %s.\n", filename);
+        goto failmap;
+    }
+
+    data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        ov_log(NULL, OVLOG_ERROR, "Could not map %s.\n", filename);
+        goto failmap;
+    }
+
+    close(fd);
+
+    chunk = ov_mallocz(sizeof(*chunk));
+    if (!chunk) {
+        munmap(data, st.st_size);
+        return NULL;
+    }
+
+    chunk->bytestream = data;
+    chunk->map_size = st.st_size;
+    chunk->release = &release_map_chunk;
+    atomic_init(&chunk->ref_count, 1);
+
+    io_str = ovio_stream_alloc(&map_backend);
+    if (io_str == NULL) {
+        release_map_chunk(chunk);
+        return io_str;
+    }
+
+    io_str->map.chunk = chunk;
+    io_str->map.data = data;
+    io_str->map.size = st.st_size;
+
+    return io_str;
+
+failmap:
+    close(fd);
+    return NULL;
+}
+#else
+OVIOStream *
+ovio_stream_open_mmap(const char *filename)
+{
+    OVIOStream *io_str;
+    FILE *fstream = fopen(filename, "rb");
+    if (fstream == NULL) {
+        ov_log(NULL, OVLOG_ERROR, "Could not open %s.\n", filename);
+        return NULL;
+    }
+
+    /* Memory mapping not available fall back to reading file */
+    io_str = ovio_stream_open(fstream);
+    if (io_str == NULL) {
+        fclose(fstream);
+        return io_str;
+    }
+
+    io_str->close_fstream = 1;
+
+    return io_str;
+}
+#endif
+
+/* User callbacks backend */
+static size_t
+cb_read(OVIOStream *io_str, uint8_t *dst, size_t size)
+{
+    long int nb_bytes = io_str->cb.read(io_str->cb.opaque, dst, size);
+
+    if (nb_bytes <= 0) {
+        io_str->error = nb_bytes < 0;
+        io_str->eof = 1;
+        return 0;
+    }
+
+    return nb_bytes;
+}
+
+static int
+cb_seek(OVIOStream *io_str, long int offset)
+{
+    if (!io_str->cb.seek) {
+        return OVVC_EUNSUPPORTED;
+    }
+
+    if (io_str->cb.seek(io_str->cb.opaque, offset) < 0) {
+        return OVVC_EINDATA;
+    }
+
+    return 0;
+}
+
+static void
+cb_close(OVIOStream *io_str)
+{
+    if (io_str->cb.close) {
+        io_str->cb.close(io_str->cb.opaque);
+    }
+}
+
+static const struct OVIOBackend cb_backend = {
+    .name  = "callbacks",
+    .read  = &cb_read,
+    .seek  = &cb_seek,
+    .close = &cb_close,
+};
+
+OVIOStream *
+ovio_stream_open_cb(const OVIOCallbacks *cb)
+{
+    OVIOStream *io_str;
+    if (cb == NULL || cb->read == NULL) {
+        return NULL;
+    }
+
+    io_str = ovio_stream_alloc(&cb_backend);
+    if (io_str == NULL) {
+        return io_str;
+    }
+
+    io_str->cb = *cb;
+
+    return io_str;
+}
+
+/* Memory feed backend
+ * Buffers fed by the user are queued and copied into chunks as the
+ * demuxer requests data, each buffer is released as soon as it has
+ * been entirely copied.
+ */
+static size_t
+feed_read(OVIOStream *io_str, uint8_t *dst, size_t size)
+{
+    size_t nb_bytes = 0;
+
+    pthread_mutex_lock(&io_str->feed.mtx);
+
+    while (io_str->feed.first && nb_bytes < size) {
+        struct OVIOFeedBuff *buff = io_str->feed.first;
+        size_t cpy_size = OVMIN(size - nb_bytes, buff->size - buff->pos);
+
+        memcpy(dst + nb_bytes, buff->data + buff->pos, cpy_size);
+
+        buff->pos += cpy_size;
+        nb_bytes  += cpy_size;
+
+        if (buff->pos == buff->size) {
+            io_str->feed.first = buff->next;
+            if (!buff->next) {
+                io_str->feed.last = NULL;
+            }
+
+            if (buff->release) {
+                buff->release(buff->opaque);
+            }
+
+            ov_free(buff);
+        }
+    }
+
+    io_str->eof = !io_str->feed.first && io_str->feed.end;
+
+    pthread_mutex_unlock(&io_str->feed.mtx);
+
+    return nb_bytes;
+}
+
+static void
+feed_close(OVIOStream *io_str)
+{
+    struct OVIOFeedBuff *buff = io_str->feed.first;
+    while (buff) {
+        struct OVIOFeedBuff *to_free = buff;
+        buff = buff->next;
+        if (to_free->release) {
+            to_free->release(to_free->opaque);
+        }
+        ov_free(to_free);
+    }
+
+    pthread_mutex_destroy(&io_str->feed.mtx);
+}
+
+static const struct OVIOBackend feed_backend = {
+    .name  = "feed",
+    .read  = &feed_read,
+    .close = &feed_close,
+};
+
+OVIOStream *
+ovio_stream_open_feed(void)
+{
+    OVIOStream *io_str = ovio_stream_alloc(&feed_backend);
+    if (io_str == NULL) {
+        return io_str;
+    }
+
+    pthread_mutex_init(&io_str->feed.mtx, NULL);
+
+    return io_str;
+}
+
+int
+ovio_stream_feed(OVIOStream *const io_str, const uint8_t *data, size_t size,
+                 void (*release)(void *opaque), void *opaque)
+{
+    struct OVIOFeedBuff *buff;
+
+    if (io_str->backend != &feed_backend) {
+        return OVVC_EUNSUPPORTED;
+    }
+
+    buff = ov_mallocz(sizeof(*buff));
+    if (!buff) {
+        return OVVC_ENOMEM;
+    }
+
+    buff->data = data;
+    buff->size = size;
+    buff->release = release;
+    buff->opaque = opaque;
+
+    pthread_mutex_lock(&io_str->feed.mtx);
+    if (io_str->feed.end) {
+        pthread_mutex_unlock(&io_str->feed.mtx);
+        ov_free(buff);
+        return OVVC_EINDATA;
+    }
+
+    if (io_str->feed.last) {
+        io_str->feed.last->next = buff;
+    } else {
+        io_str->feed.first = buff;
+    }
+    io_str->feed.last = buff;
+    pthread_mutex_unlock(&io_str->feed.mtx);
+
+    return 0;
+}
+
+void
+ovio_stream_feed_end(OVIOStream *const io_str)
+{
+    if (io_str->backend != &feed_backend) {
+        return;
+    }
 
-    return ftell(fstream);
+    pthread_mutex_lock(&io_str->feed.mtx);
+    io_str->feed.end = 1;
+    pthread_mutex_unlock(&io_str->feed.mtx);
 }
@@ -2,6 +2,7 @@
 #define OVIO_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 
 /*
@@ -12,12 +13,76 @@
 
 typedef struct OVIOStream OVIOStream;
 
-/* TODO open / close */
+/* Reference counted chunk of bytestream read from an OVIOStream
+ * NAL Units can refer to it instead of owning a copy of their data
+ */
+typedef struct OVIOChunk OVIOChunk;
+
+/* User defined input used by ovio_stream_open_cb() */
+typedef struct OVIOCallbacks {
+    void *opaque;
+
+    /* Read up to size bytes into dst, returns the number of bytes
+     * read, 0 at end of stream and a negative value on error
+     */
+    long int (*read)(void *opaque, uint8_t *dst, size_t size);
+
+    /* Optional: move to offset bytes from stream start
+     * returns a negative value on error
+     */
+    int (*seek)(void *opaque, long int offset);
+
+    /* Optional: called when the stream is closed */
+    void (*close)(void *opaque);
+} OVIOCallbacks;
+
+/* Read from a FILE opened by the caller, the FILE is not closed
+ * by ovio_stream_close()
+ */
 OVIOStream *ovio_stream_open(FILE *fstream);
 
+/* Map a file in memory, NAL Units then refer to the mapping
+ * instead of a copy. Falls back to reading the file when memory
+ * mapping is not available.
+ */
+OVIOStream *ovio_stream_open_mmap(const char *filename);
+
+OVIOStream *ovio_stream_open_cb(const OVIOCallbacks *cb);
+
+/* Stream reading memory buffers given through ovio_stream_feed()
+ * Reading from the stream returns OVVC_EAGAIN when not enough
+ * data was fed and ovio_stream_feed_end() was not called.
+ */
+OVIOStream *ovio_stream_open_feed(void);
+
+/* Append size bytes at data to a feed stream. Data must stay valid
+ * until release is called with opaque once data has been consumed
+ * (release can be NULL). Can be called from any thread.
+ */
+int ovio_stream_feed(OVIOStream *const io_str, const uint8_t *data, size_t size,
+                     void (*release)(void *opaque), void *opaque);
+
+/* Signal no more data will be fed to the stream */
+void ovio_stream_feed_end(OVIOStream *const io_str);
+
 void ovio_stream_close(OVIOStream *io_str);
 
-size_t ovio_stream_read(const uint8_t **dst_buff, size_t size, OVIOStream *const io_str);
+/* Read next chunk of stream, dst_chunk receives a new reference on
+ * the chunk the dst_size bytes pointed by dst_buff belong to.
+ * The 8 bytes preceding dst_buff are a copy of the previous chunk last
+ * bytes, and 8 bytes of padding follow the last chunk of the stream.
+ */
+int ovio_stream_read(OVIOChunk **dst_chunk, const uint8_t **dst_buff, size_t *dst_size,
+                     OVIOStream *const io_str);
+
+/* Move to offset bytes from stream start, this must be done
+ * before the stream is attached to a demuxer
+ */
+int ovio_stream_seek(OVIOStream *const io_str, long int offset);
+
+int ovio_chunk_new_ref(OVIOChunk **chunk_p, OVIOChunk *chunk);
+
+void ovio_chunk_unref(OVIOChunk **chunk_p);
 
 int ovio_stream_eof(OVIOStream *const io_str);
 
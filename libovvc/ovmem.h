@@ -2,7 +2,8 @@
 #define OVMEM_H
 #include <stddef.h>
 
-#define ALIGN 32
+/* Cache line size so frame planes rows can start on a line */
+#define ALIGN 64
 
 #define DECLARE_ALIGNED(n, t, v) t __attribute__ ((aligned (n))) v
 #define ov_malloc_attrib   __attribute__((__malloc__))
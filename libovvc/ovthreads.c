@@ -1,6 +1,10 @@
 #include <pthread.h>
 /* FIXME tmp*/
 #include <stdatomic.h>
+#if !_WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#endif
 
 #include "slicedec.h"
 #include "overror.h"
@@ -10,239 +14,591 @@
 #include "ovdpb.h"
 
 /*
-Functions for the threads decoding rectangular entries
+Functions for the decoder thread pool
 */
-struct EntryThread
+struct OVJobQueue
 {
-    struct SliceThread *parent;
-    pthread_t thread;
-    pthread_mutex_t entry_mtx;
-    pthread_cond_t  entry_cnd;
+    struct OVJob *first_job;
+    struct OVJob *last_job;
+};
 
+struct OVWorker
+{
+    struct OVThreadPool *pool;
+    pthread_t thread;
 
-    /* CTU decoder associated to entry 
-     * thread
+    /* Jobs submitted to this worker for each priority level,
+     * other workers steal from these queues when theirs are empty
      */
-    OVCTUDec *ctudec;
+    pthread_mutex_t queue_mtx;
+    struct OVJobQueue queues[OV_POOL_NB_PRIO + 1];
 
-    int state;
-    int kill;
+    /* Position in priority schedule */
+    unsigned sched_pos;
 };
 
-void uninit_entry_threads(struct SliceThread *th_slice);
+/* Worker running on the current thread, NULL outside of pools */
+static _Thread_local struct OVWorker *current_worker;
 
-static int
-thread_decode_entries(struct SliceThread *th_slice, struct EntryThread *tdec)
+/* Priority level looked up first on successive picks so that
+ * higher priorities are served four and two times more often than
+ * the lowest one while lower priorities are never starved
+ */
+static const uint8_t prio_schedule[7] = {2, 1, 2, 0, 2, 1, 2};
+
+static struct OVJob *
+worker_pop_job(struct OVWorker *worker, int prio)
 {
-    uint16_t nb_entries      = th_slice->nb_entries;
-    uint16_t nb_entry_th = th_slice->nb_entry_th;
+    struct OVJobQueue *const queue = &worker->queues[prio];
+    struct OVJob *job;
+
+    pthread_mutex_lock(&worker->queue_mtx);
+    job = queue->first_job;
+    if (job) {
+        queue->first_job = job->next;
+        if (!queue->first_job) {
+            queue->last_job = NULL;
+        }
+        atomic_fetch_sub_explicit(&worker->pool->nb_pending, 1, memory_order_acq_rel);
+    }
+    pthread_mutex_unlock(&worker->queue_mtx);
 
-    unsigned first_job = atomic_fetch_add_explicit(&th_slice->first_job, 1, memory_order_acq_rel);
-    unsigned entry_idx = first_job;
-    ov_log(NULL, OVLOG_DEBUG, "Decoder with POC %d, start entry, nb_entries %d\n", th_slice->owner->pic->poc, nb_entries);
-    do {
-        OVCTUDec *const ctudec  = tdec->ctudec;
-        OVSliceDec *const sldec = th_slice->owner;
-        const OVPS *const prms  = sldec->active_params;
+    return job;
+}
 
-        th_slice->decode_entry(sldec, ctudec, prms, entry_idx);
+/* Note both the owner and the thieves take the oldest job of
+ * a queue so a job never waits on a job queued behind it
+ * (i.e. next CTU line or next picture in decoding order).
+ * Entry jobs of a decoder all share the same priority level.
+ */
+static struct OVJob *
+worker_steal_job(struct OVWorker *worker, int prio)
+{
+    struct OVThreadPool *const pool = worker->pool;
+    int worker_idx = worker - pool->workers;
+    int i;
 
-        entry_idx = atomic_fetch_add_explicit(&th_slice->last_entry_idx, 1, memory_order_acq_rel);
+    for (i = 1; i < pool->nb_workers; ++i) {
+        struct OVWorker *victim = &pool->workers[(worker_idx + i) % pool->nb_workers];
+        struct OVJob *job = worker_pop_job(victim, prio);
+        if (job) {
+            return job;
+        }
+    }
 
-    } while (entry_idx < nb_entries);
+    return NULL;
+}
 
-    /* Last thread to exit loop will have entry_idx set to nb_entry + nb_entry_th - 1*/
-    return entry_idx == nb_entries + nb_entry_th - 1;
+static struct OVJob *
+worker_next_job(struct OVWorker *worker)
+{
+    int first_prio = prio_schedule[worker->sched_pos++ % sizeof(prio_schedule)];
+    struct OVJob *job = worker_pop_job(worker, OV_POOL_PRIO_UNBLOCK);
+    int prio;
+
+    if (!job) {
+        job = worker_steal_job(worker, OV_POOL_PRIO_UNBLOCK);
+    }
+
+    if (!job) {
+        job = worker_pop_job(worker, first_prio);
+    }
+
+    if (!job) {
+        job = worker_steal_job(worker, first_prio);
+    }
+
+    /* Fallback on other levels from highest to lowest priority */
+    for (prio = OV_POOL_NB_PRIO - 1; prio >= 0 && !job; --prio) {
+        if (prio != first_prio) {
+            job = worker_pop_job(worker, prio);
+            if (!job) {
+                job = worker_steal_job(worker, prio);
+            }
+        }
+    }
+
+    return job;
+}
+
+static void *
+worker_main_function(void *opaque)
+{
+    struct OVWorker *worker = (struct OVWorker *)opaque;
+    struct OVThreadPool *const pool = worker->pool;
+    uint8_t kill = 0;
+
+    current_worker = worker;
+
+    while (!kill) {
+        struct OVJob *job = worker_next_job(worker);
+
+        if (job) {
+            job->run(job->opaque, job->idx);
+            continue;
+        }
+
+        pthread_mutex_lock(&pool->pool_mtx);
+        while (!atomic_load_explicit(&pool->nb_pending, memory_order_acquire) && !pool->kill) {
+            pool->nb_idle++;
+            pthread_cond_wait(&pool->pool_cnd, &pool->pool_mtx);
+            pool->nb_idle--;
+        }
+
+        /* Remaining jobs are processed before exiting */
+        kill = pool->kill && !atomic_load_explicit(&pool->nb_pending, memory_order_acquire);
+        pthread_mutex_unlock(&pool->pool_mtx);
+    }
+
+    return NULL;
+}
+
+/* Must be called with pool mutex locked */
+static int
+pool_start_worker(struct OVThreadPool *pool)
+{
+    struct OVWorker *worker = &pool->workers[pool->nb_started];
+
+    if (pthread_create(&worker->thread, NULL, worker_main_function, worker)) {
+        ov_log(NULL, OVLOG_ERROR, "Thread creation failed in thread pool\n");
+        return OVVC_ENOMEM;
+    }
+
+    pool->nb_started++;
+    ov_log(NULL, OVLOG_DEBUG, "Thread pool started worker %d\n", pool->nb_started - 1);
+
+    return 0;
 }
 
 int
-ovthread_decode_entries(struct SliceThread *th_slice, DecodeFunc decode_entry, int nb_entries)
+ovthread_pool_submit(struct OVThreadPool *pool, struct OVJob *job)
 {
-    int i;
-    int nb_entry_th = OVMIN(nb_entries, th_slice->nb_entry_th);
+    struct OVWorker *worker;
+    struct OVJobQueue *queue;
 
-    th_slice->nb_entries = nb_entries;
-    th_slice->decode_entry = decode_entry;
+    job->next = NULL;
 
-    atomic_store_explicit(&th_slice->first_job, 0, memory_order_relaxed);
-    atomic_store_explicit(&th_slice->last_entry_idx, th_slice->nb_entry_th, memory_order_relaxed);
+    pthread_mutex_lock(&pool->pool_mtx);
 
-    /* Wake entry decoder threads by setting their state to 0 
-     * and signaling on entry condition
+    /* Workers are started lazily when no worker is waiting for a job
+     * No worker is started once the pool is closing since it could
+     * be missed by the join of ovthread_pool_uninit()
      */
-    for (i = 0; i < nb_entry_th; ++i) {
-        struct EntryThread *tdec = &th_slice->tdec[i];
-        pthread_mutex_lock(&tdec->entry_mtx);
-        tdec->ctudec = th_slice->owner->ctudec_list[i];
-        tdec->state = 0;
-        pthread_cond_signal(&tdec->entry_cnd);
-        pthread_mutex_unlock(&tdec->entry_mtx);
-        ov_log(NULL, OVLOG_DEBUG, "Main launches POC %d entry %d\n", th_slice->owner->pic->poc, i);
+    if (!pool->nb_idle && pool->nb_started < pool->nb_workers && !pool->kill) {
+        int ret = pool_start_worker(pool);
+        if (ret < 0 && !pool->nb_started) {
+            pthread_mutex_unlock(&pool->pool_mtx);
+            return ret;
+        }
     }
 
-    //TODOpar: re-use when the entry entry will be launched by slice threads.  
-    /* Main thread wait until all active_state has been set to 1 
-     * by the last decoder thread
+    if (!pool->nb_started) {
+        pthread_mutex_unlock(&pool->pool_mtx);
+        return OVVC_EAGAIN;
+    }
+
+    /* Jobs submitted by a job (e.g. filtering of the lines it just
+     * decoded) are kept on the queue of its worker so they are likely
+     * run on the same core, other jobs are spread over the workers
      */
-    // pthread_mutex_lock(&th_slice->gnrl_mtx);
-    // while (th_slice->active_state) {
-    //     pthread_cond_wait(&th_slice->gnrl_cnd, &th_slice->gnrl_mtx);
-    // }
-    // // th_slice->active_state = 0;
-    // pthread_mutex_unlock(&th_slice->gnrl_mtx);
+    if (current_worker && current_worker->pool == pool) {
+        worker = current_worker;
+    } else {
+        worker = &pool->workers[pool->next_worker++ % pool->nb_started];
+    }
+    queue  = &worker->queues[OVMIN(job->priority, OV_POOL_PRIO_UNBLOCK)];
+
+    pthread_mutex_lock(&worker->queue_mtx);
+    if (queue->last_job) {
+        queue->last_job->next = job;
+    } else {
+        queue->first_job = job;
+    }
+    queue->last_job = job;
+    pthread_mutex_unlock(&worker->queue_mtx);
+
+    atomic_fetch_add_explicit(&pool->nb_pending, 1, memory_order_acq_rel);
+
+    pthread_cond_signal(&pool->pool_cnd);
+    pthread_mutex_unlock(&pool->pool_mtx);
 
     return 0;
 }
 
-static void *
-entry_thread_main_function(void *opaque)
+int
+ovthread_pool_nb_idle(struct OVThreadPool *pool)
 {
-    struct EntryThread *tdec = (struct EntryThread *)opaque;
+    int nb_idle;
 
-    pthread_mutex_lock(&tdec->entry_mtx);
-    tdec->state = 1;
-    pthread_cond_signal(&tdec->entry_cnd);
+    pthread_mutex_lock(&pool->pool_mtx);
 
-    while (!tdec->kill){
-        do { 
-            pthread_cond_wait(&tdec->entry_cnd, &tdec->entry_mtx);
-            if (tdec->kill && tdec->state != 0) {
-                return NULL;
-            }
-        /*FIXME determine state value to exit loop*/
-        } while (tdec->state != 0 );
-        tdec->state = 1;
+    /* Workers not started yet are counted as idle */
+    nb_idle  = pool->nb_idle + pool->nb_workers - pool->nb_started;
+    nb_idle -= atomic_load_explicit(&pool->nb_pending, memory_order_acquire);
 
-        uint8_t is_last = thread_decode_entries(tdec->parent, tdec);
+    pthread_mutex_unlock(&pool->pool_mtx);
 
-        /* Main thread is not last so we wake it
-         * if its entry has already ended
-         */
-        if (is_last) {
-            slicedec_finish_decoding(tdec->parent->owner);
-        }
+    return OVMAX(nb_idle, 0);
+}
+
+int
+ovthread_pool_init(struct OVThreadPool *pool, int nb_workers)
+{
+    int i;
+
+    pool->workers = ov_mallocz(sizeof(struct OVWorker) * nb_workers);
+    if (!pool->workers) {
+        return OVVC_ENOMEM;
     }
-    pthread_mutex_unlock(&tdec->entry_mtx);
-    return NULL;
+
+    pool->nb_workers = nb_workers;
+    pool->nb_started = 0;
+    pool->nb_idle    = 0;
+    pool->next_worker = 0;
+    pool->kill = 0;
+    pool->shared = 0;
+
+    pool->nb_pic_in_flight  = 0;
+    pool->max_pic_in_flight = OVMAX(nb_workers - 1, 1);
+
+    atomic_init(&pool->nb_pending, 0);
+
+    for (i = 0; i < nb_workers; ++i) {
+        struct OVWorker *worker = &pool->workers[i];
+        worker->pool = pool;
+        pthread_mutex_init(&worker->queue_mtx, NULL);
+    }
+
+    pthread_mutex_init(&pool->pool_mtx, NULL);
+    pthread_cond_init(&pool->pool_cnd, NULL);
+    pthread_cond_init(&pool->pic_cnd, NULL);
+
+    return 0;
+}
+
+void
+ovthread_pool_uninit(struct OVThreadPool *pool)
+{
+    int i;
+    int nb_started;
+    void *ret;
+
+    if (!pool->workers) {
+        return;
+    }
+
+    /* No worker is started after kill is set */
+    pthread_mutex_lock(&pool->pool_mtx);
+    pool->kill = 1;
+    nb_started = pool->nb_started;
+    pthread_cond_broadcast(&pool->pool_cnd);
+    pthread_mutex_unlock(&pool->pool_mtx);
+
+    for (i = 0; i < nb_started; ++i) {
+        pthread_join(pool->workers[i].thread, &ret);
+    }
+
+    for (i = 0; i < pool->nb_workers; ++i) {
+        pthread_mutex_destroy(&pool->workers[i].queue_mtx);
+    }
+
+    pthread_mutex_destroy(&pool->pool_mtx);
+    pthread_cond_destroy(&pool->pool_cnd);
+    pthread_cond_destroy(&pool->pic_cnd);
+
+    ov_freep(&pool->workers);
+}
+
+/* Wait until a picture can be decoded on the pool without
+ * every worker being possibly blocked on reference lines
+ */
+void
+ovthread_pool_acquire_pic(struct OVThreadPool *pool)
+{
+    pthread_mutex_lock(&pool->pool_mtx);
+    while (pool->nb_pic_in_flight >= pool->max_pic_in_flight) {
+        pthread_cond_wait(&pool->pic_cnd, &pool->pool_mtx);
+    }
+    pool->nb_pic_in_flight++;
+    pthread_mutex_unlock(&pool->pool_mtx);
+}
+
+/* Reserve nb_pic pictures on the pool at once without waiting,
+ * nothing is reserved if less than nb_pic pictures are available
+ */
+int
+ovthread_pool_try_acquire_pic(struct OVThreadPool *pool, int nb_pic)
+{
+    int ret = OVVC_EAGAIN;
+
+    pthread_mutex_lock(&pool->pool_mtx);
+    if (pool->nb_pic_in_flight + nb_pic <= pool->max_pic_in_flight) {
+        pool->nb_pic_in_flight += nb_pic;
+        ret = 0;
+    }
+    pthread_mutex_unlock(&pool->pool_mtx);
+
+    return ret;
+}
+
+void
+ovthread_pool_release_pic(struct OVThreadPool *pool)
+{
+    pthread_mutex_lock(&pool->pool_mtx);
+    pool->nb_pic_in_flight--;
+    pthread_cond_signal(&pool->pic_cnd);
+    pthread_mutex_unlock(&pool->pool_mtx);
+}
+
+/*
+Functions for the jobs decoding rectangular entries
+*/
+static int
+slice_submit_job(struct SliceThread *th_slice, struct OVJob *job, uint8_t priority)
+{
+    int ret;
+
+    /* Picture will not be finished before this job is done */
+    atomic_fetch_add_explicit(&th_slice->nb_active_jobs, 1, memory_order_acq_rel);
+
+    job->priority = priority;
+
+    ret = ovthread_pool_submit(th_slice->pool, job);
+    if (ret < 0) {
+        atomic_fetch_sub_explicit(&th_slice->nb_active_jobs, 1, memory_order_acq_rel);
+    }
+
+    return ret;
 }
 
 int
-init_entry_threads(struct SliceThread *th_slice, int nb_threads)
+ovthread_slice_submit_job(struct SliceThread *th_slice, struct OVJob *job)
+{
+    return slice_submit_job(th_slice, job, th_slice->priority);
+}
+
+/* Jobs submitted here are run before any entry job so that
+ * entry jobs blocked on the lines they report are released
+ * by the next worker picking a job.
+ */
+int
+ovthread_slice_submit_unblock_job(struct SliceThread *th_slice, struct OVJob *job)
+{
+    return slice_submit_job(th_slice, job, OV_POOL_PRIO_UNBLOCK);
+}
+
+void
+ovthread_slice_job_done(struct SliceThread *th_slice)
+{
+    /* Last job to exit finishes the picture */
+    if (atomic_fetch_sub_explicit(&th_slice->nb_active_jobs, 1, memory_order_acq_rel) == 1) {
+        slicedec_finish_decoding(th_slice->owner);
+    }
+}
+
+static int
+thread_decode_entries(void *opaque, int ctudec_idx)
+{
+    struct SliceThread *th_slice = (struct SliceThread *)opaque;
+    OVSliceDec *const sldec = th_slice->owner;
+    OVCTUDec *const ctudec  = sldec->ctudec_list[ctudec_idx];
+    const OVPS *const prms  = sldec->active_params;
+    unsigned nb_entries     = th_slice->nb_entries;
+    unsigned entry_idx;
+
+    ov_log(NULL, OVLOG_DEBUG, "Decoder with POC %d, start entry, nb_entries %d\n", sldec->pic->poc, nb_entries);
+
+    entry_idx = atomic_fetch_add_explicit(&th_slice->next_entry, 1, memory_order_acq_rel);
+    while (entry_idx < nb_entries) {
+        th_slice->decode_entry(sldec, ctudec, prms, entry_idx);
+
+        entry_idx = atomic_fetch_add_explicit(&th_slice->next_entry, 1, memory_order_acq_rel);
+    }
+
+    ovthread_slice_job_done(th_slice);
+
+    return 0;
+}
+
+int
+ovthread_decode_entries(struct SliceThread *th_slice, DecodeFunc decode_entry, int nb_entries)
 {
     int i;
-    for (i = 0; i < nb_threads; ++i){
-        struct EntryThread *tdec = &th_slice->tdec[i];
+    int ret = 0;
+    int nb_jobs = OVMIN(nb_entries, th_slice->nb_entry_th);
 
-        tdec->state = 0;
-        tdec->kill  = 0;
+    th_slice->nb_entries = nb_entries;
+    th_slice->decode_entry = decode_entry;
 
-        tdec->parent = th_slice;
+    atomic_store_explicit(&th_slice->next_entry, 0, memory_order_relaxed);
+    atomic_store_explicit(&th_slice->nb_active_jobs, nb_jobs, memory_order_relaxed);
 
-        pthread_mutex_init(&tdec->entry_mtx, NULL);
-        pthread_cond_init(&tdec->entry_cnd, NULL);
+    /* One job per CTU decoder, each job decodes entries
+     * in increasing order until all entries are claimed
+     */
+    for (i = 0; i < nb_jobs; ++i) {
+        struct OVJob *job = &th_slice->jobs[i];
 
-        pthread_mutex_lock(&tdec->entry_mtx);
+        job->run    = thread_decode_entries;
+        job->opaque = th_slice;
+        job->idx    = i;
+        job->priority = th_slice->priority;
 
-        if (pthread_create(&tdec->thread, NULL, entry_thread_main_function, tdec)) {
-            pthread_mutex_unlock(&tdec->entry_mtx);
-            ov_log(NULL, OVLOG_ERROR, "Thread creation failed at decoder init\n");
-            goto failthread;
+        ret = ovthread_pool_submit(th_slice->pool, job);
+        if (ret < 0) {
+            break;
         }
+        ov_log(NULL, OVLOG_DEBUG, "Main launches POC %d entry %d\n", th_slice->owner->pic->poc, i);
+    }
+
+    if (i < nb_jobs) {
+        int nb_missing = nb_jobs - i;
 
-        /* Wait until subdec is set */
-        while (!tdec->state) {
-            pthread_cond_wait(&tdec->entry_cnd, &tdec->entry_mtx);
+        /* No job will finish the picture */
+        if (!i) {
+            atomic_store_explicit(&th_slice->nb_active_jobs, 0, memory_order_release);
+            return ret;
+        }
+
+        /* Submitted jobs claim every entry, the picture is finished
+         * here if they all exited before the count is corrected
+         */
+        ov_log(NULL, OVLOG_WARNING, "Only %d of %d entry jobs started\n", i, nb_jobs);
+        if (atomic_fetch_sub_explicit(&th_slice->nb_active_jobs, nb_missing, memory_order_acq_rel) == nb_missing) {
+            slicedec_finish_decoding(th_slice->owner);
         }
-        pthread_mutex_unlock(&tdec->entry_mtx);
     }
 
     return 0;
+}
 
-failthread:
-    uninit_entry_threads(th_slice);
+/*
+Functions used to notify the user thread of decoded pictures
+*/
+int
+ovthread_main_thread_init(struct MainThread *th_main)
+{
+    pthread_condattr_t cnd_attr;
+
+    pthread_condattr_init(&cnd_attr);
+    #if OV_MAIN_CND_MONOTONIC
+    pthread_condattr_setclock(&cnd_attr, OV_MAIN_CND_CLOCK);
+    #endif
+
+    pthread_mutex_init(&th_main->main_mtx, NULL);
+    pthread_cond_init(&th_main->main_cnd, &cnd_attr);
+    pthread_condattr_destroy(&cnd_attr);
+
+    th_main->event_fd[0] = -1;
+    th_main->event_fd[1] = -1;
+
+    #if !_WIN32
+    if (pipe(th_main->event_fd) < 0) {
+        ov_log(NULL, OVLOG_WARNING, "Could not create decoder event pipe\n");
+        th_main->event_fd[0] = -1;
+        th_main->event_fd[1] = -1;
+        return 0;
+    }
 
-    ov_freep(&th_slice->tdec);
+    for (int i = 0; i < 2; ++i) {
+        fcntl(th_main->event_fd[i], F_SETFL, fcntl(th_main->event_fd[i], F_GETFL) | O_NONBLOCK);
+        fcntl(th_main->event_fd[i], F_SETFD, FD_CLOEXEC);
+    }
+    #endif
 
-    return OVVC_ENOMEM;
+    return 0;
 }
 
 void
-uninit_entry_threads(struct SliceThread *th_slice)
+ovthread_main_thread_uninit(struct MainThread *th_main)
 {
-    int i;
-    void *ret;
-    for (i = 0; i < th_slice->nb_entry_th; ++i){
-        struct EntryThread *th_entry = &th_slice->tdec[i];
-        pthread_mutex_lock(&th_entry->entry_mtx);
-        th_entry->kill = 1;
-        pthread_cond_signal(&th_entry->entry_cnd);
-        pthread_mutex_unlock(&th_entry->entry_mtx);
+    #if !_WIN32
+    for (int i = 0; i < 2; ++i) {
+        if (th_main->event_fd[i] >= 0) {
+            close(th_main->event_fd[i]);
+            th_main->event_fd[i] = -1;
+        }
+    }
+    #endif
+
+    pthread_mutex_destroy(&th_main->main_mtx);
+    pthread_cond_destroy(&th_main->main_cnd);
+}
 
-        pthread_join(th_entry->thread, &ret);
-        pthread_mutex_destroy(&th_entry->entry_mtx);
-        pthread_cond_destroy(&th_entry->entry_cnd);
+/* Make the event file descriptor readable if the DPB holds a
+ * picture which would be returned by ovdec_receive_picture()
+ */
+void
+ovthread_main_thread_check_output(struct MainThread *th_main)
+{
+    #if !_WIN32
+    const OVDPB *dpb = th_main->dpb ? *th_main->dpb : NULL;
+
+    if (th_main->event_fd[1] >= 0 && dpb) {
+        int out_cvs_id = (dpb->cvs_id - 1) & 0xFF;
+        if (ovdpb_output_ready(dpb, out_cvs_id)) {
+            uint8_t evt = 1;
+            /* A full pipe is already readable so failure is ignored */
+            if (write(th_main->event_fd[1], &evt, 1) < 0) {
+                return;
+            }
+        }
     }
+    #endif
+}
 
-    pthread_mutex_destroy(&th_slice->gnrl_mtx);
-    pthread_cond_destroy(&th_slice->gnrl_cnd);
-    ov_freep(&th_slice->tdec);
+/* Wake threads waiting for a sub decoder or a picture
+ * and raise an event if a picture can now be output
+ * Must be called with main_mtx locked so the decoder cannot be
+ * closed before this returns
+ */
+void
+ovthread_main_thread_signal(struct MainThread *th_main)
+{
+    pthread_cond_broadcast(&th_main->main_cnd);
 
+    ovthread_main_thread_check_output(th_main);
 }
 
+void
+ovthread_main_thread_clear_event(struct MainThread *th_main)
+{
+    #if !_WIN32
+    if (th_main->event_fd[0] >= 0) {
+        uint8_t evts[64];
+        while (read(th_main->event_fd[0], evts, sizeof(evts)) > 0);
+    }
+    #endif
+}
 
 /*
 Functions needed by the threads decoding an entire slice
 */
 int
 ovthread_slice_thread_init(struct SliceThread *th_slice, int nb_entry_th)
-{   
+{
     th_slice->nb_entry_th = nb_entry_th;
-    th_slice->tdec = ov_mallocz(sizeof(struct EntryThread) * nb_entry_th);
-    if (!th_slice->tdec) {
-        goto failalloc;
+    th_slice->jobs = ov_mallocz(sizeof(struct OVJob) * nb_entry_th);
+    if (!th_slice->jobs) {
+        return OVVC_ENOMEM;
     }
 
-    atomic_init(&th_slice->first_job,      0);
-    atomic_init(&th_slice->last_entry_idx, 0);
+    atomic_init(&th_slice->next_entry,     0);
+    atomic_init(&th_slice->nb_active_jobs, 0);
 
     pthread_mutex_init(&th_slice->gnrl_mtx, NULL);
     pthread_cond_init(&th_slice->gnrl_cnd,  NULL);
 
-    // if (pthread_create(&tdec->thread, NULL, entry_thread_main_function, tdec)) {
-    //     pthread_mutex_unlock(&tdec->entry_mtx);
-    //     ov_log(NULL, OVLOG_ERROR, "Thread creation failed at decoder init\n");
-    //     goto failthread;
-    // }
-
-    init_entry_threads(th_slice, nb_entry_th);
-
     return 0;
-
-// failthread:
-//     ov_freep(&th_slice->tdec);
-//     return OVVC_ENOMEM;
-
-failalloc:
-    return OVVC_ENOMEM;
 }
 
-
-//TODO: function unecessary if the pthread in SliceThread is not launched.
 void
 ovthread_slice_thread_uninit(struct SliceThread *th_slice)
 {
-    pthread_mutex_lock(&th_slice->gnrl_mtx);
-    //TODO: need for a kill in SliceThread ?
-    // th_slice->kill = 1;
-    pthread_cond_signal(&th_slice->gnrl_cnd);
-    pthread_mutex_unlock(&th_slice->gnrl_mtx);
-
-    uninit_entry_threads(th_slice);
-
-    // void *ret;
-    // // pthread_join(th_slice->thread, &ret);
-    // pthread_mutex_destroy(&th_slice->gnrl_mtx);
-    // pthread_cond_destroy(&th_slice->gnrl_cnd);
+    pthread_mutex_destroy(&th_slice->gnrl_mtx);
+    pthread_cond_destroy(&th_slice->gnrl_cnd);
+
+    ov_freep(&th_slice->jobs);
 }
 
 
@@ -254,8 +610,15 @@ uint32_t write_decoded_frame_to_file(OVFrame *const frame, FILE *fp){
   uint8_t component = 0;
   uint32_t ret = 0;
   for(component=0; component<3; component++){
-    uint32_t frame_size = frame->height[component] * frame->linesize[component];
-    ret +=fwrite(frame->data[component], frame_size, sizeof(uint8_t), fp);
+    /* Planes rows are padded so they are written one at a time */
+    size_t smp_size = frame->frame_info.chromat_format == OV_YUV_420_P8 ? 1 : 2;
+    size_t row_size = frame->width[component] * smp_size;
+    const uint8_t *row = frame->data[component];
+    size_t y;
+    for(y=0; y<frame->height[component]; y++){
+      ret +=fwrite(row, row_size, sizeof(uint8_t), fp);
+      row += frame->linesize[component];
+    }
   }
   return ret;
 }
@@ -2,20 +2,71 @@
 #define OVTHREADS_H
 
 #include <stdint.h>
+#include <time.h>
 
 #include "slicedec.h"
 
 #define USE_THREADS 1
 
+/* Clock used by timed waits on main_cnd, monotonic when
+ * supported so wall clock changes do not alter timeouts
+ */
+#if defined(CLOCK_MONOTONIC) && !defined(__APPLE__) && !_WIN32
+#define OV_MAIN_CND_MONOTONIC 1
+#define OV_MAIN_CND_CLOCK CLOCK_MONOTONIC
+#else
+#define OV_MAIN_CND_MONOTONIC 0
+#define OV_MAIN_CND_CLOCK CLOCK_REALTIME
+#endif
+
 struct SliceThread;
+struct OVThreadPool;
+struct OVJob;
 struct OVVCDec;
 struct OVFrame;
+struct MainThread;
+
+int ovthread_pool_init(struct OVThreadPool *pool, int nb_workers);
+
+void ovthread_pool_uninit(struct OVThreadPool *pool);
+
+int ovthread_pool_submit(struct OVThreadPool *pool, struct OVJob *job);
+
+/* Number of workers available for new jobs */
+int ovthread_pool_nb_idle(struct OVThreadPool *pool);
+
+/* Limit the number of pictures decoded at once on a pool */
+void ovthread_pool_acquire_pic(struct OVThreadPool *pool);
+
+void ovthread_pool_release_pic(struct OVThreadPool *pool);
+
+/* Returns OVVC_EAGAIN instead of waiting if nb_pic pictures
+ * cannot be reserved at once
+ */
+int ovthread_pool_try_acquire_pic(struct OVThreadPool *pool, int nb_pic);
 
+
+int ovthread_slice_submit_job(struct SliceThread *th_slice, struct OVJob *job);
+
+int ovthread_slice_submit_unblock_job(struct SliceThread *th_slice, struct OVJob *job);
+
+void ovthread_slice_job_done(struct SliceThread *th_slice);
+
+/* Returns a negative value only if no entry job could be submitted,
+ * the picture is then not finished by any job
+ */
 int ovthread_decode_entries(struct SliceThread *th_slice, DecodeFunc decode_entry, int nb_entries);
 
-int init_entry_threads(struct SliceThread *th_slice, int nb_threads);
 
-void uninit_entry_threads(struct SliceThread *th_slice);
+int ovthread_main_thread_init(struct MainThread *th_main);
+
+void ovthread_main_thread_uninit(struct MainThread *th_main);
+
+void ovthread_main_thread_signal(struct MainThread *th_main);
+
+void ovthread_main_thread_check_output(struct MainThread *th_main);
+
+void ovthread_main_thread_clear_event(struct MainThread *th_main);
 
 
 int ovthread_slice_thread_init(struct SliceThread *th_slice, int nb_threads);
@@ -1,12 +1,14 @@
 #include "ovunits.h"
 #include "ovmem.h"
 #include "ovutils.h"
+#include "ovio.h"
 
 int
 ov_nalu_init(OVNALUnit *nalu)
 {
     nalu->rbsp_data = NULL;
     nalu->rbsp_size = 0;
+    nalu->chunk = NULL;
 
     nalu->epb_pos = NULL;
     nalu->nb_epb = 0;
@@ -32,7 +34,13 @@ ov_nalu_new_ref(OVNALUnit **nalu_p, OVNALUnit *nalu)
 static void
 ovnalu_free(OVNALUnit *nalu)
 {
-    ov_freep(&nalu->rbsp_data);
+    if (nalu->chunk) {
+        ovio_chunk_unref(&nalu->chunk);
+        nalu->rbsp_data = NULL;
+    } else {
+        ov_freep(&nalu->rbsp_data);
+    }
+
     if (nalu->epb_pos) {
         ov_freep(&nalu->epb_pos);
     }
@@ -50,11 +50,19 @@ typedef struct OVVRBSPData{
     size_t size;
 }OVRBSPData;
 
+struct OVIOChunk;
+
 /* NAL Units */
 typedef struct OVNALUnit {
   /* Associated Raw byte sequence stream payload
    */
   const uint8_t  *rbsp_data;
+
+  /* Input chunk rbsp_data points into when the NAL Unit does not
+   * own a copy of its RBSP (NULL otherwise)
+   */
+  struct OVIOChunk *chunk;
+
   const uint32_t *epb_pos;
   size_t rbsp_size;
   int nb_epb;
@@ -14,6 +14,7 @@
 
 #define OVMAX(a, b) (((a) > (b)) ? (a) : (b))
 #define OVMIN(a, b) (((a) < (b)) ? (a) : (b))
+#define OVALIGN(x, a) (((x) + (a) - 1) & ~((size_t)(a) - 1))
 #define OVABS(a) (((a) < (0)) ? -(a) : (a))
 
 #define ov_clz(x) __builtin_clz(x)
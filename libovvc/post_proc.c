@@ -38,7 +38,7 @@ pp_init_functions(const OVSEI* sei, struct PostProcFunctions *const pp_funcs)
 }
 
 int
-pp_process_frame(const OVSEI* sei, OVDPB *dpb, OVFrame **frame_p)
+pp_process_frame(struct PostProcCtx *pp_ctx, const OVSEI* sei, OVDPB *dpb, OVFrame **frame_p)
 {
     int ret=0;
     struct PostProcFunctions pp_funcs;
@@ -49,14 +49,25 @@ pp_process_frame(const OVSEI* sei, OVDPB *dpb, OVFrame **frame_p)
         struct Frame* frame = *frame_p;
         struct Frame* frame_post_proc;
         ret = dpbpriv_request_frame(&dpb->internal, &frame_post_proc);
+        if (ret < 0) {
+            return ret;
+        }
 
-        int16_t* srcComp[3] = {(int16_t*)frame->data[0], (int16_t*)frame->data[1], (int16_t*)frame->data[2]};
-        int16_t* dstComp[3] = {(int16_t*)frame_post_proc->data[0], (int16_t*)frame_post_proc->data[1], 
-                                (int16_t*)frame_post_proc->data[2]};
+        OVSample* srcComp[3] = {(OVSample*)frame->data[0], (OVSample*)frame->data[1], (OVSample*)frame->data[2]};
+        OVSample* dstComp[3] = {(OVSample*)frame_post_proc->data[0], (OVSample*)frame_post_proc->data[1], 
+                                (OVSample*)frame_post_proc->data[2]};
 
         uint8_t enable_deblock = 1;
-        pp_funcs.pp_film_grain(dstComp, srcComp, sei->sei_fg, 
-            frame->width[0], frame->height[0], frame->poc, 0, enable_deblock);
+        /* Strides in samples */
+        int pic_stride[3] = {frame->linesize[0] / sizeof(OVSample), frame->linesize[1] / sizeof(OVSample),
+                             frame->linesize[2] / sizeof(OVSample)};
+
+        ret = pp_funcs.pp_film_grain(pp_ctx, dstComp, srcComp, sei->sei_fg,
+            frame->width[0], frame->height[0], pic_stride, frame->poc, 0, enable_deblock);
+        if (ret < 0) {
+            ovframe_unref(&frame_post_proc);
+            return ret;
+        }
 
 #if ENABLE_SLHDR
         //TODOpp: redundant check with pp_init_functions
@@ -67,7 +78,8 @@ pp_process_frame(const OVSEI* sei, OVDPB *dpb, OVFrame **frame_p)
             //      0x30, 0x4d, 0x4e, 0x66, 0x69, 0x80, 0x84, 0x99, 0x9e, 0xb3, 0xb7, 0xcc, 0xd0, 0xe6, 0xe8, 0x66, 0x84, 0x9e, 0x88, 0xa6, 0x80, 
             //      0xae, 0x87, 0xc2, 0x96, 0xda, 0x87};
             // pp_funcs.pp_sdr_to_hdr(sei->sei_slhdr->slhdr_context, srcComp, dstComp, payload_example, frame->width[0], frame->height[0]);
-            pp_funcs.pp_sdr_to_hdr(sei->sei_slhdr->slhdr_context, srcComp, dstComp, 
+            /* FIXME SL-HDR library expects 16 bits samples */
+            pp_funcs.pp_sdr_to_hdr(sei->sei_slhdr->slhdr_context, (int16_t **)srcComp, (int16_t **)dstComp, 
                                     sei->sei_slhdr->payload_array, frame->width[0], frame->height[0]);
         }
 #endif
@@ -76,3 +88,11 @@ pp_process_frame(const OVSEI* sei, OVDPB *dpb, OVFrame **frame_p)
     }
     return ret;
 }
+
+void
+pp_uninit_ctx(struct PostProcCtx *pp_ctx)
+{
+    if (pp_ctx->fg_ctx) {
+        fg_uninit_ctx(&pp_ctx->fg_ctx);
+    }
+}
@@ -3,14 +3,35 @@
 
 #include <stdint.h>
 
+#include "ovdefs.h"
+#include "bitdepth.h"
+
 struct OVSEIFGrain;
 struct OVVCDec;
+struct OVThreadPool;
+struct FGCtx;
+struct PostProcCtx;
 
-typedef void (*FGFunc)(int16_t** dstComp, int16_t** srcComp, struct OVSEIFGrain* fgrain, 
-                          int pic_w, int pic_h, int poc, uint8_t isIdrPic, uint8_t enableDeblocking);
+typedef int (*FGFunc)(struct PostProcCtx *pp_ctx, OVSample** dstComp, OVSample** srcComp, struct OVSEIFGrain* fgrain,
+                      int pic_w, int pic_h, const int *pic_stride, int poc, uint8_t isIdrPic, uint8_t enableDeblocking);
 
 typedef void (*SLHDRFunc)(void* slhdr_context, int16_t** sdr_pic, int16_t** hdr_pic, uint8_t* SEIPayload, int pic_width, int pic_height);
 
+/* Film grain synthesis kernels, grain stripes are 16 lines high and
+ * grain data base blocks are read from lines of 64 samples
+ */
+typedef int16_t (*FGBlockAvgFunc)(const OVSample *src, uint32_t src_stride, uint16_t *nb_samples,
+                                  uint8_t blk_h, uint8_t blk_w, uint8_t bitdepth);
+
+typedef void (*FGGrainBlkFunc)(int16_t *grain, uint32_t grain_stride, const int8_t *grain_db,
+                               uint8_t log2_scale_factor, int16_t scale_factor, uint32_t blk_w);
+
+typedef void (*FGDeblockStripeFunc)(int16_t *grain, uint32_t width, uint32_t grain_stride);
+
+typedef void (*FGBlendStripeFunc)(OVSample *dst, const OVSample *src, const int16_t *grain,
+                                  uint32_t width, uint32_t grain_stride, uint32_t pic_stride,
+                                  uint32_t blk_h, uint8_t bitdepth);
+
 struct PostProcFunctions
 {
     uint8_t pp_apply_flag;
@@ -18,16 +39,60 @@ struct PostProcFunctions
     SLHDRFunc pp_sdr_to_hdr;
 };
 
-int pp_process_frame(const OVSEI* sei, OVDPB *dpb, OVFrame **frame_p);
+struct FGFunctions
+{
+    FGBlockAvgFunc block_avg;
+    FGGrainBlkFunc grain_blk8x8;
+    FGDeblockStripeFunc deblock_stripe;
+    FGBlendStripeFunc blend_stripe;
+};
+
+/* Post processing state kept by the decoder across output pictures */
+struct PostProcCtx
+{
+    /* Pool film grain stripes jobs are submitted to */
+    struct OVThreadPool *pool;
+    uint8_t priority;
+
+    /* SIMD extensions post processing kernels are allowed to use */
+    int cpu_flags;
+
+    /* Allocated on first picture with film grain */
+    struct FGCtx *fg_ctx;
+};
+
+int pp_process_frame(struct PostProcCtx *pp_ctx, const OVSEI* sei, OVDPB *dpb, OVFrame **frame_p);
+
+void pp_uninit_ctx(struct PostProcCtx *pp_ctx);
 
 
 //TODO: change function names.
 // void fg_data_base_generation(int8_t****  dataBase, uint8_t enableDeblocking)
 void fg_data_base_generation(uint8_t enableDeblocking);
 
-void fg_grain_apply_pic(int16_t** dstComp, int16_t** srcComp, struct OVSEIFGrain* fgrain, 
-                          int pic_w, int pic_h, int poc, uint8_t isIdrPic, uint8_t enableDeblocking);
+int fg_grain_apply_pic(struct PostProcCtx *pp_ctx, OVSample** dstComp, OVSample** srcComp, struct OVSEIFGrain* fgrain,
+                       int pic_w, int pic_h, const int *pic_stride, int poc, uint8_t isIdrPic, uint8_t enableDeblocking);
+
+int fg_grain_no_filter(struct PostProcCtx *pp_ctx, OVSample** dstComp, OVSample** srcComp, struct OVSEIFGrain* fgrain,
+                       int pic_w, int pic_h, const int *pic_stride, int poc, uint8_t isIdrPic, uint8_t enableDeblocking);
+
+void fg_uninit_ctx(struct FGCtx **fg_ctx_p);
+
+/* C kernels, also used by SIMD kernels on blocks they do not handle */
+int16_t fg_compute_block_avg(const OVSample *dstSampleBlk8, uint32_t widthComp, uint16_t *pNumSamples,
+                             uint8_t ySize, uint8_t xSize, uint8_t bitDepth);
+
+void fg_simulate_grain_blk8x8(int16_t *grainStripe, uint32_t grainStride, const int8_t *grainDb,
+                              uint8_t log2ScaleFactor, int16_t scaleFactor, uint32_t xSize);
+
+void fg_deblock_grain_stripe(int16_t *grainStripe, uint32_t widthComp, uint32_t strideComp);
+
+void fg_blend_stripe(OVSample *dstSampleOffsetY, const OVSample *srcSampleOffsetY, const int16_t *grainStripe,
+                     uint32_t widthComp, uint32_t grainStride, uint32_t picStride, uint32_t blockHeight, uint8_t bitDepth);
+
+void pp_init_fg_functions(struct FGFunctions *const fg_funcs, int cpu_flags);
+
+void pp_init_fg_functions_sse(struct FGFunctions *const fg_funcs);
 
-void fg_grain_no_filter(int16_t** dstComp, int16_t** srcComp, struct OVSEIFGrain* fgrain, 
-                          int pic_w, int pic_h, int poc, uint8_t isIdrPic, uint8_t enableDeblocking);
-#endif
\ No newline at end of file
+void pp_init_fg_functions_avx2(struct FGFunctions *const fg_funcs);
+#endif
@@ -1,9 +1,18 @@
 #include <stdint.h>
 #include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
+#include "ovconfig.h"
 #include "ovutils.h"
 #include "ovmem.h"
+#include "overror.h"
+#include "ovcpu.h"
+#include "bitdepth.h"
 #include "nvcl_structures.h"
+#include "dec_structures.h"
+#include "ovthreads.h"
+#include "post_proc.h"
 
 
 #define MAX_NUM_INTENSITIES                             256 // Maximum nuber of intensity intervals supported in FGC SEI
@@ -533,7 +542,7 @@ static int8_t  fg_data_base[NUM_CUT_OFF_FREQ*NUM_CUT_OFF_FREQ*DATA_BASE_SIZE*DAT
 static uint8_t fg_data_base_created = 0;
 
 /* Function to calculate block average */
-int16_t fg_compute_block_avg(int16_t *dstSampleBlk8, uint32_t widthComp, uint16_t *pNumSamples,
+int16_t fg_compute_block_avg(const OVSample *dstSampleBlk8, uint32_t widthComp, uint16_t *pNumSamples,
                       uint8_t ySize, uint8_t xSize, uint8_t bitDepth)
 {
   uint32_t blockAvg   = 0;
@@ -562,12 +571,12 @@ int16_t fg_compute_block_avg(int16_t *dstSampleBlk8, uint32_t widthComp, uint16_
   return blockAvg;
 }
 
-void fg_deblock_grain_stripe(int32_t *grainStripe, uint32_t widthComp, uint32_t strideComp)
+void fg_deblock_grain_stripe(int16_t *grainStripe, uint32_t widthComp, uint32_t strideComp)
 {
   int32_t left1, left0, right0, right1;
   uint32_t pos8, vertCtr;
 
-  for (pos8 = 0; pos8 < (widthComp - 8); pos8 += 8)
+  for (pos8 = 0; pos8 + 8 < widthComp; pos8 += 8)
   {
     for (vertCtr = 0; vertCtr < 16; vertCtr++) /* Across 16 pels of the vertical boundary*/
     {
@@ -582,7 +591,8 @@ void fg_deblock_grain_stripe(int32_t *grainStripe, uint32_t widthComp, uint32_t
   return;
 }
 
-void fg_blend_stripe(int16_t *dstSampleOffsetY, int16_t *srcSampleOffsetY, int32_t *grainStripe, uint32_t widthComp, uint32_t blockHeight, uint8_t bitDepth)
+void fg_blend_stripe(OVSample *dstSampleOffsetY, const OVSample *srcSampleOffsetY, const int16_t *grainStripe,
+                     uint32_t widthComp, uint32_t grainStride, uint32_t picStride, uint32_t blockHeight, uint8_t bitDepth)
 {
   uint32_t  k, l;
   int32_t   grainSample;
@@ -591,9 +601,9 @@ void fg_blend_stripe(int16_t *dstSampleOffsetY, int16_t *srcSampleOffsetY, int32
   {
     for (k = 0; k < widthComp; k++) /* x direction */
     {
-        grainSample   =   grainStripe[k + (l*widthComp)];
+        grainSample   =   grainStripe[k + (l*grainStride)];
         grainSample   <<=  (bitDepth - 8);
-        dstSampleOffsetY[k + (l*widthComp)] = (int16_t) ov_clip_uintp2(grainSample + srcSampleOffsetY[k + (l*widthComp)], bitDepth);
+        dstSampleOffsetY[k + (l*picStride)] = (OVSample) ov_clip_uintp2(grainSample + srcSampleOffsetY[k + (l*picStride)], bitDepth);
     }
   }
   return;
@@ -607,24 +617,20 @@ uint32_t prng(uint32_t x_r)
   return x_r;
 }
 
-// void fg_simulate_grain_blk8x8(int32_t *grainStripe, uint32_t grainStripeOffsetBlk8, int8_t****  dataBase,
-void fg_simulate_grain_blk8x8(int32_t *grainStripe, uint32_t grainStripeOffsetBlk8,
-  uint32_t width, uint8_t log2ScaleFactor, int16_t scaleFactor, uint32_t kOffset, uint32_t lOffset, uint8_t h, uint8_t v, uint32_t xSize)
+/* grainDb points to the first grain sample of the block in the data base */
+void fg_simulate_grain_blk8x8(int16_t *grainStripe, uint32_t grainStride, const int8_t *grainDb,
+                              uint8_t log2ScaleFactor, int16_t scaleFactor, uint32_t xSize)
 {
   uint32_t k, l;
-  uint32_t idx, idx_offset, idx_offset_l, grainStripeOffsetBlk8_l;
 
-  idx_offset = ( h*NUM_CUT_OFF_FREQ +  v ) * DATA_BASE_SIZE  * DATA_BASE_SIZE;
   for (l = 0; l < 8; l++) /* y direction */
   {
-    idx_offset_l            = idx_offset + (l + lOffset) * DATA_BASE_SIZE;
-    grainStripeOffsetBlk8_l = grainStripeOffsetBlk8 + (l*width);
     for (k = 0; k < xSize; k++) /* x direction */
     {
-      idx = idx_offset_l + (k + kOffset);
-      grainStripe[grainStripeOffsetBlk8_l + k ] = ((scaleFactor * fg_data_base[idx]) >> (log2ScaleFactor + GRAIN_SCALE));
-        // ((scaleFactor * fg_data_base[h][v][l + lOffset][k + kOffset]) >> (log2ScaleFactor + GRAIN_SCALE));
+      grainStripe[k] = ((scaleFactor * grainDb[k]) >> (log2ScaleFactor + GRAIN_SCALE));
     }
+    grainStripe += grainStride;
+    grainDb     += DATA_BASE_SIZE;
   }
   return;
 }
@@ -773,63 +779,370 @@ void fg_compute_model_values(struct OVSEIFGrain* fgrain, int16_t intensityInterv
     }
 }
 
-void fg_grain_no_filter(int16_t** dstComp, int16_t** srcComp, struct OVSEIFGrain* fgrain, int pic_w, 
-                            int pic_h, int poc, uint8_t isIdrPic, uint8_t enableDeblocking)
+int fg_grain_no_filter(struct PostProcCtx *pp_ctx, OVSample** dstComp, OVSample** srcComp, struct OVSEIFGrain* fgrain,
+                       int pic_w, int pic_h, const int *pic_stride, int poc, uint8_t isIdrPic, uint8_t enableDeblocking)
 {
+    return 0;
 }
 
-void fg_grain_apply_pic(int16_t** dstComp, int16_t** srcComp, struct OVSEIFGrain* fgrain, int pic_w, 
-                            int pic_h, int poc, uint8_t isIdrPic, uint8_t enableDeblocking)
+void
+pp_init_fg_functions(struct FGFunctions *const fg_funcs, int cpu_flags)
 {
-    uint8_t   compCtr, blkId; /* number of color components */
-    uint8_t   log2ScaleFactor, h, v;
-    uint8_t   bitDepth; /*grain bit depth and decoded bit depth are assumed to be same */
+    fg_funcs->block_avg      = &fg_compute_block_avg;
+    fg_funcs->grain_blk8x8   = &fg_simulate_grain_blk8x8;
+    fg_funcs->deblock_stripe = &fg_deblock_grain_stripe;
+    fg_funcs->blend_stripe   = &fg_blend_stripe;
+
+    /* SIMD kernels store 10 bits samples only */
+    #if ARCH_X86 && BITDEPTH == 10
+      #if SSE_ENABLED
+      if (cpu_flags & OV_CPU_SSE4_1) {
+          pp_init_fg_functions_sse(fg_funcs);
+      }
+      #endif
+      #if AVX_ENABLED
+      if (cpu_flags & OV_CPU_AVX2) {
+          pp_init_fg_functions_avx2(fg_funcs);
+      }
+      #endif
+    #endif
+}
+
+/* Stripes of 16 lines of each component are independent once the seed
+ * of the PRNG at their first 16x16 block is known, so they are
+ * distributed over the calling thread and idle workers of the pool
+ */
+#define FG_STRIPE_H  16
+#define FG_MAX_JOBS  16
+
+struct FGCtx
+{
+    struct FGFunctions funcs;
+
+    /* One grain stripe per job and one for the calling thread,
+     * buffers only grow with picture width and number of jobs
+     */
+    int16_t *grain_stripes;
+    uint32_t grain_stride;
+    int nb_grain_stripes;
+
+    /* PRNG seed on the first 16x16 block of each stripe */
+    uint32_t *seeds[3];
+    int nb_seeds;
+
+    /* Current picture */
+    OVSample *dst[3];
+    const OVSample *src[3];
+    uint32_t width[3];
+    uint32_t height[3];
+    uint32_t pic_stride[3];
+    const struct OVSEIFGrain *fgrain;
+    int16_t intensity_interval[3][MAX_NUM_INTENSITIES];
+    uint8_t enable_deblock;
+
+    int nb_stripes[3];
+    int nb_units;
+
+    struct OVJob jobs[FG_MAX_JOBS];
+    atomic_uint next_unit;
+
+    /* Jobs still waiting in the pool queues may run after the picture
+     * is output, they only process stripes if they start while the
+     * stripes of a picture are open and exit otherwise.
+     * Only jobs with an index below nb_open_jobs have a grain buffer
+     * for the current picture.
+     * A job is not submitted again before it left the queues.
+     */
+    int nb_open_jobs;
+    uint8_t job_queued[FG_MAX_JOBS];
+    int nb_queued_jobs;
+    int nb_running_jobs;
+    pthread_mutex_t jobs_mtx;
+    pthread_cond_t jobs_cnd;
+};
+
+static int
+fg_init_ctx(struct FGCtx **fg_ctx_p)
+{
+    struct FGCtx *fg = ov_mallocz(sizeof(*fg));
+    if (!fg) {
+        return OVVC_ENOMEM;
+    }
+
+    pthread_mutex_init(&fg->jobs_mtx, NULL);
+    pthread_cond_init(&fg->jobs_cnd, NULL);
+
+    *fg_ctx_p = fg;
+
+    return 0;
+}
+
+void
+fg_uninit_ctx(struct FGCtx **fg_ctx_p)
+{
+    struct FGCtx *fg = *fg_ctx_p;
+
+    /* Queued jobs still refer to the context */
+    pthread_mutex_lock(&fg->jobs_mtx);
+    while (fg->nb_queued_jobs)
+    {
+        pthread_cond_wait(&fg->jobs_cnd, &fg->jobs_mtx);
+    }
+    pthread_mutex_unlock(&fg->jobs_mtx);
+
+    pthread_mutex_destroy(&fg->jobs_mtx);
+    pthread_cond_destroy(&fg->jobs_cnd);
+
+    ov_freep(&fg->grain_stripes);
+    ov_freep(&fg->seeds[0]);
+
+    ov_freep(fg_ctx_p);
+}
+
+static int
+fg_update_buffers(struct FGCtx *fg, uint32_t pic_w, uint32_t pic_h, int nb_grain_stripes)
+{
+    /* SIMD kernels may read and write up to 16 samples after the
+     * end of stripe lines
+     */
+    uint32_t grain_stride = ((pic_w + 15) & ~15) + 16;
+    int nb_seeds = (pic_h + FG_STRIPE_H - 1) / FG_STRIPE_H;
+
+    if (grain_stride > fg->grain_stride || nb_grain_stripes > fg->nb_grain_stripes) {
+        grain_stride     = OVMAX(grain_stride, fg->grain_stride);
+        nb_grain_stripes = OVMAX(nb_grain_stripes, fg->nb_grain_stripes);
+
+        ov_freep(&fg->grain_stripes);
+        fg->grain_stripes = ov_malloc(sizeof(int16_t) * FG_STRIPE_H * grain_stride * nb_grain_stripes);
+        if (!fg->grain_stripes) {
+            fg->grain_stride = 0;
+            fg->nb_grain_stripes = 0;
+            return OVVC_ENOMEM;
+        }
+        fg->grain_stride = grain_stride;
+        fg->nb_grain_stripes = nb_grain_stripes;
+    }
+
+    if (nb_seeds > fg->nb_seeds) {
+        ov_freep(&fg->seeds[0]);
+        fg->seeds[0] = ov_malloc(sizeof(uint32_t) * 3 * nb_seeds);
+        if (!fg->seeds[0]) {
+            fg->nb_seeds = 0;
+            return OVVC_ENOMEM;
+        }
+        fg->seeds[1] = fg->seeds[0] + nb_seeds;
+        fg->seeds[2] = fg->seeds[1] + nb_seeds;
+        fg->nb_seeds = nb_seeds;
+    }
+
+    return 0;
+}
+
+static void
+fg_grain_apply_stripe(struct FGCtx *fg, int compCtr, int stripe_idx, int16_t *grainStripe)
+{
+    const struct FGFunctions *const funcs = &fg->funcs;
+    const struct OVSEIFGrain *const fgrain = fg->fgrain;
+    uint32_t  widthComp     = fg->width[compCtr];
+    uint32_t  heightComp    = fg->height[compCtr];
+    uint32_t  picStrideComp = fg->pic_stride[compCtr];
+    uint32_t  grainStride   = fg->grain_stride;
+    uint32_t  y = stripe_idx * FG_STRIPE_H;
+    uint32_t  blockHeight = OVMIN(FG_STRIPE_H, heightComp - y);
+    const OVSample *srcSampleOffsetY = fg->src[compCtr] + y * picStrideComp;
+    OVSample  *dstSampleOffsetY      = fg->dst[compCtr] + y * picStrideComp;
+    uint32_t  pseudoRandValEc;
+    uint32_t  x;
+    uint8_t   blkId;
+
+    if (!fgrain->fg_comp_model_present_flag[compCtr])
+    {
+        uint32_t l;
+        for (l = 0; l < blockHeight; l++)
+        {
+            memcpy(dstSampleOffsetY, srcSampleOffsetY, (widthComp * sizeof(OVSample)));
+            dstSampleOffsetY += picStrideComp;
+            srcSampleOffsetY += picStrideComp;
+        }
+        return;
+    }
+
+    pseudoRandValEc = fg->seeds[compCtr][stripe_idx];
+
+    /* Initialization of grain stripe of 16xwidth size */
+    memset(grainStripe, 0, FG_STRIPE_H * grainStride * sizeof(int16_t));
+
+    for (x = 0; x < widthComp; x += 16)
+    {
+        for (blkId = 0; blkId < 4; blkId++)
+        {
+            int32_t yOffset8x8 = (blkId >> 1) * 8;
+            int32_t xOffset8x8 = (blkId & 0x1)* 8;
+            int32_t blk_h = OVMIN(8, (int32_t)(heightComp - y) - yOffset8x8);
+            int32_t blk_w = OVMIN(8, (int32_t)(widthComp - x) - xOffset8x8);
+            const OVSample *srcSampleBlk8 = srcSampleOffsetY + x + xOffset8x8 + (yOffset8x8 * picStrideComp);
+            uint16_t numSamples;
+            int16_t  blockAvg;
+            uint32_t intensityInt;
+
+            /* Handling of non 8x8 blocks along with 8x8 blocks */
+            if (blk_h <= 0 || blk_w <= 0)
+            {
+                continue;
+            }
+
+            blockAvg = funcs->block_avg(srcSampleBlk8, picStrideComp, &numSamples, blk_h, blk_w, BITDEPTH);
+
+            /* Selection of the component model */
+            intensityInt = fg->intensity_interval[compCtr][blockAvg];
+
+            if (-1 != intensityInt)
+            {
+                uint32_t kOffset, lOffset;
+                int16_t  scaleFactor;
+                uint8_t  h, v;
+                const int8_t *grainDb;
+
+                /* 8x8 grain block offset using co-ordinates of decoded 8x8 block in the frame */
+                kOffset     =  (MSB16(pseudoRandValEc) % 52);
+                kOffset     &= 0xFFFC;
+                kOffset     += (x + xOffset8x8) & 0x0008;
+                lOffset     =  (LSB16(pseudoRandValEc) % 56);
+                lOffset     &= 0xFFF8;
+                lOffset     += (y + yOffset8x8) & 0x0008;
+                scaleFactor =  BIT0(pseudoRandValEc) ? -1 : 1;
+                scaleFactor *= fgrain->fg_comp_model_value[compCtr][intensityInt][0];
+                h           =  fgrain->fg_comp_model_value[compCtr][intensityInt][1] - 2;
+                v           =  fgrain->fg_comp_model_value[compCtr][intensityInt][2] - 2;
+
+                grainDb = &fg_data_base[((h * NUM_CUT_OFF_FREQ + v) * DATA_BASE_SIZE + lOffset) * DATA_BASE_SIZE + kOffset];
+
+                /* 8x8 block grain simulation */
+                funcs->grain_blk8x8(grainStripe + x + xOffset8x8 + yOffset8x8 * grainStride, grainStride,
+                                    grainDb, fgrain->fg_log2_scale_factor, scaleFactor, blk_w);
+            }/* only if average falls in any interval */
+        } /* 8x8 level block processing */
+
+        /* uppdate the PRNG once per 16x16 block of samples */
+        pseudoRandValEc = prng(pseudoRandValEc);
+    }
+
+    /* deblocking at the vertical edges of 8x8 at 16xwidth*/
+    if (fg->enable_deblock)
+    {
+        funcs->deblock_stripe(grainStripe, widthComp, grainStride);
+    }
+
+    /* Blending of size 16xwidth*/
+    funcs->blend_stripe(dstSampleOffsetY, srcSampleOffsetY, grainStripe, widthComp, grainStride,
+                        picStrideComp, blockHeight, BITDEPTH);
+}
+
+/* Process stripes until every stripe of the picture is claimed */
+static void
+fg_grain_apply_stripes(struct FGCtx *fg, int16_t *grainStripe)
+{
+    unsigned unit = atomic_fetch_add_explicit(&fg->next_unit, 1, memory_order_acq_rel);
+
+    while (unit < fg->nb_units) {
+        int compCtr = 0;
+        int stripe_idx = unit;
+
+        while (stripe_idx >= fg->nb_stripes[compCtr]) {
+            stripe_idx -= fg->nb_stripes[compCtr++];
+        }
+
+        fg_grain_apply_stripe(fg, compCtr, stripe_idx, grainStripe);
+
+        unit = atomic_fetch_add_explicit(&fg->next_unit, 1, memory_order_acq_rel);
+    }
+}
+
+static int
+fg_stripes_job(void *opaque, int idx)
+{
+    struct FGCtx *fg = (struct FGCtx *)opaque;
+    uint8_t stripes_open;
+
+    pthread_mutex_lock(&fg->jobs_mtx);
+    fg->job_queued[idx] = 0;
+    fg->nb_queued_jobs--;
+    stripes_open = idx < fg->nb_open_jobs;
+    if (stripes_open) {
+        fg->nb_running_jobs++;
+    }
+    pthread_cond_broadcast(&fg->jobs_cnd);
+    pthread_mutex_unlock(&fg->jobs_mtx);
+
+    /* Picture was already output */
+    if (!stripes_open) {
+        return 0;
+    }
+
+    fg_grain_apply_stripes(fg, fg->grain_stripes + (idx + 1) * FG_STRIPE_H * fg->grain_stride);
+
+    pthread_mutex_lock(&fg->jobs_mtx);
+    if (!--fg->nb_running_jobs) {
+        pthread_cond_broadcast(&fg->jobs_cnd);
+    }
+    pthread_mutex_unlock(&fg->jobs_mtx);
+
+    return 0;
+}
+
+int fg_grain_apply_pic(struct PostProcCtx *pp_ctx, OVSample** dstComp, OVSample** srcComp, struct OVSEIFGrain* fgrain,
+                       int pic_w, int pic_h, const int *pic_stride, int poc, uint8_t isIdrPic, uint8_t enableDeblocking)
+{
+    struct FGCtx *fg;
+    uint8_t   compCtr;
     uint8_t   color_offset[3];
-    uint32_t  widthComp[3], heightComp[3], strideComp[3];
-    int16_t   *dstSampleOffsetY;
-    int16_t   *srcSampleBlk16, *srcSampleBlk8, *srcSampleOffsetY;
-    uint16_t  numSamples;
-    int16_t   scaleFactor;
-    uint32_t  kOffset, lOffset, grainStripeOffset, grainStripeOffsetBlk8, offsetBlk8x8;
-    int32_t   *grainStripe; /* worth a row of 16x16 : Max size : 16xw;*/
-    int32_t   yOffset8x8, xOffset8x8;
-    uint32_t  picOffset, x, y, intensityInt;
-    int16_t   blockAvg; 
-    uint32_t  pseudoRandValEc; /* ec : seed to be used for the psudo random generator for a given color component */
     uint32_t  picOrderCntOffset=0;
+    int nb_jobs = 0;
+    int i, ret;
+
+    if (0 != fgrain->fg_characteristics_cancel_flag)
+    {
+        goto end;
+    }
+
+    if (!pp_ctx->fg_ctx) {
+        ret = fg_init_ctx(&pp_ctx->fg_ctx);
+        if (ret < 0) {
+            ov_log(NULL, OVLOG_ERROR, "Failed to allocate film grain context.\n");
+            return ret;
+        }
+    }
+
+    fg = pp_ctx->fg_ctx;
+
+    /* Workers already busy with decoding jobs would delay picture output */
+    if (pp_ctx->pool) {
+        nb_jobs = OVMIN(ovthread_pool_nb_idle(pp_ctx->pool), FG_MAX_JOBS);
+    }
+
+    ret = fg_update_buffers(fg, pic_w, pic_h, nb_jobs + 1);
+    if (ret < 0) {
+        ov_log(NULL, OVLOG_ERROR, "Failed to allocate film grain stripes.\n");
+        return ret;
+    }
+
+    pp_init_fg_functions(&fg->funcs, pp_ctx->cpu_flags);
 
     /* from SMPTE RDD5 */
     color_offset[0] = COLOUR_OFFSET_LUMA;
     color_offset[1] = COLOUR_OFFSET_CR;
     color_offset[2] = COLOUR_OFFSET_CB;
 
-    //BITDEPTH: only for 10-bits
-    bitDepth        = 10;
-    log2ScaleFactor = fgrain->fg_log2_scale_factor;
-
-    widthComp[0]    = pic_w;
-    widthComp[1]    = pic_w;
-    widthComp[2]    = pic_w;
-    heightComp[0]   = pic_h;
-    heightComp[1]   = pic_h;
-    heightComp[2]   = pic_h;
-
     //Only for 420 chroma format
-    widthComp[1]  >>= 1;
-    widthComp[2]  >>= 1;
-    heightComp[1] >>= 1;
-    heightComp[2] >>= 1;
-
-    /* component strides */
-    strideComp[0] = widthComp[0];
-    strideComp[1] = widthComp[1];
-    strideComp[2] = widthComp[2];
-
-    grainStripe = (int32_t *)ov_malloc(strideComp[0] * 16 * sizeof(int32_t));
+    fg->width[0]  = pic_w;
+    fg->width[1]  = pic_w >> 1;
+    fg->width[2]  = pic_w >> 1;
+    fg->height[0] = pic_h;
+    fg->height[1] = pic_h >> 1;
+    fg->height[2] = pic_h >> 1;
 
-    int16_t intensityInterval[3][MAX_NUM_INTENSITIES] ;
-    memset(intensityInterval, -1, sizeof(intensityInterval));
-    fg_compute_model_values(fgrain, intensityInterval);
+    memset(fg->intensity_interval, -1, sizeof(fg->intensity_interval));
+    fg_compute_model_values(fgrain, fg->intensity_interval);
 
     if(!fg_data_base_created){
         fg_data_base_generation(enableDeblocking);
@@ -841,105 +1154,101 @@ void fg_grain_apply_pic(int16_t** dstComp, int16_t** srcComp, struct OVSEIFGrain
         picOrderCntOffset = fgrain->fg_idr_pic;
     }
 
-    if (0 == fgrain->fg_characteristics_cancel_flag)
+    fg->fgrain = fgrain;
+    fg->enable_deblock = enableDeblocking;
+    fg->nb_units = 0;
+
+    for (compCtr = 0; compCtr < 3; compCtr++)
     {
-        for (compCtr = 0; compCtr < 3; compCtr++)
-        {
-            if (1 == fgrain->fg_comp_model_present_flag[compCtr])
-            {
-                picOffset = poc + (picOrderCntOffset << 5);
-                /* Seed initialization for current picture*/
-                pseudoRandValEc = seedLUT[((picOffset + color_offset[compCtr]) % 256)];
+        fg->dst[compCtr] = dstComp[compCtr];
+        fg->src[compCtr] = srcComp[compCtr];
+        fg->pic_stride[compCtr] = pic_stride[compCtr];
+        fg->nb_stripes[compCtr] = (fg->height[compCtr] + FG_STRIPE_H - 1) / FG_STRIPE_H;
+        fg->nb_units += fg->nb_stripes[compCtr];
 
-                dstSampleOffsetY = dstComp[compCtr];
-                srcSampleOffsetY = srcComp[compCtr];
+        if (1 == fgrain->fg_comp_model_present_flag[compCtr])
+        {
+            uint32_t picOffset = poc + (picOrderCntOffset << 5);
+            uint32_t nb_blk16_w = (fg->width[compCtr] + 15) >> 4;
+            /* Seed initialization for current picture*/
+            uint32_t pseudoRandValEc = seedLUT[((picOffset + color_offset[compCtr]) % 256)];
+            int stripe_idx;
 
-                /* Loop of 16x16 blocks */
-                for (y = 0; y < heightComp[compCtr]; y += 16)
-                {
-                    /* Initialization of grain stripe of 16xwidth size */
-                    memset(grainStripe, 0, (strideComp[0] * 16 * sizeof(int32_t)));
-                    for (x = 0; x < widthComp[compCtr]; x += 16)
-                    {
-                        /* start position offset of decoded sample in x direction */
-                        grainStripeOffset = x;
-                        srcSampleBlk16 = srcSampleOffsetY + x;
-
-                        for (blkId = 0; blkId < 4; blkId++)
-                        {
-                            yOffset8x8 = (blkId >> 1) * 8;
-                            xOffset8x8 = (blkId & 0x1)* 8;
-                            offsetBlk8x8 = xOffset8x8 + (yOffset8x8 * strideComp[compCtr]);
-                            grainStripeOffsetBlk8 = grainStripeOffset + offsetBlk8x8;
-
-                            srcSampleBlk8 = srcSampleBlk16 + offsetBlk8x8;
-                            blockAvg      = fg_compute_block_avg(srcSampleBlk8, strideComp[compCtr], &numSamples,
-                                 OVMIN(8, (heightComp[compCtr] - y - yOffset8x8)),
-                                 OVMIN(8, (widthComp[compCtr] - x - xOffset8x8)),
-                                 bitDepth);
-
-                            /* Handling of non 8x8 blocks along with 8x8 blocks */
-                            if (numSamples > 0)
-                            {
-                                /* Selection of the component model */
-                                intensityInt = intensityInterval[compCtr][blockAvg];
-
-                                if (-1 != intensityInt)
-                                {
-                                    /* 8x8 grain block offset using co-ordinates of decoded 8x8 block in the frame */
-                                    kOffset     =  (MSB16(pseudoRandValEc) % 52);
-                                    kOffset     &= 0xFFFC;
-                                    kOffset     += (x + xOffset8x8) & 0x0008;
-                                    lOffset     =  (LSB16(pseudoRandValEc) % 56);
-                                    lOffset     &= 0xFFF8;
-                                    lOffset     += (y + yOffset8x8) & 0x0008;
-                                    scaleFactor =  BIT0(pseudoRandValEc) ? -1 : 1;
-                                    scaleFactor *= fgrain->fg_comp_model_value[compCtr][intensityInt][0];
-                                    h           =  fgrain->fg_comp_model_value[compCtr][intensityInt][1] - 2;
-                                    v           =  fgrain->fg_comp_model_value[compCtr][intensityInt][2] - 2;
-
-                                    /* 8x8 block grain simulation */
-                                    // fg_simulate_grain_blk8x8(grainStripe, grainStripeOffsetBlk8, m_pGrainSynt, strideComp[compCtr],
-                                    fg_simulate_grain_blk8x8(grainStripe, grainStripeOffsetBlk8, strideComp[compCtr],
-                                    log2ScaleFactor, scaleFactor, kOffset, lOffset, h, v, OVMIN(8, (widthComp[compCtr] - x - xOffset8x8)));
-                                }/* only if average falls in any interval */
-                            } /* includes corner case handling */
-                        } /* 8x8 level block processing */
-
-                        /* uppdate the PRNG once per 16x16 block of samples */
-                        pseudoRandValEc = prng(pseudoRandValEc);
-
-                    } /* End of 16xwidth grain simulation */
-
-                    /* deblocking at the vertical edges of 8x8 at 16xwidth*/
-                    if (enableDeblocking)
-                    {
-                        fg_deblock_grain_stripe(grainStripe, widthComp[compCtr], strideComp[compCtr]);
-                    }
-                    /* Blending of size 16xwidth*/
-                    fg_blend_stripe(dstSampleOffsetY, srcSampleOffsetY, grainStripe, strideComp[compCtr], OVMIN(16, (heightComp[compCtr] - y)), bitDepth);
-                    dstSampleOffsetY += OVMIN(16, heightComp[compCtr] - y) * strideComp[compCtr];
-                    srcSampleOffsetY += OVMIN(16, heightComp[compCtr] - y) * strideComp[compCtr];
-                } 
-            }
-            else
+            /* The PRNG is updated once per 16x16 block of samples */
+            for (stripe_idx = 0; stripe_idx < fg->nb_stripes[compCtr]; ++stripe_idx)
             {
-                dstSampleOffsetY = dstComp[compCtr];
-                srcSampleOffsetY = srcComp[compCtr];
-                for (y = 0; y < heightComp[compCtr]; y += 1)
+                uint32_t j;
+                fg->seeds[compCtr][stripe_idx] = pseudoRandValEc;
+                for (j = 0; j < nb_blk16_w; ++j)
                 {
-                    memcpy(dstSampleOffsetY, srcSampleOffsetY, (widthComp[compCtr] * sizeof(int16_t)));
-                    // memset(dstSampleOffsetY, srcSampleOffsetY, (strideComp[compCtr] * sizeof(int32_t)));
-                    dstSampleOffsetY += strideComp[compCtr];
-                    srcSampleOffsetY += strideComp[compCtr];
+                    pseudoRandValEc = prng(pseudoRandValEc);
                 }
             }
-        }/* end of component loop */
+        }
     }
 
-  if (isIdrPic)
-  {
-    fgrain->fg_idr_pic ++;
-  }
-  ov_free(grainStripe);
+    atomic_store_explicit(&fg->next_unit, 0, memory_order_relaxed);
+
+    nb_jobs = OVMIN(nb_jobs, fg->nb_units - 1);
+
+    pthread_mutex_lock(&fg->jobs_mtx);
+    fg->nb_open_jobs = nb_jobs;
+    pthread_mutex_unlock(&fg->jobs_mtx);
+
+    for (i = 0; i < nb_jobs; ++i)
+    {
+        struct OVJob *job = &fg->jobs[i];
+        uint8_t queued;
+
+        /* Jobs left in the queues by previous pictures will
+         * process stripes of this one if they start in time
+         */
+        pthread_mutex_lock(&fg->jobs_mtx);
+        queued = fg->job_queued[i];
+        if (!queued) {
+            fg->job_queued[i] = 1;
+            fg->nb_queued_jobs++;
+        }
+        pthread_mutex_unlock(&fg->jobs_mtx);
+
+        if (queued) {
+            continue;
+        }
+
+        job->run      = fg_stripes_job;
+        job->opaque   = fg;
+        job->idx      = i;
+        job->priority = pp_ctx->priority;
+
+        if (ovthread_pool_submit(pp_ctx->pool, job) < 0)
+        {
+            pthread_mutex_lock(&fg->jobs_mtx);
+            fg->job_queued[i] = 0;
+            fg->nb_queued_jobs--;
+            pthread_mutex_unlock(&fg->jobs_mtx);
+            break;
+        }
+    }
+
+    /* Calling thread processes stripes too, once all stripes are
+     * claimed it only waits for the stripes processed by running
+     * jobs and not for jobs still queued behind decoding jobs
+     */
+    fg_grain_apply_stripes(fg, fg->grain_stripes);
+
+    pthread_mutex_lock(&fg->jobs_mtx);
+    fg->nb_open_jobs = 0;
+    while (fg->nb_running_jobs)
+    {
+        pthread_cond_wait(&fg->jobs_cnd, &fg->jobs_mtx);
+    }
+    pthread_mutex_unlock(&fg->jobs_mtx);
+
+end:
+    if (isIdrPic)
+    {
+        fgrain->fg_idr_pic ++;
+    }
+
+    return 0;
 }
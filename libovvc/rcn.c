@@ -14,15 +14,15 @@
 #include "rcn_lmcs.h"
 #include "ovmem.h"
 #include "ovconfig.h"
+#include "ovcpu.h"
 #include "drv.h"
 
 #if ARCH_X86
   #if SSE_ENABLED
     #include "x86/rcn_sse.h"
-  #elif AVX_ENABLED
-    //Link AVX optims
-  #else
-    //Failover x86
+  #endif
+  #if AVX_ENABLED
+    #include "x86/rcn_avx2.h"
   #endif
 #elif ARCH_AARCH64
   #if NEON_ENABLED
@@ -67,6 +67,7 @@ vvc_intra_pred_isp(const OVCTUDec *const ctudec,
     const struct OVRCNCtx *const rcn_ctx = &ctudec->rcn_ctx;
     const struct DCFunctions *dc = &rcn_ctx->rcn_funcs.dc;
     const struct PlanarFunctions *planar = &rcn_ctx->rcn_funcs.planar;
+    const struct AngularFunctions *angular = &rcn_ctx->rcn_funcs.angular;
 
     fill_ref_left_0(src, dst_stride, ref2,
                     ctudec->rcn_ctx.progress_field.vfield[(x0 >> 2) + !!(offset_x % 4)],
@@ -149,33 +150,36 @@ vvc_intra_pred_isp(const OVCTUDec *const ctudec,
                                                log2_pb_w, log2_pb_h,
                                                -abs_angle_val);
                     } else {
-                        intra_angular_v_cubic(ref1, dst, dst_stride,
-                                              log2_pb_w, log2_pb_h,
-                                              -abs_angle_val);
+                        angular->v[0][log2_pb_w](ref1, dst, dst_stride,
+                                                 log2_pb_w, log2_pb_h,
+                                                 -abs_angle_val);
                     }
 
-                } else if ((mode_idx < 8 &&  OVMIN(2, log2_pb_h - (floor_log2(3*inverse_angle_table[mode_idx] - 2) - 8)) < 0) || log2_pb_h < 2){//FIXME check this
-                    int abs_angle_val = angle_table[mode_idx];
-                    uint8_t req_frac = !!(abs_angle_val & 0x1F);
-                    if (!req_frac){
-                        intra_angular_v_nofrac(ref1, dst, dst_stride,
-                                                log2_pb_w, log2_pb_h,
-                                                abs_angle_val);
-                    } else {
-                        intra_angular_v_cubic(ref1, dst, dst_stride,
-                                              log2_pb_w, log2_pb_h,
-                                              abs_angle_val);
-                    }
                 } else {
+                    /* PDPC kernels require a non negative scale */
+                    int scale = OVMIN(2, log2_pb_h - (floor_log2(3*inverse_angle_table[mode_idx] - 2) - 8));
                     uint8_t req_frac = !!(angle_table[mode_idx] & 0x1F);
-                    if (!req_frac){
-                        intra_angular_v_nofrac_pdpc(ref1, ref2, dst, dst_stride,
-                                                    log2_pb_w, log2_pb_h,
-                                                    mode_idx);
+                    if (scale < 0 || log2_pb_h < 2) {
+                        int abs_angle_val = angle_table[mode_idx];
+                        if (!req_frac){
+                            intra_angular_v_nofrac(ref1, dst, dst_stride,
+                                                   log2_pb_w, log2_pb_h,
+                                                   abs_angle_val);
+                        } else {
+                            angular->v[0][log2_pb_w](ref1, dst, dst_stride,
+                                                     log2_pb_w, log2_pb_h,
+                                                     abs_angle_val);
+                        }
                     } else {
-                        intra_angular_v_cubic_pdpc(ref1, ref2, dst, dst_stride,
-                                              log2_pb_w, log2_pb_h,
-                                              mode_idx);
+                        if (!req_frac){
+                            intra_angular_v_nofrac_pdpc(ref1, ref2, dst, dst_stride,
+                                                        log2_pb_w, log2_pb_h,
+                                                        mode_idx);
+                        } else {
+                            angular->v_pdpc[0][log2_pb_w](ref1, ref2, dst, dst_stride,
+                                                          log2_pb_w, log2_pb_h,
+                                                          mode_idx);
+                        }
                     }
                 }
                 break;
@@ -215,33 +219,36 @@ vvc_intra_pred_isp(const OVCTUDec *const ctudec,
                                                log2_pb_w, log2_pb_h,
                                                -abs_angle_val);
                     } else {
-                        intra_angular_h_cubic(ref2, dst, dst_stride,
-                                              log2_pb_w, log2_pb_h,
-                                              -abs_angle_val);
+                        angular->h[0][log2_pb_h](ref2, dst, dst_stride,
+                                                 log2_pb_w, log2_pb_h,
+                                                 -abs_angle_val);
 
                     }
-                } else if ((mode_idx < 8 &&  OVMIN(2, log2_pb_w - (floor_log2(3*inverse_angle_table[mode_idx] - 2) - 8)) < 0) || log2_pb_h < 2){//FIXME check this
-                    int abs_angle_val = angle_table[mode_idx];
-                    uint8_t req_frac = !!(abs_angle_val & 0x1F);
-                    if (!req_frac){
-                        intra_angular_h_nofrac(ref2, dst, dst_stride,
-                                                log2_pb_w, log2_pb_h,
-                                                abs_angle_val);
-                    } else {
-                        intra_angular_h_cubic(ref2, dst, dst_stride,
-                                              log2_pb_w, log2_pb_h,
-                                              abs_angle_val);
-                    }
                 } else {
+                    /* PDPC kernels require a non negative scale */
+                    int scale = OVMIN(2, log2_pb_w - (floor_log2(3*inverse_angle_table[mode_idx] - 2) - 8));
                     uint8_t req_frac = !!(angle_table[mode_idx] & 0x1F);
-                    if (!req_frac){
-                        intra_angular_h_nofrac_pdpc(ref1, ref2, dst, dst_stride,
-                                                    log2_pb_w, log2_pb_h,
-                                                    mode_idx);
+                    if (scale < 0 || log2_pb_w < 2) {
+                        int abs_angle_val = angle_table[mode_idx];
+                        if (!req_frac){
+                            intra_angular_h_nofrac(ref2, dst, dst_stride,
+                                                   log2_pb_w, log2_pb_h,
+                                                   abs_angle_val);
+                        } else {
+                            angular->h[0][log2_pb_h](ref2, dst, dst_stride,
+                                                     log2_pb_w, log2_pb_h,
+                                                     abs_angle_val);
+                        }
                     } else {
-                        intra_angular_h_cubic_pdpc(ref1, ref2, dst, dst_stride,
-                                              log2_pb_w, log2_pb_h,
-                                              mode_idx);
+                        if (!req_frac){
+                            intra_angular_h_nofrac_pdpc(ref1, ref2, dst, dst_stride,
+                                                        log2_pb_w, log2_pb_h,
+                                                        mode_idx);
+                        } else {
+                            angular->h_pdpc[0][log2_pb_h](ref1, ref2, dst, dst_stride,
+                                                          log2_pb_w, log2_pb_h,
+                                                          mode_idx);
+                        }
                     }
                 }
             }
@@ -390,7 +397,7 @@ vvc_intra_pred_multi_ref(const OVCTUDec *const ctudec,
 #include "dbf_utils.h"
 void
 rcn_residual(OVCTUDec *const ctudec,
-             int16_t *const dst, int16_t *src,
+             uint16_t *const dst, int16_t *src,
              uint8_t x0, uint8_t y0,
              unsigned int log2_tb_w, unsigned int log2_tb_h,
              unsigned int lim_cg_w,
@@ -398,17 +405,16 @@ rcn_residual(OVCTUDec *const ctudec,
              uint8_t is_dc, uint8_t lfnst_flag, uint8_t is_mip, uint8_t lfnst_idx, uint8_t sbt)
 {
     struct TRFunctions *TRFunc = &ctudec->rcn_ctx.rcn_funcs.tr;
+    int16_t *const res = ctudec->transform_buff;
     fill_bs_map(&ctudec->dbf_info.bs1_map, x0, y0, log2_tb_w, log2_tb_h);
     int shift_v = 6 + 1;
-    int shift_h = (6 + 15 - 1) - 10;
+    int shift_h = (6 + 15 - 1) - BITDEPTH;
 
     DECLARE_ALIGNED(32, int16_t, tmp)[64*64];
 
     int tb_w = 1 << log2_tb_w;
     int tb_h = 1 << log2_tb_h;
 
-    memset(tmp, 0, sizeof(int16_t) << (log2_tb_w + log2_tb_h));
-
     if (lfnst_flag) {
         /* FIXME separate lfnst mode derivation from lfnst reconstruction */
         process_lfnst_luma(ctudec, src, ctudec->lfnst_subblock, log2_tb_w, log2_tb_h, x0, y0,
@@ -424,27 +430,47 @@ rcn_residual(OVCTUDec *const ctudec,
 
         /* FIXME use coefficient zeroing in MTS */
         TRFunc->func[tr_v_idx][log2_tb_h](src, tmp, tb_w, tb_w, tb_h, shift_v);
-        TRFunc->func[tr_h_idx][log2_tb_w](tmp, dst, tb_h, tb_h, tb_w, shift_h);
+        TRFunc->func[tr_h_idx][log2_tb_w](tmp, res, tb_h, tb_h, tb_w, shift_h);
+
+        vvc_add_residual(res, dst, log2_tb_w, log2_tb_h, 0);
 
     } else if (!cu_mts_flag) {
 
         if (is_dc) {
 
-            TRFunc->dc(dst, log2_tb_w, log2_tb_h, src[0]);
+            if (TRFunc->dc_add) {
+                TRFunc->dc_add(dst, log2_tb_w, log2_tb_h, src[0]);
+            } else {
+                TRFunc->dc(res, log2_tb_w, log2_tb_h, src[0]);
+                vvc_add_residual(res, dst, log2_tb_w, log2_tb_h, 0);
+            }
 
         } else {
             int nb_row = OVMIN(lim_cg_w, 1 << log2_tb_w);
             int nb_col = OVMIN(lim_cg_w, 1 << log2_tb_h);
 
+            /* First nb_row lines are written by the vertical pass, only
+             * the remaining ones need to be zeroed for the horizontal pass
+             */
+            memset(tmp + (nb_row << log2_tb_h), 0, sizeof(int16_t) * ((tb_w - nb_row) << log2_tb_h));
+
             TRFunc->func[DCT_II][log2_tb_h](src, tmp, tb_w, nb_row, nb_col, shift_v);
-            TRFunc->func[DCT_II][log2_tb_w](tmp, dst, tb_h, tb_h, nb_row, shift_h);
+
+            if (TRFunc->dct2_add[log2_tb_w]) {
+                TRFunc->dct2_add[log2_tb_w](tmp, dst, tb_h, tb_h, nb_row, shift_h);
+            } else {
+                TRFunc->func[DCT_II][log2_tb_w](tmp, res, tb_h, tb_h, nb_row, shift_h);
+                vvc_add_residual(res, dst, log2_tb_w, log2_tb_h, 0);
+            }
         }
     } else {
         enum DCTType tr_h_idx = cu_mts_idx  & 1;
         enum DCTType tr_v_idx = cu_mts_idx >> 1;
 
         TRFunc->func[tr_v_idx][log2_tb_h](src, tmp, tb_w, tb_w, tb_h, shift_v);
-        TRFunc->func[tr_h_idx][log2_tb_w](tmp, dst, tb_h, tb_h, tb_w, shift_h);
+        TRFunc->func[tr_h_idx][log2_tb_w](tmp, res, tb_h, tb_h, tb_w, shift_h);
+
+        vvc_add_residual(res, dst, log2_tb_w, log2_tb_h, 0);
     }
 }
 
@@ -459,7 +485,7 @@ rcn_residual_c(OVCTUDec *const ctudec,
     struct TRFunctions *TRFunc = &ctudec->rcn_ctx.rcn_funcs.tr;
 
     const int shift_v = 6 + 1;
-    const int shift_h = (6 + 15 - 1) - 10;
+    const int shift_h = (6 + 15 - 1) - BITDEPTH;
 
     DECLARE_ALIGNED(32, int16_t, tmp)[32*32];
 
@@ -497,17 +523,20 @@ rcn_residual_c(OVCTUDec *const ctudec,
 }
 
 void
-rcn_init_functions(struct RCNFunctions *rcn_func, uint8_t ict_type, uint8_t lm_chroma_enabled,
+rcn_init_functions(struct RCNFunctions *rcn_func, int cpu_flags, uint8_t ict_type, uint8_t lm_chroma_enabled,
                     uint8_t sps_chroma_vertical_collocated_flag, uint8_t lmcs_flag)
 {
   rcn_init_mc_functions(rcn_func);
   rcn_init_tr_functions(rcn_func);
   rcn_init_dc_planar_functions(rcn_func);
+  rcn_init_angular_functions(rcn_func);
   rcn_init_ict_functions(rcn_func, ict_type);
   rcn_init_lfnst_functions(rcn_func);
   rcn_init_mip_functions(rcn_func);
   rcn_init_alf_functions(rcn_func);
   rcn_init_sao_functions(rcn_func);
+  rcn_init_dbf_functions(rcn_func);
+  rcn_init_refine_functions(rcn_func);
   rcn_init_lmcs_function(rcn_func, lmcs_flag);
 
   if (lm_chroma_enabled) {
@@ -519,32 +548,58 @@ rcn_init_functions(struct RCNFunctions *rcn_func, uint8_t ict_type, uint8_t lm_c
       }
   }
 
+  /* SIMD kernels are built when enabled at configure time and
+   * only used if supported by the CPU, later levels override
+   * the kernels of previous ones
+   */
   #if ARCH_X86
     #if SSE_ENABLED
-      rcn_init_mc_functions_sse(rcn_func);
+    if (cpu_flags & OV_CPU_SSE4_1) {
       rcn_init_tr_functions_sse(rcn_func);
+      rcn_init_lfnst_functions_sse(rcn_func);
+      /* Kernels working on CTU buffers clip to BITDEPTH */
       rcn_init_dc_planar_functions_sse(rcn_func);
+      rcn_init_angular_functions_sse(rcn_func);
       rcn_init_ict_functions_sse(rcn_func, ict_type);
-      rcn_init_lfnst_functions_sse(rcn_func);
       rcn_init_mip_functions_sse(rcn_func);
-      rcn_init_alf_functions_sse(rcn_func);
-      rcn_init_sao_functions_sse(rcn_func);
+      rcn_init_refine_functions_sse(rcn_func);
       if (lm_chroma_enabled) {
           if (!sps_chroma_vertical_collocated_flag /*sps->sps_chroma_horizontal_collocated_flag*/) {
               rcn_init_cclm_functions_sse(rcn_func);
           }
       }
-    #elif AVX_ENABLED
-      //Link AVX optims
-    #else
-      //Failover x86
+      /* Remaining SIMD kernels read or write 10 bits picture
+       * samples only and are not built otherwise (see x86obj.mak)
+       */
+      #if BITDEPTH == 10
+      rcn_init_mc_functions_sse(rcn_func);
+      rcn_init_alf_functions_sse(rcn_func);
+      rcn_init_sao_functions_sse(rcn_func);
+      rcn_init_dbf_functions_sse(rcn_func);
+      #endif
+    }
+    #endif
+    #if AVX_ENABLED
+    if (cpu_flags & OV_CPU_AVX2) {
+      rcn_init_tr_functions_avx2(rcn_func);
+      rcn_init_angular_functions_avx2(rcn_func);
+      #if BITDEPTH == 10
+      rcn_init_mc_functions_avx2(rcn_func);
+      rcn_init_alf_functions_avx2(rcn_func);
+      rcn_init_sao_functions_avx2(rcn_func);
+      #endif
+    }
     #endif
   #elif ARCH_AARCH64
     #if NEON_ENABLED
+    if (cpu_flags & OV_CPU_NEON) {
       // rcn_init_tr_functions_neon(rcn_func);
       // rcn_init_dc_planar_functions_neon(rcn_func);
       // rcn_init_sao_functions_neon(rcn_func);
+      #if BITDEPTH == 10
       rcn_init_mc_functions_neon(rcn_func);
+      #endif
+    }
     #else
       //Failover ARM
     #endif
@@ -24,8 +24,11 @@ struct DBFInfo;
 struct OVBuffInfo;
 struct VVCGPM;
 
+/* Inverse transform luma coefficients and add the residual
+ * to reconstructed samples in dst
+ */
 void rcn_residual(OVCTUDec *const ctudec,
-             int16_t *const dst, int16_t *src,
+             uint16_t *const dst, int16_t *src,
              uint8_t x0, uint8_t y0,
              unsigned int log2_tb_w, unsigned int log2_tb_h,
              unsigned int lim_cg_w,
@@ -105,7 +108,8 @@ void rcn_init_gpm_params();
 void rcn_gpm_b(OVCTUDec *const ctudec, struct VVCGPM* gpm_ctx, int x0, int y0, int log2_pb_w, int log2_pb_h);
 
 /* FIXME check vertical / horizontal */
-void rcn_init_functions(struct RCNFunctions *rcn_func, uint8_t ict_type, uint8_t lm_chroma_enabled, 
+/* SIMD kernels are selected according to cpu_flags (see ovcpu.h) */
+void rcn_init_functions(struct RCNFunctions *rcn_func, int cpu_flags, uint8_t ict_type, uint8_t lm_chroma_enabled,
                         uint8_t sps_chroma_vertical_collocated_flag, uint8_t lmcs_flag);
 
 void rcn_init_cclm_functions(struct RCNFunctions *rcn_func);
@@ -118,12 +122,20 @@ void rcn_init_tr_functions(struct RCNFunctions *const rcn_funcs);
 
 void rcn_init_dc_planar_functions(struct RCNFunctions *const rcn_funcs);
 
+void rcn_init_angular_functions(struct RCNFunctions *const rcn_funcs);
+
 void rcn_init_lfnst_functions(struct RCNFunctions *rcn_func);
 
 void rcn_init_mip_functions(struct RCNFunctions *const rcn_funcs);
 
 void rcn_init_sao_functions(struct RCNFunctions *const rcn_funcs);
 
+void rcn_init_dbf_functions(struct RCNFunctions *const rcn_funcs);
+
+void rcn_init_refine_functions(struct RCNFunctions *const rcn_funcs);
+
+void rcn_dbf_implicit_edges(struct DBFInfo *const dbf_info);
+
 void rcn_dbf_ctu(const struct OVRCNCtx  *const rcn_ctx, struct DBFInfo *const dbf_info,
                  uint8_t log2_ctu_s, uint8_t last_x, uint8_t last_y);
 
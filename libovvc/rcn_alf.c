@@ -117,8 +117,7 @@ static const uint8_t shuffle_lut[4][13] = {
 void
 rcn_alf_create(RCNALF* alf)
 {
-    //BITDEPTH: uniquement pour bitdepth 10
-    int bit_depth = 10;
+    int bit_depth = BITDEPTH;
     int shift_luma = bit_depth - 8;
     int shift_chroma = bit_depth - 8;
 
@@ -153,16 +152,11 @@ void alf_reconstructCoeff_luma(RCNALF* alf, const struct OVALFData* alf_data)
     int num_coeff = 13;
     int num_coeff_minus1 = num_coeff - 1;
 
-    int num_filters = alf_data->alf_luma_num_filters_signalled_minus1 + 1 ;
-    int16_t* coeff ;
-    int16_t* clip;
-
-    coeff = (int16_t*) alf_data->alf_luma_coeff;
-    clip = (int16_t*) alf_data->alf_luma_clip_idx;
-    for( int filter_idx = 0; filter_idx < num_filters; filter_idx++ )
-    {
-        coeff[filter_idx* MAX_NUM_ALF_LUMA_COEFF + num_coeff_minus1] = factor;
-    }
+    /* APS data is shared between decoders and must not be modified,
+     * the last coefficient of each filter is only set in coeff_final
+     */
+    const int16_t* coeff = &alf_data->alf_luma_coeff[0][0];
+    const int16_t* clip = &alf_data->alf_luma_clip_idx[0][0];
 
     for( int class_idx = 0; class_idx < num_classes; class_idx++ )
     {
@@ -190,13 +184,13 @@ void alf_reconstructCoeff_chroma(RCNALF* alf, const struct OVALFData* alf_data)
     int num_coeff_minus1 = num_coeff - 1;
     const int num_alts = alf_data->alf_chroma_num_alt_filters_minus1 + 1;
 
-    int16_t* coeff ;
-    int16_t* clip;
+    const int16_t* coeff;
+    const int16_t* clip;
 
     for( int alt_idx = 0; alt_idx < num_alts; ++ alt_idx )
     {
-        coeff = (int16_t*) alf_data->alf_chroma_coeff[alt_idx];
-        clip = (int16_t*) alf_data->alf_chroma_clip_idx[alt_idx];
+        coeff = alf_data->alf_chroma_coeff[alt_idx];
+        clip = alf_data->alf_chroma_clip_idx[alt_idx];
         for( int coeffIdx = 0; coeffIdx < num_coeff_minus1; ++coeffIdx )
         {
             alf->chroma_coeff_final[alt_idx][coeffIdx] = coeff[coeffIdx];
@@ -228,10 +222,17 @@ void alf_reconstructCoeff_chroma(RCNALF* alf, const struct OVALFData* alf_data)
 void rcn_alf_reconstruct_coeff_APS(RCNALF* alf, OVCTUDec *const ctudec, uint8_t luma_flag, uint8_t chroma_flag)
 {
 
+    struct ALFInfo *alf_info = &ctudec->alf_info;
+
     if (luma_flag){
-      for (int i = 0; i < ctudec->alf_info.num_alf_aps_ids_luma; i++)
+      for (int i = 0; i < alf_info->num_alf_aps_ids_luma; i++)
       {
-        const struct OVALFData* alf_data = ctudec->alf_info.aps_alf_data[i];
+        const struct OVALFData* alf_data = alf_info->aps_alf_data[i];
+
+        /* Filter set was already derived from this APS */
+        if (alf_info->rcn_aps_uid[i] == alf_info->aps_alf_uid[i]) {
+            continue;
+        }
 
         alf_reconstructCoeff_luma(alf, alf_data);
 
@@ -243,12 +244,14 @@ void rcn_alf_reconstruct_coeff_APS(RCNALF* alf, OVCTUDec *const ctudec, uint8_t
             }
           }
         }
+        alf_info->rcn_aps_uid[i] = alf_info->aps_alf_uid[i];
       }
     }
 
-    if (chroma_flag){
-        const struct OVALFData* alf_data_c = ctudec->alf_info.aps_alf_data_c;
+    if (chroma_flag && alf_info->rcn_aps_uid_c != alf_info->aps_alf_uid_c){
+        const struct OVALFData* alf_data_c = alf_info->aps_alf_data_c;
         alf_reconstructCoeff_chroma(alf, alf_data_c);
+        alf_info->rcn_aps_uid_c = alf_info->aps_alf_uid_c;
     }
 }
 
@@ -442,8 +445,7 @@ void rcn_alf_derive_classification(RCNALF *alf, int16_t *const rcn_img, const in
 {
     int height = blk.y + blk.height;
     int width = blk.x + blk.width;
-    //BITDEPTH: uniquement pour bitdepth 10
-    int bit_depth = 10;
+    int bit_depth = BITDEPTH;
 
     for( int i = blk.y; i < height; i += CLASSIFICATION_BLK_SIZE )
     {
@@ -466,7 +468,7 @@ void rcn_alf_derive_classification(RCNALF *alf, int16_t *const rcn_img, const in
     }
 }
 
-void cc_alf_filterBlk(int16_t * chroma_dst, int16_t * luma_src, const int chr_stride, const int luma_stride,
+void cc_alf_filterBlk(OVSample * chroma_dst, int16_t * luma_src, const int chr_stride, const int luma_stride,
                         const Area blk_dst, const uint8_t c_id, const int16_t *filt_coeff,
                         const int vbCTUHeight, int vbPos)
 {
@@ -483,7 +485,7 @@ void cc_alf_filterBlk(int16_t * chroma_dst, int16_t * luma_src, const int chr_st
       {
         int row       = ii;
         int col       = j;
-        int16_t *srcSelf  = chroma_dst + col + row * chr_stride;
+        OVSample *srcSelf  = chroma_dst + col + row * chr_stride;
 
         int offset1 = luma_stride;
         int offset2 = -luma_stride;
@@ -523,8 +525,7 @@ void cc_alf_filterBlk(int16_t * chroma_dst, int16_t * luma_src, const int chr_st
           const int scale_bits = 7;
           sum = (sum + ((1 << scale_bits ) >> 1)) >> scale_bits;
 
-          //BITDEPTH: uniquement pour bitdepth 10
-          const int bit_depth = 10;
+          const int bit_depth = BITDEPTH;
           const int offset = 1 << bit_depth >> 1;
           sum = OVMAX( OVMIN( sum + offset, (1<<bit_depth) - 1 ), 0) - offset;
 
@@ -538,7 +539,7 @@ void cc_alf_filterBlk(int16_t * chroma_dst, int16_t * luma_src, const int chr_st
   }
 }
 
-void cc_alf_filterBlkVB(int16_t * chroma_dst, int16_t * luma_src, const int chr_stride, const int luma_stride,
+void cc_alf_filterBlkVB(OVSample * chroma_dst, int16_t * luma_src, const int chr_stride, const int luma_stride,
                         const Area blk_dst, const uint8_t c_id, const int16_t *filt_coeff,
                         const int vbCTUHeight, int vbPos)
 {
@@ -556,7 +557,7 @@ void cc_alf_filterBlkVB(int16_t * chroma_dst, int16_t * luma_src, const int chr_
       {
         int row       = ii;
         int col       = j;
-        int16_t *srcSelf  = chroma_dst + col + row * chr_stride;
+        OVSample *srcSelf  = chroma_dst + col + row * chr_stride;
 
         int offset1 = luma_stride;
         int offset2 = -luma_stride;
@@ -597,8 +598,7 @@ void cc_alf_filterBlkVB(int16_t * chroma_dst, int16_t * luma_src, const int chr_
             const int scale_bits = 7;
             sum = (sum + ((1 << scale_bits ) >> 1)) >> scale_bits;
 
-            //BITDEPTH: uniquement pour bitdepth 10
-            const int bit_depth = 10;
+            const int bit_depth = BITDEPTH;
             const int offset = 1 << bit_depth >> 1;
             sum = OVMAX( OVMIN( sum + offset, (1<<bit_depth) - 1 ), 0) - offset;
 
@@ -617,7 +617,7 @@ void cc_alf_filterBlkVB(int16_t * chroma_dst, int16_t * luma_src, const int chr_
 // src   : filter buffer pre-ALF (of size CTU)
 // blk_dst: location and dimension of destination block in frame
 // blk   : location and dimension of destination block in filter buffer
-static void alf_filter_c(int16_t *const dst, const int16_t *const src,
+static void alf_filter_c(OVSample *const dst, const int16_t *const src,
                   const int dst_stride, const int src_stride,
                   Area blk_dst,
                   const int16_t *const filter_set, const int16_t *const clip_set,
@@ -632,8 +632,8 @@ static void alf_filter_c(int16_t *const dst, const int16_t *const src,
     int dst_blk_stride = dst_stride * blk_h;
     int src_blk_stride = src_stride * blk_h;
 
-    int16_t* dst0 = dst ;
-    int16_t* dst1 = dst + dst_stride;
+    OVSample* dst0 = dst ;
+    OVSample* dst1 = dst + dst_stride;
     int i;
 
     const int16_t *lm_src0 = src;
@@ -673,7 +673,7 @@ static void alf_filter_c(int16_t *const dst, const int16_t *const src,
                     sum = (sum + offset) >> shift;
 
                     sum += curr;
-                    dst1[l] = OVMAX( OVMIN( sum, (1<<10) - 1 ), 0);
+                    dst1[l] = OVMAX( OVMIN( sum, OV_SAMPLE_MAX ), 0);
 
                     src_0++;
                     src_1++;
@@ -699,7 +699,7 @@ static void alf_filter_c(int16_t *const dst, const int16_t *const src,
     }
 }
 
-static void alf_filter_cVB(int16_t *const dst, const int16_t *const src,
+static void alf_filter_cVB(OVSample *const dst, const int16_t *const src,
                   const int dst_stride, const int src_stride,
                   Area blk_dst,
                   const int16_t *const filter_set, const int16_t *const clip_set,
@@ -714,8 +714,8 @@ static void alf_filter_cVB(int16_t *const dst, const int16_t *const src,
     int dst_blk_stride = dst_stride * blk_h;
     int src_blk_stride = src_stride * blk_h;
 
-    int16_t* dst0 = dst ;
-    int16_t* dst1 = dst + dst_stride;
+    OVSample* dst0 = dst ;
+    OVSample* dst1 = dst + dst_stride;
     int i;
 
     const int16_t *lm_src0 = src;
@@ -782,7 +782,7 @@ static void alf_filter_cVB(int16_t *const dst, const int16_t *const src,
                     }
 
                     sum += curr;
-                    dst1[l] = OVMAX( OVMIN( sum, (1<<10) - 1 ), 0);
+                    dst1[l] = OVMAX( OVMIN( sum, OV_SAMPLE_MAX ), 0);
 
                     src_0++;
                     src_1++;
@@ -808,7 +808,7 @@ static void alf_filter_cVB(int16_t *const dst, const int16_t *const src,
     }
 }
 
-static void alf_filterBlkLuma(uint8_t * class_idx_arr, uint8_t * transpose_idx_arr, int16_t *const dst, int16_t *const src, const int dstStride, const int srcStride,
+static void alf_filterBlkLuma(uint8_t * class_idx_arr, uint8_t * transpose_idx_arr, OVSample *const dst, int16_t *const src, const int dstStride, const int srcStride,
                          Area blk_dst, const int16_t *filter_set, const int16_t *clip_set,
                          const int ctu_height, int virbnd_pos)
 {
@@ -826,10 +826,10 @@ static void alf_filterBlkLuma(uint8_t * class_idx_arr, uint8_t * transpose_idx_a
   int srcStride2 = srcStride * clsSizeY;
 
   int16_t * _src = src;
-  int16_t * _dst = dst;
+  OVSample * _dst = dst;
 
-  int16_t* pRec0 = dst ;
-  int16_t* pRec1 = pRec0 + dstStride;
+  OVSample* pRec0 = dst ;
+  OVSample* pRec1 = pRec0 + dstStride;
 
   for( int i = 0; i < blk_dst.height; i += clsSizeY )
   {
@@ -875,7 +875,7 @@ static void alf_filterBlkLuma(uint8_t * class_idx_arr, uint8_t * transpose_idx_a
           sum = (sum + offset) >> shift;
 
           sum += curr;
-          pRec1[jj] = OVMAX( OVMIN( sum, (1<<10) - 1 ), 0);
+          pRec1[jj] = OVMAX( OVMIN( sum, OV_SAMPLE_MAX ), 0);
 
           pImg0++;
           pImg1++;
@@ -896,7 +896,7 @@ static void alf_filterBlkLuma(uint8_t * class_idx_arr, uint8_t * transpose_idx_a
   }
 }
 
-static void alf_filterBlkLumaVB(uint8_t * class_idx_arr, uint8_t * transpose_idx_arr, int16_t *const dst, int16_t *const src, const int dstStride, const int srcStride,
+static void alf_filterBlkLumaVB(uint8_t * class_idx_arr, uint8_t * transpose_idx_arr, OVSample *const dst, int16_t *const src, const int dstStride, const int srcStride,
                          Area blk_dst, const int16_t *filter_set, const int16_t *clip_set,
                          const int ctu_height, int virbnd_pos)
 {
@@ -914,10 +914,10 @@ static void alf_filterBlkLumaVB(uint8_t * class_idx_arr, uint8_t * transpose_idx
   int srcStride2 = srcStride * clsSizeY;
 
   int16_t * _src = src;
-  int16_t * _dst = dst;
+  OVSample * _dst = dst;
 
-  int16_t* pRec0 = dst ;
-  int16_t* pRec1 = pRec0 + dstStride;
+  OVSample* pRec0 = dst ;
+  OVSample* pRec1 = pRec0 + dstStride;
 
   for( int i = 0; i < blk_dst.height; i += clsSizeY )
   {
@@ -990,7 +990,7 @@ static void alf_filterBlkLumaVB(uint8_t * class_idx_arr, uint8_t * transpose_idx
           }
 
           sum += curr;
-          pRec1[jj] = OVMAX( OVMIN( sum, (1<<10) - 1 ), 0);
+          pRec1[jj] = OVMAX( OVMIN( sum, OV_SAMPLE_MAX ), 0);
 
           pImg0++;
           pImg1++;
@@ -1062,9 +1062,8 @@ void rcn_alf_filter_line(OVCTUDec *const ctudec, const struct RectEntryInfo cons
             //Destination block in the final image
             blk_dst.x=x_pos_pic; blk_dst.y=y_pos_pic;
             blk_dst.width=width; blk_dst.height=height;
-            //BITDEPTH
-            int stride_dst = frame->linesize[c_idx]/2;
-            int16_t*  dst_luma = (int16_t*) frame->data[c_idx] + blk_dst.y*stride_dst + blk_dst.x;
+            int stride_dst = frame->linesize[c_idx] / sizeof(OVSample);
+            OVSample*  dst_luma = (OVSample*) frame->data[c_idx] + blk_dst.y*stride_dst + blk_dst.x;
 
             rcn_alf_derive_classification(alf, src_luma, stride_src, blk_dst, ctu_width, ctudec->pic_h, ctudec->rcn_ctx.rcn_funcs.alf.classif);
 
@@ -1085,7 +1084,7 @@ void rcn_alf_filter_line(OVCTUDec *const ctudec, const struct RectEntryInfo cons
 
         for( uint8_t c_idx = 1; c_idx < 3; c_idx++ )
         {
-            const int chr_scale = frame->linesize[0] / frame->linesize[c_idx];
+            const int chr_scale = frame->width[0] / frame->width[c_idx];
 
             if( (c_idx==1 && (alf_params_ctu->ctb_alf_flag & 2)) || (c_idx==2 && (alf_params_ctu->ctb_alf_flag & 1)))
             {
@@ -1099,8 +1098,8 @@ void rcn_alf_filter_line(OVCTUDec *const ctudec, const struct RectEntryInfo cons
                 blk_dst.width  = width /chr_scale;
                 blk_dst.height = height/chr_scale;
 
-                int stride_dst = frame->linesize[c_idx]/2;
-                int16_t*  dst_chroma = (int16_t*) frame->data[c_idx] + blk_dst.y*stride_dst + blk_dst.x;
+                int stride_dst = frame->linesize[c_idx] / sizeof(OVSample);
+                OVSample*  dst_chroma = (OVSample*) frame->data[c_idx] + blk_dst.y*stride_dst + blk_dst.x;
 
                 uint8_t alt_num = (c_idx == 1) ? alf_params_ctu->cb_alternative : alf_params_ctu->cr_alternative;
 
@@ -1133,9 +1132,8 @@ void rcn_alf_filter_line(OVCTUDec *const ctudec, const struct RectEntryInfo cons
                     //Destination block in the final image
                     blk_dst.x=x_pos_pic/chr_scale; blk_dst.y=y_pos_pic/chr_scale;
                     blk_dst.width=width/chr_scale; blk_dst.height=height/chr_scale;
-                    //BITDEPTH
-                    int stride_dst = frame->linesize[c_idx]/2;
-                    int16_t*  dst_chroma = (int16_t*) frame->data[c_idx] + blk_dst.y*stride_dst + blk_dst.x;
+                    int stride_dst = frame->linesize[c_idx] / sizeof(OVSample);
+                    OVSample*  dst_chroma = (OVSample*) frame->data[c_idx] + blk_dst.y*stride_dst + blk_dst.x;
 
                     // const int16_t *filt_coeff = alf_data.alf_cc_mapped_coeff[c_idx - 1][filt_idx];
                     const int16_t *filt_coeff = alf_data->alf_cc_mapped_coeff[c_idx - 1][filt_idx - 1];
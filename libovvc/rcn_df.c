@@ -3,6 +3,7 @@
 #include "ovutils.h"
 #include "dec_structures.h"
 #include "ctudec.h"
+#include "rcn.h"
 
 #define DEFAULT_INTRA_TC_OFFSET 2 ///< Default intra TC offset
 #define MAX_QP 64
@@ -34,7 +35,7 @@ static const uint8_t beta_lut[MAX_QP + 1] =
 
 
 static inline uint8_t
-use_strong_filter_l0(const int16_t* src, const int stride, const int beta, const int tc, int max_l_p, int max_l_q)
+use_strong_filter_l0(const OVSample* src, const int stride, const int beta, const int tc, int max_l_p, int max_l_q)
 {
     const int16_t m0 = src[-stride * 4];
     const int16_t m3 = src[-stride    ];
@@ -78,7 +79,7 @@ use_strong_filter_l0(const int16_t* src, const int stride, const int beta, const
 }
 
 static inline uint8_t
-use_strong_filter_l1(const int16_t* src, const int stride, const int beta, const int tc)
+use_strong_filter_l1(const OVSample* src, const int stride, const int beta, const int tc)
 {
     const int16_t m0 = src[-stride * 4];
     const int16_t m3 = src[-stride    ];
@@ -95,19 +96,19 @@ use_strong_filter_l1(const int16_t* src, const int stride, const int beta, const
 
 /* FIXME Macros ? */
 static inline uint16_t
-compute_dp_c(int16_t* src, const int stride , const uint8_t is_ctb_b)
+compute_dp_c(OVSample* src, const int stride , const uint8_t is_ctb_b)
 {
     return abs(src[-stride * (3 - is_ctb_b)] - 2 * src[-stride * 2] + src[-stride]);
 }
 
 static inline uint16_t
-compute_dp(int16_t* src, const int stride)
+compute_dp(OVSample* src, const int stride)
 {
     return abs(src[-stride * 3] - 2 * src[-stride * 2] + src[-stride]);
 }
 
 static inline uint16_t
-compute_dq(int16_t* src, const int stride)
+compute_dq(OVSample* src, const int stride)
 {
     return abs(src[0] - 2 * src[stride] + src[stride * 2]);
 }
@@ -123,7 +124,7 @@ struct DBFParams{
 static struct DBFParams
 compute_dbf_limits(const struct DBFInfo *const dbf_info, int qp, int bs)
 {
-    const int bitdepth  = 10;
+    const int bitdepth  = BITDEPTH;
     int beta_offset  = dbf_info->beta_offset;
     int tc_offset    = dbf_info->tc_offset;
 
@@ -132,7 +133,11 @@ compute_dbf_limits(const struct DBFInfo *const dbf_info, int qp, int bs)
     const int tc_idx   = ov_clip((qp + DEFAULT_INTRA_TC_OFFSET * (bs - 1) + tc_offset), 0, MAX_QP + DEFAULT_INTRA_TC_OFFSET);
     const int beta_idx = ov_clip(qp + beta_offset, 0, MAX_QP);
 
+#if BITDEPTH < 10
+    const int tc = (tc_lut[tc_idx] + (1 << (9 - bitdepth))) >> (10 - bitdepth);
+#else
     const int tc = tc_lut[tc_idx] << (bitdepth - 10);
+#endif
 
     const int beta = beta_lut[beta_idx] << (bitdepth - 8);
     struct DBFParams dbf_params;
@@ -164,10 +169,10 @@ derive_filter_idx(int filter_l_p, int filter_l_q)
 }
 
 static void
-filter_7_7(int16_t *src, const int stride, const int tc)
+filter_7_7(OVSample *src, const int stride, const int tc)
 {
-    int16_t* srcP = src - stride;
-    int16_t* srcQ = src;
+    OVSample* srcP = src - stride;
+    OVSample* srcQ = src;
 
     static const int dbCoeffs7[7] = { 59, 50, 41, 32, 23, 14, 5 };
     static const int8_t tc7[7] = { 6, 5, 4, 3, 2, 1, 1};
@@ -193,10 +198,10 @@ filter_7_7(int16_t *src, const int stride, const int tc)
 }
 
 static void
-filter_7_5(int16_t *src, const int stride, const int tc)
+filter_7_5(OVSample *src, const int stride, const int tc)
 {
-    int16_t* srcP = src - stride;
-    int16_t* srcQ = src;
+    OVSample* srcP = src - stride;
+    OVSample* srcQ = src;
 
     static const int dbCoeffs7[7] = { 59, 50, 41, 32, 23, 14, 5 };
     static const int dbCoeffs5[5] = { 58, 45, 32, 19, 6};
@@ -224,10 +229,10 @@ filter_7_5(int16_t *src, const int stride, const int tc)
 }
 
 static void
-filter_5_7(int16_t *src, const int stride, const int tc)
+filter_5_7(OVSample *src, const int stride, const int tc)
 {
-    int16_t* srcP = src - stride;
-    int16_t* srcQ = src;
+    OVSample* srcP = src - stride;
+    OVSample* srcQ = src;
 
     static const int dbCoeffs7[7] = { 59, 50, 41, 32, 23, 14, 5 };
     static const int dbCoeffs5[5] = { 58, 45, 32, 19, 6};
@@ -254,10 +259,10 @@ filter_5_7(int16_t *src, const int stride, const int tc)
 }
 
 static void
-filter_5_5(int16_t *src, const int stride, const int tc)
+filter_5_5(OVSample *src, const int stride, const int tc)
 {
-    int16_t* srcP = src - stride;
-    int16_t* srcQ = src;
+    OVSample* srcP = src - stride;
+    OVSample* srcQ = src;
 
     static const int dbCoeffs5[5] = { 58, 45, 32, 19, 6};
     static const int8_t tc7[7] = { 6, 5, 4, 3, 2, 1, 1};
@@ -285,10 +290,10 @@ filter_5_5(int16_t *src, const int stride, const int tc)
 }
 
 static void
-filter_7_3(int16_t *src, const int stride, const int tc)
+filter_7_3(OVSample *src, const int stride, const int tc)
 {
-    int16_t* srcP = src - stride;
-    int16_t* srcQ = src;
+    OVSample* srcP = src - stride;
+    OVSample* srcQ = src;
 
     static const int dbCoeffs7[7] = { 59, 50, 41, 32, 23, 14, 5 };
     static const int dbCoeffs3[3] = { 53, 32, 11 };
@@ -317,10 +322,10 @@ filter_7_3(int16_t *src, const int stride, const int tc)
 }
 
 static void
-filter_3_7(int16_t *src, const int stride, const int tc)
+filter_3_7(OVSample *src, const int stride, const int tc)
 {
-    int16_t* srcP = src - stride;
-    int16_t* srcQ = src;
+    OVSample* srcP = src - stride;
+    OVSample* srcQ = src;
 
     static const int dbCoeffs7[7] = { 59, 50, 41, 32, 23, 14, 5 };
     static const int dbCoeffs3[3] = { 53, 32, 11 };
@@ -349,10 +354,10 @@ filter_3_7(int16_t *src, const int stride, const int tc)
 }
 
 static void
-filter_5_3(int16_t *src, const int stride, const int tc)
+filter_5_3(OVSample *src, const int stride, const int tc)
 {
-    int16_t* srcP = src - stride;
-    int16_t* srcQ = src;
+    OVSample* srcP = src - stride;
+    OVSample* srcQ = src;
 
     static const int dbCoeffs3[3] = { 53, 32, 11 };
     static const int dbCoeffs5[5] = { 58, 45, 32, 19, 6};
@@ -380,10 +385,10 @@ filter_5_3(int16_t *src, const int stride, const int tc)
 }
 
 static void
-filter_3_5(int16_t *src, const int stride, const int tc)
+filter_3_5(OVSample *src, const int stride, const int tc)
 {
-    int16_t* srcP = src - stride;
-    int16_t* srcQ = src;
+    OVSample* srcP = src - stride;
+    OVSample* srcQ = src;
 
     static const int dbCoeffs3[3] = { 53, 32, 11 };
     static const int dbCoeffs5[5] = { 58, 45, 32, 19, 6};
@@ -410,21 +415,21 @@ filter_3_5(int16_t *src, const int stride, const int tc)
     }
 }
 
-void (*filter_lut[11])(int16_t *src, const int stride, const int tc) = {
+void (*filter_lut[11])(OVSample *src, const int stride, const int tc) = {
     NULL       , &filter_3_5, &filter_3_7, NULL       ,
     &filter_5_3, &filter_5_5, &filter_5_7, NULL       ,
     &filter_7_3, &filter_7_5, &filter_7_7
 };
 
 static inline void
-filter_luma_strong_large(int16_t* src, const int stride, const int tc, int max_l_p, int max_l_q)
+filter_luma_strong_large(OVSample* src, const int stride, const int tc, int max_l_p, int max_l_q)
 {
     const int filter_idx = derive_filter_idx(max_l_p, max_l_q);
     filter_lut[filter_idx](src, stride, tc);
 }
 
 static inline void
-filter_luma_strong_small(int16_t* src, const int stride, const int tc)
+filter_luma_strong_small(OVSample* src, const int stride, const int tc)
 {
 
     const int16_t m0  = src[-stride * 4];
@@ -445,7 +450,7 @@ filter_luma_strong_small(int16_t* src, const int stride, const int tc)
 }
 
 static inline void
-filter_luma_weak(int16_t* src, const int stride, const int tc, const int th_cut, const uint8_t extend_p, const uint8_t extend_q)
+filter_luma_weak(OVSample* src, const int stride, const int tc, const int th_cut, const uint8_t extend_p, const uint8_t extend_q)
 {
     const int16_t m1  = src[-stride * 3];
     const int16_t m2  = src[-stride * 2];
@@ -459,26 +464,26 @@ filter_luma_weak(int16_t* src, const int stride, const int tc, const int th_cut,
 
     if (abs(delta) < th_cut) {
         delta = ov_clip(delta,-tc, tc);
-        src[-stride] = ov_clip(m3 + delta, 0, 1023 );
-        src[0]       = ov_clip(m4 - delta, 0, 1023);
+        src[-stride] = ov_clip(m3 + delta, 0, OV_SAMPLE_MAX );
+        src[0]       = ov_clip(m4 - delta, 0, OV_SAMPLE_MAX);
 
         if (extend_p) {
             const int tc2 = tc >> 1;
             const int delta1 = ov_clip(((((m1 + m3 + 1) >> 1) - m2 + delta) >> 1),-tc2, tc2);
-            src[-stride * 2] = ov_clip(m2 + delta1, 0, 1023);
+            src[-stride * 2] = ov_clip(m2 + delta1, 0, OV_SAMPLE_MAX);
         }
 
         if (extend_q) {
             const int tc2 = tc >> 1;
             const int delta2 = ov_clip(((((m6 + m4 + 1) >> 1) - m5 - delta) >> 1),-tc2, tc2);
-            src[stride] = ov_clip(m5 + delta2, 0, 1023);
+            src[stride] = ov_clip(m5 + delta2, 0, OV_SAMPLE_MAX);
         }
     }
 }
 
 
 static inline uint8_t
-use_strong_filter_c2(uint16_t* src, const int stride, const int beta, const int tc, uint8_t is_ctb_b)
+use_strong_filter_c2(OVSample* src, const int stride, const int beta, const int tc, uint8_t is_ctb_b)
 {
     const int16_t m0 = src[(-stride * 4) >> is_ctb_b];
     #if 0
@@ -497,7 +502,7 @@ use_strong_filter_c2(uint16_t* src, const int stride, const int beta, const int
 }
 
 static inline uint8_t
-use_strong_filter_c(uint16_t* src, const int stride, const int beta, const int tc)
+use_strong_filter_c(OVSample* src, const int stride, const int beta, const int tc)
 {
     const int16_t m0 = src[-stride * 4];
     const int16_t m3 = src[-stride    ];
@@ -513,7 +518,7 @@ use_strong_filter_c(uint16_t* src, const int stride, const int beta, const int t
 }
 
 static inline void
-filter_chroma_strong(uint16_t* src, const int stride, const int tc/*, const uint8_t is_ctb_b*/)
+filter_chroma_strong(OVSample* src, const int stride, const int tc/*, const uint8_t is_ctb_b*/)
 {
     const int16_t m0 = src[-stride * 4];
     const int16_t m1 = src[-stride * 3];
@@ -533,7 +538,7 @@ filter_chroma_strong(uint16_t* src, const int stride, const int tc/*, const uint
 }
 
 static inline void
-filter_chroma_strong_c(uint16_t* src, const int stride, const int tc, uint8_t is_ctb_b)
+filter_chroma_strong_c(OVSample* src, const int stride, const int tc, uint8_t is_ctb_b)
 {
     const int16_t m0 = src[-stride * 4];
     const int16_t m1 = src[-stride * 3];
@@ -560,7 +565,7 @@ filter_chroma_strong_c(uint16_t* src, const int stride, const int tc, uint8_t is
 }
 
 static inline void
-filter_chroma_weak(uint16_t* src, const int stride, const int tc)
+filter_chroma_weak(OVSample* src, const int stride, const int tc)
 {
     int delta;
 
@@ -570,8 +575,113 @@ filter_chroma_weak(uint16_t* src, const int stride, const int tc)
     const int16_t m5 = src[ stride    ];
 
     delta = ov_clip(((((m4 - m3) << 2) + m2 - m5 + 4) >> 3), -tc, tc);
-    src[-stride] = ov_clip(m3 + delta, 0, 1023);
-    src[0]       = ov_clip(m4 - delta, 0, 1023);
+    src[-stride] = ov_clip(m3 + delta, 0, OV_SAMPLE_MAX);
+    src[0]       = ov_clip(m4 - delta, 0, OV_SAMPLE_MAX);
+}
+
+/* Apply strong or weak filters on the segments of an edge according
+ * to the decisions stored in segs
+ * Segments are 4 luma lines long and step is the distance between two
+ * samples across the edge
+ */
+static void
+filter_luma_segments(OVSample *src, ptrdiff_t line_stride, ptrdiff_t step,
+                     const struct DBFSegments *segs)
+{
+    uint64_t seg_map = segs->strong_map | segs->weak_map;
+
+    while (seg_map) {
+        int seg_idx = ov_ctz64(seg_map);
+        OVSample *seg = src + seg_idx * (line_stride << 2);
+        const int tc = segs->tc[seg_idx];
+        int i;
+
+        if ((segs->strong_map >> seg_idx) & 0x1) {
+            for (i = 0; i < 4; i++) {
+                filter_luma_strong_small(seg, step, tc);
+                seg += line_stride;
+            }
+        } else {
+            const int th_cut = tc * 10;
+            uint8_t extend_p = (segs->ext_p_map >> seg_idx) & 0x1;
+            uint8_t extend_q = (segs->ext_q_map >> seg_idx) & 0x1;
+            for (i = 0; i < 4; i++) {
+                filter_luma_weak(seg, step, tc, th_cut, extend_p, extend_q);
+                seg += line_stride;
+            }
+        }
+
+        seg_map &= seg_map - 1;
+    }
+}
+
+static void
+filter_luma_ver(OVSample *src, ptrdiff_t stride, const struct DBFSegments *segs)
+{
+    filter_luma_segments(src, stride, 1, segs);
+}
+
+static void
+filter_luma_hor(OVSample *src, ptrdiff_t stride, const struct DBFSegments *segs)
+{
+    filter_luma_segments(src, 1, stride, segs);
+}
+
+/* Segments are 2 chroma lines long */
+static void
+filter_chroma_ver(OVSample *src, ptrdiff_t stride, const struct DBFSegments *segs,
+                  uint8_t is_ctb_b)
+{
+    uint64_t seg_map = segs->strong_map | segs->weak_map;
+
+    while (seg_map) {
+        int seg_idx = ov_ctz64(seg_map);
+        OVSample *seg = src + seg_idx * (stride << 1);
+        const int tc = segs->tc[seg_idx];
+        int i;
+
+        if ((segs->strong_map >> seg_idx) & 0x1) {
+            for (i = 0; i < 2; i++) {
+                filter_chroma_strong(seg, 1, tc);
+                seg += stride;
+            }
+        } else {
+            for (i = 0; i < 2; i++) {
+                filter_chroma_weak(seg, 1, tc);
+                seg += stride;
+            }
+        }
+
+        seg_map &= seg_map - 1;
+    }
+}
+
+static void
+filter_chroma_hor(OVSample *src, ptrdiff_t stride, const struct DBFSegments *segs,
+                  uint8_t is_ctb_b)
+{
+    uint64_t seg_map = segs->strong_map | segs->weak_map;
+
+    while (seg_map) {
+        int seg_idx = ov_ctz64(seg_map);
+        OVSample *seg = src + (seg_idx << 1);
+        const int tc = segs->tc[seg_idx];
+        int i;
+
+        if ((segs->strong_map >> seg_idx) & 0x1) {
+            for (i = 0; i < 2; i++) {
+                filter_chroma_strong_c(seg, stride, tc, is_ctb_b);
+                seg++;
+            }
+        } else {
+            for (i = 0; i < 2; i++) {
+                filter_chroma_weak(seg, stride, tc);
+                seg++;
+            }
+        }
+
+        seg_map &= seg_map - 1;
+    }
 }
 
 /* Check if filter is 3 or 1 sample large based on other left edges */
@@ -596,7 +706,8 @@ derive_large_map_from_ngh(const uint64_t *src_map)
 }
 
 static void
-filter_veritcal_edge_c(const struct DBFInfo *const dbf_info, uint16_t *src, ptrdiff_t stride,
+filter_veritcal_edge_c(const struct DBFInfo *const dbf_info, struct DBFSegments *segs, int seg_idx,
+                       OVSample *src, ptrdiff_t stride,
                        uint8_t qp, uint64_t bs2_map, uint64_t large_map_q)
 {
     const uint8_t is_large = large_map_q & 0x1;
@@ -607,17 +718,17 @@ filter_veritcal_edge_c(const struct DBFInfo *const dbf_info, uint16_t *src, ptrd
      * FIXME check on inter when bs1 is enabled
      */
     if (is_large || is_bs2) {
-        uint16_t *src0 = src;
-        uint16_t *src1 = src + stride;
+        OVSample *src0 = src;
+        OVSample *src1 = src + stride;
 
         const struct DBFParams dbf_params = compute_dbf_limits(dbf_info, qp, 1 + is_bs2);
         uint8_t is_strong = 0;
 
         if (is_large) {
-            const int dp0 = compute_dp((int16_t *)src0, 1);
-            const int dq0 = compute_dq((int16_t *)src0, 1);
-            const int dp3 = compute_dp((int16_t *)src1, 1);
-            const int dq3 = compute_dq((int16_t *)src1, 1);
+            const int dp0 = compute_dp(src0, 1);
+            const int dq0 = compute_dq(src0, 1);
+            const int dp3 = compute_dp(src1, 1);
+            const int dq3 = compute_dq(src1, 1);
 
             const int d0 = dp0 + dq0;
             const int d3 = dp3 + dq3;
@@ -629,29 +740,21 @@ filter_veritcal_edge_c(const struct DBFInfo *const dbf_info, uint16_t *src, ptrd
                         (2 * d3 < (dbf_params.beta >> 2)) &&
                         use_strong_filter_c(src0, 1, dbf_params.beta, dbf_params.tc) &&
                         use_strong_filter_c(src1, 1, dbf_params.beta, dbf_params.tc);
-
-            if (is_strong) {
-                int j;
-                for (j = 0; j < 2; ++j) {
-                    filter_chroma_strong(src, 1, dbf_params.tc);
-                    src += stride;
-                }
-            }
         }
 
-        if (!is_strong) {
-            int j;
-            for (j = 0; j < 2; ++j) {
-                filter_chroma_weak(src, 1, dbf_params.tc);
-                src += stride;
-            }
+        if (is_strong) {
+            segs->strong_map |= (uint64_t)1 << seg_idx;
+        } else {
+            segs->weak_map |= (uint64_t)1 << seg_idx;
         }
+        segs->tc[seg_idx] = dbf_params.tc;
     }
 }
 
 /* Filter vertical edges */
 static void
-vvc_dbf_chroma_hor(uint16_t *src_cb, uint16_t *src_cr, int stride,
+vvc_dbf_chroma_hor(const struct DBFFunctions *const dbf,
+                   OVSample *src_cb, OVSample *src_cr, int stride,
                    const struct DBFInfo *const dbf_info,
                    uint8_t nb_unit_h, int is_last_h, uint8_t nb_unit_w,
                    uint8_t ctu_lft)
@@ -697,7 +800,9 @@ vvc_dbf_chroma_hor(uint16_t *src_cb, uint16_t *src_cr, int stride,
 
             /* FIXME use absolute QP maps */
             const uint8_t *qp_col = &dbf_info->qp_map_cb.hor[36 + edge_idx];
-            uint16_t *src = src_cb;
+            OVSample *src = src_cb;
+            struct DBFSegments segs = {0};
+            int seg_idx = 0;
 
             /* Discard non filtered edges from edge_map */
             edge_map &= bs2_map | (bs1_map & large_map_q);
@@ -713,19 +818,22 @@ vvc_dbf_chroma_hor(uint16_t *src_cb, uint16_t *src_cr, int stride,
                 large_map_q >>= nb_skipped_blk;
                 bs2_map     >>= nb_skipped_blk;
                 qp_col       += nb_skipped_blk * 34;
-                src          += nb_skipped_blk * blk_stride;
+                seg_idx      += nb_skipped_blk;
 
                 qp = (qp_col[-1] + qp_col[0] + 1) >> 1;
 
-                filter_veritcal_edge_c(dbf_info, src, stride, qp, bs2_map, large_map_q);
+                filter_veritcal_edge_c(dbf_info, &segs, seg_idx,
+                                       src + seg_idx * blk_stride, stride, qp, bs2_map, large_map_q);
 
                 edge_map    >>= nb_skipped_blk + 1;
                 large_map_q >>= 1;
                 bs2_map     >>= 1;
 
-                src += blk_stride;
                 qp_col += 34;
+                seg_idx++;
             }
+
+            dbf->chroma_ver(src, stride, &segs, 0);
         }
         src_cb += 1 << 3;
     }
@@ -746,7 +854,9 @@ vvc_dbf_chroma_hor(uint16_t *src_cb, uint16_t *src_cr, int stride,
 
             const uint8_t *qp_col = &dbf_info->qp_map_cr.hor[36 + edge_idx];
 
-            uint16_t *src = src_cr;
+            OVSample *src = src_cr;
+            struct DBFSegments segs = {0};
+            int seg_idx = 0;
 
             edge_map &= bs2_map | (bs1_map & large_map_q);
 
@@ -758,26 +868,30 @@ vvc_dbf_chroma_hor(uint16_t *src_cb, uint16_t *src_cr, int stride,
                 large_map_q >>= nb_skipped_blk;
                 bs2_map     >>= nb_skipped_blk;
                 qp_col       += nb_skipped_blk * 34;
-                src          += nb_skipped_blk * blk_stride;
+                seg_idx      += nb_skipped_blk;
 
                 qp = (qp_col[-1] + qp_col[0] + 1) >> 1;
 
-                filter_veritcal_edge_c(dbf_info, src, stride, qp, bs2_map, large_map_q);
+                filter_veritcal_edge_c(dbf_info, &segs, seg_idx,
+                                       src + seg_idx * blk_stride, stride, qp, bs2_map, large_map_q);
 
                 edge_map    >>= nb_skipped_blk + 1;
                 large_map_q >>= 1;
                 bs2_map     >>= 1;
 
-                src += blk_stride;
                 qp_col += 34;
+                seg_idx++;
             }
+
+            dbf->chroma_ver(src, stride, &segs, 0);
         }
         src_cr += 1 << 3;
     }
 }
 
 static void
-filter_horizontal_edge_c(const struct DBFInfo *const dbf_info, uint16_t *src, ptrdiff_t stride,
+filter_horizontal_edge_c(const struct DBFInfo *const dbf_info, struct DBFSegments *segs, int seg_idx,
+                         OVSample *src, ptrdiff_t stride,
                          uint8_t qp, uint64_t bs2_map, uint64_t large_map_q, uint8_t is_ctb_b)
 {
     const uint8_t is_large = large_map_q & 0x1;
@@ -788,17 +902,17 @@ filter_horizontal_edge_c(const struct DBFInfo *const dbf_info, uint16_t *src, pt
      * FIXME check on inter when bs1 is enabled
      */
     if (is_large || is_bs2) {
-        uint16_t *src0 = src;
-        uint16_t *src1 = src + 1;
+        OVSample *src0 = src;
+        OVSample *src1 = src + 1;
 
         const struct DBFParams dbf_params = compute_dbf_limits(dbf_info, qp, 1 + is_bs2);
         uint8_t is_strong = 0;
 
         if (is_large) {
-            const int dp0 = compute_dp_c((int16_t *)src0, stride, is_ctb_b);
-            const int dq0 = compute_dq((int16_t *)src0, stride);
-            const int dp3 = compute_dp_c((int16_t *)src1, stride, is_ctb_b);
-            const int dq3 = compute_dq((int16_t *)src1, stride);
+            const int dp0 = compute_dp_c(src0, stride, is_ctb_b);
+            const int dq0 = compute_dq(src0, stride);
+            const int dp3 = compute_dp_c(src1, stride, is_ctb_b);
+            const int dq3 = compute_dq(src1, stride);
 
             const int d0 = dp0 + dq0;
             const int d3 = dp3 + dq3;
@@ -810,28 +924,20 @@ filter_horizontal_edge_c(const struct DBFInfo *const dbf_info, uint16_t *src, pt
                         (2 * d3 < (dbf_params.beta >> 2)) &&
                         use_strong_filter_c2(src0, stride, dbf_params.beta, dbf_params.tc, is_ctb_b) &&
                         use_strong_filter_c2(src1, stride, dbf_params.beta, dbf_params.tc, is_ctb_b);
-
-            if (is_strong) {
-                int j;
-                for (j = 0; j < 2; ++j) {
-                    filter_chroma_strong_c(src, stride, dbf_params.tc, is_ctb_b);
-                    src++;
-                }
-            }
         }
 
-        if (!is_strong) {
-            int j;
-            for (j = 0; j < 2; ++j) {
-                filter_chroma_weak(src, stride, dbf_params.tc);
-                src++;
-            }
+        if (is_strong) {
+            segs->strong_map |= (uint64_t)1 << seg_idx;
+        } else {
+            segs->weak_map |= (uint64_t)1 << seg_idx;
         }
+        segs->tc[seg_idx] = dbf_params.tc;
     }
 }
 
 static void
-vvc_dbf_chroma_ver(uint16_t *src_cb, uint16_t *src_cr, int stride,
+vvc_dbf_chroma_ver(const struct DBFFunctions *const dbf,
+                   OVSample *src_cb, OVSample *src_cr, int stride,
                    const struct DBFInfo *const dbf_info,
                    uint8_t nb_unit_w, int is_last_w, uint8_t nb_unit_h, uint8_t is_last_h,
                    uint8_t ctu_abv)
@@ -866,7 +972,9 @@ vvc_dbf_chroma_ver(uint16_t *src_cb, uint16_t *src_cr, int stride,
             uint64_t large_map_q = derive_large_map_from_ngh(&edg_map_tab[edge_idx]);
 
             uint8_t is_ctb_b = i == 0;
-            uint16_t *src = src_cb;
+            OVSample *src = src_cb;
+            struct DBFSegments segs = {0};
+            int seg_idx = 0;
 
             edge_map &= bs2_map | (bs1_map & large_map_q);
 
@@ -878,20 +986,23 @@ vvc_dbf_chroma_ver(uint16_t *src_cb, uint16_t *src_cr, int stride,
                 large_map_q >>= nb_skipped_blk;
                 bs2_map     >>= nb_skipped_blk;
                 qp_row       += nb_skipped_blk;
-                src          += nb_skipped_blk * blk_stride;
+                seg_idx      += nb_skipped_blk;
 
                 qp = (qp_row[0] + qp_row[34] + 1) >> 1;
 
-                filter_horizontal_edge_c(dbf_info, src, stride, qp, bs2_map,
+                filter_horizontal_edge_c(dbf_info, &segs, seg_idx,
+                                         src + seg_idx * blk_stride, stride, qp, bs2_map,
                                          large_map_q, is_ctb_b);
 
                 edge_map    >>= nb_skipped_blk + 1;
                 large_map_q >>= 1;
                 bs2_map     >>= 1;
 
-                src += blk_stride;
                 qp_row++;
+                seg_idx++;
             }
+
+            dbf->chroma_hor(src, stride, &segs, is_ctb_b);
         }
         src_cb += stride << 3;
     }
@@ -910,8 +1021,10 @@ vvc_dbf_chroma_ver(uint16_t *src_cb, uint16_t *src_cr, int stride,
         if (edge_map) {
             uint64_t large_map_q = derive_large_map_from_ngh(&edg_map_tab[edge_idx]);
             const uint8_t *qp_row = &dbf_info->qp_map_cr.hor[edge_idx * 34];
-            uint16_t *src = src_cr;
+            OVSample *src = src_cr;
             uint8_t is_ctb_b = i == 0;
+            struct DBFSegments segs = {0};
+            int seg_idx = 0;
 
             edge_map &= bs2_map | (bs1_map & large_map_q);
 
@@ -923,27 +1036,31 @@ vvc_dbf_chroma_ver(uint16_t *src_cb, uint16_t *src_cr, int stride,
                 large_map_q >>= nb_skipped_blk;
                 bs2_map     >>= nb_skipped_blk;
                 qp_row       += nb_skipped_blk;
-                src          += nb_skipped_blk * blk_stride;
+                seg_idx      += nb_skipped_blk;
 
                 qp = (qp_row[0] + qp_row[34] + 1) >> 1;
 
-                filter_horizontal_edge_c(dbf_info, src, stride, qp, bs2_map,
+                filter_horizontal_edge_c(dbf_info, &segs, seg_idx,
+                                         src + seg_idx * blk_stride, stride, qp, bs2_map,
                                          large_map_q, is_ctb_b);
 
                 edge_map    >>= nb_skipped_blk + 1;
                 large_map_q >>= 1;
                 bs2_map     >>= 1;
 
-                src += blk_stride;
                 qp_row++;
+                seg_idx++;
             }
+
+            dbf->chroma_hor(src, stride, &segs, is_ctb_b);
         }
         src_cr += stride << 3;
     }
 }
 
 static void
-filter_veritcal_edge(const struct DBFInfo *const dbf_info, uint16_t *src, ptrdiff_t stride,
+filter_veritcal_edge(const struct DBFInfo *const dbf_info, struct DBFSegments *segs, int seg_idx,
+                     OVSample *src, ptrdiff_t stride,
                      uint8_t qp, uint64_t bs2_map, uint64_t large_p_map,
                      uint64_t large_q_map, uint64_t small_map,
                      uint64_t affine_p, uint64_t affine_q, uint64_t aff_edg_1)
@@ -958,13 +1075,13 @@ filter_veritcal_edge(const struct DBFInfo *const dbf_info, uint16_t *src, ptrdif
     /*FIXME subblock handling */
 
     const struct DBFParams dbf_params = compute_dbf_limits(dbf_info, qp, bs);
-    uint16_t* src0 = src;
-    uint16_t* src3 = src + stride * 3;
+    OVSample* src0 = src;
+    OVSample* src3 = src + stride * 3;
 
-    const int dp0 = compute_dp((int16_t *)src0, 1);
-    const int dq0 = compute_dq((int16_t *)src0, 1);
-    const int dp3 = compute_dp((int16_t *)src3, 1);
-    const int dq3 = compute_dq((int16_t *)src3, 1);
+    const int dp0 = compute_dp(src0, 1);
+    const int dq0 = compute_dq(src0, 1);
+    const int dp3 = compute_dp(src3, 1);
+    const int dq3 = compute_dq(src3, 1);
 
     uint8_t use_strong_large = 0;
 
@@ -991,15 +1108,15 @@ filter_veritcal_edge(const struct DBFInfo *const dbf_info, uint16_t *src, ptrdif
         int dq3L = dq3;
 
         if (max_l_p > 3) {
-            dp0L += compute_dp((int16_t *)src0 - 3, 1) + 1;
-            dp3L += compute_dp((int16_t *)src3 - 3, 1) + 1;
+            dp0L += compute_dp(src0 - 3, 1) + 1;
+            dp3L += compute_dp(src3 - 3, 1) + 1;
             dp0L >>= 1;
             dp3L >>= 1;
         }
 
         if (max_l_q > 3) {
-            dq0L += compute_dq((int16_t *)src0 + 3, 1) + 1;
-            dq3L += compute_dq((int16_t *)src3 + 3, 1) + 1;
+            dq0L += compute_dq(src0 + 3, 1) + 1;
+            dq3L += compute_dq(src3 + 3, 1) + 1;
             dq0L >>= 1;
             dq3L >>= 1;
         }
@@ -1012,10 +1129,10 @@ filter_veritcal_edge(const struct DBFInfo *const dbf_info, uint16_t *src, ptrdif
         use_strong_large = (dL < dbf_params.beta) &&
             ((d0L << 1) < (dbf_params.beta >> 4)) &&
             ((d3L << 1) < (dbf_params.beta >> 4)) &&
-            use_strong_filter_l0((int16_t *)src0, 1, dbf_params.beta, dbf_params.tc, max_l_p, max_l_q) &&
-            use_strong_filter_l0((int16_t *)src3, 1, dbf_params.beta, dbf_params.tc, max_l_p, max_l_q);
+            use_strong_filter_l0(src0, 1, dbf_params.beta, dbf_params.tc, max_l_p, max_l_q) &&
+            use_strong_filter_l0(src3, 1, dbf_params.beta, dbf_params.tc, max_l_p, max_l_q);
         if (use_strong_large) {
-            int16_t *_src = (int16_t *)src0;
+            OVSample *_src = src0;
             /* FIXME should already be 3 or higher since we would be small otherwise */
             max_l_p = max_l_p > 3 ? max_l_p : 3;
             max_l_q = max_l_q > 3 ? max_l_q : 3;
@@ -1037,36 +1154,31 @@ filter_veritcal_edge(const struct DBFInfo *const dbf_info, uint16_t *src, ptrdif
 
             sw = sw && ((d0 << 1) < (dbf_params.beta >> 2))
                 && ((d3 << 1) < (dbf_params.beta >> 2))
-                && use_strong_filter_l1((int16_t *)src0, 1, dbf_params.beta, dbf_params.tc)
-                && use_strong_filter_l1((int16_t *)src3, 1, dbf_params.beta, dbf_params.tc);
+                && use_strong_filter_l1(src0, 1, dbf_params.beta, dbf_params.tc)
+                && use_strong_filter_l1(src3, 1, dbf_params.beta, dbf_params.tc);
 
             if (sw){
-                int16_t *_src = (int16_t *)src0;
-                for (int i = 0; i < 4; i++) {
-                    filter_luma_strong_small(_src, 1, dbf_params.tc);
-                    _src += stride;
-                }
+                segs->strong_map |= (uint64_t)1 << seg_idx;
             } else {
                 const int dp = dp0 + dp3;
                 const int dq = dq0 + dq3;
                 const int side_thd = (dbf_params.beta + (dbf_params.beta >> 1)) >> 3;
-                const int th_cut  = dbf_params.tc * 10;
                 //uint8_t extend_p = is_not_small && (dp < side_thd);
                 //uint8_t extend_q = is_not_small && (dq < side_thd);
-                uint8_t extend_p = (dp < side_thd) && (max_l_p > 1 && max_l_q > 1);
-                uint8_t extend_q = (dq < side_thd) && (max_l_p > 1 && max_l_q > 1);
-                int16_t *_src = (int16_t *)src0;
-                for (int i = 0; i < 4; i++) {
-                    filter_luma_weak(_src, 1, dbf_params.tc, th_cut, extend_p, extend_q);
-                    _src += stride;
-                }
+                uint64_t extend_p = (dp < side_thd) && (max_l_p > 1 && max_l_q > 1);
+                uint64_t extend_q = (dq < side_thd) && (max_l_p > 1 && max_l_q > 1);
+                segs->weak_map  |= (uint64_t)1 << seg_idx;
+                segs->ext_p_map |= extend_p << seg_idx;
+                segs->ext_q_map |= extend_q << seg_idx;
             }
+            segs->tc[seg_idx] = dbf_params.tc;
         }
     }
 }
 
 static void
-vvc_dbf_ctu_hor(uint16_t *src, int stride, const struct DBFInfo *const dbf_info,
+vvc_dbf_ctu_hor(const struct DBFFunctions *const dbf, OVSample *src, int stride,
+                const struct DBFInfo *const dbf_info,
                 uint8_t nb_unit_h, int is_last_h, uint8_t nb_unit_w, uint8_t ctu_lft)
 {
     const int blk_stride = stride << 2; 
@@ -1081,7 +1193,7 @@ vvc_dbf_ctu_hor(uint16_t *src, int stride, const struct DBFInfo *const dbf_info,
     src += skip_first << 2;
 
     for (i = skip_first; i < nb_unit_w; ++i) {
-        uint16_t* src_tmp = src;
+        OVSample* src_tmp = src;
 
         uint64_t edg_msk = edg_map[i] | aff_edg_map[i];
         uint64_t bs1_map  = dbf_info->bs1_map.ver[i];
@@ -1107,6 +1219,9 @@ vvc_dbf_ctu_hor(uint16_t *src, int stride, const struct DBFInfo *const dbf_info,
 
             const uint8_t *qp_col = &dbf_info->qp_map_y.hor[36 + i];
 
+            struct DBFSegments segs = {0};
+            int seg_idx = 0;
+
             //if (i != 16) {
                large_p_map  &= ~(aff_edg_map[i] & (~edg_map[i]));
                large_q_map  &= ~(aff_edg_map[i] & (~edg_map[i]));
@@ -1125,10 +1240,11 @@ vvc_dbf_ctu_hor(uint16_t *src, int stride, const struct DBFInfo *const dbf_info,
                 bs2_map     >>= nb_skipped_blk;
                 qp_col       += nb_skipped_blk * 34;
                 src_tmp      += nb_skipped_blk * blk_stride;
+                seg_idx      += nb_skipped_blk;
 
                 qp = (qp_col[-1] + qp_col[0] + 1) >> 1;
 
-                filter_veritcal_edge(dbf_info, src_tmp, stride, qp, bs2_map, large_p_map,
+                filter_veritcal_edge(dbf_info, &segs, seg_idx, src_tmp, stride, qp, bs2_map, large_p_map,
                                      large_q_map, small_map, affine_p, affine_q, aff_edg_1);
 
                 edg_msk  >>= nb_skipped_blk + 1;
@@ -1144,14 +1260,21 @@ vvc_dbf_ctu_hor(uint16_t *src, int stride, const struct DBFInfo *const dbf_info,
 
                 src_tmp += blk_stride;
                 qp_col += 34;
+                seg_idx++;
             } while (edg_msk);
+
+            /* Segments of the edge are filtered at once once decisions
+             * have been derived, large filters are already applied
+             */
+            dbf->luma_ver(src, stride, &segs);
         }
         src += 1 << 2;
     }
 }
 
 static void
-filter_horizontal_edge(const struct DBFInfo *const dbf_info, uint16_t *src, ptrdiff_t stride,
+filter_horizontal_edge(const struct DBFInfo *const dbf_info, struct DBFSegments *segs, int seg_idx,
+                       OVSample *src, ptrdiff_t stride,
                        uint8_t qp, uint64_t bs2_map, uint64_t large_p_map,
                        uint64_t large_q_map, uint64_t small_map,
                        uint64_t affine_p, uint64_t affine_q, uint64_t aff_edg_1)
@@ -1164,13 +1287,13 @@ filter_horizontal_edge(const struct DBFInfo *const dbf_info, uint16_t *src, ptrd
 
     const struct DBFParams dbf_params = compute_dbf_limits(dbf_info, qp, bs);
 
-    int16_t *src0 = (int16_t *)src;
-    int16_t *src3 = (int16_t *)src + 3;
+    OVSample *src0 = src;
+    OVSample *src3 = src + 3;
 
-    const int dp0 = compute_dp((int16_t *)src0, stride);
-    const int dq0 = compute_dq((int16_t *)src0, stride);
-    const int dp3 = compute_dp((int16_t *)src3, stride);
-    const int dq3 = compute_dq((int16_t *)src3, stride);
+    const int dp0 = compute_dp(src0, stride);
+    const int dq0 = compute_dq(src0, stride);
+    const int dp3 = compute_dp(src3, stride);
+    const int dq3 = compute_dq(src3, stride);
 
     uint8_t use_strong_large = 0;
 
@@ -1224,7 +1347,7 @@ filter_horizontal_edge(const struct DBFInfo *const dbf_info, uint16_t *src, ptrd
             max_l_p = max_l_p > 3 ? max_l_p : 3;
             max_l_q = max_l_q > 3 ? max_l_q : 3;
         for (int i = 0; i < 4; i++) {
-            int16_t *_src = src0 + i;
+            OVSample *_src = src0 + i;
             filter_luma_strong_large(_src, stride, dbf_params.tc, max_l_p, max_l_q);
         }
     } else {
@@ -1241,28 +1364,25 @@ filter_horizontal_edge(const struct DBFInfo *const dbf_info, uint16_t *src, ptrd
                 && use_strong_filter_l1(src3, stride, dbf_params.beta, dbf_params.tc);
 
             if (sw){
-                for (int i = 0; i < 4; i++) {
-                    int16_t *_src = src0 + i;
-                    filter_luma_strong_small(_src, stride, dbf_params.tc);
-                }
+                segs->strong_map |= (uint64_t)1 << seg_idx;
             } else {
                 const int dp = dp0 + dp3;
                 const int dq = dq0 + dq3;
                 const int side_thd = (dbf_params.beta + (dbf_params.beta >> 1)) >> 3;
-                const int th_cut  = dbf_params.tc * 10;
-                uint8_t extend_p = (dp < side_thd) && (max_l_p > 1 && max_l_q > 1);
-                uint8_t extend_q = (dq < side_thd) && (max_l_p > 1 && max_l_q > 1);
-                for (int i = 0; i < 4; i++) {
-                    int16_t *_src = src0 + i;
-                    filter_luma_weak(_src, stride, dbf_params.tc, th_cut, extend_p, extend_q);
-                }
+                uint64_t extend_p = (dp < side_thd) && (max_l_p > 1 && max_l_q > 1);
+                uint64_t extend_q = (dq < side_thd) && (max_l_p > 1 && max_l_q > 1);
+                segs->weak_map  |= (uint64_t)1 << seg_idx;
+                segs->ext_p_map |= extend_p << seg_idx;
+                segs->ext_q_map |= extend_q << seg_idx;
             }
+            segs->tc[seg_idx] = dbf_params.tc;
         }
     }
 }
 
 static void
-vvc_dbf_ctu_ver(uint16_t *src, int stride, const struct DBFInfo *const dbf_info,
+vvc_dbf_ctu_ver(const struct DBFFunctions *const dbf, OVSample *src, int stride,
+                const struct DBFInfo *const dbf_info,
                 uint8_t nb_unit_w, int is_last_w, uint8_t nb_unit_h, uint8_t ctu_abv)
 {
     const int blk_stride = 1 << 2;
@@ -1283,7 +1403,7 @@ vvc_dbf_ctu_ver(uint16_t *src, int stride, const struct DBFInfo *const dbf_info,
     src += (skip_first * stride) << 2;
 
     for (i = skip_first; i < nb_unit_h; ++i) {
-        uint16_t *src_tmp = src;
+        OVSample *src_tmp = src;
 
         uint64_t edg_msk = edg_map[i] | aff_edg_map[i];
         uint64_t bs2_map = dbf_info->bs2_map.hor[i];
@@ -1306,6 +1426,8 @@ vvc_dbf_ctu_ver(uint16_t *src, int stride, const struct DBFInfo *const dbf_info,
             const uint8_t *qp_row = &dbf_info->qp_map_y.hor[34 * i];
             uint64_t affine_p = dbf_info->affine_map.hor[i];
             uint64_t affine_q = dbf_info->affine_map.hor[i + 1];
+            struct DBFSegments segs = {0};
+            int seg_idx = 0;
     //        if (i != 16) {
                large_p_map  &= ~(aff_edg_map[i] & (~edg_map[i]));
                large_q_map  &= ~(aff_edg_map[i] & (~edg_map[i]));
@@ -1325,10 +1447,11 @@ vvc_dbf_ctu_ver(uint16_t *src, int stride, const struct DBFInfo *const dbf_info,
                 bs2_map     >>= nb_skipped_blk;
                 qp_row       += nb_skipped_blk;
                 src_tmp      += nb_skipped_blk * blk_stride;
+                seg_idx      += nb_skipped_blk;
 
                 qp = (qp_row[0] + qp_row[34] + 1) >> 1;
 
-                filter_horizontal_edge(dbf_info, src_tmp, stride, qp, bs2_map,
+                filter_horizontal_edge(dbf_info, &segs, seg_idx, src_tmp, stride, qp, bs2_map,
                                        large_p_map, large_q_map, small_map,
                                        affine_p, affine_q, aff_edg_1);
 
@@ -1344,7 +1467,10 @@ vvc_dbf_ctu_ver(uint16_t *src, int stride, const struct DBFInfo *const dbf_info,
 
                 src_tmp += blk_stride;
                 qp_row++;
+                seg_idx++;
             } while(edg_msk);
+
+            dbf->luma_hor(src, stride, &segs);
         }
 
         src += stride << 2;
@@ -1352,18 +1478,10 @@ vvc_dbf_ctu_ver(uint16_t *src, int stride, const struct DBFInfo *const dbf_info,
 }
 
 #if 1
+/* Force transform_edges on implicit transform trees */
 void
-rcn_dbf_ctu(const struct OVRCNCtx  *const rcn_ctx, struct DBFInfo *const dbf_info,
-            uint8_t log2_ctu_s, uint8_t last_x, uint8_t last_y)
+rcn_dbf_implicit_edges(struct DBFInfo *const dbf_info)
 {
-    const struct OVBuffInfo *const fbuff = &rcn_ctx->frame_buff;
-
-    uint8_t nb_unit = (1 << log2_ctu_s) >> 2;
-    /* FIXME give as argument */
-    uint8_t ctu_lft = rcn_ctx->ctudec->ctu_ngh_flags & CTU_LFT_FLG;
-    uint8_t ctu_abv = rcn_ctx->ctudec->ctu_ngh_flags & CTU_UP_FLG;
-
-    /* Force transform_edges on implicit transform trees */
     uint64_t *edg_map_tab = &dbf_info->ctb_bound_ver_c[8];
     edg_map_tab[16] = -1ll;
     edg_map_tab = &dbf_info->ctb_bound_ver[8];
@@ -1376,20 +1494,34 @@ rcn_dbf_ctu(const struct OVRCNCtx  *const rcn_ctx, struct DBFInfo *const dbf_inf
     aff_edg_map[16] = -1ll;
     aff_edg_map = &dbf_info->aff_edg_ver[8];
     aff_edg_map[16] = -1ll;
+}
+
+void
+rcn_dbf_ctu(const struct OVRCNCtx  *const rcn_ctx, struct DBFInfo *const dbf_info,
+            uint8_t log2_ctu_s, uint8_t last_x, uint8_t last_y)
+{
+    const struct OVFrameBuffInfo *const fbuff = &rcn_ctx->frame_buff;
+    const struct DBFFunctions *const dbf = &rcn_ctx->rcn_funcs.dbf;
 
+    uint8_t nb_unit = (1 << log2_ctu_s) >> 2;
+    /* FIXME give as argument */
+    uint8_t ctu_lft = rcn_ctx->ctudec->ctu_ngh_flags & CTU_LFT_FLG;
+    uint8_t ctu_abv = rcn_ctx->ctudec->ctu_ngh_flags & CTU_UP_FLG;
+
+    rcn_dbf_implicit_edges(dbf_info);
 
     #if 1
     if (!dbf_info->disable_h)
-    vvc_dbf_ctu_hor(fbuff->y, fbuff->stride, dbf_info, nb_unit, !!last_y, nb_unit, ctu_lft);
+    vvc_dbf_ctu_hor(dbf, fbuff->y, fbuff->stride, dbf_info, nb_unit, !!last_y, nb_unit, ctu_lft);
     if (!dbf_info->disable_v)
-    vvc_dbf_ctu_ver(fbuff->y, fbuff->stride, dbf_info, nb_unit, !!last_x, nb_unit, ctu_abv);
+    vvc_dbf_ctu_ver(dbf, fbuff->y, fbuff->stride, dbf_info, nb_unit, !!last_x, nb_unit, ctu_abv);
 
     if (!dbf_info->disable_h)
-    vvc_dbf_chroma_hor(fbuff->cb, fbuff->cr, fbuff->stride_c, dbf_info,
+    vvc_dbf_chroma_hor(dbf, fbuff->cb, fbuff->cr, fbuff->stride_c, dbf_info,
                        nb_unit, !!last_y, nb_unit, ctu_lft);
 
     if (!dbf_info->disable_v)
-    vvc_dbf_chroma_ver(fbuff->cb, fbuff->cr, fbuff->stride_c, dbf_info,
+    vvc_dbf_chroma_ver(dbf, fbuff->cb, fbuff->cr, fbuff->stride_c, dbf_info,
                        nb_unit, !!last_x, nb_unit, !!last_y, ctu_abv);
                        #endif
 
@@ -1399,7 +1531,8 @@ void
 rcn_dbf_truncated_ctu(const struct OVRCNCtx  *const rcn_ctx, struct DBFInfo *const dbf_info,
                       uint8_t log2_ctu_s, uint8_t last_x, uint8_t last_y, uint8_t ctu_w, uint8_t ctu_h)
 {
-    const struct OVBuffInfo *const fbuff = &rcn_ctx->frame_buff;
+    const struct OVFrameBuffInfo *const fbuff = &rcn_ctx->frame_buff;
+    const struct DBFFunctions *const dbf = &rcn_ctx->rcn_funcs.dbf;
 
     uint8_t nb_unit_w = (ctu_w) >> 2;
     uint8_t nb_unit_h = (ctu_h) >> 2;
@@ -1409,19 +1542,28 @@ rcn_dbf_truncated_ctu(const struct OVRCNCtx  *const rcn_ctx, struct DBFInfo *con
 
     #if 1
     if (!dbf_info->disable_h)
-    vvc_dbf_ctu_hor(fbuff->y, fbuff->stride, dbf_info, nb_unit_h, !!last_y, nb_unit_w, ctu_lft);
+    vvc_dbf_ctu_hor(dbf, fbuff->y, fbuff->stride, dbf_info, nb_unit_h, !!last_y, nb_unit_w, ctu_lft);
     if (!dbf_info->disable_v)
-    vvc_dbf_ctu_ver(fbuff->y, fbuff->stride, dbf_info, nb_unit_w, !!last_x, nb_unit_h, ctu_abv);
+    vvc_dbf_ctu_ver(dbf, fbuff->y, fbuff->stride, dbf_info, nb_unit_w, !!last_x, nb_unit_h, ctu_abv);
 
     if (!dbf_info->disable_h)
-    vvc_dbf_chroma_hor(fbuff->cb, fbuff->cr, fbuff->stride_c, dbf_info,
+    vvc_dbf_chroma_hor(dbf, fbuff->cb, fbuff->cr, fbuff->stride_c, dbf_info,
                        nb_unit_h, !!last_y, nb_unit_w, ctu_lft);
 
     if (!dbf_info->disable_v)
-    vvc_dbf_chroma_ver(fbuff->cb, fbuff->cr, fbuff->stride_c, dbf_info,
+    vvc_dbf_chroma_ver(dbf, fbuff->cb, fbuff->cr, fbuff->stride_c, dbf_info,
                        nb_unit_w, !!last_x, nb_unit_h, !!last_y, ctu_abv);
                        #endif
 
 }
+
+void
+rcn_init_dbf_functions(struct RCNFunctions *const rcn_funcs)
+{
+    rcn_funcs->dbf.luma_ver   = &filter_luma_ver;
+    rcn_funcs->dbf.luma_hor   = &filter_luma_hor;
+    rcn_funcs->dbf.chroma_ver = &filter_chroma_ver;
+    rcn_funcs->dbf.chroma_hor = &filter_chroma_hor;
+}
 #endif
 
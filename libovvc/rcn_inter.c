@@ -31,7 +31,6 @@
 #define PROF_MV_SHIFT 8
 #define PROF_MV_RND (1 << (PROF_MV_SHIFT - 1))
 
-#define BITDEPTH 10
 #define PROF_SMP_SHIFT (14 - BITDEPTH)
 #define PROF_SMP_RND (1 << (14 - 1))
 #define PROF_SMP_OFFSET (1 << (PROF_SMP_SHIFT + 1) - 1)
@@ -75,8 +74,7 @@ struct OVDMV {
     int32_t y;
 };
 
-#define BIT_DEPTH 10
-#define ov_clip_pixel(a) ov_clip_uintp2(a, BIT_DEPTH)
+#define ov_clip_pixel(a) ov_clip_uintp2(a, BITDEPTH)
 
 enum CUMode {
     OV_NA = 0xFF,
@@ -85,13 +83,6 @@ enum CUMode {
     OV_INTER_SKIP = 3,
     OV_MIP = 4,
 };
-static void
-rcn_bdof(int16_t *dst, int dst_stride,
-         const int16_t *ref_bdof0, const int16_t *ref_bdof1, int ref_stride,
-         const int16_t *grad_x0, const int16_t *grad_y0,
-         const int16_t *grad_x1, const int16_t *grad_y1,
-         int grad_stride, uint8_t pb_w, uint8_t pb_h);
-
 static OVMV
 clip_mv(int pos_x, int pos_y, int pic_w, int pic_h, int pb_w, int pb_h, OVMV mv)
 {
@@ -170,7 +161,7 @@ rcn_prof(uint16_t* dst, int dst_stride, const uint16_t* src, int src_stride,
             /* Clipping if not bi directional */
             if (!bidir) {
                 val = (val + 8200 /*+ PROF_SMP_OFFSET*/) >> PROF_SMP_SHIFT;
-                dst[x] = ov_clip(val, 0, 1023);
+                dst[x] = ov_clip(val, 0, OV_SAMPLE_MAX);
             } else {
                 dst[x] = val + (1 << 13);
             }
@@ -189,12 +180,12 @@ rcn_prof(uint16_t* dst, int dst_stride, const uint16_t* src, int src_stride,
 /* FIXME check edge_emulation OK */
 
 static void
-extend_bdof_buff(const uint16_t *const src, uint16_t *dst_prof,
+extend_bdof_buff(const OVSample *const src, uint16_t *dst_prof,
                  int16_t ref_stride, int16_t pb_w, int16_t pb_h,
                  uint8_t ext_x, uint8_t ext_y)
 {
     int16_t tmp_prof_stride = 128;
-    const uint16_t *ref = src  - ref_stride  - 1;
+    const OVSample *ref = src  - ref_stride  - 1;
 
     uint16_t     *dst = dst_prof;
     uint16_t *dst_lst = dst_prof + (pb_h + 1) * tmp_prof_stride;
@@ -209,7 +200,7 @@ extend_bdof_buff(const uint16_t *const src, uint16_t *dst_prof,
         ref += ref_stride;
     }
 
-    const uint16_t *ref_lst = ref + (pb_h + 1) * ref_stride;
+    const OVSample *ref_lst = ref + (pb_h + 1) * ref_stride;
 
     /* Copy or extend upper and lower ref_line */
     for (i = 0; i < pb_w + 2; ++i) {
@@ -245,10 +236,10 @@ extend_bdof_buff(const uint16_t *const src, uint16_t *dst_prof,
 }
 
 static void
-extend_prof_buff(const uint16_t *const src, uint16_t *dst_prof, int16_t ref_stride, uint8_t ext_x, uint8_t ext_y)
+extend_prof_buff(const OVSample *const src, uint16_t *dst_prof, int16_t ref_stride, uint8_t ext_x, uint8_t ext_y)
 {
     int16_t tmp_prof_stride = (128);
-    const uint16_t *ref = src  - ref_stride  - 1;
+    const OVSample *ref = src  - ref_stride  - 1;
     uint16_t       *dst = dst_prof;
     uint16_t *dst_lst = dst_prof + (SB_H + 1) * tmp_prof_stride;
     int i, j;
@@ -262,7 +253,7 @@ extend_prof_buff(const uint16_t *const src, uint16_t *dst_prof, int16_t ref_stri
         ref += ref_stride;
     }
 
-    const uint16_t *ref_lst = ref + (SB_H + 1) * ref_stride;
+    const OVSample *ref_lst = ref + (SB_H + 1) * ref_stride;
 
     /* Copy or extend upper and lower ref_line */
     for (i = 0; i < SB_W + 2; ++i) {
@@ -341,7 +332,7 @@ extend_bdof_grad(uint16_t *dst_grad, int16_t grad_stride, int16_t pb_w, int16_t
 }
 
 static void
-emulate_block_border(uint16_t *buf, const uint16_t *src,
+emulate_block_border(OVSample *buf, const OVSample *src,
                      ptrdiff_t buf_linesize,
                      ptrdiff_t src_linesize,
                      int block_w, int block_h,
@@ -383,13 +374,13 @@ emulate_block_border(uint16_t *buf, const uint16_t *src,
 
     // top
     for (y = 0; y < start_y; y++) {
-        memcpy(buf, src, w * sizeof(uint16_t));
+        memcpy(buf, src, w * sizeof(OVSample));
         buf += buf_linesize;
     }
 
     // copy existing part
     for (; y < end_y; y++) {
-        memcpy(buf, src, w * sizeof(uint16_t));
+        memcpy(buf, src, w * sizeof(OVSample));
         src += src_linesize;
         buf += buf_linesize;
     }
@@ -397,14 +388,14 @@ emulate_block_border(uint16_t *buf, const uint16_t *src,
     // bottom
     src -= src_linesize;
     for (; y < block_h; y++) {
-        memcpy(buf, src, w * sizeof(uint16_t));
+        memcpy(buf, src, w * sizeof(OVSample));
         buf += buf_linesize;
     }
 
     buf -= block_h * buf_linesize + start_x;
 
     while (block_h--) {
-        uint16_t *bufp = (uint16_t *) buf;
+        OVSample *bufp = buf;
 
         // left
         for(x = 0; x < start_x; x++) {
@@ -419,47 +410,45 @@ emulate_block_border(uint16_t *buf, const uint16_t *src,
     }
 }
 
+/* Samples outside of the picture are read from the frame margins
+ * filled with border samples once reference CTU lines are decoded,
+ * edge emulation is only required when reads go past the margins
+ */
 static uint8_t
 test_for_edge_emulation_c(int pb_x, int pb_y, int pic_w, int pic_h,
-                          int pb_w, int pb_h)
+                          int pb_w, int pb_h, int margin)
 {
     uint8_t emulate_edge = 0;
-    emulate_edge  =      pb_x - REF_PADDING_C < 0;
-    emulate_edge |= 2 * (pb_y - REF_PADDING_C < 0);
-    emulate_edge |= 4 * (pb_x >= pic_w);
-    emulate_edge |= 8 * (pb_y >= pic_h);
-    emulate_edge |= 4 * ((pb_x + pb_w + EPEL_EXTRA_AFTER) >= pic_w);
-    emulate_edge |= 8 * ((pb_y + pb_h + EPEL_EXTRA_AFTER) >= pic_h);
+    emulate_edge  =      pb_x - REF_PADDING_C < -margin;
+    emulate_edge |= 2 * (pb_y - REF_PADDING_C < -margin);
+    emulate_edge |= 4 * ((pb_x + pb_w + EPEL_EXTRA_AFTER) >= pic_w + margin);
+    emulate_edge |= 8 * ((pb_y + pb_h + EPEL_EXTRA_AFTER) >= pic_h + margin);
     return emulate_edge;
 }
 
 static uint8_t
 test_for_edge_emulation(int pb_x, int pb_y, int pic_w, int pic_h,
-                        int pu_w, int pu_h)
+                        int pu_w, int pu_h, int margin)
 {
-    /* FIXME thi could be simplified */
     uint8_t emulate_edge = 0;
-    emulate_edge =       pb_x - REF_PADDING_L < 0;
-    emulate_edge |= 2 * (pb_y - REF_PADDING_L < 0);
-
-    emulate_edge |= 4 * (pb_x >= pic_w);
-    emulate_edge |= 8 * (pb_y >= pic_h);
+    emulate_edge =       pb_x - REF_PADDING_L < -margin;
+    emulate_edge |= 2 * (pb_y - REF_PADDING_L < -margin);
 
-    emulate_edge |= 4 * ((pb_x + pu_w + QPEL_EXTRA_AFTER) >= pic_w);
-    emulate_edge |= 8 * ((pb_y + pu_h + QPEL_EXTRA_AFTER) >= pic_h);
+    emulate_edge |= 4 * ((pb_x + pu_w + QPEL_EXTRA_AFTER) >= pic_w + margin);
+    emulate_edge |= 8 * ((pb_y + pu_h + QPEL_EXTRA_AFTER) >= pic_h + margin);
     return emulate_edge;
 }
 
-static struct OVBuffInfo
+static struct OVFrameBuffInfo
 derive_ref_buf_c(const OVPicture *const ref_pic, OVMV mv, int pos_x, int pos_y,
-                 uint16_t *edge_buff0, uint16_t *edge_buff1,
+                 OVSample *edge_buff0, OVSample *edge_buff1,
                  int log2_pu_w, int log2_pu_h, int log2_ctu_s)
 {
-    struct OVBuffInfo ref_buff;
-    uint16_t *const ref_cb  = (uint16_t *) ref_pic->frame->data[1];
-    uint16_t *const ref_cr  = (uint16_t *) ref_pic->frame->data[2];
+    struct OVFrameBuffInfo ref_buff;
+    OVSample *const ref_cb  = (OVSample *) ref_pic->frame->data[1];
+    OVSample *const ref_cr  = (OVSample *) ref_pic->frame->data[2];
 
-    int src_stride = ref_pic->frame->linesize[1] >> 1;
+    int src_stride = ref_pic->frame->linesize[1] / sizeof(OVSample);
 
     /*FIXME check buff side derivation */
     int ref_pos_x = pos_x + (mv.x >> 5);
@@ -471,11 +460,11 @@ derive_ref_buf_c(const OVPicture *const ref_pic, OVMV mv, int pos_x, int pos_y,
     const int pic_w = ref_pic->frame->width[0]  >> 1;
     const int pic_h = ref_pic->frame->height[0] >> 1;
 
-    uint16_t *src_cb  = &ref_cb[ref_pos_x + ref_pos_y * src_stride];
-    uint16_t *src_cr  = &ref_cr[ref_pos_x + ref_pos_y * src_stride];
+    OVSample *src_cb  = &ref_cb[ref_pos_x + ref_pos_y * src_stride];
+    OVSample *src_cr  = &ref_cr[ref_pos_x + ref_pos_y * src_stride];
 
     uint8_t emulate_edge = test_for_edge_emulation_c(ref_pos_x, ref_pos_y, pic_w, pic_h,
-                                                     pu_w, pu_h);;
+                                                     pu_w, pu_h, ref_pic->frame->margin[1]);
 
     if (emulate_edge){
         int src_off  = REF_PADDING_C * (src_stride) + (REF_PADDING_C);
@@ -561,14 +550,14 @@ padd_dmvr(int16_t *const _ref, int16_t stride, uint8_t pu_w, uint8_t pu_h)
     memcpy(ref + 2 * stride, ref, sizeof(*ref) * (pu_w + QPEL_EXTRA + 4));
 }
 
-static struct OVBuffInfo
+static struct OVFrameBuffInfo
 derive_ref_buf_y(OVPicture *const ref_pic, OVMV mv, int pos_x, int pos_y,
-                uint16_t *edge_buff, int log2_pu_w, int log2_pu_h, int log2_ctu_s)
+                OVSample *edge_buff, int log2_pu_w, int log2_pu_h, int log2_ctu_s)
 {
-    struct OVBuffInfo ref_buff;
-    uint16_t *const ref_y  = (uint16_t *) ref_pic->frame->data[0];
+    struct OVFrameBuffInfo ref_buff;
+    OVSample *const ref_y  = (OVSample *) ref_pic->frame->data[0];
 
-    int src_stride = ref_pic->frame->linesize[0] >> 1;
+    int src_stride = ref_pic->frame->linesize[0] / sizeof(OVSample);
 
     int ref_pos_x = pos_x + (mv.x >> 4);
     int ref_pos_y = pos_y + (mv.y >> 4);
@@ -580,14 +569,14 @@ derive_ref_buf_y(OVPicture *const ref_pic, OVMV mv, int pos_x, int pos_y,
     const int pic_h = ref_pic->frame->height[0];
 
     uint8_t emulate_edge = test_for_edge_emulation(ref_pos_x, ref_pos_y, pic_w, pic_h,
-                                                   pu_w, pu_h);;
+                                                   pu_w, pu_h, ref_pic->frame->margin[0]);
 
     /*Frame thread synchronization to ensure data is available
      */
     rcn_inter_synchronization(ref_pic, ref_pos_x, ref_pos_y, pu_w, pu_h, log2_ctu_s);
 
     if (emulate_edge){
-        const uint16_t *src_y  = &ref_y[ref_pos_x + ref_pos_y * src_stride];
+        const OVSample *src_y  = &ref_y[ref_pos_x + ref_pos_y * src_stride];
         int src_off  = REF_PADDING_L * (src_stride) + (REF_PADDING_L);
         int buff_off = REF_PADDING_L * (RCN_CTB_STRIDE) + (REF_PADDING_L);
         int cpy_w = pu_w + QPEL_EXTRA;
@@ -612,24 +601,24 @@ derive_ref_buf_y(OVPicture *const ref_pic, OVMV mv, int pos_x, int pos_y,
     return ref_buff;
 }
 
-static struct OVBuffInfo
+static struct OVFrameBuffInfo
 derive_dmvr_ref_buf_y(const OVPicture *const ref_pic, OVMV mv, int pos_x, int pos_y,
-                      uint16_t *edge_buff, int pu_w, int pu_h, int log2_ctu_s)
+                      OVSample *edge_buff, int pu_w, int pu_h, int log2_ctu_s)
 {
-    struct OVBuffInfo ref_buff;
-    uint16_t *const ref_y  = (uint16_t *) ref_pic->frame->data[0];
+    struct OVFrameBuffInfo ref_buff;
+    OVSample *const ref_y  = (OVSample *) ref_pic->frame->data[0];
 
     const int pic_w = ref_pic->frame->width[0];
     const int pic_h = ref_pic->frame->height[0];
 
-    int src_stride = ref_pic->frame->linesize[0] >> 1;
+    int src_stride = ref_pic->frame->linesize[0] / sizeof(OVSample);
 
     OVMV mv_clipped = clip_mv(pos_x, pos_y, pic_w, pic_h, pu_w, pu_h, mv);
 
     int ref_pos_x = pos_x + (mv_clipped.x >> 4);
     int ref_pos_y = pos_y + (mv_clipped.y >> 4);
 
-    const uint16_t *src_y = &ref_y[ref_pos_x + ref_pos_y * src_stride];
+    const OVSample *src_y = &ref_y[ref_pos_x + ref_pos_y * src_stride];
 
     int src_off  = (REF_PADDING_L * src_stride) + (REF_PADDING_L);
     int buff_off = (REF_PADDING_L * RCN_CTB_STRIDE) + (REF_PADDING_L);
@@ -655,26 +644,26 @@ derive_dmvr_ref_buf_y(const OVPicture *const ref_pic, OVMV mv, int pos_x, int po
     return ref_buff;
 }
 
-static struct OVBuffInfo
+static struct OVFrameBuffInfo
 derive_dmvr_ref_buf_c(const OVPicture *const ref_pic, OVMV mv, int pos_x, int pos_y,
-                      uint16_t *edge_buff0, uint16_t *edge_buff1, int pu_w, int pu_h)
+                      OVSample *edge_buff0, OVSample *edge_buff1, int pu_w, int pu_h)
 {
-    struct OVBuffInfo ref_buff;
-    uint16_t *const ref_cb  = (uint16_t *) ref_pic->frame->data[1];
-    uint16_t *const ref_cr  = (uint16_t *) ref_pic->frame->data[2];
+    struct OVFrameBuffInfo ref_buff;
+    OVSample *const ref_cb  = (OVSample *) ref_pic->frame->data[1];
+    OVSample *const ref_cr  = (OVSample *) ref_pic->frame->data[2];
 
     const int pic_w = ref_pic->frame->width[1];
     const int pic_h = ref_pic->frame->height[1];
 
-    int src_stride = ref_pic->frame->linesize[1] >> 1;
+    int src_stride = ref_pic->frame->linesize[1] / sizeof(OVSample);
 
     OVMV mv_clipped = clip_mv(pos_x << 1, pos_y << 1, pic_w << 1, pic_h << 1, pu_w << 1, pu_h << 1, mv);
 
     int ref_pos_x = pos_x + (mv_clipped.x >> 5);
     int ref_pos_y = pos_y + (mv_clipped.y >> 5);
 
-    const uint16_t *src_cb = &ref_cb[ref_pos_x + ref_pos_y * src_stride];
-    const uint16_t *src_cr = &ref_cr[ref_pos_x + ref_pos_y * src_stride];
+    const OVSample *src_cb = &ref_cb[ref_pos_x + ref_pos_y * src_stride];
+    const OVSample *src_cr = &ref_cr[ref_pos_x + ref_pos_y * src_stride];
 
     int src_off  = (REF_PADDING_C * src_stride) + (REF_PADDING_C);
     int buff_off = (REF_PADDING_C * RCN_CTB_STRIDE) + (REF_PADDING_C);
@@ -726,10 +715,10 @@ rcn_motion_compensation_b(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     /* TMP buffers for edge emulation
      * FIXME use tmp buffers in local contexts
      */
-    uint16_t edge_buff0[RCN_CTB_SIZE];
-    uint16_t edge_buff1[RCN_CTB_SIZE];
-    uint16_t edge_buff0_1[RCN_CTB_SIZE];
-    uint16_t edge_buff1_1[RCN_CTB_SIZE];
+    OVSample edge_buff0[RCN_CTB_SIZE];
+    OVSample edge_buff1[RCN_CTB_SIZE];
+    OVSample edge_buff0_1[RCN_CTB_SIZE];
+    OVSample edge_buff1_1[RCN_CTB_SIZE];
     int16_t tmp_buff[RCN_CTB_SIZE];
 
     /*FIXME we suppose here both refs possess the same size*/
@@ -748,10 +737,10 @@ rcn_motion_compensation_b(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     mv1 = clip_mv(pos_x, pos_y, ref1->frame->width[0],
                   ref1->frame->height[0], 1 << log2_pu_w, 1 << log2_pu_h, mv1);
 
-    struct OVBuffInfo ref0_b = derive_ref_buf_y(ref0, mv0, pos_x, pos_y, edge_buff0,
+    struct OVFrameBuffInfo ref0_b = derive_ref_buf_y(ref0, mv0, pos_x, pos_y, edge_buff0,
                                                       log2_pu_w, log2_pu_h, log2_ctb_s);
 
-    struct OVBuffInfo ref1_b = derive_ref_buf_y(ref1, mv1, pos_x, pos_y, edge_buff1,
+    struct OVFrameBuffInfo ref1_b = derive_ref_buf_y(ref1, mv1, pos_x, pos_y, edge_buff1,
                                                       log2_pu_w, log2_pu_h, log2_ctb_s);
 
     const int pu_w = 1 << log2_pu_w;
@@ -784,19 +773,19 @@ rcn_motion_compensation_b(OVCTUDec *const ctudec, struct OVBuffInfo dst,
         wt1 = bcw_weights[mv0.bcw_idx_plus1-1];
         wt0 = 8 - wt1;
         int denom = 2;
-        mc_l->bidir_w[prec_1_mc_type][log2_pu_w - 1]((uint8_t*)dst.y, RCN_CTB_STRIDE<<1, (uint8_t*)ref1_b.y, ref1_b.stride<<1, 
+        mc_l->bidir_w[prec_1_mc_type][log2_pu_w - 1]((uint8_t*)dst.y, RCN_CTB_STRIDE<<1, (uint8_t*)ref1_b.y, ref1_b.stride * sizeof(OVSample), 
                                                         tmp_buff,  MAX_PB_SIZE, pu_h, denom, wt0, wt1, 
                                                         prec_x1, prec_y1, pu_w);  
     }
 
     rcn_ctx->rcn_funcs.lmcs_reshape(dst.y, RCN_CTB_STRIDE, ctudec->lmcs_info.lmcs_lut_fwd_luma, pu_w, pu_h);
 
-    const struct OVBuffInfo ref0_c = derive_ref_buf_c(ref0, mv0,
+    const struct OVFrameBuffInfo ref0_c = derive_ref_buf_c(ref0, mv0,
                                                       pos_x >> 1, pos_y >> 1,
                                                       edge_buff0, edge_buff0_1,
                                                       log2_pu_w, log2_pu_h, log2_ctb_s);
 
-    const struct OVBuffInfo ref1_c = derive_ref_buf_c(ref1, mv1,
+    const struct OVFrameBuffInfo ref1_c = derive_ref_buf_c(ref1, mv1,
                                                       pos_x >> 1, pos_y >> 1,
                                                       edge_buff1, edge_buff1_1,
                                                       log2_pu_w, log2_pu_h, log2_ctb_s);
@@ -821,10 +810,10 @@ rcn_motion_compensation_b(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     }
     else{
         int denom = 2;
-        mc_c->bidir_w[prec_1_mc_type][log2_pu_w - 1]((uint8_t*)dst.cb, RCN_CTB_STRIDE<<1, (uint8_t*)ref1_c.cb, ref1_c.stride_c<<1, 
+        mc_c->bidir_w[prec_1_mc_type][log2_pu_w - 1]((uint8_t*)dst.cb, RCN_CTB_STRIDE<<1, (uint8_t*)ref1_c.cb, ref1_c.stride_c * sizeof(OVSample), 
                                                     ref_data0,  MAX_PB_SIZE, pu_h >> 1, denom, wt0, wt1, 
                                                     prec_x1, prec_y1, pu_w >> 1);
-        mc_c->bidir_w[prec_1_mc_type][log2_pu_w - 1]((uint8_t*)dst.cr, RCN_CTB_STRIDE<<1, (uint8_t*)ref1_c.cr, ref1_c.stride_c<<1, 
+        mc_c->bidir_w[prec_1_mc_type][log2_pu_w - 1]((uint8_t*)dst.cr, RCN_CTB_STRIDE<<1, (uint8_t*)ref1_c.cr, ref1_c.stride_c * sizeof(OVSample), 
                                                         ref_data1,  MAX_PB_SIZE, pu_h >> 1, denom, wt0, wt1, 
                                                         prec_x1, prec_y1, pu_w >> 1);
     }
@@ -853,8 +842,8 @@ rcn_motion_compensation_b_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     /* TMP buffers for edge emulation
      * FIXME use tmp buffers in local contexts
      */
-    uint16_t edge_buff0[RCN_CTB_SIZE];
-    uint16_t edge_buff1[RCN_CTB_SIZE];
+    OVSample edge_buff0[RCN_CTB_SIZE];
+    OVSample edge_buff1[RCN_CTB_SIZE];
     int16_t tmp_buff[RCN_CTB_SIZE];
 
     /*FIXME we suppose here both refs possess the same size*/
@@ -874,10 +863,10 @@ rcn_motion_compensation_b_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
                   ref1->frame->height[0], 1 << log2_pu_w, 1 << log2_pu_h, mv1);
 
 
-    struct OVBuffInfo ref0_b = derive_ref_buf_y(ref0, mv0, pos_x, pos_y, edge_buff0,
+    struct OVFrameBuffInfo ref0_b = derive_ref_buf_y(ref0, mv0, pos_x, pos_y, edge_buff0,
                                                 log2_pu_w, log2_pu_h, log2_ctb_s);
 
-    struct OVBuffInfo ref1_b = derive_ref_buf_y(ref1, mv1, pos_x, pos_y, edge_buff1,
+    struct OVFrameBuffInfo ref1_b = derive_ref_buf_y(ref1, mv1, pos_x, pos_y, edge_buff1,
                                                 log2_pu_w, log2_pu_h, log2_ctb_s);
 
     const int pu_w = 1 << log2_pu_w;
@@ -910,7 +899,7 @@ rcn_motion_compensation_b_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
         wt1 = bcw_weights[mv0.bcw_idx_plus1-1];
         wt0 = 8 - wt1;
         int denom = 2;
-        mc_l->bidir_w[prec_1_mc_type][log2_pu_w - 1]((uint8_t*)dst.y, RCN_CTB_STRIDE<<1, (uint8_t*)ref1_b.y, ref1_b.stride<<1, 
+        mc_l->bidir_w[prec_1_mc_type][log2_pu_w - 1]((uint8_t*)dst.y, RCN_CTB_STRIDE<<1, (uint8_t*)ref1_b.y, ref1_b.stride * sizeof(OVSample), 
                                                         tmp_buff,  MAX_PB_SIZE, pu_h, denom, wt0, wt1, 
                                                         prec_x1, prec_y1, pu_w); 
     }
@@ -1114,12 +1103,14 @@ rcn_dmvr_mv_refine(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     struct InterDRVCtx *const inter_ctx = &ctudec->drv_ctx.inter_ctx;
     struct OVRCNCtx    *const rcn_ctx   = &ctudec->rcn_ctx;
     struct MCFunctions *mc_l = &rcn_ctx->rcn_funcs.mc_l;
+    const struct DMVRFunctions *dmvr = &rcn_ctx->rcn_funcs.dmvr;
+    const struct BDOFFunctions *bdof = &rcn_ctx->rcn_funcs.bdof;
 
     OVPicture *ref0 = inter_ctx->rpl0[ref_idx0];
     OVPicture *ref1 = inter_ctx->rpl1[ref_idx1];
 
-    uint16_t edge_buff0[RCN_CTB_SIZE];
-    uint16_t edge_buff1[RCN_CTB_SIZE];
+    OVSample edge_buff0[RCN_CTB_SIZE];
+    OVSample edge_buff1[RCN_CTB_SIZE];
 
     /*FIXME permit smaller stride to reduce tables */
     int16_t ref_dmvr0[(16 + 2 * DMVR_REF_PADD) * (128 + 2 * DMVR_REF_PADD)] = {0};
@@ -1136,10 +1127,10 @@ rcn_dmvr_mv_refine(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     OVMV tmp0 = *mv0;
     OVMV tmp1 = *mv1;
 
-    struct OVBuffInfo ref0_b = derive_dmvr_ref_buf_y(ref0, *mv0, pos_x, pos_y, edge_buff0,
+    struct OVFrameBuffInfo ref0_b = derive_dmvr_ref_buf_y(ref0, *mv0, pos_x, pos_y, edge_buff0,
                                                      pu_w, pu_h, ctudec->part_ctx->log2_ctu_s);
 
-    struct OVBuffInfo ref1_b = derive_dmvr_ref_buf_y(ref1, *mv1, pos_x, pos_y, edge_buff1,
+    struct OVFrameBuffInfo ref1_b = derive_dmvr_ref_buf_y(ref1, *mv1, pos_x, pos_y, edge_buff1,
                                                      pu_w, pu_h, ctudec->part_ctx->log2_ctu_s);
 
     uint8_t prec_x0 = (mv0->x) & 0xF;
@@ -1166,18 +1157,18 @@ rcn_dmvr_mv_refine(OVCTUDec *const ctudec, struct OVBuffInfo dst,
                                    prec_x1, prec_y1, pu_w + 4);
 
     /* Compute SAD on center part */
-    dmvr_sad = rcn_dmvr_sad(ref_dmvr0 + 2 + 2 * dmvr_stride,
-                            ref_dmvr1 + 2 + 2 * dmvr_stride,
-                            dmvr_stride, pu_w, pu_h);
+    dmvr_sad = dmvr->sad(ref_dmvr0 + 2 + 2 * dmvr_stride,
+                         ref_dmvr1 + 2 + 2 * dmvr_stride,
+                         dmvr_stride, pu_w, pu_h);
 
     min_cost = (dmvr_sad - (dmvr_sad >> 2));
 
     /* skip MV refinement if cost is small or zero */
     if (min_cost >= (pu_w * pu_h)) {
         uint64_t sad[25];
-        uint8_t dmvr_idx = dmvr_compute_sads(ref_dmvr0 + 2 + 2 * dmvr_stride,
-                                             ref_dmvr1 + 2 + 2 * dmvr_stride,
-                                             sad, pu_w, pu_h);
+        uint8_t dmvr_idx = dmvr->sads(ref_dmvr0 + 2 + 2 * dmvr_stride,
+                                      ref_dmvr1 + 2 + 2 * dmvr_stride,
+                                      sad, pu_w, pu_h);
 
         int32_t delta_h = dmvr_mv_x[dmvr_idx] << 4;
         int32_t delta_v = dmvr_mv_y[dmvr_idx] << 4;
@@ -1271,11 +1262,11 @@ rcn_dmvr_mv_refine(OVCTUDec *const ctudec, struct OVBuffInfo dst,
         extend_bdof_buff(ref0_b.y, (uint16_t*)tmp_buff, ref0_b.stride, pu_w, pu_h, prec_x0 >> 3, prec_y0 >> 3);
         extend_bdof_buff(ref1_b.y, (uint16_t*)tmp_buff1, ref1_b.stride, pu_w, pu_h, prec_x1 >> 3, prec_y1 >> 3);
 
-        compute_prof_grad((uint16_t *)tmp_buff, ref_stride, pu_w, pu_h, grad_stride,
-                          grad_x0 + grad_stride + 1, grad_y0 + grad_stride + 1);
+        bdof->grad((uint16_t *)tmp_buff, ref_stride, pu_w, pu_h, grad_stride,
+                   grad_x0 + grad_stride + 1, grad_y0 + grad_stride + 1);
 
-        compute_prof_grad((uint16_t *)tmp_buff1, ref_stride, pu_w, pu_h, grad_stride,
-                          grad_x1 + grad_stride + 1, grad_y1 + grad_stride + 1);
+        bdof->grad((uint16_t *)tmp_buff1, ref_stride, pu_w, pu_h, grad_stride,
+                   grad_x1 + grad_stride + 1, grad_y1 + grad_stride + 1);
 
         /* Grad padding */
         extend_bdof_grad((uint16_t *)grad_x0, grad_stride, pu_w, pu_h);
@@ -1288,9 +1279,9 @@ rcn_dmvr_mv_refine(OVCTUDec *const ctudec, struct OVBuffInfo dst,
         extend_bdof_grad((uint16_t *)tmp_buff1, ref_stride, pu_w, pu_h);
 
         /* Split into 4x4 subblocks for BDOF computation */
-        rcn_bdof((int16_t *)dst.y, dst.stride, tmp_buff + 128 + 1, tmp_buff1 + 128 + 1,
-                 ref_stride, grad_x0, grad_y0, grad_x1, grad_y1,
-                 grad_stride, pu_w, pu_h);
+        bdof->subblocks((int16_t *)dst.y, dst.stride, tmp_buff + 128 + 1, tmp_buff1 + 128 + 1,
+                        ref_stride, grad_x0, grad_y0, grad_x1, grad_y1,
+                        grad_stride, pu_w, pu_h);
 
     }
 
@@ -1304,17 +1295,17 @@ rcn_dmvr_mv_refine(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     dst.cr += (x0 >> 1) + (y0 >> 1) * dst.stride_c;
 
     struct MCFunctions *mc_c = &rcn_ctx->rcn_funcs.mc_c;
-    //uint16_t *edge_buff0_1 = edge_buff0 + 24 * RCN_CTB_STRIDE;
-    //uint16_t *edge_buff1_1 = edge_buff1 + 24 * RCN_CTB_STRIDE;
-    uint16_t edge_buff0_1[RCN_CTB_SIZE];
-    uint16_t edge_buff1_1[RCN_CTB_SIZE];
+    //OVSample *edge_buff0_1 = edge_buff0 + 24 * RCN_CTB_STRIDE;
+    //OVSample *edge_buff1_1 = edge_buff1 + 24 * RCN_CTB_STRIDE;
+    OVSample edge_buff0_1[RCN_CTB_SIZE];
+    OVSample edge_buff1_1[RCN_CTB_SIZE];
 
-    struct OVBuffInfo ref0_c = derive_dmvr_ref_buf_c(ref0, tmp0,
+    struct OVFrameBuffInfo ref0_c = derive_dmvr_ref_buf_c(ref0, tmp0,
                                                      pos_x >> 1, pos_y >> 1,
                                                      edge_buff0, edge_buff0_1,
                                                      pu_w >> 1, pu_h >> 1);
 
-    struct OVBuffInfo ref1_c = derive_dmvr_ref_buf_c(ref1, tmp1,
+    struct OVFrameBuffInfo ref1_c = derive_dmvr_ref_buf_c(ref1, tmp1,
                                                      pos_x >> 1, pos_y >> 1,
                                                      edge_buff1, edge_buff1_1,
                                                      pu_w >> 1, pu_h >> 1);
@@ -1445,10 +1436,10 @@ rcn_apply_bdof_subblock(const int16_t* src0, int src0_stride,
             val2 = (int16_t)((src0[2] + src1[2] + b2 + BDOF_OFFSET) >> BDOF_SHIFT);
             val3 = (int16_t)((src0[3] + src1[3] + b3 + BDOF_OFFSET) >> BDOF_SHIFT);
 
-            dst[0] = ov_clip(val0, 0, 1023);
-            dst[1] = ov_clip(val1, 0, 1023);
-            dst[2] = ov_clip(val2, 0, 1023);
-            dst[3] = ov_clip(val3, 0, 1023);
+            dst[0] = ov_clip(val0, 0, OV_SAMPLE_MAX);
+            dst[1] = ov_clip(val1, 0, OV_SAMPLE_MAX);
+            dst[2] = ov_clip(val2, 0, OV_SAMPLE_MAX);
+            dst[3] = ov_clip(val3, 0, OV_SAMPLE_MAX);
         #if 0
         }
         #endif
@@ -1619,6 +1610,7 @@ rcn_bdof_mcp_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     struct OVRCNCtx    *const rcn_ctx   = &ctudec->rcn_ctx;
     const struct InterDRVCtx *const inter_ctx = &ctudec->drv_ctx.inter_ctx;
     struct MCFunctions *mc_l = &rcn_ctx->rcn_funcs.mc_l;
+    const struct BDOFFunctions *bdof = &rcn_ctx->rcn_funcs.bdof;
     /* FIXME derive ref_idx */
     uint8_t ref_idx_0 = ref_idx0;
     uint8_t ref_idx_1 = ref_idx1;
@@ -1629,8 +1621,8 @@ rcn_bdof_mcp_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     /* TMP buffers for edge emulation
      * FIXME use tmp buffers in local contexts
      */
-    uint16_t edge_buff0[RCN_CTB_SIZE];
-    uint16_t edge_buff1[RCN_CTB_SIZE];
+    OVSample edge_buff0[RCN_CTB_SIZE];
+    OVSample edge_buff1[RCN_CTB_SIZE];
 
     /*FIXME we suppose here both refs possess the same size*/
 
@@ -1649,10 +1641,10 @@ rcn_bdof_mcp_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
                   ref1->frame->height[0], 1 << log2_pu_w, 1 << log2_pu_h, mv1);
 
 
-    struct OVBuffInfo ref0_b = derive_ref_buf_y(ref0, mv0, pos_x, pos_y, edge_buff0,
+    struct OVFrameBuffInfo ref0_b = derive_ref_buf_y(ref0, mv0, pos_x, pos_y, edge_buff0,
                                                       log2_pu_w, log2_pu_h, log2_ctb_s);
 
-    struct OVBuffInfo ref1_b = derive_ref_buf_y(ref1, mv1, pos_x, pos_y, edge_buff1,
+    struct OVFrameBuffInfo ref1_b = derive_ref_buf_y(ref1, mv1, pos_x, pos_y, edge_buff1,
                                                       log2_pu_w, log2_pu_h, log2_ctb_s);
 
     const int pu_w = 1 << log2_pu_w;
@@ -1699,11 +1691,11 @@ rcn_bdof_mcp_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     extend_bdof_buff(ref0_b.y, (uint16_t *)ref_bdof0, ref0_b.stride, pb_w, pb_h, prec_x0 >> 3, prec_y0 >> 3);
     extend_bdof_buff(ref1_b.y, (uint16_t *)ref_bdof1, ref1_b.stride, pb_w, pb_h, prec_x1 >> 3, prec_y1 >> 3);
 
-    compute_prof_grad((uint16_t *)ref_bdof0, ref_stride, pb_w, pb_h, grad_stride,
-                      grad_x0 + grad_stride + 1, grad_y0 + grad_stride + 1);
+    bdof->grad((uint16_t *)ref_bdof0, ref_stride, pb_w, pb_h, grad_stride,
+               grad_x0 + grad_stride + 1, grad_y0 + grad_stride + 1);
 
-    compute_prof_grad((uint16_t *)ref_bdof1, ref_stride, pb_w, pb_h, grad_stride,
-                      grad_x1 + grad_stride + 1, grad_y1 + grad_stride + 1);
+    bdof->grad((uint16_t *)ref_bdof1, ref_stride, pb_w, pb_h, grad_stride,
+               grad_x1 + grad_stride + 1, grad_y1 + grad_stride + 1);
 
     /* Grad padding */
     extend_bdof_grad((uint16_t *)grad_x0, grad_stride, pb_w, pb_h);
@@ -1718,9 +1710,9 @@ rcn_bdof_mcp_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     dst.y += y0 * RCN_CTB_STRIDE;
 
     /* Split into 4x4 subblocks for BDOF computation */
-    rcn_bdof((int16_t *)dst.y, dst.stride, ref_bdof0 + 128 + 1, ref_bdof1 + 128 + 1,
-             ref_stride, grad_x0, grad_y0, grad_x1, grad_y1,
-             grad_stride, pb_w, pb_h);
+    bdof->subblocks((int16_t *)dst.y, dst.stride, ref_bdof0 + 128 + 1, ref_bdof1 + 128 + 1,
+                    ref_stride, grad_x0, grad_y0, grad_x1, grad_y1,
+                    grad_stride, pb_w, pb_h);
 
     rcn_ctx->rcn_funcs.lmcs_reshape(dst.y, RCN_CTB_STRIDE,
                                   ctudec->lmcs_info.lmcs_lut_fwd_luma,
@@ -1738,6 +1730,7 @@ rcn_prof_motion_compensation_b_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     struct OVRCNCtx    *const rcn_ctx   = &ctudec->rcn_ctx;
     const struct InterDRVCtx *const inter_ctx = &ctudec->drv_ctx.inter_ctx;
     struct MCFunctions *mc_l = &rcn_ctx->rcn_funcs.mc_l;
+    const struct PROFFunctions *prof = &rcn_ctx->rcn_funcs.prof;
     /* FIXME derive ref_idx */
     uint8_t ref_idx_0 = ref_idx0;
     uint8_t ref_idx_1 = ref_idx1;
@@ -1751,8 +1744,8 @@ rcn_prof_motion_compensation_b_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     /* TMP buffers for edge emulation
      * FIXME use tmp buffers in local contexts
      */
-    uint16_t edge_buff0[RCN_CTB_SIZE];
-    uint16_t edge_buff1[RCN_CTB_SIZE];
+    OVSample edge_buff0[RCN_CTB_SIZE];
+    OVSample edge_buff1[RCN_CTB_SIZE];
     int16_t tmp_buff[RCN_CTB_SIZE];
     int16_t tmp_buff1[RCN_CTB_SIZE];
 
@@ -1773,10 +1766,10 @@ rcn_prof_motion_compensation_b_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
                   ref1->frame->height[0], 1 << log2_pu_w, 1 << log2_pu_h, mv1);
 
 
-    const struct OVBuffInfo ref0_b = derive_ref_buf_y(ref0, mv0, pos_x, pos_y, edge_buff0,
+    const struct OVFrameBuffInfo ref0_b = derive_ref_buf_y(ref0, mv0, pos_x, pos_y, edge_buff0,
                                                       log2_pu_w, log2_pu_h, log2_ctb_s);
 
-    const struct OVBuffInfo ref1_b = derive_ref_buf_y(ref1, mv1, pos_x, pos_y, edge_buff1,
+    const struct OVFrameBuffInfo ref1_b = derive_ref_buf_y(ref1, mv1, pos_x, pos_y, edge_buff1,
                                                       log2_pu_w, log2_pu_h, log2_ctb_s);
 
     const int pu_w = 1 << log2_pu_w;
@@ -1810,10 +1803,10 @@ rcn_prof_motion_compensation_b_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
 
         extend_prof_buff(ref0_b.y, (uint16_t *)tmp_prof, ref0_b.stride, prec_x0 >> 3, prec_y0 >> 3);
 
-        compute_prof_grad((uint16_t *)tmp_prof, tmp_prof_stride, SB_W, SB_H, 4, tmp_grad_x, tmp_grad_y);
+        prof->grad((uint16_t *)tmp_prof, tmp_prof_stride, SB_W, SB_H, 4, tmp_grad_x, tmp_grad_y);
 
-        rcn_prof((uint16_t *)tmp_buff, MAX_PB_SIZE, (uint16_t *)tmp_prof + 128 + 1, tmp_prof_stride, tmp_grad_x, tmp_grad_y,
-                 4, prof_info->dmv_scale_h_0, prof_info->dmv_scale_v_0, 1);
+        prof->func((uint16_t *)tmp_buff, MAX_PB_SIZE, (uint16_t *)tmp_prof + 128 + 1, tmp_prof_stride, tmp_grad_x, tmp_grad_y,
+                   4, prof_info->dmv_scale_h_0, prof_info->dmv_scale_v_0, 1);
     } else {
         mc_l->bidir0[prec_0_mc_type][log2_pu_w - 1](tmp_buff, ref0_b.y, ref0_b.stride,
                                                     pu_h, prec_x0, prec_y0, pu_w);
@@ -1831,11 +1824,11 @@ rcn_prof_motion_compensation_b_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
 
         extend_prof_buff(ref1_b.y, (uint16_t *)tmp_prof, ref1_b.stride, prec_x1 >> 3, prec_y1 >> 3);
 
-        compute_prof_grad((uint16_t *)tmp_prof, tmp_prof_stride, SB_W, SB_H, 4, tmp_grad_x, tmp_grad_y);
+        prof->grad((uint16_t *)tmp_prof, tmp_prof_stride, SB_W, SB_H, 4, tmp_grad_x, tmp_grad_y);
 
-        rcn_prof((uint16_t *)tmp_buff1, MAX_PB_SIZE, (uint16_t *)tmp_prof + 128 + 1, tmp_prof_stride,
-                 tmp_grad_x, tmp_grad_y,
-                 4, prof_info->dmv_scale_h_1, prof_info->dmv_scale_v_1, 1);
+        prof->func((uint16_t *)tmp_buff1, MAX_PB_SIZE, (uint16_t *)tmp_prof + 128 + 1, tmp_prof_stride,
+                   tmp_grad_x, tmp_grad_y,
+                   4, prof_info->dmv_scale_h_1, prof_info->dmv_scale_v_1, 1);
                  /*FIXME merge */
         if( mv0.bcw_idx_plus1 == 0 || mv0.bcw_idx_plus1 == 3){
             tmp_mrg(dst.y, RCN_CTB_STRIDE, (uint16_t *)tmp_buff1, MAX_PB_SIZE,
@@ -1858,7 +1851,7 @@ rcn_prof_motion_compensation_b_l(OVCTUDec *const ctudec, struct OVBuffInfo dst,
             wt1 = bcw_weights[mv0.bcw_idx_plus1-1];
             wt0 = 8 - wt1;
             int denom = 2;
-            mc_l->bidir_w[prec_1_mc_type][log2_pu_w - 1]((uint8_t*)dst.y, RCN_CTB_STRIDE<<1, (uint8_t*)ref1_b.y, ref1_b.stride<<1, 
+            mc_l->bidir_w[prec_1_mc_type][log2_pu_w - 1]((uint8_t*)dst.y, RCN_CTB_STRIDE<<1, (uint8_t*)ref1_b.y, ref1_b.stride * sizeof(OVSample), 
                                                         tmp_buff,  MAX_PB_SIZE, pu_h, denom, wt0, wt1, 
                                                         prec_x1, prec_y1, pu_w); 
         }
@@ -1891,10 +1884,10 @@ rcn_motion_compensation_b_c(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     /* TMP buffers for edge emulation
      * FIXME use tmp buffers in local contexts
      */
-    uint16_t edge_buff0[RCN_CTB_SIZE];
-    uint16_t edge_buff1[RCN_CTB_SIZE];
-    uint16_t edge_buff0_1[RCN_CTB_SIZE];
-    uint16_t edge_buff1_1[RCN_CTB_SIZE];
+    OVSample edge_buff0[RCN_CTB_SIZE];
+    OVSample edge_buff1[RCN_CTB_SIZE];
+    OVSample edge_buff0_1[RCN_CTB_SIZE];
+    OVSample edge_buff1_1[RCN_CTB_SIZE];
     int16_t tmp_buff[RCN_CTB_SIZE];
 
     /*FIXME we suppose here both refs possess the same size*/
@@ -1920,12 +1913,12 @@ rcn_motion_compensation_b_c(OVCTUDec *const ctudec, struct OVBuffInfo dst,
     dst.cb += (x0 >> 1) + (y0 >> 1) * dst.stride_c;
     dst.cr += (x0 >> 1) + (y0 >> 1) * dst.stride_c;
 
-    const struct OVBuffInfo ref0_c = derive_ref_buf_c(ref0, mv0,
+    const struct OVFrameBuffInfo ref0_c = derive_ref_buf_c(ref0, mv0,
                                                       pos_x >> 1, pos_y >> 1,
                                                       edge_buff0, edge_buff0_1,
                                                       log2_pu_w, log2_pu_h, log2_ctb_s);
 
-    const struct OVBuffInfo ref1_c = derive_ref_buf_c(ref1, mv1,
+    const struct OVFrameBuffInfo ref1_c = derive_ref_buf_c(ref1, mv1,
                                                       pos_x >> 1, pos_y >> 1,
                                                       edge_buff1, edge_buff1_1,
                                                       log2_pu_w, log2_pu_h, log2_ctb_s);
@@ -1952,10 +1945,10 @@ rcn_motion_compensation_b_c(OVCTUDec *const ctudec, struct OVBuffInfo dst,
         wt1 = bcw_weights[mv0.bcw_idx_plus1-1];
         wt0 = 8 - wt1;
         int denom = 2;
-        mc_c->bidir_w[prec_1_mc_type][log2_pu_w - 1]((uint8_t*)dst.cb, RCN_CTB_STRIDE<<1, (uint8_t*)ref1_c.cb, ref1_c.stride_c<<1, 
+        mc_c->bidir_w[prec_1_mc_type][log2_pu_w - 1]((uint8_t*)dst.cb, RCN_CTB_STRIDE<<1, (uint8_t*)ref1_c.cb, ref1_c.stride_c * sizeof(OVSample), 
                                                     ref_data0,  MAX_PB_SIZE, pu_h >> 1, denom, wt0, wt1, 
                                                     prec_x1, prec_y1, pu_w >> 1);
-        mc_c->bidir_w[prec_1_mc_type][log2_pu_w - 1]((uint8_t*)dst.cr, RCN_CTB_STRIDE<<1, (uint8_t*)ref1_c.cr, ref1_c.stride_c<<1, 
+        mc_c->bidir_w[prec_1_mc_type][log2_pu_w - 1]((uint8_t*)dst.cr, RCN_CTB_STRIDE<<1, (uint8_t*)ref1_c.cr, ref1_c.stride_c * sizeof(OVSample), 
                                                         ref_data1,  MAX_PB_SIZE, pu_h >> 1, denom, wt0, wt1, 
                                                         prec_x1, prec_y1, pu_w >> 1);
     }
@@ -1979,16 +1972,16 @@ rcn_mcp(OVCTUDec *const ctudec, struct OVBuffInfo dst, int x0, int y0, int log2_
     dst.cb += (x0 >> 1) + (y0 >> 1) * dst.stride_c;
     dst.cr += (x0 >> 1) + (y0 >> 1) * dst.stride_c;
 
-    uint16_t tmp_buff [RCN_CTB_SIZE];
+    OVSample tmp_buff [RCN_CTB_SIZE];
 
     const OVFrame *const frame0 = ref_pic->frame;
 
-    const uint16_t *const ref0_y  = (uint16_t *) frame0->data[0];
-    const uint16_t *const ref0_cb = (uint16_t *) frame0->data[1];
-    const uint16_t *const ref0_cr = (uint16_t *) frame0->data[2];
+    const OVSample *const ref0_y  = (OVSample *) frame0->data[0];
+    const OVSample *const ref0_cb = (OVSample *) frame0->data[1];
+    const OVSample *const ref0_cr = (OVSample *) frame0->data[2];
 
-    int src_stride   = frame0->linesize[0] >> 1;
-    int src_stride_c = frame0->linesize[1] >> 1;
+    int src_stride   = frame0->linesize[0] / sizeof(OVSample);
+    int src_stride_c = frame0->linesize[1] / sizeof(OVSample);
 
     uint8_t log2_ctb_s = ctudec->part_ctx->log2_ctu_s;
     int pos_x = (ctudec->ctb_x << log2_ctb_s) + x0;
@@ -2017,11 +2010,11 @@ rcn_mcp(OVCTUDec *const ctudec, struct OVBuffInfo dst, int x0, int y0, int log2_
     int prec_c_mc_type = (prec_x_c > 0) + ((prec_y_c > 0) << 1);
 
     uint8_t emulate_edge = test_for_edge_emulation(ref_x, ref_y, pic_w, pic_h,
-                                                   pu_w, pu_h);;
+                                                   pu_w, pu_h, frame0->margin[0]);
 
-    const uint16_t *src_y  = &ref0_y [ ref_x       + ref_y        * src_stride];
-    const uint16_t *src_cb = &ref0_cb[(ref_x >> 1) + (ref_y >> 1) * src_stride_c];
-    const uint16_t *src_cr = &ref0_cr[(ref_x >> 1) + (ref_y >> 1) * src_stride_c];
+    const OVSample *src_y  = &ref0_y [ ref_x       + ref_y        * src_stride];
+    const OVSample *src_cb = &ref0_cb[(ref_x >> 1) + (ref_y >> 1) * src_stride_c];
+    const OVSample *src_cr = &ref0_cr[(ref_x >> 1) + (ref_y >> 1) * src_stride_c];
 
     /* 
      * Thread synchronization to ensure data is available before usage
@@ -2050,7 +2043,7 @@ rcn_mcp(OVCTUDec *const ctudec, struct OVBuffInfo dst, int x0, int y0, int log2_
 
 
     emulate_edge = test_for_edge_emulation_c(ref_x >> 1, ref_y >> 1, pic_w >> 1, pic_h >> 1,
-                                             pu_w >> 1, pu_h >> 1);;
+                                             pu_w >> 1, pu_h >> 1, frame0->margin[1]);
 
     if (emulate_edge){
         int src_off  = REF_PADDING_C * (src_stride_c) + (REF_PADDING_C);
@@ -2069,10 +2062,10 @@ rcn_mcp(OVCTUDec *const ctudec, struct OVBuffInfo dst, int x0, int y0, int log2_
                                                 pu_h >> 1, prec_x_c, prec_y_c, pu_w >> 1);
 
     if (emulate_edge){
-        int src_off  = REF_PADDING_C * (frame0->linesize[1] >> 1) + (REF_PADDING_C);
+        int src_off  = REF_PADDING_C * (frame0->linesize[1] / sizeof(OVSample)) + (REF_PADDING_C);
         int buff_off = REF_PADDING_C * (RCN_CTB_STRIDE) + (REF_PADDING_C);
         emulate_block_border(tmp_buff, (src_cr - src_off),
-                             RCN_CTB_STRIDE, frame0->linesize[1] >> 1,
+                             RCN_CTB_STRIDE, frame0->linesize[1] / sizeof(OVSample),
                              (pu_w >> 1) + EPEL_EXTRA, (pu_h >> 1) + EPEL_EXTRA,
                              (pos_x >> 1) + (mv.x >> 5) - REF_PADDING_C, (pos_y >> 1) + (mv.y >> 5) - REF_PADDING_C,
                              (pic_w >> 1), (pic_h >> 1));
@@ -2098,14 +2091,14 @@ rcn_mcp_l(OVCTUDec *const ctudec, struct OVBuffInfo dst, int x0, int y0, int log
 
     dst.y  += x0 + y0 * dst.stride;
 
-    uint16_t tmp_buff [RCN_CTB_SIZE];
+    OVSample tmp_buff [RCN_CTB_SIZE];
 
     OVPicture *ref_pic =  type ? ref1 : ref0;
     const OVFrame *const frame0 = ref_pic->frame;
 
-    const uint16_t *const ref0_y  = (uint16_t *) frame0->data[0];
+    const OVSample *const ref0_y  = (OVSample *) frame0->data[0];
 
-    int src_stride   = frame0->linesize[0] >> 1;
+    int src_stride   = frame0->linesize[0] / sizeof(OVSample);
 
     uint8_t log2_ctb_s = ctudec->part_ctx->log2_ctu_s;
     int pos_x = (ctudec->ctb_x << log2_ctb_s) + x0;
@@ -2132,9 +2125,9 @@ rcn_mcp_l(OVCTUDec *const ctudec, struct OVBuffInfo dst, int x0, int y0, int log
     int prec_mc_type   = (prec_x  > 0) + ((prec_y > 0)   << 1);
 
     uint8_t emulate_edge = test_for_edge_emulation(ref_x, ref_y, pic_w, pic_h,
-                                                   pu_w, pu_h);;
+                                                   pu_w, pu_h, frame0->margin[0]);
 
-    const uint16_t *src_y  = &ref0_y [ ref_x       + ref_y        * src_stride];
+    const OVSample *src_y  = &ref0_y [ ref_x       + ref_y        * src_stride];
 
     /*
      * Thread synchronization to ensure data is available before usage
@@ -2179,14 +2172,14 @@ rcn_prof_mcp_l(OVCTUDec *const ctudec, struct OVBuffInfo dst, int x0, int y0,
 
     dst.y  += x0 + y0 * dst.stride;
 
-    uint16_t tmp_buff [RCN_CTB_SIZE];
+    OVSample tmp_buff [RCN_CTB_SIZE];
 
     OVPicture *ref_pic =  type ? ref1 : ref0;
     const OVFrame *const frame0 = ref_pic->frame;
 
-    const uint16_t *const ref0_y  = (uint16_t *) frame0->data[0];
+    const OVSample *const ref0_y  = (OVSample *) frame0->data[0];
 
-    int src_stride   = frame0->linesize[0] >> 1;
+    int src_stride   = frame0->linesize[0] / sizeof(OVSample);
 
     uint8_t log2_ctb_s = ctudec->part_ctx->log2_ctu_s;
     int pos_x = (ctudec->ctb_x << log2_ctb_s) + x0;
@@ -2213,9 +2206,9 @@ rcn_prof_mcp_l(OVCTUDec *const ctudec, struct OVBuffInfo dst, int x0, int y0,
     int prec_mc_type   = (prec_x  > 0) + ((prec_y > 0)   << 1);
 
     uint8_t emulate_edge = test_for_edge_emulation(ref_x, ref_y, pic_w, pic_h,
-                                                   pu_w, pu_h);;
+                                                   pu_w, pu_h, frame0->margin[0]);
 
-    const uint16_t *src_y  = &ref0_y [ ref_x       + ref_y        * src_stride];
+    const OVSample *src_y  = &ref0_y [ ref_x       + ref_y        * src_stride];
 
     /* 
      * Thread synchronization to ensure data is available before usage
@@ -2249,10 +2242,10 @@ rcn_prof_mcp_l(OVCTUDec *const ctudec, struct OVBuffInfo dst, int x0, int y0,
 
     extend_prof_buff(src_y, (uint16_t *)tmp_prof, src_stride, prec_x >> 3, prec_y >> 3);
 
-    compute_prof_grad((uint16_t *)tmp_prof, tmp_prof_stride, SB_W, SB_H, 4, tmp_grad_x, tmp_grad_y);
+    rcn_ctx->rcn_funcs.prof.grad((uint16_t *)tmp_prof, tmp_prof_stride, SB_W, SB_H, 4, tmp_grad_x, tmp_grad_y);
 
-    rcn_prof(dst.y, dst.stride, (uint16_t *)tmp_prof + 128 + 1, tmp_prof_stride, tmp_grad_x, tmp_grad_y,
-             4, dmv_scale_h, dmv_scale_v, 0);
+    rcn_ctx->rcn_funcs.prof.func(dst.y, dst.stride, (uint16_t *)tmp_prof + 128 + 1, tmp_prof_stride, tmp_grad_x, tmp_grad_y,
+                                 4, dmv_scale_h, dmv_scale_v, 0);
 
     rcn_ctx->rcn_funcs.lmcs_reshape(dst.y, RCN_CTB_STRIDE, ctudec->lmcs_info.lmcs_lut_fwd_luma, pu_w, pu_h);
 }
@@ -2272,15 +2265,15 @@ rcn_mcp_c(OVCTUDec *const ctudec, struct OVBuffInfo dst, int x0, int y0, int log
     dst.cb += (x0 >> 1) + (y0 >> 1) * dst.stride_c;
     dst.cr += (x0 >> 1) + (y0 >> 1) * dst.stride_c;
 
-    uint16_t tmp_buff [RCN_CTB_SIZE];
+    OVSample tmp_buff [RCN_CTB_SIZE];
 
     OVPicture *ref_pic =  type ? ref1 : ref0;
     const OVFrame *const frame0 = ref_pic->frame;
 
-    const uint16_t *const ref0_cb = (uint16_t *) frame0->data[1];
-    const uint16_t *const ref0_cr = (uint16_t *) frame0->data[2];
+    const OVSample *const ref0_cb = (OVSample *) frame0->data[1];
+    const OVSample *const ref0_cr = (OVSample *) frame0->data[2];
 
-    int src_stride_c = frame0->linesize[1] >> 1;
+    int src_stride_c = frame0->linesize[1] / sizeof(OVSample);
 
     uint8_t log2_ctb_s = ctudec->part_ctx->log2_ctu_s;
     int pos_x = (ctudec->ctb_x << log2_ctb_s) + x0;
@@ -2302,11 +2295,11 @@ rcn_mcp_c(OVCTUDec *const ctudec, struct OVBuffInfo dst, int x0, int y0, int log
 
     int prec_c_mc_type = (prec_x_c > 0) + ((prec_y_c > 0) << 1);
 
-    const uint16_t *src_cb = &ref0_cb[(ref_x >> 1) + (ref_y >> 1) * src_stride_c];
-    const uint16_t *src_cr = &ref0_cr[(ref_x >> 1) + (ref_y >> 1) * src_stride_c];
+    const OVSample *src_cb = &ref0_cb[(ref_x >> 1) + (ref_y >> 1) * src_stride_c];
+    const OVSample *src_cr = &ref0_cr[(ref_x >> 1) + (ref_y >> 1) * src_stride_c];
 
     uint8_t emulate_edge = test_for_edge_emulation_c(ref_x >> 1, ref_y >> 1, pic_w >> 1, pic_h >> 1,
-                                                     pu_w >> 1, pu_h >> 1);;
+                                                     pu_w >> 1, pu_h >> 1, frame0->margin[1]);
 
     if (emulate_edge){
         int src_off  = REF_PADDING_C * (src_stride_c) + (REF_PADDING_C);
@@ -2325,10 +2318,10 @@ rcn_mcp_c(OVCTUDec *const ctudec, struct OVBuffInfo dst, int x0, int y0, int log
                                                 pu_h >> 1, prec_x_c, prec_y_c, pu_w >> 1);
 
     if (emulate_edge){
-        int src_off  = REF_PADDING_C * (frame0->linesize[1] >> 1) + (REF_PADDING_C);
+        int src_off  = REF_PADDING_C * (frame0->linesize[1] / sizeof(OVSample)) + (REF_PADDING_C);
         int buff_off = REF_PADDING_C * (RCN_CTB_STRIDE) + (REF_PADDING_C);
         emulate_block_border(tmp_buff, (src_cr - src_off),
-                             RCN_CTB_STRIDE, frame0->linesize[1] >> 1,
+                             RCN_CTB_STRIDE, frame0->linesize[1] / sizeof(OVSample),
                              (pu_w >> 1) + EPEL_EXTRA, (pu_h >> 1) + EPEL_EXTRA,
                              (pos_x >> 1) + (mv.x >> 5) - REF_PADDING_C, (pos_y >> 1) + (mv.y >> 5) - REF_PADDING_C,
                              (pic_w >> 1), (pic_h >> 1));
@@ -2468,10 +2461,13 @@ void rcn_ciip_weighted_sum(OVCTUDec*const ctudec, struct OVBuffInfo* tmp_intra,
     tmp_intra->cr += (x0 >> 1) + (y0 >> 1) * tmp_intra->stride_c;
     tmp_inter->cr += (x0 >> 1) + (y0 >> 1) * tmp_inter->stride_c;
 
-    struct MCFunctions *mc_c = &ctudec->rcn_ctx.rcn_funcs.mc_c;
     if (log2_pb_w <= 2){
-        mc_c->unidir[0][0](dst.cb, dst.stride_c, tmp_inter->cb, tmp_inter->stride_c, 1 << (log2_pb_h - 1), 0, 0, 1 << (log2_pb_w - 1));
-        mc_c->unidir[0][0](dst.cr, dst.stride_c, tmp_inter->cr, tmp_inter->stride_c, 1 << (log2_pb_h - 1), 0, 0, 1 << (log2_pb_w - 1));
+        int i;
+        /* Inter prediction is kept as is for narrow chroma blocks */
+        for (i = 0; i < 1 << (log2_pb_h - 1); ++i) {
+            memcpy(&dst.cb[i * dst.stride_c], &tmp_inter->cb[i * tmp_inter->stride_c], sizeof(uint16_t) << (log2_pb_w - 1));
+            memcpy(&dst.cr[i * dst.stride_c], &tmp_inter->cr[i * tmp_inter->stride_c], sizeof(uint16_t) << (log2_pb_w - 1));
+        }
     }
     else{
         put_weighted_ciip_pixels(dst.cb, dst.stride_c, tmp_intra->cb, tmp_inter->cb, tmp_inter->stride_c,
@@ -2766,10 +2762,10 @@ rcn_gpm_mc(OVCTUDec *const ctudec, struct OVBuffInfo dst, int split_dir,
     /* TMP buffers for edge emulation
      * FIXME use tmp buffers in local contexts
      */
-    uint16_t edge_buff0[RCN_CTB_SIZE];
-    uint16_t edge_buff1[RCN_CTB_SIZE];
-    uint16_t edge_buff0_1[RCN_CTB_SIZE];
-    uint16_t edge_buff1_1[RCN_CTB_SIZE];
+    OVSample edge_buff0[RCN_CTB_SIZE];
+    OVSample edge_buff1[RCN_CTB_SIZE];
+    OVSample edge_buff0_1[RCN_CTB_SIZE];
+    OVSample edge_buff1_1[RCN_CTB_SIZE];
     int16_t tmp_buff0[RCN_CTB_SIZE];
     int16_t tmp_buff1[RCN_CTB_SIZE];
 
@@ -2790,10 +2786,10 @@ rcn_gpm_mc(OVCTUDec *const ctudec, struct OVBuffInfo dst, int split_dir,
                   ref1->frame->height[0], 1 << log2_pu_w, 1 << log2_pu_h, mv1);
 
 
-    const struct OVBuffInfo ref0_b = derive_ref_buf_y(ref0, mv0, pos_x, pos_y, edge_buff0,
+    const struct OVFrameBuffInfo ref0_b = derive_ref_buf_y(ref0, mv0, pos_x, pos_y, edge_buff0,
                                                       log2_pu_w, log2_pu_h, log2_ctb_s);
 
-    const struct OVBuffInfo ref1_b = derive_ref_buf_y(ref1, mv1, pos_x, pos_y, edge_buff1,
+    const struct OVFrameBuffInfo ref1_b = derive_ref_buf_y(ref1, mv1, pos_x, pos_y, edge_buff1,
                                                       log2_pu_w, log2_pu_h, log2_ctb_s);
 
     const int pu_w = 1 << log2_pu_w;
@@ -2830,12 +2826,12 @@ rcn_gpm_mc(OVCTUDec *const ctudec, struct OVBuffInfo dst, int split_dir,
     rcn_ctx->rcn_funcs.lmcs_reshape(dst.y, RCN_CTB_STRIDE, ctudec->lmcs_info.lmcs_lut_fwd_luma, pu_w, pu_h);
 
 
-    const struct OVBuffInfo ref0_c = derive_ref_buf_c(ref0, mv0,
+    const struct OVFrameBuffInfo ref0_c = derive_ref_buf_c(ref0, mv0,
                                                       pos_x >> 1, pos_y >> 1,
                                                       edge_buff0, edge_buff0_1,
                                                       log2_pu_w, log2_pu_h, log2_ctb_s);
 
-    const struct OVBuffInfo ref1_c = derive_ref_buf_c(ref1, mv1,
+    const struct OVFrameBuffInfo ref1_c = derive_ref_buf_c(ref1, mv1,
                                                       pos_x >> 1, pos_y >> 1,
                                                       edge_buff1, edge_buff1_1,
                                                       log2_pu_w, log2_pu_h, log2_ctb_s);
@@ -2879,3 +2875,16 @@ rcn_gpm_b(OVCTUDec *const ctudec, struct VVCGPM* gpm_ctx,
                           type0, gpm_ctx->mv0, type1, gpm_ctx->mv1);
 
 }
+
+void
+rcn_init_refine_functions(struct RCNFunctions *const rcn_funcs)
+{
+    rcn_funcs->dmvr.sad  = &rcn_dmvr_sad;
+    rcn_funcs->dmvr.sads = &dmvr_compute_sads;
+
+    rcn_funcs->bdof.grad      = &compute_prof_grad;
+    rcn_funcs->bdof.subblocks = &rcn_bdof;
+
+    rcn_funcs->prof.grad = &compute_prof_grad;
+    rcn_funcs->prof.func = &rcn_prof;
+}
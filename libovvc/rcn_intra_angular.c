@@ -3,9 +3,12 @@
 #include <string.h>
 
 #include "ovutils.h"
+#include "bitdepth.h"
 
 #include "rcn_intra_angular.h"
 #include "data_rcn_angular.h"
+#include "rcn_structures.h"
+#include "rcn.h"
 
 
 
@@ -99,7 +102,7 @@ vvc_intra_angular_hdia(const uint16_t* const ref_abv,
                                   _tmp[x] +
                                     ((wL * (above - _tmp[x]) + 32) >> 6),
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                 delta_pos += 32;
                 _tmp += tmp_stride;
@@ -145,7 +148,7 @@ vvc_intra_angular_vdia(const uint16_t* const ref_abv,
                                 _dst[x] = ov_clip(
                                   _dst[x] + ((wL * (left - _dst[x]) + 32) >> 6),
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                 delta_pos += 32;
                 _dst += dst_stride;
@@ -179,7 +182,7 @@ vvc_intra_angular_h_c(const uint16_t* ref_lft, uint16_t* dst,
                               (((delta_frac) * (curr_ref_val - last_ref_val) +
                                 16) >>
                                5);
-                        _tmp[x] = ov_clip(val, 0, 1023);
+                        _tmp[x] = ov_clip(val, 0, OV_SAMPLE_MAX);
                         last_ref_val = curr_ref_val;
                         pRM++;
                 }
@@ -220,7 +223,7 @@ vvc_intra_angular_v_c(const uint16_t* ref_abv, uint16_t* dst,
                               (((delta_frac) * (curr_ref_val - last_ref_val) +
                                 16) >>
                                5);
-                        _dst[x] = ov_clip(val, 0, 1023);
+                        _dst[x] = ov_clip(val, 0, OV_SAMPLE_MAX);
                         last_ref_val = curr_ref_val;
                 }
                 delta_pos += angle_val;
@@ -248,7 +251,7 @@ vvc_intra_hor_pdpc(const uint16_t* const ref_abv,
                         const int32_t t_val = ref_abv[x + 1];
                         int val =
                           (l_wgh * (t_val - tl_val) + (l_val << 6) + 32) >> 6;
-                        _dst[x] = ov_clip(val, 0, 1023);
+                        _dst[x] = ov_clip(val, 0, OV_SAMPLE_MAX);
                 }
                 _dst += dst_stride;
         }
@@ -275,7 +278,7 @@ vvc_intra_ver_pdpc(const uint16_t* const ref_abv,
                         int l_wgh = pdpc_w[x];
                         int val =
                           (l_wgh * (l_val - tl_val) + (t_val << 6) + 32) >> 6;
-                        _dst[x] = ov_clip(val, 0, 1023);
+                        _dst[x] = ov_clip(val, 0, OV_SAMPLE_MAX);
                 }
                 _dst += dst_stride;
         }
@@ -367,7 +370,7 @@ vvc_intra_angular_hpos_wide(const uint16_t* const ref_abv,
                         _tmp[x] =
                           ov_clip(_tmp[x] + ((wL * (left - _tmp[x]) + 32) >> 6),
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         inv_angle_sum += inv_angle;
                 }
                 delta_pos += angle_val;
@@ -430,7 +433,7 @@ vvc_intra_angular_vpos_wide(const uint16_t* const ref_abv,
                         _dst[x] =
                           ov_clip(_dst[x] + ((wL * (left - _dst[x]) + 32) >> 6),
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         inv_angle_sum += inv_angle;
                 }
                 delta_pos += angle_val;
@@ -505,7 +508,7 @@ intra_angular_h_nofrac_pdpc(const uint16_t* ref_abv, const uint16_t* ref_lft,
                         _tmp[x] =
                           ov_clip(_tmp[x] + ((wL * (left - _tmp[x]) + 32) >> 6),
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         inv_angle_sum += inv_angle;
                 }
                 delta_pos += angle_val >> 5;
@@ -565,7 +568,7 @@ intra_angular_h_gauss_pdpc(const uint16_t* ref_abv, const uint16_t* ref_lft,
                         _tmp[x] =
                           ov_clip(_tmp[x] + ((wL * (left - _tmp[x]) + 32) >> 6),
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         inv_angle_sum += inv_angle;
                 }
 
@@ -637,7 +640,7 @@ intra_angular_v_nofrac_pdpc(const uint16_t* ref_abv, const uint16_t* ref_lft,
                         _dst[x] =
                           ov_clip(_dst[x] + ((wL * (left - _dst[x]) + 32) >> 6),
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         inv_angle_sum += inv_angle;
                 }
                 delta_pos += angle_val;
@@ -682,7 +685,7 @@ intra_angular_v_gauss_pdpc(const uint16_t* ref_abv, const uint16_t* ref_lft,
                         _dst[x] =
                           ov_clip(_dst[x] + ((wL * (left - _dst[x]) + 32) >> 6),
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         inv_angle_sum += inv_angle;
                 }
                 delta_pos += angle_val;
@@ -715,7 +718,7 @@ intra_angular_h_cubic(const uint16_t* ref_lft, uint16_t* dst,
                                (int32_t)(ref[2] * filter[2]) +
                                (int32_t)(ref[3] * filter[3]) + 32) >>
                               6;
-                        _tmp[x] = ov_clip(val, 0, 1023);
+                        _tmp[x] = ov_clip(val, 0, OV_SAMPLE_MAX);
                         ref++;
                 }
                 delta_pos += angle_val;
@@ -800,7 +803,7 @@ intra_angular_v_cubic(const uint16_t* ref_abv, uint16_t* dst,
                                (int32_t)(ref[2] * filter[2]) +
                                (int32_t)(ref[3] * filter[3]) + 32) >>
                               6;
-                        _dst[x] = ov_clip(val, 0, 1023);
+                        _dst[x] = ov_clip(val, 0, OV_SAMPLE_MAX);
                         ref++;
                 }
                 delta_pos += angle_val;
@@ -872,7 +875,7 @@ intra_angular_h_cubic_pdpc(const uint16_t* ref_abv, const uint16_t* ref_lft,
                                    (int32_t)(ref[3] * filter[3]) + 32) >>
                                   6;
                         ref++;
-                        _tmp[x] = ov_clip(val, 0, 1023);
+                        _tmp[x] = ov_clip(val, 0, OV_SAMPLE_MAX);
                 }
 
                 for (int x = 0; x < OVMIN(3 << scale, height); x++) {
@@ -884,7 +887,7 @@ intra_angular_h_cubic_pdpc(const uint16_t* ref_abv, const uint16_t* ref_lft,
                         _tmp[x] =
                           ov_clip(_tmp[x] + ((wL * (left - _tmp[x]) + 32) >> 6),
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         inv_angle_sum += inv_angle;
                 }
                 delta_pos += angle_val;
@@ -929,7 +932,7 @@ intra_angular_v_cubic_pdpc(const uint16_t* ref_abv, const uint16_t* ref_lft,
                                    (int32_t)(ref[3] * filter[3]) + 32) >>
                                   6;
                         ref++;
-                        _dst[x] = ov_clip(val, 0, 1023);
+                        _dst[x] = ov_clip(val, 0, OV_SAMPLE_MAX);
                 }
 
                 for (int x = 0; x < OVMIN(3 << scale, width); x++) {
@@ -941,7 +944,7 @@ intra_angular_v_cubic_pdpc(const uint16_t* ref_abv, const uint16_t* ref_lft,
                         _dst[x] =
                           ov_clip(_dst[x] + ((wL * (left - _dst[x]) + 32) >> 6),
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         inv_angle_sum += inv_angle;
                 }
                 delta_pos += angle_val;
@@ -1039,7 +1042,7 @@ intra_angular_h_cubic_mref(const uint16_t* const ref_lft, uint16_t* const dst,
                      (int32_t)(ref[3] * filter[3]) + 32) >>
                     6;
                 ref++;
-                _tmp[x] = ov_clip(val, 0, 1023);
+                _tmp[x] = ov_clip(val, 0, OV_SAMPLE_MAX);
             }
             delta_pos += angle_val;
             _tmp += tmp_stride;
@@ -1092,7 +1095,7 @@ intra_angular_v_cubic_mref(const uint16_t* const ref_abv, uint16_t* const dst,
                      (int32_t)(ref[3] * filter[3]) + 32) >>
                     6;
                 ref++;
-                _dst[x] = ov_clip(val, 0, 1023);
+                _dst[x] = ov_clip(val, 0, OV_SAMPLE_MAX);
             }
             delta_pos += angle_val;
             _dst += dst_stride;
@@ -1108,3 +1111,22 @@ intra_angular_v_cubic_mref(const uint16_t* const ref_abv, uint16_t* const dst,
         }
     }
 }
+
+void
+rcn_init_angular_functions(struct RCNFunctions *const rcn_funcs)
+{
+    struct AngularFunctions *const angular = &rcn_funcs->angular;
+    int i;
+
+    for (i = 0; i < 8; ++i) {
+        angular->v[0][i] = &intra_angular_v_cubic;
+        angular->v[1][i] = &intra_angular_v_gauss;
+        angular->h[0][i] = &intra_angular_h_cubic;
+        angular->h[1][i] = &intra_angular_h_gauss;
+
+        angular->v_pdpc[0][i] = &intra_angular_v_cubic_pdpc;
+        angular->v_pdpc[1][i] = &intra_angular_v_gauss_pdpc;
+        angular->h_pdpc[0][i] = &intra_angular_h_cubic_pdpc;
+        angular->h_pdpc[1][i] = &intra_angular_h_gauss_pdpc;
+    }
+}
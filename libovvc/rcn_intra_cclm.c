@@ -233,11 +233,11 @@ vvc_intra_cclm_cl(const uint16_t* const src_luma, uint16_t* const dst_cb,
                                 _dst_cb[i] = ov_clip(
                                   ((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                                 _dst_cr[i] = ov_clip(
                                   ((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                         _dst_cb += dst_stride;
                         _dst_cr += dst_stride;
@@ -264,11 +264,11 @@ vvc_intra_cclm_cl(const uint16_t* const src_luma, uint16_t* const dst_cb,
                         _dst_cb[i] =
                           ov_clip(((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         _dst_cr[i] =
                           ov_clip(((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                 }
 
                 _dst_cb += dst_stride;
@@ -286,11 +286,11 @@ vvc_intra_cclm_cl(const uint16_t* const src_luma, uint16_t* const dst_cb,
                                 _dst_cb[i] = ov_clip(
                                   ((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                                 _dst_cr[i] = ov_clip(
                                   ((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                         _dst_cb += dst_stride;
                         _dst_cr += dst_stride;
@@ -316,11 +316,11 @@ vvc_intra_cclm_cl(const uint16_t* const src_luma, uint16_t* const dst_cb,
                         _dst_cb[0] =
                           ov_clip(((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         _dst_cr[0] =
                           ov_clip(((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
 
                         for (i = 1, i_s = 1 << W_SHIFT; i < 1 << log2_pb_w;
                              ++i, i_s = i << W_SHIFT) {
@@ -332,11 +332,11 @@ vvc_intra_cclm_cl(const uint16_t* const src_luma, uint16_t* const dst_cb,
                                 _dst_cb[i] = ov_clip(
                                   ((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                                 _dst_cr[i] = ov_clip(
                                   ((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                         _dst_cb += dst_stride;
                         _dst_cr += dst_stride;
@@ -393,8 +393,8 @@ vvc_intra_mdlm_top_cl(const uint16_t* const src_luma, uint16_t* const dst_cb,
 
         // ref above
         if (!up_available) {
-                lm_params.offset_cb = 512;
-                lm_params.offset_cr = 512;
+                lm_params.offset_cb = OV_SAMPLE_MID;
+                lm_params.offset_cr = OV_SAMPLE_MID;
                 lm_params.scale_cb = 0;
                 lm_params.scale_cr = 0;
                 lm_params.shift_cb = 0;
@@ -544,11 +544,11 @@ vvc_intra_mdlm_top_cl(const uint16_t* const src_luma, uint16_t* const dst_cb,
                                 _dst_cb[i] = ov_clip(
                                   ((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                                 _dst_cr[i] = ov_clip(
                                   ((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                         _dst_cb += dst_stride;
                         _dst_cr += dst_stride;
@@ -574,11 +574,11 @@ vvc_intra_mdlm_top_cl(const uint16_t* const src_luma, uint16_t* const dst_cb,
                         _dst_cb[0] =
                           ov_clip(((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         _dst_cr[0] =
                           ov_clip(((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
 
                         for (i = 1, i_s = 1 << W_SHIFT; i < 1 << log2_pb_w;
                              ++i, i_s = i << W_SHIFT) {
@@ -590,11 +590,11 @@ vvc_intra_mdlm_top_cl(const uint16_t* const src_luma, uint16_t* const dst_cb,
                                 _dst_cb[i] = ov_clip(
                                   ((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                                 _dst_cr[i] = ov_clip(
                                   ((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                         _dst_cb += dst_stride;
                         _dst_cr += dst_stride;
@@ -650,8 +650,8 @@ vvc_intra_mdlm_left_cl(const uint16_t* const src_luma, uint16_t* const dst_cb,
 
         // ref above
         if (!left_available) {
-                lm_params.offset_cb = 512;
-                lm_params.offset_cr = 512;
+                lm_params.offset_cb = OV_SAMPLE_MID;
+                lm_params.offset_cr = OV_SAMPLE_MID;
                 lm_params.scale_cb = 0;
                 lm_params.scale_cr = 0;
                 lm_params.shift_cb = 0;
@@ -765,11 +765,11 @@ vvc_intra_mdlm_left_cl(const uint16_t* const src_luma, uint16_t* const dst_cb,
                                 _dst_cb[i] = ov_clip(
                                   ((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                                 _dst_cr[i] = ov_clip(
                                   ((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                         _dst_cb += dst_stride;
                         _dst_cr += dst_stride;
@@ -796,11 +796,11 @@ vvc_intra_mdlm_left_cl(const uint16_t* const src_luma, uint16_t* const dst_cb,
                         _dst_cb[i] =
                           ov_clip(((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         _dst_cr[i] =
                           ov_clip(((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                 }
 
                 _dst_cb += dst_stride;
@@ -818,11 +818,11 @@ vvc_intra_mdlm_left_cl(const uint16_t* const src_luma, uint16_t* const dst_cb,
                                 _dst_cb[i] = ov_clip(
                                   ((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                                 _dst_cr[i] = ov_clip(
                                   ((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                         _dst_cb += dst_stride;
                         _dst_cr += dst_stride;
@@ -1015,18 +1015,18 @@ vvc_intra_cclm(const uint16_t* const src_luma, uint16_t* const dst_cb,
                         cr_ref[1] = cr_ref[3];
                 }
         } else {
-                lm_ref[0] = 512;
-                lm_ref[1] = 512;
-                lm_ref[2] = 512;
-                lm_ref[3] = 512;
-                cb_ref[0] = 512;
-                cb_ref[1] = 512;
-                cb_ref[2] = 512;
-                cb_ref[3] = 512;
-                cr_ref[0] = 512;
-                cr_ref[1] = 512;
-                cr_ref[2] = 512;
-                cr_ref[3] = 512;
+                lm_ref[0] = OV_SAMPLE_MID;
+                lm_ref[1] = OV_SAMPLE_MID;
+                lm_ref[2] = OV_SAMPLE_MID;
+                lm_ref[3] = OV_SAMPLE_MID;
+                cb_ref[0] = OV_SAMPLE_MID;
+                cb_ref[1] = OV_SAMPLE_MID;
+                cb_ref[2] = OV_SAMPLE_MID;
+                cb_ref[3] = OV_SAMPLE_MID;
+                cr_ref[0] = OV_SAMPLE_MID;
+                cr_ref[1] = OV_SAMPLE_MID;
+                cr_ref[2] = OV_SAMPLE_MID;
+                cr_ref[3] = OV_SAMPLE_MID;
         }
 
         // TODO compute lm_param for cb and cr components
@@ -1059,11 +1059,11 @@ vvc_intra_cclm(const uint16_t* const src_luma, uint16_t* const dst_cb,
                                 _dst_cb[i] = ov_clip(
                                   ((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                                 _dst_cr[i] = ov_clip(
                                   ((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                         _dst_cb += dst_stride;
                         _dst_cr += dst_stride;
@@ -1095,11 +1095,11 @@ vvc_intra_cclm(const uint16_t* const src_luma, uint16_t* const dst_cb,
                                 _dst_cb[i] = ov_clip(
                                   ((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                                 _dst_cr[i] = ov_clip(
                                   ((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                         _dst_cb += dst_stride;
                         _dst_cr += dst_stride;
@@ -1123,11 +1123,11 @@ vvc_intra_cclm(const uint16_t* const src_luma, uint16_t* const dst_cb,
                         _dst_cb[0] =
                           ov_clip(((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         _dst_cr[0] =
                           ov_clip(((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
 
                         for (i = 1, i_s = 1 << W_SHIFT; i < 1 << log2_pb_w;
                              ++i, i_s = i << W_SHIFT) {
@@ -1140,11 +1140,11 @@ vvc_intra_cclm(const uint16_t* const src_luma, uint16_t* const dst_cb,
                                 _dst_cb[i] = ov_clip(
                                   ((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                                 _dst_cr[i] = ov_clip(
                                   ((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                         _dst_cb += dst_stride;
                         _dst_cr += dst_stride;
@@ -1154,8 +1154,8 @@ vvc_intra_cclm(const uint16_t* const src_luma, uint16_t* const dst_cb,
                 int32_t value;
                 uint16_t *_dst_cb, *_dst_cr;
                 const uint16_t* _src;
-                int offset_cb = 512;
-                int offset_cr = 512;
+                int offset_cb = OV_SAMPLE_MID;
+                int offset_cr = OV_SAMPLE_MID;
                 int scale_cb = 0;
                 int scale_cr = 0;
                 int shift_cb = 0;
@@ -1168,11 +1168,11 @@ vvc_intra_cclm(const uint16_t* const src_luma, uint16_t* const dst_cb,
                         _dst_cb[0] =
                           ov_clip(((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         _dst_cr[0] =
                           ov_clip(((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
 
                         for (i = 1, i_s = 1 << W_SHIFT; i < 1 << log2_pb_w;
                              ++i, i_s = i << W_SHIFT) {
@@ -1185,11 +1185,11 @@ vvc_intra_cclm(const uint16_t* const src_luma, uint16_t* const dst_cb,
                                 _dst_cb[i] = ov_clip(
                                   ((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                                 _dst_cr[i] = ov_clip(
                                   ((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                         _dst_cb += dst_stride;
                         _dst_cr += dst_stride;
@@ -1246,8 +1246,8 @@ vvc_intra_mdlm_top(const uint16_t* const src_luma, uint16_t* const dst_cb,
 
         // ref above
         if (!up_available) {
-                lm_params.offset_cb = 512;
-                lm_params.offset_cr = 512;
+                lm_params.offset_cb = OV_SAMPLE_MID;
+                lm_params.offset_cr = OV_SAMPLE_MID;
                 lm_params.scale_cb = 0;
                 lm_params.scale_cr = 0;
                 lm_params.shift_cb = 0;
@@ -1399,11 +1399,11 @@ vvc_intra_mdlm_top(const uint16_t* const src_luma, uint16_t* const dst_cb,
                                 _dst_cb[i] = ov_clip(
                                   ((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                                 _dst_cr[i] = ov_clip(
                                   ((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                         _dst_cb += dst_stride;
                         _dst_cr += dst_stride;
@@ -1427,11 +1427,11 @@ vvc_intra_mdlm_top(const uint16_t* const src_luma, uint16_t* const dst_cb,
                         _dst_cb[0] =
                           ov_clip(((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         _dst_cr[0] =
                           ov_clip(((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
 
                         for (i = 1, i_s = 1 << W_SHIFT; i < 1 << log2_pb_w;
                              ++i, i_s = i << W_SHIFT) {
@@ -1444,11 +1444,11 @@ vvc_intra_mdlm_top(const uint16_t* const src_luma, uint16_t* const dst_cb,
                                 _dst_cb[i] = ov_clip(
                                   ((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                                 _dst_cr[i] = ov_clip(
                                   ((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                         _dst_cb += dst_stride;
                         _dst_cr += dst_stride;
@@ -1503,8 +1503,8 @@ vvc_intra_mdlm_left(const uint16_t* const src_luma, uint16_t* const dst_cb,
 
         // ref above
         if (!left_available) {
-                lm_params.offset_cb = 512;
-                lm_params.offset_cr = 512;
+                lm_params.offset_cb = OV_SAMPLE_MID;
+                lm_params.offset_cr = OV_SAMPLE_MID;
                 lm_params.scale_cb = 0;
                 lm_params.scale_cr = 0;
                 lm_params.shift_cb = 0;
@@ -1609,11 +1609,11 @@ vvc_intra_mdlm_left(const uint16_t* const src_luma, uint16_t* const dst_cb,
                                 _dst_cb[i] = ov_clip(
                                   ((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                                 _dst_cr[i] = ov_clip(
                                   ((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                         _dst_cb += dst_stride;
                         _dst_cr += dst_stride;
@@ -1638,11 +1638,11 @@ vvc_intra_mdlm_left(const uint16_t* const src_luma, uint16_t* const dst_cb,
                         _dst_cb[0] =
                           ov_clip(((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         _dst_cr[0] =
                           ov_clip(((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         for (i = 1, i_s = 1 << W_SHIFT; i < 1 << log2_pb_w;
                              ++i, i_s = i << W_SHIFT) {
                                 value =
@@ -1654,11 +1654,11 @@ vvc_intra_mdlm_left(const uint16_t* const src_luma, uint16_t* const dst_cb,
                                 _dst_cb[i] = ov_clip(
                                   ((value * scale_cb) >> shift_cb) + offset_cb,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                                 _dst_cr[i] = ov_clip(
                                   ((value * scale_cr) >> shift_cr) + offset_cr,
                                   0,
-                                  1023);
+                                  OV_SAMPLE_MAX);
                         }
                         _dst_cb += dst_stride;
                         _dst_cr += dst_stride;
@@ -1877,8 +1877,8 @@ compute_lm_subsample_collocated(const uint16_t *lm_src, uint16_t *dst_cb, uint16
             lm_val += lm_src[2 * i + lm_src_stride];
 
             lm_val >>= 3;
-            dst_cb[i] = ov_clip(((lm_val * scale_cb) >> shift_cb) + offset_cb, 0, 1023);
-            dst_cr[i] = ov_clip(((lm_val * scale_cr) >> shift_cr) + offset_cr, 0, 1023);
+            dst_cb[i] = ov_clip(((lm_val * scale_cb) >> shift_cb) + offset_cb, 0, OV_SAMPLE_MAX);
+            dst_cr[i] = ov_clip(((lm_val * scale_cr) >> shift_cr) + offset_cr, 0, OV_SAMPLE_MAX);
         }
         dst_cb += dst_stride_c;
         dst_cr += dst_stride_c;
@@ -2136,8 +2136,8 @@ compute_lm_subsample(const uint16_t *lm_src, uint16_t *dst_cb, uint16_t *dst_cr,
             lm_val += lm_src[2 * i + 1 + lm_src_stride];
             lm_val += lm_src[2 * i + lm_src_stride - (!pad_left)];
             lm_val >>= 3;
-            dst_cb[i] = ov_clip(((lm_val * scale_cb) >> shift_cb) + offset_cb, 0, 1023);
-            dst_cr[i] = ov_clip(((lm_val * scale_cr) >> shift_cr) + offset_cr, 0, 1023);
+            dst_cb[i] = ov_clip(((lm_val * scale_cb) >> shift_cb) + offset_cb, 0, OV_SAMPLE_MAX);
+            dst_cr[i] = ov_clip(((lm_val * scale_cr) >> shift_cr) + offset_cr, 0, OV_SAMPLE_MAX);
         }
         dst_cb += dst_stride_c;
         dst_cr += dst_stride_c;
@@ -2152,8 +2152,8 @@ vvc_intra_cclm2(const uint16_t *lm_src, uint16_t *dst_cb, uint16_t *dst_cr,
                uint8_t y0, LMsubsampleFunc const *compute_subsample)
 {
     struct CCLMParams lm_params = {
-        .cb = {.a = 0, .b = 512, .shift = 0},
-        .cr = {.a = 0, .b = 512, .shift = 0}
+        .cb = {.a = 0, .b = OV_SAMPLE_MID, .shift = 0},
+        .cr = {.a = 0, .b = OV_SAMPLE_MID, .shift = 0}
     };
 
     int pb_w = 1 << log2_pb_w;
@@ -2224,8 +2224,8 @@ vvc_intra_cclm2_collocated(const uint16_t *lm_src, uint16_t *dst_cb, uint16_t *d
                            uint8_t y0)
 {
     struct CCLMParams lm_params = {
-        .cb = {.a = 0, .b = 512, .shift = 0},
-        .cr = {.a = 0, .b = 512, .shift = 0}
+        .cb = {.a = 0, .b = OV_SAMPLE_MID, .shift = 0},
+        .cr = {.a = 0, .b = OV_SAMPLE_MID, .shift = 0}
     };
 
     int pb_w = 1 << log2_pb_w;
@@ -2305,8 +2305,8 @@ vvc_intra_mdlm_t2(const uint16_t *lm_src, uint16_t *dst_cb, uint16_t *dst_cr,
                   uint8_t y0, uint8_t x0, uint64_t abv_map, LMsubsampleFunc const *compute_subsample)
 {
     struct CCLMParams lm_params = {
-        .cb = {.a = 0, .b = 512, .shift = 0},
-        .cr = {.a = 0, .b = 512, .shift = 0}
+        .cb = {.a = 0, .b = OV_SAMPLE_MID, .shift = 0},
+        .cr = {.a = 0, .b = OV_SAMPLE_MID, .shift = 0}
     };
 
     int pb_w = 1 << log2_pb_w;
@@ -2364,8 +2364,8 @@ vvc_intra_mdlm_t2_collocated(const uint16_t *lm_src, uint16_t *dst_cb, uint16_t
                              uint8_t y0, uint8_t x0, uint64_t abv_map)
 {
     struct CCLMParams lm_params = {
-        .cb = {.a = 0, .b = 512, .shift = 0},
-        .cr = {.a = 0, .b = 512, .shift = 0}
+        .cb = {.a = 0, .b = OV_SAMPLE_MID, .shift = 0},
+        .cr = {.a = 0, .b = OV_SAMPLE_MID, .shift = 0}
     };
 
     int pb_w = 1 << log2_pb_w;
@@ -2435,8 +2435,8 @@ vvc_intra_mdlm_l2(const uint16_t *lm_src, uint16_t *dst_cb, uint16_t *dst_cr,
                   uint8_t y0, uint8_t x0, uint64_t lft_map, LMsubsampleFunc const *compute_subsample)
 {
     struct CCLMParams lm_params = {
-        .cb = {.a = 0, .b = 512, .shift = 0},
-        .cr = {.a = 0, .b = 512, .shift = 0}
+        .cb = {.a = 0, .b = OV_SAMPLE_MID, .shift = 0},
+        .cr = {.a = 0, .b = OV_SAMPLE_MID, .shift = 0}
     };
 
     int pb_w = 1 << log2_pb_w;
@@ -2486,8 +2486,8 @@ vvc_intra_mdlm_l2_collocated(const uint16_t *lm_src, uint16_t *dst_cb, uint16_t
                              uint8_t y0, uint8_t x0, uint64_t lft_map)
 {
     struct CCLMParams lm_params = {
-        .cb = {.a = 0, .b = 512, .shift = 0},
-        .cr = {.a = 0, .b = 512, .shift = 0}
+        .cb = {.a = 0, .b = OV_SAMPLE_MID, .shift = 0},
+        .cr = {.a = 0, .b = OV_SAMPLE_MID, .shift = 0}
     };
 
     int pb_w = 1 << log2_pb_w;
@@ -2,6 +2,7 @@
 #include <stdint.h>
 
 #include "ovutils.h"
+#include "bitdepth.h"
 #include "rcn_structures.h"
 
 static const uint8_t vvc_pdpc_w[3][128] = {
@@ -147,7 +148,7 @@ vvc_intra_dc_pdpc(const uint16_t* const src_above,
                         int val = ((t_wgh * l_val) + (l_wgh * t_val) +
                                    (64 - (t_wgh + l_wgh)) * dc_val + 32) >>
                                   6;
-                        _dst[x] = ov_clip(val, 0, 1023);
+                        _dst[x] = ov_clip(val, 0, OV_SAMPLE_MAX);
                 }
                 _dst += dst_stride;
         }
@@ -212,7 +213,7 @@ vvc_intra_planar_pdpc(const uint16_t* const src_above,
                         val = ((x_wgh * l_val) + (y_wgh * t_val) +
                                (64 - (x_wgh + y_wgh)) * val + 32) >>
                               6;
-                        _dst[x] = ov_clip(val, 0, 1023);
+                        _dst[x] = ov_clip(val, 0, OV_SAMPLE_MAX);
                 }
                 // #if CUT_PDPC
                 //                 for (; x < width; ++x) {
@@ -225,7 +226,7 @@ vvc_intra_planar_pdpc(const uint16_t* const src_above,
                 //                               s_shift;
                 //                         val = ((y_wgh * t_val) + (64 - y_wgh)
                 //                         * val + 32) >> 6; _dst[x] =
-                //                         av_clip(val, 0, 1023);
+                //                         av_clip(val, 0, OV_SAMPLE_MAX);
                 //                 }
                 // #endif
                 _dst += dst_stride;
@@ -248,7 +249,7 @@ vvc_intra_planar_pdpc(const uint16_t* const src_above,
         //                                offset) >>
         //                               s_shift;
         //                         val = ((x_wgh * l_val) + (64 - x_wgh) * val +
-        //                         32) >> 6; _dst[x] = av_clip(val, 0, 1023);
+        //                         32) >> 6; _dst[x] = av_clip(val, 0, OV_SAMPLE_MAX);
         //                 }
         //                 for (; x < width; ++x) {
         //                         int32_t val;
@@ -259,7 +260,7 @@ vvc_intra_planar_pdpc(const uint16_t* const src_above,
         //                         w_scale) +
         //                                offset) >>
         //                               s_shift;
-        //                         _dst[x] = av_clip(val, 0, 1023);
+        //                         _dst[x] = av_clip(val, 0, OV_SAMPLE_MAX);
         //                 }
         //                 _dst += dst_stride;
         //         }
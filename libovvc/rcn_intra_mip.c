@@ -112,7 +112,7 @@ mip_matmult(int16_t * bndy_line, uint16_t * mip_pred, const int stride_x, const
                 tmp3 += ((int32_t)bndy_line[i + 3]) * matrix_mip[i + 3];
             }
             val = (tmp0 + tmp1) + (tmp2 + tmp3);
-            mip_pred[pos++] = ov_clip(((val + rnd_mip) >> MIP_SHIFT) + input_offset, 0, 1023);
+            mip_pred[pos++] = ov_clip(((val + rnd_mip) >> MIP_SHIFT) + input_offset, 0, OV_SAMPLE_MAX);
             matrix_mip += stride_x;
         }
     }
@@ -5,7 +5,7 @@
 
 #include "rcn_lmcs.h"
 
-#define BITDEPTH 10
+#include "bitdepth.h"
 #define SMP_RNG (1 << BITDEPTH)
 #define CLIP_VAL ((1 << BITDEPTH) - 1)
 
@@ -283,6 +283,18 @@ rcn_lmcs_reshape_luma_blk_lut(uint16_t *dst, ptrdiff_t stride_dst, uint16_t* lmc
     }
 }
 
+static void
+rcn_lmcs_reshape_pic_blk_lut(OVSample *dst, ptrdiff_t stride_dst, uint16_t* lmcs_lut_luma,
+                             int width, int height)
+{
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++){
+            dst[x] = lmcs_lut_luma[dst[x]];
+        }
+        dst += stride_dst;
+    }
+}
+
 void 
 rcn_lmcs_compute_lut_luma(struct LMCSInfo *lmcs_info, uint16_t* inverse_lut,
                           uint16_t* forward_lut, uint16_t* wnd_boundaries)
@@ -306,12 +318,21 @@ rcn_lmcs_no_reshape(uint16_t *dst, ptrdiff_t stride_dst, uint16_t* lmcs_lut_luma
     return;
 }
 
+static void
+rcn_lmcs_no_reshape_pic(OVSample *dst, ptrdiff_t stride_dst, uint16_t* lmcs_lut_luma,
+                        int width, int height)
+{
+    return;
+}
+
 void
 rcn_init_lmcs_function(struct RCNFunctions *rcn_func, uint8_t lmcs_flag)
 {
     if(lmcs_flag){
         rcn_func->lmcs_reshape = &rcn_lmcs_reshape_luma_blk_lut;
+        rcn_func->lmcs_reshape_pic = &rcn_lmcs_reshape_pic_blk_lut;
     } else {
         rcn_func->lmcs_reshape = &rcn_lmcs_no_reshape;
+        rcn_func->lmcs_reshape_pic = &rcn_lmcs_no_reshape_pic;
     }
 }
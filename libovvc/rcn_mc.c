@@ -3,13 +3,13 @@
 #include <string.h>
 
 #include "ovutils.h"
+#include "bitdepth.h"
 
 #include "rcn_mc.h"
 #include "rcn_structures.h"
 
-#define ov_clip_pixel(a) ov_clip_uintp2(a, BIT_DEPTH)
+#define ov_clip_pixel(a) ov_clip_uintp2(a, BITDEPTH)
 #define MAX_PB_SIZE 128
-#define BIT_DEPTH 10
 
 #define EPEL_EXTRA_BEFORE 1
 #define EPEL_EXTRA_AFTER 2
@@ -132,17 +132,20 @@ static const int8_t ov_bilinear_filters_4[15][2] =
 
 static void
 put_vvc_pel_uni_pixels(uint16_t* _dst, ptrdiff_t _dststride,
-                       const uint16_t* _src, ptrdiff_t _srcstride, int height,
+                       const OVSample* _src, ptrdiff_t _srcstride, int height,
                        intptr_t mx, intptr_t my, int width)
 {
     int y;
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
     ptrdiff_t srcstride = _srcstride;
     uint16_t* dst = (uint16_t*)_dst;
     ptrdiff_t dststride = _dststride;
 
     for (y = 0; y < height; y++) {
-        memcpy(dst, src, width * sizeof(uint16_t));
+        int x;
+        for (x = 0; x < width; ++x) {
+            dst[x] = src[x];
+        }
         src += srcstride;
         dst += dststride;
     }
@@ -151,11 +154,11 @@ put_vvc_pel_uni_pixels(uint16_t* _dst, ptrdiff_t _dststride,
 /*FIXME It might actually be better to use one function for bi pred instead of
  * 2*/
 static void
-put_vvc_pel_pixels(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
+put_vvc_pel_pixels(int16_t* _dst, const OVSample* _src, ptrdiff_t _srcstride,
                    int height, intptr_t mx, intptr_t my, int width)
 {
     int x, y;
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
 
     int16_t* dst = (int16_t*)_dst;
 
@@ -163,7 +166,7 @@ put_vvc_pel_pixels(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; ++x) {
-            dst[x] = src[x] << (14 - BIT_DEPTH);
+            dst[x] = src[x] << (14 - BITDEPTH);
         }
         src += srcstride;
         dst += MAX_PB_SIZE;
@@ -172,23 +175,23 @@ put_vvc_pel_pixels(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
 
 static void
 put_vvc_pel_bi_pixels(uint16_t* _dst, ptrdiff_t _dststride,
-                      const uint16_t* _src0, ptrdiff_t _srcstride,
+                      const OVSample* _src0, ptrdiff_t _srcstride,
                       const int16_t* _src1, int height, intptr_t mx,
                       intptr_t my, int width)
 {
     int x, y;
-    const uint16_t* src0 = _src0;
+    const OVSample* src0 = _src0;
     const int16_t* src1 = _src1;
     ptrdiff_t srcstride = _srcstride;
     uint16_t* dst = (uint16_t*)_dst;
     ptrdiff_t dststride = _dststride;
-    int shift = 14 - BIT_DEPTH + 1;
+    int shift = 14 - BITDEPTH + 1;
     int offset = 1 << (shift - 1);
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; ++x) {
             dst[x] = ov_clip_pixel(
-                                   ((src0[x] << (14 - BIT_DEPTH)) + src1[x] + offset) >>
+                                   ((src0[x] << (14 - BITDEPTH)) + src1[x] + offset) >>
                                    shift);
         }
         src0 += srcstride;
@@ -198,23 +201,23 @@ put_vvc_pel_bi_pixels(uint16_t* _dst, ptrdiff_t _dststride,
 }
 
 static void
-put_vvc_qpel_uni_h(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src,
+put_vvc_qpel_uni_h(uint16_t* _dst, ptrdiff_t _dststride, const OVSample* _src,
                    ptrdiff_t _srcstride, int height, intptr_t mx, intptr_t my,
                    int width)
 {
     int x, y;
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
     ptrdiff_t srcstride = _srcstride;
     uint16_t* dst = (uint16_t*)_dst;
     ptrdiff_t dststride = _dststride;
     const int8_t* filter = width == 4 && height == 4 ? ov_mc_filters_4[mx - 1] : ov_mc_filters[mx - 1];
-    int shift = 14 - BIT_DEPTH;
+    int shift = 14 - BITDEPTH;
     int offset = 1 << (shift - 1);
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
             dst[x] = ov_clip_pixel(
-                                   ((MCP_FILTER_L(src, 1, filter) >> (BIT_DEPTH - 8)) +
+                                   ((MCP_FILTER_L(src, 1, filter) >> (BITDEPTH - 8)) +
                                     offset) >> shift);
         }
         src += srcstride;
@@ -223,24 +226,24 @@ put_vvc_qpel_uni_h(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src,
 }
 
 static void
-put_vvc_qpel_uni_v(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src,
+put_vvc_qpel_uni_v(uint16_t* _dst, ptrdiff_t _dststride, const OVSample* _src,
                    ptrdiff_t _srcstride, int height, intptr_t mx, intptr_t my,
                    int width)
 {
     int x, y;
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
     ptrdiff_t srcstride = _srcstride;
     uint16_t* dst = (uint16_t*)_dst;
     ptrdiff_t dststride = _dststride;
     const int8_t* filter = width == 4 && height == 4 ? ov_mc_filters_4[my - 1] : ov_mc_filters[my - 1];
-    int shift = 14 - BIT_DEPTH;
+    int shift = 14 - BITDEPTH;
     int offset = 1 << (shift - 1);
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
             dst[x] =
                 ov_clip_pixel(((MCP_FILTER_L(src, srcstride, filter) >>
-                                (BIT_DEPTH - 8)) + offset) >> shift);
+                                (BITDEPTH - 8)) + offset) >> shift);
         }
         src += srcstride;
         dst += dststride;
@@ -248,26 +251,26 @@ put_vvc_qpel_uni_v(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src,
 }
 
 static void
-put_vvc_qpel_uni_hv(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src,
+put_vvc_qpel_uni_hv(uint16_t* _dst, ptrdiff_t _dststride, const OVSample* _src,
                     ptrdiff_t _srcstride, int height, intptr_t mx, intptr_t my,
                     int width)
 {
     int x, y;
     const int8_t* filter;
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
     ptrdiff_t srcstride = _srcstride;
     uint16_t* dst = (uint16_t*)_dst;
     ptrdiff_t dststride = _dststride;
     int16_t tmp_array[(MAX_PB_SIZE + QPEL_EXTRA) * MAX_PB_SIZE];
     int16_t* tmp = tmp_array;
-    int shift = 14 - BIT_DEPTH;
+    int shift = 14 - BITDEPTH;
     int offset = 1 << (shift - 1);
 
     src -= QPEL_EXTRA_BEFORE * srcstride;
     filter = width == 4 && height == 4 ? ov_mc_filters_4[mx - 1] : ov_mc_filters[mx - 1];
     for (y = 0; y < height + QPEL_EXTRA; y++) {
         for (x = 0; x < width; x++) {
-            tmp[x] = MCP_FILTER_L(src, 1, filter) >> (BIT_DEPTH - 8);
+            tmp[x] = MCP_FILTER_L(src, 1, filter) >> (BITDEPTH - 8);
         }
         src += srcstride;
         tmp += MAX_PB_SIZE;
@@ -289,34 +292,37 @@ put_vvc_qpel_uni_hv(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src,
 
 static void
 put_vvc_pel_bilinear_pixels(uint16_t* _dst, ptrdiff_t _dststride,
-                            const uint16_t* _src, ptrdiff_t _srcstride, int height,
+                            const OVSample* _src, ptrdiff_t _srcstride, int height,
                             intptr_t mx, intptr_t my, int width)
 {
     int y;
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
     ptrdiff_t srcstride = _srcstride;
     uint16_t* dst = (uint16_t*)_dst;
     ptrdiff_t dststride = _dststride;
 
     for (y = 0; y < height; y++) {
-        memcpy(dst, src, width * sizeof(uint16_t));
+        int x;
+        for (x = 0; x < width; ++x) {
+            dst[x] = src[x];
+        }
         src += srcstride;
         dst += dststride;
     }
 }
 
 static void
-put_vvc_qpel_bilinear_h(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src,
+put_vvc_qpel_bilinear_h(uint16_t* _dst, ptrdiff_t _dststride, const OVSample* _src,
                         ptrdiff_t _srcstride, int height, intptr_t mx, intptr_t my,
                         int width)
 {
     int x, y;
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
     ptrdiff_t srcstride = _srcstride;
     uint16_t* dst = (uint16_t*)_dst;
     ptrdiff_t dststride = _dststride;
     const int8_t* filter = ov_bilinear_filters_4[mx - 1];
-    int shift = 14 - BIT_DEPTH;
+    int shift = 14 - BITDEPTH;
     int offset = 1 << (shift - 1);
 
     src += 1;
@@ -331,17 +337,17 @@ put_vvc_qpel_bilinear_h(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _s
 }
 
 static void
-put_vvc_qpel_bilinear_v(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src,
+put_vvc_qpel_bilinear_v(uint16_t* _dst, ptrdiff_t _dststride, const OVSample* _src,
                         ptrdiff_t _srcstride, int height, intptr_t mx, intptr_t my,
                         int width)
 {
     int x, y;
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
     ptrdiff_t srcstride = _srcstride;
     uint16_t* dst = (uint16_t*)_dst;
     ptrdiff_t dststride = _dststride;
     const int8_t* filter = ov_bilinear_filters_4[my - 1];
-    int shift = 14 - BIT_DEPTH;
+    int shift = 14 - BITDEPTH;
     int offset = 1 << (shift - 1);
 
     src += srcstride;
@@ -356,20 +362,20 @@ put_vvc_qpel_bilinear_v(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _s
 }
 
 static void
-put_vvc_qpel_bilinear_hv(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src,
+put_vvc_qpel_bilinear_hv(uint16_t* _dst, ptrdiff_t _dststride, const OVSample* _src,
                          ptrdiff_t _srcstride, int height, intptr_t mx, intptr_t my,
                          int width)
 {
     int x, y;
     const int8_t* filter;
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
     ptrdiff_t srcstride = _srcstride;
     uint16_t* dst = (uint16_t*)_dst;
     ptrdiff_t dststride = _dststride;
     int16_t tmp_array[(MAX_PB_SIZE + QPEL_EXTRA) * MAX_PB_SIZE];
     int16_t* tmp = tmp_array;
 
-    int shift = 14 - BIT_DEPTH;
+    int shift = 14 - BITDEPTH;
     int offset = 1 << (shift - 1);
 
     filter = ov_bilinear_filters_4[mx - 1];
@@ -396,11 +402,11 @@ put_vvc_qpel_bilinear_hv(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _
 }
 
 static void
-put_vvc_qpel_h(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
+put_vvc_qpel_h(int16_t* _dst, const OVSample* _src, ptrdiff_t _srcstride,
                int height, intptr_t mx, intptr_t my, int width)
 {
     int x, y;
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
 
     int16_t* dst = (int16_t*)_dst;
 
@@ -411,7 +417,7 @@ put_vvc_qpel_h(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
-            dst[x] = MCP_FILTER_L(src, 1, filter) >> (BIT_DEPTH - 8);
+            dst[x] = MCP_FILTER_L(src, 1, filter) >> (BITDEPTH - 8);
         }
         src += srcstride;
         dst += MAX_PB_SIZE;
@@ -419,11 +425,11 @@ put_vvc_qpel_h(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
 }
 
 static void
-put_vvc_qpel_v(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
+put_vvc_qpel_v(int16_t* _dst, const OVSample* _src, ptrdiff_t _srcstride,
                int height, intptr_t mx, intptr_t my, int width)
 {
     int x, y;
-    const uint16_t* src = (uint16_t*)_src;
+    const OVSample* src = (const OVSample*)_src;
 
     int16_t* dst = (int16_t*)_dst;
 
@@ -435,7 +441,7 @@ put_vvc_qpel_v(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
             dst[x] = MCP_FILTER_L(src, srcstride, filter) >>
-                (BIT_DEPTH - 8);
+                (BITDEPTH - 8);
         }
         src += srcstride;
         dst += MAX_PB_SIZE;
@@ -443,12 +449,12 @@ put_vvc_qpel_v(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
 }
 
 static void
-put_vvc_qpel_hv(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
+put_vvc_qpel_hv(int16_t* _dst, const OVSample* _src, ptrdiff_t _srcstride,
                 int height, intptr_t mx, intptr_t my, int width)
 {
     int x, y;
 
-    const uint16_t* src = (uint16_t*)_src;
+    const OVSample* src = (const OVSample*)_src;
 
     int16_t* dst = (int16_t*)_dst;
 
@@ -464,7 +470,7 @@ put_vvc_qpel_hv(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
 
     for (y = 0; y < height + QPEL_EXTRA; y++) {
         for (x = 0; x < width; x++) {
-            tmp[x] = MCP_FILTER_L(src, 1, filter) >> (BIT_DEPTH - 8);
+            tmp[x] = MCP_FILTER_L(src, 1, filter) >> (BITDEPTH - 8);
         }
         src += srcstride;
         tmp += MAX_PB_SIZE;
@@ -484,12 +490,12 @@ put_vvc_qpel_hv(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
 }
 
 static void
-put_vvc_qpel_bi_h(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
+put_vvc_qpel_bi_h(uint16_t* _dst, ptrdiff_t _dststride, const OVSample* _src0,
                   ptrdiff_t _srcstride, const int16_t* _src1, int height,
                   intptr_t mx, intptr_t my, int width)
 {
     int x, y;
-    const uint16_t* src0 = _src0;
+    const OVSample* src0 = _src0;
     const int16_t* src1 = _src1;
 
     uint16_t* dst = (uint16_t*)_dst;
@@ -500,13 +506,13 @@ put_vvc_qpel_bi_h(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
     const int8_t* filter = ov_mc_filters[mx - 1];
     filter = width == 4 && height == 4 ? ov_mc_filters_4[mx - 1] : ov_mc_filters[mx - 1];
 
-    int shift = 14 + 1 - BIT_DEPTH;
+    int shift = 14 + 1 - BITDEPTH;
     int offset = 1 << (shift - 1);
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
             dst[x] = ov_clip_pixel(
-                                   ((MCP_FILTER_L(src0, 1, filter) >> (BIT_DEPTH - 8)) +
+                                   ((MCP_FILTER_L(src0, 1, filter) >> (BITDEPTH - 8)) +
                                     src1[x] + offset) >> shift);
         }
         src0 += srcstride;
@@ -516,12 +522,12 @@ put_vvc_qpel_bi_h(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
 }
 
 static void
-put_vvc_qpel_bi_v(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
+put_vvc_qpel_bi_v(uint16_t* _dst, ptrdiff_t _dststride, const OVSample* _src0,
                   ptrdiff_t _srcstride, const int16_t* _src1, int height,
                   intptr_t mx, intptr_t my, int width)
 {
     int x, y;
-    const uint16_t* src0 = _src0;
+    const OVSample* src0 = _src0;
     const int16_t* src1 = _src1;
 
     uint16_t* dst = (uint16_t*)_dst;
@@ -532,14 +538,14 @@ put_vvc_qpel_bi_v(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
     const int8_t* filter = ov_mc_filters[my - 1];
     filter = width == 4 && height == 4 ? ov_mc_filters_4[my - 1] : ov_mc_filters[my - 1];
 
-    int shift = 14 + 1 - BIT_DEPTH;
+    int shift = 14 + 1 - BITDEPTH;
     int offset = 1 << (shift - 1);
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
             dst[x] = ov_clip_pixel(
                                    ((MCP_FILTER_L(src0, srcstride, filter) >>
-                                     (BIT_DEPTH - 8)) +
+                                     (BITDEPTH - 8)) +
                                     src1[x] + offset) >> shift);
         }
         src0 += srcstride;
@@ -549,13 +555,13 @@ put_vvc_qpel_bi_v(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
 }
 
 static void
-put_vvc_qpel_bi_hv(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
+put_vvc_qpel_bi_hv(uint16_t* _dst, ptrdiff_t _dststride, const OVSample* _src0,
                    ptrdiff_t _srcstride, const int16_t* _src1, int height,
                    intptr_t mx, intptr_t my, int width)
 {
     int x, y;
 
-    const uint16_t* src0 = _src0;
+    const OVSample* src0 = _src0;
     const int16_t* src1 = _src1;
     uint16_t* dst = (uint16_t*)_dst;
 
@@ -568,7 +574,7 @@ put_vvc_qpel_bi_hv(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
     const int8_t* filter = ov_mc_filters[mx - 1];
     filter = width == 4 && height == 4 ? ov_mc_filters_4[mx - 1] : ov_mc_filters[mx - 1];
 
-    int shift = 14 + 1 - BIT_DEPTH;
+    int shift = 14 + 1 - BITDEPTH;
     int offset = 1 << (shift - 1);
 
     src0 -= QPEL_EXTRA_BEFORE * srcstride;
@@ -576,7 +582,7 @@ put_vvc_qpel_bi_hv(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
     for (y = 0; y < height + QPEL_EXTRA; y++) {
         for (x = 0; x < width; x++) {
             tmp[x] =
-                MCP_FILTER_L(src0, 1, filter) >> (BIT_DEPTH - 8);
+                MCP_FILTER_L(src0, 1, filter) >> (BITDEPTH - 8);
         }
         src0 += srcstride;
         tmp += MAX_PB_SIZE;
@@ -599,23 +605,23 @@ put_vvc_qpel_bi_hv(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
 }
 
 static void
-put_vvc_epel_uni_h(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src,
+put_vvc_epel_uni_h(uint16_t* _dst, ptrdiff_t _dststride, const OVSample* _src,
                    ptrdiff_t _srcstride, int height, intptr_t mx, intptr_t my,
                    int width)
 {
     int x, y;
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
     ptrdiff_t srcstride = _srcstride;
     uint16_t* dst = (uint16_t*)_dst;
     ptrdiff_t dststride = _dststride;
     const int8_t* filter = ov_mcp_filters_c[mx - 1];
-    int shift = 14 - BIT_DEPTH;
+    int shift = 14 - BITDEPTH;
     int offset = 1 << (shift - 1);
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
             dst[x] = ov_clip_pixel(
-                                   ((MCP_FILTER_C(src, 1, filter) >> (BIT_DEPTH - 8)) +
+                                   ((MCP_FILTER_C(src, 1, filter) >> (BITDEPTH - 8)) +
                                     offset) >> shift);
         }
         src += srcstride;
@@ -624,24 +630,24 @@ put_vvc_epel_uni_h(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src,
 }
 
 static void
-put_vvc_epel_uni_v(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src,
+put_vvc_epel_uni_v(uint16_t* _dst, ptrdiff_t _dststride, const OVSample* _src,
                    ptrdiff_t _srcstride, int height, intptr_t mx, intptr_t my,
                    int width)
 {
     int x, y;
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
     ptrdiff_t srcstride = _srcstride;
     uint16_t* dst = (uint16_t*)_dst;
     ptrdiff_t dststride = _dststride;
     const int8_t* filter = ov_mcp_filters_c[my - 1];
-    int shift = 14 - BIT_DEPTH;
+    int shift = 14 - BITDEPTH;
     int offset = 1 << (shift - 1);
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
             dst[x] =
                 ov_clip_pixel(((MCP_FILTER_C(src, srcstride, filter) >>
-                                (BIT_DEPTH - 8)) + offset) >> shift);
+                                (BITDEPTH - 8)) + offset) >> shift);
         }
         src += srcstride;
         dst += dststride;
@@ -649,26 +655,26 @@ put_vvc_epel_uni_v(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src,
 }
 
 static void
-put_vvc_epel_uni_hv(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src,
+put_vvc_epel_uni_hv(uint16_t* _dst, ptrdiff_t _dststride, const OVSample* _src,
                     ptrdiff_t _srcstride, int height, intptr_t mx, intptr_t my,
                     int width)
 {
     int x, y;
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
     ptrdiff_t srcstride = _srcstride;
     uint16_t* dst = (uint16_t*)_dst;
     ptrdiff_t dststride = _dststride;
     const int8_t* filter = ov_mcp_filters_c[mx - 1];
     int16_t tmp_array[(MAX_PB_SIZE + EPEL_EXTRA) * MAX_PB_SIZE];
     int16_t* tmp = tmp_array;
-    int shift = 14 - BIT_DEPTH;
+    int shift = 14 - BITDEPTH;
     int offset = 1 << (shift - 1);
 
     src -= EPEL_EXTRA_BEFORE * srcstride;
 
     for (y = 0; y < height + EPEL_EXTRA; y++) {
         for (x = 0; x < width; x++) {
-            tmp[x] = MCP_FILTER_C(src, 1, filter) >> (BIT_DEPTH - 8);
+            tmp[x] = MCP_FILTER_C(src, 1, filter) >> (BITDEPTH - 8);
         }
         src += srcstride;
         tmp += MAX_PB_SIZE;
@@ -689,12 +695,12 @@ put_vvc_epel_uni_hv(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src,
 }
 
 static void
-put_vvc_epel_h(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
+put_vvc_epel_h(int16_t* _dst, const OVSample* _src, ptrdiff_t _srcstride,
                int height, intptr_t mx, intptr_t my, int width)
 {
     int x, y;
 
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
 
     int16_t* dst = (int16_t*)_dst;
 
@@ -704,7 +710,7 @@ put_vvc_epel_h(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
-            dst[x] = MCP_FILTER_C(src, 1, filter) >> (BIT_DEPTH - 8);
+            dst[x] = MCP_FILTER_C(src, 1, filter) >> (BITDEPTH - 8);
         }
         src += srcstride;
         dst += MAX_PB_SIZE;
@@ -712,12 +718,12 @@ put_vvc_epel_h(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
 }
 
 static void
-put_vvc_epel_v(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
+put_vvc_epel_v(int16_t* _dst, const OVSample* _src, ptrdiff_t _srcstride,
                int height, intptr_t mx, intptr_t my, int width)
 {
     int x, y;
 
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
 
     int16_t* dst = (int16_t*)_dst;
 
@@ -728,7 +734,7 @@ put_vvc_epel_v(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
             dst[x] = MCP_FILTER_C(src, srcstride, filter) >>
-                (BIT_DEPTH - 8);
+                (BITDEPTH - 8);
         }
         src += srcstride;
         dst += MAX_PB_SIZE;
@@ -736,11 +742,11 @@ put_vvc_epel_v(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
 }
 
 static void
-put_vvc_epel_hv(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
+put_vvc_epel_hv(int16_t* _dst, const OVSample* _src, ptrdiff_t _srcstride,
                 int height, intptr_t mx, intptr_t my, int width)
 {
     int x, y;
-    const uint16_t* src = _src;
+    const OVSample* src = _src;
 
     int16_t* dst = (int16_t*)_dst;
 
@@ -755,7 +761,7 @@ put_vvc_epel_hv(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
 
     for (y = 0; y < height + EPEL_EXTRA; y++) {
         for (x = 0; x < width; x++) {
-            tmp[x] = MCP_FILTER_C(src, 1, filter) >> (BIT_DEPTH - 8);
+            tmp[x] = MCP_FILTER_C(src, 1, filter) >> (BITDEPTH - 8);
         }
         src += srcstride;
         tmp += MAX_PB_SIZE;
@@ -774,12 +780,12 @@ put_vvc_epel_hv(int16_t* _dst, const uint16_t* _src, ptrdiff_t _srcstride,
 }
 
 static void
-put_vvc_epel_bi_h(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
+put_vvc_epel_bi_h(uint16_t* _dst, ptrdiff_t _dststride, const OVSample* _src0,
                   ptrdiff_t _srcstride, const int16_t* _src1, int height,
                   intptr_t mx, intptr_t my, int width)
 {
     int x, y;
-    const uint16_t* src0 = _src0;
+    const OVSample* src0 = _src0;
     const int16_t* src1 = (int16_t*)_src1;
 
     uint16_t* dst = (uint16_t*)_dst;
@@ -789,13 +795,13 @@ put_vvc_epel_bi_h(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
 
     const int8_t* filter = ov_mcp_filters_c[mx - 1];
 
-    int shift = 14 + 1 - BIT_DEPTH;
+    int shift = 14 + 1 - BITDEPTH;
     int offset = 1 << (shift - 1);
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
             dst[x] = ov_clip_pixel(
-                                   ((MCP_FILTER_C(src0, 1, filter) >> (BIT_DEPTH - 8)) +
+                                   ((MCP_FILTER_C(src0, 1, filter) >> (BITDEPTH - 8)) +
                                     src1[x] + offset) >> shift);
         }
         src0 += srcstride;
@@ -806,12 +812,12 @@ put_vvc_epel_bi_h(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
 
 
 static void
-put_vvc_epel_bi_v(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
+put_vvc_epel_bi_v(uint16_t* _dst, ptrdiff_t _dststride, const OVSample* _src0,
                   ptrdiff_t _srcstride, const int16_t* _src1, int height,
                   intptr_t mx, intptr_t my, int width)
 {
     int x, y;
-    const uint16_t* src0 = _src0;
+    const OVSample* src0 = _src0;
     const int16_t* src1 = _src1;
 
     uint16_t* dst = (uint16_t*)_dst;
@@ -821,14 +827,14 @@ put_vvc_epel_bi_v(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
 
     const int8_t* filter = ov_mcp_filters_c[my - 1];
 
-    int shift = 14 + 1 - BIT_DEPTH;
+    int shift = 14 + 1 - BITDEPTH;
     int offset = 1 << (shift - 1);
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
             dst[x] = ov_clip_pixel(
                                    ((MCP_FILTER_C(src0, srcstride, filter) >>
-                                     (BIT_DEPTH - 8)) +
+                                     (BITDEPTH - 8)) +
                                     src1[x] + offset) >> shift);
         }
         src0 += srcstride;
@@ -838,12 +844,12 @@ put_vvc_epel_bi_v(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
 }
 
 static void
-put_vvc_epel_bi_hv(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
+put_vvc_epel_bi_hv(uint16_t* _dst, ptrdiff_t _dststride, const OVSample* _src0,
                    ptrdiff_t _srcstride, const int16_t* _src1, int height,
                    intptr_t mx, intptr_t my, int width)
 {
     int x, y;
-    const uint16_t* src0 = _src0;
+    const OVSample* src0 = _src0;
     const int16_t* src1 = _src1;
 
     uint16_t* dst = (uint16_t*)_dst;
@@ -856,7 +862,7 @@ put_vvc_epel_bi_hv(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
 
     const int8_t* filter = ov_mcp_filters_c[mx - 1];
 
-    int shift = 14 + 1 - BIT_DEPTH;
+    int shift = 14 + 1 - BITDEPTH;
     int offset = 1 << (shift - 1);
 
     src0 -= EPEL_EXTRA_BEFORE * srcstride;
@@ -864,7 +870,7 @@ put_vvc_epel_bi_hv(uint16_t* _dst, ptrdiff_t _dststride, const uint16_t* _src0,
     for (y = 0; y < height + EPEL_EXTRA; y++) {
         for (x = 0; x < width; x++) {
             tmp[x] =
-                MCP_FILTER_C(src0, 1, filter) >> (BIT_DEPTH - 8);
+                MCP_FILTER_C(src0, 1, filter) >> (BITDEPTH - 8);
         }
         src0 += srcstride;
         tmp += MAX_PB_SIZE;
@@ -892,22 +898,22 @@ put_weighted_epel_bi_h(uint8_t* _dst, ptrdiff_t _dststride, uint8_t* _src, ptrdi
                   int wx0, int wx1, intptr_t mx, intptr_t my, int width)
 {
     int x, y;
-    const uint16_t* src = (uint16_t*) _src;
+    const OVSample* src = (const OVSample*)_src;
     uint16_t* dst = (uint16_t*)_dst;
 
-    ptrdiff_t srcstride = _srcstride >> 1;
+    ptrdiff_t srcstride = _srcstride / sizeof(OVSample);
     ptrdiff_t dststride = _dststride >> 1;
 
     const int8_t* filter = ov_mcp_filters_c[mx - 1];
 
     denom = floor_log2(wx0 + wx1);
-    int shift = 14 + denom -BIT_DEPTH;
+    int shift = 14 + denom -BITDEPTH;
     int offset = 1 << (shift - 1);
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
             dst[x] = ov_clip_pixel(
-                                   ((MCP_FILTER_C(src, 1, filter) >> (BIT_DEPTH - 8)) * wx1 +
+                                   ((MCP_FILTER_C(src, 1, filter) >> (BITDEPTH - 8)) * wx1 +
                                     src2[x] * wx0 + offset) >> shift);
         }
         src += srcstride;
@@ -922,25 +928,25 @@ put_weighted_epel_bi_v(uint8_t* _dst, ptrdiff_t _dststride, uint8_t* _src, ptrdi
                   int wx0, int wx1, intptr_t mx, intptr_t my, int width)
 {
     int x, y;
-    const uint16_t* src = (uint16_t*) _src;
+    const OVSample* src = (const OVSample*)_src;
     
 
     uint16_t* dst = (uint16_t*)_dst;
 
-    ptrdiff_t srcstride = _srcstride >> 1;
+    ptrdiff_t srcstride = _srcstride / sizeof(OVSample);
     ptrdiff_t dststride = _dststride >> 1;
 
     const int8_t* filter = ov_mcp_filters_c[my - 1];
 
     denom = floor_log2(wx0 + wx1);
-    int shift = 14 + denom -BIT_DEPTH;
+    int shift = 14 + denom -BITDEPTH;
     int offset = 1 << (shift - 1);
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
             dst[x] = ov_clip_pixel(
                                    ((MCP_FILTER_C(src, srcstride, filter) >>
-                                     (BIT_DEPTH - 8)) * wx1 +
+                                     (BITDEPTH - 8)) * wx1 +
                                     src2[x] * wx0 + offset) >> shift);
         }
         src += srcstride;
@@ -955,12 +961,12 @@ put_weighted_epel_bi_hv(uint8_t* _dst, ptrdiff_t _dststride, uint8_t* _src, ptrd
                    int wx0, int wx1, intptr_t mx, intptr_t my, int width)
 {
     int x, y;
-    const uint16_t* src = (uint16_t*) _src;
+    const OVSample* src = (const OVSample*)_src;
     
 
     uint16_t* dst = (uint16_t*)_dst;
 
-    ptrdiff_t srcstride = _srcstride >> 1;
+    ptrdiff_t srcstride = _srcstride / sizeof(OVSample);
     ptrdiff_t dststride = _dststride >> 1;
 
     int16_t tmp_array[(MAX_PB_SIZE + EPEL_EXTRA) * MAX_PB_SIZE];
@@ -969,7 +975,7 @@ put_weighted_epel_bi_hv(uint8_t* _dst, ptrdiff_t _dststride, uint8_t* _src, ptrd
     const int8_t* filter = ov_mcp_filters_c[mx - 1];
 
     denom = floor_log2(wx0 + wx1);
-    int shift = 14 + denom -BIT_DEPTH;
+    int shift = 14 + denom -BITDEPTH;
     int offset = 1 << (shift - 1);
 
     src -= EPEL_EXTRA_BEFORE * srcstride;
@@ -977,7 +983,7 @@ put_weighted_epel_bi_hv(uint8_t* _dst, ptrdiff_t _dststride, uint8_t* _src, ptrd
     for (y = 0; y < height + EPEL_EXTRA; y++) {
         for (x = 0; x < width; x++) {
             tmp[x] =
-                MCP_FILTER_C(src, 1, filter) >> (BIT_DEPTH - 8);
+                MCP_FILTER_C(src, 1, filter) >> (BITDEPTH - 8);
         }
         src += srcstride;
         tmp += MAX_PB_SIZE;
@@ -1004,17 +1010,17 @@ put_weighted_pel_bi_pixels(uint8_t* _dst, ptrdiff_t _dststride, uint8_t* _src, p
                   int wx0, int wx1, intptr_t mx, intptr_t my, int width)
 {   
     int x, y;
-    const uint16_t* src = (uint16_t*) _src;
+    const OVSample* src = (const OVSample*)_src;
     
-    ptrdiff_t srcstride = _srcstride >> 1;
+    ptrdiff_t srcstride = _srcstride / sizeof(OVSample);
     uint16_t* dst = (uint16_t*)_dst;
     ptrdiff_t dststride = _dststride >> 1;
-    int shift = 14 - BIT_DEPTH + 3;
+    int shift = 14 - BITDEPTH + 3;
     int offset = (1 << (shift - 1)) ;
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; ++x) {
             dst[x] = ov_clip_pixel( ( (src2[x]  * wx0
-                                        + ((src[x] * wx1) << (14 - BIT_DEPTH)) + offset )  >> shift ) );
+                                        + ((src[x] * wx1) << (14 - BITDEPTH)) + offset )  >> shift ) );
         }
         src2 += MAX_PB_SIZE;
         src += srcstride;
@@ -1028,25 +1034,25 @@ put_weighted_qpel_bi_h(uint8_t* _dst, ptrdiff_t _dststride, uint8_t* _src, ptrdi
                   int wx0, int wx1, intptr_t mx, intptr_t my, int width)
 {
     int x, y;
-    const uint16_t* src = (uint16_t*) _src;
+    const OVSample* src = (const OVSample*)_src;
     
 
     uint16_t* dst = (uint16_t*)_dst;
 
-    ptrdiff_t srcstride = _srcstride >> 1;
+    ptrdiff_t srcstride = _srcstride / sizeof(OVSample);
     ptrdiff_t dststride = _dststride >> 1;
 
     const int8_t* filter;
     filter = width == 4 && height == 4 ? ov_mc_filters_4[mx - 1] : ov_mc_filters[mx - 1];
 
     denom = floor_log2(wx0 + wx1);
-    int shift = 14 + denom -BIT_DEPTH;
+    int shift = 14 + denom -BITDEPTH;
     int offset = 1 << (shift - 1);
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
             dst[x] = ov_clip_pixel(
-                                   ((MCP_FILTER_L(src, 1, filter) >> (BIT_DEPTH - 8)) * wx1 +
+                                   ((MCP_FILTER_L(src, 1, filter) >> (BITDEPTH - 8)) * wx1 +
                                     src2[x] * wx0 + offset) >> shift);
         }
         src += srcstride;
@@ -1062,26 +1068,26 @@ put_weighted_qpel_bi_v(uint8_t* _dst, ptrdiff_t _dststride, uint8_t* _src, ptrdi
                   int wx0, int wx1, intptr_t mx, intptr_t my, int width)
 {
     int x, y;
-    const uint16_t* src = (uint16_t*) _src;
+    const OVSample* src = (const OVSample*)_src;
     
 
     uint16_t* dst = (uint16_t*)_dst;
 
-    ptrdiff_t srcstride = _srcstride >> 1;
+    ptrdiff_t srcstride = _srcstride / sizeof(OVSample);
     ptrdiff_t dststride = _dststride >> 1;
 
     const int8_t* filter;
     filter = width == 4 && height == 4 ? ov_mc_filters_4[my - 1] : ov_mc_filters[my - 1];
 
     denom = floor_log2(wx0 + wx1);
-    int shift = 14 + denom -BIT_DEPTH;
+    int shift = 14 + denom -BITDEPTH;
     int offset = 1 << (shift - 1);
 
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++) {
             dst[x] = ov_clip_pixel(
                                    ((MCP_FILTER_L(src, srcstride, filter) >>
-                                     (BIT_DEPTH - 8)) * wx1 +
+                                     (BITDEPTH - 8)) * wx1 +
                                     src2[x] * wx0 + offset) >> shift);
         }
         src += srcstride;
@@ -1097,11 +1103,11 @@ put_weighted_qpel_bi_hv(uint8_t* _dst, ptrdiff_t _dststride, uint8_t* _src, ptrd
 {
     int x, y;
 
-    const uint16_t* src = (uint16_t*) _src;
+    const OVSample* src = (const OVSample*)_src;
     
     uint16_t* dst = (uint16_t*)_dst;
 
-    ptrdiff_t srcstride = _srcstride >> 1;
+    ptrdiff_t srcstride = _srcstride / sizeof(OVSample);
     ptrdiff_t dststride = _dststride >> 1;
 
     int16_t tmp_array[(MAX_PB_SIZE + QPEL_EXTRA) * MAX_PB_SIZE];
@@ -1111,7 +1117,7 @@ put_weighted_qpel_bi_hv(uint8_t* _dst, ptrdiff_t _dststride, uint8_t* _src, ptrd
     filter = width == 4 && height == 4 ? ov_mc_filters_4[mx - 1] : ov_mc_filters[mx - 1];
 
     denom = floor_log2(wx0 + wx1);
-    int shift = 14 + denom -BIT_DEPTH;
+    int shift = 14 + denom -BITDEPTH;
     int offset = 1 << (shift - 1);
 
     src -= QPEL_EXTRA_BEFORE * srcstride;
@@ -1119,7 +1125,7 @@ put_weighted_qpel_bi_hv(uint8_t* _dst, ptrdiff_t _dststride, uint8_t* _src, ptrd
     for (y = 0; y < height + QPEL_EXTRA; y++) {
         for (x = 0; x < width; x++) {
             tmp[x] =
-                MCP_FILTER_L(src, 1, filter) >> (BIT_DEPTH - 8);
+                MCP_FILTER_L(src, 1, filter) >> (BITDEPTH - 8);
         }
         src += srcstride;
         tmp += MAX_PB_SIZE;
@@ -1171,7 +1177,7 @@ put_weighted_gpm_bi_pixels(uint16_t* _dst, int _dststride, const int16_t* _src0,
     ptrdiff_t srcstride = _srcstride;
     uint16_t* dst = (uint16_t*)_dst;
     ptrdiff_t dststride = _dststride;
-    int shift = 14 - BIT_DEPTH + 3;
+    int shift = 14 - BITDEPTH + 3;
     int offset = (1 << (shift - 1)) ;
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; ++x) {
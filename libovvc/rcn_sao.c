@@ -7,30 +7,28 @@
 #include "ovframe.h"
 #include "ovdpb.h"
 #include "slicedec.h"
+#include "bitdepth.h"
 
 // #include "dec_structures.h"
 // #include "ctudec.h"
 
-#define BIT_DEPTH 10
-
 static void sao_band_filter(uint8_t *_dst, uint8_t *_src,
         ptrdiff_t stride_dst, ptrdiff_t stride_src,
         SAOParamsCtu *sao,
          int width, int height,
         int c_idx)
 {
-    int16_t *dst = (int16_t *)_dst;
+    OVSample *dst = (OVSample *)_dst;
     int16_t *src = (int16_t *)_src;
     int offset_table[32] = { 0 };
     int k, y, x;
-    //BITDEPTH: uniquement pour bitdepth 10
-    int shift  = BIT_DEPTH - 5;
+    int shift  = BITDEPTH - 5;
 
     int16_t *sao_offset_val = sao->offset_val[c_idx];
     uint8_t sao_left_class  = sao->band_position[c_idx];
 
     stride_src /= sizeof(int16_t);
-    stride_dst /= sizeof(int16_t);
+    stride_dst /= sizeof(OVSample);
 
     for (k = 0; k < 4; k++)
         offset_table[(k + sao_left_class) & 31] = sao_offset_val[k];
@@ -38,9 +36,9 @@ static void sao_band_filter(uint8_t *_dst, uint8_t *_src,
     for (y = 0; y < height; y++) {
         for (x = 0; x < width; x++)
             #if 0
-            dst[x] = ov_clip_uintp2(src[x] + offset_table[src[x] >> shift], BIT_DEPTH);
+            dst[x] = ov_clip_uintp2(src[x] + offset_table[src[x] >> shift], BITDEPTH);
             #else
-            dst[x] = ov_clip(src[x] + offset_table[src[x] >> shift], 0, 1023);
+            dst[x] = ov_clip(src[x] + offset_table[src[x] >> shift], 0, OV_SAMPLE_MAX);
             #endif
         dst += stride_dst;
         src += stride_src;
@@ -67,11 +65,11 @@ static void sao_edge_filter(uint8_t *_dst, uint8_t *_src,
 
     int16_t *sao_offset_val = sao->offset_val[c_idx];
     uint8_t eo = sao->eo_class[c_idx];
-    int16_t *dst = (int16_t *)_dst;
+    OVSample *dst = (OVSample *)_dst;
     int16_t *src = (int16_t *)_src;
 
     stride_src /= sizeof(int16_t);
-    stride_dst /= sizeof(int16_t);
+    stride_dst /= sizeof(OVSample);
     int a_stride, b_stride;
     int src_offset = 0;
     int dst_offset = 0;
@@ -85,9 +83,9 @@ static void sao_edge_filter(uint8_t *_dst, uint8_t *_src,
             int diff1         = CMP(src[x + src_offset], src[x + src_offset + b_stride]);
             int offset_val    = 2 + diff0 + diff1;
             #if 0
-            dst[x + dst_offset] = ov_clip_uintp2( src[x + src_offset] + sao_offset_val[offset_val], BIT_DEPTH );
+            dst[x + dst_offset] = ov_clip_uintp2( src[x + src_offset] + sao_offset_val[offset_val], BITDEPTH );
             #else
-            dst[x + dst_offset] = ov_clip( src[x + src_offset] + sao_offset_val[offset_val], 0, 1023 );
+            dst[x + dst_offset] = ov_clip( src[x + src_offset] + sao_offset_val[offset_val], 0, OV_SAMPLE_MAX );
             #endif
         }
         src_offset += stride_src;
@@ -117,11 +115,10 @@ void rcn_sao_ctu(OVCTUDec *const ctudec, SAOParamsCtu *sao, int x_start_pic, int
         int width    = OVMIN(ctb_size_h, f_width - x0);
         int height   = OVMIN(ctb_size_v, f_height - y0);
 
-        //BITDEPTH: uniquement pour bitdepth 10
         int int16_t_shift = 1;
         ptrdiff_t stride_out_pic = frame->linesize[c_idx];
         uint8_t *out_pic = frame->data[c_idx];
-        out_pic = &out_pic[ y0 * stride_out_pic + (x0<<int16_t_shift)];
+        out_pic = &out_pic[ y0 * stride_out_pic + x0 * sizeof(OVSample)];
 
         uint8_t *filtered = (uint8_t *) fb->filter_region[c_idx];
         int stride_filtered = fb->filter_region_stride[c_idx]<<int16_t_shift;
@@ -158,7 +155,7 @@ void rcn_sao_ctu(OVCTUDec *const ctudec, SAOParamsCtu *sao, int x_start_pic, int
                 }
 
                 //parameters: buffer
-                int src_offset = y_start*stride_out_pic + x_start*sizeof(uint16_t);
+                int src_offset = y_start*stride_out_pic + x_start*sizeof(OVSample);
                 int dst_offset = y_start*stride_filtered + x_start*sizeof(uint16_t);
 
                 saofunc->edge[!(width % 8)](out_pic + src_offset, filtered + dst_offset, stride_out_pic, stride_filtered, sao, width, height, c_idx);
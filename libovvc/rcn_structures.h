@@ -6,6 +6,8 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "bitdepth.h"
+
 struct ALFClassifier;
 struct Area;
 struct CCLMParams;
@@ -22,16 +24,19 @@ enum DCTType
 
 #define NB_TR_SIZES 7
 
+/* Motion compensation reads reference samples from pictures planes
+ * and writes CTU reconstruction buffers
+ */
 typedef void (*MCUniDirFunc)(uint16_t *_dst, ptrdiff_t _dststride,
-                             const uint16_t *_src, ptrdiff_t _srcstride,
+                             const OVSample *_src, ptrdiff_t _srcstride,
                              int height, intptr_t mx, intptr_t my, int width);
 
 typedef void (*MCBiDir0Func)(int16_t *_dst,
-                             const uint16_t *_src, ptrdiff_t _srcstride,
+                             const OVSample *_src, ptrdiff_t _srcstride,
                              int height, intptr_t mx, intptr_t my, int width);
 
 typedef void (*MCBiDir1Func)(uint16_t *_dst, ptrdiff_t _dststride,
-                             const uint16_t *_src0, ptrdiff_t _srcstride,
+                             const OVSample *_src0, ptrdiff_t _srcstride,
                              const int16_t *_src1,
                              int height, intptr_t mx, intptr_t my, int width);
 
@@ -67,6 +72,13 @@ typedef void (*TrFunc)(const int16_t *src, int16_t *dst,
                  ptrdiff_t src_stride,
                  int num_lines, int num_columns, int shift);
 
+/* Last transform pass adding its num_lines output lines to
+ * reconstructed samples of stride RCN_CTB_STRIDE
+ */
+typedef void (*TrAddFunc)(const int16_t *src, uint16_t *dst,
+                          ptrdiff_t src_stride,
+                          int num_lines, int num_columns, int shift);
+
 typedef void (*DCFunc)(const uint16_t* const src_above,
                  const uint16_t* const src_left, uint16_t* const dst,
                  ptrdiff_t dst_stride, int log2_pb_w, int log2_pb_h);
@@ -75,6 +87,37 @@ typedef void (*PlanarFunc)(const uint16_t* const src_above,
                      const uint16_t* const src_left, uint16_t* const dst,
                      ptrdiff_t dst_stride, int log2_pb_w, int log2_pb_h);
 
+/* Decoder side refinement of bi-predicted (DMVR, BDOF) and affine
+ * (PROF) blocks from 14 bits intermediate MC samples
+ */
+typedef uint64_t (*DMVRSADFunc)(const int16_t *ref0, const int16_t *ref1,
+                                int16_t dmvr_stride, int16_t pb_w, int16_t pb_h);
+
+typedef uint8_t (*DMVRSADsFunc)(const int16_t *ref0, const int16_t *ref1,
+                                uint64_t *sad_array, int sb_w, int sb_h);
+
+typedef void (*RefineGradFunc)(const uint16_t* src, int src_stride, int sb_w, int sb_h,
+                               int grad_stride, int16_t* grad_x, int16_t* grad_y);
+
+typedef void (*BDOFFunc)(int16_t *dst, int dst_stride,
+                         const int16_t *ref_bdof0, const int16_t *ref_bdof1, int ref_stride,
+                         const int16_t *grad_x0, const int16_t *grad_y0,
+                         const int16_t *grad_x1, const int16_t *grad_y1,
+                         int grad_stride, uint8_t pb_w, uint8_t pb_h);
+
+typedef void (*PROFFunc)(uint16_t* dst, int dst_stride, const uint16_t* src, int src_stride,
+                         const int16_t* grad_x, const int16_t* grad_y, int grad_stride,
+                         const int32_t* dmv_scale_h, const int32_t* dmv_scale_v,
+                         uint8_t bidir);
+
+typedef void (*IntraAngularFunc)(const uint16_t* ref, uint16_t* dst,
+                                 ptrdiff_t dst_stride, int log2_pb_w,
+                                 int log2_pb_h, int angle_val);
+
+typedef void (*IntraAngularPDPCFunc)(const uint16_t* ref_abv, const uint16_t* ref_lft,
+                                     uint16_t* const dst, ptrdiff_t dst_stride,
+                                     int log2_pb_w, int log2_pb_h, int mode_idx);
+
 typedef void (*LFNSTFunc)(const int16_t* const src, int16_t* const dst,
                      const int8_t* const lfnst_matrix, int log2_tb_w,
                      int log2_tb_h);
@@ -94,18 +137,18 @@ typedef void (*ALFClassifBlkFunc)(uint8_t * class_idx_arr, uint8_t * transpose_i
                                   int16_t *const src, const int stride, const struct Area blk,
                                   const int shift, const int ctu_height, int virbnd_pos);
 
-typedef void (*ALFFilterBlkFunc)(uint8_t * class_idx_arr, uint8_t * transpose_idx_arr, int16_t *const dst, int16_t *const src, const int dstStride, const int srcStride,
+typedef void (*ALFFilterBlkFunc)(uint8_t * class_idx_arr, uint8_t * transpose_idx_arr, OVSample *const dst, int16_t *const src, const int dstStride, const int srcStride,
                         struct Area blk_dst, const int16_t *filter_set, const int16_t *clip_set,
                         const int ctu_height, int virbnd_pos);
 
 
-typedef void (*ALFChromaFilterBlkFunc)(int16_t *const dst, const int16_t *const src,
+typedef void (*ALFChromaFilterBlkFunc)(OVSample *const dst, const int16_t *const src,
                                        const int dstStride, const int srcStride,
                                        struct Area blk_dst,
                                        const int16_t *const filter_set, const int16_t *const clip_set,
                                        const int ctu_height, int virbnd_pos);
 
-typedef void (*CCALFFilterBlkFunc)(int16_t * chroma_dst, int16_t * luma_src, const int chr_stride, const int luma_stride,
+typedef void (*CCALFFilterBlkFunc)(OVSample * chroma_dst, int16_t * luma_src, const int chr_stride, const int luma_stride,
                         const struct Area blk_dst, const uint8_t c_id, const int16_t *filt_coeff,
                         const int vbCTUHeight, int vbPos);
 
@@ -121,6 +164,29 @@ typedef void (*SAOEdgeFilterFunc)(uint8_t* _dst, uint8_t* _src,
 
 typedef void (*LMCSReshapeFunc)(uint16_t *_dst, ptrdiff_t stride_dst, uint16_t* lmcs_lut_luma, int width, int height);
 
+/* Inverse mapping is applied on reconstructed samples once written to picture */
+typedef void (*LMCSReshapePicFunc)(OVSample *_dst, ptrdiff_t stride_dst, uint16_t* lmcs_lut_luma, int width, int height);
+
+/* Deblocking filter decisions for the segments of an edge
+ * Bit n of the maps corresponds to the n-th segment of 4 luma
+ * or 2 chroma lines along the edge.
+ */
+struct DBFSegments
+{
+    uint64_t strong_map;
+    uint64_t weak_map;
+    uint64_t ext_p_map;
+    uint64_t ext_q_map;
+    int16_t tc[64];
+};
+
+/* src points to the first q sample of the first segment */
+typedef void (*DBFLumaFunc)(OVSample *src, ptrdiff_t stride,
+                            const struct DBFSegments *segs);
+
+typedef void (*DBFChromaFunc)(OVSample *src, ptrdiff_t stride,
+                              const struct DBFSegments *segs, uint8_t is_ctb_b);
+
 /**
  * The Context put together all functions used by strategies.
  */
@@ -138,6 +204,29 @@ struct MCFunctions{
     MCUniDirFunc bilinear[4];
 };
 
+struct DMVRFunctions
+{
+  /* SAD on even lines of the whole block */
+  DMVRSADFunc sad;
+  /* SADs of the 25 integer offsets, returns index of the best one */
+  DMVRSADsFunc sads;
+};
+
+struct BDOFFunctions
+{
+  /* Gradients of a block of any size multiple of 4 */
+  RefineGradFunc grad;
+  /* Weights derivation and refinement of 4x4 subblocks */
+  BDOFFunc subblocks;
+};
+
+struct PROFFunctions
+{
+  /* Gradients of a 4x4 subblock */
+  RefineGradFunc grad;
+  PROFFunc func;
+};
+
 struct CCLMFunctions
 {
     CCLMFunc cclm;
@@ -150,6 +239,12 @@ struct TRFunctions
 {
    TrFunc func[NB_TR_TYPES][NB_TR_SIZES];
    void (*dc)(int16_t* const dst, int log2_tb_w, int log2_tb_h, int dc_val);
+
+   /* Optional fused DCT-II horizontal pass and DC with residual add,
+    * NULL when the residual has to go through a transform buffer
+    */
+   TrAddFunc dct2_add[NB_TR_SIZES];
+   void (*dc_add)(uint16_t *dst, int log2_tb_w, int log2_tb_h, int dc_val);
 };
 
 struct DCFunctions
@@ -164,6 +259,19 @@ struct PlanarFunctions
   PlanarFunc pdpc[2];
 };
 
+/* Angular modes with fractional angles
+ * First index is 0 for cubic and 1 for gaussian interpolation,
+ * second index is log2 of the number of samples interpolated per line
+ * (width for vertical modes and height for horizontal modes)
+ */
+struct AngularFunctions
+{
+  IntraAngularFunc v[2][8];
+  IntraAngularFunc h[2][8];
+  IntraAngularPDPCFunc v_pdpc[2][8];
+  IntraAngularPDPCFunc h_pdpc[2][8];
+};
+
 struct ICTFunctions
 {
   ResidualAddScaleFunc add[7];
@@ -194,6 +302,16 @@ struct SAOFunctions{
     SAOEdgeFilterFunc edge[2];
 };
 
+struct DBFFunctions{
+    /* Filtering across vertical edges */
+    DBFLumaFunc luma_ver;
+    DBFChromaFunc chroma_ver;
+
+    /* Filtering across horizontal edges */
+    DBFLumaFunc luma_hor;
+    DBFChromaFunc chroma_hor;
+};
+
 struct RCNFunctions
 {
     /* Motion Compensation Luma */
@@ -202,6 +320,11 @@ struct RCNFunctions
     /* Motion Compensation Chroma */
     struct MCFunctions mc_c;
 
+    /* Inter prediction refinement */
+    struct DMVRFunctions dmvr;
+    struct BDOFFunctions bdof;
+    struct PROFFunctions prof;
+
     struct CCLMFunctions cclm;
 
     struct ICTFunctions ict;
@@ -218,6 +341,9 @@ struct RCNFunctions
     /* Planar Functions */
     struct PlanarFunctions planar;
 
+    /* Angular Functions */
+    struct AngularFunctions angular;
+
     /* MIP Functions */
     struct MIPFunctions mip;
 
@@ -227,8 +353,12 @@ struct RCNFunctions
     /* SAO Functions */
     struct SAOFunctions sao;
 
+    /* Deblocking Functions */
+    struct DBFFunctions dbf;
+
     /* LMCS Functions */
     LMCSReshapeFunc lmcs_reshape;
+    LMCSReshapePicFunc lmcs_reshape_pic;
 };
 
 
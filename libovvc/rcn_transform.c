@@ -596,4 +596,12 @@ rcn_init_tr_functions(struct RCNFunctions *const rcn_funcs)
   rcn_funcs->tr.func[DCT_II][6] = &vvc_inverse_dct_ii_64;
 
   rcn_funcs->tr.dc = &vvc_inverse_dct_ii_dc;
+
+  /* No fused residual add in C, residual is added
+   * from the transform buffer
+   */
+  for (int i = 0; i < NB_TR_SIZES; ++i) {
+    rcn_funcs->tr.dct2_add[i] = NULL;
+  }
+  rcn_funcs->tr.dc_add = NULL;
 }
@@ -11,11 +11,13 @@
 #include "drv_utils.h"
 #include "rcn.h"
 #include "ovdpb.h"
+#include "ovframe.h"
 #include "drv_lines.h"
 #include "rcn_mc.h"
 #include "ovthreads.h"
 #include "rcn_sao.h"
 #include "rcn_lmcs.h"
+#include "decinit.h"
 
 
 /* TODO define in a header */
@@ -29,6 +31,10 @@ static int
 slicedec_decode_rect_entry(OVSliceDec *sldec, OVCTUDec *const ctudec, const OVPS *const prms,
                            uint16_t entry_idx);
 
+static int
+slicedec_decode_wpp_line(OVSliceDec *sldec, OVCTUDec *const ctudec, const OVPS *const prms,
+                         uint16_t entry_idx);
+
 static void derive_dequant_ctx(OVCTUDec *const ctudec, const VVCQPCTX *const qp_ctx,
                                int cu_qp_delta);
 
@@ -315,24 +321,7 @@ cabac_lines_uninit(OVSliceDec *sldec)
 void
 uninit_in_loop_filters(OVCTUDec *const ctudec, int ctb_size)
 {
-    //Uninit SAO info and ctu params
-    struct SAOInfo* sao_info  = &ctudec->sao_info;
-    if(sao_info->sao_params){
-        ov_free(sao_info->sao_params);
-    }
-
-    //Uninit ALF info and ctu params
-    struct ALFInfo* alf_info  = &ctudec->alf_info;
-    if(alf_info->ctb_alf_params){
-        ov_free(alf_info->ctb_alf_params);
-        // rcn_alf_destroy(&alf_info->rcn_alf, ctb_size);
-    }
-
-    //Uninit CC ALF ctu params
-    if(alf_info->ctb_cc_alf_filter_idx[0]){
-        ov_free(alf_info->ctb_cc_alf_filter_idx[0]);
-        ov_free(alf_info->ctb_cc_alf_filter_idx[1]);
-    }
+    /* Note SAO and ALF ctu params are owned by the slice decoder */
 
     //Uninit LMCS info and output pivots
     struct LMCSInfo* lmcs_info  = &ctudec->lmcs_info;
@@ -351,26 +340,13 @@ init_in_loop_filters(OVCTUDec *const ctudec, const OVPS *const prms)
     const OVPH *const ph = prms->ph;
     const struct OVLMCSData* aps_lmcs_data = &prms->aps_lmcs->aps_lmcs_data;
 
-    uint16_t pic_w = sps->sps_pic_width_max_in_luma_samples;
-    uint16_t pic_h = sps->sps_pic_height_max_in_luma_samples;
-    uint8_t log2_ctb_s = sps->sps_log2_ctu_size_minus5 + 5;
-    int nb_ctb_pic_w = (pic_w + ((1 << log2_ctb_s) - 1)) >> log2_ctb_s;
-    int nb_ctb_pic_h = (pic_h + ((1 << log2_ctb_s) - 1)) >> log2_ctb_s;
-
-    //Init SAO info and ctu params
+    //Init SAO info
     struct SAOInfo* sao_info  = &ctudec->sao_info;
     sao_info->sao_luma_flag   =  sh->sh_sao_luma_used_flag;
     sao_info->sao_chroma_flag =  sh->sh_sao_chroma_used_flag;
     sao_info->chroma_format_idc = sps->sps_chroma_format_idc;
-    if(sao_info->sao_luma_flag || sao_info->sao_chroma_flag){
-        if(!sao_info->sao_params){
-            sao_info->sao_params = ov_mallocz(sizeof(SAOParamsCtu) * nb_ctb_pic_w * nb_ctb_pic_h);
-        } else {
-            memset(sao_info->sao_params,0,sizeof(SAOParamsCtu) * nb_ctb_pic_w * nb_ctb_pic_h);
-        }
-    }
 
-    //Init ALF info and ctu params
+    //Init ALF info
     struct ALFInfo* alf_info  = &ctudec->alf_info;
     alf_info->alf_luma_enabled_flag = sh->sh_alf_enabled_flag;
     alf_info->alf_cb_enabled_flag = sh->sh_alf_cb_enabled_flag;
@@ -381,16 +357,16 @@ init_in_loop_filters(OVCTUDec *const ctudec, const OVPS *const prms)
         for (int i = 0; i < alf_info->num_alf_aps_ids_luma; i++)
         {
             alf_info->aps_alf_data[i] = &prms->aps_alf[i]->aps_alf_data;
+            alf_info->aps_alf_uid[i] = nvcl_ps_uid(prms->aps_alf[i]);
         }
         alf_info->aps_alf_data_c = &prms->aps_alf_c->aps_alf_data;
-        if(!alf_info->ctb_alf_params){
-            alf_info->ctb_alf_params = ov_malloc(sizeof(ALFParamsCtu) * nb_ctb_pic_w * nb_ctb_pic_h);
-        } else {
-            memset(alf_info->ctb_alf_params, 0, sizeof(ALFParamsCtu) * nb_ctb_pic_w * nb_ctb_pic_h);
-        }
+        alf_info->aps_alf_uid_c = nvcl_ps_uid(prms->aps_alf_c);
 
         //create the structures for ALF reconstruction
-        rcn_alf_create(&alf_info->rcn_alf);
+        if (!alf_info->fixed_filters_init) {
+            rcn_alf_create(&alf_info->rcn_alf);
+            alf_info->fixed_filters_init = 1;
+        }
 
         //Initialization of ALF reconstruction structures
         RCNALF* alf = &alf_info->rcn_alf;
@@ -399,26 +375,21 @@ init_in_loop_filters(OVCTUDec *const ctudec, const OVPS *const prms)
         rcn_alf_reconstruct_coeff_APS(alf, ctudec, luma_flag, chroma_flag);
     }
 
-    //Init CC ALF ctu params
+    //Init CC ALF info
     alf_info->cc_alf_cb_enabled_flag = sh->sh_alf_cc_cb_enabled_flag;
     alf_info->cc_alf_cr_enabled_flag = sh->sh_alf_cc_cr_enabled_flag;
     if(alf_info->cc_alf_cb_enabled_flag || alf_info->cc_alf_cr_enabled_flag){
         alf_info->aps_cc_alf_data_cb   = &prms->aps_cc_alf_cb->aps_alf_data;
         alf_info->aps_cc_alf_data_cr = &prms->aps_cc_alf_cr->aps_alf_data;
-        if(!alf_info->ctb_cc_alf_filter_idx[0]){
-            alf_info->ctb_cc_alf_filter_idx[0] = ov_malloc(sizeof(uint8_t) * nb_ctb_pic_w * nb_ctb_pic_h);
-            alf_info->ctb_cc_alf_filter_idx[1] = ov_malloc(sizeof(uint8_t) * nb_ctb_pic_w * nb_ctb_pic_h);
-        } else {
-            memset(alf_info->ctb_cc_alf_filter_idx[0], 0, sizeof(uint8_t) * nb_ctb_pic_w * nb_ctb_pic_h);
-            memset(alf_info->ctb_cc_alf_filter_idx[1], 0, sizeof(uint8_t) * nb_ctb_pic_w * nb_ctb_pic_h);
-        }
     }
 
     //Init LMCS info and output pivots
     struct LMCSInfo* lmcs_info   = &ctudec->lmcs_info;
     lmcs_info->lmcs_enabled_flag = ph->ph_lmcs_enabled_flag;
     lmcs_info->scale_c_flag      = ph->ph_chroma_residual_scale_flag;
-    if(sh->sh_lmcs_used_flag){
+    /* LUTs are kept as long as the LMCS APS does not change */
+    if(sh->sh_lmcs_used_flag && (!lmcs_info->lmcs_lut_inv_luma ||
+                                 lmcs_info->aps_uid != nvcl_ps_uid(prms->aps_lmcs))){
         int bitdepth = 10;
         if(!lmcs_info->lmcs_lut_inv_luma){
             lmcs_info->lmcs_lut_inv_luma = ov_malloc(sizeof(uint16_t) << bitdepth);
@@ -436,6 +407,8 @@ init_in_loop_filters(OVCTUDec *const ctudec, const OVPS *const prms)
         rcn_derive_lmcs_params(lmcs_info, output_pivot, aps_lmcs_data);
         rcn_lmcs_compute_lut_luma(lmcs_info, lmcs_info->lmcs_lut_inv_luma, lmcs_info->lmcs_lut_fwd_luma,
                                 lmcs_info->lmcs_output_pivot);
+
+        lmcs_info->aps_uid = nvcl_ps_uid(prms->aps_lmcs);
     }
 
     return 0;
@@ -513,6 +486,146 @@ clear_cabac_lines(const OVSliceDec *sldec, const OVPS *const prms)
      memset(lns_c->cu_mode_x,       0xFF,  sizeof(*lns_c->cu_mode_x)       * nb_pb_pic_w * tinfo->nb_tile_rows);
 }
 
+static void
+lf_params_uninit(struct LFParams *const lf_prms)
+{
+     ov_freep(&lf_prms->sao_params);
+     ov_freep(&lf_prms->alf_params);
+     ov_freep(&lf_prms->cc_alf_filter_idx[0]);
+     ov_freep(&lf_prms->cc_alf_filter_idx[1]);
+
+     ov_freep(&lf_prms->alf_flag_line);
+     ov_freep(&lf_prms->cc_alf_flag_line[0]);
+     ov_freep(&lf_prms->cc_alf_flag_line[1]);
+
+     lf_prms->nb_ctb = 0;
+     lf_prms->nb_ctb_line = 0;
+}
+
+static int
+init_lf_params(OVSliceDec *sldec, const OVPS *const prms)
+{
+     const struct PicPartInfo *const pinfo = &prms->pic_info;
+     const struct TileInfo *const tinfo = &prms->pps_info.tile_info;
+     const OVSH *const sh = prms->sh;
+     struct LFParams *const lf_prms = &sldec->lf_params;
+
+     uint32_t nb_ctb = pinfo->nb_ctb_w * pinfo->nb_ctb_h;
+     uint32_t nb_ctb_line = pinfo->nb_ctb_w * tinfo->nb_tile_rows;
+
+     if (nb_ctb > lf_prms->nb_ctb || nb_ctb_line > lf_prms->nb_ctb_line) {
+         lf_params_uninit(lf_prms);
+
+         lf_prms->sao_params = ov_mallocz(sizeof(*lf_prms->sao_params) * nb_ctb);
+         lf_prms->alf_params = ov_mallocz(sizeof(*lf_prms->alf_params) * nb_ctb);
+         lf_prms->cc_alf_filter_idx[0] = ov_mallocz(sizeof(uint8_t) * nb_ctb);
+         lf_prms->cc_alf_filter_idx[1] = ov_mallocz(sizeof(uint8_t) * nb_ctb);
+
+         lf_prms->alf_flag_line = ov_mallocz(sizeof(uint8_t) * nb_ctb_line);
+         lf_prms->cc_alf_flag_line[0] = ov_mallocz(sizeof(uint8_t) * nb_ctb_line);
+         lf_prms->cc_alf_flag_line[1] = ov_mallocz(sizeof(uint8_t) * nb_ctb_line);
+
+         if (!lf_prms->sao_params || !lf_prms->alf_params ||
+             !lf_prms->cc_alf_filter_idx[0] || !lf_prms->cc_alf_filter_idx[1] ||
+             !lf_prms->alf_flag_line || !lf_prms->cc_alf_flag_line[0] ||
+             !lf_prms->cc_alf_flag_line[1]) {
+             lf_params_uninit(lf_prms);
+             return OVVC_ENOMEM;
+         }
+
+         lf_prms->nb_ctb = nb_ctb;
+         lf_prms->nb_ctb_line = nb_ctb_line;
+     }
+
+     if (sh->sh_sao_luma_used_flag || sh->sh_sao_chroma_used_flag) {
+         memset(lf_prms->sao_params, 0, sizeof(*lf_prms->sao_params) * nb_ctb);
+     }
+
+     if (sh->sh_alf_enabled_flag || sh->sh_alf_cb_enabled_flag || sh->sh_alf_cr_enabled_flag) {
+         memset(lf_prms->alf_params, 0, sizeof(*lf_prms->alf_params) * nb_ctb);
+     }
+
+     if (sh->sh_alf_cc_cb_enabled_flag || sh->sh_alf_cc_cr_enabled_flag) {
+         memset(lf_prms->cc_alf_filter_idx[0], 0, sizeof(uint8_t) * nb_ctb);
+         memset(lf_prms->cc_alf_filter_idx[1], 0, sizeof(uint8_t) * nb_ctb);
+     }
+
+     return 0;
+}
+
+static void
+intra_lines_uninit(OVSliceDec *sldec)
+{
+     struct OVBuffInfo *const il = &sldec->intra_lines;
+
+     ov_freep(&il->y);
+     ov_freep(&il->cb);
+     ov_freep(&il->cr);
+
+     sldec->intra_lines_size = 0;
+}
+
+static int
+init_intra_lines(OVSliceDec *sldec, const OVPS *const prms)
+{
+     const struct PicPartInfo *const pinfo = &prms->pic_info;
+     const struct TileInfo *const tinfo = &prms->pps_info.tile_info;
+     struct OVBuffInfo *const il = &sldec->intra_lines;
+
+     /* Two extra CTUs per tile are required since intra line
+      * is copied with the above right CTU
+      */
+     uint32_t stride = (uint32_t)(pinfo->nb_ctb_w + 2 * tinfo->nb_tile_cols) << pinfo->log2_ctu_s;
+     uint32_t size = stride * tinfo->nb_tile_rows;
+
+     if (size > sldec->intra_lines_size) {
+         intra_lines_uninit(sldec);
+
+         il->y  = ov_malloc(sizeof(*il->y)  * size);
+         il->cb = ov_malloc(sizeof(*il->cb) * (size >> 1));
+         il->cr = ov_malloc(sizeof(*il->cr) * (size >> 1));
+
+         if (!il->y || !il->cb || !il->cr) {
+             intra_lines_uninit(sldec);
+             return OVVC_ENOMEM;
+         }
+
+         sldec->intra_lines_size = size;
+     }
+
+     il->stride   = stride;
+     il->stride_c = stride >> 1;
+
+     return 0;
+}
+
+static void
+wpp_info_uninit(struct WPPInfo *const wpp)
+{
+     ov_freep(&wpp->nb_ctu_decoded);
+     ov_freep(&wpp->ctx_tables);
+     wpp->nb_lines_alloc = 0;
+}
+
+static int
+init_wpp_info(struct WPPInfo *const wpp, uint16_t nb_lines)
+{
+     if (nb_lines > wpp->nb_lines_alloc) {
+         wpp_info_uninit(wpp);
+
+         wpp->nb_ctu_decoded = ov_mallocz(sizeof(*wpp->nb_ctu_decoded) * nb_lines);
+         wpp->ctx_tables     = ov_malloc(sizeof(*wpp->ctx_tables) * OVCABAC_NB_CTX * nb_lines);
+         if (!wpp->nb_ctu_decoded || !wpp->ctx_tables) {
+             wpp_info_uninit(wpp);
+             return OVVC_ENOMEM;
+         }
+
+         wpp->nb_lines_alloc = nb_lines;
+     }
+
+     return 0;
+}
+
 static void
 offset_cabac_lines(struct CCLines *const cc_lns, uint16_t ctb_x, uint8_t log2_ctb_s, uint8_t log2_min_cb_s)
 {
@@ -596,91 +709,78 @@ slicedec_init_rect_entry(struct RectEntryInfo *einfo, const OVPS *const prms, in
     einfo->implicit_h = 0;
     einfo->implicit_w = 0;
 
+    einfo->entropy_sync = prms->sps->sps_entropy_coding_sync_enabled_flag;
+    einfo->wpp_sync = 0;
+    einfo->first_line = 0;
+
+    /* Filtering is pipelined only when there is a single tile since
+     * tiles are filtered concurrently by their own CTU decoder
+     */
+    einfo->lf_pipeline = tile_info->nb_tile_cols * tile_info->nb_tile_rows == 1;
+
+    if (einfo->entropy_sync) {
+        /* Entries are CTU lines of tiles in tile scan order */
+        int first_line = tile_info->ctu_y[tile_y] * tile_info->nb_tile_cols +
+                         tile_x * einfo->nb_ctu_h;
+
+        einfo->first_line  = first_line;
+        einfo->entry_start = sh_info->rbsp_entry[first_line];
+        einfo->entry_end   = sh_info->rbsp_entry[first_line + einfo->nb_ctu_h];
+    }
+
     init_pic_border_info(einfo, prms, entry_idx);
 }
 
-//TODOpar: temporary function, change with refs and ref_counts when functional
-void
+/* Parameter sets are shared with the main decoder, only references
+ * are taken so they are kept alive until the slice decoder is reused
+ * for another picture.
+ */
+int
 slicedec_copy_params(OVSliceDec *sldec, struct OVPS* dec_params)
 {   
+    struct OVPS* slice_params;
+    int i;
+
     //structures not allocated yet
-    if(!sldec->active_params)
+    if (!sldec->active_params) {
         sldec->active_params = ov_mallocz(sizeof(struct OVPS));
-    struct OVPS* slice_params = sldec->active_params;
+        if (!sldec->active_params) {
+            return OVVC_ENOMEM;
+        }
+    }
 
-    if(!slice_params->sps){
-        slice_params->sps = ov_mallocz(sizeof(struct OVSPS));
-        slice_params->pps = ov_mallocz(sizeof(struct OVPPS));
-        slice_params->sh = ov_mallocz(sizeof(struct OVSH));
-        slice_params->ph = ov_mallocz(sizeof(struct OVPH));
+    slice_params = sldec->active_params;
 
-        for (int i=0; i<8; i++)
-            slice_params->aps_alf[i] = ov_mallocz(sizeof(struct OVAPS));
+    nvcl_ps_replace(&slice_params->sps, dec_params->sps);
+    nvcl_ps_replace(&slice_params->pps, dec_params->pps);
+    nvcl_ps_replace(&slice_params->sh, dec_params->sh);
+    nvcl_ps_replace(&slice_params->ph, dec_params->ph);
 
-        slice_params->aps_alf_c = ov_mallocz(sizeof(struct OVAPS));
-        slice_params->aps_cc_alf_cb = ov_mallocz(sizeof(struct OVAPS));
-        slice_params->aps_cc_alf_cr = ov_mallocz(sizeof(struct OVAPS));
-        slice_params->aps_lmcs = ov_mallocz(sizeof(struct OVAPS));
+    for (i = 0; i < 8; i++) {
+        nvcl_ps_replace(&slice_params->aps_alf[i], dec_params->aps_alf[i]);
     }
 
-    *(slice_params->sps) = *(dec_params->sps);        
-    *(slice_params->pps) = *(dec_params->pps);
-    *(slice_params->sh) = *(dec_params->sh);
-    *(slice_params->ph) = *(dec_params->ph);
-
-    if(dec_params->aps_alf){
-        for (int i=0; i<8; i++){
-            if(dec_params->aps_alf[i])
-                *(slice_params->aps_alf[i]) = *(dec_params->aps_alf[i]);
-        }
-    }
-    if(dec_params->aps_alf_c){
-        *(slice_params->aps_alf_c) = *(dec_params->aps_alf_c);
-    }
-    if(dec_params->aps_cc_alf_cb){
-        *(slice_params->aps_cc_alf_cb) = *(dec_params->aps_cc_alf_cb);
-    }
-    if(dec_params->aps_cc_alf_cr){
-        *(slice_params->aps_cc_alf_cr) = *(dec_params->aps_cc_alf_cr);
-    }
-    if(dec_params->aps_lmcs){
-        *(slice_params->aps_lmcs) = *(dec_params->aps_lmcs);
-    }
+    nvcl_ps_replace(&slice_params->aps_alf_c, dec_params->aps_alf_c);
+    nvcl_ps_replace(&slice_params->aps_cc_alf_cb, dec_params->aps_cc_alf_cb);
+    nvcl_ps_replace(&slice_params->aps_cc_alf_cr, dec_params->aps_cc_alf_cr);
+    nvcl_ps_replace(&slice_params->aps_lmcs, dec_params->aps_lmcs);
 
     slice_params->sps_info = dec_params->sps_info;
     slice_params->pps_info = dec_params->pps_info;
     slice_params->ph_info = dec_params->ph_info;
     slice_params->sh_info = dec_params->sh_info;
     slice_params->pic_info = dec_params->pic_info;
+
+    return 0;
 }
 
-//TODOpar: temporary function, change with refs and ref_counts when functional
 void
 slicedec_free_params(OVSliceDec *sldec)
 {   
     if(!sldec->active_params)
         return;
 
-    struct OVPS* slice_params = sldec->active_params;
-    if(slice_params->sps){
-        ov_freep(&slice_params->sps);
-        ov_freep(&slice_params->pps);
-        ov_freep(&slice_params->sh);
-        ov_freep(&slice_params->ph);
-
-    }
-    if(slice_params->aps_alf_c){
-        for (int i=0; i<8; i++)
-            ov_freep(&(slice_params->aps_alf[i]));
-
-        ov_freep(&slice_params->aps_alf_c);
-    }
-    if(slice_params->aps_cc_alf_cb){
-        ov_freep(&slice_params->aps_cc_alf_cb);
-        ov_freep(&slice_params->aps_cc_alf_cr);
-    }
-    if(slice_params->aps_lmcs)
-        ov_freep(&slice_params->aps_lmcs);
+    decinit_unref_params(sldec->active_params);
 
     ov_freep(&sldec->active_params);
 }
@@ -691,9 +791,29 @@ slicedec_finish_decoding(OVSliceDec *sldec)
     struct SliceThread *th_slice = &sldec->th_slice;
     ov_nalu_unref(&th_slice->slice_nalu);
 
-    ov_log(NULL, OVLOG_DEBUG, "Decoder with POC %d, finished frame \n", sldec->pic->poc);
+    /* No picture is attached when the slice failed before picture
+     * initialisation (e.g. unsupported bit depth)
+     */
+    if (sldec->pic) {
+        ov_log(NULL, OVLOG_DEBUG, "Decoder with POC %d, finished frame \n", sldec->pic->poc);
+
+        ovdpb_report_decoded_frame( sldec->pic );
+    }
 
-    ovdpb_report_decoded_frame( sldec->pic );
+    #if USE_THREADS
+    /* Released before signaling since the decoder might be
+     * closed as soon as main thread is signaled
+     */
+    ovthread_pool_release_pic(th_slice->pool);
+    #endif
+
+    /* State is changed under main thread lock so the decoder
+     * is not closed before main thread is signaled
+     */
+    struct MainThread* t_main = th_slice->main_thread;
+    if(t_main){
+        pthread_mutex_lock(&t_main->main_mtx);
+    }
 
     pthread_mutex_lock(&th_slice->gnrl_mtx);
     th_slice->active_state = DECODING_FINISHED;
@@ -701,28 +821,118 @@ slicedec_finish_decoding(OVSliceDec *sldec)
     pthread_mutex_unlock(&th_slice->gnrl_mtx);
 
     //Signal main thread that a slice thread is available
-    struct MainThread* t_main = th_slice->main_thread;
     if(t_main){
-        pthread_mutex_lock(&t_main->main_mtx);
-        pthread_cond_signal(&t_main->main_cnd);
+        ovthread_main_thread_signal(t_main);
         pthread_mutex_unlock(&t_main->main_mtx);
     }
 }
 
+static int
+slicedec_init_wpp(OVSliceDec *sldec, uint16_t nb_lines)
+{
+    struct WPPInfo *const wpp = &sldec->wpp_info;
+    int ret;
+    int i;
+
+    ret = init_wpp_info(wpp, nb_lines);
+    if (ret < 0) {
+        return ret;
+    }
+
+    for (i = 0; i < nb_lines; ++i) {
+        atomic_store_explicit(&wpp->nb_ctu_decoded[i], 0, memory_order_relaxed);
+    }
+
+    return 0;
+}
+
+static int lf_pipeline_filter_lines(void *opaque, int idx);
+
+static void
+slicedec_init_lf_pipeline(OVSliceDec *sldec, const OVPS *const prms)
+{
+    struct LFPipeline *const lfp = &sldec->lf_pipeline;
+    OVCTUDec *const lf_ctudec = lfp->lf_ctudec;
+    int nb_ctu_w = prms->pps_info.tile_info.nb_ctu_w[0];
+
+    slicedec_init_rect_entry(&lfp->einfo, prms, 0);
+
+    if (nb_ctu_w > lf_ctudec->prev_nb_ctu_w_rect_entry) {
+        int margin = 3;
+        ctudec_alloc_filter_buffers(lf_ctudec, nb_ctu_w, margin);
+        lf_ctudec->prev_nb_ctu_w_rect_entry = nb_ctu_w;
+    }
+
+    lf_ctudec->filter_buffers.pic_frame = sldec->pic->frame;
+
+    /* Deblocking records are only used when CTU lines are decoded
+     * one after the other by the same entry
+     */
+    lfp->defer_dbf = !prms->sps->sps_entropy_coding_sync_enabled_flag;
+    if (lfp->defer_dbf && nb_ctu_w * LF_NB_DBF_LINES > lfp->nb_dbf_records) {
+        ov_freep(&lfp->dbf_records);
+        lfp->nb_dbf_records = 0;
+        lfp->dbf_records = ov_malloc(sizeof(*lfp->dbf_records) * nb_ctu_w * LF_NB_DBF_LINES);
+        if (lfp->dbf_records) {
+            lfp->nb_dbf_records = nb_ctu_w * LF_NB_DBF_LINES;
+        }
+    }
+
+    /* Fallback to deblocking after each CTU on allocation failure */
+    lfp->defer_dbf &= !!lfp->dbf_records;
+
+    lf_ctudec->rcn_ctx.ctudec = lf_ctudec;
+
+    atomic_store_explicit(&lfp->nb_filter_req, 0, memory_order_relaxed);
+    lfp->next_filter_line = 0;
+
+    lfp->lf_job.run    = lf_pipeline_filter_lines;
+    lfp->lf_job.opaque = sldec;
+    lfp->lf_job.idx    = 0;
+}
+
 int
 slicedec_decode_rect_entries(OVSliceDec *sldec, const OVPS *const prms)
 {
     /* FIXME do not recompute everywhere */
     int nb_entries = prms->pps_info.tile_info.nb_tile_cols *
                      prms->pps_info.tile_info.nb_tile_rows;
+    DecodeFunc decode_entry = slicedec_decode_rect_entry;
 
     int ret = 0;
+
+    uint8_t entropy_sync = prms->sps->sps_entropy_coding_sync_enabled_flag;
+    uint8_t lf_pipeline = nb_entries == 1;
+
+    if (entropy_sync || lf_pipeline) {
+        uint16_t nb_lines = entropy_sync ? prms->sh_info.nb_entries
+                                         : prms->pic_info.nb_ctb_h;
+
+        ret = slicedec_init_wpp(sldec, nb_lines);
+        if (ret < 0) {
+            return ret;
+        }
+    }
+
+    if (lf_pipeline) {
+        slicedec_init_lf_pipeline(sldec, prms);
+    }
+
+    /* CTU lines are decoded in parallel only if there is
+     * a single tile, otherwise tiles are decoded in parallel
+     * and their CTU lines one after the other
+     */
+    if (entropy_sync && lf_pipeline) {
+        nb_entries = prms->sh_info.nb_entries;
+        decode_entry = slicedec_decode_wpp_line;
+    }
+
     #if USE_THREADS
-    ovthread_decode_entries(&sldec->th_slice, slicedec_decode_rect_entry, nb_entries);
+    ret = ovthread_decode_entries(&sldec->th_slice, decode_entry, nb_entries);
     #else
     int i;
     for (i = 0; i < nb_entries; ++i) {
-        ret = slicedec_decode_rect_entry(sldec, sldec->ctudec_list[0], prms, i);
+        ret = decode_entry(sldec, sldec->ctudec_list[0], prms, i);
     }
     ret = 0;
     #endif
@@ -778,6 +988,28 @@ cabac_line_next_ctu(OVCTUDec *const ctudec, uint8_t nb_pb_ctb)
 }
 
 
+/* Save deblocking information of current CTU so it can be
+ * deblocked later by the filtering job
+ */
+static void
+dbf_record_ctu(const OVCTUDec *const ctudec, int ctb_x, uint8_t log2_ctb_s,
+               uint8_t last_x, uint8_t last_y, uint8_t truncated,
+               int ctu_w, int ctu_h)
+{
+    struct DBFCTURecord *const rec = &ctudec->dbf_records[ctb_x];
+
+    memcpy(&rec->dbf_info, &ctudec->dbf_info, sizeof(rec->dbf_info));
+
+    rec->fbuff         = ctudec->rcn_ctx.frame_buff;
+    rec->ctu_ngh_flags = ctudec->ctu_ngh_flags;
+    rec->log2_ctb_s    = log2_ctb_s;
+    rec->last_x        = last_x;
+    rec->last_y        = last_y;
+    rec->truncated     = truncated;
+    rec->ctu_w         = ctu_w;
+    rec->ctu_h         = ctu_h;
+}
+
 /* Wrapper function around decode CTU calls so we can easily modify
  * what is to be done before and after each CTU
  * without adding many thing in each lin decoder
@@ -812,10 +1044,10 @@ decode_ctu(OVCTUDec *const ctudec, const struct RectEntryInfo *const einfo,
     rcn_write_ctu_to_frame(&ctudec->rcn_ctx, log2_ctb_s);
     rcn_ctu_to_intra_line(ctudec, ctb_addr_rs % nb_ctu_w << log2_ctb_s);
 
-    const struct OVBuffInfo *const fbuff = &ctudec->rcn_ctx.frame_buff;
+    const struct OVFrameBuffInfo *const fbuff = &ctudec->rcn_ctx.frame_buff;
     ptrdiff_t stride_out_pic = fbuff->stride;
-    uint16_t *out_pic = fbuff->y;
-    ctudec->rcn_ctx.rcn_funcs.lmcs_reshape(out_pic, stride_out_pic, ctudec->lmcs_info.lmcs_lut_inv_luma,
+    OVSample *out_pic = fbuff->y;
+    ctudec->rcn_ctx.rcn_funcs.lmcs_reshape_pic(out_pic, stride_out_pic, ctudec->lmcs_info.lmcs_lut_inv_luma,
                                             1 << log2_ctb_s, 1 << log2_ctb_s);
 
     if (!ctudec->dbf_disable) {
@@ -823,8 +1055,17 @@ decode_ctu(OVCTUDec *const ctudec, const struct RectEntryInfo *const einfo,
         uint8_t is_last_y = einfo->nb_ctu_h == (ctb_addr_rs / nb_ctu_w) + 1;
         #if 1
 
-        rcn_dbf_ctu(&ctudec->rcn_ctx, &ctudec->dbf_info, log2_ctb_s,
-                    is_last_x, is_last_y);
+        if (ctudec->dbf_records) {
+            /* Edges are forced before storing since next CTUs
+             * deblocking info is derived from current one
+             */
+            rcn_dbf_implicit_edges(&ctudec->dbf_info);
+            dbf_record_ctu(ctudec, ctb_addr_rs % nb_ctu_w, log2_ctb_s,
+                           is_last_x, is_last_y, 0, 1 << log2_ctb_s, 1 << log2_ctb_s);
+        } else {
+            rcn_dbf_ctu(&ctudec->rcn_ctx, &ctudec->dbf_info, log2_ctb_s,
+                        is_last_x, is_last_y);
+        }
                     #endif
     }
 
@@ -864,23 +1105,258 @@ decode_truncated_ctu(OVCTUDec *const ctudec, const struct RectEntryInfo *const e
                                   ctu_w, ctu_h);
     rcn_ctu_to_intra_line(ctudec, ctb_addr_rs % nb_ctu_w << log2_ctb_s);
 
-    const struct OVBuffInfo *const fbuff = &ctudec->rcn_ctx.frame_buff;
+    const struct OVFrameBuffInfo *const fbuff = &ctudec->rcn_ctx.frame_buff;
     ptrdiff_t stride_out_pic = fbuff->stride;
-    uint16_t *out_pic = fbuff->y;
-    ctudec->rcn_ctx.rcn_funcs.lmcs_reshape(out_pic, stride_out_pic, ctudec->lmcs_info.lmcs_lut_inv_luma, ctu_w, ctu_h);
+    OVSample *out_pic = fbuff->y;
+    ctudec->rcn_ctx.rcn_funcs.lmcs_reshape_pic(out_pic, stride_out_pic, ctudec->lmcs_info.lmcs_lut_inv_luma, ctu_w, ctu_h);
 
     if (!ctudec->dbf_disable) {
         uint8_t is_last_x = (ctb_addr_rs + 1) % nb_ctu_w == 0;
         uint8_t is_last_y = einfo->nb_ctu_h == (ctb_addr_rs / nb_ctu_w) + 1;
-        rcn_dbf_truncated_ctu(&ctudec->rcn_ctx, &ctudec->dbf_info, log2_ctb_s,
-                              is_last_x, is_last_y, ctu_w, ctu_h);
+        if (ctudec->dbf_records) {
+            dbf_record_ctu(ctudec, ctb_addr_rs % nb_ctu_w, log2_ctb_s,
+                           is_last_x, is_last_y, 1, ctu_w, ctu_h);
+        } else {
+            rcn_dbf_truncated_ctu(&ctudec->rcn_ctx, &ctudec->dbf_info, log2_ctb_s,
+                                  is_last_x, is_last_y, ctu_w, ctu_h);
+        }
     }
 
     return ret;
 }
 
+static void
+wpp_wait_ctu_line(struct WPPInfo *const wpp, uint16_t line_idx, unsigned nb_ctu)
+{
+    atomic_uint *const nb_ctu_decoded = &wpp->nb_ctu_decoded[line_idx];
+
+    if (atomic_load_explicit(nb_ctu_decoded, memory_order_acquire) >= nb_ctu) {
+        return;
+    }
+
+    /* Waiter is registered before progress is checked again and
+     * reporters check for waiters after storing progress (both
+     * sequentially consistent) so no wakeup can be missed
+     */
+    pthread_mutex_lock(&wpp->wpp_mtx);
+    atomic_fetch_add(&wpp->nb_waiters, 1);
+    while (atomic_load(nb_ctu_decoded) < nb_ctu) {
+        pthread_cond_wait(&wpp->wpp_cnd, &wpp->wpp_mtx);
+    }
+    atomic_fetch_sub(&wpp->nb_waiters, 1);
+    pthread_mutex_unlock(&wpp->wpp_mtx);
+}
+
+static void
+wpp_report_ctu(struct WPPInfo *const wpp, uint16_t line_idx, unsigned nb_ctu)
+{
+    atomic_store(&wpp->nb_ctu_decoded[line_idx], nb_ctu);
+
+    if (atomic_load(&wpp->nb_waiters)) {
+        pthread_mutex_lock(&wpp->wpp_mtx);
+        pthread_cond_broadcast(&wpp->wpp_cnd);
+        pthread_mutex_unlock(&wpp->wpp_mtx);
+    }
+}
+
+/* Store CABAC contexts after first CTU of the line
+ * so they can be used to init next CTU line
+ */
+static void
+wpp_store_ctx(struct WPPInfo *const wpp, const OVCTUDec *const ctudec, uint16_t line_idx)
+{
+    uint64_t *const ctx_dst = &wpp->ctx_tables[(uint32_t)line_idx * OVCABAC_NB_CTX];
+
+    memcpy(ctx_dst, ctudec->cabac_ctx->ctx_table, sizeof(ctudec->cabac_ctx->ctx_table));
+}
+
+/* Extend picture borders of a filtered CTU line segment into frame
+ * margins before reporting it so other pictures can use it as a
+ * reference without edge emulation
+ */
+static void
+report_ctu_line(const OVSliceDec *const sldec, const struct RectEntryInfo *const einfo,
+                uint16_t ctb_y_pic)
+{
+    uint8_t log2_ctb_s = sldec->active_params->pic_info.log2_ctu_s;
+    int last_ctb_x = einfo->ctb_x + einfo->nb_ctu_w - 1;
+
+    ovframe_extend_borders(sldec->pic->frame,
+                           einfo->ctb_x << log2_ctb_s, ctb_y_pic << log2_ctb_s,
+                           (last_ctb_x + 1) << log2_ctb_s, (ctb_y_pic + 1) << log2_ctb_s);
+
+    ovdpb_report_decoded_ctu_line(sldec->pic, ctb_y_pic, einfo->ctb_x, last_ctb_x);
+}
+
+/* Apply in-loop filters on the available pixels of a CTU line
+ * and report filtered lines to DPB
+ */
+static void
+filter_ctu_line(OVCTUDec *const ctudec, const OVSliceDec *const sldec,
+                const struct RectEntryInfo *const einfo, uint16_t ctb_y)
+{
+    uint16_t ctb_y_pic = einfo->ctb_y + ctb_y;
+
+    if (ctb_y == 0) {
+        rcn_sao_first_pix_rows(ctudec, einfo, ctb_y);
+        if (einfo->nb_ctu_h == 1) {
+            rcn_sao_filter_line(ctudec, einfo, ctb_y);
+            rcn_alf_filter_line(ctudec, einfo, ctb_y);
+            report_ctu_line(sldec, einfo, ctb_y_pic);
+        }
+    } else if (ctb_y == einfo->nb_ctu_h - 1) {
+        rcn_sao_filter_line(ctudec, einfo, ctb_y - 1);
+        rcn_sao_filter_line(ctudec, einfo, ctb_y);
+
+        rcn_alf_filter_line(ctudec, einfo, ctb_y - 1);
+        report_ctu_line(sldec, einfo, ctb_y_pic - 1);
+        rcn_alf_filter_line(ctudec, einfo, ctb_y);
+        report_ctu_line(sldec, einfo, ctb_y_pic);
+    } else {
+        rcn_sao_filter_line(ctudec, einfo, ctb_y - 1);
+        rcn_alf_filter_line(ctudec, einfo, ctb_y - 1);
+        report_ctu_line(sldec, einfo, ctb_y_pic - 1);
+    }
+}
+
+/* Deblock a CTU line from the records stored while decoding it
+ */
+static void
+dbf_ctu_line_records(OVCTUDec *const lf_ctudec, const struct LFPipeline *const lfp,
+                     uint16_t ctb_y)
+{
+    const struct RectEntryInfo *const einfo = &lfp->einfo;
+    struct DBFCTURecord *rec = &lfp->dbf_records[(ctb_y % LF_NB_DBF_LINES) * einfo->nb_ctu_w];
+    int ctb_x;
+
+    for (ctb_x = 0; ctb_x < einfo->nb_ctu_w; ++ctb_x, ++rec) {
+        lf_ctudec->rcn_ctx.frame_buff = rec->fbuff;
+        lf_ctudec->ctu_ngh_flags = rec->ctu_ngh_flags;
+
+        if (!rec->truncated) {
+            rcn_dbf_ctu(&lf_ctudec->rcn_ctx, &rec->dbf_info, rec->log2_ctb_s,
+                        rec->last_x, rec->last_y);
+        } else {
+            rcn_dbf_truncated_ctu(&lf_ctudec->rcn_ctx, &rec->dbf_info, rec->log2_ctb_s,
+                                  rec->last_x, rec->last_y, rec->ctu_w, rec->ctu_h);
+        }
+    }
+}
+
+/* Filter decoded CTU lines in order until end_line or
+ * a line which is not yet decoded
+ */
+static void
+lf_pipeline_filter_available_lines(OVSliceDec *const sldec, uint16_t end_line)
+{
+    struct LFPipeline *const lfp = &sldec->lf_pipeline;
+    const struct RectEntryInfo *const einfo = &lfp->einfo;
+    struct WPPInfo *const wpp = &sldec->wpp_info;
+
+    for (;;) {
+        uint16_t ctb_y;
+
+        pthread_mutex_lock(&lfp->lf_mtx);
+        ctb_y = lfp->next_filter_line;
+
+        if (ctb_y >= end_line ||
+            atomic_load_explicit(&wpp->nb_ctu_decoded[einfo->first_line + ctb_y],
+                                 memory_order_acquire) < einfo->nb_ctu_w) {
+            pthread_mutex_unlock(&lfp->lf_mtx);
+            break;
+        }
+
+        /* Deblocking is applied here when deferred while decoding */
+        if (lfp->defer_dbf && !lfp->lf_ctudec->dbf_disable) {
+            dbf_ctu_line_records(lfp->lf_ctudec, lfp, ctb_y);
+        }
+
+        filter_ctu_line(lfp->lf_ctudec, sldec, einfo, ctb_y);
+
+        lfp->next_filter_line = ctb_y + 1;
+        pthread_mutex_unlock(&lfp->lf_mtx);
+    }
+}
+
+/* Return the deblocking records to be used by the CTU line ctb_y.
+ * Records of the line decoded LF_NB_DBF_LINES lines before are reused
+ * so this line is filtered on current thread if the filtering job
+ * did not process it yet.
+ */
+static struct DBFCTURecord *
+lf_pipeline_dbf_records(OVSliceDec *const sldec, uint16_t ctb_y)
+{
+    struct LFPipeline *const lfp = &sldec->lf_pipeline;
+
+    if (!lfp->defer_dbf) {
+        return NULL;
+    }
+
+    if (ctb_y >= LF_NB_DBF_LINES) {
+        lf_pipeline_filter_available_lines(sldec, ctb_y - LF_NB_DBF_LINES + 1);
+    }
+
+    return &lfp->dbf_records[(ctb_y % LF_NB_DBF_LINES) * lfp->einfo.nb_ctu_w];
+}
+
+/* Filter CTU lines once they are decoded.
+ * Filtering requires lines to be processed in order by using the
+ * same filter buffers so only one job processes the lines
+ * while decoding threads only notify it a new line is available.
+ */
+static int
+lf_pipeline_filter_lines(void *opaque, int idx)
+{
+    OVSliceDec *const sldec = (OVSliceDec *)opaque;
+    struct LFPipeline *const lfp = &sldec->lf_pipeline;
+    const struct RectEntryInfo *const einfo = &lfp->einfo;
+    unsigned nb_req = 1;
+
+    do {
+        lf_pipeline_filter_available_lines(sldec, einfo->nb_ctu_h);
+
+        nb_req = atomic_fetch_sub_explicit(&lfp->nb_filter_req, nb_req, memory_order_acq_rel) - nb_req;
+
+    } while (nb_req);
+
+    #if USE_THREADS
+    ovthread_slice_job_done(&sldec->th_slice);
+    #endif
+
+    return 0;
+}
+
+/* Report a decoded CTU line and start the filtering job
+ * if it is not already running
+ */
+static void
+lf_pipeline_report_line(OVSliceDec *const sldec, const struct RectEntryInfo *const einfo,
+                        uint16_t line_idx)
+{
+    struct LFPipeline *const lfp = &sldec->lf_pipeline;
+
+    wpp_report_ctu(&sldec->wpp_info, line_idx, einfo->nb_ctu_w);
+
+    if (atomic_fetch_add_explicit(&lfp->nb_filter_req, 1, memory_order_acq_rel)) {
+        return;
+    }
+
+    #if USE_THREADS
+    /* Entry jobs of later pictures may already be queued and block
+     * on the lines this job reports, so it is queued above them
+     */
+    if (ovthread_slice_submit_unblock_job(&sldec->th_slice, &lfp->lf_job) >= 0) {
+        return;
+    }
+
+    /* Filter on current thread on submission failure */
+    atomic_fetch_add_explicit(&sldec->th_slice.nb_active_jobs, 1, memory_order_acq_rel);
+    #endif
+    lf_pipeline_filter_lines(sldec, 0);
+}
+
 static int
-decode_ctu_line(OVCTUDec *const ctudec, const OVSliceDec *const sldec,
+decode_ctu_line(OVCTUDec *const ctudec, OVSliceDec *const sldec,
                 const struct DRVLines *const drv_lines,
                 const struct RectEntryInfo *const einfo,
                 uint16_t ctb_addr_rs)
@@ -890,6 +1366,10 @@ decode_ctu_line(OVCTUDec *const ctudec, const OVSliceDec *const sldec,
     uint8_t log2_min_cb_s = ctudec->part_ctx->log2_min_cb_s;
     uint16_t nb_pb_ctb = (1 << log2_ctb_s) >> log2_min_cb_s;
     const uint8_t slice_type = sldec->slice_type;
+    struct WPPInfo *const wpp = &sldec->wpp_info;
+    int ctb_y = ctudec->ctb_y - einfo->ctb_y;
+    uint16_t line_idx = einfo->first_line + ctb_y;
+    uint8_t wait_above = einfo->wpp_sync && ctb_y;
     int ctb_x = 0;
     int ret;
     /* FIXME not really required ?*/
@@ -917,6 +1397,16 @@ decode_ctu_line(OVCTUDec *const ctudec, const OVSliceDec *const sldec,
          */
         if (ctb_x == 0) {
             backup_qp = ctudec->drv_ctx.qp_map_x[0];
+            if (einfo->entropy_sync) {
+                wpp_store_ctx(wpp, ctudec, line_idx);
+            }
+        }
+
+        /* Above CTUs information of next CTU must be available
+         * before loading it from lines
+         */
+        if (wait_above) {
+            wpp_wait_ctu_line(wpp, line_idx - 1, OVMIN(ctb_x + 3, nb_ctu_w));
         }
 
         rcn_update_ctu_border(&ctudec->rcn_ctx, log2_ctb_s);
@@ -932,6 +1422,10 @@ decode_ctu_line(OVCTUDec *const ctudec, const OVSliceDec *const sldec,
             dbf_load_info(dbf_info, dbf_lns, log2_ctb_s, (ctb_x + 1) % nb_ctu_w);
         }
 
+        if (einfo->wpp_sync) {
+            wpp_report_ctu(wpp, line_idx, ctb_x + 1);
+        }
+
         ctb_addr_rs++;
         ctb_x++;
 
@@ -982,33 +1476,17 @@ decode_ctu_line(OVCTUDec *const ctudec, const OVSliceDec *const sldec,
         store_inter_maps(drv_lines, ctudec, ctb_x, 1);
     }
 
-    //Apply in-loop filters on the available pixels of CTU line
-    int ctb_y = ctudec->ctb_y - einfo->ctb_y;
-    if(ctb_y == 0){
-        rcn_sao_first_pix_rows(ctudec, einfo, ctb_y);
-        if(einfo->nb_ctu_h == 1){
-            rcn_sao_filter_line(ctudec, einfo, ctb_y);
-            rcn_alf_filter_line(ctudec, einfo, ctb_y);
-            ovdpb_report_decoded_ctu_line(sldec->pic, ctudec->ctb_y, einfo->ctb_x, einfo->ctb_x + nb_ctu_w - 1);
-        } 
-    }    
-    else if(ctb_y == einfo->nb_ctu_h - 1){
-        rcn_sao_filter_line(ctudec, einfo, ctb_y-1);
-        rcn_sao_filter_line(ctudec, einfo, ctb_y);
-
-        rcn_alf_filter_line(ctudec, einfo, ctb_y-1);
-        ovdpb_report_decoded_ctu_line(sldec->pic, ctudec->ctb_y-1, einfo->ctb_x, einfo->ctb_x + einfo->nb_ctu_w - 1);
-        rcn_alf_filter_line(ctudec, einfo, ctb_y);
-        ovdpb_report_decoded_ctu_line(sldec->pic, ctudec->ctb_y, einfo->ctb_x, einfo->ctb_x + einfo->nb_ctu_w - 1);
-    }
-    else{
-        rcn_sao_filter_line(ctudec, einfo, ctb_y-1);
-        rcn_alf_filter_line(ctudec, einfo, ctb_y-1);
-        ovdpb_report_decoded_ctu_line(sldec->pic, ctudec->ctb_y-1, einfo->ctb_x, einfo->ctb_x + nb_ctu_w - 1);
-    }
-
     if (ctb_x == 0) {
         backup_qp = ctudec->drv_ctx.qp_map_x[0];
+        if (einfo->entropy_sync) {
+            wpp_store_ctx(wpp, ctudec, line_idx);
+        }
+    }
+
+    if (einfo->lf_pipeline) {
+        lf_pipeline_report_line(sldec, einfo, line_idx);
+    } else {
+        filter_ctu_line(ctudec, sldec, einfo, ctb_y);
     }
 
     /* Next line will use the qp of the first pu as a start value
@@ -1027,7 +1505,7 @@ decode_ctu_line(OVCTUDec *const ctudec, const OVSliceDec *const sldec,
 }
 
 static int
-decode_ctu_last_line(OVCTUDec *const ctudec, const OVSliceDec *const sldec,
+decode_ctu_last_line(OVCTUDec *const ctudec, OVSliceDec *const sldec,
                      const struct DRVLines *const drv_lines,
                      const struct RectEntryInfo *const einfo,
                      uint16_t ctb_addr_rs)
@@ -1040,8 +1518,16 @@ decode_ctu_last_line(OVCTUDec *const ctudec, const OVSliceDec *const sldec,
     uint16_t nb_pb_ctb = (1 << log2_ctb_s) >> log2_min_cb_s;
     int nb_ctu_w = einfo->nb_ctu_w;
     uint8_t slice_type = sldec->slice_type;
+    struct WPPInfo *const wpp = &sldec->wpp_info;
+    int ctb_y = ctudec->ctb_y - einfo->ctb_y;
+    uint16_t line_idx = einfo->first_line + ctb_y;
+    uint8_t wait_above = einfo->wpp_sync && ctb_y;
     int ctb_x = 0;
 
+    /* Note CABAC contexts are not stored since this is the last
+     * CTU line of the entry
+     */
+
     // rcn_frame_line_to_ctu(&ctudec->rcn_ctx, log2_ctb_s);
     rcn_intra_line_to_ctu(&ctudec->rcn_ctx, 0, log2_ctb_s);
 
@@ -1058,6 +1544,10 @@ decode_ctu_last_line(OVCTUDec *const ctudec, const OVSliceDec *const sldec,
 
         cabac_line_next_ctu(ctudec, nb_pb_ctb);
 
+        if (wait_above) {
+            wpp_wait_ctu_line(wpp, line_idx - 1, OVMIN(ctb_x + 3, nb_ctu_w));
+        }
+
         if (slice_type != SLICE_I) {
             store_inter_maps(drv_lines, ctudec, ctb_x, 0);
         }
@@ -1071,6 +1561,10 @@ decode_ctu_last_line(OVCTUDec *const ctudec, const OVSliceDec *const sldec,
             dbf_load_info(dbf_info, dbf_lns, log2_ctb_s, (ctb_x + 1) % nb_ctu_w);
         }
 
+        if (einfo->wpp_sync) {
+            wpp_report_ctu(wpp, line_idx, ctb_x + 1);
+        }
+
         ctb_addr_rs++;
         ctb_x++;
 
@@ -1091,21 +1585,10 @@ decode_ctu_last_line(OVCTUDec *const ctudec, const OVSliceDec *const sldec,
         store_inter_maps(drv_lines, ctudec, ctb_x, 1);
     }
 
-    int ctb_y = ctudec->ctb_y - einfo->ctb_y;
-    if(ctb_y == 0){
-        rcn_sao_first_pix_rows(ctudec, einfo, ctb_y);
-        rcn_sao_filter_line(ctudec, einfo, ctb_y);
-        rcn_alf_filter_line(ctudec, einfo, ctb_y);
-        ovdpb_report_decoded_ctu_line(sldec->pic, ctudec->ctb_y, einfo->ctb_x, einfo->ctb_x + nb_ctu_w - 1);
-    }    
-    else{
-        rcn_sao_filter_line(ctudec, einfo, ctb_y-1);
-        rcn_sao_filter_line(ctudec, einfo, ctb_y);
-
-        rcn_alf_filter_line(ctudec, einfo, ctb_y-1);
-        ovdpb_report_decoded_ctu_line(sldec->pic, ctudec->ctb_y-1, einfo->ctb_x, einfo->ctb_x + einfo->nb_ctu_w - 1);
-        rcn_alf_filter_line(ctudec, einfo, ctb_y);
-        ovdpb_report_decoded_ctu_line(sldec->pic, ctudec->ctb_y, einfo->ctb_x, einfo->ctb_x + einfo->nb_ctu_w - 1);
+    if (einfo->lf_pipeline) {
+        lf_pipeline_report_line(sldec, einfo, line_idx);
+    } else {
+        filter_ctu_line(ctudec, sldec, einfo, ctb_y);
     }
 
     ret = 0;
@@ -1123,25 +1606,25 @@ slicedec_attach_frame_buff(OVCTUDec *const ctudec, OVSliceDec *sldec,
 {
     OVFrame *f = sldec->pic->frame;
     uint8_t log2_ctb_s = ctudec->part_ctx->log2_ctu_s;
-    struct OVBuffInfo *const fbuff = &ctudec->rcn_ctx.frame_buff;
+    struct OVFrameBuffInfo *const fbuff = &ctudec->rcn_ctx.frame_buff;
 
-    uint32_t entry_start_offset   = ((uint32_t)einfo->ctb_x << (log2_ctb_s + 1));
-    uint32_t entry_start_offset_c = ((uint32_t)einfo->ctb_x << (log2_ctb_s));
+    uint32_t entry_start_offset   = ((uint32_t)einfo->ctb_x << log2_ctb_s)       * sizeof(OVSample);
+    uint32_t entry_start_offset_c = ((uint32_t)einfo->ctb_x << (log2_ctb_s - 1)) * sizeof(OVSample);
 
     entry_start_offset   += ((uint32_t)einfo->ctb_y << log2_ctb_s)       * (f->linesize[0]);
     entry_start_offset_c += ((uint32_t)einfo->ctb_y << (log2_ctb_s - 1)) * (f->linesize[1]);
 
     /*FIXME clean offset */
-    fbuff->y  = (uint16_t *)&f->data[0][entry_start_offset];
-    fbuff->cb = (uint16_t *)&f->data[1][entry_start_offset_c];
-    fbuff->cr = (uint16_t *)&f->data[2][entry_start_offset_c];
+    fbuff->y  = (OVSample *)&f->data[0][entry_start_offset];
+    fbuff->cb = (OVSample *)&f->data[1][entry_start_offset_c];
+    fbuff->cr = (OVSample *)&f->data[2][entry_start_offset_c];
 
-    fbuff->stride   = f->linesize[0] >> 1;
-    fbuff->stride_c = f->linesize[1] >> 1;
+    fbuff->stride   = f->linesize[0] / sizeof(OVSample);
+    fbuff->stride_c = f->linesize[1] / sizeof(OVSample);
 }
 
 static void
-fbuff_new_line(struct OVBuffInfo *fbuff, uint8_t log2_ctb_s)
+fbuff_new_line(struct OVFrameBuffInfo *fbuff, uint8_t log2_ctb_s)
 {
     fbuff->y  += fbuff->stride << log2_ctb_s;
     fbuff->cb += fbuff->stride_c << (log2_ctb_s - 1);
@@ -1184,6 +1667,48 @@ tmvp_entry_init(OVCTUDec *ctudec, OVPicture *active_pic)
     memset(tmvp_ctx->dir_map_v1, 0, 34 * sizeof(uint64_t));
 }
 
+/* Attach CTU decoder to intra and in loop filters lines
+ * shared by all entries
+ */
+static void
+attach_entry_lines(OVCTUDec *ctudec, const OVSliceDec *sldec,
+                   const struct RectEntryInfo *const einfo, uint8_t log2_ctb_s)
+{
+    const struct LFParams *const lf_prms = &sldec->lf_params;
+    const struct OVBuffInfo *const il = &sldec->intra_lines;
+    struct OVBuffInfo *const intra_line_b = &ctudec->rcn_ctx.intra_line_buff;
+    struct ALFInfo *const alf_info = &ctudec->alf_info;
+
+    uint32_t nb_ctb_pic_w = einfo->nb_ctb_pic_w;
+
+    /* Per CTU parameters are stored in tile scan order */
+    uint32_t ctb_offset = nb_ctb_pic_w * einfo->ctb_y + einfo->ctb_x * einfo->nb_ctu_h;
+
+    /* Above line flags are stored per tile row */
+    uint32_t line_offset = nb_ctb_pic_w * einfo->tile_y + einfo->ctb_x;
+
+    /* Intra lines have two additional CTUs per tile */
+    uint32_t il_offset = (il->stride * einfo->tile_y) +
+                         ((uint32_t)(einfo->ctb_x + 2 * einfo->tile_x) << log2_ctb_s);
+
+    ctudec->sao_info.sao_params = lf_prms->sao_params + ctb_offset;
+
+    alf_info->ctb_alf_params = lf_prms->alf_params + ctb_offset;
+    alf_info->ctb_cc_alf_filter_idx[0] = lf_prms->cc_alf_filter_idx[0] + ctb_offset;
+    alf_info->ctb_cc_alf_filter_idx[1] = lf_prms->cc_alf_filter_idx[1] + ctb_offset;
+
+    alf_info->ctb_alf_flag_line = lf_prms->alf_flag_line + line_offset;
+    alf_info->ctb_cc_alf_flag_line[0] = lf_prms->cc_alf_flag_line[0] + line_offset;
+    alf_info->ctb_cc_alf_flag_line[1] = lf_prms->cc_alf_flag_line[1] + line_offset;
+
+    intra_line_b->y  = il->y  + il_offset;
+    intra_line_b->cb = il->cb + (il_offset >> 1);
+    intra_line_b->cr = il->cr + (il_offset >> 1);
+
+    intra_line_b->stride   = (uint32_t)einfo->nb_ctu_w << log2_ctb_s;
+    intra_line_b->stride_c = (uint32_t)einfo->nb_ctu_w << (log2_ctb_s - 1);
+}
+
 static void
 init_lines(OVCTUDec *ctudec, const OVSliceDec *sldec, const struct RectEntryInfo *const einfo, const OVPS *const prms, const OVPartInfo*const part_ctx, struct DRVLines *drv_lines, struct CCLines *cc_lines)
 {
@@ -1202,6 +1727,8 @@ init_lines(OVCTUDec *ctudec, const OVSliceDec *sldec, const struct RectEntryInfo
     offset_drv_lines(drv_lines, einfo->tile_x, einfo->tile_y, einfo->ctb_x, log2_ctb_s,
                      log2_min_cb_s, tinfo->nb_tile_cols, nb_ctb_pic_w);
 
+    attach_entry_lines(ctudec, sldec, einfo, log2_ctb_s);
+
     cabac_line_next_line(ctudec, cc_lines);
 
     drv_line_next_line(ctudec, drv_lines);
@@ -1283,48 +1810,23 @@ slicedec_smvd_params(OVCTUDec *const ctudec, const OVPS *const prms, int cur_poc
     }
 }
 
-static int
-slicedec_decode_rect_entry(OVSliceDec *sldec, OVCTUDec *const ctudec, const OVPS *const prms,
-                           uint16_t entry_idx)
+/* Init CTU decoder information to be used by an entry
+ */
+static void
+slicedec_init_entry_ctudec(OVSliceDec *sldec, OVCTUDec *const ctudec, const OVPS *const prms,
+                           const struct RectEntryInfo *const einfo)
 {
-    int ctb_addr_rs = 0;
-    int ctb_y = 0;
-    int ret;
-
-    struct RectEntryInfo einfo;
-
-    /*FIXME handle cabac alloc or keep it on the stack ? */
-    OVCABACCtx cabac_ctx;
-    slicedec_init_rect_entry(&einfo, prms, entry_idx);
-
-    struct DRVLines drv_lines;
-    struct CCLines cc_lines[2] = {sldec->cabac_lines[0], sldec->cabac_lines[1]};
-
-    const int nb_ctu_w = einfo.nb_ctu_w;
-    const int nb_ctu_h = einfo.nb_ctu_h;
-    
-    struct OVFilterBuffers* fb = &ctudec->filter_buffers;
-    fb->pic_frame = sldec->pic->frame;
-    if(nb_ctu_w > ctudec->prev_nb_ctu_w_rect_entry)
-    {
-        int margin = 3;
-        ctudec_alloc_filter_buffers(ctudec, einfo.nb_ctu_w, margin);
-        ctudec_alloc_intra_line_buff(ctudec, einfo.nb_ctu_w + 2);
-        ctudec->prev_nb_ctu_w_rect_entry = nb_ctu_w;
-    }
-
-    struct OVBuffInfo tmp_fbuff;
-    ctudec->cabac_ctx = &cabac_ctx;
-
     ctudec->qp_ctx.current_qp = ctudec->slice_qp;
 
     derive_dequant_ctx(ctudec, &ctudec->qp_ctx, 0);
 
     /*FIXME quick tmvp import */
-    ctudec->nb_ctb_pic_w = einfo.nb_ctb_pic_w;
+    ctudec->nb_ctb_pic_w = einfo->nb_ctb_pic_w;
 
     tmvp_entry_init(ctudec, sldec->pic);
 
+    ctudec->dbf_records = NULL;
+
     /* FIXME tmp Reset DBF */
     memcpy(ctudec->drv_ctx.inter_ctx.rpl0, sldec->pic->rpl0, sizeof(sldec->pic->rpl0));
     memcpy(ctudec->drv_ctx.inter_ctx.rpl1, sldec->pic->rpl1, sizeof(sldec->pic->rpl1));
@@ -1359,6 +1861,130 @@ slicedec_decode_rect_entry(OVSliceDec *sldec, OVCTUDec *const ctudec, const OVPS
     ctudec->drv_ctx.inter_ctx.bcw_flag = sldec->active_params->sps->sps_bcw_enabled_flag;
     ctudec->drv_ctx.inter_ctx.amvr_flag = sldec->active_params->sps->sps_amvr_enabled_flag;
     ctudec->drv_ctx.inter_ctx.affine_amvr_flag = sldec->active_params->sps->sps_affine_amvr_enabled_flag;
+}
+
+/* Decode a CTU line of an entry when entropy coding sync is
+ * enabled. Each CTU line has its own entry point and CABAC contexts
+ * are initialised from the contexts stored after the first
+ * CTU of the above line.
+ */
+static int
+decode_wpp_ctu_line(OVSliceDec *sldec, OVCTUDec *const ctudec, const OVPS *const prms,
+                    struct RectEntryInfo *const einfo, uint16_t ctb_y)
+{
+    const struct SHInfo *const sh_info = &prms->sh_info;
+    struct WPPInfo *const wpp = &sldec->wpp_info;
+    struct OVFrameBuffInfo *const fbuff = &ctudec->rcn_ctx.frame_buff;
+    uint8_t log2_ctb_s = ctudec->part_ctx->log2_ctu_s;
+    uint16_t line_idx = einfo->first_line + ctb_y;
+    int ctb_addr_rs = ctb_y * einfo->nb_ctu_w;
+    int ret;
+
+    /*FIXME handle cabac alloc or keep it on the stack ? */
+    OVCABACCtx cabac_ctx;
+    struct DRVLines drv_lines;
+    struct CCLines cc_lines[2] = {sldec->cabac_lines[0], sldec->cabac_lines[1]};
+
+    einfo->entry_start = sh_info->rbsp_entry[line_idx];
+    einfo->entry_end   = sh_info->rbsp_entry[line_idx + 1];
+
+    ctudec->cabac_ctx = &cabac_ctx;
+
+    if (ctb_y == 0) {
+        memcpy(cabac_ctx.ctx_table, sldec->cabac_init_ctx, sizeof(cabac_ctx.ctx_table));
+    } else {
+        const uint64_t *const ctx_src = &wpp->ctx_tables[(uint32_t)(line_idx - 1) * OVCABAC_NB_CTX];
+
+        /* Wait for above CTUs required by first CTU of the line */
+        if (einfo->wpp_sync) {
+            wpp_wait_ctu_line(wpp, line_idx - 1, OVMIN(2, einfo->nb_ctu_w));
+        }
+
+        memcpy(cabac_ctx.ctx_table, ctx_src, sizeof(cabac_ctx.ctx_table));
+    }
+
+    ret = ovcabac_attach_entry(ctudec->cabac_ctx, einfo->entry_start, einfo->entry_end);
+    if (ret < 0) {
+        /* Keep contexts and progress consistent so following lines
+         * are not blocked by the invalid one
+         */
+        wpp_store_ctx(wpp, ctudec, line_idx);
+        if (einfo->lf_pipeline) {
+            lf_pipeline_report_line(sldec, einfo, line_idx);
+        }
+        return OVVC_EINDATA;
+    }
+
+    /* QP prediction is reset to slice QP at the start of each CTU line */
+    ctudec->qp_ctx.current_qp = ctudec->slice_qp;
+
+    derive_dequant_ctx(ctudec, &ctudec->qp_ctx, 0);
+
+    init_lines(ctudec, sldec, einfo, prms, ctudec->part_ctx,
+               &drv_lines, cc_lines);
+
+    slicedec_attach_frame_buff(ctudec, sldec, einfo);
+
+    fbuff->y  += ((ptrdiff_t)fbuff->stride   * ctb_y) << log2_ctb_s;
+    fbuff->cb += ((ptrdiff_t)fbuff->stride_c * ctb_y) << (log2_ctb_s - 1);
+    fbuff->cr += ((ptrdiff_t)fbuff->stride_c * ctb_y) << (log2_ctb_s - 1);
+
+    ctudec->ctb_y = einfo->ctb_y + ctb_y;
+
+    if (ctb_y == einfo->nb_ctu_h - 1 && einfo->implicit_h) {
+        ret = decode_ctu_last_line(ctudec, sldec, &drv_lines, einfo, ctb_addr_rs);
+    } else {
+        ret = decode_ctu_line(ctudec, sldec, &drv_lines, einfo, ctb_addr_rs);
+    }
+
+    return ret;
+}
+
+static int
+slicedec_decode_rect_entry(OVSliceDec *sldec, OVCTUDec *const ctudec, const OVPS *const prms,
+                           uint16_t entry_idx)
+{
+    int ctb_addr_rs = 0;
+    int ctb_y = 0;
+    int ret;
+
+    struct RectEntryInfo einfo;
+
+    /*FIXME handle cabac alloc or keep it on the stack ? */
+    OVCABACCtx cabac_ctx;
+    slicedec_init_rect_entry(&einfo, prms, entry_idx);
+
+    struct DRVLines drv_lines;
+    struct CCLines cc_lines[2] = {sldec->cabac_lines[0], sldec->cabac_lines[1]};
+
+    const int nb_ctu_w = einfo.nb_ctu_w;
+    const int nb_ctu_h = einfo.nb_ctu_h;
+    
+    struct OVFilterBuffers* fb = &ctudec->filter_buffers;
+    fb->pic_frame = sldec->pic->frame;
+    if(!einfo.lf_pipeline && nb_ctu_w > ctudec->prev_nb_ctu_w_rect_entry)
+    {
+        int margin = 3;
+        ctudec_alloc_filter_buffers(ctudec, einfo.nb_ctu_w, margin);
+        ctudec->prev_nb_ctu_w_rect_entry = nb_ctu_w;
+    }
+
+    struct OVFrameBuffInfo tmp_fbuff;
+
+    slicedec_init_entry_ctudec(sldec, ctudec, prms, &einfo);
+
+    /* CTU lines of the entry are separate entry points
+     * decoded one after the other
+     */
+    if (einfo.entropy_sync) {
+        ret = 0;
+        for (ctb_y = 0; ctb_y < nb_ctu_h; ++ctb_y) {
+            ret = decode_wpp_ctu_line(sldec, ctudec, prms, &einfo, ctb_y);
+        }
+        return ret;
+    }
+
+    ctudec->cabac_ctx = &cabac_ctx;
 
     /* FIXME entry might be check before attaching entry to CABAC so there
      * is no need for this check
@@ -1368,12 +1994,8 @@ slicedec_decode_rect_entry(OVSliceDec *sldec, OVCTUDec *const ctudec, const OVPS
         return OVVC_EINDATA;
     }
 
-    /* FIXME Note cabac context tables could be initialised earlier
-     * so we could only init once and recopy context tables to others
-     * entries CABAC readers
-     */
-    ovcabac_init_slice_context_table(cabac_ctx.ctx_table, prms->sh->sh_slice_type ^ prms->sh->sh_cabac_init_flag,
-                                     ctudec->slice_qp);
+    /* Context tables were initialised once for the slice */
+    memcpy(cabac_ctx.ctx_table, sldec->cabac_init_ctx, sizeof(cabac_ctx.ctx_table));
 
     init_lines(ctudec, sldec, &einfo, prms, ctudec->part_ctx,
                &drv_lines, cc_lines);
@@ -1386,6 +2008,10 @@ slicedec_decode_rect_entry(OVSliceDec *sldec, OVCTUDec *const ctudec, const OVPS
 
         ctudec->ctb_y = einfo.ctb_y + ctb_y;
 
+        if (einfo.lf_pipeline) {
+            ctudec->dbf_records = lf_pipeline_dbf_records(sldec, ctb_y);
+        }
+
         /* New ctu line */
         ret = decode_ctu_line(ctudec, sldec, &drv_lines, &einfo, ctb_addr_rs);
 
@@ -1407,6 +2033,11 @@ slicedec_decode_rect_entry(OVSliceDec *sldec, OVCTUDec *const ctudec, const OVPS
     }
 
     ctudec->ctb_y = einfo.ctb_y + ctb_y;
+
+    if (einfo.lf_pipeline) {
+        ctudec->dbf_records = lf_pipeline_dbf_records(sldec, ctb_y);
+    }
+
     /* Last line */
     if (!einfo.implicit_h) {
         ret = decode_ctu_line(ctudec, sldec, &drv_lines, &einfo, ctb_addr_rs);
@@ -1418,6 +2049,25 @@ slicedec_decode_rect_entry(OVSliceDec *sldec, OVCTUDec *const ctudec, const OVPS
     return ctb_addr_rs;
 }
 
+/* Decode one CTU line entry of a picture containing a single tile
+ * with entropy coding sync enabled so that CTU lines can be decoded
+ * in parallel with a two CTUs delay to their above line.
+ */
+static int
+slicedec_decode_wpp_line(OVSliceDec *sldec, OVCTUDec *const ctudec, const OVPS *const prms,
+                         uint16_t entry_idx)
+{
+    struct RectEntryInfo einfo;
+
+    slicedec_init_rect_entry(&einfo, prms, 0);
+
+    einfo.wpp_sync = 1;
+
+    slicedec_init_entry_ctudec(sldec, ctudec, prms, &einfo);
+
+    return decode_wpp_ctu_line(sldec, ctudec, prms, &einfo, entry_idx);
+}
+
 static uint8_t ict_type(const OVPH *const ph)
 {
     uint8_t type = (ph->ph_joint_cbcr_sign_flag << 1);
@@ -1437,12 +2087,13 @@ init_affine_status(OVCTUDec *const ctudec, const OVSPS *const sps,
 
 /* FIXME clean this init */
 static int
-slicedec_init_slice_tools(OVCTUDec *const ctudec, const OVPS *const prms)
+slicedec_init_slice_tools(OVCTUDec *const ctudec, const OVPS *const prms, int cpu_flags)
 {
     const OVSPS *const sps = prms->sps;
     const OVPPS *const pps = prms->pps;
     const OVSH *const sh = prms->sh;
     const OVPH *const ph = prms->ph;
+    uint32_t rcn_funcs_key;
 
     ctudec->max_log2_transform_skip_size = sps->sps_log2_transform_skip_max_size_minus2 + 2;
 
@@ -1476,6 +2127,8 @@ slicedec_init_slice_tools(OVCTUDec *const ctudec, const OVPS *const prms)
                           #else
                           ctudec->dbf_disable = 1;
 #endif
+    ctudec->entropy_sync = sps->sps_entropy_coding_sync_enabled_flag;
+
     ctudec->dbf_info.beta_offset = sh->sh_luma_beta_offset_div2 * 2;
     ctudec->dbf_info.tc_offset = sh->sh_luma_tc_offset_div2 * 2;
 
@@ -1506,12 +2159,37 @@ slicedec_init_slice_tools(OVCTUDec *const ctudec, const OVPS *const prms)
     ctudec->drv_ctx.inter_ctx.tmvp_ctx.col_ref_l0 = ph->ph_collocated_from_l0_flag || sh->sh_collocated_from_l0_flag
                                                     || sh->sh_slice_type == SLICE_P;
 
-    rcn_init_functions(&ctudec->rcn_ctx.rcn_funcs, ict_type(ph), ctudec->lm_chroma_enabled,
-                        sps->sps_chroma_vertical_collocated_flag, ph->ph_lmcs_enabled_flag);
+    rcn_funcs_key  = ict_type(ph);
+    rcn_funcs_key |= !!ctudec->lm_chroma_enabled << 2;
+    rcn_funcs_key |= !!sps->sps_chroma_vertical_collocated_flag << 3;
+    rcn_funcs_key |= !!ph->ph_lmcs_enabled_flag << 4;
+    rcn_funcs_key |= 0x80;
+    rcn_funcs_key |= (uint32_t)cpu_flags << 8;
+
+    if (ctudec->rcn_ctx.rcn_funcs_key != rcn_funcs_key) {
+        rcn_init_functions(&ctudec->rcn_ctx.rcn_funcs, cpu_flags, ict_type(ph), ctudec->lm_chroma_enabled,
+                           sps->sps_chroma_vertical_collocated_flag, ph->ph_lmcs_enabled_flag);
+        ctudec->rcn_ctx.rcn_funcs_key = rcn_funcs_key;
+    }
 
     return 0;
 }
 
+static void
+init_cabac_ctx_table(OVSliceDec *const sldec, const OVPS *const prms, uint8_t slice_qp)
+{
+    uint8_t init_type = prms->sh->sh_slice_type ^ prms->sh->sh_cabac_init_flag;
+    uint16_t key = 0x8000 | (init_type << 8) | slice_qp;
+
+    /* Entries of consecutive slices with same init type and QP
+     * reuse the same table
+     */
+    if (sldec->cabac_init_key != key) {
+        ovcabac_init_slice_context_table(sldec->cabac_init_ctx, init_type, slice_qp);
+        sldec->cabac_init_key = key;
+    }
+}
+
 /*FIXME check init return */
 int
 slicedec_update_entry_decoders(OVSliceDec *sldec, const OVPS *const prms)
@@ -1519,15 +2197,18 @@ slicedec_update_entry_decoders(OVSliceDec *sldec, const OVPS *const prms)
     int i;
     int nb_ctudec = sldec->nb_entry_th;
 
-    for (i = 0; i < nb_ctudec; ++i) {
-        OVCTUDec *ctudec = sldec->ctudec_list[i];
+    for (i = 0; i < nb_ctudec + 1; ++i) {
+        /* Filtering CTU decoder is initialised along with the others */
+        OVCTUDec *ctudec = i < nb_ctudec ? sldec->ctudec_list[i] : sldec->lf_pipeline.lf_ctudec;
         ctudec->pic_w = sldec->pic->frame->width[0];
         ctudec->pic_h = sldec->pic->frame->height[0];
         ctudec->cur_poc = sldec->pic->poc;
-        slicedec_init_slice_tools(ctudec, prms);
+        slicedec_init_slice_tools(ctudec, prms, sldec->cpu_flags);
 //if (sldec->slice_type != 2) ctudec->dbf_info.disable_v = 1;
     }
 
+    init_cabac_ctx_table(sldec, prms, sldec->ctudec_list[0]->slice_qp);
+
     return 0;
 }
 
@@ -1535,10 +2216,10 @@ int
 slicedec_init_lines(OVSliceDec *const sldec, const OVPS *const prms)
 {
     const OVSH *sh = prms->sh;
+    int ret;
     sldec->slice_type = sh->sh_slice_type;
 
     if (!sldec->cabac_lines[0].qt_depth_map_x) {
-        int ret;
         ret = init_cabac_lines(sldec, prms);
         if (ret < 0) {
             ov_log(NULL, 3, "FAILED init cabac lines\n");
@@ -1548,7 +2229,6 @@ slicedec_init_lines(OVSliceDec *const sldec, const OVPS *const prms)
     clear_cabac_lines(sldec, prms);
 
     if (!sldec->drv_lines.intra_luma_x) {
-        int ret;
         ret = init_drv_lines(sldec, prms);
         if (ret < 0) {
             ov_log(NULL, 3, "FAILED init DRV lines\n");
@@ -1558,6 +2238,18 @@ slicedec_init_lines(OVSliceDec *const sldec, const OVPS *const prms)
         reset_drv_lines(sldec, prms);
     }
 
+    ret = init_intra_lines(sldec, prms);
+    if (ret < 0) {
+        ov_log(NULL, 3, "FAILED init intra lines\n");
+        return ret;
+    }
+
+    ret = init_lf_params(sldec, prms);
+    if (ret < 0) {
+        ov_log(NULL, 3, "FAILED init in loop filters params\n");
+        return ret;
+    }
+
     return 0;
 }
 
@@ -1639,8 +2331,20 @@ slicedec_init(OVSliceDec *sldec, int nb_entry_th)
 
     sldec->th_slice.owner = sldec;
 
+    ret = ctudec_init(&sldec->lf_pipeline.lf_ctudec);
+    if (ret < 0) {
+        goto faillfctudec;
+    }
+
+    atomic_init(&sldec->wpp_info.nb_waiters, 0);
+    pthread_mutex_init(&sldec->wpp_info.wpp_mtx, NULL);
+    pthread_cond_init(&sldec->wpp_info.wpp_cnd, NULL);
+    pthread_mutex_init(&sldec->lf_pipeline.lf_mtx, NULL);
+
     return 0;
 
+faillfctudec:
+    ovthread_slice_thread_uninit(&sldec->th_slice);
 failthreads:
     uninit_ctudec_list(sldec, nb_entry_th);
 failctudec:
@@ -1661,12 +2365,27 @@ slicedec_uninit(OVSliceDec **sldec_p)
         uninit_ctudec_list(sldec, sldec->nb_entry_th);
     }
 
+    if (sldec->lf_pipeline.lf_ctudec) {
+        uninit_in_loop_filters(sldec->lf_pipeline.lf_ctudec, 0);
+        ctudec_uninit(sldec->lf_pipeline.lf_ctudec);
+    }
+
+    ov_freep(&sldec->lf_pipeline.dbf_records);
+    pthread_mutex_destroy(&sldec->lf_pipeline.lf_mtx);
+
     /*FIXME is init test */
     if (sldec->cabac_lines[0].log2_cu_w_map_x) {
         cabac_lines_uninit(sldec);
         drv_lines_uninit(sldec);
     }
 
+    intra_lines_uninit(sldec);
+    lf_params_uninit(&sldec->lf_params);
+
+    wpp_info_uninit(&sldec->wpp_info);
+    pthread_mutex_destroy(&sldec->wpp_info.wpp_mtx);
+    pthread_cond_destroy(&sldec->wpp_info.wpp_cnd);
+
     slicedec_free_params(sldec);
 
     ov_freep(sldec_p);
@@ -1694,7 +2413,10 @@ derive_ctu_neighborhood(OVCTUDec *const ctudec,
     if (!is_left_border && !is_up_border) {
         ctb_flags |= CTU_UPLFT_FLG;
     }
-    if (!is_up_border && is_right_border) {
+    /* Above right CTU is not available when entropy coding sync
+     * is enabled
+     */
+    if (!is_up_border && is_right_border && !ctudec->entropy_sync) {
         ctb_flags |= CTU_UPRGT_FLG;
     }
 
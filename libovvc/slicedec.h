@@ -7,8 +7,10 @@
 #include "ovdefs.h"
 #include "ctudec.h"
 #include "dec_structures.h"
+#include "vcl_cabac.h"
 
-struct EntryThread;
+struct OVThreadPool;
+struct OVJob;
 
 enum StateSliceThread {
     IDLE = 0,
@@ -21,14 +23,19 @@ typedef int (*DecodeFunc)(OVSliceDec *sldec, OVCTUDec *const ctudec, const OVPS
 struct SliceThread
 {
     OVSliceDec *owner;
-    struct EntryThread *tdec;
+
+    /* Decoder thread pool entries jobs are submitted to */
+    struct OVThreadPool *pool;
+    uint8_t priority;
+
+    /* One job per CTU decoder */
+    struct OVJob *jobs;
     
     struct OutputThread* output_thread;
     struct MainThread* main_thread;
     
     OVNALUnit* slice_nalu;
 
-    int nb_threads;
     uint8_t active_state;
 
     /* Information on current task */
@@ -37,13 +44,9 @@ struct SliceThread
 
     DecodeFunc decode_entry;
 
-    atomic_uint first_job;
-    atomic_uint last_entry_idx;
+    atomic_uint next_entry;
+    atomic_uint nb_active_jobs;
 
-    /* Slice decoder thread to be used later if
-     * multiple slices
-     */
-    pthread_t thread;
     pthread_mutex_t gnrl_mtx;
     pthread_cond_t gnrl_cnd;
 };
@@ -122,6 +125,103 @@ struct DRVLines
 };
 
 
+/* In loop filters CTU parameters of the picture and
+ * ALF CABAC context lines
+ * They are shared by all entries of the slice so CTU lines
+ * decoded by separate threads can access their above CTU line
+ */
+struct LFParams
+{
+    SAOParamsCtu *sao_params;
+    ALFParamsCtu *alf_params;
+    uint8_t *cc_alf_filter_idx[2];
+
+    /* ALF flags of above CTU line one line per tile row */
+    uint8_t *alf_flag_line;
+    uint8_t *cc_alf_flag_line[2];
+
+    /* Allocated sizes in number of CTUs */
+    uint32_t nb_ctb;
+    uint32_t nb_ctb_line;
+};
+
+/* Wavefront Parallel Processing synchronisation
+ * on CTU lines
+ */
+struct WPPInfo
+{
+    /* Number of CTUs decoded in each CTU line entry */
+    atomic_uint *nb_ctu_decoded;
+
+    /* CABAC contexts stored after first CTU of each CTU line */
+    uint64_t *ctx_tables;
+
+    uint16_t nb_lines_alloc;
+
+    /* Number of entries blocked on wpp_cnd, reports only
+     * take wpp_mtx and broadcast when it is not zero
+     */
+    atomic_uint nb_waiters;
+
+    pthread_mutex_t wpp_mtx;
+    pthread_cond_t wpp_cnd;
+};
+
+/* Deblocking information of a CTU saved during CTU decoding
+ * so deblocking can be applied later by the filtering job
+ */
+struct DBFCTURecord
+{
+    struct DBFInfo dbf_info;
+
+    /* Frame position of the CTU */
+    struct OVFrameBuffInfo fbuff;
+
+    uint8_t ctu_ngh_flags;
+    uint8_t log2_ctb_s;
+    uint8_t last_x;
+    uint8_t last_y;
+    uint8_t truncated;
+    uint8_t ctu_w;
+    uint8_t ctu_h;
+};
+
+/* Number of CTU lines of deblocking records, decoding
+ * cannot go further ahead of the filtering job
+ */
+#define LF_NB_DBF_LINES 3
+
+/* In loop filters applied on CTU lines by a job running
+ * behind CTU lines decoding when the slice is a single tile
+ */
+struct LFPipeline
+{
+    /* CTU decoder only used for filtering */
+    OVCTUDec *lf_ctudec;
+
+    struct RectEntryInfo einfo;
+
+    struct OVJob lf_job;
+
+    /* Number of filtering requests since in loop filters
+     * of a line can only be applied by one job at a time
+     */
+    atomic_uint nb_filter_req;
+    uint16_t next_filter_line;
+
+    /* Deblocking is deferred to the filtering job
+     * when CTU lines are decoded by a single entry
+     */
+    uint8_t defer_dbf;
+    struct DBFCTURecord *dbf_records;
+    uint32_t nb_dbf_records;
+
+    /* Held while filtering a CTU line since the decoding
+     * thread may also filter lines when records are exhausted
+     */
+    pthread_mutex_t lf_mtx;
+};
+
 typedef struct OVSliceDec
 {
    uint8_t slice_type;
@@ -135,6 +235,25 @@ typedef struct OVSliceDec
     */
    struct DRVLines drv_lines;
 
+   /* Lines of reconstructed samples used for intra prediction
+    * of the next CTU line, one line per tile row
+    */
+   struct OVBuffInfo intra_lines;
+   uint32_t intra_lines_size;
+
+   struct LFParams lf_params;
+
+   struct WPPInfo wpp_info;
+
+   struct LFPipeline lf_pipeline;
+
+   /* CABAC contexts initialised from slice init type and QP
+    * copied by every entry at its start, they are only derived
+    * again when the key changes
+    */
+   uint64_t cabac_init_ctx[OVCABAC_NB_CTX];
+   uint16_t cabac_init_key;
+
    /* Reference to current pic being decoded */
    OVPicture *pic;
 
@@ -143,12 +262,18 @@ typedef struct OVSliceDec
 
    struct SliceThread th_slice;
 
+   /* SIMD extensions reconstruction functions can use */
+   int cpu_flags;
+
 } OVSliceDec;
 
-void slicedec_copy_params(OVSliceDec *sldec, struct OVPS* dec_params);
+int slicedec_copy_params(OVSliceDec *sldec, struct OVPS* dec_params);
 
 int slicedec_update_entry_decoders(OVSliceDec *sldec, const OVPS *const prms);
 
+/* Start decoding the entries of the slice, on failure no entry
+ * job was started and slicedec_finish_decoding() must be called
+ */
 int slicedec_decode_rect_entries(OVSliceDec *sldec, const OVPS *const prms);
 
 void slicedec_finish_decoding(OVSliceDec *sldec);
@@ -23,7 +23,7 @@ nvcl_decode_nalu_sh(OVNVCLReader *const rdr, OVNVCLCtx *const nvcl_ctx, uint8_t
 {
     int ret;
 
-    OVSH *sh = ov_mallocz(sizeof(*sh));
+    OVSH *sh = nvcl_ps_alloc(sizeof(*sh));
     if (!sh) {
         return OV_ENOMEM;
     }
@@ -40,19 +40,15 @@ nvcl_decode_nalu_sh(OVNVCLReader *const rdr, OVNVCLCtx *const nvcl_ctx, uint8_t
     }
     #endif
 
-    /* FIXME this is temporary to ensure the
-     * sh is freed between each slice
-     */
-    if (nvcl_ctx->sh) {
-        ov_freep(&nvcl_ctx->sh);
-    }
+    /* Slice decoders using the previous SH keep their own reference */
+    nvcl_ps_unref(&nvcl_ctx->sh);
 
     nvcl_ctx->sh = sh;
 
     return 0;
 
 cleanup:
-    ov_free(sh);
+    nvcl_ps_unref(&sh);
     return ret;
 }
 
@@ -323,9 +319,20 @@ nvcl_sh_read(OVNVCLReader *const rdr, OVSH *const sh,
         }
     }
 
-    /*FIXME derive nb entry points */
+    /*FIXME derive nb entry points from tiles in slice */
     int nb_entry_points = (pps->pps_num_tile_columns_minus1 + 1) * (pps->pps_num_tile_rows_minus1 + 1) - 1;
-    if (nb_entry_points > 1) {
+    if (sps->sps_entropy_coding_sync_enabled_flag) {
+        /* One entry per CTU line of each tile */
+        uint8_t log2_ctb_s = pps->pps_log2_ctu_size_minus5 + 5;
+        int nb_ctb_pic_h = (pps->pps_pic_height_in_luma_samples + ((1 << log2_ctb_s) - 1)) >> log2_ctb_s;
+        nb_entry_points = (pps->pps_num_tile_columns_minus1 + 1) * nb_ctb_pic_h - 1;
+    }
+
+    if (sps->sps_entry_point_offsets_present_flag && nb_entry_points > 0) {
+        if (nb_entry_points > 254) {
+            ov_log(NULL, 3, "Unsupported number of entry points %d\n", nb_entry_points);
+            return OV_INVALID_DATA;
+        }
         sh->sh_entry_offset_len_minus1 = nvcl_read_u_expgolomb(rdr);
         for (i = 0; i < nb_entry_points; i++) {
             sh->sh_entry_point_offset_minus1[i] = nvcl_read_bits(rdr, sh->sh_entry_offset_len_minus1 + 1);
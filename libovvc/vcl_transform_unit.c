@@ -578,7 +578,7 @@ recon_isp_subtree_v(OVCTUDec *const ctudec,
 
             if (log2_pb_w) {
                 int shift_v = 6 + 1;
-                int shift_h = (6 + 15 - 1) - 10;
+                int shift_h = (6 + 15 - 1) - BITDEPTH;
                 DECLARE_ALIGNED(32, int16_t, tmp)[64*64];
                 int16_t *src = coeffs_y;
                 int16_t *dst = ctudec->transform_buff;
@@ -601,7 +601,7 @@ recon_isp_subtree_v(OVCTUDec *const ctudec,
                 TRFunc->func[type_v][OVMIN(log2_cb_h,6)](src, tmp, pb_w, pb_w, cb_h, shift_v);
                 TRFunc->func[type_h][OVMIN(log2_pb_w,6)](tmp, dst, cb_h, cb_h, pb_w, shift_h);
             } else {
-                int shift_h = (6 + 15 - 1) - 10;
+                int shift_h = (6 + 15 - 1) - BITDEPTH;
                 int cb_h = 1 << log2_cb_h;
                 DECLARE_ALIGNED(32, int16_t, tmp)[64];
 
@@ -676,7 +676,7 @@ recon_isp_subtree_h(OVCTUDec *const ctudec,
             if (log2_pb_h) {
                 DECLARE_ALIGNED(32, int16_t, tmp)[64*64];
                 int shift_v = 6 + 1;
-                int shift_h = (6 + 15 - 1) - 10;
+                int shift_h = (6 + 15 - 1) - BITDEPTH;
                 int16_t *src = coeffs_y;
                 int16_t *dst = ctudec->transform_buff;
                 int cb_w = 1 << log2_cb_w;
@@ -701,7 +701,7 @@ recon_isp_subtree_h(OVCTUDec *const ctudec,
                 TRFunc->func[type_v][OVMIN(log2_pb_h,6)](src, tmp, cb_w, cb_w, pb_h, shift_v);
                 TRFunc->func[type_h][OVMIN(log2_cb_w,6)](tmp, dst, pb_h, pb_h, cb_w, shift_h);
             } else {
-                int shift_h = (6 + 15 - 1) - 10;
+                int shift_h = (6 + 15 - 1) - BITDEPTH;
                 int cb_w = 1 << log2_cb_w;
                 DECLARE_ALIGNED(32, int16_t, tmp)[64];
 
@@ -1055,21 +1055,21 @@ rcn_tu_st(OVCTUDec *const ctu_dec,
     if (cbf_flag_l) {
         const struct TBInfo *const tb_info = &tu_info->tb_info[2];
 
+        uint16_t *const dst = &ctu_dec->rcn_ctx.ctu_buff.y[x0 + y0 * RCN_CTB_STRIDE];
+
         if (!(tu_info->tr_skip_mask & 0x10)) {
             int lim_sb_s = ((((tb_info->last_pos >> 8)) >> 2) + (((tb_info->last_pos & 0xFF))>> 2) + 1) << 2;
             int16_t *const coeffs_y = ctu_dec->residual_y + tu_info->pos_offset;
             uint8_t is_mip = !!(cu_flags & flg_mip_flag);
-            rcn_residual(ctu_dec, ctu_dec->transform_buff, coeffs_y, x0, y0, log2_tb_w, log2_tb_h,
+            rcn_residual(ctu_dec, dst, coeffs_y, x0, y0, log2_tb_w, log2_tb_h,
                          lim_sb_s, tu_info->cu_mts_flag, tu_info->cu_mts_idx,
                          !tb_info->last_pos, tu_info->lfnst_flag, is_mip, tu_info->lfnst_idx, tu_info->is_sbt);
 
         } else {
             int16_t *const coeffs_y = ctu_dec->residual_y + tu_info->pos_offset;
-            memcpy(ctu_dec->transform_buff, coeffs_y, sizeof(int16_t) << (log2_tb_w + log2_tb_h));
+            vvc_add_residual(coeffs_y, dst, log2_tb_w, log2_tb_h, 0);
         }
 
-        /* FIXME use transform add optimization */
-        vvc_add_residual(ctu_dec->transform_buff, &ctu_dec->rcn_ctx.ctu_buff.y[x0 + y0 * RCN_CTB_STRIDE], log2_tb_w, log2_tb_h, 0);
         /* FIXME Avoid reprocessing CCLM from here by recontructing at the end of transform tree */
         if (ctu_dec->intra_mode_c >= 67 && ctu_dec->intra_mode_c < 70) {
             vvc_intra_pred_chroma(&ctu_dec->rcn_ctx, &ctu_dec->rcn_ctx.ctu_buff, ctu_dec->intra_mode_c, x0 >> 1, y0 >> 1, log2_tb_w - 1, log2_tb_h - 1);
@@ -1109,24 +1109,23 @@ rcn_tu_l(OVCTUDec *const ctu_dec,
 {
     const struct TBInfo *const tb_info = &tu_info->tb_info[2];
     if (cbf_mask) {
+        uint16_t *const dst = &ctu_dec->rcn_ctx.ctu_buff.y[x0 + y0 * RCN_CTB_STRIDE];
+
         if (!(tu_info->tr_skip_mask & 0x10)) {
             int lim_sb_s = ((((tb_info->last_pos >> 8)) >> 2) + (((tb_info->last_pos & 0xFF))>> 2) + 1) << 2;
             int16_t *const coeffs_y = ctu_dec->residual_y + tu_info->pos_offset;
             uint8_t is_mip = !!(cu_flags & flg_mip_flag);
-            rcn_residual(ctu_dec, ctu_dec->transform_buff, coeffs_y, x0, y0, log2_tb_w, log2_tb_h,
+            rcn_residual(ctu_dec, dst, coeffs_y, x0, y0, log2_tb_w, log2_tb_h,
                          lim_sb_s, tu_info->cu_mts_flag, tu_info->cu_mts_idx,
                          !tb_info->last_pos, tu_info->lfnst_flag, is_mip, tu_info->lfnst_idx, tu_info->is_sbt);
 
         } else {
             int16_t *const coeffs_y = ctu_dec->residual_y + tu_info->pos_offset;
-            memcpy(ctu_dec->transform_buff, coeffs_y, sizeof(int16_t) << (log2_tb_w + log2_tb_h));
+            vvc_add_residual(coeffs_y, dst, log2_tb_w, log2_tb_h, 0);
         }
 
         fill_bs_map(&ctu_dec->dbf_info.bs1_map, x0, y0, log2_tb_w, log2_tb_h);
         fill_ctb_bound(&ctu_dec->dbf_info, x0, y0, log2_tb_w, log2_tb_h);
-
-        /* FIXME use transform add optimization */
-        vvc_add_residual(ctu_dec->transform_buff, &ctu_dec->rcn_ctx.ctu_buff.y[x0 + y0 * RCN_CTB_STRIDE], log2_tb_w, log2_tb_h, 0);
     }
 }
 
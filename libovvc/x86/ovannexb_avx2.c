@@ -0,0 +1,36 @@
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "ovannexb.h"
+
+/* Process 32 candidate positions at once, bytes at positions +1 and +2
+ * are obtained from unaligned loads so a block needs 34 bytes
+ */
+const uint8_t *
+ovannexb_find_candidate_avx2(const uint8_t *byte, const uint8_t *end)
+{
+    const __m256i zero  = _mm256_setzero_si256();
+    const __m256i three = _mm256_set1_epi8(0x3);
+
+    while (byte + 34 <= end) {
+        __m256i b0 = _mm256_loadu_si256((const __m256i *)byte);
+        __m256i b1 = _mm256_loadu_si256((const __m256i *)(byte + 1));
+        __m256i b2 = _mm256_loadu_si256((const __m256i *)(byte + 2));
+
+        __m256i z0 = _mm256_cmpeq_epi8(b0, zero);
+        __m256i z1 = _mm256_cmpeq_epi8(b1, zero);
+
+        /* Unsigned b2 <= 3 */
+        __m256i le3 = _mm256_cmpeq_epi8(_mm256_min_epu8(b2, three), b2);
+
+        uint32_t mask = _mm256_movemask_epi8(_mm256_and_si256(_mm256_and_si256(z0, z1), le3));
+
+        if (mask) {
+            return byte + __builtin_ctz(mask);
+        }
+
+        byte += 32;
+    }
+
+    return byte;
+}
@@ -0,0 +1,36 @@
+#include <stdint.h>
+#include <emmintrin.h>
+
+#include "ovannexb.h"
+
+/* Process 16 candidate positions at once, bytes at positions +1 and +2
+ * are obtained from unaligned loads so a block needs 18 bytes
+ */
+const uint8_t *
+ovannexb_find_candidate_sse(const uint8_t *byte, const uint8_t *end)
+{
+    const __m128i zero  = _mm_setzero_si128();
+    const __m128i three = _mm_set1_epi8(0x3);
+
+    while (byte + 18 <= end) {
+        __m128i b0 = _mm_loadu_si128((const __m128i *)byte);
+        __m128i b1 = _mm_loadu_si128((const __m128i *)(byte + 1));
+        __m128i b2 = _mm_loadu_si128((const __m128i *)(byte + 2));
+
+        __m128i z0 = _mm_cmpeq_epi8(b0, zero);
+        __m128i z1 = _mm_cmpeq_epi8(b1, zero);
+
+        /* Unsigned b2 <= 3 */
+        __m128i le3 = _mm_cmpeq_epi8(_mm_min_epu8(b2, three), b2);
+
+        int mask = _mm_movemask_epi8(_mm_and_si128(_mm_and_si128(z0, z1), le3));
+
+        if (mask) {
+            return byte + __builtin_ctz(mask);
+        }
+
+        byte += 16;
+    }
+
+    return byte;
+}
@@ -0,0 +1,179 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "ovutils.h"
+#include "post_proc.h"
+
+/* Kernels load pictures samples as 16 bits words, grain is
+ * scaled to the bitdepth argument
+ */
+#if BITDEPTH != 10
+#error "Film grain SIMD kernels require 16 bits OVSample (BITDEPTH 10)"
+#endif
+
+#define GRAIN_SCALE 6
+
+/* Grain data base blocks are read from lines of 64 samples */
+#define DATA_BASE_SIZE 64
+
+static inline __m256i
+loadu_2x128(const void *lo, const void *hi)
+{
+  __m256i x = _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)lo));
+  return _mm256_inserti128_si256(x, _mm_loadu_si128((__m128i *)hi), 1);
+}
+
+static int16_t
+fg_block_avg_avx2(const OVSample *src, uint32_t src_stride, uint16_t *nb_samples,
+                  uint8_t blk_h, uint8_t blk_w, uint8_t bitdepth)
+{
+  __m256i sum;
+  __m128i sum_128;
+  int k;
+
+  /* Partial blocks on picture borders */
+  if (blk_h != 8 || blk_w != 8) {
+    return fg_compute_block_avg(src, src_stride, nb_samples, blk_h, blk_w, bitdepth);
+  }
+
+  /* Two lines per register, sum of 4 samples per lane fits on 16 bits */
+  sum = loadu_2x128(src, &src[src_stride]);
+  for (k = 2; k < 8; k += 2) {
+    sum = _mm256_add_epi16(sum, loadu_2x128(&src[k * src_stride], &src[(k + 1) * src_stride]));
+  }
+
+  sum = _mm256_madd_epi16(sum, _mm256_set1_epi16(1));
+  sum_128 = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+  sum_128 = _mm_add_epi32(sum_128, _mm_shuffle_epi32(sum_128, 0x4E));
+  sum_128 = _mm_add_epi32(sum_128, _mm_shuffle_epi32(sum_128, 0xB1));
+
+  *nb_samples = 64;
+
+  return ov_clip_uintp2((uint32_t)_mm_cvtsi128_si32(sum_128) >> (6 + bitdepth - 8), 8);
+}
+
+static void
+fg_grain_blk8x8_avx2(int16_t *grain, uint32_t grain_stride, const int8_t *grain_db,
+                     uint8_t log2_scale_factor, int16_t scale_factor, uint32_t blk_w)
+{
+  const __m256i sf = _mm256_set1_epi32(scale_factor);
+  const __m128i shift = _mm_cvtsi32_si128(log2_scale_factor + GRAIN_SCALE);
+  int k;
+
+  if (blk_w != 8) {
+    fg_simulate_grain_blk8x8(grain, grain_stride, grain_db, log2_scale_factor, scale_factor, blk_w);
+    return;
+  }
+
+  /* Two lines per iteration */
+  for (k = 0; k < 8; k += 2) {
+    __m256i p0 = _mm256_cvtepi8_epi32(_mm_loadl_epi64((__m128i *)grain_db));
+    __m256i p1 = _mm256_cvtepi8_epi32(_mm_loadl_epi64((__m128i *)&grain_db[DATA_BASE_SIZE]));
+    __m256i g;
+
+    p0 = _mm256_sra_epi32(_mm256_mullo_epi32(p0, sf), shift);
+    p1 = _mm256_sra_epi32(_mm256_mullo_epi32(p1, sf), shift);
+
+    /* Pack is done per 128 bits lane */
+    g = _mm256_permute4x64_epi64(_mm256_packs_epi32(p0, p1), 0xD8);
+
+    _mm_storeu_si128((__m128i *)grain, _mm256_castsi256_si128(g));
+    _mm_storeu_si128((__m128i *)&grain[grain_stride], _mm256_extracti128_si256(g, 1));
+
+    grain    += grain_stride << 1;
+    grain_db += DATA_BASE_SIZE << 1;
+  }
+}
+
+/* (l + 2 * c + r) >> 2 computed as ((l + r) >> 1 + c) >> 1 which gives
+ * the same result without overflowing 16 bits
+ */
+static void
+fg_deblock_stripe_avx2(int16_t *grain, uint32_t width, uint32_t grain_stride)
+{
+  /* Only the two samples around each edge are modified */
+  const __m256i edge_msk = _mm256_setr_epi16(0, 0, 0, -1, -1, 0, 0, 0,
+                                             0, 0, 0, -1, -1, 0, 0, 0);
+  const __m256i last_edge_msk = _mm256_setr_epi16(0, 0, 0, -1, -1, 0, 0, 0,
+                                                  0, 0, 0,  0,  0, 0, 0, 0);
+  uint32_t nb_edges, pos8;
+  int k;
+
+  if (width <= 8) {
+    return;
+  }
+
+  nb_edges = (width - 8 + 7) >> 3;
+
+  /* Two edges per iteration, last edge uses low lane only */
+  for (pos8 = 0; nb_edges; pos8 += 16) {
+    const __m256i msk = nb_edges > 1 ? edge_msk : last_edge_msk;
+    int16_t *ln = grain + pos8 + 4;
+
+    for (k = 0; k < 16; ++k) {
+      __m256i l = _mm256_loadu_si256((__m256i *)&ln[-1]);
+      __m256i c = _mm256_loadu_si256((__m256i *)&ln[0]);
+      __m256i r = _mm256_loadu_si256((__m256i *)&ln[1]);
+      __m256i f = _mm256_srai_epi16(_mm256_add_epi16(l, r), 1);
+
+      f = _mm256_srai_epi16(_mm256_add_epi16(f, c), 1);
+
+      _mm256_storeu_si256((__m256i *)ln, _mm256_blendv_epi8(c, f, msk));
+
+      ln += grain_stride;
+    }
+
+    nb_edges -= OVMIN(nb_edges, 2);
+  }
+}
+
+static void
+fg_blend_stripe_avx2(OVSample *dst, const OVSample *src, const int16_t *grain,
+                     uint32_t width, uint32_t grain_stride, uint32_t pic_stride,
+                     uint32_t blk_h, uint8_t bitdepth)
+{
+  const __m256i max_val = _mm256_set1_epi16((1 << bitdepth) - 1);
+  const __m256i zero = _mm256_setzero_si256();
+  uint32_t width16 = width & ~15;
+  int scale_shift = bitdepth - 8;
+  uint32_t k, l;
+  int i;
+
+  for (l = 0; l < blk_h; ++l) {
+    for (k = 0; k < width16; k += 16) {
+      __m256i s = _mm256_loadu_si256((__m256i *)&src[k]);
+      __m256i g = _mm256_loadu_si256((__m256i *)&grain[k]);
+
+      /* Grain is scaled to bitdepth with saturated doublings,
+       * saturation does not change the clipped result
+       */
+      for (i = 0; i < scale_shift; ++i) {
+        g = _mm256_adds_epi16(g, g);
+      }
+
+      s = _mm256_adds_epi16(s, g);
+      s = _mm256_min_epi16(_mm256_max_epi16(s, zero), max_val);
+
+      _mm256_storeu_si256((__m256i *)&dst[k], s);
+    }
+
+    for (; k < width; ++k) {
+      int32_t grain_val = grain[k] << (bitdepth - 8);
+      dst[k] = ov_clip_uintp2(src[k] + grain_val, bitdepth);
+    }
+
+    dst   += pic_stride;
+    src   += pic_stride;
+    grain += grain_stride;
+  }
+}
+
+void
+pp_init_fg_functions_avx2(struct FGFunctions *const fg_funcs)
+{
+  fg_funcs->block_avg      = &fg_block_avg_avx2;
+  fg_funcs->grain_blk8x8   = &fg_grain_blk8x8_avx2;
+  fg_funcs->deblock_stripe = &fg_deblock_stripe_avx2;
+  fg_funcs->blend_stripe   = &fg_blend_stripe_avx2;
+}
@@ -0,0 +1,167 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <smmintrin.h>
+
+#include "ovutils.h"
+#include "post_proc.h"
+
+/* Kernels load pictures samples as 16 bits words, grain is
+ * scaled to the bitdepth argument
+ */
+#if BITDEPTH != 10
+#error "Film grain SIMD kernels require 16 bits OVSample (BITDEPTH 10)"
+#endif
+
+#define GRAIN_SCALE 6
+
+/* Grain data base blocks are read from lines of 64 samples */
+#define DATA_BASE_SIZE 64
+
+static int16_t
+fg_block_avg_sse(const OVSample *src, uint32_t src_stride, uint16_t *nb_samples,
+                 uint8_t blk_h, uint8_t blk_w, uint8_t bitdepth)
+{
+  __m128i sum;
+  int k;
+
+  /* Partial blocks on picture borders */
+  if (blk_h != 8 || blk_w != 8) {
+    return fg_compute_block_avg(src, src_stride, nb_samples, blk_h, blk_w, bitdepth);
+  }
+
+  /* Sum of 8 samples per lane fits on 16 bits */
+  sum = _mm_loadu_si128((__m128i *)src);
+  for (k = 1; k < 8; ++k) {
+    sum = _mm_add_epi16(sum, _mm_loadu_si128((__m128i *)&src[k * src_stride]));
+  }
+
+  sum = _mm_madd_epi16(sum, _mm_set1_epi16(1));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+
+  *nb_samples = 64;
+
+  return ov_clip_uintp2((uint32_t)_mm_cvtsi128_si32(sum) >> (6 + bitdepth - 8), 8);
+}
+
+static void
+fg_grain_blk8x8_sse(int16_t *grain, uint32_t grain_stride, const int8_t *grain_db,
+                    uint8_t log2_scale_factor, int16_t scale_factor, uint32_t blk_w)
+{
+  const __m128i sf = _mm_set1_epi16(scale_factor);
+  const __m128i shift = _mm_cvtsi32_si128(log2_scale_factor + GRAIN_SCALE);
+  int k;
+
+  if (blk_w != 8) {
+    fg_simulate_grain_blk8x8(grain, grain_stride, grain_db, log2_scale_factor, scale_factor, blk_w);
+    return;
+  }
+
+  for (k = 0; k < 8; ++k) {
+    __m128i db = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i *)grain_db));
+    __m128i lo = _mm_mullo_epi16(db, sf);
+    __m128i hi = _mm_mulhi_epi16(db, sf);
+    __m128i p0 = _mm_unpacklo_epi16(lo, hi);
+    __m128i p1 = _mm_unpackhi_epi16(lo, hi);
+
+    p0 = _mm_sra_epi32(p0, shift);
+    p1 = _mm_sra_epi32(p1, shift);
+
+    _mm_storeu_si128((__m128i *)grain, _mm_packs_epi32(p0, p1));
+
+    grain    += grain_stride;
+    grain_db += DATA_BASE_SIZE;
+  }
+}
+
+/* (l + 2 * c + r) >> 2 computed as ((l + r) >> 1 + c) >> 1 which gives
+ * the same result without overflowing 16 bits
+ */
+static inline __m128i
+fg_smooth_sse(const int16_t *grain)
+{
+  __m128i l = _mm_loadu_si128((__m128i *)&grain[-1]);
+  __m128i c = _mm_loadu_si128((__m128i *)&grain[0]);
+  __m128i r = _mm_loadu_si128((__m128i *)&grain[1]);
+
+  __m128i s = _mm_srai_epi16(_mm_add_epi16(l, r), 1);
+
+  return _mm_srai_epi16(_mm_add_epi16(s, c), 1);
+}
+
+static void
+fg_deblock_stripe_sse(int16_t *grain, uint32_t width, uint32_t grain_stride)
+{
+  /* Only the two samples around the edge are modified */
+  const __m128i edge_msk = _mm_setr_epi16(0, 0, 0, -1, -1, 0, 0, 0);
+  uint32_t pos8;
+  int k;
+
+  if (width <= 8) {
+    return;
+  }
+
+  for (pos8 = 0; pos8 < width - 8; pos8 += 8) {
+    int16_t *ln = grain + pos8 + 4;
+    for (k = 0; k < 16; ++k) {
+      __m128i c = _mm_loadu_si128((__m128i *)ln);
+      __m128i f = fg_smooth_sse(ln);
+
+      _mm_storeu_si128((__m128i *)ln, _mm_blendv_epi8(c, f, edge_msk));
+
+      ln += grain_stride;
+    }
+  }
+}
+
+static void
+fg_blend_stripe_sse(OVSample *dst, const OVSample *src, const int16_t *grain,
+                    uint32_t width, uint32_t grain_stride, uint32_t pic_stride,
+                    uint32_t blk_h, uint8_t bitdepth)
+{
+  const __m128i max_val = _mm_set1_epi16((1 << bitdepth) - 1);
+  const __m128i zero = _mm_setzero_si128();
+  uint32_t width8 = width & ~7;
+  int scale_shift = bitdepth - 8;
+  uint32_t k, l;
+  int i;
+
+  for (l = 0; l < blk_h; ++l) {
+    for (k = 0; k < width8; k += 8) {
+      __m128i s = _mm_loadu_si128((__m128i *)&src[k]);
+      __m128i g = _mm_loadu_si128((__m128i *)&grain[k]);
+
+      /* Grain is scaled to bitdepth with saturated doublings,
+       * saturation does not change the clipped result
+       */
+      for (i = 0; i < scale_shift; ++i) {
+        g = _mm_adds_epi16(g, g);
+      }
+
+      s = _mm_adds_epi16(s, g);
+      s = _mm_min_epi16(_mm_max_epi16(s, zero), max_val);
+
+      _mm_storeu_si128((__m128i *)&dst[k], s);
+    }
+
+    for (; k < width; ++k) {
+      int32_t grain_val = grain[k] << (bitdepth - 8);
+      dst[k] = ov_clip_uintp2(src[k] + grain_val, bitdepth);
+    }
+
+    dst   += pic_stride;
+    src   += pic_stride;
+    grain += grain_stride;
+  }
+}
+
+void
+pp_init_fg_functions_sse(struct FGFunctions *const fg_funcs)
+{
+  fg_funcs->block_avg      = &fg_block_avg_sse;
+  fg_funcs->grain_blk8x8   = &fg_grain_blk8x8_sse;
+  fg_funcs->deblock_stripe = &fg_deblock_stripe_sse;
+  fg_funcs->blend_stripe   = &fg_blend_stripe_sse;
+}
@@ -0,0 +1,742 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "ovutils.h"
+#include "rcn_alf.h"
+#include "rcn_structures.h"
+#include "x86/rcn_avx2.h"
+
+#define ALF_SHIFT  (NUM_BITS - 1)
+#define ALF_ROUND  (1 << (ALF_SHIFT - 1))
+
+/* Rounding is changed on the lines next to the virtual boundary */
+#define ALF_SHIFT_VB  (ALF_SHIFT + 3)
+#define ALF_ROUND_VB  (1 << (ALF_SHIFT_VB - 1))
+
+#define ALF_LUMA_FILTER_IDX(transpose_idx, class_idx) \
+  ((transpose_idx) * MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_LUMA_COEFF + (class_idx) * MAX_NUM_ALF_LUMA_COEFF)
+
+static inline __m256i
+loadu_2x128(const void *lo, const void *hi)
+{
+  __m256i x = _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)lo));
+  return _mm256_inserti128_si256(x, _mm_loadu_si128((__m128i *)hi), 1);
+}
+
+/* Store the first nb_smp samples of a line, nb_smp being a multiple of 4 */
+static inline void
+store_n_epi16(OVSample *dst, __m256i val, int nb_smp)
+{
+  __m128i lo = _mm256_castsi256_si128(val);
+
+  if (nb_smp >= 16) {
+    _mm256_storeu_si256((__m256i *)dst, val);
+  } else if (nb_smp >= 8) {
+    _mm_storeu_si128((__m128i *)dst, lo);
+    if (nb_smp == 12) {
+      _mm_storel_epi64((__m128i *)&dst[8], _mm256_extracti128_si256(val, 1));
+    }
+  } else {
+    _mm_storel_epi64((__m128i *)dst, lo);
+  }
+}
+
+/* Sum of clipped differences between a pair of symmetric samples
+ * and current sample weighted by a pair of coefficients
+ */
+static inline void
+alf_process_2_coeffs(__m256i *accum_a, __m256i *accum_b, __m256i cur,
+                     const uint16_t *ptr0, const uint16_t *ptr1,
+                     const uint16_t *ptr2, const uint16_t *ptr3,
+                     __m256i coeff_a, __m256i coeff_b,
+                     __m256i clip_a, __m256i clip_b)
+{
+  const __m256i val00 = _mm256_sub_epi16(_mm256_loadu_si256((const __m256i *)ptr0), cur);
+  const __m256i val10 = _mm256_sub_epi16(_mm256_loadu_si256((const __m256i *)ptr2), cur);
+  const __m256i val01 = _mm256_sub_epi16(_mm256_loadu_si256((const __m256i *)ptr1), cur);
+  const __m256i val11 = _mm256_sub_epi16(_mm256_loadu_si256((const __m256i *)ptr3), cur);
+
+  __m256i val01a = _mm256_unpacklo_epi16(val00, val10);
+  __m256i val01b = _mm256_unpackhi_epi16(val00, val10);
+  __m256i val01c = _mm256_unpacklo_epi16(val01, val11);
+  __m256i val01d = _mm256_unpackhi_epi16(val01, val11);
+
+  const __m256i min_a = _mm256_sub_epi16(_mm256_setzero_si256(), clip_a);
+  const __m256i min_b = _mm256_sub_epi16(_mm256_setzero_si256(), clip_b);
+
+  val01a = _mm256_max_epi16(_mm256_min_epi16(val01a, clip_a), min_a);
+  val01b = _mm256_max_epi16(_mm256_min_epi16(val01b, clip_b), min_b);
+  val01c = _mm256_max_epi16(_mm256_min_epi16(val01c, clip_a), min_a);
+  val01d = _mm256_max_epi16(_mm256_min_epi16(val01d, clip_b), min_b);
+
+  val01a = _mm256_add_epi16(val01a, val01c);
+  val01b = _mm256_add_epi16(val01b, val01d);
+
+  *accum_a = _mm256_add_epi32(*accum_a, _mm256_madd_epi16(val01a, coeff_a));
+  *accum_b = _mm256_add_epi32(*accum_b, _mm256_madd_epi16(val01b, coeff_b));
+}
+
+/* Samples of a line are interleaved by unpack in each 128 bits lane so
+ * coefficients of 4x4 blocks 0 and 2 are used for the first half of
+ * lanes and those of blocks 1 and 3 for the second half
+ */
+static inline void
+alf_load_luma_params(__m256i params[2][2][6], const int16_t *filter_set, const int16_t *clip_set,
+                     const uint8_t *class_idx_arr, const uint8_t *transpose_idx_arr, int nb_blk)
+{
+  int k;
+
+  for (k = 0; k < 2; ++k) {
+    int blk_lo = k;
+    int blk_hi = nb_blk > 2 ? k + 2 : k;
+    int filt_lo = ALF_LUMA_FILTER_IDX(transpose_idx_arr[blk_lo], class_idx_arr[blk_lo]);
+    int filt_hi = ALF_LUMA_FILTER_IDX(transpose_idx_arr[blk_hi], class_idx_arr[blk_hi]);
+
+    const __m256i coeff_lo = loadu_2x128(&filter_set[filt_lo], &filter_set[filt_hi]);
+    const __m256i coeff_hi = loadu_2x128(&filter_set[filt_lo + 8], &filter_set[filt_hi + 8]);
+    const __m256i clip_lo  = loadu_2x128(&clip_set[filt_lo], &clip_set[filt_hi]);
+    const __m256i clip_hi  = loadu_2x128(&clip_set[filt_lo + 8], &clip_set[filt_hi + 8]);
+
+    params[k][0][0] = _mm256_shuffle_epi32(coeff_lo, 0x00);
+    params[k][0][1] = _mm256_shuffle_epi32(coeff_lo, 0x55);
+    params[k][0][2] = _mm256_shuffle_epi32(coeff_lo, 0xaa);
+    params[k][0][3] = _mm256_shuffle_epi32(coeff_lo, 0xff);
+    params[k][0][4] = _mm256_shuffle_epi32(coeff_hi, 0x00);
+    params[k][0][5] = _mm256_shuffle_epi32(coeff_hi, 0x55);
+    params[k][1][0] = _mm256_shuffle_epi32(clip_lo, 0x00);
+    params[k][1][1] = _mm256_shuffle_epi32(clip_lo, 0x55);
+    params[k][1][2] = _mm256_shuffle_epi32(clip_lo, 0xaa);
+    params[k][1][3] = _mm256_shuffle_epi32(clip_lo, 0xff);
+    params[k][1][4] = _mm256_shuffle_epi32(clip_hi, 0x00);
+    params[k][1][5] = _mm256_shuffle_epi32(clip_hi, 0x55);
+  }
+}
+
+static inline void
+alf_filter_luma_avx2(uint8_t *class_idx_arr, uint8_t *transpose_idx_arr,
+                     OVSample *const dst, int16_t *const src,
+                     const int dst_stride, const int src_stride,
+                     struct Area blk_dst, const int16_t *filter_set, const int16_t *clip_set,
+                     const int ctu_height, int virbnd_pos, int use_vb)
+{
+  const __m256i offset    = _mm256_set1_epi32(ALF_ROUND);
+  const __m256i offset_vb = _mm256_set1_epi32(ALF_ROUND_VB);
+  const __m256i max_val   = _mm256_set1_epi16((1 << 10) - 1);
+  const __m256i zero      = _mm256_setzero_si256();
+
+  int16_t *_src = src;
+  OVSample *_dst = dst;
+  int i, j, ii;
+
+  for (i = 0; i < blk_dst.height; i += 4) {
+    for (j = 0; j < blk_dst.width; j += 16) {
+      int nb_smp = OVMIN(16, blk_dst.width - j);
+      int cls_idx = (i >> 2) * CLASSIFICATION_BLK_SIZE + (j >> 2);
+      __m256i params[2][2][6];
+
+      alf_load_luma_params(params, filter_set, clip_set, &class_idx_arr[cls_idx],
+                           &transpose_idx_arr[cls_idx], nb_smp >> 2);
+
+      for (ii = 0; ii < 4; ii++) {
+        const uint16_t *img0, *img1, *img2, *img3, *img4, *img5, *img6;
+        uint8_t near_vb = 0;
+        __m256i cur, accum_a, accum_b;
+        int k;
+
+        img0 = (uint16_t *)_src + j + ii * src_stride;
+        img1 = img0 + src_stride;
+        img2 = img0 - src_stride;
+        img3 = img1 + src_stride;
+        img4 = img2 - src_stride;
+        img5 = img3 + src_stride;
+        img6 = img4 - src_stride;
+
+        if (use_vb) {
+          const int y_vb = (blk_dst.y + i + ii) & (ctu_height - 1);
+
+          if (y_vb < virbnd_pos && (y_vb >= virbnd_pos - 4)) {
+            img1 = (y_vb == virbnd_pos - 1) ? img0 : img1;
+            img3 = (y_vb >= virbnd_pos - 2) ? img1 : img3;
+            img5 = (y_vb >= virbnd_pos - 3) ? img3 : img5;
+
+            img2 = (y_vb == virbnd_pos - 1) ? img0 : img2;
+            img4 = (y_vb >= virbnd_pos - 2) ? img2 : img4;
+            img6 = (y_vb >= virbnd_pos - 3) ? img4 : img6;
+          } else if (y_vb >= virbnd_pos && (y_vb <= virbnd_pos + 3)) {
+            img2 = (y_vb == virbnd_pos) ? img0 : img2;
+            img4 = (y_vb <= virbnd_pos + 1) ? img2 : img4;
+            img6 = (y_vb <= virbnd_pos + 2) ? img4 : img6;
+
+            img1 = (y_vb == virbnd_pos) ? img0 : img1;
+            img3 = (y_vb <= virbnd_pos + 1) ? img1 : img3;
+            img5 = (y_vb <= virbnd_pos + 2) ? img3 : img5;
+          }
+
+          near_vb = y_vb == virbnd_pos - 1 || y_vb == virbnd_pos;
+        }
+
+        cur = _mm256_loadu_si256((const __m256i *)img0);
+
+        accum_a = near_vb ? offset_vb : offset;
+        accum_b = accum_a;
+
+        #define ALF_LUMA_2_COEFFS(k, p0, p1, p2, p3)\
+        alf_process_2_coeffs(&accum_a, &accum_b, cur, p0, p1, p2, p3,\
+                             params[0][0][k], params[1][0][k],\
+                             params[0][1][k], params[1][1][k])
+
+        ALF_LUMA_2_COEFFS(0, img5 + 0, img6 + 0, img3 + 1, img4 - 1);
+        ALF_LUMA_2_COEFFS(1, img3 + 0, img4 + 0, img3 - 1, img4 + 1);
+        ALF_LUMA_2_COEFFS(2, img1 + 2, img2 - 2, img1 + 1, img2 - 1);
+        ALF_LUMA_2_COEFFS(3, img1 + 0, img2 + 0, img1 - 1, img2 + 1);
+        ALF_LUMA_2_COEFFS(4, img1 - 2, img2 + 2, img0 + 3, img0 - 3);
+        ALF_LUMA_2_COEFFS(5, img0 + 2, img0 - 2, img0 + 1, img0 - 1);
+
+        #undef ALF_LUMA_2_COEFFS
+
+        k = near_vb ? ALF_SHIFT_VB : ALF_SHIFT;
+        accum_a = _mm256_sra_epi32(accum_a, _mm_cvtsi32_si128(k));
+        accum_b = _mm256_sra_epi32(accum_b, _mm_cvtsi32_si128(k));
+
+        accum_a = _mm256_packs_epi32(accum_a, accum_b);
+        accum_a = _mm256_add_epi16(accum_a, cur);
+        accum_a = _mm256_min_epi16(max_val, _mm256_max_epi16(accum_a, zero));
+
+        store_n_epi16(_dst + ii * dst_stride + j, accum_a, nb_smp);
+      }
+    }
+
+    _src += src_stride * 4;
+    _dst += dst_stride * 4;
+  }
+}
+
+static void
+alf_filter_luma_blk_avx2(uint8_t *class_idx_arr, uint8_t *transpose_idx_arr,
+                         OVSample *const dst, int16_t *const src,
+                         const int dst_stride, const int src_stride,
+                         struct Area blk_dst, const int16_t *filter_set, const int16_t *clip_set,
+                         const int ctu_height, int virbnd_pos)
+{
+  alf_filter_luma_avx2(class_idx_arr, transpose_idx_arr, dst, src, dst_stride, src_stride,
+                       blk_dst, filter_set, clip_set, ctu_height, virbnd_pos, 0);
+}
+
+static void
+alf_filter_luma_blk_vb_avx2(uint8_t *class_idx_arr, uint8_t *transpose_idx_arr,
+                            OVSample *const dst, int16_t *const src,
+                            const int dst_stride, const int src_stride,
+                            struct Area blk_dst, const int16_t *filter_set, const int16_t *clip_set,
+                            const int ctu_height, int virbnd_pos)
+{
+  alf_filter_luma_avx2(class_idx_arr, transpose_idx_arr, dst, src, dst_stride, src_stride,
+                       blk_dst, filter_set, clip_set, ctu_height, virbnd_pos, 1);
+}
+
+static inline void
+alf_filter_chroma_avx2(OVSample *const dst, const int16_t *const src,
+                       const int dst_stride, const int src_stride,
+                       struct Area blk_dst,
+                       const int16_t *const filter_set, const int16_t *const clip_set,
+                       const int ctu_height, int virbnd_pos, int use_vb)
+{
+  const __m256i offset    = _mm256_set1_epi32(ALF_ROUND);
+  const __m256i offset_vb = _mm256_set1_epi32(ALF_ROUND_VB);
+  const __m256i max_val   = _mm256_set1_epi16((1 << 10) - 1);
+  const __m256i zero      = _mm256_setzero_si256();
+
+  const __m256i fs = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)filter_set));
+  const __m256i fc = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)clip_set));
+  const __m256i coeff[3] = {
+    _mm256_shuffle_epi32(fs, 0x00), _mm256_shuffle_epi32(fs, 0x55), _mm256_shuffle_epi32(fs, 0xaa)
+  };
+  const __m256i clip[3] = {
+    _mm256_shuffle_epi32(fc, 0x00), _mm256_shuffle_epi32(fc, 0x55), _mm256_shuffle_epi32(fc, 0xaa)
+  };
+
+  const int16_t *_src = src;
+  OVSample *_dst = dst;
+  int i, j, ii;
+
+  for (i = 0; i < blk_dst.height; i += 4) {
+    for (ii = 0; ii < 4; ii++) {
+      const int y_vb = (blk_dst.y + i + ii) & (ctu_height - 1);
+      uint8_t near_vb = use_vb && (y_vb == virbnd_pos - 1 || y_vb == virbnd_pos);
+      const __m128i shift = _mm_cvtsi32_si128(near_vb ? ALF_SHIFT_VB : ALF_SHIFT);
+
+      for (j = 0; j < blk_dst.width; j += 16) {
+        const uint16_t *img0, *img1, *img2, *img3, *img4;
+        __m256i cur, accum_a, accum_b;
+
+        img0 = (uint16_t *)_src + j + ii * src_stride;
+        img1 = img0 + src_stride;
+        img2 = img0 - src_stride;
+        img3 = img1 + src_stride;
+        img4 = img2 - src_stride;
+
+        if (use_vb) {
+          if (y_vb < virbnd_pos && (y_vb >= virbnd_pos - 2)) {
+            img1 = (y_vb == virbnd_pos - 1) ? img0 : img1;
+            img3 = img1;
+
+            img2 = (y_vb == virbnd_pos - 1) ? img0 : img2;
+            img4 = img2;
+          } else if (y_vb >= virbnd_pos && (y_vb <= virbnd_pos + 1)) {
+            img2 = (y_vb == virbnd_pos) ? img0 : img2;
+            img4 = img2;
+
+            img1 = (y_vb == virbnd_pos) ? img0 : img1;
+            img3 = img1;
+          }
+        }
+
+        cur = _mm256_loadu_si256((const __m256i *)img0);
+
+        accum_a = near_vb ? offset_vb : offset;
+        accum_b = accum_a;
+
+        alf_process_2_coeffs(&accum_a, &accum_b, cur, img3 + 0, img4 + 0, img1 + 1, img2 - 1,
+                             coeff[0], coeff[0], clip[0], clip[0]);
+        alf_process_2_coeffs(&accum_a, &accum_b, cur, img1 + 0, img2 + 0, img1 - 1, img2 + 1,
+                             coeff[1], coeff[1], clip[1], clip[1]);
+        alf_process_2_coeffs(&accum_a, &accum_b, cur, img0 + 2, img0 - 2, img0 + 1, img0 - 1,
+                             coeff[2], coeff[2], clip[2], clip[2]);
+
+        accum_a = _mm256_sra_epi32(accum_a, shift);
+        accum_b = _mm256_sra_epi32(accum_b, shift);
+
+        accum_a = _mm256_packs_epi32(accum_a, accum_b);
+        accum_a = _mm256_add_epi16(accum_a, cur);
+        accum_a = _mm256_min_epi16(max_val, _mm256_max_epi16(accum_a, zero));
+
+        store_n_epi16(_dst + ii * dst_stride + j, accum_a, OVMIN(16, blk_dst.width - j));
+      }
+    }
+
+    _src += src_stride * 4;
+    _dst += dst_stride * 4;
+  }
+}
+
+static void
+alf_filter_chroma_blk_avx2(OVSample *const dst, const int16_t *const src,
+                           const int dst_stride, const int src_stride,
+                           struct Area blk_dst,
+                           const int16_t *const filter_set, const int16_t *const clip_set,
+                           const int ctu_height, int virbnd_pos)
+{
+  alf_filter_chroma_avx2(dst, src, dst_stride, src_stride, blk_dst,
+                         filter_set, clip_set, ctu_height, virbnd_pos, 0);
+}
+
+static void
+alf_filter_chroma_blk_vb_avx2(OVSample *const dst, const int16_t *const src,
+                              const int dst_stride, const int src_stride,
+                              struct Area blk_dst,
+                              const int16_t *const filter_set, const int16_t *const clip_set,
+                              const int ctu_height, int virbnd_pos)
+{
+  alf_filter_chroma_avx2(dst, src, dst_stride, src_stride, blk_dst,
+                         filter_set, clip_set, ctu_height, virbnd_pos, 1);
+}
+
+/* Split 32 luma samples into 16 even and 16 odd samples */
+static inline void
+deinterleave_epi16(__m256i *even, __m256i *odd, const int16_t *src)
+{
+  const __m256i shuf = _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15,
+                                        0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+  __m256i x0 = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i *)&src[0]), shuf);
+  __m256i x1 = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i *)&src[16]), shuf);
+
+  x0 = _mm256_permute4x64_epi64(x0, 0xD8);
+  x1 = _mm256_permute4x64_epi64(x1, 0xD8);
+
+  *even = _mm256_permute2x128_si256(x0, x1, 0x20);
+  *odd  = _mm256_permute2x128_si256(x0, x1, 0x31);
+}
+
+static void
+cc_alf_filter_blk_vb_avx2(OVSample *chroma_dst, int16_t *luma_src, const int chr_stride, const int luma_stride,
+                          const struct Area blk_dst, const uint8_t c_id, const int16_t *filt_coeff,
+                          const int vb_ctu_height, int vb_pos)
+{
+  const __m256i filter01 = _mm256_set1_epi32((filt_coeff[0] & 0xFFFF) | ((filt_coeff[1] & 0xFFFF) << 16));
+  const __m256i filter23 = _mm256_set1_epi32((filt_coeff[2] & 0xFFFF) | ((filt_coeff[3] & 0xFFFF) << 16));
+  const __m256i filter45 = _mm256_set1_epi32((filt_coeff[4] & 0xFFFF) | ((filt_coeff[5] & 0xFFFF) << 16));
+  const __m256i filter6  = _mm256_set1_epi16(filt_coeff[6]);
+
+  const int scale_bits = 7;
+  const __m256i scale_offset = _mm256_set1_epi32((1 << scale_bits) >> 1);
+
+  const __m256i offset = _mm256_set1_epi16((1 << 10) >> 1);
+  const __m256i clip_h = _mm256_set1_epi16((1 << 10) - 1);
+  const __m256i clip_l = _mm256_setzero_si256();
+  int i, j, ii;
+
+  for (i = 0; i < blk_dst.height; i += 4) {
+    for (ii = 0; ii < 4; ii++) {
+      int offset1 = luma_stride;
+      int offset2 = -luma_stride;
+      int offset3 = 2 * luma_stride;
+
+      /* 4:2:0 only, luma lines are never on the virtual boundary */
+      int pos = ((blk_dst.y + i + ii) << 1) & (vb_ctu_height - 1);
+      if (pos == (vb_pos - 2) || pos == (vb_pos + 1)) {
+        offset3 = offset1;
+      } else if (pos == (vb_pos - 1) || pos == vb_pos) {
+        offset1 = 0;
+        offset2 = 0;
+        offset3 = 0;
+      }
+
+      for (j = 0; j < blk_dst.width; j += 16) {
+        OVSample *src_self = chroma_dst + j + ii * chr_stride;
+        const int16_t *src_cross = luma_src + (j << 1) + (ii << 1) * luma_stride;
+        __m256i val0, val1, val2, val3, val4, val5, val6, tmp, curr;
+        __m256i a0, a1;
+
+        __m256i self = _mm256_loadu_si256((const __m256i *)src_self);
+
+        deinterleave_epi16(&val0, &tmp, src_cross + offset2);
+        deinterleave_epi16(&curr, &val2, src_cross);
+        deinterleave_epi16(&tmp, &val1, src_cross - 2);
+        deinterleave_epi16(&val4, &val5, src_cross + offset1);
+        deinterleave_epi16(&tmp, &val3, src_cross + offset1 - 2);
+        deinterleave_epi16(&val6, &tmp, src_cross + offset3);
+
+        val0 = _mm256_sub_epi16(val0, curr);
+        val1 = _mm256_sub_epi16(val1, curr);
+        val2 = _mm256_sub_epi16(val2, curr);
+        val3 = _mm256_sub_epi16(val3, curr);
+        val4 = _mm256_sub_epi16(val4, curr);
+        val5 = _mm256_sub_epi16(val5, curr);
+        val6 = _mm256_sub_epi16(val6, curr);
+
+        {
+          __m256i val01l = _mm256_madd_epi16(_mm256_unpacklo_epi16(val0, val1), filter01);
+          __m256i val01h = _mm256_madd_epi16(_mm256_unpackhi_epi16(val0, val1), filter01);
+          __m256i val23l = _mm256_madd_epi16(_mm256_unpacklo_epi16(val2, val3), filter23);
+          __m256i val23h = _mm256_madd_epi16(_mm256_unpackhi_epi16(val2, val3), filter23);
+          __m256i val45l = _mm256_madd_epi16(_mm256_unpacklo_epi16(val4, val5), filter45);
+          __m256i val45h = _mm256_madd_epi16(_mm256_unpackhi_epi16(val4, val5), filter45);
+          __m256i val6lo = _mm256_mullo_epi16(val6, filter6);
+          __m256i val6hi = _mm256_mulhi_epi16(val6, filter6);
+          __m256i val6l  = _mm256_unpacklo_epi16(val6lo, val6hi);
+          __m256i val6h  = _mm256_unpackhi_epi16(val6lo, val6hi);
+
+          a0 = _mm256_add_epi32(_mm256_add_epi32(val01l, val23l), _mm256_add_epi32(val45l, val6l));
+          a1 = _mm256_add_epi32(_mm256_add_epi32(val01h, val23h), _mm256_add_epi32(val45h, val6h));
+        }
+
+        a0 = _mm256_srai_epi32(_mm256_add_epi32(a0, scale_offset), scale_bits);
+        a1 = _mm256_srai_epi32(_mm256_add_epi32(a1, scale_offset), scale_bits);
+
+        a0 = _mm256_packs_epi32(a0, a1);
+        a0 = _mm256_add_epi16(a0, offset);
+
+        a0 = _mm256_min_epi16(a0, clip_h);
+        a0 = _mm256_max_epi16(a0, clip_l);
+
+        a0 = _mm256_sub_epi16(a0, offset);
+        a0 = _mm256_add_epi16(a0, self);
+
+        a0 = _mm256_min_epi16(a0, clip_h);
+        a0 = _mm256_max_epi16(a0, clip_l);
+
+        store_n_epi16(src_self, a0, OVMIN(16, blk_dst.width - j));
+      }
+    }
+    chroma_dst += chr_stride * 4;
+    luma_src += luma_stride * 4 << 1;
+  }
+}
+
+/* Sums of vertical, horizontal and diagonal gradients of 2x2 sub sampled
+ * positions over 8 columns of 4 lines, the odd sums of previous columns
+ * are added so each output holds sums over a 4 (or 8) columns window
+ */
+static inline __m128i
+alf_grad_sums_sse(const int16_t *src0, const int16_t *src1, const int16_t *src2, const int16_t *src3,
+                  __m128i *prev)
+{
+  const __m128i x0 = _mm_loadu_si128((const __m128i *)src0);
+  const __m128i x1 = _mm_loadu_si128((const __m128i *)src1);
+  const __m128i x2 = _mm_loadu_si128((const __m128i *)src2);
+  const __m128i x3 = _mm_loadu_si128((const __m128i *)src3);
+
+  const __m128i x4 = _mm_loadu_si128((const __m128i *)(src0 + 2));
+  const __m128i x5 = _mm_loadu_si128((const __m128i *)(src1 + 2));
+  const __m128i x6 = _mm_loadu_si128((const __m128i *)(src2 + 2));
+  const __m128i x7 = _mm_loadu_si128((const __m128i *)(src3 + 2));
+
+  const __m128i nw = _mm_blend_epi16(x0, x1, 0xaa);
+  const __m128i n  = _mm_blend_epi16(x0, x5, 0x55);
+  const __m128i ne = _mm_blend_epi16(x4, x5, 0xaa);
+  const __m128i w  = _mm_blend_epi16(x1, x2, 0xaa);
+  const __m128i e  = _mm_blend_epi16(x5, x6, 0xaa);
+  const __m128i sw = _mm_blend_epi16(x2, x3, 0xaa);
+  const __m128i s  = _mm_blend_epi16(x2, x7, 0x55);
+  const __m128i se = _mm_blend_epi16(x6, x7, 0xaa);
+
+  __m128i c = _mm_blend_epi16(x1, x6, 0x55);
+  __m128i d;
+
+  c = _mm_add_epi16(c, c);
+  d = _mm_shuffle_epi8(c, _mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13));
+
+  {
+    const __m128i ver = _mm_abs_epi16(_mm_sub_epi16(c, _mm_add_epi16(n, s)));
+    const __m128i hor = _mm_abs_epi16(_mm_sub_epi16(d, _mm_add_epi16(w, e)));
+    const __m128i di0 = _mm_abs_epi16(_mm_sub_epi16(d, _mm_add_epi16(nw, se)));
+    const __m128i di1 = _mm_abs_epi16(_mm_sub_epi16(d, _mm_add_epi16(ne, sw)));
+
+    const __m128i hv  = _mm_hadd_epi16(ver, hor);
+    const __m128i di  = _mm_hadd_epi16(di0, di1);
+    const __m128i all = _mm_hadd_epi16(hv, di);
+
+    const __m128i t = _mm_blend_epi16(all, *prev, 0xaa);
+
+    *prev = all;
+
+    return _mm_hadd_epi16(t, all);
+  }
+}
+
+static inline __m256i
+alf_grad_sums_avx2(const int16_t *src0, const int16_t *src1, const int16_t *src2, const int16_t *src3,
+                   __m256i *prev)
+{
+  const __m256i x0 = _mm256_loadu_si256((const __m256i *)src0);
+  const __m256i x1 = _mm256_loadu_si256((const __m256i *)src1);
+  const __m256i x2 = _mm256_loadu_si256((const __m256i *)src2);
+  const __m256i x3 = _mm256_loadu_si256((const __m256i *)src3);
+
+  const __m256i x4 = _mm256_loadu_si256((const __m256i *)(src0 + 2));
+  const __m256i x5 = _mm256_loadu_si256((const __m256i *)(src1 + 2));
+  const __m256i x6 = _mm256_loadu_si256((const __m256i *)(src2 + 2));
+  const __m256i x7 = _mm256_loadu_si256((const __m256i *)(src3 + 2));
+
+  const __m256i nw = _mm256_blend_epi16(x0, x1, 0xaa);
+  const __m256i n  = _mm256_blend_epi16(x0, x5, 0x55);
+  const __m256i ne = _mm256_blend_epi16(x4, x5, 0xaa);
+  const __m256i w  = _mm256_blend_epi16(x1, x2, 0xaa);
+  const __m256i e  = _mm256_blend_epi16(x5, x6, 0xaa);
+  const __m256i sw = _mm256_blend_epi16(x2, x3, 0xaa);
+  const __m256i s  = _mm256_blend_epi16(x2, x7, 0x55);
+  const __m256i se = _mm256_blend_epi16(x6, x7, 0xaa);
+
+  __m256i c = _mm256_blend_epi16(x1, x6, 0x55);
+  __m256i d;
+
+  c = _mm256_add_epi16(c, c);
+  d = _mm256_shuffle_epi8(c, _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                              2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13));
+
+  {
+    const __m256i ver = _mm256_abs_epi16(_mm256_sub_epi16(c, _mm256_add_epi16(n, s)));
+    const __m256i hor = _mm256_abs_epi16(_mm256_sub_epi16(d, _mm256_add_epi16(w, e)));
+    const __m256i di0 = _mm256_abs_epi16(_mm256_sub_epi16(d, _mm256_add_epi16(nw, se)));
+    const __m256i di1 = _mm256_abs_epi16(_mm256_sub_epi16(d, _mm256_add_epi16(ne, sw)));
+
+    const __m256i hv  = _mm256_hadd_epi16(ver, hor);
+    const __m256i di  = _mm256_hadd_epi16(di0, di1);
+    const __m256i all = _mm256_hadd_epi16(hv, di);
+
+    /* Sums of previous 8 columns are in the other 128 bits lane */
+    const __m256i all_prev = _mm256_permute2x128_si256(all, *prev, 0x03);
+    const __m256i t = _mm256_blend_epi16(all, all_prev, 0xaa);
+
+    *prev = all;
+
+    return _mm256_hadd_epi16(t, all);
+  }
+}
+
+/* Classification of two 4x4 blocks on two 4x4 blocks lines in each
+ * 128 bits lane
+ */
+static inline void
+alf_classif_4x4_avx2(__m256i *class_idx, __m256i *transpose_idx, uint16_t col_sums[18][40],
+                     int i, int col, uint32_t z, uint32_t z2, int virbnd_pos, int shift)
+{
+  const __m256i zero = _mm256_setzero_si256();
+  __m256i x0, x1, x2, x3, x4, x5, x6, x7;
+  __m256i x0l, x0h, x1l, x1h, x2l, x2h, x3l, x3h;
+  __m256i x4l, x4h, x5l, x5h, x6l, x6h, x7l, x7h;
+
+  x0 = (z == virbnd_pos) ? zero : _mm256_loadu_si256((__m256i *)&col_sums[i + 0][col]);
+  x1 = _mm256_loadu_si256((__m256i *)&col_sums[i + 1][col]);
+  x2 = _mm256_loadu_si256((__m256i *)&col_sums[i + 2][col]);
+  x3 = (z == virbnd_pos - 4) ? zero : _mm256_loadu_si256((__m256i *)&col_sums[i + 3][col]);
+
+  x4 = (z2 == virbnd_pos) ? zero : _mm256_loadu_si256((__m256i *)&col_sums[i + 2][col]);
+  x5 = _mm256_loadu_si256((__m256i *)&col_sums[i + 3][col]);
+  x6 = _mm256_loadu_si256((__m256i *)&col_sums[i + 4][col]);
+  x7 = (z2 == virbnd_pos - 4) ? zero : _mm256_loadu_si256((__m256i *)&col_sums[i + 5][col]);
+
+  x0l = _mm256_unpacklo_epi16(x0, zero);
+  x0h = _mm256_unpackhi_epi16(x0, zero);
+  x1l = _mm256_unpacklo_epi16(x1, zero);
+  x1h = _mm256_unpackhi_epi16(x1, zero);
+  x2l = _mm256_unpacklo_epi16(x2, zero);
+  x2h = _mm256_unpackhi_epi16(x2, zero);
+  x3l = _mm256_unpacklo_epi16(x3, zero);
+  x3h = _mm256_unpackhi_epi16(x3, zero);
+  x4l = _mm256_unpacklo_epi16(x4, zero);
+  x4h = _mm256_unpackhi_epi16(x4, zero);
+  x5l = _mm256_unpacklo_epi16(x5, zero);
+  x5h = _mm256_unpackhi_epi16(x5, zero);
+  x6l = _mm256_unpacklo_epi16(x6, zero);
+  x6h = _mm256_unpackhi_epi16(x6, zero);
+  x7l = _mm256_unpacklo_epi16(x7, zero);
+  x7h = _mm256_unpackhi_epi16(x7, zero);
+
+  x0l = _mm256_add_epi32(_mm256_add_epi32(x0l, x1l), _mm256_add_epi32(x2l, x3l));
+  x4l = _mm256_add_epi32(_mm256_add_epi32(x4l, x5l), _mm256_add_epi32(x6l, x7l));
+  x0h = _mm256_add_epi32(_mm256_add_epi32(x0h, x1h), _mm256_add_epi32(x2h, x3h));
+  x4h = _mm256_add_epi32(_mm256_add_epi32(x4h, x5h), _mm256_add_epi32(x6h, x7h));
+
+  x2l = _mm256_unpacklo_epi32(x0l, x4l);
+  x2h = _mm256_unpackhi_epi32(x0l, x4l);
+  x6l = _mm256_unpacklo_epi32(x0h, x4h);
+  x6h = _mm256_unpackhi_epi32(x0h, x4h);
+
+  {
+    const __m256i sum_v  = _mm256_unpacklo_epi32(x2l, x6l);
+    const __m256i sum_h  = _mm256_unpackhi_epi32(x2l, x6l);
+    const __m256i sum_d0 = _mm256_unpacklo_epi32(x2h, x6h);
+    const __m256i sum_d1 = _mm256_unpackhi_epi32(x2h, x6h);
+
+    const uint32_t scale  = (z == virbnd_pos - 4 || z == virbnd_pos) ? 96 : 64;
+    const uint32_t scale2 = (z2 == virbnd_pos - 4 || z2 == virbnd_pos) ? 96 : 64;
+    const __m256i scales = _mm256_unpacklo_epi64(_mm256_set1_epi32(scale), _mm256_set1_epi32(scale2));
+
+    __m256i activity = _mm256_mullo_epi32(_mm256_add_epi32(sum_v, sum_h), scales);
+    __m256i cls, dir_hv, hv1, hv0, dir_d, d1, d0, a, b, dir_idx, hvd1, hvd0;
+    __m256i strength1, strength2, offset, tr;
+
+    activity = _mm256_srl_epi32(activity, _mm_cvtsi32_si128(shift));
+    activity = _mm256_min_epi32(activity, _mm256_set1_epi32(15));
+    cls = _mm256_shuffle_epi8(_mm256_setr_epi8(0, 1, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 4,
+                                               0, 1, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 4),
+                              activity);
+
+    dir_hv = _mm256_cmpgt_epi32(sum_v, sum_h);
+    hv1    = _mm256_max_epi32(sum_v, sum_h);
+    hv0    = _mm256_min_epi32(sum_v, sum_h);
+
+    dir_d = _mm256_cmpgt_epi32(sum_d0, sum_d1);
+    d1    = _mm256_max_epi32(sum_d0, sum_d1);
+    d0    = _mm256_min_epi32(sum_d0, sum_d1);
+
+    a       = _mm256_xor_si256(_mm256_mullo_epi32(d1, hv0), _mm256_set1_epi32(0x80000000));
+    b       = _mm256_xor_si256(_mm256_mullo_epi32(hv1, d0), _mm256_set1_epi32(0x80000000));
+    dir_idx = _mm256_cmpgt_epi32(a, b);
+    hvd1    = _mm256_blendv_epi8(hv1, d1, dir_idx);
+    hvd0    = _mm256_blendv_epi8(hv0, d0, dir_idx);
+
+    strength1 = _mm256_cmpgt_epi32(hvd1, _mm256_add_epi32(hvd0, hvd0));
+    strength2 = _mm256_cmpgt_epi32(_mm256_add_epi32(hvd1, hvd1), _mm256_add_epi32(hvd0, _mm256_slli_epi32(hvd0, 3)));
+    offset    = _mm256_and_si256(strength1, _mm256_set1_epi32(5));
+    cls       = _mm256_add_epi32(cls, offset);
+    cls       = _mm256_add_epi32(cls, _mm256_and_si256(strength2, _mm256_set1_epi32(5)));
+    offset    = _mm256_andnot_si256(dir_idx, offset);
+    offset    = _mm256_add_epi32(offset, offset);
+    cls       = _mm256_add_epi32(cls, offset);
+
+    tr = _mm256_set1_epi32(3);
+    tr = _mm256_add_epi32(tr, dir_hv);
+    tr = _mm256_add_epi32(tr, dir_d);
+    tr = _mm256_add_epi32(tr, dir_d);
+
+    *class_idx     = _mm256_shuffle_epi8(cls, _mm256_setr_epi8(0, 4, 8, 12, 0, 4, 8, 12, 0, 4, 8, 12, 0, 4, 8, 12,
+                                                               0, 4, 8, 12, 0, 4, 8, 12, 0, 4, 8, 12, 0, 4, 8, 12));
+    *transpose_idx = _mm256_shuffle_epi8(tr, _mm256_setr_epi8(0, 4, 8, 12, 0, 4, 8, 12, 0, 4, 8, 12, 0, 4, 8, 12,
+                                                              0, 4, 8, 12, 0, 4, 8, 12, 0, 4, 8, 12, 0, 4, 8, 12));
+  }
+}
+
+static void
+alf_classif_blk_avx2(uint8_t *class_idx_arr, uint8_t *transpose_idx_arr,
+                     int16_t *const src, const int stride, const struct Area blk,
+                     const int shift, const int ctu_height, int virbnd_pos)
+{
+  const int fl = 2;
+  const int fl_p1 = fl + 1;
+  const int height = blk.height + 2 * fl;
+  const int width  = blk.width + 2 * fl;
+
+  uint16_t col_sums[18][40];
+  int i, j;
+
+  for (i = 0; i < height; i += 2) {
+    int y_offset = (i - fl_p1) * stride - fl_p1;
+    const int16_t *src0 = &src[y_offset];
+    const int16_t *src1 = &src[y_offset + stride];
+    const int16_t *src2 = &src[y_offset + stride * 2];
+    const int16_t *src3 = &src[y_offset + stride * 3];
+    __m256i prev = _mm256_setzero_si256();
+    __m128i prev_128;
+
+    const int y = blk.y - 2 + i;
+    if (y > 0 && (y & (ctu_height - 1)) == virbnd_pos - 2) {
+      src3 = src2;
+    } else if (y > 0 && (y & (ctu_height - 1)) == virbnd_pos) {
+      src0 = src1;
+    }
+
+    for (j = 0; j + 16 <= width; j += 16) {
+      __m256i sums = alf_grad_sums_avx2(src0 + j, src1 + j, src2 + j, src3 + j, &prev);
+      _mm256_storeu_si256((__m256i *)&col_sums[i >> 1][j], sums);
+    }
+
+    /* Remaining 8 columns are processed on 128 bits */
+    prev_128 = _mm256_extracti128_si256(prev, 1);
+    for (; j < width; j += 8) {
+      __m128i sums = alf_grad_sums_sse(src0 + j, src1 + j, src2 + j, src3 + j, &prev_128);
+      _mm_storeu_si128((__m128i *)&col_sums[i >> 1][j], sums);
+    }
+  }
+
+  for (i = 0; i < (blk.height >> 1); i += 4) {
+    const uint32_t z  = (2 * i + blk.y) & (ctu_height - 1);
+    const uint32_t z2 = (2 * i + 4 + blk.y) & (ctu_height - 1);
+    __m256i class_idx[2], transpose_idx[2];
+    __m128i c1, c2, t1, t2;
+    int y_offset, x_offset;
+
+    alf_classif_4x4_avx2(&class_idx[0], &transpose_idx[0], col_sums, i, 4,  z, z2, virbnd_pos, shift);
+    alf_classif_4x4_avx2(&class_idx[1], &transpose_idx[1], col_sums, i, 20, z, z2, virbnd_pos, shift);
+
+    c1 = _mm_unpacklo_epi16(_mm256_castsi256_si128(class_idx[0]), _mm256_extracti128_si256(class_idx[0], 1));
+    c2 = _mm_unpacklo_epi16(_mm256_castsi256_si128(class_idx[1]), _mm256_extracti128_si256(class_idx[1], 1));
+    c1 = _mm_unpacklo_epi32(c1, c2);
+
+    t1 = _mm_unpacklo_epi16(_mm256_castsi256_si128(transpose_idx[0]), _mm256_extracti128_si256(transpose_idx[0], 1));
+    t2 = _mm_unpacklo_epi16(_mm256_castsi256_si128(transpose_idx[1]), _mm256_extracti128_si256(transpose_idx[1], 1));
+    t1 = _mm_unpacklo_epi32(t1, t2);
+
+    y_offset = (2 * i + blk.y) % ctu_height;
+    x_offset = (blk.x) % ctu_height;
+
+    _mm_storel_epi64((__m128i *)(class_idx_arr + (y_offset >> 2) * CLASSIFICATION_BLK_SIZE + (x_offset >> 2)), c1);
+    _mm_storel_epi64((__m128i *)(class_idx_arr + ((y_offset >> 2) + 1) * CLASSIFICATION_BLK_SIZE + (x_offset >> 2)), _mm_bsrli_si128(c1, 8));
+
+    _mm_storel_epi64((__m128i *)(transpose_idx_arr + (y_offset >> 2) * CLASSIFICATION_BLK_SIZE + (x_offset >> 2)), t1);
+    _mm_storel_epi64((__m128i *)(transpose_idx_arr + ((y_offset >> 2) + 1) * CLASSIFICATION_BLK_SIZE + (x_offset >> 2)), _mm_bsrli_si128(t1, 8));
+  }
+}
+
+void
+rcn_init_alf_functions_avx2(struct RCNFunctions *const rcn_funcs)
+{
+  rcn_funcs->alf.classif   = &alf_classif_blk_avx2;
+  rcn_funcs->alf.luma[0]   = &alf_filter_luma_blk_avx2;
+  rcn_funcs->alf.luma[1]   = &alf_filter_luma_blk_vb_avx2;
+  rcn_funcs->alf.chroma[0] = &alf_filter_chroma_blk_avx2;
+  rcn_funcs->alf.chroma[1] = &alf_filter_chroma_blk_vb_avx2;
+  rcn_funcs->alf.ccalf[0]  = &cc_alf_filter_blk_vb_avx2;
+  rcn_funcs->alf.ccalf[1]  = &cc_alf_filter_blk_vb_avx2;
+}
@@ -81,7 +81,7 @@
 
 
 static void
-simdFilter5x5Blk(int16_t *const dst, const int16_t *const src,
+simdFilter5x5Blk(OVSample *const dst, const int16_t *const src,
                  const int dstStride, const int srcStride,
                  Area blk_dst,
                  const int16_t *const filter_set, const int16_t *const clip_set,
@@ -97,7 +97,7 @@ simdFilter5x5Blk(int16_t *const dst, const int16_t *const src,
     const int clpMax = (1<<10) - 1;
 
     int16_t * _src = (int16_t *) src;
-    int16_t * _dst = dst;
+    OVSample * _dst = dst;
 
     const __m128i mmOffset = _mm_set1_epi32(ROUND);
     const __m128i mmMin = _mm_set1_epi16( clpMin );
@@ -152,7 +152,7 @@ simdFilter5x5Blk(int16_t *const dst, const int16_t *const src,
 }
 
 static void
-simdFilter5x5BlkVB(int16_t *const dst, const int16_t *const src,
+simdFilter5x5BlkVB(OVSample *const dst, const int16_t *const src,
                  const int dstStride, const int srcStride,
                  Area blk_dst,
                  const int16_t *const filter_set, const int16_t *const clip_set,
@@ -168,7 +168,7 @@ simdFilter5x5BlkVB(int16_t *const dst, const int16_t *const src,
     const int clpMax = (1<<10) - 1;
 
     int16_t * _src = (int16_t *) src;
-    int16_t * _dst = dst;
+    OVSample * _dst = dst;
 
     const __m128i mmOffset = _mm_set1_epi32(ROUND);
     const __m128i mmMin = _mm_set1_epi16( clpMin );
@@ -261,7 +261,7 @@ simdFilter5x5BlkVB(int16_t *const dst, const int16_t *const src,
 }
 
 static void
-simdFilter7x7Blk(uint8_t * class_idx_arr, uint8_t * transpose_idx_arr, int16_t *const dst, int16_t *const src, const int dstStride, const int srcStride,
+simdFilter7x7Blk(uint8_t * class_idx_arr, uint8_t * transpose_idx_arr, OVSample *const dst, int16_t *const src, const int dstStride, const int srcStride,
                          Area blk_dst, const int16_t *filter_set, const int16_t *clip_set,
                          const int ctu_height, int virbnd_pos)
 {
@@ -275,7 +275,7 @@ simdFilter7x7Blk(uint8_t * class_idx_arr, uint8_t * transpose_idx_arr, int16_t *
     const int clpMax = (1<<10) - 1;
 
     int16_t * _src = src;
-    int16_t * _dst = dst;
+    OVSample * _dst = dst;
 
     int transpose_idx = 0;
     int class_idx = 0;
@@ -355,7 +355,7 @@ simdFilter7x7Blk(uint8_t * class_idx_arr, uint8_t * transpose_idx_arr, int16_t *
 }
 
 static void
-simdFilter7x7BlkVB(uint8_t * class_idx_arr, uint8_t * transpose_idx_arr, int16_t *const dst, int16_t *const src, const int dstStride, const int srcStride,
+simdFilter7x7BlkVB(uint8_t * class_idx_arr, uint8_t * transpose_idx_arr, OVSample *const dst, int16_t *const src, const int dstStride, const int srcStride,
                          Area blk_dst, const int16_t *filter_set, const int16_t *clip_set,
                          const int ctu_height, int virbnd_pos)
 {
@@ -369,7 +369,7 @@ simdFilter7x7BlkVB(uint8_t * class_idx_arr, uint8_t * transpose_idx_arr, int16_t
     const int clpMax = (1<<10) - 1;
 
     int16_t * _src = src;
-    int16_t * _dst = dst;
+    OVSample * _dst = dst;
 
     int transpose_idx = 0;
     int class_idx = 0;
@@ -529,7 +529,7 @@ simdFilter7x7BlkVB(uint8_t * class_idx_arr, uint8_t * transpose_idx_arr, int16_t
   odd = _mm_unpackhi_epi32(b0, b1);\
 }
 
-void cc_alf_filterBlkVB_sse(int16_t * chroma_dst, int16_t * luma_src, const int chr_stride, const int luma_stride,
+void cc_alf_filterBlkVB_sse(OVSample * chroma_dst, int16_t * luma_src, const int chr_stride, const int luma_stride,
                             const Area blk_dst, const uint8_t c_id, const int16_t *filt_coeff,
                             const int vbCTUHeight, int vbPos)
 {
@@ -563,7 +563,7 @@ void cc_alf_filterBlkVB_sse(int16_t * chroma_dst, int16_t * luma_src, const int
       {
         int row       = ii;
         int col       = j;
-        int16_t *srcSelf  = chroma_dst + col + row * chr_stride;
+        OVSample *srcSelf  = chroma_dst + col + row * chr_stride;
 
         int offset1 = luma_stride;
         int offset2 = -luma_stride;
@@ -0,0 +1,12 @@
+#ifndef RCN_AVX2_H
+#define RCN_AVX2_H
+#include "rcn_structures.h"
+
+void rcn_init_mc_functions_avx2(struct RCNFunctions *const rcn_funcs);
+void rcn_init_angular_functions_avx2(struct RCNFunctions *const rcn_funcs);
+void rcn_init_alf_functions_avx2(struct RCNFunctions *const rcn_funcs);
+void rcn_init_sao_functions_avx2(struct RCNFunctions *const rcn_funcs);
+void rcn_init_tr_functions_avx2(struct RCNFunctions *const rcn_funcs);
+
+
+#endif//RCN_AVX2_H
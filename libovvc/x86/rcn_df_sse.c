@@ -0,0 +1,432 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <emmintrin.h>
+#include <smmintrin.h>
+
+#include "ovutils.h"
+#include "rcn_structures.h"
+
+/* Segments are processed by groups filling the 8 lanes of a register
+ * (2 luma segments of 4 lines or 4 chroma segments of 2 lines).
+ * Each half of a group is only loaded and stored if one of its segments
+ * is filtered so we never access lines outside of the picture.
+ */
+#define HALF_LO 0x1
+#define HALF_HI 0x2
+
+static inline __m128i
+load_half(const uint16_t *src, int halves)
+{
+  if (halves == (HALF_LO | HALF_HI)) {
+    return _mm_loadu_si128((const __m128i *)src);
+  } else if (halves == HALF_LO) {
+    return _mm_loadl_epi64((const __m128i *)src);
+  } else {
+    return _mm_slli_si128(_mm_loadl_epi64((const __m128i *)&src[4]), 8);
+  }
+}
+
+static inline void
+store_half(uint16_t *dst, __m128i x, int halves)
+{
+  if (halves == (HALF_LO | HALF_HI)) {
+    _mm_storeu_si128((__m128i *)dst, x);
+  } else if (halves == HALF_LO) {
+    _mm_storel_epi64((__m128i *)dst, x);
+  } else {
+    _mm_storel_epi64((__m128i *)&dst[4], _mm_srli_si128(x, 8));
+  }
+}
+
+static inline void
+transpose_8x8(__m128i *x)
+{
+  __m128i t0 = _mm_unpacklo_epi16(x[0], x[1]);
+  __m128i t1 = _mm_unpackhi_epi16(x[0], x[1]);
+  __m128i t2 = _mm_unpacklo_epi16(x[2], x[3]);
+  __m128i t3 = _mm_unpackhi_epi16(x[2], x[3]);
+  __m128i t4 = _mm_unpacklo_epi16(x[4], x[5]);
+  __m128i t5 = _mm_unpackhi_epi16(x[4], x[5]);
+  __m128i t6 = _mm_unpacklo_epi16(x[6], x[7]);
+  __m128i t7 = _mm_unpackhi_epi16(x[6], x[7]);
+
+  __m128i u0 = _mm_unpacklo_epi32(t0, t2);
+  __m128i u1 = _mm_unpackhi_epi32(t0, t2);
+  __m128i u2 = _mm_unpacklo_epi32(t1, t3);
+  __m128i u3 = _mm_unpackhi_epi32(t1, t3);
+  __m128i u4 = _mm_unpacklo_epi32(t4, t6);
+  __m128i u5 = _mm_unpackhi_epi32(t4, t6);
+  __m128i u6 = _mm_unpacklo_epi32(t5, t7);
+  __m128i u7 = _mm_unpackhi_epi32(t5, t7);
+
+  x[0] = _mm_unpacklo_epi64(u0, u4);
+  x[1] = _mm_unpackhi_epi64(u0, u4);
+  x[2] = _mm_unpacklo_epi64(u1, u5);
+  x[3] = _mm_unpackhi_epi64(u1, u5);
+  x[4] = _mm_unpacklo_epi64(u2, u6);
+  x[5] = _mm_unpackhi_epi64(u2, u6);
+  x[6] = _mm_unpacklo_epi64(u3, u7);
+  x[7] = _mm_unpackhi_epi64(u3, u7);
+}
+
+/* Load p3 to q3 samples of the 8 lines of a group into x[0] to x[7]
+ * with one line per lane
+ */
+static inline void
+load_lines_ver(__m128i *x, const uint16_t *src, ptrdiff_t stride, int halves)
+{
+  int i;
+  for (i = 0; i < 4; ++i) {
+    x[i]     = halves & HALF_LO ? _mm_loadu_si128((const __m128i *)&src[i * stride - 4])
+                                : _mm_setzero_si128();
+    x[i + 4] = halves & HALF_HI ? _mm_loadu_si128((const __m128i *)&src[(i + 4) * stride - 4])
+                                : _mm_setzero_si128();
+  }
+  transpose_8x8(x);
+}
+
+static inline void
+store_lines_ver(uint16_t *dst, ptrdiff_t stride, __m128i *x, int halves)
+{
+  int i;
+  transpose_8x8(x);
+  for (i = 0; i < 4; ++i) {
+    if (halves & HALF_LO) {
+      _mm_storeu_si128((__m128i *)&dst[i * stride - 4], x[i]);
+    }
+    if (halves & HALF_HI) {
+      _mm_storeu_si128((__m128i *)&dst[(i + 4) * stride - 4], x[i + 4]);
+    }
+  }
+}
+
+static inline void
+load_lines_hor(__m128i *x, const uint16_t *src, ptrdiff_t stride, int halves)
+{
+  int i;
+  for (i = 0; i < 8; ++i) {
+    x[i] = load_half(&src[(i - 4) * stride], halves);
+  }
+}
+
+/* Lines from p3 up to first are left untouched, q3 is never modified */
+static inline void
+store_lines_hor(uint16_t *dst, ptrdiff_t stride, __m128i *x, int halves, int first)
+{
+  int i;
+  for (i = first; i < 7; ++i) {
+    store_half(&dst[(i - 4) * stride], x[i], halves);
+  }
+}
+
+/* Lane masks and tc from the segments of a group
+ */
+static inline __m128i
+luma_mask(uint64_t map, int seg_idx)
+{
+  return _mm_set_epi64x(-(int64_t)((map >> (seg_idx + 1)) & 0x1),
+                        -(int64_t)((map >> seg_idx) & 0x1));
+}
+
+static inline __m128i
+luma_tc(const int16_t *tc)
+{
+  return _mm_set_epi16(tc[1], tc[1], tc[1], tc[1], tc[0], tc[0], tc[0], tc[0]);
+}
+
+static inline __m128i
+chroma_mask(uint64_t map, int seg_idx)
+{
+  return _mm_set_epi32(-(int32_t)((map >> (seg_idx + 3)) & 0x1),
+                       -(int32_t)((map >> (seg_idx + 2)) & 0x1),
+                       -(int32_t)((map >> (seg_idx + 1)) & 0x1),
+                       -(int32_t)((map >> seg_idx) & 0x1));
+}
+
+static inline __m128i
+chroma_tc(const int16_t *tc)
+{
+  return _mm_set_epi16(tc[3], tc[3], tc[2], tc[2], tc[1], tc[1], tc[0], tc[0]);
+}
+
+static inline __m128i
+clip_tc(__m128i x, __m128i ref, __m128i tc)
+{
+  x = _mm_max_epi16(x, _mm_sub_epi16(ref, tc));
+  return _mm_min_epi16(x, _mm_add_epi16(ref, tc));
+}
+
+static inline __m128i
+clip_pixel(__m128i x)
+{
+  x = _mm_max_epi16(x, _mm_setzero_si128());
+  return _mm_min_epi16(x, _mm_set1_epi16(0x03FF));
+}
+
+/* x[0] to x[7] contain p3, p2, p1, p0, q0, q1, q2, q3 */
+static inline void
+filter_luma_strong_small_sse(__m128i *x, __m128i tc, __m128i msk)
+{
+  const __m128i p3 = x[0], p2 = x[1], p1 = x[2], p0 = x[3];
+  const __m128i q0 = x[4], q1 = x[5], q2 = x[6], q3 = x[7];
+  const __m128i tc2 = _mm_add_epi16(tc, tc);
+  const __m128i tc3 = _mm_add_epi16(tc2, tc);
+  const __m128i rnd2 = _mm_set1_epi16(2);
+  const __m128i rnd4 = _mm_set1_epi16(4);
+
+  const __m128i sum_p = _mm_add_epi16(_mm_add_epi16(p2, p1), _mm_add_epi16(p0, q0));
+  const __m128i sum_m = _mm_add_epi16(_mm_add_epi16(p1, p0), _mm_add_epi16(q0, q1));
+  const __m128i sum_q = _mm_add_epi16(_mm_add_epi16(p0, q0), _mm_add_epi16(q1, q2));
+  __m128i r;
+
+  r = _mm_add_epi16(_mm_slli_epi16(_mm_add_epi16(p3, p2), 1), sum_p);
+  r = _mm_srli_epi16(_mm_add_epi16(r, rnd4), 3);
+  x[1] = _mm_blendv_epi8(p2, clip_tc(r, p2, tc), msk);
+
+  r = _mm_srli_epi16(_mm_add_epi16(sum_p, rnd2), 2);
+  x[2] = _mm_blendv_epi8(p1, clip_tc(r, p1, tc2), msk);
+
+  r = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(sum_p, sum_m), rnd4), 3);
+  x[3] = _mm_blendv_epi8(p0, clip_tc(r, p0, tc3), msk);
+
+  r = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(sum_m, sum_q), rnd4), 3);
+  x[4] = _mm_blendv_epi8(q0, clip_tc(r, q0, tc3), msk);
+
+  r = _mm_srli_epi16(_mm_add_epi16(sum_q, rnd2), 2);
+  x[5] = _mm_blendv_epi8(q1, clip_tc(r, q1, tc2), msk);
+
+  r = _mm_add_epi16(_mm_slli_epi16(_mm_add_epi16(q2, q3), 1), sum_q);
+  r = _mm_srli_epi16(_mm_add_epi16(r, rnd4), 3);
+  x[6] = _mm_blendv_epi8(q2, clip_tc(r, q2, tc), msk);
+}
+
+static inline void
+filter_luma_weak_sse(__m128i *x, __m128i tc, __m128i msk,
+                     __m128i ext_p, __m128i ext_q)
+{
+  const __m128i p2 = x[1], p1 = x[2], p0 = x[3];
+  const __m128i q0 = x[4], q1 = x[5], q2 = x[6];
+  const __m128i th_cut = _mm_mullo_epi16(tc, _mm_set1_epi16(10));
+  const __m128i tc2 = _mm_srai_epi16(tc, 1);
+  const __m128i m_tc = _mm_sub_epi16(_mm_setzero_si128(), tc);
+  const __m128i m_tc2 = _mm_sub_epi16(_mm_setzero_si128(), tc2);
+  __m128i delta, delta1, delta2;
+
+  delta = _mm_mullo_epi16(_mm_sub_epi16(q0, p0), _mm_set1_epi16(9));
+  delta = _mm_sub_epi16(delta, _mm_mullo_epi16(_mm_sub_epi16(q1, p1), _mm_set1_epi16(3)));
+  delta = _mm_srai_epi16(_mm_add_epi16(delta, _mm_set1_epi16(8)), 4);
+
+  msk = _mm_and_si128(msk, _mm_cmpgt_epi16(th_cut, _mm_abs_epi16(delta)));
+
+  delta = _mm_min_epi16(_mm_max_epi16(delta, m_tc), tc);
+
+  delta1 = _mm_add_epi16(_mm_sub_epi16(_mm_avg_epu16(p2, p0), p1), delta);
+  delta1 = _mm_srai_epi16(delta1, 1);
+  delta1 = _mm_min_epi16(_mm_max_epi16(delta1, m_tc2), tc2);
+
+  delta2 = _mm_sub_epi16(_mm_sub_epi16(_mm_avg_epu16(q2, q0), q1), delta);
+  delta2 = _mm_srai_epi16(delta2, 1);
+  delta2 = _mm_min_epi16(_mm_max_epi16(delta2, m_tc2), tc2);
+
+  x[3] = _mm_blendv_epi8(p0, clip_pixel(_mm_add_epi16(p0, delta)), msk);
+  x[4] = _mm_blendv_epi8(q0, clip_pixel(_mm_sub_epi16(q0, delta)), msk);
+  x[2] = _mm_blendv_epi8(p1, clip_pixel(_mm_add_epi16(p1, delta1)), _mm_and_si128(msk, ext_p));
+  x[5] = _mm_blendv_epi8(q1, clip_pixel(_mm_add_epi16(q1, delta2)), _mm_and_si128(msk, ext_q));
+}
+
+static inline void
+filter_chroma_strong_sse(__m128i *x, __m128i tc, __m128i msk, uint8_t is_ctb_b)
+{
+  const __m128i p3 = x[0], p2 = x[1], p1 = x[2], p0 = x[3];
+  const __m128i q0 = x[4], q1 = x[5], q2 = x[6], q3 = x[7];
+  const __m128i rnd4 = _mm_set1_epi16(4);
+  const __m128i sum_c = _mm_add_epi16(_mm_add_epi16(p0, q0), _mm_add_epi16(q1, q2));
+  __m128i r;
+
+  if (is_ctb_b) {
+    /* p1 and p2 are left untouched on CTU upper boundary */
+    r = _mm_add_epi16(_mm_add_epi16(_mm_add_epi16(p1, p1), p1), _mm_add_epi16(p0, sum_c));
+    r = _mm_srli_epi16(_mm_add_epi16(r, rnd4), 3);
+    x[3] = _mm_blendv_epi8(p0, clip_tc(r, p0, tc), msk);
+
+    r = _mm_add_epi16(_mm_slli_epi16(p1, 1), _mm_add_epi16(q0, q3));
+    r = _mm_add_epi16(r, sum_c);
+    r = _mm_srli_epi16(_mm_add_epi16(r, rnd4), 3);
+    x[4] = _mm_blendv_epi8(q0, clip_tc(r, q0, tc), msk);
+  } else {
+    const __m128i sum_p = _mm_add_epi16(_mm_add_epi16(p3, p2), _mm_add_epi16(p1, p0));
+
+    r = _mm_add_epi16(_mm_add_epi16(_mm_slli_epi16(p3, 1), p2), q0);
+    r = _mm_add_epi16(r, sum_p);
+    r = _mm_srli_epi16(_mm_add_epi16(r, rnd4), 3);
+    x[1] = _mm_blendv_epi8(p2, clip_tc(r, p2, tc), msk);
+
+    r = _mm_add_epi16(_mm_add_epi16(p3, p1), _mm_add_epi16(q0, q1));
+    r = _mm_add_epi16(r, sum_p);
+    r = _mm_srli_epi16(_mm_add_epi16(r, rnd4), 3);
+    x[2] = _mm_blendv_epi8(p1, clip_tc(r, p1, tc), msk);
+
+    r = _mm_add_epi16(_mm_add_epi16(sum_p, p0), _mm_add_epi16(q0, _mm_add_epi16(q1, q2)));
+    r = _mm_srli_epi16(_mm_add_epi16(r, rnd4), 3);
+    x[3] = _mm_blendv_epi8(p0, clip_tc(r, p0, tc), msk);
+
+    r = _mm_add_epi16(_mm_add_epi16(p2, p1), _mm_add_epi16(q0, q3));
+    r = _mm_add_epi16(r, sum_c);
+    r = _mm_srli_epi16(_mm_add_epi16(r, rnd4), 3);
+    x[4] = _mm_blendv_epi8(q0, clip_tc(r, q0, tc), msk);
+  }
+
+  r = _mm_add_epi16(_mm_add_epi16(p1, q1), _mm_slli_epi16(q3, 1));
+  r = _mm_add_epi16(r, sum_c);
+  r = _mm_srli_epi16(_mm_add_epi16(r, rnd4), 3);
+  x[5] = _mm_blendv_epi8(q1, clip_tc(r, q1, tc), msk);
+
+  r = _mm_add_epi16(_mm_add_epi16(q2, q3), _mm_add_epi16(q3, _mm_add_epi16(q3, q2)));
+  r = _mm_add_epi16(r, _mm_add_epi16(p0, _mm_add_epi16(q0, q1)));
+  r = _mm_srli_epi16(_mm_add_epi16(r, rnd4), 3);
+  x[6] = _mm_blendv_epi8(q2, clip_tc(r, q2, tc), msk);
+}
+
+static inline void
+filter_chroma_weak_sse(__m128i *x, __m128i tc, __m128i msk)
+{
+  const __m128i p1 = x[2], p0 = x[3];
+  const __m128i q0 = x[4], q1 = x[5];
+  const __m128i m_tc = _mm_sub_epi16(_mm_setzero_si128(), tc);
+  __m128i delta;
+
+  delta = _mm_slli_epi16(_mm_sub_epi16(q0, p0), 2);
+  delta = _mm_add_epi16(delta, _mm_sub_epi16(p1, q1));
+  delta = _mm_srai_epi16(_mm_add_epi16(delta, _mm_set1_epi16(4)), 3);
+  delta = _mm_min_epi16(_mm_max_epi16(delta, m_tc), tc);
+
+  x[3] = _mm_blendv_epi8(p0, clip_pixel(_mm_add_epi16(p0, delta)), msk);
+  x[4] = _mm_blendv_epi8(q0, clip_pixel(_mm_sub_epi16(q0, delta)), msk);
+}
+
+static inline void
+filter_luma_group(__m128i *x, const struct DBFSegments *segs, int seg_idx)
+{
+  const __m128i tc = luma_tc(&segs->tc[seg_idx]);
+
+  if ((segs->strong_map >> seg_idx) & 0x3) {
+    filter_luma_strong_small_sse(x, tc, luma_mask(segs->strong_map, seg_idx));
+  }
+
+  if ((segs->weak_map >> seg_idx) & 0x3) {
+    filter_luma_weak_sse(x, tc, luma_mask(segs->weak_map, seg_idx),
+                         luma_mask(segs->ext_p_map, seg_idx),
+                         luma_mask(segs->ext_q_map, seg_idx));
+  }
+}
+
+static inline void
+filter_chroma_group(__m128i *x, const struct DBFSegments *segs, int seg_idx,
+                    uint8_t is_ctb_b)
+{
+  const __m128i tc = chroma_tc(&segs->tc[seg_idx]);
+
+  if ((segs->strong_map >> seg_idx) & 0xF) {
+    filter_chroma_strong_sse(x, tc, chroma_mask(segs->strong_map, seg_idx), is_ctb_b);
+  }
+
+  if ((segs->weak_map >> seg_idx) & 0xF) {
+    filter_chroma_weak_sse(x, tc, chroma_mask(segs->weak_map, seg_idx));
+  }
+}
+
+static void
+dbf_filter_luma_ver_sse(uint16_t *src, ptrdiff_t stride,
+                        const struct DBFSegments *segs)
+{
+  uint64_t seg_map = segs->strong_map | segs->weak_map;
+
+  while (seg_map) {
+    int seg_idx = ov_ctz64(seg_map) & ~0x1;
+    int halves = (seg_map >> seg_idx) & 0x3;
+    uint16_t *grp = src + seg_idx * (stride << 2);
+    __m128i x[8];
+
+    load_lines_ver(x, grp, stride, halves);
+    filter_luma_group(x, segs, seg_idx);
+    store_lines_ver(grp, stride, x, halves);
+
+    seg_map &= ~((uint64_t)0x3 << seg_idx);
+  }
+}
+
+static void
+dbf_filter_luma_hor_sse(uint16_t *src, ptrdiff_t stride,
+                        const struct DBFSegments *segs)
+{
+  uint64_t seg_map = segs->strong_map | segs->weak_map;
+
+  while (seg_map) {
+    int seg_idx = ov_ctz64(seg_map) & ~0x1;
+    int halves = (seg_map >> seg_idx) & 0x3;
+    uint16_t *grp = src + (seg_idx << 2);
+    __m128i x[8];
+
+    load_lines_hor(x, grp, stride, halves);
+    filter_luma_group(x, segs, seg_idx);
+    store_lines_hor(grp, stride, x, halves, 1);
+
+    seg_map &= ~((uint64_t)0x3 << seg_idx);
+  }
+}
+
+static inline int
+chroma_halves(uint64_t seg_map, int seg_idx)
+{
+  return (((seg_map >> seg_idx) & 0x3) ? HALF_LO : 0) |
+         (((seg_map >> seg_idx) & 0xC) ? HALF_HI : 0);
+}
+
+static void
+dbf_filter_chroma_ver_sse(uint16_t *src, ptrdiff_t stride,
+                          const struct DBFSegments *segs, uint8_t is_ctb_b)
+{
+  uint64_t seg_map = segs->strong_map | segs->weak_map;
+
+  while (seg_map) {
+    int seg_idx = ov_ctz64(seg_map) & ~0x3;
+    int halves = chroma_halves(seg_map, seg_idx);
+    uint16_t *grp = src + seg_idx * (stride << 1);
+    __m128i x[8];
+
+    load_lines_ver(x, grp, stride, halves);
+    filter_chroma_group(x, segs, seg_idx, 0);
+    store_lines_ver(grp, stride, x, halves);
+
+    seg_map &= ~((uint64_t)0xF << seg_idx);
+  }
+}
+
+static void
+dbf_filter_chroma_hor_sse(uint16_t *src, ptrdiff_t stride,
+                          const struct DBFSegments *segs, uint8_t is_ctb_b)
+{
+  uint64_t seg_map = segs->strong_map | segs->weak_map;
+
+  while (seg_map) {
+    int seg_idx = ov_ctz64(seg_map) & ~0x3;
+    int halves = chroma_halves(seg_map, seg_idx);
+    uint16_t *grp = src + (seg_idx << 1);
+    __m128i x[8];
+
+    load_lines_hor(x, grp, stride, halves);
+    filter_chroma_group(x, segs, seg_idx, is_ctb_b);
+    store_lines_hor(grp, stride, x, halves, is_ctb_b ? 3 : 1);
+
+    seg_map &= ~((uint64_t)0xF << seg_idx);
+  }
+}
+
+void
+rcn_init_dbf_functions_sse(struct RCNFunctions *const rcn_funcs)
+{
+  rcn_funcs->dbf.luma_ver   = &dbf_filter_luma_ver_sse;
+  rcn_funcs->dbf.luma_hor   = &dbf_filter_luma_hor_sse;
+  rcn_funcs->dbf.chroma_ver = &dbf_filter_chroma_ver_sse;
+  rcn_funcs->dbf.chroma_hor = &dbf_filter_chroma_hor_sse;
+}
@@ -0,0 +1,479 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <smmintrin.h>
+
+#include "ovutils.h"
+#include "rcn_structures.h"
+
+#define DMVR_STRIDE (128 + 4)
+
+#define GRAD_SHIFT 6
+
+#define BDOF_WGT_LIMIT ((1 << 4) - 1)
+#define BDOF_SHIFT   (14 + 1 - BITDEPTH)
+#define BDOF_OFFSET  ((1 << (BDOF_SHIFT - 1)))
+
+#define PROF_DELTA_LIMIT (1 << (BITDEPTH + 3))
+
+/* Intermediate samples are stored with a (1 << 13) offset which is a
+ * multiple of both (1 << GRAD_SHIFT) and (1 << 4) so it cancels out
+ * when subtracting shifted samples.
+ */
+
+static inline uint32_t
+hsum_epi32(__m128i x)
+{
+  x = _mm_add_epi32(x, _mm_shuffle_epi32(x, 0x4E));
+  x = _mm_add_epi32(x, _mm_shuffle_epi32(x, 0xB1));
+
+  return (uint32_t)_mm_cvtsi128_si32(x);
+}
+
+static inline __m128i
+sad_8(const int16_t *ref0, const int16_t *ref1)
+{
+  const __m128i zero = _mm_setzero_si128();
+  __m128i a = _mm_loadu_si128((const __m128i *)ref0);
+  __m128i b = _mm_loadu_si128((const __m128i *)ref1);
+
+  /* Absolute difference of two int16_t fits in an uint16_t */
+  __m128i d = _mm_sub_epi16(_mm_max_epi16(a, b), _mm_min_epi16(a, b));
+
+  return _mm_add_epi32(_mm_unpacklo_epi16(d, zero), _mm_unpackhi_epi16(d, zero));
+}
+
+static uint64_t
+dmvr_sad_sse(const int16_t *ref0, const int16_t *ref1,
+             int16_t dmvr_stride, int16_t pb_w, int16_t pb_h)
+{
+  __m128i acc = _mm_setzero_si128();
+  int i;
+
+  if (pb_w == 16) {
+    for (i = 0; i < (pb_h >> 1); ++i) {
+      acc = _mm_add_epi32(acc, sad_8(ref0,     ref1));
+      acc = _mm_add_epi32(acc, sad_8(ref0 + 8, ref1 + 8));
+
+      ref0 += dmvr_stride << 1;
+      ref1 += dmvr_stride << 1;
+    }
+  } else {
+    for (i = 0; i < (pb_h >> 1); ++i) {
+      acc = _mm_add_epi32(acc, sad_8(ref0, ref1));
+
+      ref0 += dmvr_stride << 1;
+      ref1 += dmvr_stride << 1;
+    }
+  }
+
+  return hsum_epi32(acc);
+}
+
+static uint8_t
+dmvr_sads_sse(const int16_t *ref0, const int16_t *ref1,
+              uint64_t *sad_array, int sb_w, int sb_h)
+{
+  uint64_t min_cost = (uint64_t) -1;
+  uint8_t dmvr_idx = 12;
+  uint8_t idx = 0;
+  int dx, dy;
+
+  /* Same raster order of offsets as the C version */
+  for (dy = -2; dy <= 2; ++dy) {
+    for (dx = -2; dx <= 2; ++dx) {
+      const int offset = dx + dy * DMVR_STRIDE;
+      uint64_t cost = dmvr_sad_sse(ref0 + offset, ref1 - offset,
+                                   DMVR_STRIDE, sb_w, sb_h);
+      if (idx == 12) {
+        cost -= cost >> 2;
+      }
+
+      sad_array[idx] = cost;
+
+      if (cost < min_cost || (idx == 12 && cost <= min_cost)) {
+        min_cost = cost;
+        dmvr_idx = idx;
+      }
+      idx++;
+    }
+  }
+
+  return dmvr_idx;
+}
+
+/* Block width must be a multiple of 8 */
+static void
+bdof_grad_sse(const uint16_t *src, int src_stride, int sb_w, int sb_h,
+              int grad_stride, int16_t *grad_x, int16_t *grad_y)
+{
+  int x, y;
+
+  src += src_stride + 1;
+
+  for (y = 0; y < sb_h; ++y) {
+    for (x = 0; x < sb_w; x += 8) {
+      __m128i abv = _mm_loadu_si128((const __m128i *)&src[x - src_stride]);
+      __m128i blw = _mm_loadu_si128((const __m128i *)&src[x + src_stride]);
+      __m128i lft = _mm_loadu_si128((const __m128i *)&src[x - 1]);
+      __m128i rgt = _mm_loadu_si128((const __m128i *)&src[x + 1]);
+
+      abv = _mm_srai_epi16(abv, GRAD_SHIFT);
+      blw = _mm_srai_epi16(blw, GRAD_SHIFT);
+      lft = _mm_srai_epi16(lft, GRAD_SHIFT);
+      rgt = _mm_srai_epi16(rgt, GRAD_SHIFT);
+
+      _mm_storeu_si128((__m128i *)&grad_x[x], _mm_sub_epi16(rgt, lft));
+      _mm_storeu_si128((__m128i *)&grad_y[x], _mm_sub_epi16(blw, abv));
+    }
+    grad_x += grad_stride;
+    grad_y += grad_stride;
+    src += src_stride;
+  }
+}
+
+static inline __m128i
+load_2x4(const void *src, ptrdiff_t stride)
+{
+  const int16_t *src16 = (const int16_t *)src;
+  __m128i l0 = _mm_loadl_epi64((const __m128i *)src16);
+  __m128i l1 = _mm_loadl_epi64((const __m128i *)(src16 + stride));
+
+  return _mm_unpacklo_epi64(l0, l1);
+}
+
+static inline void
+store_2x4(void *dst, ptrdiff_t stride, __m128i x)
+{
+  int16_t *dst16 = (int16_t *)dst;
+
+  _mm_storel_epi64((__m128i *)dst16, x);
+  _mm_storel_epi64((__m128i *)(dst16 + stride), _mm_srli_si128(x, 8));
+}
+
+/* 4x4 PROF subblock, two lines per register */
+static void
+prof_grad_sse(const uint16_t *src, int src_stride, int sb_w, int sb_h,
+              int grad_stride, int16_t *grad_x, int16_t *grad_y)
+{
+  int y;
+
+  src += src_stride + 1;
+
+  for (y = 0; y < 4; y += 2) {
+    __m128i abv = load_2x4(src - src_stride, src_stride);
+    __m128i blw = load_2x4(src + src_stride, src_stride);
+    __m128i lft = load_2x4(src - 1, src_stride);
+    __m128i rgt = load_2x4(src + 1, src_stride);
+
+    abv = _mm_srai_epi16(abv, GRAD_SHIFT);
+    blw = _mm_srai_epi16(blw, GRAD_SHIFT);
+    lft = _mm_srai_epi16(lft, GRAD_SHIFT);
+    rgt = _mm_srai_epi16(rgt, GRAD_SHIFT);
+
+    store_2x4(grad_x, grad_stride, _mm_sub_epi16(rgt, lft));
+    store_2x4(grad_y, grad_stride, _mm_sub_epi16(blw, abv));
+
+    grad_x += grad_stride << 1;
+    grad_y += grad_stride << 1;
+    src += src_stride << 1;
+  }
+}
+
+static void
+prof_sse(uint16_t *dst, int dst_stride, const uint16_t *src, int src_stride,
+         const int16_t *grad_x, const int16_t *grad_y, int grad_stride,
+         const int32_t *dmv_scale_h, const int32_t *dmv_scale_v,
+         uint8_t bidir)
+{
+  const __m128i lim_min = _mm_set1_epi32(-PROF_DELTA_LIMIT);
+  const __m128i lim_max = _mm_set1_epi32(PROF_DELTA_LIMIT - 1);
+  const __m128i smp_max = _mm_set1_epi16(OV_SAMPLE_MAX);
+  const __m128i zero = _mm_setzero_si128();
+  int y;
+
+  for (y = 0; y < 4; y += 2) {
+    /* Scales are clipped to 5 bits and fit in 16 bits */
+    __m128i dmv_h = _mm_packs_epi32(_mm_loadu_si128((const __m128i *)&dmv_scale_h[0]),
+                                    _mm_loadu_si128((const __m128i *)&dmv_scale_h[4]));
+    __m128i dmv_v = _mm_packs_epi32(_mm_loadu_si128((const __m128i *)&dmv_scale_v[0]),
+                                    _mm_loadu_si128((const __m128i *)&dmv_scale_v[4]));
+    __m128i gx = load_2x4(grad_x, grad_stride);
+    __m128i gy = load_2x4(grad_y, grad_stride);
+    __m128i smp = load_2x4(src, src_stride);
+
+    __m128i add_lo = _mm_madd_epi16(_mm_unpacklo_epi16(dmv_h, dmv_v),
+                                    _mm_unpacklo_epi16(gx, gy));
+    __m128i add_hi = _mm_madd_epi16(_mm_unpackhi_epi16(dmv_h, dmv_v),
+                                    _mm_unpackhi_epi16(gx, gy));
+    __m128i add;
+
+    add_lo = _mm_min_epi32(_mm_max_epi32(add_lo, lim_min), lim_max);
+    add_hi = _mm_min_epi32(_mm_max_epi32(add_hi, lim_min), lim_max);
+
+    add = _mm_packs_epi32(add_lo, add_hi);
+
+    if (!bidir) {
+      /* ((val + 8200) >> 4) with val = smp - (1 << 13) + add on 16 bits.
+       * Saturation only occurs on values clipped to OV_SAMPLE_MAX anyway.
+       */
+      __m128i val = _mm_add_epi16(_mm_sub_epi16(smp, _mm_set1_epi16(1 << 13)), add);
+
+      val = _mm_adds_epi16(val, _mm_set1_epi16(8));
+      val = _mm_srai_epi16(val, 14 - BITDEPTH);
+      val = _mm_add_epi16(val, _mm_set1_epi16((1 << 13) >> (14 - BITDEPTH)));
+      val = _mm_min_epi16(_mm_max_epi16(val, zero), smp_max);
+
+      store_2x4(dst, dst_stride, val);
+    } else {
+      store_2x4(dst, dst_stride, _mm_add_epi16(smp, add));
+    }
+
+    dmv_scale_h += 8;
+    dmv_scale_v += 8;
+
+    grad_x += grad_stride << 1;
+    grad_y += grad_stride << 1;
+
+    dst += dst_stride << 1;
+    src += src_stride << 1;
+  }
+}
+
+/* Sums of the four first lanes of a, b, c and d */
+static inline __m128i
+hsum4_epi32(__m128i a, __m128i b, __m128i c, __m128i d)
+{
+  return _mm_hadd_epi32(_mm_hadd_epi32(a, b), _mm_hadd_epi32(c, d));
+}
+
+static inline void
+bdof_weights(int32_t sum_avg_x, int32_t sum_avg_y, int32_t sum_avg_x_y_signs,
+             int32_t sum_delta_x, int32_t sum_delta_y,
+             int16_t *weight_x, int16_t *weight_y)
+{
+  int wgt_x = 0;
+  int wgt_y = 0;
+
+  if (sum_avg_x) {
+    int log2_renorm_x = floor_log2(sum_avg_x);
+
+    wgt_x = (sum_delta_x << 2) >> log2_renorm_x;
+    wgt_x = ov_clip(wgt_x, -BDOF_WGT_LIMIT, BDOF_WGT_LIMIT);
+  }
+
+  if (sum_avg_y) {
+    int log2_renorm_y = floor_log2(sum_avg_y);
+    int x_offset = 0;
+
+    if (wgt_x) {
+      int high = sum_avg_x_y_signs >> 12;
+      int low  = sum_avg_x_y_signs & ((1 << 12) - 1);
+      x_offset = (((wgt_x * high) << 12) + (wgt_x * low)) >> 1;
+    }
+
+    wgt_y = ((sum_delta_y << 2) - x_offset) >> log2_renorm_y;
+    wgt_y = ov_clip(wgt_y, -BDOF_WGT_LIMIT, BDOF_WGT_LIMIT);
+  }
+
+  *weight_x = wgt_x;
+  *weight_y = wgt_y;
+}
+
+/* Accumulate the terms of the weights derivation of a line of 8 samples */
+static inline void
+bdof_sums_line(const int16_t *ref0, const int16_t *ref1,
+               const int16_t *grad_x0, const int16_t *grad_x1,
+               const int16_t *grad_y0, const int16_t *grad_y1,
+               __m128i *sum_avg_x, __m128i *sum_avg_y, __m128i *sum_signs,
+               __m128i *sum_delta_x, __m128i *sum_delta_y)
+{
+  __m128i gx0 = _mm_loadu_si128((const __m128i *)grad_x0);
+  __m128i gx1 = _mm_loadu_si128((const __m128i *)grad_x1);
+  __m128i gy0 = _mm_loadu_si128((const __m128i *)grad_y0);
+  __m128i gy1 = _mm_loadu_si128((const __m128i *)grad_y1);
+  __m128i r0  = _mm_loadu_si128((const __m128i *)ref0);
+  __m128i r1  = _mm_loadu_si128((const __m128i *)ref1);
+
+  __m128i avg_x = _mm_srai_epi16(_mm_add_epi16(gx0, gx1), 1);
+  __m128i avg_y = _mm_srai_epi16(_mm_add_epi16(gy0, gy1), 1);
+  __m128i delta = _mm_sub_epi16(_mm_srai_epi16(r1, 4), _mm_srai_epi16(r0, 4));
+
+  *sum_avg_x   = _mm_add_epi16(*sum_avg_x, _mm_abs_epi16(avg_x));
+  *sum_avg_y   = _mm_add_epi16(*sum_avg_y, _mm_abs_epi16(avg_y));
+  *sum_signs   = _mm_add_epi16(*sum_signs, _mm_sign_epi16(avg_x, avg_y));
+  *sum_delta_x = _mm_add_epi16(*sum_delta_x, _mm_sign_epi16(delta, avg_x));
+  *sum_delta_y = _mm_add_epi16(*sum_delta_y, _mm_sign_epi16(delta, avg_y));
+}
+
+/* Derive weights of two horizontally adjacent 4x4 subblocks from their
+ * 6x6 windows. Windows of left and right subblocks are read from lines
+ * starting respectively at first and third sample of the 10 samples wide
+ * area so we never read outside of the padded buffers.
+ */
+static inline void
+derive_bdof_weights_x2(const int16_t *ref0, const int16_t *ref1,
+                       const int16_t *grad_x0, const int16_t *grad_x1,
+                       const int16_t *grad_y0, const int16_t *grad_y1,
+                       int ref_stride, int grad_stride,
+                       int16_t *wgt_x, int16_t *wgt_y)
+{
+  const __m128i msk_l = _mm_setr_epi16(1, 1, 1, 1, 1, 1, 0, 0);
+  const __m128i msk_r = _mm_setr_epi16(0, 0, 1, 1, 1, 1, 1, 1);
+  __m128i avg_x_l = _mm_setzero_si128();
+  __m128i avg_y_l = _mm_setzero_si128();
+  __m128i signs_l = _mm_setzero_si128();
+  __m128i dlt_x_l = _mm_setzero_si128();
+  __m128i dlt_y_l = _mm_setzero_si128();
+  __m128i avg_x_r = _mm_setzero_si128();
+  __m128i avg_y_r = _mm_setzero_si128();
+  __m128i signs_r = _mm_setzero_si128();
+  __m128i dlt_x_r = _mm_setzero_si128();
+  __m128i dlt_y_r = _mm_setzero_si128();
+  __m128i sums_l, sums_r, sums_y;
+  int i;
+
+  /* 16 bits accumulators cannot overflow on 6 lines */
+  for (i = 0; i < 6; ++i) {
+    bdof_sums_line(ref0, ref1, grad_x0, grad_x1, grad_y0, grad_y1,
+                   &avg_x_l, &avg_y_l, &signs_l, &dlt_x_l, &dlt_y_l);
+
+    bdof_sums_line(ref0 + 2, ref1 + 2, grad_x0 + 2, grad_x1 + 2, grad_y0 + 2, grad_y1 + 2,
+                   &avg_x_r, &avg_y_r, &signs_r, &dlt_x_r, &dlt_y_r);
+
+    ref0 += ref_stride;
+    ref1 += ref_stride;
+
+    grad_x0 += grad_stride;
+    grad_x1 += grad_stride;
+    grad_y0 += grad_stride;
+    grad_y1 += grad_stride;
+  }
+
+  sums_l = hsum4_epi32(_mm_madd_epi16(avg_x_l, msk_l), _mm_madd_epi16(avg_y_l, msk_l),
+                       _mm_madd_epi16(signs_l, msk_l), _mm_madd_epi16(dlt_x_l, msk_l));
+
+  sums_r = hsum4_epi32(_mm_madd_epi16(avg_x_r, msk_r), _mm_madd_epi16(avg_y_r, msk_r),
+                       _mm_madd_epi16(signs_r, msk_r), _mm_madd_epi16(dlt_x_r, msk_r));
+
+  sums_y = hsum4_epi32(_mm_madd_epi16(dlt_y_l, msk_l), _mm_madd_epi16(dlt_y_r, msk_r),
+                       _mm_setzero_si128(), _mm_setzero_si128());
+
+  bdof_weights(_mm_extract_epi32(sums_l, 0), _mm_extract_epi32(sums_l, 1),
+               _mm_extract_epi32(sums_l, 2), _mm_extract_epi32(sums_l, 3),
+               _mm_extract_epi32(sums_y, 0), &wgt_x[0], &wgt_y[0]);
+
+  bdof_weights(_mm_extract_epi32(sums_r, 0), _mm_extract_epi32(sums_r, 1),
+               _mm_extract_epi32(sums_r, 2), _mm_extract_epi32(sums_r, 3),
+               _mm_extract_epi32(sums_y, 1), &wgt_x[1], &wgt_y[1]);
+}
+
+/* Refine 4 lines of two horizontally adjacent 4x4 subblocks */
+static inline void
+apply_bdof_x2(const int16_t *ref0, const int16_t *ref1, int ref_stride,
+              int16_t *dst, int dst_stride,
+              const int16_t *grad_x0, const int16_t *grad_x1,
+              const int16_t *grad_y0, const int16_t *grad_y1, int grad_stride,
+              const int16_t *wgt_x, const int16_t *wgt_y)
+{
+  const __m128i wgt_l = _mm_set1_epi32((uint16_t)wgt_x[0] | ((uint32_t)(uint16_t)wgt_y[0] << 16));
+  const __m128i wgt_r = _mm_set1_epi32((uint16_t)wgt_x[1] | ((uint32_t)(uint16_t)wgt_y[1] << 16));
+  const __m128i offset = _mm_set1_epi32(BDOF_OFFSET);
+  const __m128i smp_max = _mm_set1_epi16(OV_SAMPLE_MAX);
+  const __m128i zero = _mm_setzero_si128();
+  int i;
+
+  for (i = 0; i < 4; ++i) {
+    __m128i gx0 = _mm_loadu_si128((const __m128i *)grad_x0);
+    __m128i gx1 = _mm_loadu_si128((const __m128i *)grad_x1);
+    __m128i gy0 = _mm_loadu_si128((const __m128i *)grad_y0);
+    __m128i gy1 = _mm_loadu_si128((const __m128i *)grad_y1);
+    __m128i r0  = _mm_loadu_si128((const __m128i *)ref0);
+    __m128i r1  = _mm_loadu_si128((const __m128i *)ref1);
+
+    __m128i dgx = _mm_sub_epi16(gx0, gx1);
+    __m128i dgy = _mm_sub_epi16(gy0, gy1);
+
+    __m128i b_l = _mm_madd_epi16(_mm_unpacklo_epi16(dgx, dgy), wgt_l);
+    __m128i b_r = _mm_madd_epi16(_mm_unpackhi_epi16(dgx, dgy), wgt_r);
+
+    __m128i sum_l = _mm_add_epi32(_mm_cvtepi16_epi32(r0), _mm_cvtepi16_epi32(r1));
+    __m128i sum_r = _mm_add_epi32(_mm_cvtepi16_epi32(_mm_srli_si128(r0, 8)),
+                                  _mm_cvtepi16_epi32(_mm_srli_si128(r1, 8)));
+    __m128i val;
+
+    sum_l = _mm_add_epi32(_mm_add_epi32(sum_l, b_l), offset);
+    sum_r = _mm_add_epi32(_mm_add_epi32(sum_r, b_r), offset);
+
+    sum_l = _mm_srai_epi32(sum_l, BDOF_SHIFT);
+    sum_r = _mm_srai_epi32(sum_r, BDOF_SHIFT);
+
+    val = _mm_packs_epi32(sum_l, sum_r);
+    val = _mm_min_epi16(_mm_max_epi16(val, zero), smp_max);
+
+    _mm_storeu_si128((__m128i *)dst, val);
+
+    dst  += dst_stride;
+    ref0 += ref_stride;
+    ref1 += ref_stride;
+
+    grad_x0 += grad_stride;
+    grad_x1 += grad_stride;
+    grad_y0 += grad_stride;
+    grad_y1 += grad_stride;
+  }
+}
+
+/* Block width must be a multiple of 8 */
+static void
+bdof_sse(int16_t *dst, int dst_stride,
+         const int16_t *ref_bdof0, const int16_t *ref_bdof1, int ref_stride,
+         const int16_t *grad_x0, const int16_t *grad_y0,
+         const int16_t *grad_x1, const int16_t *grad_y1,
+         int grad_stride, uint8_t pb_w, uint8_t pb_h)
+{
+  const int16_t *ref0_ln = ref_bdof0 - ref_stride - 1;
+  const int16_t *ref1_ln = ref_bdof1 - ref_stride - 1;
+  int i, j;
+
+  for (i = 0; i < pb_h; i += 4) {
+    for (j = 0; j < pb_w; j += 8) {
+      int16_t wgt_x[2];
+      int16_t wgt_y[2];
+
+      derive_bdof_weights_x2(ref0_ln + j, ref1_ln + j,
+                             grad_x0 + j, grad_x1 + j, grad_y0 + j, grad_y1 + j,
+                             ref_stride, grad_stride, wgt_x, wgt_y);
+
+      apply_bdof_x2(ref0_ln + ref_stride + 1 + j, ref1_ln + ref_stride + 1 + j, ref_stride,
+                    dst + j, dst_stride,
+                    grad_x0 + grad_stride + 1 + j, grad_x1 + grad_stride + 1 + j,
+                    grad_y0 + grad_stride + 1 + j, grad_y1 + grad_stride + 1 + j,
+                    grad_stride, wgt_x, wgt_y);
+    }
+
+    ref0_ln += ref_stride << 2;
+    ref1_ln += ref_stride << 2;
+
+    grad_x0 += grad_stride << 2;
+    grad_y0 += grad_stride << 2;
+    grad_x1 += grad_stride << 2;
+    grad_y1 += grad_stride << 2;
+
+    dst += dst_stride << 2;
+  }
+}
+
+void
+rcn_init_refine_functions_sse(struct RCNFunctions *const rcn_funcs)
+{
+  rcn_funcs->dmvr.sad  = &dmvr_sad_sse;
+  rcn_funcs->dmvr.sads = &dmvr_sads_sse;
+
+  rcn_funcs->bdof.grad      = &bdof_grad_sse;
+  rcn_funcs->bdof.subblocks = &bdof_sse;
+
+  rcn_funcs->prof.grad = &prof_grad_sse;
+  rcn_funcs->prof.func = &prof_sse;
+}
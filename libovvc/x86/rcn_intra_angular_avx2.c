@@ -0,0 +1,336 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "ovutils.h"
+#include "rcn_structures.h"
+#include "data_rcn_angular.h"
+#include "x86/rcn_avx2.h"
+
+static const int8_t cubic_filter_avx2[32][4] = {
+  {  0, 64,  0,  0 }, { -1, 63,  2,  0 }, { -2, 62,  4,  0 }, { -2, 60,  7, -1 },
+  { -2, 58, 10, -2 }, { -3, 57, 12, -2 }, { -4, 56, 14, -2 }, { -4, 55, 15, -2 },
+  { -4, 54, 16, -2 }, { -5, 53, 18, -2 }, { -6, 52, 20, -2 }, { -6, 49, 24, -3 },
+  { -6, 46, 28, -4 }, { -5, 44, 29, -4 }, { -4, 42, 30, -4 }, { -4, 39, 33, -4 },
+  { -4, 36, 36, -4 }, { -4, 33, 39, -4 }, { -4, 30, 42, -4 }, { -4, 29, 44, -5 },
+  { -4, 28, 46, -6 }, { -3, 24, 49, -6 }, { -2, 20, 52, -6 }, { -2, 18, 53, -5 },
+  { -2, 16, 54, -4 }, { -2, 15, 55, -4 }, { -2, 14, 56, -4 }, { -2, 12, 57, -3 },
+  { -2, 10, 58, -2 }, { -1,  7, 60, -2 }, {  0,  4, 62, -2 }, {  0,  2, 63, -1 }
+};
+
+#define TMP_STRIDE 128
+
+/* Kernels below interpolate 16 samples per iteration and are only
+ * registered for lines of at least 16 samples so that the at most
+ * 12 PDPC samples of a line fit in one register
+ */
+struct PDPCInfo
+{
+  int16_t wgt[16];
+  int16_t idx[16];
+  int nb_smp;
+};
+
+static inline __m256i
+tap_pair(int c0, int c1)
+{
+  return _mm256_set1_epi32((uint16_t)c0 | ((uint32_t)(uint16_t)c1 << 16));
+}
+
+static inline void
+load_coeffs(int delta_frac, int is_gauss, __m256i *c01, __m256i *c23)
+{
+  if (is_gauss) {
+    const int f = delta_frac >> 1;
+    *c01 = tap_pair(16 - f, 32 - f);
+    *c23 = tap_pair(16 + f, f);
+  } else {
+    const int8_t *filter = cubic_filter_avx2[delta_frac];
+    *c01 = tap_pair(filter[0], filter[1]);
+    *c23 = tap_pair(filter[2], filter[3]);
+  }
+}
+
+static inline __m256i
+filter_4tap_16(const uint16_t *ref, __m256i c01, __m256i c23)
+{
+  const __m256i rnd = _mm256_set1_epi32(32);
+  const __m256i r0 = _mm256_loadu_si256((const __m256i *)&ref[0]);
+  const __m256i r1 = _mm256_loadu_si256((const __m256i *)&ref[1]);
+  const __m256i r2 = _mm256_loadu_si256((const __m256i *)&ref[2]);
+  const __m256i r3 = _mm256_loadu_si256((const __m256i *)&ref[3]);
+
+  /* Unpacks and packs both operate within 128-bit lanes so that
+   * samples order is preserved
+   */
+  __m256i lo = _mm256_add_epi32(_mm256_madd_epi16(_mm256_unpacklo_epi16(r0, r1), c01),
+                                _mm256_madd_epi16(_mm256_unpacklo_epi16(r2, r3), c23));
+  __m256i hi = _mm256_add_epi32(_mm256_madd_epi16(_mm256_unpackhi_epi16(r0, r1), c01),
+                                _mm256_madd_epi16(_mm256_unpackhi_epi16(r2, r3), c23));
+
+  lo = _mm256_srai_epi32(_mm256_add_epi32(lo, rnd), 6);
+  hi = _mm256_srai_epi32(_mm256_add_epi32(hi, rnd), 6);
+
+  return _mm256_min_epu16(_mm256_packus_epi32(lo, hi), _mm256_set1_epi16(OV_SAMPLE_MAX));
+}
+
+static inline void
+filter_line(const uint16_t *ref, uint16_t *dst, int line_len,
+            int delta_frac, int is_gauss)
+{
+  __m256i c01, c23;
+  int x;
+
+  load_coeffs(delta_frac, is_gauss, &c01, &c23);
+
+  for (x = 0; x < line_len; x += 16) {
+    _mm256_storeu_si256((__m256i *)&dst[x], filter_4tap_16(&ref[x], c01, c23));
+  }
+}
+
+static void
+init_pdpc_info(struct PDPCInfo *pdpc, int mode_idx, int log2_nb_lines, int line_len)
+{
+  const int inv_angle = inverse_angle_table[mode_idx];
+  const int scale = OVMIN(2, log2_nb_lines - (floor_log2(3 * inv_angle - 2) - 8));
+  int x;
+
+  pdpc->nb_smp = OVMIN(3 << scale, line_len);
+
+  for (x = 0; x < 16; ++x) {
+    pdpc->wgt[x] = x < pdpc->nb_smp ? 32 >> ((x << 1) >> scale) : 0;
+    pdpc->idx[x] = x < pdpc->nb_smp ? ((256 + (x + 1) * inv_angle) >> 9) + 1 : 0;
+  }
+}
+
+/* dst + ((wgt * (side - dst) + 32) >> 6) */
+static inline void
+pdpc_line(const uint16_t *ref_side, uint16_t *dst, const struct PDPCInfo *pdpc)
+{
+  const __m256i wgt = _mm256_loadu_si256((const __m256i *)pdpc->wgt);
+  const __m256i wrnd = _mm256_set1_epi16(32);
+  const __m256i one = _mm256_set1_epi16(1);
+  int16_t side[16] = {0};
+  __m256i pred, diff, lo, hi;
+  int x;
+
+  for (x = 0; x < pdpc->nb_smp; ++x) {
+    side[x] = ref_side[pdpc->idx[x]];
+  }
+
+  pred = _mm256_loadu_si256((const __m256i *)dst);
+  diff = _mm256_sub_epi16(_mm256_loadu_si256((const __m256i *)side), pred);
+
+  lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(diff, one), _mm256_unpacklo_epi16(wgt, wrnd));
+  hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(diff, one), _mm256_unpackhi_epi16(wgt, wrnd));
+
+  lo = _mm256_srai_epi32(lo, 6);
+  hi = _mm256_srai_epi32(hi, 6);
+
+  pred = _mm256_add_epi16(pred, _mm256_packs_epi32(lo, hi));
+  pred = _mm256_max_epi16(pred, _mm256_setzero_si256());
+  pred = _mm256_min_epi16(pred, _mm256_set1_epi16(OV_SAMPLE_MAX));
+
+  _mm256_storeu_si256((__m256i *)dst, pred);
+}
+
+static inline void
+transpose_8x8(__m128i *x)
+{
+  __m128i t0 = _mm_unpacklo_epi16(x[0], x[1]);
+  __m128i t1 = _mm_unpackhi_epi16(x[0], x[1]);
+  __m128i t2 = _mm_unpacklo_epi16(x[2], x[3]);
+  __m128i t3 = _mm_unpackhi_epi16(x[2], x[3]);
+  __m128i t4 = _mm_unpacklo_epi16(x[4], x[5]);
+  __m128i t5 = _mm_unpackhi_epi16(x[4], x[5]);
+  __m128i t6 = _mm_unpacklo_epi16(x[6], x[7]);
+  __m128i t7 = _mm_unpackhi_epi16(x[6], x[7]);
+
+  __m128i u0 = _mm_unpacklo_epi32(t0, t2);
+  __m128i u1 = _mm_unpackhi_epi32(t0, t2);
+  __m128i u2 = _mm_unpacklo_epi32(t1, t3);
+  __m128i u3 = _mm_unpackhi_epi32(t1, t3);
+  __m128i u4 = _mm_unpacklo_epi32(t4, t6);
+  __m128i u5 = _mm_unpackhi_epi32(t4, t6);
+  __m128i u6 = _mm_unpacklo_epi32(t5, t7);
+  __m128i u7 = _mm_unpackhi_epi32(t5, t7);
+
+  x[0] = _mm_unpacklo_epi64(u0, u4);
+  x[1] = _mm_unpackhi_epi64(u0, u4);
+  x[2] = _mm_unpacklo_epi64(u1, u5);
+  x[3] = _mm_unpackhi_epi64(u1, u5);
+  x[4] = _mm_unpacklo_epi64(u2, u6);
+  x[5] = _mm_unpackhi_epi64(u2, u6);
+  x[6] = _mm_unpacklo_epi64(u3, u7);
+  x[7] = _mm_unpackhi_epi64(u3, u7);
+}
+
+/* tmp lines are dst columns, height is at least 16 */
+static void
+transpose_tmp(const uint16_t *tmp, uint16_t *dst, ptrdiff_t dst_stride,
+              int width, int height)
+{
+  int x, y, i;
+
+  if (width < 8) {
+    for (x = 0; x < width; ++x) {
+      for (y = 0; y < height; ++y) {
+        dst[y * dst_stride + x] = tmp[x * TMP_STRIDE + y];
+      }
+    }
+    return;
+  }
+
+  for (x = 0; x < width; x += 8) {
+    for (y = 0; y < height; y += 8) {
+      __m128i r[8];
+      for (i = 0; i < 8; ++i) {
+        r[i] = _mm_loadu_si128((const __m128i *)&tmp[(x + i) * TMP_STRIDE + y]);
+      }
+      transpose_8x8(r);
+      for (i = 0; i < 8; ++i) {
+        _mm_storeu_si128((__m128i *)&dst[(y + i) * dst_stride + x], r[i]);
+      }
+    }
+  }
+}
+
+static inline void
+angular_lines(const uint16_t *ref, const uint16_t *ref_side,
+              uint16_t *dst, ptrdiff_t dst_stride,
+              int line_len, int nb_lines, int angle_val, int is_gauss,
+              const struct PDPCInfo *pdpc)
+{
+  int delta_pos = angle_val;
+  int y;
+
+  for (y = 0; y < nb_lines; ++y) {
+    filter_line(ref + (delta_pos >> 5), dst, line_len, delta_pos & 0x1F, is_gauss);
+    if (pdpc) {
+      pdpc_line(ref_side + y, dst, pdpc);
+    }
+    delta_pos += angle_val;
+    dst += dst_stride;
+  }
+}
+
+static void
+intra_angular_v_cubic_avx2(const uint16_t *ref_abv, uint16_t *dst,
+                           ptrdiff_t dst_stride, int log2_pb_w,
+                           int log2_pb_h, int angle_val)
+{
+  angular_lines(ref_abv, NULL, dst, dst_stride, 1 << log2_pb_w, 1 << log2_pb_h,
+                angle_val, 0, NULL);
+}
+
+static void
+intra_angular_v_gauss_avx2(const uint16_t *ref_abv, uint16_t *dst,
+                           ptrdiff_t dst_stride, int log2_pb_w,
+                           int log2_pb_h, int angle_val)
+{
+  angular_lines(ref_abv, NULL, dst, dst_stride, 1 << log2_pb_w, 1 << log2_pb_h,
+                angle_val, 1, NULL);
+}
+
+static void
+intra_angular_h_cubic_avx2(const uint16_t *ref_lft, uint16_t *dst,
+                           ptrdiff_t dst_stride, int log2_pb_w,
+                           int log2_pb_h, int angle_val)
+{
+  uint16_t tmp[TMP_STRIDE * 128];
+
+  angular_lines(ref_lft, NULL, tmp, TMP_STRIDE, 1 << log2_pb_h, 1 << log2_pb_w,
+                angle_val, 0, NULL);
+
+  transpose_tmp(tmp, dst, dst_stride, 1 << log2_pb_w, 1 << log2_pb_h);
+}
+
+static void
+intra_angular_h_gauss_avx2(const uint16_t *ref_lft, uint16_t *dst,
+                           ptrdiff_t dst_stride, int log2_pb_w,
+                           int log2_pb_h, int angle_val)
+{
+  uint16_t tmp[TMP_STRIDE * 128];
+
+  angular_lines(ref_lft, NULL, tmp, TMP_STRIDE, 1 << log2_pb_h, 1 << log2_pb_w,
+                angle_val, 1, NULL);
+
+  transpose_tmp(tmp, dst, dst_stride, 1 << log2_pb_w, 1 << log2_pb_h);
+}
+
+static void
+intra_angular_v_cubic_pdpc_avx2(const uint16_t *ref_abv, const uint16_t *ref_lft,
+                                uint16_t *const dst, ptrdiff_t dst_stride,
+                                int log2_pb_w, int log2_pb_h, int mode_idx)
+{
+  struct PDPCInfo pdpc;
+
+  init_pdpc_info(&pdpc, mode_idx, log2_pb_h, 1 << log2_pb_w);
+
+  angular_lines(ref_abv, ref_lft, dst, dst_stride, 1 << log2_pb_w, 1 << log2_pb_h,
+                angle_table[mode_idx], 0, &pdpc);
+}
+
+static void
+intra_angular_v_gauss_pdpc_avx2(const uint16_t *ref_abv, const uint16_t *ref_lft,
+                                uint16_t *const dst, ptrdiff_t dst_stride,
+                                int log2_pb_w, int log2_pb_h, int mode_idx)
+{
+  struct PDPCInfo pdpc;
+
+  init_pdpc_info(&pdpc, mode_idx, log2_pb_h, 1 << log2_pb_w);
+
+  angular_lines(ref_abv, ref_lft, dst, dst_stride, 1 << log2_pb_w, 1 << log2_pb_h,
+                angle_table[mode_idx], 1, &pdpc);
+}
+
+static void
+intra_angular_h_cubic_pdpc_avx2(const uint16_t *ref_abv, const uint16_t *ref_lft,
+                                uint16_t *const dst, ptrdiff_t dst_stride,
+                                int log2_pb_w, int log2_pb_h, int mode_idx)
+{
+  uint16_t tmp[TMP_STRIDE * 128];
+  struct PDPCInfo pdpc;
+
+  init_pdpc_info(&pdpc, mode_idx, log2_pb_w, 1 << log2_pb_h);
+
+  angular_lines(ref_lft, ref_abv, tmp, TMP_STRIDE, 1 << log2_pb_h, 1 << log2_pb_w,
+                angle_table[mode_idx], 0, &pdpc);
+
+  transpose_tmp(tmp, dst, dst_stride, 1 << log2_pb_w, 1 << log2_pb_h);
+}
+
+static void
+intra_angular_h_gauss_pdpc_avx2(const uint16_t *ref_abv, const uint16_t *ref_lft,
+                                uint16_t *const dst, ptrdiff_t dst_stride,
+                                int log2_pb_w, int log2_pb_h, int mode_idx)
+{
+  uint16_t tmp[TMP_STRIDE * 128];
+  struct PDPCInfo pdpc;
+
+  init_pdpc_info(&pdpc, mode_idx, log2_pb_w, 1 << log2_pb_h);
+
+  angular_lines(ref_lft, ref_abv, tmp, TMP_STRIDE, 1 << log2_pb_h, 1 << log2_pb_w,
+                angle_table[mode_idx], 1, &pdpc);
+
+  transpose_tmp(tmp, dst, dst_stride, 1 << log2_pb_w, 1 << log2_pb_h);
+}
+
+void
+rcn_init_angular_functions_avx2(struct RCNFunctions *const rcn_funcs)
+{
+  struct AngularFunctions *const angular = &rcn_funcs->angular;
+  int i;
+
+  for (i = 4; i < 8; ++i) {
+    angular->v[0][i] = &intra_angular_v_cubic_avx2;
+    angular->v[1][i] = &intra_angular_v_gauss_avx2;
+    angular->h[0][i] = &intra_angular_h_cubic_avx2;
+    angular->h[1][i] = &intra_angular_h_gauss_avx2;
+
+    angular->v_pdpc[0][i] = &intra_angular_v_cubic_pdpc_avx2;
+    angular->v_pdpc[1][i] = &intra_angular_v_gauss_pdpc_avx2;
+    angular->h_pdpc[0][i] = &intra_angular_h_cubic_pdpc_avx2;
+    angular->h_pdpc[1][i] = &intra_angular_h_gauss_pdpc_avx2;
+  }
+}
@@ -6,7 +6,6 @@
 #include "ovutils.h"
 #include "ctudec.h"
 
-#define CLIP_10 ((1 << 10) - 1)
 
 static void
 compute_lm_subsample_4_sse(const uint16_t *lm_src, uint16_t *dst_cb, uint16_t *dst_cr,
@@ -64,8 +63,8 @@ compute_lm_subsample_4_sse(const uint16_t *lm_src, uint16_t *dst_cb, uint16_t *d
                         r[0] = _mm_max_epi16(r[0], _mm_setzero_si128());
                         r[1] = _mm_max_epi16(r[1], _mm_setzero_si128());
 
-                        r[0] = _mm_min_epi16(r[0], _mm_set1_epi16(CLIP_10));
-                        r[1] = _mm_min_epi16(r[1], _mm_set1_epi16(CLIP_10));
+                        r[0] = _mm_min_epi16(r[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+                        r[1] = _mm_min_epi16(r[1], _mm_set1_epi16(OV_SAMPLE_MAX));
 
                         _mm_storel_epi64((__m128i *)&dst_cb[0], r[0]);
                         _mm_storel_epi64((__m128i *)&dst_cr[0], r[1]);
@@ -104,8 +103,8 @@ compute_lm_subsample_4_sse(const uint16_t *lm_src, uint16_t *dst_cb, uint16_t *d
                               r[0] = _mm_max_epi16(r[0], _mm_setzero_si128());
                               r[1] = _mm_max_epi16(r[1], _mm_setzero_si128());
 
-                              r[0] = _mm_min_epi16(r[0], _mm_set1_epi16(CLIP_10));
-                              r[1] = _mm_min_epi16(r[1], _mm_set1_epi16(CLIP_10));
+                              r[0] = _mm_min_epi16(r[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+                              r[1] = _mm_min_epi16(r[1], _mm_set1_epi16(OV_SAMPLE_MAX));
 
                               _mm_storel_epi64((__m128i *)&dst_cb[i], r[0]);
                               _mm_storel_epi64((__m128i *)&dst_cr[i], r[1]);
@@ -183,8 +182,8 @@ compute_lm_subsample_8_sse(const uint16_t *lm_src, uint16_t *dst_cb, uint16_t *d
                           r[0] = _mm_max_epi16(r[0], _mm_setzero_si128());
                           r[1] = _mm_max_epi16(r[1], _mm_setzero_si128());
 
-                          r[0] = _mm_min_epi16(r[0], _mm_set1_epi16(CLIP_10));
-                          r[1] = _mm_min_epi16(r[1], _mm_set1_epi16(CLIP_10));
+                          r[0] = _mm_min_epi16(r[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+                          r[1] = _mm_min_epi16(r[1], _mm_set1_epi16(OV_SAMPLE_MAX));
 
                           _mm_storeu_si128((__m128i *)&dst_cb[0], r[0]);
                           _mm_storeu_si128((__m128i *)&dst_cr[0], r[1]);
@@ -235,8 +234,8 @@ compute_lm_subsample_8_sse(const uint16_t *lm_src, uint16_t *dst_cb, uint16_t *d
                               r[0] = _mm_max_epi16(r[0], _mm_setzero_si128());
                               r[1] = _mm_max_epi16(r[1], _mm_setzero_si128());
 
-                              r[0] = _mm_min_epi16(r[0], _mm_set1_epi16(CLIP_10));
-                              r[1] = _mm_min_epi16(r[1], _mm_set1_epi16(CLIP_10));
+                              r[0] = _mm_min_epi16(r[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+                              r[1] = _mm_min_epi16(r[1], _mm_set1_epi16(OV_SAMPLE_MAX));
 
                               _mm_storeu_si128((__m128i *)&dst_cb[i], r[0]);
                               _mm_storeu_si128((__m128i *)&dst_cr[i], r[1]);
@@ -298,8 +297,8 @@ compute_lm_subsample_4_lft_avail_sse(const uint16_t *lm_src, uint16_t *dst_cb, u
                               r[0] = _mm_max_epi16(r[0], _mm_setzero_si128());
                               r[1] = _mm_max_epi16(r[1], _mm_setzero_si128());
 
-                              r[0] = _mm_min_epi16(r[0], _mm_set1_epi16(CLIP_10));
-                              r[1] = _mm_min_epi16(r[1], _mm_set1_epi16(CLIP_10));
+                              r[0] = _mm_min_epi16(r[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+                              r[1] = _mm_min_epi16(r[1], _mm_set1_epi16(OV_SAMPLE_MAX));
 
                               _mm_storel_epi64((__m128i *)&dst_cb[i], r[0]);
                               _mm_storel_epi64((__m128i *)&dst_cr[i], r[1]);
@@ -373,8 +372,8 @@ compute_lm_subsample_8_lft_avail_sse(const uint16_t *lm_src, uint16_t *dst_cb, u
                               r[0] = _mm_max_epi16(r[0], _mm_setzero_si128());
                               r[1] = _mm_max_epi16(r[1], _mm_setzero_si128());
 
-                              r[0] = _mm_min_epi16(r[0], _mm_set1_epi16(CLIP_10));
-                              r[1] = _mm_min_epi16(r[1], _mm_set1_epi16(CLIP_10));
+                              r[0] = _mm_min_epi16(r[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+                              r[1] = _mm_min_epi16(r[1], _mm_set1_epi16(OV_SAMPLE_MAX));
 
                               _mm_storeu_si128((__m128i *)&dst_cb[i], r[0]);
                               _mm_storeu_si128((__m128i *)&dst_cr[i], r[1]);
@@ -113,7 +113,7 @@ vvc_intra_dc_pdpc_sse(const uint16_t *const src_above,
 
             out_v = _mm_srli_epi16(tst,6);
 
-            out_v = _mm_min_epi16(out_v, _mm_set1_epi16(1023));
+            out_v = _mm_min_epi16(out_v, _mm_set1_epi16(OV_SAMPLE_MAX));
             out_v = _mm_max_epi16(out_v, _mm_set1_epi16(0));
 
             _mm_storeu_si128((__m128i *)(_dst + 8 * x), out_v);
@@ -290,7 +290,7 @@ vvc_intra_planar_pdpc_sse(const uint16_t *const src_above,
 
             out_v = _mm_srli_epi16(tst,6);
 
-            out_v = _mm_min_epi16(out_v, _mm_set1_epi16(1023));
+            out_v = _mm_min_epi16(out_v, _mm_set1_epi16(OV_SAMPLE_MAX));
             out_v = _mm_max_epi16(out_v, _mm_set1_epi16(0));
 
             _mm_storeu_si128((__m128i *)(_dst + 8 * x), out_v);
@@ -466,7 +466,7 @@ vvc_intra_planar_pdpc_2_sse(const uint16_t *const src_above,
 
             out_v = _mm_srli_epi16(tst,6);
 
-            out_v = _mm_min_epi16(out_v, _mm_set1_epi16(1023));
+            out_v = _mm_min_epi16(out_v, _mm_set1_epi16(OV_SAMPLE_MAX));
             out_v = _mm_max_epi16(out_v, _mm_set1_epi16(0));
 
             _mm_storeu_si128((__m128i *)(_dst + 8 * x), out_v);
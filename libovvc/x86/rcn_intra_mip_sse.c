@@ -75,7 +75,7 @@ mip_matmult_8_8(int16_t * bndy_line, uint16_t * mip_pred, const int stride_x, co
 
           m[0] = _mm_packs_epi32(m[0], m[1]);
 
-          m[0] = _mm_min_epi16(m[0], _mm_set1_epi16(1023));
+          m[0] = _mm_min_epi16(m[0], _mm_set1_epi16(OV_SAMPLE_MAX));
           m[0] = _mm_max_epi16(m[0], _mm_setzero_si128());
 
           _mm_store_si128((__m128i *)mip_pred, m[0]);
@@ -128,7 +128,7 @@ mip_matmult_8_8(int16_t * bndy_line, uint16_t * mip_pred, const int stride_x, co
 
             m[0] = _mm_packs_epi32(m[0], m[1]);
 
-            m[0] = _mm_min_epi16(m[0], _mm_set1_epi16(1023));
+            m[0] = _mm_min_epi16(m[0], _mm_set1_epi16(OV_SAMPLE_MAX));
             m[0] = _mm_max_epi16(m[0], _mm_setzero_si128());
 
             _mm_storeu_si128((__m128i *)mip_pred, m[0]);
@@ -167,7 +167,7 @@ mip_matmult_4_4(int16_t * bndy_line, uint16_t * mip_pred, const int stride_x, co
 
           m[0] = _mm_packs_epi32(m[0], _mm_setzero_si128());
 
-          m[0] = _mm_min_epi16(m[0], _mm_set1_epi16(1023));
+          m[0] = _mm_min_epi16(m[0], _mm_set1_epi16(OV_SAMPLE_MAX));
           m[0] = _mm_max_epi16(m[0], _mm_setzero_si128());
 
           _mm_storel_epi64((__m128i *)mip_pred, m[0]);
@@ -0,0 +1,793 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "rcn_structures.h"
+#include "x86/rcn_avx2.h"
+
+#define SIZE_BLOCK_16 3
+#define SIZE_BLOCK_32 4
+#define SIZE_BLOCK_64 5
+#define SIZE_BLOCK_128 6
+
+#define MAX_PB_SIZE 128
+
+#define EPEL_EXTRA_BEFORE 1
+#define EPEL_EXTRA_AFTER 2
+#define EPEL_EXTRA EPEL_EXTRA_BEFORE + EPEL_EXTRA_AFTER
+
+#define QPEL_EXTRA_BEFORE 3
+#define QPEL_EXTRA_AFTER 4
+#define QPEL_EXTRA QPEL_EXTRA_BEFORE + QPEL_EXTRA_AFTER
+
+/* Kernels below process 16 samples per iteration and are only
+ * registered for blocks whose width is a multiple of 16
+ */
+
+static const int8_t ov_mc_filters_avx2[16][8] =
+{
+  {   0, 1,  -3, 63,  4,  -2,  1,  0 },
+  {  -1, 2,  -5, 62,  8,  -3,  1,  0 },
+  {  -1, 3,  -8, 60, 13,  -4,  1,  0 },
+  {  -1, 4, -10, 58, 17,  -5,  1,  0 },
+  {  -1, 4, -11, 52, 26,  -8,  3, -1 },
+  {  -1, 3,  -9, 47, 31, -10,  4, -1 },
+  {  -1, 4, -11, 45, 34, -10,  4, -1 },
+  {  -1, 4, -11, 40, 40, -11,  4, -1 },
+  {  -1, 4, -10, 34, 45, -11,  4, -1 },
+  {  -1, 4, -10, 31, 47,  -9,  3, -1 },
+  {  -1, 3,  -8, 26, 52, -11,  4, -1 },
+  {   0, 1,  -5, 17, 58, -10,  4, -1 },
+  {   0, 1,  -4, 13, 60,  -8,  3, -1 },
+  {   0, 1,  -3,  8, 62,  -5,  2, -1 },
+  {   0, 1,  -2,  4, 63,  -3,  1,  0 },
+
+  //Hpel for amvr
+  {   0, 3,   9, 20, 20,   9,  3,  0 }
+};
+
+static const int8_t ov_mcp_filters_c_avx2[31][4] =
+{
+  { -1, 63,  2,  0 },
+  { -2, 62,  4,  0 },
+  { -2, 60,  7, -1 },
+  { -2, 58, 10, -2 },
+  { -3, 57, 12, -2 },
+  { -4, 56, 14, -2 },
+  { -4, 55, 15, -2 },
+  { -4, 54, 16, -2 },
+  { -5, 53, 18, -2 },
+  { -6, 52, 20, -2 },
+  { -6, 49, 24, -3 },
+  { -6, 46, 28, -4 },
+  { -5, 44, 29, -4 },
+  { -4, 42, 30, -4 },
+  { -4, 39, 33, -4 },
+  { -4, 36, 36, -4 },
+  { -4, 33, 39, -4 },
+  { -4, 30, 42, -4 },
+  { -4, 29, 44, -5 },
+  { -4, 28, 46, -6 },
+  { -3, 24, 49, -6 },
+  { -2, 20, 52, -6 },
+  { -2, 18, 53, -5 },
+  { -2, 16, 54, -4 },
+  { -2, 15, 55, -4 },
+  { -2, 14, 56, -4 },
+  { -2, 12, 57, -3 },
+  { -2, 10, 58, -2 },
+  { -1,  7, 60, -2 },
+  {  0,  4, 62, -2 },
+  {  0,  2, 63, -1 },
+};
+
+/* Pack pairs of consecutive taps so they can be applied with madd
+ * on interleaved samples
+ */
+static inline void
+load_coeffs(__m256i *c, const int8_t *filter, int nb_taps)
+{
+  int i;
+  for (i = 0; i < nb_taps / 2; ++i) {
+    c[i] = _mm256_set1_epi32((uint16_t)filter[2 * i] | ((uint32_t)(uint16_t)filter[2 * i + 1] << 16));
+  }
+}
+
+/* Apply nb_taps filter on 16 consecutive samples, src points to the
+ * current sample and taps are read at src + k * stride for k in
+ * [-(nb_taps / 2 - 1); nb_taps / 2]
+ * Lane order is kept since unpack, madd and packs all operate on
+ * 128 bits lanes
+ */
+static inline __m256i
+mc_filter_16(const int16_t *src, ptrdiff_t stride, const __m256i *c,
+             int nb_taps, int shift)
+{
+  __m256i lo = _mm256_setzero_si256();
+  __m256i hi = _mm256_setzero_si256();
+  int k;
+
+  src -= (nb_taps / 2 - 1) * stride;
+
+  for (k = 0; k < nb_taps / 2; ++k) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)&src[(2 * k) * stride]);
+    __m256i b = _mm256_loadu_si256((const __m256i *)&src[(2 * k + 1) * stride]);
+    lo = _mm256_add_epi32(lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), c[k]));
+    hi = _mm256_add_epi32(hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), c[k]));
+  }
+
+  lo = _mm256_srai_epi32(lo, shift);
+  hi = _mm256_srai_epi32(hi, shift);
+
+  return _mm256_packs_epi32(lo, hi);
+}
+
+/* Round 14 bits intermediate samples to output bitdepth */
+static inline __m256i
+mc_uni_round(__m256i x)
+{
+  const __m256i offset = _mm256_set1_epi16(1 << (14 - 10 - 1));
+  x = _mm256_srai_epi16(_mm256_add_epi16(x, offset), 14 - 10);
+  x = _mm256_max_epi16(x, _mm256_setzero_si256());
+  return _mm256_min_epi16(x, _mm256_set1_epi16(0x03FF));
+}
+
+/* Weighted sum of two 14 bits predictions with rounding and clipping
+ * wx contains the weights of a and b in its low and high 16 bits
+ */
+static inline __m256i
+mc_bi_round(__m256i a, __m256i b, __m256i wx, __m256i offset, int shift)
+{
+  __m256i lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), wx);
+  __m256i hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), wx);
+
+  lo = _mm256_srai_epi32(_mm256_add_epi32(lo, offset), shift);
+  hi = _mm256_srai_epi32(_mm256_add_epi32(hi, offset), shift);
+
+  return _mm256_min_epu16(_mm256_packus_epi32(lo, hi), _mm256_set1_epi16(0x03FF));
+}
+
+static inline __m256i
+mc_bi_avg(__m256i a, __m256i b)
+{
+  const int shift = 14 + 1 - 10;
+  return mc_bi_round(a, b, _mm256_set1_epi32(0x00010001),
+                     _mm256_set1_epi32(1 << (shift - 1)), shift);
+}
+
+static inline __m256i
+mc_pel_16(const uint16_t *src)
+{
+  __m256i x = _mm256_loadu_si256((const __m256i *)src);
+  return _mm256_slli_epi16(x, 14 - 10);
+}
+
+/* First pass of separable filters into a MAX_PB_SIZE stride buffer
+ * including nb_taps - 1 extra rows required by vertical filtering
+ */
+static inline void
+mc_filter_h_tmp(int16_t *tmp, const uint16_t *src, ptrdiff_t srcstride,
+                const int8_t *filter, int nb_taps, int height, int width)
+{
+  __m256i c[4];
+  int x, y;
+
+  load_coeffs(c, filter, nb_taps);
+
+  src -= (nb_taps / 2 - 1) * srcstride;
+
+  for (y = 0; y < height + nb_taps - 1; y++) {
+    for (x = 0; x < width; x += 16) {
+      __m256i r = mc_filter_16((const int16_t *)&src[x], 1, c, nb_taps, 10 - 8);
+      _mm256_storeu_si256((__m256i *)&tmp[x], r);
+    }
+    src += srcstride;
+    tmp += MAX_PB_SIZE;
+  }
+}
+
+static void
+put_vvc_uni_pel_pixels16_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                                 const uint16_t *src, ptrdiff_t srcstride,
+                                 int height, intptr_t mx, intptr_t my, int width)
+{
+  int x, y;
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x += 16) {
+      __m256i r = _mm256_loadu_si256((const __m256i *)&src[x]);
+      _mm256_storeu_si256((__m256i *)&dst[x], r);
+    }
+    src += srcstride;
+    dst += dststride;
+  }
+}
+
+static void
+put_vvc_bi0_pel_pixels16_10_avx2(int16_t *dst, const uint16_t *src,
+                                 ptrdiff_t srcstride, int height,
+                                 intptr_t mx, intptr_t my, int width)
+{
+  int x, y;
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x += 16) {
+      _mm256_storeu_si256((__m256i *)&dst[x], mc_pel_16(&src[x]));
+    }
+    src += srcstride;
+    dst += MAX_PB_SIZE;
+  }
+}
+
+static void
+put_vvc_bi1_pel_pixels16_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                                 const uint16_t *src0, ptrdiff_t srcstride,
+                                 const int16_t *src1, int height,
+                                 intptr_t mx, intptr_t my, int width)
+{
+  int x, y;
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x += 16) {
+      __m256i b = _mm256_loadu_si256((const __m256i *)&src1[x]);
+      __m256i r = mc_bi_avg(mc_pel_16(&src0[x]), b);
+      _mm256_storeu_si256((__m256i *)&dst[x], r);
+    }
+    src0 += srcstride;
+    src1 += MAX_PB_SIZE;
+    dst += dststride;
+  }
+}
+
+static void
+put_vvc_bi_w_pel_pixels16_10_avx2(uint8_t *_dst, ptrdiff_t _dststride,
+                                  uint8_t *_src, ptrdiff_t _srcstride,
+                                  int16_t *src2, ptrdiff_t src2stride,
+                                  int height, int denom, int wx0, int wx1,
+                                  intptr_t mx, intptr_t my, int width)
+{
+  uint16_t *dst = (uint16_t *)_dst;
+  const uint16_t *src = (const uint16_t *)_src;
+  ptrdiff_t dststride = _dststride >> 1;
+  ptrdiff_t srcstride = _srcstride >> 1;
+  const int shift = denom + 14 - 10 + 1;
+  const __m256i offset = _mm256_set1_epi32(1 << (shift - 1));
+  const __m256i wx = _mm256_set1_epi32((uint16_t)wx1 | ((uint32_t)(uint16_t)wx0 << 16));
+  int x, y;
+
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x += 16) {
+      __m256i b = _mm256_loadu_si256((const __m256i *)&src2[x]);
+      __m256i r = mc_bi_round(mc_pel_16(&src[x]), b, wx, offset, shift);
+      _mm256_storeu_si256((__m256i *)&dst[x], r);
+    }
+    src += srcstride;
+    src2 += src2stride;
+    dst += dststride;
+  }
+}
+
+/* Generic kernels, stride is 1 for horizontal and srcstride for
+ * vertical filtering
+ */
+static inline void
+put_vvc_uni_filter_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                           const uint16_t *src, ptrdiff_t srcstride,
+                           ptrdiff_t tap_stride, const int8_t *filter,
+                           int nb_taps, int height, int width)
+{
+  __m256i c[4];
+  int x, y;
+
+  load_coeffs(c, filter, nb_taps);
+
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x += 16) {
+      __m256i r = mc_filter_16((const int16_t *)&src[x], tap_stride, c, nb_taps, 10 - 8);
+      _mm256_storeu_si256((__m256i *)&dst[x], mc_uni_round(r));
+    }
+    src += srcstride;
+    dst += dststride;
+  }
+}
+
+static inline void
+put_vvc_bi0_filter_10_avx2(int16_t *dst, const uint16_t *src,
+                           ptrdiff_t srcstride, ptrdiff_t tap_stride,
+                           const int8_t *filter, int nb_taps,
+                           int height, int width)
+{
+  __m256i c[4];
+  int x, y;
+
+  load_coeffs(c, filter, nb_taps);
+
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x += 16) {
+      __m256i r = mc_filter_16((const int16_t *)&src[x], tap_stride, c, nb_taps, 10 - 8);
+      _mm256_storeu_si256((__m256i *)&dst[x], r);
+    }
+    src += srcstride;
+    dst += MAX_PB_SIZE;
+  }
+}
+
+static inline void
+put_vvc_bi1_filter_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                           const uint16_t *src0, ptrdiff_t srcstride,
+                           const int16_t *src1, ptrdiff_t tap_stride,
+                           const int8_t *filter, int nb_taps,
+                           int height, int width)
+{
+  __m256i c[4];
+  int x, y;
+
+  load_coeffs(c, filter, nb_taps);
+
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x += 16) {
+      __m256i a = mc_filter_16((const int16_t *)&src0[x], tap_stride, c, nb_taps, 10 - 8);
+      __m256i b = _mm256_loadu_si256((const __m256i *)&src1[x]);
+      _mm256_storeu_si256((__m256i *)&dst[x], mc_bi_avg(a, b));
+    }
+    src0 += srcstride;
+    src1 += MAX_PB_SIZE;
+    dst += dststride;
+  }
+}
+
+static inline void
+put_vvc_bi_w_filter_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                            const uint16_t *src, ptrdiff_t srcstride,
+                            const int16_t *src2, ptrdiff_t src2stride,
+                            ptrdiff_t tap_stride, const int8_t *filter,
+                            int nb_taps, int height, int denom,
+                            int wx0, int wx1, int width)
+{
+  const int shift = denom + 14 - 10 + 1;
+  const __m256i offset = _mm256_set1_epi32(1 << (shift - 1));
+  const __m256i wx = _mm256_set1_epi32((uint16_t)wx1 | ((uint32_t)(uint16_t)wx0 << 16));
+  __m256i c[4];
+  int x, y;
+
+  load_coeffs(c, filter, nb_taps);
+
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x += 16) {
+      __m256i a = mc_filter_16((const int16_t *)&src[x], tap_stride, c, nb_taps, 10 - 8);
+      __m256i b = _mm256_loadu_si256((const __m256i *)&src2[x]);
+      _mm256_storeu_si256((__m256i *)&dst[x], mc_bi_round(a, b, wx, offset, shift));
+    }
+    src += srcstride;
+    src2 += src2stride;
+    dst += dststride;
+  }
+}
+
+/* Separable kernels, second pass is applied on the 14 bits
+ * horizontally filtered samples
+ */
+static inline void
+put_vvc_uni_hv_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                       const uint16_t *src, ptrdiff_t srcstride,
+                       const int8_t *filter_h, const int8_t *filter_v,
+                       int nb_taps, int height, int width)
+{
+  int16_t tmp_array[(MAX_PB_SIZE + QPEL_EXTRA) * MAX_PB_SIZE];
+  const int16_t *tmp = tmp_array + (nb_taps / 2 - 1) * MAX_PB_SIZE;
+  __m256i c[4];
+  int x, y;
+
+  mc_filter_h_tmp(tmp_array, src, srcstride, filter_h, nb_taps, height, width);
+
+  load_coeffs(c, filter_v, nb_taps);
+
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x += 16) {
+      __m256i r = mc_filter_16(&tmp[x], MAX_PB_SIZE, c, nb_taps, 6);
+      _mm256_storeu_si256((__m256i *)&dst[x], mc_uni_round(r));
+    }
+    tmp += MAX_PB_SIZE;
+    dst += dststride;
+  }
+}
+
+static inline void
+put_vvc_bi0_hv_10_avx2(int16_t *dst, const uint16_t *src, ptrdiff_t srcstride,
+                       const int8_t *filter_h, const int8_t *filter_v,
+                       int nb_taps, int height, int width)
+{
+  int16_t tmp_array[(MAX_PB_SIZE + QPEL_EXTRA) * MAX_PB_SIZE];
+  const int16_t *tmp = tmp_array + (nb_taps / 2 - 1) * MAX_PB_SIZE;
+  __m256i c[4];
+  int x, y;
+
+  mc_filter_h_tmp(tmp_array, src, srcstride, filter_h, nb_taps, height, width);
+
+  load_coeffs(c, filter_v, nb_taps);
+
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x += 16) {
+      __m256i r = mc_filter_16(&tmp[x], MAX_PB_SIZE, c, nb_taps, 6);
+      _mm256_storeu_si256((__m256i *)&dst[x], r);
+    }
+    tmp += MAX_PB_SIZE;
+    dst += MAX_PB_SIZE;
+  }
+}
+
+static inline void
+put_vvc_bi1_hv_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                       const uint16_t *src0, ptrdiff_t srcstride,
+                       const int16_t *src1,
+                       const int8_t *filter_h, const int8_t *filter_v,
+                       int nb_taps, int height, int width)
+{
+  int16_t tmp_array[(MAX_PB_SIZE + QPEL_EXTRA) * MAX_PB_SIZE];
+  const int16_t *tmp = tmp_array + (nb_taps / 2 - 1) * MAX_PB_SIZE;
+  __m256i c[4];
+  int x, y;
+
+  mc_filter_h_tmp(tmp_array, src0, srcstride, filter_h, nb_taps, height, width);
+
+  load_coeffs(c, filter_v, nb_taps);
+
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x += 16) {
+      __m256i a = mc_filter_16(&tmp[x], MAX_PB_SIZE, c, nb_taps, 6);
+      __m256i b = _mm256_loadu_si256((const __m256i *)&src1[x]);
+      _mm256_storeu_si256((__m256i *)&dst[x], mc_bi_avg(a, b));
+    }
+    tmp += MAX_PB_SIZE;
+    src1 += MAX_PB_SIZE;
+    dst += dststride;
+  }
+}
+
+static inline void
+put_vvc_bi_w_hv_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                        const uint16_t *src, ptrdiff_t srcstride,
+                        const int16_t *src2, ptrdiff_t src2stride,
+                        const int8_t *filter_h, const int8_t *filter_v,
+                        int nb_taps, int height, int denom,
+                        int wx0, int wx1, int width)
+{
+  int16_t tmp_array[(MAX_PB_SIZE + QPEL_EXTRA) * MAX_PB_SIZE];
+  const int16_t *tmp = tmp_array + (nb_taps / 2 - 1) * MAX_PB_SIZE;
+  const int shift = denom + 14 - 10 + 1;
+  const __m256i offset = _mm256_set1_epi32(1 << (shift - 1));
+  const __m256i wx = _mm256_set1_epi32((uint16_t)wx1 | ((uint32_t)(uint16_t)wx0 << 16));
+  __m256i c[4];
+  int x, y;
+
+  mc_filter_h_tmp(tmp_array, src, srcstride, filter_h, nb_taps, height, width);
+
+  load_coeffs(c, filter_v, nb_taps);
+
+  for (y = 0; y < height; y++) {
+    for (x = 0; x < width; x += 16) {
+      __m256i a = mc_filter_16(&tmp[x], MAX_PB_SIZE, c, nb_taps, 6);
+      __m256i b = _mm256_loadu_si256((const __m256i *)&src2[x]);
+      _mm256_storeu_si256((__m256i *)&dst[x], mc_bi_round(a, b, wx, offset, shift));
+    }
+    tmp += MAX_PB_SIZE;
+    src2 += src2stride;
+    dst += dststride;
+  }
+}
+
+/* Luma 8 taps kernels */
+static void
+put_vvc_uni_qpel_h16_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                             const uint16_t *src, ptrdiff_t srcstride,
+                             int height, intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_uni_filter_10_avx2(dst, dststride, src, srcstride, 1,
+                             ov_mc_filters_avx2[mx - 1], 8, height, width);
+}
+
+static void
+put_vvc_uni_qpel_v16_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                             const uint16_t *src, ptrdiff_t srcstride,
+                             int height, intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_uni_filter_10_avx2(dst, dststride, src, srcstride, srcstride,
+                             ov_mc_filters_avx2[my - 1], 8, height, width);
+}
+
+static void
+put_vvc_uni_qpel_hv16_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                              const uint16_t *src, ptrdiff_t srcstride,
+                              int height, intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_uni_hv_10_avx2(dst, dststride, src, srcstride,
+                         ov_mc_filters_avx2[mx - 1], ov_mc_filters_avx2[my - 1],
+                         8, height, width);
+}
+
+static void
+put_vvc_bi0_qpel_h16_10_avx2(int16_t *dst, const uint16_t *src,
+                             ptrdiff_t srcstride, int height,
+                             intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi0_filter_10_avx2(dst, src, srcstride, 1,
+                             ov_mc_filters_avx2[mx - 1], 8, height, width);
+}
+
+static void
+put_vvc_bi0_qpel_v16_10_avx2(int16_t *dst, const uint16_t *src,
+                             ptrdiff_t srcstride, int height,
+                             intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi0_filter_10_avx2(dst, src, srcstride, srcstride,
+                             ov_mc_filters_avx2[my - 1], 8, height, width);
+}
+
+static void
+put_vvc_bi0_qpel_hv16_10_avx2(int16_t *dst, const uint16_t *src,
+                              ptrdiff_t srcstride, int height,
+                              intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi0_hv_10_avx2(dst, src, srcstride,
+                         ov_mc_filters_avx2[mx - 1], ov_mc_filters_avx2[my - 1],
+                         8, height, width);
+}
+
+static void
+put_vvc_bi1_qpel_h16_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                             const uint16_t *src0, ptrdiff_t srcstride,
+                             const int16_t *src1, int height,
+                             intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi1_filter_10_avx2(dst, dststride, src0, srcstride, src1, 1,
+                             ov_mc_filters_avx2[mx - 1], 8, height, width);
+}
+
+static void
+put_vvc_bi1_qpel_v16_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                             const uint16_t *src0, ptrdiff_t srcstride,
+                             const int16_t *src1, int height,
+                             intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi1_filter_10_avx2(dst, dststride, src0, srcstride, src1, srcstride,
+                             ov_mc_filters_avx2[my - 1], 8, height, width);
+}
+
+static void
+put_vvc_bi1_qpel_hv16_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                              const uint16_t *src0, ptrdiff_t srcstride,
+                              const int16_t *src1, int height,
+                              intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi1_hv_10_avx2(dst, dststride, src0, srcstride, src1,
+                         ov_mc_filters_avx2[mx - 1], ov_mc_filters_avx2[my - 1],
+                         8, height, width);
+}
+
+static void
+put_vvc_bi_w_qpel_h16_10_avx2(uint8_t *_dst, ptrdiff_t _dststride,
+                              uint8_t *_src, ptrdiff_t _srcstride,
+                              int16_t *src2, ptrdiff_t src2stride,
+                              int height, int denom, int wx0, int wx1,
+                              intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi_w_filter_10_avx2((uint16_t *)_dst, _dststride >> 1,
+                              (const uint16_t *)_src, _srcstride >> 1,
+                              src2, src2stride, 1, ov_mc_filters_avx2[mx - 1],
+                              8, height, denom, wx0, wx1, width);
+}
+
+static void
+put_vvc_bi_w_qpel_v16_10_avx2(uint8_t *_dst, ptrdiff_t _dststride,
+                              uint8_t *_src, ptrdiff_t _srcstride,
+                              int16_t *src2, ptrdiff_t src2stride,
+                              int height, int denom, int wx0, int wx1,
+                              intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi_w_filter_10_avx2((uint16_t *)_dst, _dststride >> 1,
+                              (const uint16_t *)_src, _srcstride >> 1,
+                              src2, src2stride, _srcstride >> 1,
+                              ov_mc_filters_avx2[my - 1],
+                              8, height, denom, wx0, wx1, width);
+}
+
+static void
+put_vvc_bi_w_qpel_hv16_10_avx2(uint8_t *_dst, ptrdiff_t _dststride,
+                               uint8_t *_src, ptrdiff_t _srcstride,
+                               int16_t *src2, ptrdiff_t src2stride,
+                               int height, int denom, int wx0, int wx1,
+                               intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi_w_hv_10_avx2((uint16_t *)_dst, _dststride >> 1,
+                          (const uint16_t *)_src, _srcstride >> 1,
+                          src2, src2stride,
+                          ov_mc_filters_avx2[mx - 1], ov_mc_filters_avx2[my - 1],
+                          8, height, denom, wx0, wx1, width);
+}
+
+/* Chroma 4 taps kernels */
+static void
+put_vvc_uni_epel_h16_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                             const uint16_t *src, ptrdiff_t srcstride,
+                             int height, intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_uni_filter_10_avx2(dst, dststride, src, srcstride, 1,
+                             ov_mcp_filters_c_avx2[mx - 1], 4, height, width);
+}
+
+static void
+put_vvc_uni_epel_v16_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                             const uint16_t *src, ptrdiff_t srcstride,
+                             int height, intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_uni_filter_10_avx2(dst, dststride, src, srcstride, srcstride,
+                             ov_mcp_filters_c_avx2[my - 1], 4, height, width);
+}
+
+static void
+put_vvc_uni_epel_hv16_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                              const uint16_t *src, ptrdiff_t srcstride,
+                              int height, intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_uni_hv_10_avx2(dst, dststride, src, srcstride,
+                         ov_mcp_filters_c_avx2[mx - 1], ov_mcp_filters_c_avx2[my - 1],
+                         4, height, width);
+}
+
+static void
+put_vvc_bi0_epel_h16_10_avx2(int16_t *dst, const uint16_t *src,
+                             ptrdiff_t srcstride, int height,
+                             intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi0_filter_10_avx2(dst, src, srcstride, 1,
+                             ov_mcp_filters_c_avx2[mx - 1], 4, height, width);
+}
+
+static void
+put_vvc_bi0_epel_v16_10_avx2(int16_t *dst, const uint16_t *src,
+                             ptrdiff_t srcstride, int height,
+                             intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi0_filter_10_avx2(dst, src, srcstride, srcstride,
+                             ov_mcp_filters_c_avx2[my - 1], 4, height, width);
+}
+
+static void
+put_vvc_bi0_epel_hv16_10_avx2(int16_t *dst, const uint16_t *src,
+                              ptrdiff_t srcstride, int height,
+                              intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi0_hv_10_avx2(dst, src, srcstride,
+                         ov_mcp_filters_c_avx2[mx - 1], ov_mcp_filters_c_avx2[my - 1],
+                         4, height, width);
+}
+
+static void
+put_vvc_bi1_epel_h16_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                             const uint16_t *src0, ptrdiff_t srcstride,
+                             const int16_t *src1, int height,
+                             intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi1_filter_10_avx2(dst, dststride, src0, srcstride, src1, 1,
+                             ov_mcp_filters_c_avx2[mx - 1], 4, height, width);
+}
+
+static void
+put_vvc_bi1_epel_v16_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                             const uint16_t *src0, ptrdiff_t srcstride,
+                             const int16_t *src1, int height,
+                             intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi1_filter_10_avx2(dst, dststride, src0, srcstride, src1, srcstride,
+                             ov_mcp_filters_c_avx2[my - 1], 4, height, width);
+}
+
+static void
+put_vvc_bi1_epel_hv16_10_avx2(uint16_t *dst, ptrdiff_t dststride,
+                              const uint16_t *src0, ptrdiff_t srcstride,
+                              const int16_t *src1, int height,
+                              intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi1_hv_10_avx2(dst, dststride, src0, srcstride, src1,
+                         ov_mcp_filters_c_avx2[mx - 1], ov_mcp_filters_c_avx2[my - 1],
+                         4, height, width);
+}
+
+static void
+put_vvc_bi_w_epel_h16_10_avx2(uint8_t *_dst, ptrdiff_t _dststride,
+                              uint8_t *_src, ptrdiff_t _srcstride,
+                              int16_t *src2, ptrdiff_t src2stride,
+                              int height, int denom, int wx0, int wx1,
+                              intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi_w_filter_10_avx2((uint16_t *)_dst, _dststride >> 1,
+                              (const uint16_t *)_src, _srcstride >> 1,
+                              src2, src2stride, 1, ov_mcp_filters_c_avx2[mx - 1],
+                              4, height, denom, wx0, wx1, width);
+}
+
+static void
+put_vvc_bi_w_epel_v16_10_avx2(uint8_t *_dst, ptrdiff_t _dststride,
+                              uint8_t *_src, ptrdiff_t _srcstride,
+                              int16_t *src2, ptrdiff_t src2stride,
+                              int height, int denom, int wx0, int wx1,
+                              intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi_w_filter_10_avx2((uint16_t *)_dst, _dststride >> 1,
+                              (const uint16_t *)_src, _srcstride >> 1,
+                              src2, src2stride, _srcstride >> 1,
+                              ov_mcp_filters_c_avx2[my - 1],
+                              4, height, denom, wx0, wx1, width);
+}
+
+static void
+put_vvc_bi_w_epel_hv16_10_avx2(uint8_t *_dst, ptrdiff_t _dststride,
+                               uint8_t *_src, ptrdiff_t _srcstride,
+                               int16_t *src2, ptrdiff_t src2stride,
+                               int height, int denom, int wx0, int wx1,
+                               intptr_t mx, intptr_t my, int width)
+{
+  put_vvc_bi_w_hv_10_avx2((uint16_t *)_dst, _dststride >> 1,
+                          (const uint16_t *)_src, _srcstride >> 1,
+                          src2, src2stride,
+                          ov_mcp_filters_c_avx2[mx - 1], ov_mcp_filters_c_avx2[my - 1],
+                          4, height, denom, wx0, wx1, width);
+}
+
+static void
+init_mc_size_avx2(struct MCFunctions *const mc, int size_idx, int is_chroma)
+{
+  mc->unidir[0][size_idx] = &put_vvc_uni_pel_pixels16_10_avx2;
+  mc->bidir0[0][size_idx] = &put_vvc_bi0_pel_pixels16_10_avx2;
+  mc->bidir1[0][size_idx] = &put_vvc_bi1_pel_pixels16_10_avx2;
+  mc->bidir_w[0][size_idx] = &put_vvc_bi_w_pel_pixels16_10_avx2;
+
+  if (!is_chroma) {
+    mc->unidir[1][size_idx] = &put_vvc_uni_qpel_h16_10_avx2;
+    mc->bidir0[1][size_idx] = &put_vvc_bi0_qpel_h16_10_avx2;
+    mc->bidir1[1][size_idx] = &put_vvc_bi1_qpel_h16_10_avx2;
+    mc->bidir_w[1][size_idx] = &put_vvc_bi_w_qpel_h16_10_avx2;
+
+    mc->unidir[2][size_idx] = &put_vvc_uni_qpel_v16_10_avx2;
+    mc->bidir0[2][size_idx] = &put_vvc_bi0_qpel_v16_10_avx2;
+    mc->bidir1[2][size_idx] = &put_vvc_bi1_qpel_v16_10_avx2;
+    mc->bidir_w[2][size_idx] = &put_vvc_bi_w_qpel_v16_10_avx2;
+
+    mc->unidir[3][size_idx] = &put_vvc_uni_qpel_hv16_10_avx2;
+    mc->bidir0[3][size_idx] = &put_vvc_bi0_qpel_hv16_10_avx2;
+    mc->bidir1[3][size_idx] = &put_vvc_bi1_qpel_hv16_10_avx2;
+    mc->bidir_w[3][size_idx] = &put_vvc_bi_w_qpel_hv16_10_avx2;
+  } else {
+    mc->unidir[1][size_idx] = &put_vvc_uni_epel_h16_10_avx2;
+    mc->bidir0[1][size_idx] = &put_vvc_bi0_epel_h16_10_avx2;
+    mc->bidir1[1][size_idx] = &put_vvc_bi1_epel_h16_10_avx2;
+    mc->bidir_w[1][size_idx] = &put_vvc_bi_w_epel_h16_10_avx2;
+
+    mc->unidir[2][size_idx] = &put_vvc_uni_epel_v16_10_avx2;
+    mc->bidir0[2][size_idx] = &put_vvc_bi0_epel_v16_10_avx2;
+    mc->bidir1[2][size_idx] = &put_vvc_bi1_epel_v16_10_avx2;
+    mc->bidir_w[2][size_idx] = &put_vvc_bi_w_epel_v16_10_avx2;
+
+    mc->unidir[3][size_idx] = &put_vvc_uni_epel_hv16_10_avx2;
+    mc->bidir0[3][size_idx] = &put_vvc_bi0_epel_hv16_10_avx2;
+    mc->bidir1[3][size_idx] = &put_vvc_bi1_epel_hv16_10_avx2;
+    mc->bidir_w[3][size_idx] = &put_vvc_bi_w_epel_hv16_10_avx2;
+  }
+}
+
+void
+rcn_init_mc_functions_avx2(struct RCNFunctions* const rcn_funcs)
+{
+  struct MCFunctions* const mc_l = &rcn_funcs->mc_l;
+  struct MCFunctions* const mc_c = &rcn_funcs->mc_c;
+
+  /* Luma width is 2 << size_idx */
+  init_mc_size_avx2(mc_l, SIZE_BLOCK_16, 0);
+  init_mc_size_avx2(mc_l, SIZE_BLOCK_32, 0);
+  init_mc_size_avx2(mc_l, SIZE_BLOCK_64, 0);
+  init_mc_size_avx2(mc_l, SIZE_BLOCK_128, 0);
+
+  /* Chroma is indexed by luma size so SIZE_BLOCK_16 can be called
+   * on 8 samples wide chroma blocks and is left to SSE
+   */
+  init_mc_size_avx2(mc_c, SIZE_BLOCK_32, 1);
+  init_mc_size_avx2(mc_c, SIZE_BLOCK_64, 1);
+  init_mc_size_avx2(mc_c, SIZE_BLOCK_128, 1);
+}
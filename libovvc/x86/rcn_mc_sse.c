@@ -7793,7 +7793,6 @@ rcn_init_mc_functions_sse(struct RCNFunctions* const rcn_funcs)
   #endif
 
 
-
   // /* Chroma functions */
   mc_c->unidir[0][SIZE_BLOCK_4] = &oh_hevc_put_hevc_uni_pel_pixels4_10_sse;
   mc_c->bidir0[0][SIZE_BLOCK_4] = &oh_hevc_put_hevc_bi0_pel_pixels4_10_sse;
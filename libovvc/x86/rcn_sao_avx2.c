@@ -0,0 +1,187 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "dec_structures.h"
+#include "rcn_structures.h"
+#include "x86/rcn_avx2.h"
+
+static inline __m256i
+sao_band_offset_avx2(__m256i src, const __m256i band[4], const __m256i sao[4])
+{
+  const __m256i band_idx = _mm256_srai_epi16(src, 10 - 5);
+  __m256i x0, x1, x2, x3;
+
+  x0 = _mm256_and_si256(_mm256_cmpeq_epi16(band_idx, band[0]), sao[0]);
+  x1 = _mm256_and_si256(_mm256_cmpeq_epi16(band_idx, band[1]), sao[1]);
+  x2 = _mm256_and_si256(_mm256_cmpeq_epi16(band_idx, band[2]), sao[2]);
+  x3 = _mm256_and_si256(_mm256_cmpeq_epi16(band_idx, band[3]), sao[3]);
+
+  x0 = _mm256_or_si256(_mm256_or_si256(x0, x1), _mm256_or_si256(x2, x3));
+
+  src = _mm256_add_epi16(src, x0);
+  src = _mm256_max_epi16(src, _mm256_setzero_si256());
+
+  return _mm256_min_epi16(src, _mm256_set1_epi16(0x03FF));
+}
+
+static void
+sao_band_filter_avx2(uint8_t *_dst, uint8_t *_src,
+                     ptrdiff_t _stride_dst, ptrdiff_t _stride_src,
+                     struct SAOParamsCtu *sao, int width,
+                     int height, int c_idx)
+{
+  int16_t *sao_offset_val = sao->offset_val[c_idx];
+  uint8_t sao_left_class = sao->band_position[c_idx];
+  uint16_t *dst = (uint16_t *)_dst;
+  uint16_t *src = (uint16_t *)_src;
+  ptrdiff_t stride_dst = _stride_dst >> 1;
+  ptrdiff_t stride_src = _stride_src >> 1;
+  __m256i band[4], sao_val[4];
+  int x, y, k;
+
+  for (k = 0; k < 4; ++k) {
+    band[k]    = _mm256_set1_epi16((sao_left_class + k) & 31);
+    sao_val[k] = _mm256_set1_epi16(sao_offset_val[k]);
+  }
+
+  for (y = 0; y < height; y++) {
+    for (x = 0; x + 16 <= width; x += 16) {
+      __m256i src0 = _mm256_loadu_si256((__m256i *)&src[x]);
+      _mm256_storeu_si256((__m256i *)&dst[x], sao_band_offset_avx2(src0, band, sao_val));
+    }
+
+    /* Remaining samples by 8 */
+    for (; x < width; x += 8) {
+      __m256i src0 = _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)&src[x]));
+      src0 = sao_band_offset_avx2(src0, band, sao_val);
+      _mm_storeu_si128((__m128i *)&dst[x], _mm256_castsi256_si128(src0));
+    }
+    dst += stride_dst;
+    src += stride_src;
+  }
+}
+
+/* Sign of differences with both neighbours are summed
+ * so edge categories are in [-2, 2]
+ */
+static inline __m256i
+sao_edge_offset_avx2(__m256i x0, __m256i cmp0, __m256i cmp1, const __m256i offset[5])
+{
+  __m256i x1, x2, x3, r0, r1, r2, r3, r4;
+
+  r2 = _mm256_min_epu16(x0, cmp0);
+  x1 = _mm256_cmpeq_epi16(cmp0, r2);
+  x2 = _mm256_cmpeq_epi16(x0, r2);
+  x1 = _mm256_sub_epi16(x2, x1);
+  r2 = _mm256_min_epu16(x0, cmp1);
+  x3 = _mm256_cmpeq_epi16(cmp1, r2);
+  x2 = _mm256_cmpeq_epi16(x0, r2);
+  x3 = _mm256_sub_epi16(x2, x3);
+  x1 = _mm256_add_epi16(x1, x3);
+
+  r0 = _mm256_and_si256(_mm256_cmpeq_epi16(x1, _mm256_set1_epi16(-2)), offset[0]);
+  r1 = _mm256_and_si256(_mm256_cmpeq_epi16(x1, _mm256_set1_epi16(-1)), offset[1]);
+  r2 = _mm256_and_si256(_mm256_cmpeq_epi16(x1, _mm256_set1_epi16(0)),  offset[2]);
+  r3 = _mm256_and_si256(_mm256_cmpeq_epi16(x1, _mm256_set1_epi16(1)),  offset[3]);
+  r4 = _mm256_and_si256(_mm256_cmpeq_epi16(x1, _mm256_set1_epi16(2)),  offset[4]);
+
+  r0 = _mm256_add_epi16(r0, r1);
+  r2 = _mm256_add_epi16(r2, r3);
+  r0 = _mm256_add_epi16(r0, r4);
+
+  return _mm256_add_epi16(r0, r2);
+}
+
+static inline __m256i
+sao_edge_apply_avx2(__m256i x0, __m256i off)
+{
+  __m256i r0 = _mm256_add_epi16(off, x0);
+  r0 = _mm256_max_epi16(r0, _mm256_setzero_si256());
+  return _mm256_min_epi16(r0, _mm256_set1_epi16(0x03FF));
+}
+
+static inline void
+sao_edge_filter_avx2(uint8_t *_dst, uint8_t *_src,
+                     ptrdiff_t _stride_dst, ptrdiff_t _stride_src,
+                     struct SAOParamsCtu *sao, int width,
+                     int height, int c_idx, int skip_last)
+{
+  static const int8_t pos[4][2][2] = {
+    { { -1,  0 }, {  1, 0 } },
+    { {  0, -1 }, {  0, 1 } },
+    { { -1, -1 }, {  1, 1 } },
+    { {  1, -1 }, { -1, 1 } },
+  };
+  int16_t *sao_offset_val = sao->offset_val[c_idx];
+  int eo = sao->eo_class[c_idx];
+  uint16_t *dst = (uint16_t *)_dst;
+  uint16_t *src = (uint16_t *)_src;
+  ptrdiff_t stride_dst = _stride_dst >> 1;
+  ptrdiff_t stride_src = _stride_src >> 1;
+  int a_stride = pos[eo][0][0] + pos[eo][0][1] * stride_src;
+  int b_stride = pos[eo][1][0] + pos[eo][1][1] * stride_src;
+  int width8 = width & ~7;
+  __m256i offset[5];
+  int x, y, k;
+
+  for (k = 0; k < 5; ++k) {
+    offset[k] = _mm256_set1_epi16(sao_offset_val[k]);
+  }
+
+  for (y = 0; y < height; y++) {
+    for (x = 0; x + 16 <= width8; x += 16) {
+      __m256i x0   = _mm256_loadu_si256((__m256i *)(src + x));
+      __m256i cmp0 = _mm256_loadu_si256((__m256i *)(src + x + a_stride));
+      __m256i cmp1 = _mm256_loadu_si256((__m256i *)(src + x + b_stride));
+      __m256i off  = sao_edge_offset_avx2(x0, cmp0, cmp1, offset);
+
+      _mm256_storeu_si256((__m256i *)(dst + x), sao_edge_apply_avx2(x0, off));
+    }
+
+    /* Remaining 8 samples are processed on the lower 128 bits, last
+     * of them is left unchanged when width is not a multiple of 8
+     */
+    for (; x < width8 + (skip_last ? 8 : 0); x += 8) {
+      __m256i x0   = _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)(src + x)));
+      __m256i cmp0 = _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)(src + x + a_stride)));
+      __m256i cmp1 = _mm256_castsi128_si256(_mm_loadu_si128((__m128i *)(src + x + b_stride)));
+      __m256i off  = sao_edge_offset_avx2(x0, cmp0, cmp1, offset);
+
+      if (x >= width8) {
+        off = _mm256_and_si256(off, _mm256_setr_epi16(-1, -1, -1, -1, -1, -1, -1, 0,
+                                                      0, 0, 0, 0, 0, 0, 0, 0));
+      }
+
+      _mm_storeu_si128((__m128i *)(dst + x), _mm256_castsi256_si128(sao_edge_apply_avx2(x0, off)));
+    }
+    src += stride_src;
+    dst += stride_dst;
+  }
+}
+
+static void
+sao_edge_filter_7_avx2(uint8_t *_dst, uint8_t *_src,
+                       ptrdiff_t _stride_dst, ptrdiff_t _stride_src,
+                       struct SAOParamsCtu *sao, int width,
+                       int height, int c_idx)
+{
+  sao_edge_filter_avx2(_dst, _src, _stride_dst, _stride_src, sao, width, height, c_idx, 1);
+}
+
+static void
+sao_edge_filter_8_avx2(uint8_t *_dst, uint8_t *_src,
+                       ptrdiff_t _stride_dst, ptrdiff_t _stride_src,
+                       struct SAOParamsCtu *sao, int width,
+                       int height, int c_idx)
+{
+  sao_edge_filter_avx2(_dst, _src, _stride_dst, _stride_src, sao, width, height, c_idx, 0);
+}
+
+void
+rcn_init_sao_functions_avx2(struct RCNFunctions *const rcn_funcs)
+{
+  rcn_funcs->sao.band    = &sao_band_filter_avx2;
+  rcn_funcs->sao.edge[0] = &sao_edge_filter_7_avx2;
+  rcn_funcs->sao.edge[1] = &sao_edge_filter_8_avx2;
+}
@@ -9,7 +9,6 @@
 #include "rcn.h"
 #include "ovutils.h"
 
-#define CLIP_10 ((1 << 10) - 1)
 #define SIGN_16 (int16_t)(1 << 15)
 
 static inline void
@@ -37,10 +36,10 @@ ovvc_transform_add_sse_8_4_10(uint16_t *dst, ptrdiff_t dst_stride,
    l2 = _mm_max_epi16(l2, _mm_setzero_si128());
    l3 = _mm_max_epi16(l3, _mm_setzero_si128());
 
-   l0 = _mm_min_epi16(l0, _mm_set1_epi16(CLIP_10));
-   l1 = _mm_min_epi16(l1, _mm_set1_epi16(CLIP_10));
-   l2 = _mm_min_epi16(l2, _mm_set1_epi16(CLIP_10));
-   l3 = _mm_min_epi16(l3, _mm_set1_epi16(CLIP_10));
+   l0 = _mm_min_epi16(l0, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l1 = _mm_min_epi16(l1, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l2 = _mm_min_epi16(l2, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l3 = _mm_min_epi16(l3, _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l0);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l1);
@@ -73,10 +72,10 @@ ovvc_transform_add_sse_16_2_10(uint16_t *dst, ptrdiff_t dst_stride,
    l2 = _mm_max_epi16(l2, _mm_setzero_si128());
    l3 = _mm_max_epi16(l3, _mm_setzero_si128());
 
-   l0 = _mm_min_epi16(l0, _mm_set1_epi16(CLIP_10));
-   l1 = _mm_min_epi16(l1, _mm_set1_epi16(CLIP_10));
-   l2 = _mm_min_epi16(l2, _mm_set1_epi16(CLIP_10));
-   l3 = _mm_min_epi16(l3, _mm_set1_epi16(CLIP_10));
+   l0 = _mm_min_epi16(l0, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l1 = _mm_min_epi16(l1, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l2 = _mm_min_epi16(l2, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l3 = _mm_min_epi16(l3, _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l0);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l1);
@@ -109,10 +108,10 @@ ovvc_transform_add_sse_32_1_10(uint16_t *dst, ptrdiff_t dst_stride,
    l2 = _mm_max_epi16(l2, _mm_setzero_si128());
    l3 = _mm_max_epi16(l3, _mm_setzero_si128());
 
-   l0 = _mm_min_epi16(l0, _mm_set1_epi16(CLIP_10));
-   l1 = _mm_min_epi16(l1, _mm_set1_epi16(CLIP_10));
-   l2 = _mm_min_epi16(l2, _mm_set1_epi16(CLIP_10));
-   l3 = _mm_min_epi16(l3, _mm_set1_epi16(CLIP_10));
+   l0 = _mm_min_epi16(l0, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l1 = _mm_min_epi16(l1, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l2 = _mm_min_epi16(l2, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l3 = _mm_min_epi16(l3, _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l0);
    _mm_storeu_si128((__m128i*)&dst[8  + 0 * dst_stride], l1);
@@ -150,10 +149,10 @@ ovvc_transform_add_half_sse_8_4_10(uint16_t *dst, ptrdiff_t dst_stride,
    l2 = _mm_max_epi16(l2, _mm_setzero_si128());
    l3 = _mm_max_epi16(l3, _mm_setzero_si128());
 
-   l0 = _mm_min_epi16(l0, _mm_set1_epi16(CLIP_10));
-   l1 = _mm_min_epi16(l1, _mm_set1_epi16(CLIP_10));
-   l2 = _mm_min_epi16(l2, _mm_set1_epi16(CLIP_10));
-   l3 = _mm_min_epi16(l3, _mm_set1_epi16(CLIP_10));
+   l0 = _mm_min_epi16(l0, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l1 = _mm_min_epi16(l1, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l2 = _mm_min_epi16(l2, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l3 = _mm_min_epi16(l3, _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l0);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l1);
@@ -191,10 +190,10 @@ ovvc_transform_add_half_sse_16_2_10(uint16_t *dst, ptrdiff_t dst_stride,
    l2 = _mm_max_epi16(l2, _mm_setzero_si128());
    l3 = _mm_max_epi16(l3, _mm_setzero_si128());
 
-   l0 = _mm_min_epi16(l0, _mm_set1_epi16(CLIP_10));
-   l1 = _mm_min_epi16(l1, _mm_set1_epi16(CLIP_10));
-   l2 = _mm_min_epi16(l2, _mm_set1_epi16(CLIP_10));
-   l3 = _mm_min_epi16(l3, _mm_set1_epi16(CLIP_10));
+   l0 = _mm_min_epi16(l0, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l1 = _mm_min_epi16(l1, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l2 = _mm_min_epi16(l2, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l3 = _mm_min_epi16(l3, _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l0);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l1);
@@ -232,10 +231,10 @@ ovvc_transform_add_half_sse_32_1_10(uint16_t *dst, ptrdiff_t dst_stride,
    l2 = _mm_max_epi16(l2, _mm_setzero_si128());
    l3 = _mm_max_epi16(l3, _mm_setzero_si128());
 
-   l0 = _mm_min_epi16(l0, _mm_set1_epi16(CLIP_10));
-   l1 = _mm_min_epi16(l1, _mm_set1_epi16(CLIP_10));
-   l2 = _mm_min_epi16(l2, _mm_set1_epi16(CLIP_10));
-   l3 = _mm_min_epi16(l3, _mm_set1_epi16(CLIP_10));
+   l0 = _mm_min_epi16(l0, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l1 = _mm_min_epi16(l1, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l2 = _mm_min_epi16(l2, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l3 = _mm_min_epi16(l3, _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l0);
    _mm_storeu_si128((__m128i*)&dst[8  + 0 * dst_stride], l1);
@@ -268,10 +267,10 @@ ovvc_transform_sub_sse_8_4_10(uint16_t *dst, ptrdiff_t dst_stride,
    l2 = _mm_max_epi16(l2, _mm_setzero_si128());
    l3 = _mm_max_epi16(l3, _mm_setzero_si128());
 
-   l0 = _mm_min_epi16(l0, _mm_set1_epi16(CLIP_10));
-   l1 = _mm_min_epi16(l1, _mm_set1_epi16(CLIP_10));
-   l2 = _mm_min_epi16(l2, _mm_set1_epi16(CLIP_10));
-   l3 = _mm_min_epi16(l3, _mm_set1_epi16(CLIP_10));
+   l0 = _mm_min_epi16(l0, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l1 = _mm_min_epi16(l1, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l2 = _mm_min_epi16(l2, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l3 = _mm_min_epi16(l3, _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l0);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l1);
@@ -304,10 +303,10 @@ ovvc_transform_sub_sse_16_2_10(uint16_t *dst, ptrdiff_t dst_stride,
    l2 = _mm_max_epi16(l2, _mm_setzero_si128());
    l3 = _mm_max_epi16(l3, _mm_setzero_si128());
 
-   l0 = _mm_min_epi16(l0, _mm_set1_epi16(CLIP_10));
-   l1 = _mm_min_epi16(l1, _mm_set1_epi16(CLIP_10));
-   l2 = _mm_min_epi16(l2, _mm_set1_epi16(CLIP_10));
-   l3 = _mm_min_epi16(l3, _mm_set1_epi16(CLIP_10));
+   l0 = _mm_min_epi16(l0, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l1 = _mm_min_epi16(l1, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l2 = _mm_min_epi16(l2, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l3 = _mm_min_epi16(l3, _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l0);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l1);
@@ -340,10 +339,10 @@ ovvc_transform_sub_sse_32_1_10(uint16_t *dst, ptrdiff_t dst_stride,
    l2 = _mm_max_epi16(l2, _mm_setzero_si128());
    l3 = _mm_max_epi16(l3, _mm_setzero_si128());
 
-   l0 = _mm_min_epi16(l0, _mm_set1_epi16(CLIP_10));
-   l1 = _mm_min_epi16(l1, _mm_set1_epi16(CLIP_10));
-   l2 = _mm_min_epi16(l2, _mm_set1_epi16(CLIP_10));
-   l3 = _mm_min_epi16(l3, _mm_set1_epi16(CLIP_10));
+   l0 = _mm_min_epi16(l0, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l1 = _mm_min_epi16(l1, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l2 = _mm_min_epi16(l2, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l3 = _mm_min_epi16(l3, _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l0);
    _mm_storeu_si128((__m128i*)&dst[8  + 0 * dst_stride], l1);
@@ -404,10 +403,10 @@ ovvc_transform_sub_half_sse_8_4_10(uint16_t *dst, ptrdiff_t dst_stride,
    l2 = _mm_max_epi16(l2, _mm_setzero_si128());
    l3 = _mm_max_epi16(l3, _mm_setzero_si128());
 
-   l0 = _mm_min_epi16(l0, _mm_set1_epi16(CLIP_10));
-   l1 = _mm_min_epi16(l1, _mm_set1_epi16(CLIP_10));
-   l2 = _mm_min_epi16(l2, _mm_set1_epi16(CLIP_10));
-   l3 = _mm_min_epi16(l3, _mm_set1_epi16(CLIP_10));
+   l0 = _mm_min_epi16(l0, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l1 = _mm_min_epi16(l1, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l2 = _mm_min_epi16(l2, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l3 = _mm_min_epi16(l3, _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l0);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l1);
@@ -457,10 +456,10 @@ ovvc_transform_sub_half_sse_16_2_10(uint16_t *dst, ptrdiff_t dst_stride,
    l2 = _mm_max_epi16(l2, _mm_setzero_si128());
    l3 = _mm_max_epi16(l3, _mm_setzero_si128());
 
-   l0 = _mm_min_epi16(l0, _mm_set1_epi16(CLIP_10));
-   l1 = _mm_min_epi16(l1, _mm_set1_epi16(CLIP_10));
-   l2 = _mm_min_epi16(l2, _mm_set1_epi16(CLIP_10));
-   l3 = _mm_min_epi16(l3, _mm_set1_epi16(CLIP_10));
+   l0 = _mm_min_epi16(l0, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l1 = _mm_min_epi16(l1, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l2 = _mm_min_epi16(l2, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l3 = _mm_min_epi16(l3, _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l0);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l1);
@@ -510,10 +509,10 @@ ovvc_transform_sub_half_sse_32_1_10(uint16_t *dst, ptrdiff_t dst_stride,
    l2 = _mm_max_epi16(l2, _mm_setzero_si128());
    l3 = _mm_max_epi16(l3, _mm_setzero_si128());
 
-   l0 = _mm_min_epi16(l0, _mm_set1_epi16(CLIP_10));
-   l1 = _mm_min_epi16(l1, _mm_set1_epi16(CLIP_10));
-   l2 = _mm_min_epi16(l2, _mm_set1_epi16(CLIP_10));
-   l3 = _mm_min_epi16(l3, _mm_set1_epi16(CLIP_10));
+   l0 = _mm_min_epi16(l0, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l1 = _mm_min_epi16(l1, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l2 = _mm_min_epi16(l2, _mm_set1_epi16(OV_SAMPLE_MAX));
+   l3 = _mm_min_epi16(l3, _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l0);
    _mm_storeu_si128((__m128i*)&dst[8  + 0 * dst_stride], l1);
@@ -614,10 +613,10 @@ ovvc_transform_scale_add_sse_8_4_10(uint16_t *dst, ptrdiff_t dst_stride,
    l[2] = _mm_max_epi16(l[2], _mm_setzero_si128());
    l[3] = _mm_max_epi16(l[3], _mm_setzero_si128());
 
-   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(CLIP_10));
-   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(CLIP_10));
-   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(CLIP_10));
-   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(CLIP_10));
+   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l[0]);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l[1]);
@@ -718,10 +717,10 @@ ovvc_transform_scale_add_sse_16_2_10(uint16_t *dst, ptrdiff_t dst_stride,
    l[2] = _mm_max_epi16(l[2], _mm_setzero_si128());
    l[3] = _mm_max_epi16(l[3], _mm_setzero_si128());
 
-   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(CLIP_10));
-   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(CLIP_10));
-   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(CLIP_10));
-   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(CLIP_10));
+   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l[0]);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l[1]);
@@ -823,10 +822,10 @@ ovvc_transform_scale_add_sse_32_1_10(uint16_t *dst, ptrdiff_t dst_stride,
    l[2] = _mm_max_epi16(l[2], _mm_setzero_si128());
    l[3] = _mm_max_epi16(l[3], _mm_setzero_si128());
 
-   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(CLIP_10));
-   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(CLIP_10));
-   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(CLIP_10));
-   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(CLIP_10));
+   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0],  l[0]);
    _mm_storeu_si128((__m128i*)&dst[8],  l[1]);
@@ -932,10 +931,10 @@ ovvc_transform_scale_add_half_sse_8_4_10(uint16_t *dst, ptrdiff_t dst_stride,
    l[2] = _mm_max_epi16(l[2], _mm_setzero_si128());
    l[3] = _mm_max_epi16(l[3], _mm_setzero_si128());
 
-   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(CLIP_10));
-   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(CLIP_10));
-   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(CLIP_10));
-   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(CLIP_10));
+   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l[0]);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l[1]);
@@ -1041,10 +1040,10 @@ ovvc_transform_scale_add_half_sse_16_2_10(uint16_t *dst, ptrdiff_t dst_stride,
    l[2] = _mm_max_epi16(l[2], _mm_setzero_si128());
    l[3] = _mm_max_epi16(l[3], _mm_setzero_si128());
 
-   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(CLIP_10));
-   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(CLIP_10));
-   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(CLIP_10));
-   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(CLIP_10));
+   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l[0]);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l[1]);
@@ -1151,10 +1150,10 @@ ovvc_transform_scale_add_half_sse_32_1_10(uint16_t *dst, ptrdiff_t dst_stride,
    l[2] = _mm_max_epi16(l[2], _mm_setzero_si128());
    l[3] = _mm_max_epi16(l[3], _mm_setzero_si128());
 
-   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(CLIP_10));
-   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(CLIP_10));
-   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(CLIP_10));
-   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(CLIP_10));
+   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0],  l[0]);
    _mm_storeu_si128((__m128i*)&dst[8],  l[1]);
@@ -1255,10 +1254,10 @@ ovvc_transform_scale_sub_sse_8_4_10(uint16_t *dst, ptrdiff_t dst_stride,
    l[2] = _mm_max_epi16(l[2], _mm_setzero_si128());
    l[3] = _mm_max_epi16(l[3], _mm_setzero_si128());
 
-   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(CLIP_10));
-   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(CLIP_10));
-   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(CLIP_10));
-   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(CLIP_10));
+   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l[0]);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l[1]);
@@ -1359,10 +1358,10 @@ ovvc_transform_scale_sub_sse_16_2_10(uint16_t *dst, ptrdiff_t dst_stride,
    l[2] = _mm_max_epi16(l[2], _mm_setzero_si128());
    l[3] = _mm_max_epi16(l[3], _mm_setzero_si128());
 
-   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(CLIP_10));
-   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(CLIP_10));
-   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(CLIP_10));
-   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(CLIP_10));
+   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l[0]);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l[1]);
@@ -1464,10 +1463,10 @@ ovvc_transform_scale_sub_sse_32_1_10(uint16_t *dst, ptrdiff_t dst_stride,
    l[2] = _mm_max_epi16(l[2], _mm_setzero_si128());
    l[3] = _mm_max_epi16(l[3], _mm_setzero_si128());
 
-   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(CLIP_10));
-   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(CLIP_10));
-   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(CLIP_10));
-   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(CLIP_10));
+   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0],  l[0]);
    _mm_storeu_si128((__m128i*)&dst[8],  l[1]);
@@ -1583,10 +1582,10 @@ ovvc_transform_scale_sub_half_sse_8_4_10(uint16_t *dst, ptrdiff_t dst_stride,
    l[2] = _mm_max_epi16(l[2], _mm_setzero_si128());
    l[3] = _mm_max_epi16(l[3], _mm_setzero_si128());
 
-   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(CLIP_10));
-   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(CLIP_10));
-   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(CLIP_10));
-   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(CLIP_10));
+   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l[0]);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l[1]);
@@ -1703,10 +1702,10 @@ ovvc_transform_scale_sub_half_sse_16_2_10(uint16_t *dst, ptrdiff_t dst_stride,
    l[2] = _mm_max_epi16(l[2], _mm_setzero_si128());
    l[3] = _mm_max_epi16(l[3], _mm_setzero_si128());
 
-   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(CLIP_10));
-   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(CLIP_10));
-   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(CLIP_10));
-   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(CLIP_10));
+   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0 * dst_stride], l[0]);
    _mm_storeu_si128((__m128i*)&dst[1 * dst_stride], l[1]);
@@ -1824,10 +1823,10 @@ ovvc_transform_scale_sub_half_sse_32_1_10(uint16_t *dst, ptrdiff_t dst_stride,
    l[2] = _mm_max_epi16(l[2], _mm_setzero_si128());
    l[3] = _mm_max_epi16(l[3], _mm_setzero_si128());
 
-   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(CLIP_10));
-   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(CLIP_10));
-   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(CLIP_10));
-   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(CLIP_10));
+   l[0] = _mm_min_epi16(l[0], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[1] = _mm_min_epi16(l[1], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[2] = _mm_min_epi16(l[2], _mm_set1_epi16(OV_SAMPLE_MAX));
+   l[3] = _mm_min_epi16(l[3], _mm_set1_epi16(OV_SAMPLE_MAX));
 
    _mm_storeu_si128((__m128i*)&dst[0],  l[0]);
    _mm_storeu_si128((__m128i*)&dst[8],  l[1]);
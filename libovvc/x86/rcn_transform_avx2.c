@@ -0,0 +1,382 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "ovutils.h"
+#include "bitdepth.h"
+#include "ctudec.h"
+#include "data_rcn_transform.h"
+#include "rcn_structures.h"
+#include "x86/rcn_avx2.h"
+
+/* Inverse DCT-II kernels process blocks of 8 lines, each coefficient
+ * row of the block being kept in 16 bits lanes of a 128 bits register
+ * so one line is processed per 32 bits lane of the 256 bits results.
+ * Only the num_columns first coefficients of each line are considered
+ * (partial butterflies), remaining ones being known to be zero by the
+ * callers (last significant coefficient group or 64 points zero out).
+ */
+
+/* Interleave two coefficients rows of 8 lines for _mm256_madd_epi16 */
+static inline __m256i
+pair_rows(__m128i a, __m128i b)
+{
+  __m128i lo = _mm_unpacklo_epi16(a, b);
+  __m128i hi = _mm_unpackhi_epi16(a, b);
+
+  return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+static inline __m256i
+pair_coeffs(int16_t c0, int16_t c1)
+{
+  return _mm256_set1_epi32((uint16_t)c0 | ((uint32_t)(uint16_t)c1 << 16));
+}
+
+/* Matrix product of nb_x rows of x (stride x_stride) by the transform
+ * coefficients m[i * m_si + j * m_sj] for nb_o outputs
+ */
+static inline void
+dct2_part_avx2(const __m128i *x, int x_stride, __m256i *o, int nb_o, int nb_x,
+               const int16_t *m, int m_si, int m_sj)
+{
+  int i, j;
+
+  for (j = 0; j < nb_o; ++j) {
+    o[j] = _mm256_setzero_si256();
+  }
+
+  for (i = 0; i < nb_x; i += 2) {
+    uint8_t has_x1 = i + 1 < nb_x;
+    __m128i x1 = has_x1 ? x[(i + 1) * x_stride] : _mm_setzero_si128();
+    __m256i p = pair_rows(x[i * x_stride], x1);
+
+    for (j = 0; j < nb_o; ++j) {
+      int16_t c0 = m[i * m_si + j * m_sj];
+      int16_t c1 = has_x1 ? m[(i + 1) * m_si + j * m_sj] : 0;
+
+      o[j] = _mm256_add_epi32(o[j], _mm256_madd_epi16(p, pair_coeffs(c0, c1)));
+    }
+  }
+}
+
+static inline void
+dct2_butterfly_avx2(__m256i *out, const __m256i *e, const __m256i *o, int half)
+{
+  int j;
+  for (j = 0; j < half; ++j) {
+    out[j]                = _mm256_add_epi32(e[j], o[j]);
+    out[2 * half - 1 - j] = _mm256_sub_epi32(e[j], o[j]);
+  }
+}
+
+static inline void
+dct2_4_avx2(const __m128i *x, int s, __m256i *out, int nb)
+{
+  __m256i e[2], o[2];
+
+  dct2_part_avx2(x,     2 * s, e, 2, (nb + 1) >> 1, DCT_II_4,     8, 1);
+  dct2_part_avx2(x + s, 2 * s, o, 2, nb >> 1,       DCT_II_4 + 4, 8, 1);
+
+  dct2_butterfly_avx2(out, e, o, 2);
+}
+
+static inline void
+dct2_8_avx2(const __m128i *x, int s, __m256i *out, int nb)
+{
+  __m256i e[4], o[4];
+
+  dct2_4_avx2(x, 2 * s, e, (nb + 1) >> 1);
+  dct2_part_avx2(x + s, 2 * s, o, 4, nb >> 1, DCT_II_8 + 8, 16, 1);
+
+  dct2_butterfly_avx2(out, e, o, 4);
+}
+
+static inline void
+dct2_16_avx2(const __m128i *x, int s, __m256i *out, int nb)
+{
+  __m256i e[8], o[8];
+
+  dct2_8_avx2(x, 2 * s, e, (nb + 1) >> 1);
+  dct2_part_avx2(x + s, 2 * s, o, 8, nb >> 1, DCT_II_16 + 16, 32, 1);
+
+  dct2_butterfly_avx2(out, e, o, 8);
+}
+
+static inline void
+dct2_32_avx2(const __m128i *x, int s, __m256i *out, int nb)
+{
+  __m256i e[16], o[16];
+
+  dct2_16_avx2(x, 2 * s, e, (nb + 1) >> 1);
+  dct2_part_avx2(x + s, 2 * s, o, 16, nb >> 1, DCT_II_32 + 32, 64, 1);
+
+  dct2_butterfly_avx2(out, e, o, 16);
+}
+
+/* Only the 32 first coefficients are used by 64 points transforms */
+static inline void
+dct2_64_avx2(const __m128i *x, int s, __m256i *out, int nb)
+{
+  __m256i e[32], o[32];
+
+  dct2_32_avx2(x, 2 * s, e, (nb + 1) >> 1);
+  dct2_part_avx2(x + s, 2 * s, o, 32, nb >> 1, DCT_II_64_OT, 1, 16);
+
+  dct2_butterfly_avx2(out, e, o, 32);
+}
+
+static inline void
+dct2_avx2(const __m128i *x, __m256i *out, int log2_tr_s, int nb)
+{
+  switch (log2_tr_s) {
+  case 4:
+    dct2_16_avx2(x, 1, out, nb);
+    break;
+  case 5:
+    dct2_32_avx2(x, 1, out, nb);
+    break;
+  case 6:
+    dct2_64_avx2(x, 1, out, nb);
+    break;
+  }
+}
+
+/* Load nb coefficients rows of nb_l <= 8 lines */
+static inline void
+load_rows(const int16_t *src, ptrdiff_t src_stride, __m128i *x, int nb, int nb_l)
+{
+  int k;
+  if (nb_l == 8) {
+    for (k = 0; k < nb; ++k) {
+      x[k] = _mm_loadu_si128((const __m128i *)&src[k * src_stride]);
+    }
+  } else if (nb_l == 4) {
+    for (k = 0; k < nb; ++k) {
+      x[k] = _mm_loadl_epi64((const __m128i *)&src[k * src_stride]);
+    }
+  } else {
+    for (k = 0; k < nb; ++k) {
+      int16_t buff[8] = {0};
+      memcpy(buff, &src[k * src_stride], sizeof(int16_t) * nb_l);
+      x[k] = _mm_loadu_si128((const __m128i *)buff);
+    }
+  }
+}
+
+/* Round, clip and transpose 8 outputs of 8 lines, lower 128 bits
+ * of l[i] contain line i outputs and upper ones line i + 4
+ */
+static inline void
+transpose_outputs(const __m256i *r, __m256i *l, __m256i add, int shift)
+{
+  __m256i v[8], p[4], a[4], e[4];
+  int i;
+
+  for (i = 0; i < 8; ++i) {
+    v[i] = _mm256_srai_epi32(_mm256_add_epi32(r[i], add), shift);
+  }
+
+  p[0] = _mm256_packs_epi32(v[0], v[2]);
+  p[1] = _mm256_packs_epi32(v[1], v[3]);
+  p[2] = _mm256_packs_epi32(v[4], v[6]);
+  p[3] = _mm256_packs_epi32(v[5], v[7]);
+
+  a[0] = _mm256_unpacklo_epi16(p[0], p[1]);
+  a[1] = _mm256_unpackhi_epi16(p[0], p[1]);
+  a[2] = _mm256_unpacklo_epi16(p[2], p[3]);
+  a[3] = _mm256_unpackhi_epi16(p[2], p[3]);
+
+  e[0] = _mm256_unpacklo_epi32(a[0], a[1]);
+  e[1] = _mm256_unpackhi_epi32(a[0], a[1]);
+  e[2] = _mm256_unpacklo_epi32(a[2], a[3]);
+  e[3] = _mm256_unpackhi_epi32(a[2], a[3]);
+
+  l[0] = _mm256_unpacklo_epi64(e[0], e[2]);
+  l[1] = _mm256_unpackhi_epi64(e[0], e[2]);
+  l[2] = _mm256_unpacklo_epi64(e[1], e[3]);
+  l[3] = _mm256_unpackhi_epi64(e[1], e[3]);
+}
+
+static inline __m128i
+output_line(const __m256i *l, int i)
+{
+  return i < 4 ? _mm256_castsi256_si128(l[i]) : _mm256_extracti128_si256(l[i - 4], 1);
+}
+
+static inline void
+store_lines(const __m256i *r, int16_t *dst, int log2_tr_s, int nb_l, int shift)
+{
+  const __m256i add = _mm256_set1_epi32(1 << (shift - 1));
+  int tr_s = 1 << log2_tr_s;
+  int i, j;
+
+  for (j = 0; j < tr_s; j += 8) {
+    __m256i l[4];
+
+    transpose_outputs(&r[j], l, add, shift);
+
+    for (i = 0; i < nb_l; ++i) {
+      _mm_storeu_si128((__m128i *)&dst[(i << log2_tr_s) + j], output_line(l, i));
+    }
+  }
+}
+
+/* Same as store_lines with outputs added to reconstructed samples */
+static inline void
+add_lines(const __m256i *r, uint16_t *dst, int log2_tr_s, int nb_l, int shift)
+{
+  const __m256i add = _mm256_set1_epi32(1 << (shift - 1));
+  const __m128i max_val = _mm_set1_epi16(OV_SAMPLE_MAX);
+  int tr_s = 1 << log2_tr_s;
+  int i, j;
+
+  for (j = 0; j < tr_s; j += 8) {
+    __m256i l[4];
+
+    transpose_outputs(&r[j], l, add, shift);
+
+    for (i = 0; i < nb_l; ++i) {
+      uint16_t *rcn = &dst[i * RCN_CTB_STRIDE + j];
+      __m128i x = _mm_loadu_si128((__m128i *)rcn);
+
+      x = _mm_adds_epi16(x, output_line(l, i));
+      x = _mm_max_epi16(x, _mm_setzero_si128());
+      x = _mm_min_epi16(x, max_val);
+
+      _mm_storeu_si128((__m128i *)rcn, x);
+    }
+  }
+}
+
+static inline void
+inverse_dct_ii_avx2(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+                    int num_lines, int num_columns, int shift, int log2_tr_s)
+{
+  int nb = OVMIN(num_columns, OVMIN(1 << log2_tr_s, 32));
+  int i;
+
+  for (i = 0; i < num_lines; i += 8) {
+    int nb_l = OVMIN(num_lines - i, 8);
+    __m128i x[32];
+    __m256i r[64];
+
+    load_rows(src + i, src_stride, x, nb, nb_l);
+
+    dct2_avx2(x, r, log2_tr_s, nb);
+
+    store_lines(r, dst + (i << log2_tr_s), log2_tr_s, nb_l, shift);
+  }
+}
+
+static inline void
+inverse_dct_ii_add_avx2(const int16_t *src, uint16_t *dst, ptrdiff_t src_stride,
+                        int num_lines, int num_columns, int shift, int log2_tr_s)
+{
+  int nb = OVMIN(num_columns, OVMIN(1 << log2_tr_s, 32));
+  int i;
+
+  for (i = 0; i < num_lines; i += 8) {
+    int nb_l = OVMIN(num_lines - i, 8);
+    __m128i x[32];
+    __m256i r[64];
+
+    load_rows(src + i, src_stride, x, nb, nb_l);
+
+    dct2_avx2(x, r, log2_tr_s, nb);
+
+    add_lines(r, dst + i * RCN_CTB_STRIDE, log2_tr_s, nb_l, shift);
+  }
+}
+
+static void
+vvc_inverse_dct_ii_16_avx2(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+                           int num_lines, int num_columns, int shift)
+{
+  inverse_dct_ii_avx2(src, dst, src_stride, num_lines, num_columns, shift, 4);
+}
+
+static void
+vvc_inverse_dct_ii_32_avx2(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+                           int num_lines, int num_columns, int shift)
+{
+  inverse_dct_ii_avx2(src, dst, src_stride, num_lines, num_columns, shift, 5);
+}
+
+static void
+vvc_inverse_dct_ii_64_avx2(const int16_t *src, int16_t *dst, ptrdiff_t src_stride,
+                           int num_lines, int num_columns, int shift)
+{
+  inverse_dct_ii_avx2(src, dst, src_stride, num_lines, num_columns, shift, 6);
+}
+
+static void
+vvc_inverse_dct_ii_add_16_avx2(const int16_t *src, uint16_t *dst, ptrdiff_t src_stride,
+                               int num_lines, int num_columns, int shift)
+{
+  inverse_dct_ii_add_avx2(src, dst, src_stride, num_lines, num_columns, shift, 4);
+}
+
+static void
+vvc_inverse_dct_ii_add_32_avx2(const int16_t *src, uint16_t *dst, ptrdiff_t src_stride,
+                               int num_lines, int num_columns, int shift)
+{
+  inverse_dct_ii_add_avx2(src, dst, src_stride, num_lines, num_columns, shift, 5);
+}
+
+static void
+vvc_inverse_dct_ii_add_64_avx2(const int16_t *src, uint16_t *dst, ptrdiff_t src_stride,
+                               int num_lines, int num_columns, int shift)
+{
+  inverse_dct_ii_add_avx2(src, dst, src_stride, num_lines, num_columns, shift, 6);
+}
+
+/* DC only blocks residual is a constant added to reconstructed samples */
+static void
+vvc_inverse_dct_ii_dc_add_avx2(uint16_t *dst, int log2_tb_w, int log2_tb_h, int dc_val)
+{
+  int value = ov_clip((((dc_val + 1) >> 1) + 8) >> 4, -(1 << 15), (1 << 15) - 1);
+  const __m256i res = _mm256_set1_epi16(value);
+  const __m256i max_val = _mm256_set1_epi16(OV_SAMPLE_MAX);
+  int tb_w = 1 << log2_tb_w;
+  int tb_h = 1 << log2_tb_h;
+  int i, j;
+
+  for (i = 0; i < tb_h; ++i) {
+    if (tb_w >= 16) {
+      for (j = 0; j < tb_w; j += 16) {
+        __m256i x = _mm256_loadu_si256((__m256i *)&dst[j]);
+        x = _mm256_adds_epi16(x, res);
+        x = _mm256_max_epi16(x, _mm256_setzero_si256());
+        x = _mm256_min_epi16(x, max_val);
+        _mm256_storeu_si256((__m256i *)&dst[j], x);
+      }
+    } else {
+      __m128i x = _mm_loadu_si128((__m128i *)dst);
+      x = _mm_adds_epi16(x, _mm256_castsi256_si128(res));
+      x = _mm_max_epi16(x, _mm_setzero_si128());
+      x = _mm_min_epi16(x, _mm256_castsi256_si128(max_val));
+      if (tb_w == 8) {
+        _mm_storeu_si128((__m128i *)dst, x);
+      } else {
+        _mm_storel_epi64((__m128i *)dst, x);
+      }
+    }
+    dst += RCN_CTB_STRIDE;
+  }
+}
+
+void
+rcn_init_tr_functions_avx2(struct RCNFunctions *const rcn_funcs)
+{
+  rcn_funcs->tr.func[DCT_II][4] = &vvc_inverse_dct_ii_16_avx2;
+  rcn_funcs->tr.func[DCT_II][5] = &vvc_inverse_dct_ii_32_avx2;
+  rcn_funcs->tr.func[DCT_II][6] = &vvc_inverse_dct_ii_64_avx2;
+
+  rcn_funcs->tr.dct2_add[4] = &vvc_inverse_dct_ii_add_16_avx2;
+  rcn_funcs->tr.dct2_add[5] = &vvc_inverse_dct_ii_add_32_avx2;
+  rcn_funcs->tr.dct2_add[6] = &vvc_inverse_dct_ii_add_64_avx2;
+
+  rcn_funcs->tr.dc_add = &vvc_inverse_dct_ii_dc_add_avx2;
+}
@@ -1,12 +1,30 @@
 x86_SRC_FOLDER:=libovvc/x86/
 x86_LIB_SRC:=																														 \
 					rcn_transform_sse.c                                            \
-					vvc_utils_sse.c                                            		 \
-					rcn_intra_dc_planar_sse.c																			 \
-					rcn_mc_sse.c																									 \
-					rcn_transform_add_sse.c																				 \
-					rcn_alf_sse.c								          												 \
-					rcn_intra_cclm_sse.c				          												 \
-					rcn_lfnst_sse.c		      		          												 \
-					rcn_intra_mip_sse.c		   		          												 \
-					rcn_sao_sse.c		   		    			      												 \
+					vvc_utils_sse.c                                                \
+					rcn_lfnst_sse.c                                                \
+					ovannexb_sse.c                                                 \
+					rcn_transform_avx2.c                                           \
+					ovannexb_avx2.c                                                \
+					rcn_intra_dc_planar_sse.c                                      \
+					rcn_transform_add_sse.c                                        \
+					rcn_intra_cclm_sse.c                                           \
+					rcn_intra_mip_sse.c                                            \
+					rcn_intra_angular_sse.c                                        \
+					rcn_inter_refine_sse.c                                         \
+					rcn_intra_angular_avx2.c                                       \
+
+# Kernels reading or writing picture samples are written for 10 bits only
+ifeq ($(BITDEPTH),10)
+x86_LIB_SRC+=																														 \
+					rcn_mc_sse.c                                                   \
+					rcn_alf_sse.c                                                  \
+					rcn_sao_sse.c                                                  \
+					rcn_df_sse.c                                                   \
+					pp_film_grain_sse.c                                            \
+					rcn_mc_avx2.c                                                  \
+					rcn_alf_avx2.c                                                 \
+					rcn_sao_avx2.c                                                 \
+					pp_film_grain_avx2.c                                           \
+
+endif